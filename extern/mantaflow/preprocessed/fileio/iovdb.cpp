@@ -53,8 +53,21 @@ template<class GridType, class T> void importVDB(typename GridType::Ptr from, Gr
 {
   using ValueT = typename GridType::ValueType;
 
-  // Check if current grid is to be read as a sparse grid, active voxels (only) will be copied
-  if (to->saveSparse()) {
+  // Copy data into the grid through a vdb dense structure, the counterpart of exportVDB(). This
+  // copies whole leaf nodes in parallel instead of looking up every cell. Cells that are not
+  // stored in the vdb grid get the background value, so for sparse grids this is only the same as
+  // clearing the grid first when the background is zero, which it is for grids written by
+  // exportVDB().
+  if (!to->saveSparse() || from->background() == ValueT(0)) {
+    ValueT *data = (ValueT *)to->getData();
+    openvdb::math::CoordBBox bbox(
+        openvdb::Coord(0),
+        openvdb::Coord(to->getSizeX() - 1, to->getSizeY() - 1, to->getSizeZ() - 1));
+    openvdb::tools::Dense<ValueT, openvdb::tools::MemoryLayout::LayoutXYZ> dense(bbox, data);
+    openvdb::tools::copyToDense(*from, dense);
+  }
+  // Otherwise only the active voxels of the sparse grid are copied
+  else {
     to->clear();  // Ensure that destination grid is empty before writing
     for (typename GridType::ValueOnCIter iter = from->cbeginValueOn(); iter.test(); ++iter) {
       ValueT vdbValue = *iter;
@@ -64,18 +77,6 @@ template<class GridType, class T> void importVDB(typename GridType::Ptr from, Gr
       to->set(coord.x(), coord.y(), coord.z(), toMantaValue);
     }
   }
-  // When importing all grid cells, using a grid accessor is usually faster than a value iterator
-  else {
-    typename GridType::Accessor accessor = from->getAccessor();
-    FOR_IJK(*to)
-    {
-      openvdb::Coord xyz(i, j, k);
-      ValueT vdbValue = accessor.getValue(xyz);
-      T toMantaValue;
-      convertFrom(vdbValue, &toMantaValue);
-      to->set(i, j, k, toMantaValue);
-    }
-  }
 }
 
 template<class VDBType, class T>
@@ -8,6 +8,7 @@
 #include "scene/integrator.h"
 #include "scene/scene.h"
 #include "session/buffers.h"
+#include "session/merge.h"
 #include "session/session.h"
 
 #include "util/args.h"
@@ -37,6 +38,7 @@ struct Options {
   Session *session;
   Scene *scene;
   string filepath;
+  vector<string> input_filepaths;
   int width, height;
   SceneParams scene_params;
   SessionParams session_params;
@@ -44,6 +46,7 @@ struct Options {
   bool show_help, interactive, pause;
   string output_filepath;
   string output_pass;
+  string merge_filepath;
 } options;
 
 static void session_print(const string &str)
@@ -124,8 +127,11 @@ static void session_init()
   else
 #endif
       if (!options.output_filepath.empty()) {
-    options.session->set_output_driver(make_unique<OIIOOutputDriver>(
-        options.output_filepath, options.output_pass, session_print));
+    options.session->set_output_driver(
+        make_unique<OIIOOutputDriver>(options.output_filepath,
+                                      options.output_pass,
+                                      options.session_params.samples,
+                                      session_print));
   }
 
   if (options.session_params.background && !options.quiet)
@@ -337,6 +343,9 @@ static int files_parse(int argc, const char *argv[])
   if (argc > 0)
     options.filepath = argv[0];
 
+  for (int i = 0; i < argc; i++)
+    options.input_filepaths.push_back(argv[i]);
+
   return 0;
 }
 
@@ -393,6 +402,9 @@ static void options_parse(int argc, const char **argv)
              "--samples %d",
              &options.session_params.samples,
              "Number of samples to render",
+             "--sample-offset %d",
+             &options.session_params.sample_offset,
+             "Number of samples to skip, to render distinct sample ranges on multiple machines",
              "--output %s",
              &options.output_filepath,
              "File path to write output image",
@@ -411,6 +423,9 @@ static void options_parse(int argc, const char **argv)
              "--list-devices",
              &list,
              "List information about all available devices",
+             "--merge %s",
+             &options.merge_filepath,
+             "Merge the input EXR files rendered with different sample ranges into this file",
 #ifdef WITH_CYCLES_LOGGING
              "--debug",
              &debug,
@@ -459,6 +474,18 @@ static void options_parse(int argc, const char **argv)
     ap.usage();
     exit(EXIT_SUCCESS);
   }
+  else if (!options.merge_filepath.empty()) {
+    ImageMerger merger;
+    merger.input = options.input_filepaths;
+    merger.output = options.merge_filepath;
+
+    if (!merger.run()) {
+      fprintf(stderr, "Failed to merge images: %s\n", merger.error.c_str());
+      exit(EXIT_FAILURE);
+    }
+
+    exit(EXIT_SUCCESS);
+  }
 
   if (ssname == "osl")
     options.scene_params.shadingsystem = SHADINGSYSTEM_OSL;
@@ -503,6 +530,10 @@ static void options_parse(int argc, const char **argv)
     fprintf(stderr, "Invalid number of samples: %d\n", options.session_params.samples);
     exit(EXIT_FAILURE);
   }
+  else if (options.session_params.sample_offset < 0) {
+    fprintf(stderr, "Invalid sample offset: %d\n", options.session_params.sample_offset);
+    exit(EXIT_FAILURE);
+  }
   else if (options.filepath == "") {
     fprintf(stderr, "No file path specified\n");
     exit(EXIT_FAILURE);
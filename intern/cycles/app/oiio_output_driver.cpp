@@ -7,8 +7,9 @@ CCL_NAMESPACE_BEGIN
 
 OIIOOutputDriver::OIIOOutputDriver(const string_view filepath,
                                    const string_view pass,
+                                   const int samples,
                                    LogFunction log)
-    : filepath_(filepath), pass_(pass), log_(log)
+    : filepath_(filepath), pass_(pass), samples_(samples), log_(log)
 {
 }
 
@@ -35,6 +36,11 @@ void OIIOOutputDriver::write_render_tile(const Tile &tile)
   const int height = tile.size.y;
 
   ImageSpec spec(width, height, 4, TypeDesc::FLOAT);
+
+  /* Store number of samples in the same way as Blender, so that images rendered with different
+   * sample offsets can be merged. */
+  const string layer = (tile.layer.empty()) ? "RenderLayer" : tile.layer;
+  spec.attribute("cycles." + layer + ".samples", TypeDesc::STRING, to_string(samples_));
   if (!image_output->open(filepath_, spec)) {
     log_("Failed to create image file");
     return;
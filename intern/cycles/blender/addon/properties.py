@@ -378,6 +378,32 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         default=0.01,
     )
 
+    use_light_tree: BoolProperty(
+        name="Light Tree",
+        description="Sample lights close to the shading point more often, reducing noise in scenes with many lights",
+        default=True,
+    )
+
+    use_guiding: BoolProperty(
+        name="Path Guiding",
+        description="Learn the incident light during the first samples and use it to guide the sampling of diffuse surfaces. "
+        "Only supported on the CPU",
+        default=False,
+    )
+    guiding_training_samples: IntProperty(
+        name="Training Samples",
+        description="Number of samples used to learn the incident light, before it is used for guiding",
+        min=1, max=(1 << 24),
+        default=32,
+    )
+    guiding_probability: FloatProperty(
+        name="Guiding Probability",
+        description="Probability of sampling a direction from the learned incident light instead of the BSDF",
+        min=0.0, max=1.0,
+        default=0.5,
+        subtype='FACTOR',
+    )
+
     use_adaptive_sampling: BoolProperty(
         name="Use Adaptive Sampling",
         description="Automatically reduce the number of samples per pixel based on estimated noise level",
@@ -523,6 +549,13 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         min=2, max=65536
     )
 
+    volume_skip_empty: BoolProperty(
+        name="Skip Empty Space",
+        description="Take larger steps through empty space inside volumes, where the shader has no density. "
+        "Faster for sparse volumes, but very thin features next to empty space may be stepped over",
+        default=False,
+    )
+
     dicing_rate: FloatProperty(
         name="Dicing Rate",
         description="Size of a micropolygon in pixels",
@@ -796,6 +829,14 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         min=8, max=8192,
     )
 
+    texture_memory_limit: IntProperty(
+        name="Texture Memory Limit",
+        description="Maximum memory in megabytes used by image textures, larger images are "
+        "loaded at lower resolution until they fit. Zero means no limit",
+        default=0,
+        min=0, max=1048576,
+    )
+
     # Various fine-tuning debug flags
 
     def _devices_update_callback(self, context):
@@ -299,6 +299,17 @@ class CYCLES_RENDER_PT_sampling_advanced(CyclesButtonsPanel, Panel):
         col.prop(cscene, "min_light_bounces")
         col.prop(cscene, "min_transparent_bounces")
         col.prop(cscene, "light_sampling_threshold", text="Light Threshold")
+        col.prop(cscene, "use_light_tree")
+
+        layout.separator()
+
+        col = layout.column(align=True)
+        col.active = use_cpu(context)
+        col.prop(cscene, "use_guiding")
+        sub = col.column(align=True)
+        sub.active = cscene.use_guiding
+        sub.prop(cscene, "guiding_training_samples")
+        sub.prop(cscene, "guiding_probability", text="Probability")
 
         for view_layer in scene.view_layers:
             if view_layer.samples > 0:
@@ -378,6 +389,7 @@ class CYCLES_RENDER_PT_volumes(CyclesButtonsPanel, Panel):
         col.prop(cscene, "volume_preview_step_rate", text="Viewport")
 
         layout.prop(cscene, "volume_max_steps", text="Max Steps")
+        layout.prop(cscene, "volume_skip_empty")
 
 
 class CYCLES_RENDER_PT_light_paths(CyclesButtonsPanel, Panel):
@@ -654,6 +666,9 @@ class CYCLES_RENDER_PT_performance_memory(CyclesButtonsPanel, Panel):
         sub.active = cscene.use_auto_tile
         sub.prop(cscene, "tile_size")
 
+        col = layout.column()
+        col.prop(cscene, "texture_memory_limit")
+
 
 class CYCLES_RENDER_PT_performance_acceleration_structure(CyclesButtonsPanel, Panel):
     bl_label = "Acceleration Structure"
@@ -145,6 +145,21 @@ Geometry *BlenderSync::sync_geometry(BL::Depsgraph &b_depsgraph,
 
   geometry_synced.insert(geom);
 
+  /* Geometry with an applied transform or displacement was modified after the last sync, so
+   * identical synced data must still be updated. */
+  if (geom->transform_applied) {
+    geom->sync_hash.clear();
+  }
+  else {
+    foreach (Node *node, used_shaders) {
+      Shader *shader = static_cast<Shader *>(node);
+      if (shader->need_update_geometry() || shader->has_displacement) {
+        geom->sync_hash.clear();
+        break;
+      }
+    }
+  }
+
   geom->name = ustring(b_ob_info.object_data.name().c_str());
 
   /* Store the shaders immediately for the object attribute code. */
@@ -21,6 +21,8 @@
 #include "util/hash.h"
 #include "util/log.h"
 #include "util/math.h"
+#include "util/md5.h"
+#include "util/tbb.h"
 
 #include "mikktspace.h"
 
@@ -206,6 +208,15 @@ static void mikk_set_tangent_space(const SMikkTSpaceContext *context,
   }
 }
 
+static void mikk_parallel_range(const SMikkTSpaceContext * /*context*/,
+                                const int num_items,
+                                void (*func)(void *data, const int start, const int end),
+                                void *data)
+{
+  parallel_for(blocked_range<int>(0, num_items, 1024),
+               [&](const blocked_range<int> &r) { func(data, r.begin(), r.end()); });
+}
+
 static void mikk_compute_tangents(
     const BL::Mesh &b_mesh, const char *layer_name, Mesh *mesh, bool need_sign, bool active_render)
 {
@@ -258,6 +269,7 @@ static void mikk_compute_tangents(
   sm_interface.m_getTexCoord = mikk_get_texture_coordinate;
   sm_interface.m_getNormal = mikk_get_normal;
   sm_interface.m_setTSpaceBasic = mikk_set_tangent_space;
+  sm_interface.m_parallelRange = mikk_parallel_range;
   /* Setup context. */
   SMikkTSpaceContext context;
   memset(&context, 0, sizeof(context));
@@ -1081,6 +1093,35 @@ static void create_subd_mesh(Scene *scene,
 
 /* Sync */
 
+static void mesh_hash_attributes(MD5Hash &md5, const AttributeSet &attributes)
+{
+  foreach (const Attribute &attr, attributes.attributes) {
+    md5.append(attr.name.string());
+    md5.append((const uint8_t *)&attr.std, sizeof(attr.std));
+    md5.append((const uint8_t *)&attr.type, sizeof(attr.type));
+    md5.append((const uint8_t *)&attr.element, sizeof(attr.element));
+    md5.append((const uint8_t *)&attr.flags, sizeof(attr.flags));
+    if (!attr.buffer.empty()) {
+      md5.append((const uint8_t *)attr.buffer.data(), attr.buffer.size());
+    }
+  }
+}
+
+/* Hash of everything sync_mesh copies from the newly synced mesh. */
+static string mesh_sync_hash(Mesh &mesh)
+{
+  MD5Hash md5;
+  mesh.hash(md5);
+
+  const size_t num_subd_faces = mesh.get_num_subd_faces();
+  md5.append((const uint8_t *)&num_subd_faces, sizeof(num_subd_faces));
+
+  mesh_hash_attributes(md5, mesh.attributes);
+  mesh_hash_attributes(md5, mesh.subd_attributes);
+
+  return md5.get_hex();
+}
+
 void BlenderSync::sync_mesh(BL::Depsgraph b_depsgraph, BObjectInfo &b_ob_info, Mesh *mesh)
 {
   /* make a copy of the shaders as the caller in the main thread still need them for syncing the
@@ -1135,9 +1176,23 @@ void BlenderSync::sync_mesh(BL::Depsgraph b_depsgraph, BObjectInfo &b_ob_info, M
     }
   }
 
+  /* With persistent data the same mesh is often synced again unchanged, for example when the
+   * depsgraph tags it on every frame. Skip the update so the mesh is not reuploaded and its
+   * BVH not rebuilt. Motion steps are synced afterwards and written in place, so they can not
+   * be compared here. */
+  const bool use_sync_hash = use_mesh_sync_hash && !mesh->get_use_motion_blur() &&
+                             !mesh->attributes.find(ATTR_STD_MOTION_VERTEX_POSITION) &&
+                             !new_mesh.attributes.find(ATTR_STD_MOTION_VERTEX_POSITION);
+  const string sync_hash = (use_sync_hash) ? mesh_sync_hash(new_mesh) : string();
+
+  if (use_sync_hash && !mesh->sync_hash.empty() && mesh->sync_hash == sync_hash) {
+    return;
+  }
+
   /* update original sockets */
 
   mesh->clear_non_sockets();
+  mesh->sync_hash = sync_hash;
 
   for (const SocketType &socket : new_mesh.type->inputs) {
     /* Those sockets are updated in sync_object, so do not modify them. */
@@ -143,6 +143,71 @@ void BlenderSync::sync_object_motion_init(BL::Object &b_parent, BL::Object &b_ob
   }
 }
 
+const BlenderSync::ObjectInstanceSettings &BlenderSync::object_instance_settings_get(
+    BObjectInfo &b_ob_info, BL::Object &b_parent, BL::ViewLayer &b_view_layer)
+{
+  /* Scenes with many instances of the same objects would otherwise spend most of the sync time
+   * in these RNA lookups. For instances the iterator object is a temporary that is reused for
+   * every instance, so key on the object being instanced. */
+  BL::Object &b_ob = b_ob_info.iter_object;
+  const pair<void *, void *> key(b_ob_info.real_object.ptr.data, b_parent.ptr.data);
+  map<pair<void *, void *>, ObjectInstanceSettings>::iterator it = object_instance_settings.find(
+      key);
+  if (it != object_instance_settings.end()) {
+    return it->second;
+  }
+
+  ObjectInstanceSettings &settings = object_instance_settings[key];
+
+  PointerRNA cobject = RNA_pointer_get(&b_ob.ptr, "cycles");
+  settings.use_holdout = b_parent.holdout_get(PointerRNA_NULL, b_view_layer);
+  settings.visibility = object_ray_visibility(b_ob) & PATH_RAY_ALL_VISIBILITY;
+
+  if (b_parent.ptr.data != b_ob.ptr.data) {
+    settings.visibility &= object_ray_visibility(b_parent);
+  }
+
+  /* TODO: make holdout objects on excluded layer invisible for non-camera rays. */
+#if 0
+  if (use_holdout && (layer_flag & view_layer.exclude_layer)) {
+    visibility &= ~(PATH_RAY_ALL_VISIBILITY - PATH_RAY_CAMERA);
+  }
+#endif
+
+  /* Clear camera visibility for indirect only objects. */
+  bool use_indirect_only = !settings.use_holdout &&
+                           b_parent.indirect_only_get(PointerRNA_NULL, b_view_layer);
+  if (use_indirect_only) {
+    settings.visibility &= ~PATH_RAY_CAMERA;
+  }
+
+  settings.is_shadow_catcher = b_ob.is_shadow_catcher() || b_parent.is_shadow_catcher();
+
+  settings.shadow_terminator_shading_offset = get_float(cobject, "shadow_terminator_offset");
+  settings.shadow_terminator_geometry_offset = get_float(cobject,
+                                                         "shadow_terminator_geometry_offset");
+
+  settings.ao_distance = get_float(cobject, "ao_distance");
+  if (settings.ao_distance == 0.0f && b_parent.ptr.data != b_ob.ptr.data) {
+    PointerRNA cparent = RNA_pointer_get(&b_parent.ptr, "cycles");
+    settings.ao_distance = get_float(cparent, "ao_distance");
+  }
+
+  /* Asset name for Cryptomatte. */
+  BL::Object parent = b_ob.parent();
+  if (parent) {
+    while (parent.parent()) {
+      parent = parent.parent();
+    }
+    settings.asset_name = parent.name();
+  }
+  else {
+    settings.asset_name = b_ob.name();
+  }
+
+  return settings;
+}
+
 Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
                                  BL::ViewLayer &b_view_layer,
                                  BL::DepsgraphObjectInstance &b_instance,
@@ -205,27 +270,9 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
   }
 
   /* Visibility flags for both parent and child. */
-  PointerRNA cobject = RNA_pointer_get(&b_ob.ptr, "cycles");
-  bool use_holdout = b_parent.holdout_get(PointerRNA_NULL, b_view_layer);
-  uint visibility = object_ray_visibility(b_ob) & PATH_RAY_ALL_VISIBILITY;
-
-  if (b_parent.ptr.data != b_ob.ptr.data) {
-    visibility &= object_ray_visibility(b_parent);
-  }
-
-  /* TODO: make holdout objects on excluded layer invisible for non-camera rays. */
-#if 0
-  if (use_holdout && (layer_flag & view_layer.exclude_layer)) {
-    visibility &= ~(PATH_RAY_ALL_VISIBILITY - PATH_RAY_CAMERA);
-  }
-#endif
-
-  /* Clear camera visibility for indirect only objects. */
-  bool use_indirect_only = !use_holdout &&
-                           b_parent.indirect_only_get(PointerRNA_NULL, b_view_layer);
-  if (use_indirect_only) {
-    visibility &= ~PATH_RAY_CAMERA;
-  }
+  const ObjectInstanceSettings &settings = object_instance_settings_get(
+      b_ob_info, b_parent, b_view_layer);
+  const uint visibility = settings.visibility;
 
   /* Don't export completely invisible objects. */
   if (visibility == 0) {
@@ -278,39 +325,19 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
   }
 
   /* holdout */
-  object->set_use_holdout(use_holdout);
+  object->set_use_holdout(settings.use_holdout);
 
   object->set_visibility(visibility);
 
-  object->set_is_shadow_catcher(b_ob.is_shadow_catcher() || b_parent.is_shadow_catcher());
-
-  float shadow_terminator_shading_offset = get_float(cobject, "shadow_terminator_offset");
-  object->set_shadow_terminator_shading_offset(shadow_terminator_shading_offset);
+  object->set_is_shadow_catcher(settings.is_shadow_catcher);
 
-  float shadow_terminator_geometry_offset = get_float(cobject,
-                                                      "shadow_terminator_geometry_offset");
-  object->set_shadow_terminator_geometry_offset(shadow_terminator_geometry_offset);
+  object->set_shadow_terminator_shading_offset(settings.shadow_terminator_shading_offset);
+  object->set_shadow_terminator_geometry_offset(settings.shadow_terminator_geometry_offset);
 
-  float ao_distance = get_float(cobject, "ao_distance");
-  if (ao_distance == 0.0f && b_parent.ptr.data != b_ob.ptr.data) {
-    PointerRNA cparent = RNA_pointer_get(&b_parent.ptr, "cycles");
-    ao_distance = get_float(cparent, "ao_distance");
-  }
-  object->set_ao_distance(ao_distance);
+  object->set_ao_distance(settings.ao_distance);
 
   /* sync the asset name for Cryptomatte */
-  BL::Object parent = b_ob.parent();
-  ustring parent_name;
-  if (parent) {
-    while (parent.parent()) {
-      parent = parent.parent();
-    }
-    parent_name = parent.name();
-  }
-  else {
-    parent_name = b_ob.name();
-  }
-  object->set_asset_name(parent_name);
+  object->set_asset_name(settings.asset_name);
 
   /* object sync
    * transform comparison should not be needed, but duplis don't work perfect
@@ -582,6 +609,7 @@ void BlenderSync::sync_objects(BL::Depsgraph &b_depsgraph,
     geometry_motion_synced.clear();
   }
   instance_geometries_by_object.clear();
+  object_instance_settings.clear();
 
   /* initialize culling */
   BlenderObjectCulling culling(scene, b_scene);
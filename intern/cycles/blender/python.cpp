@@ -868,6 +868,60 @@ static PyObject *enable_print_stats_func(PyObject * /*self*/, PyObject * /*args*
   Py_RETURN_NONE;
 }
 
+static PyObject *named_kernel_time_stats_to_py(const NamedKernelTimeStats &stats)
+{
+  PyObject *dict = PyDict_New();
+  for (const NamedKernelTimeEntry &entry : stats.entries) {
+    PyObject *item = Py_BuildValue("{s:d,s:K,s:K}",
+                                   "time",
+                                   entry.time,
+                                   "launches",
+                                   (unsigned long long)entry.num_launches,
+                                   "items",
+                                   (unsigned long long)entry.num_work_items);
+    PyDict_SetItemString(dict, entry.name.c_str(), item);
+    Py_DECREF(item);
+  }
+  return dict;
+}
+
+/* Kernel and shader execution statistics of the last render, only available when printing of
+ * render statistics is enabled. For CPU rendering the time per shader is estimated by the
+ * sampling profiler, and there are no per-kernel launches. */
+static PyObject *get_render_stats_func(PyObject * /*self*/, PyObject * /*args*/)
+{
+  RenderStats &stats = BlenderSession::last_render_stats;
+
+  PyObject *kernels, *shaders;
+  if (stats.has_kernel_profiling) {
+    kernels = named_kernel_time_stats_to_py(stats.gpu_kernels);
+    shaders = named_kernel_time_stats_to_py(stats.gpu_shaders);
+  }
+  else {
+    kernels = PyDict_New();
+    shaders = PyDict_New();
+    if (stats.has_profiling) {
+      foreach (NamedSampleCountStats::entry_map::const_reference entry, stats.shaders.entries) {
+        const NamedSampleCountPair &pair = entry.second;
+        PyObject *item = Py_BuildValue("{s:d,s:K}",
+                                       "time",
+                                       pair.samples * 0.001,
+                                       "items",
+                                       (unsigned long long)pair.hits);
+        PyDict_SetItemString(shaders, pair.name.c_str(), item);
+        Py_DECREF(item);
+      }
+    }
+  }
+
+  PyObject *result = PyDict_New();
+  PyDict_SetItemString(result, "kernels", kernels);
+  PyDict_SetItemString(result, "shaders", shaders);
+  Py_DECREF(kernels);
+  Py_DECREF(shaders);
+  return result;
+}
+
 static PyObject *get_device_types_func(PyObject * /*self*/, PyObject * /*args*/)
 {
   vector<DeviceType> device_types = Device::available_types();
@@ -956,6 +1010,7 @@ static PyMethodDef methods[] = {
 
     /* Statistics. */
     {"enable_print_stats", enable_print_stats_func, METH_NOARGS, ""},
+    {"get_render_stats", get_render_stats_func, METH_NOARGS, ""},
 
     /* Compute Device selection */
     {"get_device_types", get_device_types_func, METH_VARARGS, ""},
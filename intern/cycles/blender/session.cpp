@@ -40,6 +40,7 @@ CCL_NAMESPACE_BEGIN
 DeviceTypeMask BlenderSession::device_override = DEVICE_MASK_ALL;
 bool BlenderSession::headless = false;
 bool BlenderSession::print_render_stats = false;
+RenderStats BlenderSession::last_render_stats;
 
 BlenderSession::BlenderSession(BL::RenderEngine &b_engine,
                                BL::Preferences &b_userpref,
@@ -439,6 +440,7 @@ void BlenderSession::render(BL::Depsgraph &b_depsgraph_)
       RenderStats stats;
       session->collect_statistics(&stats);
       printf("Render statistics:\n%s\n", stats.full_report().c_str());
+      last_render_stats = stats;
     }
 
     if (session->progress.get_cancel())
@@ -12,6 +12,7 @@
 
 #include "scene/bake.h"
 #include "scene/scene.h"
+#include "scene/stats.h"
 #include "session/session.h"
 
 #include "util/vector.h"
@@ -119,6 +120,9 @@ class BlenderSession {
 
   static bool print_render_stats;
 
+  /* Statistics of the last render, when printing of render statistics is enabled. */
+  static RenderStats last_render_stats;
+
  protected:
   void stamp_view_layer_metadata(Scene *scene, const string &view_layer_name);
 
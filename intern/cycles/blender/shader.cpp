@@ -1337,7 +1337,11 @@ void BlenderSync::sync_materials(BL::Depsgraph &b_depsgraph, bool update_all)
       shader->set_volume_step_rate(get_float(cmat, "volume_step_rate"));
       shader->set_displacement_method(get_displacement_method(cmat));
 
-      shader->set_graph(graph);
+      /* Frame changes re-sync all shaders when images are animated, avoid recompiling
+       * the ones that did not change. */
+      if (!shader->update_graph(graph)) {
+        continue;
+      }
 
       /* By simplifying the shader graph as soon as possible, some
        * redundant shader nodes might be removed which prevents loading
@@ -1483,8 +1487,9 @@ void BlenderSync::sync_world(BL::Depsgraph &b_depsgraph, BL::SpaceView3D &b_v3d,
       background->set_visibility(visibility);
     }
 
-    shader->set_graph(graph);
-    shader->tag_update(scene);
+    if (shader->update_graph(graph)) {
+      shader->tag_update(scene);
+    }
   }
 
   /* Fast GI */
@@ -1568,8 +1573,9 @@ void BlenderSync::sync_lights(BL::Depsgraph &b_depsgraph, bool update_all)
         graph->connect(emission->output("Emission"), out->input("Surface"));
       }
 
-      shader->set_graph(graph);
-      shader->tag_update(scene);
+      if (shader->update_graph(graph)) {
+        shader->tag_update(scene);
+      }
     }
   }
 }
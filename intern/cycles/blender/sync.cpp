@@ -57,6 +57,7 @@ BlenderSync::BlenderSync(BL::RenderEngine &b_engine,
       preview(preview),
       experimental(false),
       use_developer_ui(use_developer_ui),
+      use_mesh_sync_hash(false),
       dicing_rate(1.0f),
       max_subdivisions(12),
       progress(progress),
@@ -262,6 +263,7 @@ void BlenderSync::sync_data(BL::RenderSettings &b_render,
   /* TODO(sergey): This feels weak to pass view layer to the integrator, and even weaker to have an
    * implicit check on whether it is a background render or not. What is the nicer thing here? */
   const bool background = !b_v3d;
+  use_mesh_sync_hash = background && b_render.use_persistent_data();
 
   sync_view_layer(b_view_layer);
   sync_integrator(b_view_layer, background);
@@ -315,6 +317,7 @@ void BlenderSync::sync_integrator(BL::ViewLayer &b_view_layer, bool background)
   float volume_step_rate = (preview) ? get_float(cscene, "volume_preview_step_rate") :
                                        get_float(cscene, "volume_step_rate");
   integrator->set_volume_step_rate(volume_step_rate);
+  integrator->set_volume_skip_empty(get_boolean(cscene, "volume_skip_empty"));
 
   integrator->set_caustics_reflective(get_boolean(cscene, "caustics_reflective"));
   integrator->set_caustics_refractive(get_boolean(cscene, "caustics_refractive"));
@@ -341,6 +344,11 @@ void BlenderSync::sync_integrator(BL::ViewLayer &b_view_layer, bool background)
   }
 
   integrator->set_light_sampling_threshold(get_float(cscene, "light_sampling_threshold"));
+  integrator->set_use_light_tree(get_boolean(cscene, "use_light_tree"));
+
+  integrator->set_use_guiding(get_boolean(cscene, "use_guiding"));
+  integrator->set_guiding_training_samples(get_int(cscene, "guiding_training_samples"));
+  integrator->set_guiding_probability(get_float(cscene, "guiding_probability"));
 
   SamplingPattern sampling_pattern = (SamplingPattern)get_enum(
       cscene, "sampling_pattern", SAMPLING_NUM_PATTERNS, SAMPLING_PATTERN_SOBOL);
@@ -819,6 +827,9 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene, bool background)
     params.texture_limit = 0;
   }
 
+  params.texture_memory_limit = (size_t)RNA_int_get(&cscene, "texture_memory_limit") * 1024 *
+                                1024;
+
   params.bvh_layout = DebugFlags().cpu.bvh_layout;
 
   params.background = background;
@@ -912,7 +923,7 @@ SessionParams BlenderSync::get_session_params(BL::RenderEngine &b_engine,
   }
 
   /* Profiling. */
-  params.use_profiling = params.device.has_profiling && !b_engine.is_preview() && background &&
+  params.use_profiling = !b_engine.is_preview() && background &&
                          BlenderSession::print_render_stats;
 
   if (background) {
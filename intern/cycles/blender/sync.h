@@ -204,6 +204,9 @@ class BlenderSync {
   bool object_is_geometry(BObjectInfo &b_ob_info);
   bool object_can_have_geometry(BL::Object &b_ob);
   bool object_is_light(BL::Object &b_ob);
+  const ObjectInstanceSettings &object_instance_settings_get(BObjectInfo &b_ob_info,
+                                                             BL::Object &b_parent,
+                                                             BL::ViewLayer &b_view_layer);
 
   /* variables */
   BL::RenderEngine b_engine;
@@ -221,6 +224,18 @@ class BlenderSync {
   set<Geometry *> geometry_motion_attribute_synced;
   /** Remember which geometries come from which objects to be able to sync them after changes. */
   map<void *, set<BL::ID>> instance_geometries_by_object;
+  /** Object settings that are the same for all instances of an object with the same parent,
+   * looked up through RNA once per sync instead of for every instance. */
+  struct ObjectInstanceSettings {
+    uint visibility;
+    bool use_holdout;
+    bool is_shadow_catcher;
+    float shadow_terminator_shading_offset;
+    float shadow_terminator_geometry_offset;
+    float ao_distance;
+    ustring asset_name;
+  };
+  map<pair<void *, void *>, ObjectInstanceSettings> object_instance_settings;
   set<float> motion_times;
   void *world_map;
   bool world_recalc;
@@ -230,6 +245,9 @@ class BlenderSync {
   bool preview;
   bool experimental;
   bool use_developer_ui;
+  /* Skip updating meshes which are synced again with identical data. Hashing the mesh data is
+   * only worth it for background renders with persistent data. */
+  bool use_mesh_sync_hash;
 
   float dicing_rate;
   int max_subdivisions;
@@ -14,10 +14,29 @@
 #include "bvh/unaligned.h"
 
 #include "util/foreach.h"
+#include "util/log.h"
 #include "util/progress.h"
 
 CCL_NAMESPACE_BEGIN
 
+/* Rebuild instead of refit once the bounds have grown this much, moving geometry makes the
+ * nodes overlap more with each refit. */
+static const float refit_max_area_ratio = 1.5f;
+
+static float node_children_area_sum(const BVHNode *node)
+{
+  if (node->is_leaf()) {
+    return 0.0f;
+  }
+
+  float area = 0.0f;
+  for (int i = 0; i < node->num_children(); i++) {
+    const BVHNode *child = node->get_child(i);
+    area += child->bounds.safe_area() + node_children_area_sum(child);
+  }
+  return area;
+}
+
 BVHStackEntry::BVHStackEntry(const BVHNode *n, int i) : node(n), idx(i)
 {
 }
@@ -82,12 +101,29 @@ void BVH2::build(Progress &progress, Stats *)
   progress.set_substatus("Packing BVH nodes");
   pack_nodes(root);
 
+  const float root_area = root->bounds.safe_area();
+  build_area_ratio = (root_area > 0.0f) ? node_children_area_sum(root) / root_area : 0.0f;
+  refit_area_ratio = build_area_ratio;
+
   /* free build nodes */
   root->deleteSubtree();
 }
 
 void BVH2::refit(Progress &progress)
 {
+  if (params.top_level) {
+    /* Drop the merged instance BVH's, they are merged again after refitting the top level
+     * nodes since they may have been refit themselves. */
+    pack.prim_index.resize(top_level_prims_size);
+    pack.prim_type.resize(top_level_prims_size);
+    pack.prim_object.resize(top_level_prims_size);
+    if (pack.prim_time.size()) {
+      pack.prim_time.resize(top_level_prims_size);
+    }
+    pack.nodes.resize(top_level_nodes_size);
+    pack.leaf_nodes.resize(top_level_leaf_nodes_size);
+  }
+
   progress.set_substatus("Packing BVH primitives");
   pack_primitives();
 
@@ -96,6 +132,22 @@ void BVH2::refit(Progress &progress)
 
   progress.set_substatus("Refitting BVH nodes");
   refit_nodes();
+
+  if (refit_degraded()) {
+    VLOG(1) << "Refit BVH degraded, rebuilding.";
+    build(progress, NULL);
+    return;
+  }
+
+  if (params.top_level) {
+    progress.set_substatus("Packing BVH instances");
+    merge_instances(top_level_nodes_size, top_level_leaf_nodes_size);
+  }
+}
+
+bool BVH2::refit_degraded() const
+{
+  return build_area_ratio > 0.0f && refit_area_ratio > build_area_ratio * refit_max_area_ratio;
 }
 
 BVHNode *BVH2::widen_children_nodes(const BVHNode *root)
@@ -303,11 +355,13 @@ void BVH2::pack_nodes(const BVHNode *root)
 
 void BVH2::refit_nodes()
 {
-  assert(!params.top_level);
-
   BoundBox bbox = BoundBox::empty;
   uint visibility = 0;
+  refit_area_sum = 0.0f;
   refit_node(0, (pack.root_index == -1) ? true : false, bbox, visibility);
+
+  const float root_area = bbox.safe_area();
+  refit_area_ratio = (root_area > 0.0f) ? refit_area_sum / root_area : 0.0f;
 }
 
 void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
@@ -319,7 +373,13 @@ void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
     const int c0 = data[0].x;
     const int c1 = data[0].y;
 
-    refit_primitives(c0, c1, bbox, visibility);
+    if (c0 < 0) {
+      /* Object instance in the top level BVH. */
+      refit_primitives(~c0, ~c0 + 1, bbox, visibility);
+    }
+    else {
+      refit_primitives(c0, c1, bbox, visibility);
+    }
 
     /* TODO(sergey): De-duplicate with pack_leaf(). */
     float4 leaf_data[BVH_NODE_LEAF_SIZE];
@@ -355,6 +415,7 @@ void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
     bbox.grow(bbox0);
     bbox.grow(bbox1);
     visibility = visibility0 | visibility1;
+    refit_area_sum += bbox0.safe_area() + bbox1.safe_area();
   }
 }
 
@@ -483,6 +544,15 @@ void BVH2::pack_instances(size_t nodes_size, size_t leaf_nodes_size)
     }
   }
 
+  top_level_prims_size = pack.prim_index.size();
+  top_level_nodes_size = nodes_size;
+  top_level_leaf_nodes_size = leaf_nodes_size;
+
+  merge_instances(nodes_size, leaf_nodes_size);
+}
+
+void BVH2::merge_instances(size_t nodes_size, size_t leaf_nodes_size)
+{
   /* track offsets of instanced BVH data in global array */
   size_t prim_offset = pack.prim_index.size();
   size_t nodes_offset = nodes_size;
@@ -80,6 +80,7 @@ class BVH2 : public BVH {
   /* refit */
   void refit_nodes();
   void refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility);
+  bool refit_degraded() const;
 
   /* Refit range of primitives. */
   void refit_primitives(int start, int end, BoundBox &bbox, uint &visibility);
@@ -90,6 +91,19 @@ class BVH2 : public BVH {
 
   /* merge instance BVH's */
   void pack_instances(size_t nodes_size, size_t leaf_nodes_size);
+  void merge_instances(size_t nodes_size, size_t leaf_nodes_size);
+
+  /* Sizes of the top level BVH without the merged instance BVH's, to merge them again after
+   * refitting. */
+  size_t top_level_prims_size = 0;
+  size_t top_level_nodes_size = 0;
+  size_t top_level_leaf_nodes_size = 0;
+
+  /* Sum of the child node areas relative to the root area, as a measure of the traversal cost
+   * when the BVH was built and after the last refit. */
+  float build_area_ratio = 0.0f;
+  float refit_area_ratio = 0.0f;
+  float refit_area_sum = 0.0f;
 };
 
 CCL_NAMESPACE_END
@@ -457,12 +457,24 @@ void BVHEmbree::add_instance(Object *ob, int i)
   BVHEmbree *instance_bvh = (BVHEmbree *)(ob->get_geometry()->bvh);
   assert(instance_bvh != NULL);
 
+  RTCGeometry geom_id = rtcNewGeometry(rtc_device, RTC_GEOMETRY_TYPE_INSTANCE);
+  rtcSetGeometryInstancedScene(geom_id, instance_bvh->scene);
+  set_instance_transform(geom_id, ob);
+
+  rtcSetGeometryUserData(geom_id, (void *)instance_bvh->scene);
+  rtcSetGeometryMask(geom_id, ob->visibility_for_tracing());
+
+  rtcCommitGeometry(geom_id);
+  rtcAttachGeometryByID(scene, geom_id, i * 2);
+  rtcReleaseGeometry(geom_id);
+}
+
+void BVHEmbree::set_instance_transform(RTCGeometry geom_id, const Object *ob)
+{
   const size_t num_object_motion_steps = ob->use_motion() ? ob->get_motion().size() : 1;
   const size_t num_motion_steps = min(num_object_motion_steps, (size_t)RTC_MAX_TIME_STEP_COUNT);
   assert(num_object_motion_steps <= RTC_MAX_TIME_STEP_COUNT);
 
-  RTCGeometry geom_id = rtcNewGeometry(rtc_device, RTC_GEOMETRY_TYPE_INSTANCE);
-  rtcSetGeometryInstancedScene(geom_id, instance_bvh->scene);
   rtcSetGeometryTimeStepCount(geom_id, num_motion_steps);
 
   if (ob->use_motion()) {
@@ -486,13 +498,6 @@ void BVHEmbree::add_instance(Object *ob, int i)
     rtcSetGeometryTransform(
         geom_id, 0, RTC_FORMAT_FLOAT3X4_ROW_MAJOR, (const float *)&ob->get_tfm());
   }
-
-  rtcSetGeometryUserData(geom_id, (void *)instance_bvh->scene);
-  rtcSetGeometryMask(geom_id, ob->visibility_for_tracing());
-
-  rtcCommitGeometry(geom_id);
-  rtcAttachGeometryByID(scene, geom_id, i * 2);
-  rtcReleaseGeometry(geom_id);
 }
 
 void BVHEmbree::add_triangles(const Object *ob, const Mesh *mesh, int i)
@@ -850,6 +855,14 @@ void BVHEmbree::refit(Progress &progress)
         }
       }
     }
+    else if (ob->is_traceable()) {
+      /* Instances only need their transform updated, the instanced scene was refit in place.
+       * Embree then only rebuilds the top level over the instances. */
+      RTCGeometry geom = rtcGetGeometry(scene, geom_id);
+      set_instance_transform(geom, ob);
+      rtcSetGeometryMask(geom, ob->visibility_for_tracing());
+      rtcCommitGeometry(geom);
+    }
     geom_id += 2;
   }
 
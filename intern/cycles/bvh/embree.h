@@ -48,6 +48,7 @@ class BVHEmbree : public BVH {
   void set_point_vertex_buffer(RTCGeometry geom_id,
                                const PointCloud *pointcloud,
                                const bool update);
+  void set_instance_transform(RTCGeometry geom_id, const Object *ob);
 
   RTCDevice rtc_device;
   enum RTCBuildQuality build_quality;
@@ -61,6 +61,8 @@ const char *device_kernel_as_string(DeviceKernel kernel)
       return "integrator_reset";
     case DEVICE_KERNEL_INTEGRATOR_SHADOW_CATCHER_COUNT_POSSIBLE_SPLITS:
       return "integrator_shadow_catcher_count_possible_splits";
+    case DEVICE_KERNEL_INTEGRATOR_INIT_FROM_ACTIVE_PIXELS:
+      return "integrator_init_from_active_pixels";
 
     /* Shader evaluation. */
     case DEVICE_KERNEL_SHADER_EVAL_DISPLACE:
@@ -101,6 +103,8 @@ const char *device_kernel_as_string(DeviceKernel kernel)
       return "adaptive_sampling_filter_x";
     case DEVICE_KERNEL_ADAPTIVE_SAMPLING_CONVERGENCE_FILTER_Y:
       return "adaptive_sampling_filter_y";
+    case DEVICE_KERNEL_ADAPTIVE_SAMPLING_ACTIVE_PIXELS_ARRAY:
+      return "adaptive_sampling_active_pixels_array";
 
     /* Denoising. */
     case DEVICE_KERNEL_FILTER_GUIDING_PREPROCESS:
@@ -6,6 +6,7 @@
 #include "kernel/types.h"
 
 #include "util/string.h"
+#include "util/vector.h"
 
 #include <ostream>  // NOLINT
 
@@ -17,4 +18,70 @@ std::ostream &operator<<(std::ostream &os, DeviceKernel kernel);
 typedef uint64_t DeviceKernelMask;
 string device_kernel_mask_as_string(DeviceKernelMask mask);
 
+/* Execution time and amount of work of kernel launches. */
+struct DeviceKernelStatistics {
+  double time = 0.0;
+  uint64_t num_launches = 0;
+  uint64_t num_work_items = 0;
+
+  void add(const double launch_time, const int work_size)
+  {
+    time += launch_time;
+    num_launches++;
+    num_work_items += work_size;
+  }
+
+  void add(const DeviceKernelStatistics &other)
+  {
+    time += other.time;
+    num_launches += other.num_launches;
+    num_work_items += other.num_work_items;
+  }
+};
+
+/* Per-kernel and per-shader execution statistics, collected when rendering with kernel
+ * profiling. Shaders are indexed by their shader ID, and the statistics are for the surface
+ * shading kernels. */
+class DeviceKernelProfiling {
+ public:
+  void add_kernel(const DeviceKernel kernel, const double time, const int work_size)
+  {
+    kernels[kernel].add(time, work_size);
+  }
+
+  void add_shader(const int shader, const double time, const int work_size)
+  {
+    if (shader >= shaders.size()) {
+      shaders.resize(shader + 1);
+    }
+    shaders[shader].add(time, work_size);
+  }
+
+  void add(const DeviceKernelProfiling &other)
+  {
+    for (int i = 0; i < DEVICE_KERNEL_NUM; i++) {
+      kernels[i].add(other.kernels[i]);
+    }
+    if (other.shaders.size() > shaders.size()) {
+      shaders.resize(other.shaders.size());
+    }
+    for (size_t i = 0; i < other.shaders.size(); i++) {
+      shaders[i].add(other.shaders[i]);
+    }
+  }
+
+  bool empty() const
+  {
+    for (int i = 0; i < DEVICE_KERNEL_NUM; i++) {
+      if (kernels[i].num_launches) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  DeviceKernelStatistics kernels[DEVICE_KERNEL_NUM];
+  vector<DeviceKernelStatistics> shaders;
+};
+
 CCL_NAMESPACE_END
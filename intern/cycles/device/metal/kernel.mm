@@ -478,7 +478,8 @@ bool MetalDeviceKernels::load(MetalDevice *device, int kernel_type)
         const std::string function_name = std::string("cycles_metal_") +
                                           device_kernel_as_string((DeviceKernel)i);
         int threads_per_threadgroup = device->max_threads_per_threadgroup;
-        if (i > DEVICE_KERNEL_INTEGRATOR_MEGAKERNEL && i < DEVICE_KERNEL_INTEGRATOR_RESET) {
+        if ((i > DEVICE_KERNEL_INTEGRATOR_MEGAKERNEL && i < DEVICE_KERNEL_INTEGRATOR_RESET) ||
+            i == DEVICE_KERNEL_ADAPTIVE_SAMPLING_ACTIVE_PIXELS_ARRAY) {
           /* Always use 512 for the sorting kernels */
           threads_per_threadgroup = 512;
         }
@@ -33,6 +33,28 @@ static bool oidn_progress_monitor_function(void *user_ptr, double /*n*/)
   return !oidn_denoiser->is_cancelled();
 }
 
+/* Upper bound for the scratch memory used by a single filter. OIDN splits larger images into
+ * overlapping tiles internally to stay within this limit, so memory use does not grow with the
+ * image resolution. The default is lower than the OIDN default, which for high resolution renders
+ * adds several gigabytes at the end of the render. */
+static int oidn_max_memory_mb()
+{
+  int max_memory_mb = 1024;
+
+  const char *max_memory_str = getenv("CYCLES_OIDN_MAX_MEMORY_MB");
+  if (max_memory_str) {
+    const int value = atoi(max_memory_str);
+    if (value > 0) {
+      max_memory_mb = value;
+    }
+    else {
+      VLOG(3) << "CYCLES_OIDN_MAX_MEMORY_MB is not a positive number";
+    }
+  }
+
+  return max_memory_mb;
+}
+
 class OIDNPass {
  public:
   OIDNPass() = default;
@@ -163,6 +185,7 @@ class OIDNDenoiseContext {
     oidn_filter.setProgressMonitorFunction(oidn_progress_monitor_function, denoiser_);
     oidn_filter.set("hdr", true);
     oidn_filter.set("srgb", false);
+    oidn_filter.set("maxMemoryMB", oidn_max_memory_mb());
     if (denoise_params_.prefilter == DENOISER_PREFILTER_NONE ||
         denoise_params_.prefilter == DENOISER_PREFILTER_ACCURATE) {
       oidn_filter.set("cleanAux", true);
@@ -196,6 +219,7 @@ class OIDNDenoiseContext {
     oidn::FilterRef oidn_filter = oidn_device.newFilter("RT");
     set_pass(oidn_filter, oidn_pass);
     set_output_pass(oidn_filter, oidn_pass);
+    oidn_filter.set("maxMemoryMB", oidn_max_memory_mb());
     oidn_filter.commit();
     oidn_filter.execute();
 
@@ -179,6 +179,8 @@ void PathTrace::render_pipeline(RenderWork render_work)
     return;
   }
 
+  update_guiding(render_work);
+
   adaptive_sample(render_work);
   if (render_cancel_.is_requested) {
     return;
@@ -338,6 +340,8 @@ void PathTrace::init_render_buffers(const RenderWork &render_work)
       path_trace_work->zero_render_buffers();
     });
 
+    reset_guiding();
+
     tile_buffer_read();
   }
 }
@@ -387,6 +391,78 @@ void PathTrace::path_trace(RenderWork &render_work)
       render_work, time_dt() - start_time, is_cancel_requested());
 }
 
+void PathTrace::reset_guiding()
+{
+  if (!(device_scene_->data.kernel_features & KERNEL_FEATURE_PATH_GUIDING) ||
+      device_scene_->guiding_train.size() == 0) {
+    return;
+  }
+
+  device_scene_->guiding_train.zero_to_device();
+  device_scene_->guiding_distribution.zero_to_device();
+}
+
+void PathTrace::update_guiding(const RenderWork &render_work)
+{
+  if (!(device_scene_->data.kernel_features & KERNEL_FEATURE_PATH_GUIDING) ||
+      device_scene_->guiding_train.size() == 0) {
+    return;
+  }
+
+  /* Build the distributions once, after the work which rendered the last training sample. */
+  const int training_end_sample = device_scene_->data.integrator.guiding_training_samples;
+  const int start_sample = render_work.path_trace.start_sample;
+  const int end_sample = start_sample + render_work.path_trace.num_samples;
+  if (!(start_sample < training_end_sample && end_sample >= training_end_sample)) {
+    return;
+  }
+
+  const double start_time = time_dt();
+
+  device_scene_->guiding_train.copy_from_device();
+
+  const float *train = device_scene_->guiding_train.data();
+  float *distribution = device_scene_->guiding_distribution.data();
+
+  const int num_cells = device_scene_->guiding_train.size() / GUIDING_NUM_BINS;
+
+  tbb::parallel_for(0, num_cells, [&](int cell) {
+    const float *cell_train = train + cell * GUIDING_NUM_BINS;
+    float *cell_cdf = distribution + cell * GUIDING_NUM_BINS;
+
+    float sum = 0.0f;
+    for (int bin = 0; bin < GUIDING_NUM_BINS; bin++) {
+      sum += cell_train[bin];
+    }
+
+    if (!(sum > 0.0f) || !isfinite_safe(sum)) {
+      /* Not enough data, fall back to BSDF sampling only. */
+      std::fill(cell_cdf, cell_cdf + GUIDING_NUM_BINS, 0.0f);
+      return;
+    }
+
+    /* Mix with a uniform distribution, so that directions which were not found to contribute
+     * during training can still be sampled. */
+    const float inv_sum = 1.0f / sum;
+    float cdf = 0.0f;
+    for (int bin = 0; bin < GUIDING_NUM_BINS; bin++) {
+      cdf += 0.8f * cell_train[bin] * inv_sum + 0.2f / GUIDING_NUM_BINS;
+      cell_cdf[bin] = cdf;
+    }
+
+    /* Normalize to exactly one to avoid precision issues in the kernel search. */
+    const float inv_cdf = 1.0f / cdf;
+    for (int bin = 0; bin < GUIDING_NUM_BINS; bin++) {
+      cell_cdf[bin] *= inv_cdf;
+    }
+    cell_cdf[GUIDING_NUM_BINS - 1] = 1.0f;
+  });
+
+  device_scene_->guiding_distribution.copy_to_device();
+
+  VLOG(3) << "Built path guiding distributions in " << time_dt() - start_time << " seconds.";
+}
+
 void PathTrace::adaptive_sample(RenderWork &render_work)
 {
   if (!render_work.adaptive_sampling.filter) {
@@ -416,6 +492,10 @@ void PathTrace::adaptive_sample(RenderWork &render_work)
 
     render_scheduler_.report_adaptive_filter_time(
         render_work, time_dt() - start_time, is_cancel_requested());
+    render_scheduler_.report_adaptive_filter_active_pixels(
+        num_active_pixels,
+        render_state_.effective_big_tile_params.width *
+            render_state_.effective_big_tile_params.height);
 
     if (num_active_pixels == 0) {
       VLOG(3) << "All pixels converged.";
@@ -476,6 +556,22 @@ void PathTrace::set_adaptive_sampling(const AdaptiveSampling &adaptive_sampling)
   render_scheduler_.set_adaptive_sampling(adaptive_sampling);
 }
 
+void PathTrace::set_use_kernel_profiling(bool use_kernel_profiling)
+{
+  for (auto &&path_trace_work : path_trace_works_) {
+    path_trace_work->set_use_kernel_profiling(use_kernel_profiling);
+  }
+}
+
+DeviceKernelProfiling PathTrace::get_kernel_profiling() const
+{
+  DeviceKernelProfiling kernel_profiling;
+  for (auto &&path_trace_work : path_trace_works_) {
+    kernel_profiling.add(path_trace_work->get_kernel_profiling());
+  }
+  return kernel_profiling;
+}
+
 void PathTrace::cryptomatte_postprocess(const RenderWork &render_work)
 {
   if (!render_work.cryptomatte.postprocess) {
@@ -915,19 +1011,19 @@ bool PathTrace::copy_render_tile_from_device()
   return success;
 }
 
-static string get_layer_view_name(const RenderBuffers &buffers)
+static string get_layer_view_name(const BufferParams &buffer_params)
 {
   string result;
 
-  if (buffers.params.layer.size()) {
-    result += string(buffers.params.layer);
+  if (buffer_params.layer.size()) {
+    result += string(buffer_params.layer);
   }
 
-  if (buffers.params.view.size()) {
+  if (buffer_params.view.size()) {
     if (!result.empty()) {
       result += ", ";
     }
-    result += string(buffers.params.view);
+    result += string(buffer_params.view);
   }
 
   return result;
@@ -939,51 +1035,81 @@ void PathTrace::process_full_buffer_from_disk(string_view filename)
 
   progress_set_status("Reading full buffer from disk");
 
+  BufferParams buffer_params;
+  DenoiseParams denoise_params;
   RenderBuffers full_frame_buffers(cpu_device_.get());
 
-  DenoiseParams denoise_params;
-  if (!tile_manager_.read_full_buffer_from_disk(filename, &full_frame_buffers, &denoise_params)) {
-    const string error_message = "Error reading tiles from file";
-    if (progress_) {
-      progress_->set_error(error_message);
-      progress_->set_cancel(error_message);
-    }
-    else {
-      LOG(ERROR) << error_message;
-    }
-    return;
-  }
+  bool success = tile_manager_.open_full_buffer_from_disk(
+      filename, &buffer_params, &denoise_params);
 
-  const string layer_view_name = get_layer_view_name(full_frame_buffers);
+  const string layer_view_name = get_layer_view_name(buffer_params);
 
   render_state_.has_denoised_result = false;
 
-  if (denoise_params.use) {
-    progress_set_status(layer_view_name, "Denoising");
+  if (success && denoise_params.use) {
+    /* The denoiser needs the full frame at once. */
+    success = tile_manager_.read_full_buffer_rows_from_disk(
+        0, buffer_params.height, &full_frame_buffers);
+
+    if (success) {
+      progress_set_status(layer_view_name, "Denoising");
 
-    /* Re-use the denoiser as much as possible, avoiding possible device re-initialization.
-     *
-     * It will not conflict with the regular rendering as:
-     *  - Rendering is supposed to be finished here.
-     *  - The next rendering will go via Session's `run_update_for_next_iteration` which will
-     *    ensure proper denoiser is used. */
-    set_denoiser_params(denoise_params);
+      /* Re-use the denoiser as much as possible, avoiding possible device re-initialization.
+       *
+       * It will not conflict with the regular rendering as:
+       *  - Rendering is supposed to be finished here.
+       *  - The next rendering will go via Session's `run_update_for_next_iteration` which will
+       *    ensure proper denoiser is used. */
+      set_denoiser_params(denoise_params);
 
-    /* Number of samples doesn't matter too much, since the samples count pass will be used. */
-    denoiser_->denoise_buffer(full_frame_buffers.params, &full_frame_buffers, 0, false);
+      /* Number of samples doesn't matter too much, since the samples count pass will be used. */
+      denoiser_->denoise_buffer(full_frame_buffers.params, &full_frame_buffers, 0, false);
 
-    render_state_.has_denoised_result = true;
+      render_state_.has_denoised_result = true;
+
+      progress_set_status(layer_view_name, "Finishing");
+
+      /* Write the full result pretending that there is a single tile.
+       * Requires some state change, but allows to use same communication API with the
+       * software. */
+      full_frame_state_.render_buffers = &full_frame_buffers;
+      full_frame_state_.offset = make_int2(0, 0);
+      tile_buffer_write();
+    }
   }
+  else if (success) {
+    progress_set_status(layer_view_name, "Finishing");
 
-  full_frame_state_.render_buffers = &full_frame_buffers;
+    /* Without denoising there is no need to have the full frame with all passes in memory at
+     * once. Stream the file to the software in bands of rows, each written as a tile. */
+    const int read_rows = tile_manager_.get_full_buffer_read_rows();
+    for (int y = 0; y < buffer_params.height && success; y += read_rows) {
+      const int height = min(read_rows, buffer_params.height - y);
 
-  progress_set_status(layer_view_name, "Finishing");
+      success = tile_manager_.read_full_buffer_rows_from_disk(y, height, &full_frame_buffers);
 
-  /* Write the full result pretending that there is a single tile.
-   * Requires some state change, but allows to use same communication API with the software. */
-  tile_buffer_write();
+      if (success) {
+        full_frame_state_.render_buffers = &full_frame_buffers;
+        full_frame_state_.offset = make_int2(0, y);
+        tile_buffer_write();
+      }
+    }
+  }
 
   full_frame_state_.render_buffers = nullptr;
+
+  tile_manager_.close_full_buffer_from_disk();
+
+  if (!success) {
+    const string error_message = "Error reading tiles from file";
+    if (progress_) {
+      progress_->set_error(error_message);
+      progress_->set_cancel(error_message);
+    }
+    else {
+      LOG(ERROR) << error_message;
+    }
+  }
 }
 
 int PathTrace::get_num_render_tile_samples() const
@@ -1047,7 +1173,7 @@ int2 PathTrace::get_render_tile_size() const
 int2 PathTrace::get_render_tile_offset() const
 {
   if (full_frame_state_.render_buffers) {
-    return make_int2(0, 0);
+    return full_frame_state_.offset;
   }
 
   const Tile &tile = tile_manager_.get_current_tile();
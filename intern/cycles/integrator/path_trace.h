@@ -89,6 +89,13 @@ class PathTrace {
    * Use this to configure the adaptive sampler before rendering any samples. */
   void set_adaptive_sampling(const AdaptiveSampling &adaptive_sampling);
 
+  /* Enable measuring execution time of every kernel launch on the GPU devices, see
+   * `PathTraceWork::set_use_kernel_profiling()`. */
+  void set_use_kernel_profiling(bool use_kernel_profiling);
+
+  /* Get kernel profiling statistics accumulated over all path trace works. */
+  DeviceKernelProfiling get_kernel_profiling() const;
+
   /* Sets output driver for render buffer output. */
   void set_output_driver(unique_ptr<OutputDriver> driver);
 
@@ -197,6 +204,7 @@ class PathTrace {
    * of rendering. */
   void init_render_buffers(const RenderWork &render_work);
   void path_trace(RenderWork &render_work);
+  void update_guiding(const RenderWork &render_work);
   void adaptive_sample(RenderWork &render_work);
   void denoise(const RenderWork &render_work);
   void cryptomatte_postprocess(const RenderWork &render_work);
@@ -205,6 +213,10 @@ class PathTrace {
   void write_tile_buffer(const RenderWork &render_work);
   void finalize_full_buffer_on_disk(const RenderWork &render_work);
 
+  /* Clear the path guiding training data and distributions, so that they are learned again for
+   * the new render. */
+  void reset_guiding();
+
   /* Get number of samples in the current state of the render buffers. */
   int get_num_samples_in_buffer();
 
@@ -308,9 +320,12 @@ class PathTrace {
    * Used by `ready_to_reset()` to implement logic which feels the most interactive. */
   bool did_draw_after_reset_ = true;
 
-  /* State of the full frame processing and writing to the software. */
+  /* State of the full frame processing and writing to the software.
+   * The full frame is written in bands of rows when it is not denoised, the offset is the position
+   * of the band within the full frame. */
   struct {
     RenderBuffers *render_buffers = nullptr;
+    int2 offset = make_int2(0, 0);
   } full_frame_state_;
 };
 
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "device/kernel.h"
 #include "integrator/pass_accessor.h"
 #include "scene/pass.h"
 #include "session/buffers.h"
@@ -140,6 +141,19 @@ class PathTraceWork {
     return device_;
   }
 
+  /* Kernel profiling: measure execution time of every kernel launch. This synchronizes the device
+   * after every kernel, so it is only to be used for performance analysis. Works which do not
+   * support it leave the statistics empty. */
+  void set_use_kernel_profiling(bool use_kernel_profiling)
+  {
+    use_kernel_profiling_ = use_kernel_profiling;
+  }
+
+  const DeviceKernelProfiling &get_kernel_profiling() const
+  {
+    return kernel_profiling_;
+  }
+
  protected:
   PathTraceWork(Device *device,
                 Film *film,
@@ -177,6 +191,9 @@ class PathTraceWork {
   BufferParams effective_buffer_params_;
 
   bool *cancel_requested_flag_ = nullptr;
+
+  bool use_kernel_profiling_ = false;
+  DeviceKernelProfiling kernel_profiling_;
 };
 
 CCL_NAMESPACE_END
@@ -73,6 +73,8 @@ PathTraceWorkGPU::PathTraceWorkGPU(Device *device,
       queued_paths_(device, "queued_paths", MEM_READ_WRITE),
       num_queued_paths_(device, "num_queued_paths", MEM_READ_WRITE),
       work_tiles_(device, "work_tiles", MEM_READ_WRITE),
+      adaptive_active_pixels_(device, "adaptive_active_pixels", MEM_READ_WRITE),
+      num_adaptive_active_pixels_(device, "num_adaptive_active_pixels", MEM_READ_WRITE),
       display_rgba_half_(device, "display buffer half", MEM_READ_WRITE),
       max_num_paths_(queue_->num_concurrent_states(estimate_single_state_size())),
       min_num_active_main_paths_(queue_->num_concurrent_busy_states()),
@@ -247,6 +249,11 @@ void PathTraceWorkGPU::render_samples(RenderStatistics &statistics,
   work_tile_scheduler_.set_max_num_path_states(max_num_paths_ / 8);
   work_tile_scheduler_.set_accelerated_rt((device_->get_bvh_layout_mask() & BVH_LAYOUT_OPTIX) !=
                                           0);
+  /* Only schedule pixels which are still active for adaptive sampling, when known. Baking is
+   * always scheduled in tiles, since it does not initialize paths from the camera. */
+  const bool use_active_pixels = has_adaptive_sampling_active_pixels() &&
+                                 !device_scene_->data.bake.use;
+  work_tile_scheduler_.set_num_active_pixels(use_active_pixels ? adaptive_active_pixels_num_ : 0);
   work_tile_scheduler_.reset(effective_buffer_params_,
                              start_sample,
                              samples_num,
@@ -323,7 +330,7 @@ void PathTraceWorkGPU::enqueue_reset()
 {
   DeviceKernelArguments args(&max_num_paths_);
 
-  queue_->enqueue(DEVICE_KERNEL_INTEGRATOR_RESET, max_num_paths_, args);
+  enqueue_kernel(DEVICE_KERNEL_INTEGRATOR_RESET, max_num_paths_, args);
   queue_->zero_to_device(integrator_queue_counter_);
   queue_->zero_to_device(integrator_shader_sort_counter_);
   queue_->zero_to_device(integrator_shader_raytrace_sort_counter_);
@@ -432,7 +439,7 @@ void PathTraceWorkGPU::enqueue_path_iteration(DeviceKernel kernel, const int num
       /* Closest ray intersection kernels with integrator state and render buffer. */
       DeviceKernelArguments args(&d_path_index, &buffers_->buffer.device_pointer, &work_size);
 
-      queue_->enqueue(kernel, work_size, args);
+      enqueue_kernel(kernel, work_size, args);
       break;
     }
 
@@ -442,7 +449,7 @@ void PathTraceWorkGPU::enqueue_path_iteration(DeviceKernel kernel, const int num
       /* Ray intersection kernels with integrator state. */
       DeviceKernelArguments args(&d_path_index, &work_size);
 
-      queue_->enqueue(kernel, work_size, args);
+      enqueue_kernel(kernel, work_size, args);
       break;
     }
     case DEVICE_KERNEL_INTEGRATOR_SHADE_BACKGROUND:
@@ -451,10 +458,15 @@ void PathTraceWorkGPU::enqueue_path_iteration(DeviceKernel kernel, const int num
     case DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE:
     case DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE_RAYTRACE:
     case DEVICE_KERNEL_INTEGRATOR_SHADE_VOLUME: {
+      if (use_kernel_profiling_ && kernel_uses_sorting(kernel) &&
+          enqueue_sorted_shading_per_shader(kernel, d_path_index, work_size)) {
+        break;
+      }
+
       /* Shading kernels with integrator state and render buffer. */
       DeviceKernelArguments args(&d_path_index, &buffers_->buffer.device_pointer, &work_size);
 
-      queue_->enqueue(kernel, work_size, args);
+      enqueue_kernel(kernel, work_size, args);
       break;
     }
 
@@ -465,6 +477,75 @@ void PathTraceWorkGPU::enqueue_path_iteration(DeviceKernel kernel, const int num
   }
 }
 
+void PathTraceWorkGPU::enqueue_kernel(DeviceKernel kernel,
+                                      const int work_size,
+                                      DeviceKernelArguments const &args)
+{
+  if (!use_kernel_profiling_) {
+    queue_->enqueue(kernel, work_size, args);
+    return;
+  }
+
+  /* Wait for previously enqueued work, so that only this kernel is measured. */
+  queue_->synchronize();
+
+  const double start_time = time_dt();
+  queue_->enqueue(kernel, work_size, args);
+  queue_->synchronize();
+
+  kernel_profiling_.add_kernel(kernel, time_dt() - start_time, work_size);
+}
+
+bool PathTraceWorkGPU::enqueue_sorted_shading_per_shader(DeviceKernel kernel,
+                                                         device_ptr d_path_index,
+                                                         const int work_size)
+{
+  /* Needs the path index array to be addressable with an offset. On Metal the device pointer is
+   * a handle to the buffer. */
+  if (device_->info.type == DEVICE_METAL) {
+    return false;
+  }
+
+  /* After filling the sorted paths array, the prefix sum of every shader is advanced to the end
+   * of its range of paths, which is the start of the range of the next shader. */
+  queue_->copy_from_device(integrator_shader_sort_prefix_sum_);
+  if (!queue_->synchronize()) {
+    return false;
+  }
+
+  const int *shader_end_offset = integrator_shader_sort_prefix_sum_.data();
+  const int max_shaders = device_scene_->data.max_shaders;
+
+  double total_time = 0.0;
+  int start_offset = 0;
+
+  for (int shader = 0; shader < max_shaders && start_offset < work_size; shader++) {
+    const int end_offset = min(shader_end_offset[shader], work_size);
+    int shader_work_size = end_offset - start_offset;
+    if (shader_work_size <= 0) {
+      continue;
+    }
+
+    device_ptr d_shader_path_index = d_path_index + start_offset * sizeof(int);
+    DeviceKernelArguments args(
+        &d_shader_path_index, &buffers_->buffer.device_pointer, &shader_work_size);
+
+    const double start_time = time_dt();
+    queue_->enqueue(kernel, shader_work_size, args);
+    queue_->synchronize();
+    const double shader_time = time_dt() - start_time;
+
+    kernel_profiling_.add_shader(shader, shader_time, shader_work_size);
+    total_time += shader_time;
+
+    start_offset = end_offset;
+  }
+
+  kernel_profiling_.add_kernel(kernel, total_time, work_size);
+
+  return true;
+}
+
 void PathTraceWorkGPU::compute_sorted_queued_paths(DeviceKernel kernel,
                                                    DeviceKernel queued_kernel,
                                                    const int num_paths_limit)
@@ -481,7 +562,7 @@ void PathTraceWorkGPU::compute_sorted_queued_paths(DeviceKernel kernel,
 
     DeviceKernelArguments args(&d_counter, &d_prefix_sum, &max_shaders);
 
-    queue_->enqueue(DEVICE_KERNEL_PREFIX_SUM, work_size, args);
+    enqueue_kernel(DEVICE_KERNEL_PREFIX_SUM, work_size, args);
   }
 
   queue_->zero_to_device(num_queued_paths_);
@@ -506,7 +587,7 @@ void PathTraceWorkGPU::compute_sorted_queued_paths(DeviceKernel kernel,
                                &d_prefix_sum,
                                &d_queued_kernel);
 
-    queue_->enqueue(kernel, work_size, args);
+    enqueue_kernel(kernel, work_size, args);
   }
 }
 
@@ -522,7 +603,7 @@ void PathTraceWorkGPU::compute_queued_paths(DeviceKernel kernel, DeviceKernel qu
   DeviceKernelArguments args(&work_size, &d_queued_paths, &d_num_queued_paths, &d_queued_kernel);
 
   queue_->zero_to_device(num_queued_paths_);
-  queue_->enqueue(kernel, work_size, args);
+  enqueue_kernel(kernel, work_size, args);
 }
 
 void PathTraceWorkGPU::compact_main_paths(const int num_active_paths)
@@ -607,7 +688,7 @@ void PathTraceWorkGPU::compact_paths(const int num_active_paths,
     DeviceKernelArguments args(&work_size, &d_compact_paths, &d_num_queued_paths, &offset);
 
     queue_->zero_to_device(num_queued_paths_);
-    queue_->enqueue(terminated_paths_kernel, work_size, args);
+    enqueue_kernel(terminated_paths_kernel, work_size, args);
   }
 
   /* Create array of paths that we need to compact, where the path index is bigger
@@ -619,7 +700,7 @@ void PathTraceWorkGPU::compact_paths(const int num_active_paths,
         &work_size, &d_compact_paths, &d_num_queued_paths, &num_active_paths);
 
     queue_->zero_to_device(num_queued_paths_);
-    queue_->enqueue(compact_paths_kernel, work_size, args);
+    enqueue_kernel(compact_paths_kernel, work_size, args);
   }
 
   queue_->copy_from_device(num_queued_paths_);
@@ -636,7 +717,7 @@ void PathTraceWorkGPU::compact_paths(const int num_active_paths,
     DeviceKernelArguments args(
         &d_compact_paths, &active_states_offset, &terminated_states_offset, &work_size);
 
-    queue_->enqueue(compact_kernel, work_size, args);
+    enqueue_kernel(compact_kernel, work_size, args);
   }
 }
 
@@ -725,8 +806,15 @@ bool PathTraceWorkGPU::enqueue_work_tiles(bool &finished)
     queue_->copy_to_device(integrator_next_main_path_index_);
   }
 
-  enqueue_work_tiles((device_scene_->data.bake.use) ? DEVICE_KERNEL_INTEGRATOR_INIT_FROM_BAKE :
-                                                      DEVICE_KERNEL_INTEGRATOR_INIT_FROM_CAMERA,
+  DeviceKernel init_kernel = DEVICE_KERNEL_INTEGRATOR_INIT_FROM_CAMERA;
+  if (device_scene_->data.bake.use) {
+    init_kernel = DEVICE_KERNEL_INTEGRATOR_INIT_FROM_BAKE;
+  }
+  else if (has_adaptive_sampling_active_pixels()) {
+    init_kernel = DEVICE_KERNEL_INTEGRATOR_INIT_FROM_ACTIVE_PIXELS;
+  }
+
+  enqueue_work_tiles(init_kernel,
                      work_tiles.data(),
                      work_tiles.size(),
                      num_active_paths,
@@ -768,10 +856,24 @@ void PathTraceWorkGPU::enqueue_work_tiles(DeviceKernel kernel,
   device_ptr d_render_buffer = buffers_->buffer.device_pointer;
 
   /* Launch kernel. */
-  DeviceKernelArguments args(
-      &d_work_tiles, &num_work_tiles, &d_render_buffer, &max_tile_work_size);
+  if (kernel == DEVICE_KERNEL_INTEGRATOR_INIT_FROM_ACTIVE_PIXELS) {
+    DeviceKernelArguments args(&d_work_tiles,
+                               &num_work_tiles,
+                               &d_render_buffer,
+                               &max_tile_work_size,
+                               &adaptive_active_pixels_.device_pointer,
+                               &effective_buffer_params_.full_x,
+                               &effective_buffer_params_.full_y,
+                               &effective_buffer_params_.width);
+
+    enqueue_kernel(kernel, max_tile_work_size * num_work_tiles, args);
+  }
+  else {
+    DeviceKernelArguments args(
+        &d_work_tiles, &num_work_tiles, &d_render_buffer, &max_tile_work_size);
 
-  queue_->enqueue(kernel, max_tile_work_size * num_work_tiles, args);
+    enqueue_kernel(kernel, max_tile_work_size * num_work_tiles, args);
+  }
 
   max_active_main_path_index_ = path_index_offset + num_predicted_splits;
 }
@@ -946,12 +1048,79 @@ int PathTraceWorkGPU::adaptive_sampling_converge_filter_count_active(float thres
   if (num_active_pixels) {
     enqueue_adaptive_sampling_filter_x();
     enqueue_adaptive_sampling_filter_y();
+    build_adaptive_sampling_active_pixels(num_active_pixels);
     queue_->synchronize();
   }
+  else {
+    adaptive_active_pixels_num_ = 0;
+  }
 
   return num_active_pixels;
 }
 
+void PathTraceWorkGPU::build_adaptive_sampling_active_pixels(
+    const int num_active_pixels_before_filter)
+{
+  const int num_pixels = effective_buffer_params_.width * effective_buffer_params_.height;
+
+  /* Scheduling all pixels in tiles is cheaper while a large part of the image is active, since
+   * converged pixels only cost a quick check in the init kernel then. */
+  if (num_active_pixels_before_filter > num_pixels / 4) {
+    adaptive_active_pixels_num_ = 0;
+    return;
+  }
+
+  /* The filter activates at most the 8 neighbors of every active pixel. */
+  const int max_num_active_pixels = min(num_pixels, num_active_pixels_before_filter * 9);
+  if (adaptive_active_pixels_.size() < max_num_active_pixels) {
+    adaptive_active_pixels_.alloc(max_num_active_pixels);
+    /* TODO: this could be skip if we had a function to just allocate on device. */
+    queue_->zero_to_device(adaptive_active_pixels_);
+  }
+  if (num_adaptive_active_pixels_.size() == 0) {
+    num_adaptive_active_pixels_.alloc(1);
+  }
+
+  queue_->zero_to_device(num_adaptive_active_pixels_);
+
+  DeviceKernelArguments args(&buffers_->buffer.device_pointer,
+                             &effective_buffer_params_.full_x,
+                             &effective_buffer_params_.full_y,
+                             &effective_buffer_params_.width,
+                             &effective_buffer_params_.height,
+                             &effective_buffer_params_.offset,
+                             &effective_buffer_params_.stride,
+                             &adaptive_active_pixels_.device_pointer,
+                             &num_adaptive_active_pixels_.device_pointer);
+
+  enqueue_kernel(DEVICE_KERNEL_ADAPTIVE_SAMPLING_ACTIVE_PIXELS_ARRAY, num_pixels, args);
+
+  queue_->copy_from_device(num_adaptive_active_pixels_);
+  queue_->synchronize();
+
+  adaptive_active_pixels_num_ = num_adaptive_active_pixels_.data()[0];
+  adaptive_active_pixels_buffer_params_ = effective_buffer_params_;
+
+  VLOG(3) << "Compacted " << adaptive_active_pixels_num_ << " active pixels out of "
+          << num_pixels << " for adaptive sampling.";
+}
+
+bool PathTraceWorkGPU::has_adaptive_sampling_active_pixels() const
+{
+  if (adaptive_active_pixels_num_ == 0) {
+    return false;
+  }
+
+  /* The array is only valid for the buffer it was built for. */
+  const BufferParams &params = adaptive_active_pixels_buffer_params_;
+  return params.full_x == effective_buffer_params_.full_x &&
+         params.full_y == effective_buffer_params_.full_y &&
+         params.width == effective_buffer_params_.width &&
+         params.height == effective_buffer_params_.height &&
+         params.offset == effective_buffer_params_.offset &&
+         params.stride == effective_buffer_params_.stride;
+}
+
 int PathTraceWorkGPU::adaptive_sampling_convergence_check_count_active(float threshold, bool reset)
 {
   device_vector<uint> num_active_pixels(device_, "num_active_pixels", MEM_READ_WRITE);
@@ -972,7 +1141,7 @@ int PathTraceWorkGPU::adaptive_sampling_convergence_check_count_active(float thr
                              &effective_buffer_params_.stride,
                              &num_active_pixels.device_pointer);
 
-  queue_->enqueue(DEVICE_KERNEL_ADAPTIVE_SAMPLING_CONVERGENCE_CHECK, work_size, args);
+  enqueue_kernel(DEVICE_KERNEL_ADAPTIVE_SAMPLING_CONVERGENCE_CHECK, work_size, args);
 
   queue_->copy_from_device(num_active_pixels);
   queue_->synchronize();
@@ -992,7 +1161,7 @@ void PathTraceWorkGPU::enqueue_adaptive_sampling_filter_x()
                              &effective_buffer_params_.offset,
                              &effective_buffer_params_.stride);
 
-  queue_->enqueue(DEVICE_KERNEL_ADAPTIVE_SAMPLING_CONVERGENCE_FILTER_X, work_size, args);
+  enqueue_kernel(DEVICE_KERNEL_ADAPTIVE_SAMPLING_CONVERGENCE_FILTER_X, work_size, args);
 }
 
 void PathTraceWorkGPU::enqueue_adaptive_sampling_filter_y()
@@ -1007,7 +1176,7 @@ void PathTraceWorkGPU::enqueue_adaptive_sampling_filter_y()
                              &effective_buffer_params_.offset,
                              &effective_buffer_params_.stride);
 
-  queue_->enqueue(DEVICE_KERNEL_ADAPTIVE_SAMPLING_CONVERGENCE_FILTER_Y, work_size, args);
+  enqueue_kernel(DEVICE_KERNEL_ADAPTIVE_SAMPLING_CONVERGENCE_FILTER_Y, work_size, args);
 }
 
 void PathTraceWorkGPU::cryptomatte_postproces()
@@ -1019,7 +1188,7 @@ void PathTraceWorkGPU::cryptomatte_postproces()
                              &effective_buffer_params_.offset,
                              &effective_buffer_params_.stride);
 
-  queue_->enqueue(DEVICE_KERNEL_CRYPTOMATTE_POSTPROCESS, work_size, args);
+  enqueue_kernel(DEVICE_KERNEL_CRYPTOMATTE_POSTPROCESS, work_size, args);
 }
 
 bool PathTraceWorkGPU::copy_render_buffers_from_device()
@@ -1034,6 +1203,9 @@ bool PathTraceWorkGPU::copy_render_buffers_to_device()
 {
   queue_->copy_to_device(buffers_->buffer);
 
+  /* Convergence of pixels might have changed, schedule all pixels until the next filter. */
+  adaptive_active_pixels_num_ = 0;
+
   /* NOTE: The direct device access to the buffers only happens within this path trace work. The
    * rest of communication happens via API calls which involves `copy_render_buffers_from_device()`
    * which will perform synchronization as needed. */
@@ -1045,6 +1217,9 @@ bool PathTraceWorkGPU::zero_render_buffers()
 {
   queue_->zero_to_device(buffers_->buffer);
 
+  /* All pixels are active again. */
+  adaptive_active_pixels_num_ = 0;
+
   return true;
 }
 
@@ -1070,7 +1245,7 @@ int PathTraceWorkGPU::shadow_catcher_count_possible_splits()
 
   DeviceKernelArguments args(&work_size, &d_num_queued_paths);
 
-  queue_->enqueue(DEVICE_KERNEL_INTEGRATOR_SHADOW_CATCHER_COUNT_POSSIBLE_SPLITS, work_size, args);
+  enqueue_kernel(DEVICE_KERNEL_INTEGRATOR_SHADOW_CATCHER_COUNT_POSSIBLE_SPLITS, work_size, args);
   queue_->copy_from_device(num_queued_paths_);
   queue_->synchronize();
 
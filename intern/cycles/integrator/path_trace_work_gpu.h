@@ -59,6 +59,15 @@ class PathTraceWorkGPU : public PathTraceWork {
 
   void enqueue_reset();
 
+  /* Enqueue kernel into the queue, measuring its execution time when kernel profiling is used. */
+  void enqueue_kernel(DeviceKernel kernel, const int work_size, DeviceKernelArguments const &args);
+
+  /* Enqueue surface shading kernel for sorted paths, with a separate launch for every shader
+   * to measure per-shader execution time. Returns false if this could not be done. */
+  bool enqueue_sorted_shading_per_shader(DeviceKernel kernel,
+                                         device_ptr d_path_index,
+                                         const int work_size);
+
   bool enqueue_work_tiles(bool &finished);
   void enqueue_work_tiles(DeviceKernel kernel,
                           const KernelWorkTile work_tiles[],
@@ -103,6 +112,8 @@ class PathTraceWorkGPU : public PathTraceWork {
   int adaptive_sampling_convergence_check_count_active(float threshold, bool reset);
   void enqueue_adaptive_sampling_filter_x();
   void enqueue_adaptive_sampling_filter_y();
+  void build_adaptive_sampling_active_pixels(int num_active_pixels_before_filter);
+  bool has_adaptive_sampling_active_pixels() const;
 
   bool has_shadow_catcher() const;
 
@@ -145,6 +156,17 @@ class PathTraceWorkGPU : public PathTraceWork {
   /* Temporary buffer for passing work tiles to kernel. */
   device_vector<KernelWorkTile> work_tiles_;
 
+  /* Compacted array of pixels which are still active for adaptive sampling, with indices relative
+   * to the effective buffer. It is built after the adaptive sampling filter when only a small part
+   * of the image remains active, so that new paths are only initialized for these pixels and
+   * converged pixels do not take path states away from them. */
+  device_vector<int> adaptive_active_pixels_;
+  device_vector<int> num_adaptive_active_pixels_;
+  /* Number of pixels in the array, 0 when the array is not used. */
+  int adaptive_active_pixels_num_ = 0;
+  /* Effective buffer parameters for which the array was built. */
+  BufferParams adaptive_active_pixels_buffer_params_;
+
   /* Temporary buffer used by the copy_to_display() whenever graphics interoperability is not
    * available. Is allocated on-demand. */
   device_vector<half4> display_rgba_half_;
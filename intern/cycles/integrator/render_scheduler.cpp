@@ -141,6 +141,7 @@ void RenderScheduler::reset(const BufferParams &buffer_params, int num_samples,
   /* TODO(sergey): Choose better initial value. */
   /* NOTE: The adaptive sampling settings might not be available here yet. */
   state_.adaptive_sampling_threshold = 0.4f;
+  state_.adaptive_sampling_step_scale = 1;
 
   state_.last_work_tile_was_denoised = false;
   state_.tile_result_was_written = false;
@@ -507,6 +508,30 @@ void RenderScheduler::report_adaptive_filter_time(const RenderWork &render_work,
           << " seconds.";
 }
 
+void RenderScheduler::report_adaptive_filter_active_pixels(int num_active_pixels, int num_pixels)
+{
+  if (num_active_pixels == 0 || num_pixels == 0) {
+    return;
+  }
+
+  /* Double the interval for every halving of the active pixels below 1/8th of the image, up to a
+   * limit. Pixels which converge within the longer interval get a few extra samples, which costs
+   * little since there are few of them. */
+  const int max_step_scale = 4;
+  const int active_ratio = num_pixels / num_active_pixels;
+
+  int step_scale = 1;
+  while (step_scale < max_step_scale && active_ratio >= 8 * step_scale) {
+    step_scale *= 2;
+  }
+
+  if (step_scale != state_.adaptive_sampling_step_scale) {
+    VLOG(3) << "Adaptive sampling interval scale " << step_scale << " for " << num_active_pixels
+            << " active pixels out of " << num_pixels;
+    state_.adaptive_sampling_step_scale = step_scale;
+  }
+}
+
 void RenderScheduler::report_denoise_time(const RenderWork &render_work, double time)
 {
   denoise_time_.add_wall(time);
@@ -861,8 +886,8 @@ int RenderScheduler::get_num_samples_to_path_trace() const
    * is to ensure that the final render is pixel-matched regardless of how many samples per second
    * compute device can do. */
 
-  return adaptive_sampling_.align_samples(path_trace_start_sample - sample_offset_,
-                                          num_samples_to_render);
+  return get_effective_adaptive_sampling().align_samples(path_trace_start_sample - sample_offset_,
+                                                        num_samples_to_render);
 }
 
 int RenderScheduler::get_num_samples_during_navigation(int resolution_divider) const
@@ -900,9 +925,16 @@ int RenderScheduler::get_num_samples_during_navigation(int resolution_divider) c
   return 4;
 }
 
+AdaptiveSampling RenderScheduler::get_effective_adaptive_sampling() const
+{
+  AdaptiveSampling adaptive_sampling = adaptive_sampling_;
+  adaptive_sampling.adaptive_step *= state_.adaptive_sampling_step_scale;
+  return adaptive_sampling;
+}
+
 bool RenderScheduler::work_need_adaptive_filter() const
 {
-  return adaptive_sampling_.need_filter(get_rendered_sample());
+  return get_effective_adaptive_sampling().need_filter(get_rendered_sample());
 }
 
 float RenderScheduler::work_adaptive_threshold() const
@@ -179,6 +179,9 @@ class RenderScheduler {
   void report_path_trace_time(const RenderWork &render_work, double time, bool is_cancelled);
   void report_path_trace_occupancy(const RenderWork &render_work, float occupancy);
   void report_adaptive_filter_time(const RenderWork &render_work, double time, bool is_cancelled);
+  /* Report number of pixels which are still active after the adaptive sampling convergence check,
+   * out of the number of pixels in the image. */
+  void report_adaptive_filter_active_pixels(int num_active_pixels, int num_pixels);
   void report_denoise_time(const RenderWork &render_work, double time);
   void report_display_update_time(const RenderWork &render_work, double time);
   void report_rebalance_time(const RenderWork &render_work, double time, bool balance_changed);
@@ -238,6 +241,10 @@ class RenderScheduler {
    */
   int get_num_samples_during_navigation(int resolution_divier) const;
 
+  /* Adaptive sampling settings with the interval between convergence checks adjusted for the
+   * number of pixels which are still active. */
+  AdaptiveSampling get_effective_adaptive_sampling() const;
+
   /* Whether adaptive sampling convergence check and filter is to happen. */
   bool work_need_adaptive_filter() const;
 
@@ -360,6 +367,11 @@ class RenderScheduler {
      * noise floor. */
     float adaptive_sampling_threshold = 0.0f;
 
+    /* Multiplier of the interval between adaptive sampling convergence checks. Grows when only few
+     * pixels remain active, since the check and filter always process all pixels while sampling
+     * only processes the active ones. */
+    int adaptive_sampling_step_scale = 1;
+
     bool last_work_tile_was_denoised = false;
     bool tile_result_was_written = false;
     bool postprocess_work_scheduled = false;
@@ -34,9 +34,12 @@ static double calculate_total_time(const vector<WorkBalanceInfo> &work_balance_i
   return total_time;
 }
 
-/* The balance is based on equalizing time which devices spent performing a task. Assume that
- * average of the observed times is usable for estimating whether more or less work is to be
- * scheduled, and how difference in the work scheduling is needed. */
+/* The balance is based on equalizing time which devices spent performing a task. The throughput
+ * of every device is estimated from the fraction of work it performed and the time it took, and
+ * the new weights are made proportional to it. This way all devices are expected to finish at the
+ * same time, instead of fast devices idling while waiting for the slowest one. With stable device
+ * performance this converges in a single step, which matters for heterogeneous devices where the
+ * initial equal distribution is far off. */
 
 bool work_balance_do_rebalance(vector<WorkBalanceInfo> &work_balance_infos)
 {
@@ -45,34 +48,49 @@ bool work_balance_do_rebalance(vector<WorkBalanceInfo> &work_balance_infos)
   const double total_time = calculate_total_time(work_balance_infos);
   const double time_average = total_time / num_infos;
 
-  double total_weight = 0;
-  vector<double> new_weights;
-  new_weights.reserve(num_infos);
+  if (time_average <= 0.0) {
+    return false;
+  }
 
-  /* Equalize the overall average time. This means that we don't make it so every work will perform
-   * amount of work based on the current average, but that after the weights changes the time will
-   * equalize.
-   * Can think of it that if one of the devices is 10% faster than another, then one device needs
-   * to do 5% less of the current work, and another needs to do 5% more. */
-  const double lerp_weight = 1.0 / num_infos;
+  double total_throughput = 0;
+  vector<double> throughputs;
+  throughputs.reserve(num_infos);
 
-  bool has_big_difference = false;
+  double max_time_difference = 0;
 
   for (const WorkBalanceInfo &info : work_balance_infos) {
-    const double time_target = lerp(info.time_spent, time_average, lerp_weight);
-    const double new_weight = info.weight * time_target / info.time_spent;
-    new_weights.push_back(new_weight);
-    total_weight += new_weight;
-
-    if (std::fabs(1.0 - time_target / time_average) > 0.02) {
-      has_big_difference = true;
+    if (info.time_spent <= 0.0) {
+      /* No statistics for this device yet. */
+      return false;
     }
+
+    const double throughput = info.weight / info.time_spent;
+    throughputs.push_back(throughput);
+    total_throughput += throughput;
+
+    max_time_difference = max(max_time_difference,
+                              std::fabs(1.0 - info.time_spent / time_average));
   }
 
-  if (!has_big_difference) {
+  if (max_time_difference <= 0.02) {
     return false;
   }
 
+  /* Small differences are likely to be caused by timing noise, so only move halfway towards the
+   * target weights to avoid oscillating between two balances. */
+  const double lerp_weight = (max_time_difference < 0.1) ? 0.5 : 1.0;
+
+  double total_weight = 0;
+  vector<double> new_weights;
+  new_weights.reserve(num_infos);
+
+  for (int i = 0; i < num_infos; ++i) {
+    const double target_weight = throughputs[i] / total_throughput;
+    const double new_weight = lerp(work_balance_infos[i].weight, target_weight, lerp_weight);
+    new_weights.push_back(new_weight);
+    total_weight += new_weight;
+  }
+
   const double total_weight_inv = 1.0 / total_weight;
   for (int i = 0; i < num_infos; ++i) {
     WorkBalanceInfo &info = work_balance_infos[i];
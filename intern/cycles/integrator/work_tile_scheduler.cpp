@@ -25,6 +25,11 @@ void WorkTileScheduler::set_max_num_path_states(int max_num_path_states)
   max_num_path_states_ = max_num_path_states;
 }
 
+void WorkTileScheduler::set_num_active_pixels(int num_active_pixels)
+{
+  num_active_pixels_ = num_active_pixels;
+}
+
 void WorkTileScheduler::reset(const BufferParams &buffer_params,
                               int sample_start,
                               int samples_num,
@@ -35,7 +40,14 @@ void WorkTileScheduler::reset(const BufferParams &buffer_params,
   image_full_offset_px_.x = buffer_params.full_x;
   image_full_offset_px_.y = buffer_params.full_y;
 
-  image_size_px_ = make_int2(buffer_params.width, buffer_params.height);
+  if (num_active_pixels_) {
+    /* Schedule the array of active pixels as if it was a single row of the image. */
+    image_full_offset_px_ = make_int2(0, 0);
+    image_size_px_ = make_int2(num_active_pixels_, 1);
+  }
+  else {
+    image_size_px_ = make_int2(buffer_params.width, buffer_params.height);
+  }
   scrambling_distance_ = scrambling_distance;
 
   offset_ = buffer_params.offset;
@@ -55,6 +67,13 @@ void WorkTileScheduler::reset_scheduler_state()
   tile_size_ = tile_calculate_best_size(
       accelerated_rt_, image_size_px_, samples_num_, max_num_path_states_, scrambling_distance_);
 
+  if (num_active_pixels_ && tile_size_.height > 1) {
+    /* Tiles are calculated as square regions of the image, use the same number of pixels in a
+     * single row of active pixels. */
+    tile_size_.width = min(tile_size_.width * tile_size_.height, image_size_px_.x);
+    tile_size_.height = 1;
+  }
+
   VLOG(3) << "Will schedule tiles of size " << tile_size_;
 
   if (VLOG_IS_ON(3)) {
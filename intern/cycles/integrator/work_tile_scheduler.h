@@ -34,6 +34,13 @@ class WorkTileScheduler {
              int sample_offset,
              float scrambling_distance);
 
+  /* Schedule work over a compacted array of pixels which are still active for adaptive sampling,
+   * rather than over all pixels of the big tile. Work tiles then span a range of this array along
+   * their X axis and have a height of 1.
+   * Pass 0 to schedule work for all pixels of the big tile.
+   * Takes effect on the next reset(). */
+  void set_num_active_pixels(int num_active_pixels);
+
   /* Get work for a device.
    * Returns true if there is still work to be done and initialize the work tile to all
    * parameters of this work. If there is nothing remaining to be done, returns false and the
@@ -61,6 +68,9 @@ class WorkTileScheduler {
   /* dimensions of the currently rendering image in pixels. */
   int2 image_size_px_ = make_int2(0, 0);
 
+  /* Number of pixels in the compacted array of active pixels, 0 when not used. */
+  int num_active_pixels_ = 0;
+
   /* Offset and stride of the buffer within which scheduling is happening.
    * Will be passed over to the KernelWorkTile. */
   int offset_, stride_;
@@ -121,6 +121,46 @@ ccl_gpu_kernel(GPU_KERNEL_BLOCK_NUM_THREADS, GPU_KERNEL_MAX_REGISTERS)
       integrator_init_from_bake(nullptr, state, tile, render_buffer, x, y, sample));
 }
 
+ccl_gpu_kernel(GPU_KERNEL_BLOCK_NUM_THREADS, GPU_KERNEL_MAX_REGISTERS)
+    ccl_gpu_kernel_signature(integrator_init_from_active_pixels,
+                             ccl_global KernelWorkTile *tiles,
+                             const int num_tiles,
+                             ccl_global float *render_buffer,
+                             const int max_tile_work_size,
+                             ccl_global const int *active_pixels,
+                             const int sx,
+                             const int sy,
+                             const int sw)
+{
+  const int work_index = ccl_gpu_global_id_x();
+
+  if (work_index >= max_tile_work_size * num_tiles) {
+    return;
+  }
+
+  const int tile_index = work_index / max_tile_work_size;
+  const int tile_work_index = work_index - tile_index * max_tile_work_size;
+
+  ccl_global const KernelWorkTile *tile = &tiles[tile_index];
+
+  if (tile_work_index >= tile->work_size) {
+    return;
+  }
+
+  const int state = tile->path_index_offset + tile_work_index;
+
+  /* Work tiles span a range of the active pixels array along their X axis. */
+  uint active_pixel_index, tile_y, sample;
+  ccl_gpu_kernel_call(get_work_pixel(tile, tile_work_index, &active_pixel_index, &tile_y, &sample));
+
+  const int pixel_index = active_pixels[active_pixel_index];
+  const int y = pixel_index / sw;
+  const int x = pixel_index - y * sw;
+
+  ccl_gpu_kernel_call(
+      integrator_init_from_camera(nullptr, state, tile, render_buffer, sx + x, sy + y, sample));
+}
+
 ccl_gpu_kernel(GPU_KERNEL_BLOCK_NUM_THREADS, GPU_KERNEL_MAX_REGISTERS)
     ccl_gpu_kernel_signature(integrator_intersect_closest,
                              ccl_global const int *path_index_array,
@@ -495,6 +535,41 @@ ccl_gpu_kernel(GPU_KERNEL_BLOCK_NUM_THREADS, GPU_KERNEL_MAX_REGISTERS)
   }
 }
 
+ccl_gpu_kernel_threads(GPU_PARALLEL_ACTIVE_INDEX_DEFAULT_BLOCK_SIZE)
+    ccl_gpu_kernel_signature(adaptive_sampling_active_pixels_array,
+                             ccl_global float *render_buffer,
+                             int sx,
+                             int sy,
+                             int sw,
+                             int sh,
+                             int offset,
+                             int stride,
+                             ccl_global int *indices,
+                             ccl_global int *num_indices)
+{
+  /* Pixel indices are relative to the (sx, sy) corner, in rows of sw pixels. */
+  ccl_gpu_kernel_lambda(ccl_gpu_kernel_call(kernel_adaptive_sampling_pixel_is_active(
+                            nullptr, render_buffer, sx + state % sw, sy + state / sw, offset, stride)),
+                        ccl_global float *render_buffer;
+                        int sx;
+                        int sy;
+                        int sw;
+                        int offset;
+                        int stride);
+  ccl_gpu_kernel_lambda_pass.render_buffer = render_buffer;
+  ccl_gpu_kernel_lambda_pass.sx = sx;
+  ccl_gpu_kernel_lambda_pass.sy = sy;
+  ccl_gpu_kernel_lambda_pass.sw = sw;
+  ccl_gpu_kernel_lambda_pass.offset = offset;
+  ccl_gpu_kernel_lambda_pass.stride = stride;
+
+  gpu_parallel_active_index_array(GPU_PARALLEL_ACTIVE_INDEX_DEFAULT_BLOCK_SIZE,
+                                  sw * sh,
+                                  indices,
+                                  num_indices,
+                                  ccl_gpu_kernel_lambda_pass);
+}
+
 ccl_gpu_kernel(GPU_KERNEL_BLOCK_NUM_THREADS, GPU_KERNEL_MAX_REGISTERS)
     ccl_gpu_kernel_signature(adaptive_sampling_filter_x,
                              ccl_global float *render_buffer,
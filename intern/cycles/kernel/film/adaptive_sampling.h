@@ -75,6 +75,25 @@ ccl_device bool kernel_adaptive_sampling_convergence_check(KernelGlobals kg,
   return did_converge;
 }
 
+/* Check whether the pixel still needs samples after the convergence check and filter. */
+
+ccl_device bool kernel_adaptive_sampling_pixel_is_active(KernelGlobals kg,
+                                                         ccl_global const float *render_buffer,
+                                                         int x,
+                                                         int y,
+                                                         int offset,
+                                                         int stride)
+{
+  kernel_assert(kernel_data.film.pass_adaptive_aux_buffer != PASS_UNUSED);
+
+  const int render_pixel_index = offset + x + y * stride;
+  ccl_global const float *buffer = render_buffer +
+                                   (uint64_t)render_pixel_index * kernel_data.film.pass_stride;
+
+  const uint aux_w_offset = kernel_data.film.pass_adaptive_aux_buffer + 3;
+  return buffer[aux_w_offset] == 0.0f;
+}
+
 /* This is a simple box filter in two passes.
  * When a pixel demands more adaptive samples, let its neighboring pixels draw more samples too. */
 
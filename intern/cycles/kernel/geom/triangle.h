@@ -11,6 +11,12 @@
 
 CCL_NAMESPACE_BEGIN
 
+/* Vertex normals are stored octahedral encoded, to reduce memory usage. */
+ccl_device_inline float3 triangle_vertex_normal(KernelGlobals kg, const uint vert)
+{
+  return octahedral_decode(kernel_tex_fetch(__tri_vnormal, vert));
+}
+
 /* Normal on triangle. */
 ccl_device_inline float3 triangle_normal(KernelGlobals kg, ccl_private ShaderData *sd)
 {
@@ -81,9 +87,9 @@ ccl_device_inline void triangle_vertices_and_normals(KernelGlobals kg,
   P[0] = kernel_tex_fetch(__tri_verts, tri_vindex.w + 0);
   P[1] = kernel_tex_fetch(__tri_verts, tri_vindex.w + 1);
   P[2] = kernel_tex_fetch(__tri_verts, tri_vindex.w + 2);
-  N[0] = kernel_tex_fetch(__tri_vnormal, tri_vindex.x);
-  N[1] = kernel_tex_fetch(__tri_vnormal, tri_vindex.y);
-  N[2] = kernel_tex_fetch(__tri_vnormal, tri_vindex.z);
+  N[0] = triangle_vertex_normal(kg, tri_vindex.x);
+  N[1] = triangle_vertex_normal(kg, tri_vindex.y);
+  N[2] = triangle_vertex_normal(kg, tri_vindex.z);
 }
 
 /* Interpolate smooth vertex normal from vertices */
@@ -93,9 +99,9 @@ triangle_smooth_normal(KernelGlobals kg, float3 Ng, int prim, float u, float v)
 {
   /* load triangle vertices */
   const uint4 tri_vindex = kernel_tex_fetch(__tri_vindex, prim);
-  float3 n0 = kernel_tex_fetch(__tri_vnormal, tri_vindex.x);
-  float3 n1 = kernel_tex_fetch(__tri_vnormal, tri_vindex.y);
-  float3 n2 = kernel_tex_fetch(__tri_vnormal, tri_vindex.z);
+  float3 n0 = triangle_vertex_normal(kg, tri_vindex.x);
+  float3 n1 = triangle_vertex_normal(kg, tri_vindex.y);
+  float3 n2 = triangle_vertex_normal(kg, tri_vindex.z);
 
   float3 N = safe_normalize((1.0f - u - v) * n2 + u * n0 + v * n1);
 
@@ -107,9 +113,9 @@ ccl_device_inline float3 triangle_smooth_normal_unnormalized(
 {
   /* load triangle vertices */
   const uint4 tri_vindex = kernel_tex_fetch(__tri_vindex, prim);
-  float3 n0 = kernel_tex_fetch(__tri_vnormal, tri_vindex.x);
-  float3 n1 = kernel_tex_fetch(__tri_vnormal, tri_vindex.y);
-  float3 n2 = kernel_tex_fetch(__tri_vnormal, tri_vindex.z);
+  float3 n0 = triangle_vertex_normal(kg, tri_vindex.x);
+  float3 n1 = triangle_vertex_normal(kg, tri_vindex.y);
+  float3 n2 = triangle_vertex_normal(kg, tri_vindex.z);
 
   /* ensure that the normals are in object space */
   if (sd->object_flag & SD_OBJECT_TRANSFORM_APPLIED) {
@@ -0,0 +1,178 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright 2011-2022 Blender Foundation */
+
+#pragma once
+
+#include "util/atomic.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Path Guiding
+ *
+ * The incident radiance is learned in a regular grid of cells over the scene bounds, each with a
+ * histogram of directions over the sphere. Directions are mapped with an equal-area cylindrical
+ * mapping, so that all bins cover the same solid angle.
+ *
+ * During the first samples, contributions found one bounce after a diffuse scatter point are
+ * recorded in the bin of the direction sampled at that point. The host then turns the histograms
+ * into normalized distributions, which are used for importance sampling directions at diffuse
+ * surfaces for the remaining samples, in a mixture with BSDF sampling. */
+
+#ifdef __PATH_GUIDING__
+
+/* Inverse of the solid angle of a direction bin. */
+#  define GUIDING_BIN_INV_SOLID_ANGLE (GUIDING_NUM_BINS * M_1_PI_F * 0.25f)
+
+ccl_device_inline int guiding_cell_index(KernelGlobals kg, const float3 P)
+{
+  const float3 grid_min = make_float3(kernel_data.integrator.guiding_grid_min[0],
+                                      kernel_data.integrator.guiding_grid_min[1],
+                                      kernel_data.integrator.guiding_grid_min[2]);
+  const float3 grid_scale = make_float3(kernel_data.integrator.guiding_grid_scale[0],
+                                        kernel_data.integrator.guiding_grid_scale[1],
+                                        kernel_data.integrator.guiding_grid_scale[2]);
+  const float3 grid_P = (P - grid_min) * grid_scale;
+
+  const int x = (int)floorf(grid_P.x);
+  const int y = (int)floorf(grid_P.y);
+  const int z = (int)floorf(grid_P.z);
+
+  if (x < 0 || y < 0 || z < 0 || x >= GUIDING_GRID_RESOLUTION || y >= GUIDING_GRID_RESOLUTION ||
+      z >= GUIDING_GRID_RESOLUTION) {
+    return -1;
+  }
+
+  return x + GUIDING_GRID_RESOLUTION * (y + GUIDING_GRID_RESOLUTION * z);
+}
+
+ccl_device_inline int guiding_direction_bin(const float3 D)
+{
+  const float u = (D.z + 1.0f) * 0.5f;
+  const float v = atan2f(D.y, D.x) * M_1_2PI_F + 0.5f;
+
+  const int i = clamp(
+      (int)(u * GUIDING_DIRECTION_RESOLUTION), 0, GUIDING_DIRECTION_RESOLUTION - 1);
+  const int j = clamp(
+      (int)(v * GUIDING_DIRECTION_RESOLUTION), 0, GUIDING_DIRECTION_RESOLUTION - 1);
+
+  return i * GUIDING_DIRECTION_RESOLUTION + j;
+}
+
+ccl_device_inline float3 guiding_bin_direction(const int bin, const float randu, const float randv)
+{
+  const int i = bin / GUIDING_DIRECTION_RESOLUTION;
+  const int j = bin % GUIDING_DIRECTION_RESOLUTION;
+
+  const float z = (i + randu) * (2.0f / GUIDING_DIRECTION_RESOLUTION) - 1.0f;
+  const float phi = ((j + randv) * (1.0f / GUIDING_DIRECTION_RESOLUTION) - 0.5f) * M_2PI_F;
+  const float r = safe_sqrtf(1.0f - z * z);
+
+  return make_float3(r * cosf(phi), r * sinf(phi), z);
+}
+
+/* Cell to use for guiding at a surface shading point, or -1 if guiding is not supported. Only
+ * purely diffuse shaders are guided, where the BSDF is smooth and can be evaluated in any
+ * direction. */
+ccl_device_inline int guiding_surface_cell(KernelGlobals kg, ccl_private const ShaderData *sd)
+{
+  for (int i = 0; i < sd->num_closure; i++) {
+    ccl_private const ShaderClosure *sc = &sd->closure[i];
+
+    if (CLOSURE_IS_BSDF_OR_BSSRDF(sc->type) && !CLOSURE_IS_BSDF_DIFFUSE(sc->type)) {
+      return -1;
+    }
+  }
+
+  return guiding_cell_index(kg, sd->P);
+}
+
+/* The distributions are stored as cumulative probabilities per cell. Cells without training data
+ * have all zero values. */
+ccl_device_inline bool guiding_cell_is_trained(KernelGlobals kg, const int cell)
+{
+  return kernel_tex_fetch(__guiding_distribution, (cell + 1) * GUIDING_NUM_BINS - 1) > 0.0f;
+}
+
+ccl_device_inline float guiding_bin_probability(KernelGlobals kg, const int cell, const int bin)
+{
+  const int offset = cell * GUIDING_NUM_BINS;
+  const float cdf = kernel_tex_fetch(__guiding_distribution, offset + bin);
+  const float prev_cdf = (bin > 0) ? kernel_tex_fetch(__guiding_distribution, offset + bin - 1) :
+                                     0.0f;
+  return cdf - prev_cdf;
+}
+
+ccl_device_inline float guiding_pdf(KernelGlobals kg, const int cell, const float3 D)
+{
+  return guiding_bin_probability(kg, cell, guiding_direction_bin(D)) *
+         GUIDING_BIN_INV_SOLID_ANGLE;
+}
+
+/* Pdf of sampling direction D from the one-sample mixture of the BSDF and the guiding
+ * distribution. Both BSDF sampling and light sampling must use this for MIS. */
+ccl_device_inline float guiding_mixture_pdf(KernelGlobals kg,
+                                            const int cell,
+                                            const float3 D,
+                                            const float bsdf_pdf)
+{
+  return lerp(bsdf_pdf, guiding_pdf(kg, cell, D), kernel_data.integrator.guiding_probability);
+}
+
+ccl_device_inline float3 guiding_sample(KernelGlobals kg,
+                                        const int cell,
+                                        const float randu,
+                                        const float randv,
+                                        ccl_private float *pdf)
+{
+  const int offset = cell * GUIDING_NUM_BINS;
+
+  /* Find the first bin with cumulative probability above randu. */
+  int first = 0;
+  int len = GUIDING_NUM_BINS;
+  while (len > 0) {
+    const int half_len = len >> 1;
+    const int middle = first + half_len;
+    if (kernel_tex_fetch(__guiding_distribution, offset + middle) <= randu) {
+      first = middle + 1;
+      len -= half_len + 1;
+    }
+    else {
+      len = half_len;
+    }
+  }
+
+  const int bin = min(first, GUIDING_NUM_BINS - 1);
+  const float cdf = kernel_tex_fetch(__guiding_distribution, offset + bin);
+  const float prev_cdf = (bin > 0) ? kernel_tex_fetch(__guiding_distribution, offset + bin - 1) :
+                                     0.0f;
+  const float probability = cdf - prev_cdf;
+
+  /* Rescale to reuse for the direction within the bin. */
+  const float bin_u = (probability > 0.0f) ? saturatef((randu - prev_cdf) / probability) : 0.5f;
+
+  *pdf = probability * GUIDING_BIN_INV_SOLID_ANGLE;
+  return guiding_bin_direction(bin, bin_u, randv);
+}
+
+/* Record a contribution into the training histograms. The weight converts it to an estimate of
+ * the incident radiance at the scatter point divided by the sampling pdf. */
+ccl_device_inline void guiding_record(KernelGlobals kg,
+                                      const int guiding_bin,
+                                      const float guiding_weight,
+                                      const float3 contribution)
+{
+  if (guiding_bin < 0) {
+    return;
+  }
+
+  const float value = average(contribution) * guiding_weight;
+  if (!(value > 0.0f) || !isfinite_safe(value)) {
+    return;
+  }
+
+  atomic_add_and_fetch_float(&kernel_tex_array(__guiding_train)[guiding_bin], value);
+}
+
+#endif /* __PATH_GUIDING__ */
+
+CCL_NAMESPACE_END
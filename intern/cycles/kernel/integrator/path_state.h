@@ -57,6 +57,13 @@ ccl_device_inline void path_state_init_integrator(KernelGlobals kg,
   INTEGRATOR_STATE_WRITE(state, path, continuation_probability) = 1.0f;
   INTEGRATOR_STATE_WRITE(state, path, throughput) = make_float3(1.0f, 1.0f, 1.0f);
 
+#ifdef __PATH_GUIDING__
+  if (kernel_data.kernel_features & KERNEL_FEATURE_PATH_GUIDING) {
+    INTEGRATOR_STATE_WRITE(state, path, guiding_bin) = -1;
+    INTEGRATOR_STATE_WRITE(state, path, guiding_weight) = 0.0f;
+  }
+#endif
+
   INTEGRATOR_STATE_WRITE(state, isect, object) = OBJECT_NONE;
   INTEGRATOR_STATE_WRITE(state, isect, prim) = PRIM_NONE;
 
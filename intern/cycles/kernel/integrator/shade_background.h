@@ -4,6 +4,7 @@
 #pragma once
 
 #include "kernel/film/accumulate.h"
+#include "kernel/integrator/guiding.h"
 #include "kernel/integrator/shader_eval.h"
 #include "kernel/light/light.h"
 #include "kernel/light/sample.h"
@@ -113,6 +114,15 @@ ccl_device_inline void integrate_background(KernelGlobals kg,
 
   /* Write to render buffer. */
   kernel_accum_background(kg, state, L, transparent, is_transparent_background_ray, render_buffer);
+
+#ifdef __PATH_GUIDING__
+  if (kernel_data.kernel_features & KERNEL_FEATURE_PATH_GUIDING) {
+    guiding_record(kg,
+                   INTEGRATOR_STATE(state, path, guiding_bin),
+                   INTEGRATOR_STATE(state, path, guiding_weight),
+                   INTEGRATOR_STATE(state, path, throughput) * L);
+  }
+#endif
 }
 
 ccl_device_inline void integrate_distant_lights(KernelGlobals kg,
@@ -161,6 +171,15 @@ ccl_device_inline void integrate_distant_lights(KernelGlobals kg,
       /* Write to render buffer. */
       const float3 throughput = INTEGRATOR_STATE(state, path, throughput);
       kernel_accum_emission(kg, state, throughput * light_eval, render_buffer);
+
+#ifdef __PATH_GUIDING__
+      if (kernel_data.kernel_features & KERNEL_FEATURE_PATH_GUIDING) {
+        guiding_record(kg,
+                       INTEGRATOR_STATE(state, path, guiding_bin),
+                       INTEGRATOR_STATE(state, path, guiding_weight),
+                       throughput * light_eval);
+      }
+#endif
     }
   }
 }
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "kernel/film/accumulate.h"
+#include "kernel/integrator/guiding.h"
 #include "kernel/integrator/shader_eval.h"
 #include "kernel/light/light.h"
 #include "kernel/light/sample.h"
@@ -72,13 +73,24 @@ ccl_device_inline void integrate_light(KernelGlobals kg,
     /* multiple importance sampling, get regular light pdf,
      * and compute weight with respect to BSDF pdf */
     const float mis_ray_pdf = INTEGRATOR_STATE(state, path, mis_ray_pdf);
-    const float mis_weight = light_sample_mis_weight_forward(kg, mis_ray_pdf, ls.pdf);
+    const int emitter = kernel_data.integrator.light_tree_lamp_offset + ls.lamp;
+    const float pdf = ls.pdf * light_tree_pdf_factor(kg, emitter, ray_P, path_flag);
+    const float mis_weight = light_sample_mis_weight_forward(kg, mis_ray_pdf, pdf);
     light_eval *= mis_weight;
   }
 
   /* Write to render buffer. */
   const float3 throughput = INTEGRATOR_STATE(state, path, throughput);
   kernel_accum_emission(kg, state, throughput * light_eval, render_buffer);
+
+#ifdef __PATH_GUIDING__
+  if (kernel_data.kernel_features & KERNEL_FEATURE_PATH_GUIDING) {
+    guiding_record(kg,
+                   INTEGRATOR_STATE(state, path, guiding_bin),
+                   INTEGRATOR_STATE(state, path, guiding_weight),
+                   throughput * light_eval);
+  }
+#endif
 }
 
 ccl_device void integrator_shade_light(KernelGlobals kg,
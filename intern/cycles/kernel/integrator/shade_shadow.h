@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "kernel/integrator/guiding.h"
 #include "kernel/integrator/shade_volume.h"
 #include "kernel/integrator/shader_eval.h"
 #include "kernel/integrator/volume_stack.h"
@@ -171,6 +172,14 @@ ccl_device void integrator_shade_shadow(KernelGlobals kg,
   }
   else {
     kernel_accum_light(kg, state, render_buffer);
+#ifdef __PATH_GUIDING__
+    if (kernel_data.kernel_features & KERNEL_FEATURE_PATH_GUIDING) {
+      guiding_record(kg,
+                     INTEGRATOR_STATE(state, shadow_path, guiding_bin),
+                     INTEGRATOR_STATE(state, shadow_path, guiding_weight),
+                     INTEGRATOR_STATE(state, shadow_path, throughput));
+    }
+#endif
     INTEGRATOR_SHADOW_PATH_TERMINATE(DEVICE_KERNEL_INTEGRATOR_SHADE_SHADOW);
     return;
   }
@@ -6,6 +6,7 @@
 #include "kernel/film/accumulate.h"
 #include "kernel/film/passes.h"
 
+#include "kernel/integrator/guiding.h"
 #include "kernel/integrator/path_state.h"
 #include "kernel/integrator/shader_eval.h"
 #include "kernel/integrator/subsurface.h"
@@ -80,12 +81,22 @@ ccl_device_forceinline void integrate_surface_emission(KernelGlobals kg,
     /* Multiple importance sampling, get triangle light pdf,
      * and compute weight with respect to BSDF pdf. */
     float pdf = triangle_light_pdf(kg, sd, t);
+    pdf *= light_tree_pdf_factor(kg, sd->object, sd->P + sd->I * t, path_flag);
     float mis_weight = light_sample_mis_weight_forward(kg, bsdf_pdf, pdf);
     L *= mis_weight;
   }
 
   const float3 throughput = INTEGRATOR_STATE(state, path, throughput);
   kernel_accum_emission(kg, state, throughput * L, render_buffer);
+
+#  ifdef __PATH_GUIDING__
+  if (kernel_data.kernel_features & KERNEL_FEATURE_PATH_GUIDING) {
+    guiding_record(kg,
+                   INTEGRATOR_STATE(state, path, guiding_bin),
+                   INTEGRATOR_STATE(state, path, guiding_weight),
+                   throughput * L);
+  }
+#  endif
 }
 #endif /* __EMISSION__ */
 
@@ -110,7 +121,7 @@ ccl_device_forceinline void integrate_surface_direct_light(KernelGlobals kg,
     float light_u, light_v;
     path_state_rng_2D(kg, rng_state, PRNG_LIGHT_U, &light_u, &light_v);
 
-    if (!light_distribution_sample_from_position(
+    if (!light_distribution_sample_from_surface(
             kg, light_u, light_v, sd->time, sd->P, bounce, path_flag, &ls)) {
       return;
     }
@@ -135,9 +146,20 @@ ccl_device_forceinline void integrate_surface_direct_light(KernelGlobals kg,
   const bool is_transmission = shader_bsdf_is_transmission(sd, ls.D);
 
   BsdfEval bsdf_eval ccl_optional_struct_init;
-  const float bsdf_pdf = shader_bsdf_eval(kg, sd, ls.D, is_transmission, &bsdf_eval, ls.shader);
+  float bsdf_pdf = shader_bsdf_eval(kg, sd, ls.D, is_transmission, &bsdf_eval, ls.shader);
   bsdf_eval_mul3(&bsdf_eval, light_eval / ls.pdf);
 
+#  ifdef __PATH_GUIDING__
+  /* Directions are sampled from the guiding mixture here, see
+   * #integrate_surface_guided_bsdf_sample, so MIS must weight with the same pdf. */
+  if (kernel_data.kernel_features & KERNEL_FEATURE_PATH_GUIDING) {
+    const int cell = (sd->flag & SD_BSSRDF) ? -1 : guiding_surface_cell(kg, sd);
+    if (cell != -1 && guiding_cell_is_trained(kg, cell)) {
+      bsdf_pdf = guiding_mixture_pdf(kg, cell, ls.D, bsdf_pdf);
+    }
+  }
+#  endif
+
   if (ls.shader & SHADER_USE_MIS) {
     const float mis_weight = light_sample_mis_weight_nee(kg, ls.pdf, bsdf_pdf);
     bsdf_eval_mul(&bsdf_eval, mis_weight);
@@ -224,9 +246,91 @@ ccl_device_forceinline void integrate_surface_direct_light(KernelGlobals kg,
   if (kernel_data.kernel_features & KERNEL_FEATURE_SHADOW_PASS) {
     INTEGRATOR_STATE_WRITE(shadow_state, shadow_path, unshadowed_throughput) = throughput;
   }
+
+#  ifdef __PATH_GUIDING__
+  if (kernel_data.kernel_features & KERNEL_FEATURE_PATH_GUIDING) {
+    INTEGRATOR_STATE_WRITE(shadow_state, shadow_path, guiding_bin) = INTEGRATOR_STATE(
+        state, path, guiding_bin);
+    INTEGRATOR_STATE_WRITE(shadow_state, shadow_path, guiding_weight) = INTEGRATOR_STATE(
+        state, path, guiding_weight);
+  }
+#  endif
 }
 #endif
 
+#ifdef __PATH_GUIDING__
+/* Sample direction from a mixture of the BSDFs and the guiding distribution, and return the
+ * BSDF evaluation with the mixture pdf. Also set up recording of training data for the
+ * sampled direction. */
+ccl_device_forceinline int integrate_surface_guided_bsdf_sample(
+    KernelGlobals kg,
+    IntegratorState state,
+    ccl_private ShaderData *sd,
+    ccl_private const RNGState *rng_state,
+    ccl_private const ShaderClosure *sc,
+    const float bsdf_u,
+    const float bsdf_v,
+    ccl_private BsdfEval *bsdf_eval,
+    ccl_private float3 *bsdf_omega_in,
+    ccl_private differential3 *bsdf_domega_in,
+    ccl_private float *bsdf_pdf)
+{
+  const int cell = (sd->flag & SD_BSSRDF) ? -1 : guiding_surface_cell(kg, sd);
+  const bool use_guiding = (cell != -1) && guiding_cell_is_trained(kg, cell);
+  const float guiding_probability = (use_guiding) ? kernel_data.integrator.guiding_probability :
+                                                    0.0f;
+
+  int label;
+
+  if (use_guiding && path_state_rng_1D(kg, rng_state, PRNG_GUIDING) < guiding_probability) {
+    float guiding_sample_pdf;
+    *bsdf_omega_in = guiding_sample(kg, cell, bsdf_u, bsdf_v, &guiding_sample_pdf);
+
+    const bool is_transmission = shader_bsdf_is_transmission(sd, *bsdf_omega_in);
+    const float pdf = shader_bsdf_eval(kg, sd, *bsdf_omega_in, is_transmission, bsdf_eval, 0);
+    *bsdf_pdf = lerp(pdf, guiding_sample_pdf, guiding_probability);
+
+    label = ((is_transmission) ? LABEL_TRANSMIT : LABEL_REFLECT) | LABEL_DIFFUSE;
+#  ifdef __RAY_DIFFERENTIALS__
+    /* Same as diffuse BSDF sampling. */
+    bsdf_domega_in->dx = (2.0f * dot(sd->N, sd->dI.dx)) * sd->N - sd->dI.dx;
+    bsdf_domega_in->dy = (2.0f * dot(sd->N, sd->dI.dy)) * sd->N - sd->dI.dy;
+#  endif
+  }
+  else {
+    label = shader_bsdf_sample_closure(
+        kg, sd, sc, bsdf_u, bsdf_v, bsdf_eval, bsdf_omega_in, bsdf_domega_in, bsdf_pdf);
+
+    if (use_guiding && *bsdf_pdf != 0.0f) {
+      *bsdf_pdf = guiding_mixture_pdf(kg, cell, *bsdf_omega_in, *bsdf_pdf);
+    }
+  }
+
+  /* Record contributions found along the new ray while training. Dividing by the throughput
+   * after the bounce gives the incident radiance, which is then divided by the pdf. This
+   * simplifies to dividing by the throughput times the BSDF evaluation. */
+  const bool is_training = INTEGRATOR_STATE(state, path, sample) <
+                           kernel_data.integrator.guiding_training_samples;
+  float guiding_weight = 0.0f;
+  if (is_training && cell != -1 && *bsdf_pdf != 0.0f) {
+    const float throughput = average(INTEGRATOR_STATE(state, path, throughput) *
+                                     bsdf_eval_sum(bsdf_eval));
+    guiding_weight = (throughput > 0.0f) ? 1.0f / throughput : 0.0f;
+  }
+
+  if (guiding_weight > 0.0f) {
+    INTEGRATOR_STATE_WRITE(state, path, guiding_bin) = cell * GUIDING_NUM_BINS +
+                                                       guiding_direction_bin(*bsdf_omega_in);
+    INTEGRATOR_STATE_WRITE(state, path, guiding_weight) = guiding_weight;
+  }
+  else {
+    INTEGRATOR_STATE_WRITE(state, path, guiding_bin) = -1;
+  }
+
+  return label;
+}
+#endif /* __PATH_GUIDING__ */
+
 /* Path tracing: bounce off or through surface with new direction. */
 ccl_device_forceinline int integrate_surface_bsdf_bssrdf_bounce(
     KernelGlobals kg,
@@ -246,6 +350,11 @@ ccl_device_forceinline int integrate_surface_bsdf_bssrdf_bounce(
 #ifdef __SUBSURFACE__
   /* BSSRDF closure, we schedule subsurface intersection kernel. */
   if (CLOSURE_IS_BSSRDF(sc->type)) {
+#  ifdef __PATH_GUIDING__
+    if (kernel_data.kernel_features & KERNEL_FEATURE_PATH_GUIDING) {
+      INTEGRATOR_STATE_WRITE(state, path, guiding_bin) = -1;
+    }
+#  endif
     return subsurface_bounce(kg, state, sd, sc);
   }
 #endif
@@ -257,8 +366,26 @@ ccl_device_forceinline int integrate_surface_bsdf_bssrdf_bounce(
   differential3 bsdf_domega_in ccl_optional_struct_init;
   int label;
 
-  label = shader_bsdf_sample_closure(
-      kg, sd, sc, bsdf_u, bsdf_v, &bsdf_eval, &bsdf_omega_in, &bsdf_domega_in, &bsdf_pdf);
+#ifdef __PATH_GUIDING__
+  if (kernel_data.kernel_features & KERNEL_FEATURE_PATH_GUIDING) {
+    label = integrate_surface_guided_bsdf_sample(kg,
+                                                 state,
+                                                 sd,
+                                                 rng_state,
+                                                 sc,
+                                                 bsdf_u,
+                                                 bsdf_v,
+                                                 &bsdf_eval,
+                                                 &bsdf_omega_in,
+                                                 &bsdf_domega_in,
+                                                 &bsdf_pdf);
+  }
+  else
+#endif
+  {
+    label = shader_bsdf_sample_closure(
+        kg, sd, sc, bsdf_u, bsdf_v, &bsdf_eval, &bsdf_omega_in, &bsdf_domega_in, &bsdf_pdf);
+  }
 
   if (bsdf_pdf == 0.0f || bsdf_eval_is_zero(&bsdf_eval)) {
     return LABEL_NONE;
@@ -401,6 +528,13 @@ ccl_device_forceinline void integrate_surface_ao(KernelGlobals kg,
   if (kernel_data.kernel_features & KERNEL_FEATURE_AO_ADDITIVE) {
     INTEGRATOR_STATE_WRITE(shadow_state, shadow_path, unshadowed_throughput) = ao_weight;
   }
+
+#  ifdef __PATH_GUIDING__
+  /* Ambient occlusion is not incident radiance. */
+  if (kernel_data.kernel_features & KERNEL_FEATURE_PATH_GUIDING) {
+    INTEGRATOR_STATE_WRITE(shadow_state, shadow_path, guiding_bin) = -1;
+  }
+#  endif
 }
 #endif /* defined(__AO__) */
 
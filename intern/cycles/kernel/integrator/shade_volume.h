@@ -149,6 +149,21 @@ ccl_device_forceinline void volume_step_init(KernelGlobals kg,
   }
 }
 
+/* Empty space skipping: grow the step size while stepping through empty space, where the shader
+ * evaluation did not return any extinction, scattering or emission. This works like locally
+ * lowering the step rate, and the step size is restored as soon as the volume is not empty. */
+#  define VOLUME_EMPTY_STEP_SCALE_MAX 8.0f
+
+ccl_device_forceinline float volume_step_scale_update(KernelGlobals kg,
+                                                      const float step_scale,
+                                                      const bool is_empty)
+{
+  if (!is_empty || !kernel_data.integrator.volume_skip_empty) {
+    return 1.0f;
+  }
+  return min(step_scale * 2.0f, VOLUME_EMPTY_STEP_SCALE_MAX);
+}
+
 /* Volume Shadows
  *
  * These functions are used to attenuate shadow rays to lights. Both absorption
@@ -205,10 +220,11 @@ ccl_device void volume_shadow_heterogeneous(KernelGlobals kg,
   float t = 0.0f;
 
   float3 sum = zero_float3();
+  float step_scale = 1.0f;
 
   for (int i = 0; i < max_steps; i++) {
     /* advance to new position */
-    float new_t = min(ray->t, (i + steps_offset) * step_size);
+    float new_t = min(ray->t, t + steps_offset * step_size * step_scale);
     float dt = new_t - t;
 
     float3 new_P = ray->P + ray->D * (t + dt * step_shade_offset);
@@ -216,7 +232,9 @@ ccl_device void volume_shadow_heterogeneous(KernelGlobals kg,
 
     /* compute attenuation over segment */
     sd->P = new_P;
-    if (shadow_volume_shader_sample(kg, state, sd, &sigma_t)) {
+    const bool is_empty = !shadow_volume_shader_sample(kg, state, sd, &sigma_t);
+    step_scale = volume_step_scale_update(kg, step_scale, is_empty);
+    if (!is_empty) {
       /* Compute `expf()` only for every Nth step, to save some calculations
        * because `exp(a)*exp(b) = exp(a+b)`, also do a quick #VOLUME_THROUGHPUT_EPSILON
        * check then. */
@@ -575,16 +593,20 @@ ccl_device_forceinline void volume_integrate_heterogeneous(
   float3 accum_albedo = zero_float3();
 #  endif
   float3 accum_emission = zero_float3();
+  float step_scale = 1.0f;
 
   for (int i = 0; i < max_steps; i++) {
-    /* Advance to new position */
-    vstate.end_t = min(ray->t, (i + steps_offset) * step_size);
+    /* Advance to new position. The first step is shortened by the random offset. */
+    const float step_length = ((i == 0) ? steps_offset : 1.0f) * step_size * step_scale;
+    vstate.end_t = min(ray->t, vstate.start_t + step_length);
     const float shade_t = vstate.start_t + (vstate.end_t - vstate.start_t) * step_shade_offset;
     sd->P = ray->P + ray->D * shade_t;
 
     /* compute segment */
     VolumeShaderCoefficients coeff ccl_optional_struct_init;
-    if (volume_shader_sample(kg, state, sd, &coeff)) {
+    const bool is_empty = !volume_shader_sample(kg, state, sd, &coeff);
+    step_scale = volume_step_scale_update(kg, step_scale, is_empty);
+    if (!is_empty) {
       const int closure_flag = sd->flag;
 
       /* Evaluate transmittance over segment. */
@@ -833,6 +855,16 @@ ccl_device_forceinline void integrate_volume_direct_light(
     INTEGRATOR_STATE_WRITE(shadow_state, shadow_path, unshadowed_throughput) = throughput;
   }
 
+#    ifdef __PATH_GUIDING__
+  /* Light scattered along the ray is part of the incident radiance at the last surface. */
+  if (kernel_data.kernel_features & KERNEL_FEATURE_PATH_GUIDING) {
+    INTEGRATOR_STATE_WRITE(shadow_state, shadow_path, guiding_bin) = INTEGRATOR_STATE(
+        state, path, guiding_bin);
+    INTEGRATOR_STATE_WRITE(shadow_state, shadow_path, guiding_weight) = INTEGRATOR_STATE(
+        state, path, guiding_weight);
+  }
+#    endif
+
   integrator_state_copy_volume_stack_to_shadow(kg, shadow_state, state);
 }
 #  endif
@@ -893,6 +925,11 @@ ccl_device_forceinline bool integrate_volume_phase_scatter(
   }
 
   /* Update path state */
+#  ifdef __PATH_GUIDING__
+  if (kernel_data.kernel_features & KERNEL_FEATURE_PATH_GUIDING) {
+    INTEGRATOR_STATE_WRITE(state, path, guiding_bin) = -1;
+  }
+#  endif
   INTEGRATOR_STATE_WRITE(state, path, mis_ray_pdf) = phase_pdf;
   INTEGRATOR_STATE_WRITE(state, path, mis_ray_t) = 0.0f;
   INTEGRATOR_STATE_WRITE(state, path, min_ray_pdf) = fminf(
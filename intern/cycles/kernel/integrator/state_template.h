@@ -51,6 +51,10 @@ KERNEL_STRUCT_MEMBER(path, packed_float3, pass_diffuse_weight, KERNEL_FEATURE_LI
 KERNEL_STRUCT_MEMBER(path, packed_float3, pass_glossy_weight, KERNEL_FEATURE_LIGHT_PASSES)
 /* Denoising. */
 KERNEL_STRUCT_MEMBER(path, packed_float3, denoising_feature_throughput, KERNEL_FEATURE_DENOISING)
+/* Path guiding training: bin of the direction sampled at the last guided scatter point, and
+ * weight to convert contributions to incident radiance estimates at that point. */
+KERNEL_STRUCT_MEMBER(path, int, guiding_bin, KERNEL_FEATURE_PATH_GUIDING)
+KERNEL_STRUCT_MEMBER(path, float, guiding_weight, KERNEL_FEATURE_PATH_GUIDING)
 /* Shader sorting. */
 /* TODO: compress as uint16? or leave out entirely and recompute key in sorting code? */
 KERNEL_STRUCT_MEMBER(path, uint32_t, shader_sort_key, KERNEL_FEATURE_PATH_TRACING)
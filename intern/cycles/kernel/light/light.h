@@ -817,15 +817,20 @@ ccl_device_forceinline void triangle_light_sample(KernelGlobals kg,
 
 /* Light Distribution */
 
-ccl_device int light_distribution_sample(KernelGlobals kg, ccl_private float *randu)
+ccl_device int light_distribution_sample_range(KernelGlobals kg,
+                                               ccl_private float *randu,
+                                               const int offset,
+                                               const int num)
 {
   /* This is basically std::upper_bound as used by PBRT, to find a point light or
    * triangle to emit from, proportional to area. a good improvement would be to
    * also sample proportional to power, though it's not so well defined with
    * arbitrary shaders. */
-  int first = 0;
-  int len = kernel_data.integrator.num_distribution + 1;
-  float r = *randu;
+  const float cdf_min = kernel_tex_fetch(__light_distribution, offset).totarea;
+  const float cdf_max = kernel_tex_fetch(__light_distribution, offset + num).totarea;
+  int first = offset;
+  int len = num + 1;
+  float r = cdf_min + *randu * (cdf_max - cdf_min);
 
   do {
     int half_len = len >> 1;
@@ -842,7 +847,7 @@ ccl_device int light_distribution_sample(KernelGlobals kg, ccl_private float *ra
 
   /* Clamping should not be needed but float rounding errors seem to
    * make this fail on rare occasions. */
-  int index = clamp(first - 1, 0, kernel_data.integrator.num_distribution - 1);
+  int index = clamp(first - 1, offset, offset + num - 1);
 
   /* Rescale to reuse random number. this helps the 2D samples within
    * each area light be stratified as well. */
@@ -853,6 +858,113 @@ ccl_device int light_distribution_sample(KernelGlobals kg, ccl_private float *ra
   return index;
 }
 
+ccl_device int light_distribution_sample(KernelGlobals kg, ccl_private float *randu)
+{
+  return light_distribution_sample_range(kg, randu, 0, kernel_data.integrator.num_distribution);
+}
+
+/* Light Tree
+ *
+ * Local emitters are grouped in a binary tree, which is traversed picking the child with the
+ * higher estimated contribution to the shading point more often. Infinite lights are not part
+ * of the tree and keep their probability from the light distribution. */
+
+ccl_device_inline float light_tree_node_importance(KernelGlobals kg,
+                                                   const int node_index,
+                                                   const float3 P)
+{
+  ccl_global const KernelLightTreeNode *knode = &kernel_tex_fetch(__light_tree_nodes,
+                                                                  node_index);
+  const float3 center = make_float3(knode->center[0], knode->center[1], knode->center[2]);
+  /* Don't let the importance blow up for points inside the bounds. */
+  const float distance_sq = max(max(len_squared(P - center), knode->radius_sq), FLT_MIN);
+  return knode->mass / distance_sq;
+}
+
+ccl_device_inline float light_tree_child_probability(const float importance,
+                                                     const float importance_sibling)
+{
+  const float total = importance + importance_sibling;
+  return (total > 0.0f) ? importance / total : 0.5f;
+}
+
+/* Pick a leaf and an entry of its light distribution range. The returned factor converts the
+ * probability of the entry in the light distribution to the probability of picking it here. */
+ccl_device int light_tree_sample(KernelGlobals kg,
+                                 ccl_private float *randu,
+                                 const float3 P,
+                                 ccl_private float *pdf_factor)
+{
+  int node_index = 0;
+  float pdf = 1.0f;
+  float r = *randu;
+
+  ccl_global const KernelLightTreeNode *knode = &kernel_tex_fetch(__light_tree_nodes, 0);
+  while (knode->num == 0) {
+    const float prob_left = light_tree_child_probability(
+        light_tree_node_importance(kg, knode->left, P),
+        light_tree_node_importance(kg, knode->right, P));
+
+    /* Rescale to reuse the random number for the next level. */
+    if (r < prob_left) {
+      r = r / prob_left;
+      pdf *= prob_left;
+      node_index = knode->left;
+    }
+    else {
+      r = (r - prob_left) / (1.0f - prob_left);
+      pdf *= 1.0f - prob_left;
+      node_index = knode->right;
+    }
+    r = min(r, 1.0f - FLT_EPSILON);
+
+    knode = &kernel_tex_fetch(__light_tree_nodes, node_index);
+  }
+
+  *randu = r;
+  *pdf_factor = (knode->mass > 0.0f) ? pdf * kernel_data.integrator.light_tree_mass / knode->mass :
+                                       0.0f;
+  return light_distribution_sample_range(kg, randu, knode->first, knode->num);
+}
+
+/* Factor to apply to the light distribution pdf of an emitter hit by a ray leaving P, matching
+ * the sampling above. Emitters are objects, or lamps after the lamp offset. */
+ccl_device float light_tree_pdf_factor(KernelGlobals kg,
+                                       const int emitter,
+                                       const float3 P,
+                                       const uint32_t path_flag)
+{
+  /* Volume scattering samples lights without the tree, see shade_volume.h. */
+  if (!kernel_data.integrator.use_light_tree || (path_flag & PATH_RAY_VOLUME_SCATTER)) {
+    return 1.0f;
+  }
+
+  int node_index = kernel_tex_fetch(__light_tree_emitter_leaf, emitter);
+  if (node_index == -1) {
+    /* Infinite lights. */
+    return 1.0f;
+  }
+
+  ccl_global const KernelLightTreeNode *knode = &kernel_tex_fetch(__light_tree_nodes,
+                                                                  node_index);
+  if (knode->mass == 0.0f) {
+    return 0.0f;
+  }
+
+  float pdf = kernel_data.integrator.light_tree_mass / knode->mass;
+  while (knode->parent != -1) {
+    const int parent_index = knode->parent;
+    knode = &kernel_tex_fetch(__light_tree_nodes, parent_index);
+
+    const int sibling_index = (knode->left == node_index) ? knode->right : knode->left;
+    pdf *= light_tree_child_probability(light_tree_node_importance(kg, node_index, P),
+                                        light_tree_node_importance(kg, sibling_index, P));
+    node_index = parent_index;
+  }
+
+  return pdf;
+}
+
 /* Generic Light */
 
 ccl_device_inline bool light_select_reached_max_bounces(KernelGlobals kg, int index, int bounce)
@@ -868,10 +980,34 @@ ccl_device_noinline bool light_distribution_sample(KernelGlobals kg,
                                                    const float3 P,
                                                    const int bounce,
                                                    const uint32_t path_flag,
+                                                   const bool use_light_tree,
                                                    ccl_private LightSample *ls)
 {
   /* Sample light index from distribution. */
-  const int index = light_distribution_sample(kg, &randu);
+  float pdf_factor = 1.0f;
+  int index;
+  if (use_light_tree && kernel_data.integrator.use_light_tree) {
+    const float light_tree_mass = kernel_data.integrator.light_tree_mass;
+    const int num_local = kernel_data.integrator.light_tree_num_distribution;
+    if (randu < light_tree_mass) {
+      randu = randu / light_tree_mass;
+      index = light_tree_sample(kg, &randu, P, &pdf_factor);
+    }
+    else {
+      /* Infinite lights, with the same probability as in the light distribution. */
+      randu = (randu - light_tree_mass) / (1.0f - light_tree_mass);
+      index = light_distribution_sample_range(
+          kg, &randu, num_local, kernel_data.integrator.num_distribution - num_local);
+    }
+  }
+  else {
+    index = light_distribution_sample(kg, &randu);
+  }
+
+  if (UNLIKELY(pdf_factor == 0.0f)) {
+    return false;
+  }
+
   ccl_global const KernelLightDistribution *kdistribution = &kernel_tex_fetch(__light_distribution,
                                                                               index);
   const int prim = kdistribution->prim;
@@ -889,6 +1025,7 @@ ccl_device_noinline bool light_distribution_sample(KernelGlobals kg,
     const int shader_flag = kdistribution->mesh_light.shader_flag;
     triangle_light_sample<in_volume_segment>(kg, prim, object, randu, randv, time, ls, P);
     ls->shader |= shader_flag;
+    ls->pdf *= pdf_factor;
     return (ls->pdf > 0.0f);
   }
 
@@ -898,7 +1035,11 @@ ccl_device_noinline bool light_distribution_sample(KernelGlobals kg,
     return false;
   }
 
-  return light_sample<in_volume_segment>(kg, lamp, randu, randv, P, path_flag, ls);
+  if (!light_sample<in_volume_segment>(kg, lamp, randu, randv, P, path_flag, ls)) {
+    return false;
+  }
+  ls->pdf *= pdf_factor;
+  return true;
 }
 
 ccl_device_inline bool light_distribution_sample_from_volume_segment(KernelGlobals kg,
@@ -910,7 +1051,7 @@ ccl_device_inline bool light_distribution_sample_from_volume_segment(KernelGloba
                                                                      const uint32_t path_flag,
                                                                      ccl_private LightSample *ls)
 {
-  return light_distribution_sample<true>(kg, randu, randv, time, P, bounce, path_flag, ls);
+  return light_distribution_sample<true>(kg, randu, randv, time, P, bounce, path_flag, false, ls);
 }
 
 ccl_device_inline bool light_distribution_sample_from_position(KernelGlobals kg,
@@ -922,7 +1063,22 @@ ccl_device_inline bool light_distribution_sample_from_position(KernelGlobals kg,
                                                                const uint32_t path_flag,
                                                                ccl_private LightSample *ls)
 {
-  return light_distribution_sample<false>(kg, randu, randv, time, P, bounce, path_flag, ls);
+  return light_distribution_sample<false>(
+      kg, randu, randv, time, P, bounce, path_flag, false, ls);
+}
+
+/* Same as above but using the light tree, for surfaces. Rays leaving the surface must account
+ * for it in their MIS weights through light_tree_pdf_factor. */
+ccl_device_inline bool light_distribution_sample_from_surface(KernelGlobals kg,
+                                                              float randu,
+                                                              const float randv,
+                                                              const float time,
+                                                              const float3 P,
+                                                              const int bounce,
+                                                              const uint32_t path_flag,
+                                                              ccl_private LightSample *ls)
+{
+  return light_distribution_sample<false>(kg, randu, randv, time, P, bounce, path_flag, true, ls);
 }
 
 ccl_device_inline bool light_distribution_sample_new_position(KernelGlobals kg,
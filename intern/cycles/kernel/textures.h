@@ -28,7 +28,7 @@ KERNEL_TEX(DecomposedTransform, __camera_motion)
 
 /* triangles */
 KERNEL_TEX(uint, __tri_shader)
-KERNEL_TEX(packed_float3, __tri_vnormal)
+KERNEL_TEX(uint, __tri_vnormal)
 KERNEL_TEX(uint4, __tri_vindex)
 KERNEL_TEX(uint, __tri_patch)
 KERNEL_TEX(float2, __tri_patch_uv)
@@ -57,9 +57,15 @@ KERNEL_TEX(uchar4, __attributes_uchar4)
 /* lights */
 KERNEL_TEX(KernelLightDistribution, __light_distribution)
 KERNEL_TEX(KernelLight, __lights)
+KERNEL_TEX(KernelLightTreeNode, __light_tree_nodes)
+KERNEL_TEX(int, __light_tree_emitter_leaf)
 KERNEL_TEX(float2, __light_background_marginal_cdf)
 KERNEL_TEX(float2, __light_background_conditional_cdf)
 
+/* path guiding */
+KERNEL_TEX(float, __guiding_train)
+KERNEL_TEX(float, __guiding_distribution)
+
 /* particles */
 KERNEL_TEX(KernelParticle, __particles)
 
@@ -96,6 +96,7 @@ CCL_NAMESPACE_BEGIN
 #    define __OSL__
 #  endif
 #  define __VOLUME_RECORD_ALL__
+#  define __PATH_GUIDING__
 #endif /* __KERNEL_CPU__ */
 
 #ifdef __KERNEL_GPU_RAYTRACING__
@@ -174,7 +175,8 @@ enum PathTraceDimension {
   PRNG_TERMINATE = 5,
   PRNG_PHASE_CHANNEL = 6,
   PRNG_SCATTER_DISTANCE = 7,
-  PRNG_BOUNCE_NUM = 8,
+  PRNG_GUIDING = 8,
+  PRNG_BOUNCE_NUM = 9,
 
   PRNG_BEVEL_U = 6, /* reuse volume dimension, correlation won't harm */
   PRNG_BEVEL_V = 7,
@@ -1157,6 +1159,12 @@ typedef struct KernelBackground {
 } KernelBackground;
 static_assert_align(KernelBackground, 16);
 
+/* Path guiding resolution, as number of grid cells along each axis and direction bins along
+ * each dimension of the sphere mapping. */
+#define GUIDING_GRID_RESOLUTION 16
+#define GUIDING_DIRECTION_RESOLUTION 16
+#define GUIDING_NUM_BINS (GUIDING_DIRECTION_RESOLUTION * GUIDING_DIRECTION_RESOLUTION)
+
 typedef struct KernelIntegrator {
   /* emission */
   int use_direct_light;
@@ -1208,6 +1216,7 @@ typedef struct KernelIntegrator {
   int use_volumes;
   int volume_max_steps;
   float volume_step_rate;
+  int volume_skip_empty;
 
   int has_shadow_catcher;
   float scrambling_distance;
@@ -1218,8 +1227,25 @@ typedef struct KernelIntegrator {
   /* MIS debugging. */
   int direct_light_sampling_type;
 
-  /* padding */
-  int pad1, pad2;
+  /* Light tree. */
+  int use_light_tree;
+  /* Probability of sampling the lights in the tree, the others are infinite lights. */
+  float light_tree_mass;
+  /* Number of light distribution entries in the tree, infinite lights come after them. */
+  int light_tree_num_distribution;
+  /* Offset of lamps in the emitter to leaf map, objects come first. */
+  int light_tree_lamp_offset;
+
+  /* Path guiding. */
+  int use_guiding;
+  /* Samples below this one train the guiding distribution, which is used for the samples after.
+   * Includes the start sample of the render. */
+  int guiding_training_samples;
+  /* Probability of sampling the guiding distribution instead of the BSDF. */
+  float guiding_probability;
+  /* Mapping from world space to the spatial grid of guiding cells. */
+  float guiding_grid_min[3];
+  float guiding_grid_scale[3];
 } KernelIntegrator;
 static_assert_align(KernelIntegrator, 16);
 
@@ -1410,6 +1436,21 @@ typedef struct KernelLightDistribution {
 } KernelLightDistribution;
 static_assert_align(KernelLightDistribution, 16);
 
+typedef struct KernelLightTreeNode {
+  /* Bounding sphere of the emitters below the node, used to estimate their importance. */
+  float center[3];
+  float radius_sq;
+  /* Probability of the emitters below the node in the light distribution. */
+  float mass;
+  int parent;
+  /* Inner nodes. */
+  int left, right;
+  /* Leaves, range of the light distribution of a single emitter. 0 for inner nodes. */
+  int first, num;
+  int pad1, pad2;
+} KernelLightTreeNode;
+static_assert_align(KernelLightTreeNode, 16);
+
 typedef struct KernelParticle {
   int index;
   float age;
@@ -1513,6 +1554,7 @@ typedef enum DeviceKernel {
   DEVICE_KERNEL_INTEGRATOR_COMPACT_SHADOW_STATES,
   DEVICE_KERNEL_INTEGRATOR_RESET,
   DEVICE_KERNEL_INTEGRATOR_SHADOW_CATCHER_COUNT_POSSIBLE_SPLITS,
+  DEVICE_KERNEL_INTEGRATOR_INIT_FROM_ACTIVE_PIXELS,
 
   DEVICE_KERNEL_SHADER_EVAL_DISPLACE,
   DEVICE_KERNEL_SHADER_EVAL_BACKGROUND,
@@ -1539,6 +1581,7 @@ typedef enum DeviceKernel {
   DEVICE_KERNEL_ADAPTIVE_SAMPLING_CONVERGENCE_CHECK,
   DEVICE_KERNEL_ADAPTIVE_SAMPLING_CONVERGENCE_FILTER_X,
   DEVICE_KERNEL_ADAPTIVE_SAMPLING_CONVERGENCE_FILTER_Y,
+  DEVICE_KERNEL_ADAPTIVE_SAMPLING_ACTIVE_PIXELS_ARRAY,
 
   DEVICE_KERNEL_FILTER_GUIDING_PREPROCESS,
   DEVICE_KERNEL_FILTER_GUIDING_SET_FAKE_ALBEDO,
@@ -1614,6 +1657,9 @@ enum KernelFeatureFlag : uint32_t {
   KERNEL_FEATURE_AO_PASS = (1U << 25U),
   KERNEL_FEATURE_AO_ADDITIVE = (1U << 26U),
   KERNEL_FEATURE_AO = (KERNEL_FEATURE_AO_PASS | KERNEL_FEATURE_AO_ADDITIVE),
+
+  /* Path guiding. */
+  KERNEL_FEATURE_PATH_GUIDING = (1U << 27U),
 };
 
 /* Shader node feature mask, to specialize shader evaluation for kernels. */
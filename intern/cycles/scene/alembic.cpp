@@ -750,6 +750,9 @@ AlembicProcedural::AlembicProcedural() : Procedural(get_node_type())
 {
   objects_loaded = false;
   scene_ = nullptr;
+  loaded_frame_start = 1.0f;
+  loaded_frame_end = 0.0f;
+  prefetch_window_frames = 0;
 }
 
 AlembicProcedural::~AlembicProcedural()
@@ -872,29 +875,14 @@ void AlembicProcedural::generate(Scene *scene, Progress &progress)
     }
   }
 
-  if (use_prefetch_is_modified()) {
-    if (!use_prefetch) {
-      for (Node *node : objects) {
-        AlembicObject *object = static_cast<AlembicObject *>(node);
-        object->clear_cache();
-      }
-    }
+  if (use_prefetch_is_modified() || prefetch_cache_size_is_modified() ||
+      start_frame_is_modified() || end_frame_is_modified()) {
+    /* Try to fit the entire animation in the cache again. */
+    prefetch_window_frames = 0;
+    loaded_frame_end = loaded_frame_start - 1.0f;
   }
 
-  if (prefetch_cache_size_is_modified()) {
-    /* Check whether the current memory usage fits in the new requested size,
-     * abort the render if it is any higher. */
-    size_t memory_used = 0ul;
-    for (Node *node : objects) {
-      AlembicObject *object = static_cast<AlembicObject *>(node);
-      memory_used += object->get_cached_data().memory_used();
-    }
-
-    if (memory_used > get_prefetch_cache_size_in_bytes()) {
-      progress.set_error("Error: Alembic Procedural memory limit reached");
-      return;
-    }
-  }
+  update_cache_window();
 
   build_caches(progress);
 
@@ -1438,7 +1426,63 @@ void AlembicProcedural::walk_hierarchy(
   }
 }
 
+void AlembicProcedural::update_cache_window()
+{
+  /* Frames outside of the animation range use the data of the nearest frame in it. */
+  const float current_frame = clamp(frame, start_frame, end_frame);
+  float window_start = current_frame;
+  float window_end = current_frame;
+
+  if (use_prefetch) {
+    if (prefetch_window_frames == 0) {
+      window_start = start_frame;
+      window_end = end_frame;
+    }
+    else {
+      window_end = min(end_frame, current_frame + (float)(prefetch_window_frames - 1));
+    }
+  }
+
+  if (current_frame >= loaded_frame_start && current_frame <= loaded_frame_end) {
+    return;
+  }
+
+  loaded_frame_start = window_start;
+  loaded_frame_end = window_end;
+
+  for (Node *node : objects) {
+    AlembicObject *object = static_cast<AlembicObject *>(node);
+
+    /* Data which does not change within a window may still change in the next one, so tag the
+     * object to ensure the new data is set on the geometry even if it looks constant. */
+    object->clear_cache();
+    object->tag_modified();
+  }
+}
+
 void AlembicProcedural::build_caches(Progress &progress)
+{
+  while (!load_caches(progress)) {
+    const int window_frames = (int)(loaded_frame_end - loaded_frame_start) + 1;
+
+    if (window_frames <= 1) {
+      progress.set_error("Error: Alembic Procedural memory limit reached");
+      return;
+    }
+
+    /* Only keep part of the animation in memory, the next frames are loaded when the current
+     * frame leaves the window. */
+    prefetch_window_frames = window_frames / 2;
+    loaded_frame_end = loaded_frame_start - 1.0f;
+
+    VLOG(1) << "AlembicProcedural prefetch cache size exceeded, loading " << prefetch_window_frames
+            << " frames at once";
+
+    update_cache_window();
+  }
+}
+
+bool AlembicProcedural::load_caches(Progress &progress)
 {
   size_t memory_used = 0;
 
@@ -1446,7 +1490,7 @@ void AlembicProcedural::build_caches(Progress &progress)
     AlembicObject *object = static_cast<AlembicObject *>(node);
 
     if (progress.get_cancel()) {
-      return;
+      return true;
     }
 
     if (object->schema_type == AlembicObject::POLY_MESH) {
@@ -1508,13 +1552,13 @@ void AlembicProcedural::build_caches(Progress &progress)
 
     if (use_prefetch) {
       if (memory_used > get_prefetch_cache_size_in_bytes()) {
-        progress.set_error("Error: Alembic Procedural memory limit reached");
-        return;
+        return false;
       }
     }
   }
 
   VLOG(1) << "AlembicProcedural memory usage : " << string_human_readable_size(memory_used);
+  return true;
 }
 
 CCL_NAMESPACE_END
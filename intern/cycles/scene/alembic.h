@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "graph/node.h"
 #include "scene/attribute.h"
 #include "scene/procedural.h"
@@ -277,9 +279,25 @@ template<typename T> class DataStore {
  private:
   const TimeIndexPair &get_index_for_time(double time) const
   {
-    std::pair<size_t, Alembic::Abc::chrono_t> index_pair;
-    index_pair = time_sampling.getNearIndex(time, index_data_map.size());
-    return index_data_map[index_pair.first];
+    /* The entries are in chronological order, but only cover the window of frames that was
+     * loaded, so they do not necessarily start at the first sample of the time sampling. Look up
+     * the entry nearest to the time. */
+    auto it = std::lower_bound(index_data_map.begin(),
+                               index_data_map.end(),
+                               time,
+                               [](const TimeIndexPair &index, double value) {
+                                 return index.time < value;
+                               });
+
+    if (it == index_data_map.end()) {
+      return index_data_map.back();
+    }
+
+    if (it != index_data_map.begin() && (time - (it - 1)->time) <= (it->time - time)) {
+      return *(it - 1);
+    }
+
+    return *it;
   }
 };
 
@@ -435,6 +453,7 @@ class AlembicObject : public Node {
   void clear_cache()
   {
     cached_data_.clear();
+    data_loaded = false;
   }
 
   Object *object = nullptr;
@@ -456,12 +475,24 @@ class AlembicObject : public Node {
  * This procedural will load the data set for the entire animation in memory on the first frame,
  * and directly set the data for the new frames on the created Nodes if needed. This allows for
  * faster updates between frames as it avoids reseeking the data on disk.
+ *
+ * If the entire animation does not fit in the prefetch cache, only a window of frames starting
+ * at the current frame is loaded, and the next window is loaded once the current frame leaves it.
  */
 class AlembicProcedural : public Procedural {
   Alembic::AbcGeom::IArchive archive;
   bool objects_loaded;
   Scene *scene_;
 
+  /* Range of frames for which data is loaded in the caches, empty if the end is before the
+   * start. */
+  float loaded_frame_start;
+  float loaded_frame_end;
+
+  /* Number of frames loaded at once when prefetching, zero to load the entire animation. Reduced
+   * when the animation does not fit in the prefetch cache. */
+  int prefetch_window_frames;
+
  public:
   NODE_DECLARE
 
@@ -525,6 +556,17 @@ class AlembicProcedural : public Procedural {
    * Returns a pointer to an existing or a newly created AlembicObject for the given path. */
   AlembicObject *get_or_create_object(const ustring &path);
 
+  /* Range of frames to load data for. */
+  float get_loaded_frame_start() const
+  {
+    return loaded_frame_start;
+  }
+
+  float get_loaded_frame_end() const
+  {
+    return loaded_frame_end;
+  }
+
  private:
   /* Add an object to our list of objects, and tag the socket as modified. */
   void add_object(AlembicObject *object);
@@ -557,8 +599,16 @@ class AlembicProcedural : public Procedural {
    * Object Nodes in the Cycles scene if none exist yet. */
   void read_subd(AlembicObject *abc_object, Alembic::AbcGeom::Abc::chrono_t frame_time);
 
+  /* Choose the window of frames to load data for, and clear the caches if it changed. */
+  void update_cache_window();
+
+  /* Load the data for the current window of frames, shrinking the window if it does not fit in
+   * the prefetch cache. */
   void build_caches(Progress &progress);
 
+  /* Returns false if the prefetch cache size was exceeded. */
+  bool load_caches(Progress &progress);
+
   size_t get_prefetch_cache_size_in_bytes() const
   {
     /* prefetch_cache_size is in megabytes, so convert to bytes. */
@@ -34,16 +34,10 @@ static set<chrono_t> get_relevant_sample_times(AlembicProcedural *proc,
   double start_frame;
   double end_frame;
 
-  if (proc->get_use_prefetch()) {
-    // load the data for the entire animation
-    start_frame = static_cast<double>(proc->get_start_frame());
-    end_frame = static_cast<double>(proc->get_end_frame());
-  }
-  else {
-    // load the data for the current frame
-    start_frame = static_cast<double>(proc->get_frame());
-    end_frame = start_frame;
-  }
+  // load the data for the current window of frames, which is either the entire animation or the
+  // current frame if prefetching is disabled
+  start_frame = static_cast<double>(proc->get_loaded_frame_start());
+  end_frame = static_cast<double>(proc->get_loaded_frame_end());
 
   const double frame_rate = static_cast<double>(proc->get_frame_rate());
   const double start_time = start_frame / frame_rate;
@@ -78,6 +78,7 @@ void Geometry::clear(bool preserve_shaders)
   transform_applied = false;
   transform_negative_scaled = false;
   transform_normal = transform_identity();
+  sync_hash.clear();
   tag_modified();
 }
 
@@ -1127,7 +1128,7 @@ void GeometryManager::device_update_mesh(Device *,
 
     packed_float3 *tri_verts = dscene->tri_verts.alloc(tri_size * 3);
     uint *tri_shader = dscene->tri_shader.alloc(tri_size);
-    packed_float3 *vnormal = dscene->tri_vnormal.alloc(vert_size);
+    uint *vnormal = dscene->tri_vnormal.alloc(vert_size);
     uint4 *tri_vindex = dscene->tri_vindex.alloc(tri_size);
     uint *tri_patch = dscene->tri_patch.alloc(tri_size);
     float2 *tri_patch_uv = dscene->tri_patch_uv.alloc(vert_size);
@@ -1280,9 +1281,16 @@ void GeometryManager::device_update_bvh(Device *device,
 
   VLOG(1) << "Using " << bvh_layout_name(bparams.bvh_layout) << " layout.";
 
+  /* The scene BVH is deleted when geometry is added, removed or rebuilt, so otherwise only
+   * transforms and deformations changed. In the viewport BVH2 and Embree can then refit the
+   * existing top level, unless objects may have become traceable or not. */
+  const bool use_dynamic_refit = bparams.bvh_type == BVH_TYPE_DYNAMIC &&
+                                 (bparams.bvh_layout == BVHLayout::BVH_LAYOUT_BVH2 ||
+                                  bparams.bvh_layout == BVHLayout::BVH_LAYOUT_EMBREE) &&
+                                 (update_flags & VISIBILITY_MODIFIED) == 0;
   const bool can_refit = scene->bvh != nullptr &&
                          (bparams.bvh_layout == BVHLayout::BVH_LAYOUT_OPTIX ||
-                          bparams.bvh_layout == BVHLayout::BVH_LAYOUT_METAL);
+                          bparams.bvh_layout == BVHLayout::BVH_LAYOUT_METAL || use_dynamic_refit);
 
   BVH *bvh = scene->bvh;
   if (!scene->bvh) {
@@ -1292,6 +1300,9 @@ void GeometryManager::device_update_bvh(Device *device,
   device->build_bvh(bvh, progress, can_refit);
 
   if (progress.get_cancel()) {
+    /* Don't refit an incomplete BVH on the next update. */
+    delete scene->bvh;
+    scene->bvh = nullptr;
     return;
   }
 
@@ -1299,7 +1310,13 @@ void GeometryManager::device_update_bvh(Device *device,
 
   PackedBVH pack;
   if (has_bvh2_layout) {
-    pack = std::move(static_cast<BVH2 *>(bvh)->pack);
+    if (bparams.bvh_type == BVH_TYPE_DYNAMIC) {
+      /* Keep the packed nodes for refitting on the next update. */
+      pack = static_cast<BVH2 *>(bvh)->pack;
+    }
+    else {
+      pack = std::move(static_cast<BVH2 *>(bvh)->pack);
+    }
   }
   else {
     pack.root_index = -1;
@@ -79,6 +79,10 @@ class Geometry : public Node {
   bool need_update_rebuild;
   bool need_update_bvh_for_offset;
 
+  /* Hash of the data from the last sync, used by the synchronization code to skip updates
+   * when identical data is synced again. Reset when the geometry is cleared. */
+  string sync_hash;
+
   /* Index into scene->geometry (only valid during update) */
   size_t index;
 
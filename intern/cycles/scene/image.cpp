@@ -15,6 +15,7 @@
 #include "util/log.h"
 #include "util/path.h"
 #include "util/progress.h"
+#include "util/tbb.h"
 #include "util/task.h"
 #include "util/texture.h"
 #include "util/unique_ptr.h"
@@ -72,6 +73,67 @@ const char *name_from_type(ImageDataType type)
   return "";
 }
 
+/* Size in bytes of a single pixel in device memory, zero for sparse volume grids. */
+size_t pixel_size_from_type(ImageDataType type)
+{
+  switch (type) {
+    case IMAGE_DATA_TYPE_FLOAT4:
+      return sizeof(float4);
+    case IMAGE_DATA_TYPE_BYTE4:
+      return sizeof(uchar4);
+    case IMAGE_DATA_TYPE_HALF4:
+      return sizeof(half4);
+    case IMAGE_DATA_TYPE_FLOAT:
+      return sizeof(float);
+    case IMAGE_DATA_TYPE_BYTE:
+      return sizeof(uchar);
+    case IMAGE_DATA_TYPE_HALF:
+      return sizeof(half);
+    case IMAGE_DATA_TYPE_USHORT4:
+      return sizeof(ushort4);
+    case IMAGE_DATA_TYPE_USHORT:
+      return sizeof(uint16_t);
+    case IMAGE_DATA_TYPE_NANOVDB_FLOAT:
+    case IMAGE_DATA_TYPE_NANOVDB_FLOAT3:
+    case IMAGE_DATA_NUM_TYPES:
+      return 0;
+  }
+  return 0;
+}
+
+/* Resolution of the largest image dimension after applying the texture limit,
+ * matching the power of two scaling in file_load_image. */
+size_t image_limited_resolution(const ImageMetaData &metadata, const int texture_limit)
+{
+  size_t resolution = max(max(metadata.width, metadata.height), metadata.depth);
+  if (texture_limit > 0) {
+    while (resolution > (size_t)texture_limit) {
+      resolution /= 2;
+    }
+  }
+  return resolution;
+}
+
+/* Estimated device memory of the image after applying the texture limit. */
+size_t image_limited_memory_size(const ImageMetaData &metadata, const int texture_limit)
+{
+  const size_t pixel_size = pixel_size_from_type(metadata.type);
+  if (pixel_size == 0) {
+    return metadata.byte_size;
+  }
+
+  const size_t resolution = max(max(metadata.width, metadata.height), metadata.depth);
+  if (resolution == 0) {
+    return 0;
+  }
+
+  const double scale = (double)image_limited_resolution(metadata, texture_limit) / resolution;
+  const size_t width = max((size_t)(metadata.width * scale), (size_t)1);
+  const size_t height = max((size_t)(metadata.height * scale), (size_t)1);
+  const size_t depth = max((size_t)(metadata.depth * scale), (size_t)1);
+  return width * height * depth * pixel_size;
+}
+
 }  // namespace
 
 /* Image Handle */
@@ -433,6 +495,7 @@ int ImageManager::add_image_slot(ImageLoader *loader,
   img->need_metadata = true;
   img->need_load = !(osl_texture_system && !img->loader->osl_filepath().empty());
   img->builtin = builtin;
+  img->texture_limit = 0;
   img->users = 1;
   img->mem = NULL;
 
@@ -643,7 +706,10 @@ void ImageManager::device_load_image(Device *device, Scene *scene, int slot, Pro
 
   progress->set_status("Updating Images", "Loading " + img->loader->name());
 
-  const int texture_limit = scene->params.texture_limit;
+  int texture_limit = scene->params.texture_limit;
+  if (img->texture_limit > 0 && (texture_limit == 0 || img->texture_limit < texture_limit)) {
+    texture_limit = img->texture_limit;
+  }
 
   load_image_metadata(img);
   ImageDataType type = img->metadata.type;
@@ -795,6 +861,93 @@ void ImageManager::device_free_image(Device *, int slot)
   images[slot] = NULL;
 }
 
+void ImageManager::device_update_texture_limits(Scene *scene)
+{
+  /* Reduce the resolution of the largest images to be loaded until all images fit in the
+   * texture memory budget. Images that are already on the device are left as is, there
+   * is no streaming so they would have to be loaded again. */
+  const size_t memory_limit = scene->params.texture_memory_limit;
+  const int scene_texture_limit = scene->params.texture_limit;
+  /* Smallest resolution to scale images down to, matching the lowest texture limit. */
+  const size_t min_resolution = 128;
+
+  vector<Image *> load_images;
+  size_t memory_size = 0;
+
+  foreach (Image *img, images) {
+    if (img == NULL || img->users == 0) {
+      continue;
+    }
+    if (img->need_load) {
+      img->texture_limit = 0;
+      load_images.push_back(img);
+    }
+    else if (img->mem) {
+      memory_size += img->mem->memory_size();
+    }
+  }
+
+  if (memory_limit == 0 || load_images.empty()) {
+    return;
+  }
+
+  parallel_for(blocked_range<size_t>(0, load_images.size()), [&](const blocked_range<size_t> &r) {
+    for (size_t i = r.begin(); i != r.end(); i++) {
+      load_image_metadata(load_images[i]);
+    }
+  });
+
+  vector<int> limits(load_images.size(), scene_texture_limit);
+  vector<size_t> sizes(load_images.size());
+  for (size_t i = 0; i < load_images.size(); i++) {
+    sizes[i] = image_limited_memory_size(load_images[i]->metadata, limits[i]);
+    memory_size += sizes[i];
+  }
+
+  const size_t full_memory_size = memory_size;
+
+  while (memory_size > memory_limit) {
+    /* Halve the resolution of the image using the most memory. */
+    size_t largest = load_images.size();
+    for (size_t i = 0; i < load_images.size(); i++) {
+      const ImageMetaData &metadata = load_images[i]->metadata;
+      if (pixel_size_from_type(metadata.type) == 0 ||
+          image_limited_resolution(metadata, limits[i]) <= min_resolution) {
+        continue;
+      }
+      if (largest == load_images.size() || sizes[i] > sizes[largest]) {
+        largest = i;
+      }
+    }
+
+    if (largest == load_images.size()) {
+      break;
+    }
+
+    const ImageMetaData &metadata = load_images[largest]->metadata;
+    limits[largest] = image_limited_resolution(metadata, limits[largest]) / 2;
+    memory_size -= sizes[largest];
+    sizes[largest] = image_limited_memory_size(metadata, limits[largest]);
+    memory_size += sizes[largest];
+  }
+
+  if (memory_size == full_memory_size) {
+    return;
+  }
+
+  for (size_t i = 0; i < load_images.size(); i++) {
+    if (limits[i] != scene_texture_limit) {
+      load_images[i]->texture_limit = limits[i];
+      VLOG(2) << "Limiting image " << load_images[i]->loader->name() << " to " << limits[i]
+              << " pixels to fit texture memory budget.";
+    }
+  }
+
+  VLOG(1) << "Reduced image texture memory from " << string_human_readable_size(full_memory_size)
+          << " to " << string_human_readable_size(memory_size) << " for a budget of "
+          << string_human_readable_size(memory_limit) << ".";
+}
+
 void ImageManager::device_update(Device *device, Scene *scene, Progress &progress)
 {
   if (!need_update()) {
@@ -807,6 +960,8 @@ void ImageManager::device_update(Device *device, Scene *scene, Progress &progres
     }
   });
 
+  device_update_texture_limits(scene);
+
   TaskPool pool;
   for (size_t slot = 0; slot < images.size(); slot++) {
     Image *img = images[slot];
@@ -845,6 +1000,8 @@ void ImageManager::device_load_builtin(Device *device, Scene *scene, Progress &p
     return;
   }
 
+  device_update_texture_limits(scene);
+
   TaskPool pool;
   for (size_t slot = 0; slot < images.size(); slot++) {
     Image *img = images[slot];
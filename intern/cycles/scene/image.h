@@ -195,6 +195,8 @@ class ImageManager {
     bool need_metadata;
     bool need_load;
     bool builtin;
+    /* Resolution limit to fit the texture memory budget, zero for unlimited. */
+    int texture_limit;
 
     string mem_name;
     device_texture *mem;
@@ -220,6 +222,7 @@ class ImageManager {
   void remove_image_user(int slot);
 
   void load_image_metadata(Image *img);
+  void device_update_texture_limits(Scene *scene);
 
   template<TypeDesc::BASETYPE FileFormat, typename StorageType>
   bool file_load_image(Image *img, int texture_limit);
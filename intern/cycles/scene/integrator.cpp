@@ -60,6 +60,7 @@ NODE_DEFINE(Integrator)
 
   SOCKET_INT(volume_max_steps, "Volume Max Steps", 1024);
   SOCKET_FLOAT(volume_step_rate, "Volume Step Rate", 1.0f);
+  SOCKET_BOOLEAN(volume_skip_empty, "Volume Skip Empty", false);
 
   SOCKET_BOOLEAN(caustics_reflective, "Reflective Caustics", true);
   SOCKET_BOOLEAN(caustics_refractive, "Refractive Caustics", true);
@@ -85,6 +86,11 @@ NODE_DEFINE(Integrator)
   SOCKET_INT(adaptive_min_samples, "Adaptive Min Samples", 0);
 
   SOCKET_FLOAT(light_sampling_threshold, "Light Sampling Threshold", 0.05f);
+  SOCKET_BOOLEAN(use_light_tree, "Use Light Tree", true);
+
+  SOCKET_BOOLEAN(use_guiding, "Use Guiding", false);
+  SOCKET_INT(guiding_training_samples, "Guiding Training Samples", 32);
+  SOCKET_FLOAT(guiding_probability, "Guiding Probability", 0.5f);
 
   static NodeEnum sampling_pattern_enum;
   sampling_pattern_enum.insert("sobol", SAMPLING_PATTERN_SOBOL);
@@ -194,6 +200,7 @@ void Integrator::device_update(Device *device, DeviceScene *dscene, Scene *scene
 
   kintegrator->volume_max_steps = volume_max_steps;
   kintegrator->volume_step_rate = volume_step_rate;
+  kintegrator->volume_skip_empty = volume_skip_empty;
 
   kintegrator->caustics_reflective = caustics_reflective;
   kintegrator->caustics_refractive = caustics_refractive;
@@ -277,6 +284,49 @@ void Integrator::device_update(Device *device, DeviceScene *dscene, Scene *scene
 
   kintegrator->has_shadow_catcher = scene->has_shadow_catcher();
 
+  /* Path guiding grid over the scene bounds. The learned distributions are reset and built by the
+   * path tracer during rendering, here we only allocate them. */
+  kintegrator->use_guiding = use_guiding;
+  kintegrator->guiding_training_samples = start_sample + max(guiding_training_samples, 1);
+  kintegrator->guiding_probability = clamp(guiding_probability, 0.0f, 1.0f);
+
+  if (use_guiding) {
+    BoundBox bounds = BoundBox::empty;
+    foreach (Object *object, scene->objects) {
+      bounds.grow(object->bounds);
+    }
+
+    if (!bounds.valid()) {
+      bounds = BoundBox(zero_float3(), one_float3());
+    }
+
+    /* Small margin so points on the boundary fall inside the grid. */
+    const float3 margin = max(bounds.size() * 1e-3f, make_float3(1e-4f, 1e-4f, 1e-4f));
+    bounds.min -= margin;
+    bounds.max += margin;
+
+    const float3 size = bounds.size();
+    kintegrator->guiding_grid_min[0] = bounds.min.x;
+    kintegrator->guiding_grid_min[1] = bounds.min.y;
+    kintegrator->guiding_grid_min[2] = bounds.min.z;
+    kintegrator->guiding_grid_scale[0] = GUIDING_GRID_RESOLUTION / size.x;
+    kintegrator->guiding_grid_scale[1] = GUIDING_GRID_RESOLUTION / size.y;
+    kintegrator->guiding_grid_scale[2] = GUIDING_GRID_RESOLUTION / size.z;
+
+    const size_t guiding_size = GUIDING_GRID_RESOLUTION * GUIDING_GRID_RESOLUTION *
+                                GUIDING_GRID_RESOLUTION * GUIDING_NUM_BINS;
+    if (dscene->guiding_train.size() != guiding_size) {
+      dscene->guiding_train.alloc(guiding_size);
+      dscene->guiding_distribution.alloc(guiding_size);
+      dscene->guiding_train.zero_to_device();
+      dscene->guiding_distribution.zero_to_device();
+    }
+  }
+  else {
+    dscene->guiding_train.free();
+    dscene->guiding_distribution.free();
+  }
+
   dscene->sample_pattern_lut.clear_modified();
   clear_modified();
 }
@@ -284,6 +334,11 @@ void Integrator::device_update(Device *device, DeviceScene *dscene, Scene *scene
 void Integrator::device_free(Device *, DeviceScene *dscene, bool force_free)
 {
   dscene->sample_pattern_lut.free_if_need_realloc(force_free);
+
+  if (force_free) {
+    dscene->guiding_train.free();
+    dscene->guiding_distribution.free();
+  }
 }
 
 void Integrator::tag_update(Scene *scene, uint32_t flag)
@@ -311,6 +366,10 @@ void Integrator::tag_update(Scene *scene, uint32_t flag)
     scene->object_manager->tag_update(scene, ObjectManager::MOTION_BLUR_MODIFIED);
     scene->camera->tag_modified();
   }
+
+  if (use_light_tree_is_modified()) {
+    scene->light_manager->tag_update(scene, LightManager::UPDATE_ALL);
+  }
 }
 
 uint Integrator::get_kernel_features() const
@@ -321,6 +380,10 @@ uint Integrator::get_kernel_features() const
     kernel_features |= KERNEL_FEATURE_AO_ADDITIVE;
   }
 
+  if (use_guiding) {
+    kernel_features |= KERNEL_FEATURE_PATH_GUIDING;
+  }
+
   return kernel_features;
 }
 
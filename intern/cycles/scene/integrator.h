@@ -42,6 +42,7 @@ class Integrator : public Node {
 
   NODE_SOCKET_API(int, volume_max_steps)
   NODE_SOCKET_API(float, volume_step_rate)
+  NODE_SOCKET_API(bool, volume_skip_empty)
 
   NODE_SOCKET_API(bool, caustics_reflective)
   NODE_SOCKET_API(bool, caustics_refractive)
@@ -68,6 +69,11 @@ class Integrator : public Node {
   NODE_SOCKET_API(int, start_sample)
 
   NODE_SOCKET_API(float, light_sampling_threshold)
+  NODE_SOCKET_API(bool, use_light_tree)
+
+  NODE_SOCKET_API(bool, use_guiding)
+  NODE_SOCKET_API(int, guiding_training_samples)
+  NODE_SOCKET_API(float, guiding_probability)
 
   NODE_SOCKET_API(bool, use_adaptive_sampling)
   NODE_SOCKET_API(int, adaptive_min_samples)
@@ -258,6 +258,91 @@ bool LightManager::object_usable_as_light(Object *object)
   return false;
 }
 
+/* Light Tree
+ *
+ * Binary tree over the emitters in the light distribution, used to pick lights that are close
+ * to the shading point more often. Each emissive object and each local light is a leaf, which
+ * covers its own range of the light distribution. */
+
+struct LightTreeEmitter {
+  BoundBox bounds;
+  float3 centroid;
+  /* Range in the light distribution. */
+  int first, num;
+  /* Object index, or lamp offset plus light index. */
+  int emitter;
+};
+
+static int light_tree_build_recursive(vector<LightTreeEmitter> &emitters,
+                                      const int begin,
+                                      const int end,
+                                      const int parent,
+                                      const KernelLightDistribution *distribution,
+                                      vector<KernelLightTreeNode> &nodes,
+                                      int *emitter_leaf)
+{
+  const int node_index = nodes.size();
+  nodes.emplace_back();
+
+  BoundBox bounds = BoundBox::empty;
+  BoundBox centroid_bounds = BoundBox::empty;
+  for (int i = begin; i < end; i++) {
+    bounds.grow(emitters[i].bounds);
+    centroid_bounds.grow(emitters[i].centroid);
+  }
+
+  KernelLightTreeNode knode;
+  const float3 center = bounds.center();
+  knode.center[0] = center.x;
+  knode.center[1] = center.y;
+  knode.center[2] = center.z;
+  knode.radius_sq = len_squared(bounds.size()) * 0.25f;
+  knode.parent = parent;
+  knode.pad1 = 0;
+  knode.pad2 = 0;
+
+  if (end - begin == 1) {
+    const LightTreeEmitter &emitter = emitters[begin];
+    knode.mass = distribution[emitter.first + emitter.num].totarea -
+                 distribution[emitter.first].totarea;
+    knode.left = -1;
+    knode.right = -1;
+    knode.first = emitter.first;
+    knode.num = emitter.num;
+    emitter_leaf[emitter.emitter] = node_index;
+  }
+  else {
+    /* Median split along the largest axis of the centroids, keeps the tree balanced. */
+    const float3 extent = centroid_bounds.size();
+    const int axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 :
+                     (extent.y >= extent.z)                         ? 1 :
+                                                                      2;
+    const int mid = (begin + end) / 2;
+    std::nth_element(emitters.begin() + begin,
+                     emitters.begin() + mid,
+                     emitters.begin() + end,
+                     [axis](const LightTreeEmitter &a, const LightTreeEmitter &b) {
+                       return a.centroid[axis] < b.centroid[axis];
+                     });
+
+    knode.left = light_tree_build_recursive(
+        emitters, begin, mid, node_index, distribution, nodes, emitter_leaf);
+    knode.right = light_tree_build_recursive(
+        emitters, mid, end, node_index, distribution, nodes, emitter_leaf);
+    knode.mass = nodes[knode.left].mass + nodes[knode.right].mass;
+    knode.first = 0;
+    knode.num = 0;
+  }
+
+  nodes[node_index] = knode;
+  return node_index;
+}
+
+static bool light_is_infinite(const Light *light)
+{
+  return light->get_light_type() == LIGHT_DISTANT || light->get_light_type() == LIGHT_BACKGROUND;
+}
+
 void LightManager::device_update_distribution(Device *,
                                               DeviceScene *dscene,
                                               Scene *scene,
@@ -312,6 +397,10 @@ void LightManager::device_update_distribution(Device *,
   KernelLightDistribution *distribution = dscene->light_distribution.alloc(num_distribution + 1);
   float totarea = 0.0f;
 
+  /* Emitters for the light tree, infinite lights are not part of it. */
+  vector<LightTreeEmitter> light_tree_emitters;
+  const int light_tree_lamp_offset = scene->objects.size();
+
   /* triangles */
   size_t offset = 0;
   int j = 0;
@@ -350,6 +439,9 @@ void LightManager::device_update_distribution(Device *,
       shader_flag |= SHADER_EXCLUDE_SHADOW_CATCHER;
     }
 
+    const size_t object_offset = offset;
+    BoundBox object_bounds = BoundBox::empty;
+
     size_t mesh_num_triangles = mesh->num_triangles();
     for (size_t i = 0; i < mesh_num_triangles; i++) {
       int shader_index = mesh->get_shader()[i];
@@ -379,22 +471,53 @@ void LightManager::device_update_distribution(Device *,
         }
 
         totarea += triangle_area(p1, p2, p3);
+
+        object_bounds.grow(p1);
+        object_bounds.grow(p2);
+        object_bounds.grow(p3);
       }
     }
 
+    if (offset > object_offset) {
+      LightTreeEmitter emitter;
+      emitter.bounds = object_bounds.valid() ? object_bounds : object->bounds;
+      emitter.centroid = emitter.bounds.center();
+      emitter.first = object_offset;
+      emitter.num = offset - object_offset;
+      emitter.emitter = j;
+      light_tree_emitters.push_back(emitter);
+    }
+
     j++;
   }
 
   float trianglearea = totarea;
+  /* Distribution entries covered by the light tree. */
+  size_t num_light_tree_distribution = offset;
   /* point lights */
   bool use_lamp_mis = false;
   int light_index = 0;
 
   if (num_lights > 0) {
     float lightarea = (totarea > 0.0f) ? totarea / num_lights : 1.0f;
+
+    /* Local lights come first and infinite lights last, so that the light tree covers a
+     * contiguous range of the distribution. The light index still follows the scene order. */
+    vector<std::pair<Light *, int>> enabled_lights;
     foreach (Light *light, scene->lights) {
-      if (!light->is_enabled)
-        continue;
+      if (light->is_enabled) {
+        enabled_lights.push_back(std::make_pair(light, (int)enabled_lights.size()));
+      }
+    }
+    std::stable_partition(enabled_lights.begin(),
+                          enabled_lights.end(),
+                          [](const std::pair<Light *, int> &item) {
+                            return !light_is_infinite(item.first);
+                          });
+
+    for (const std::pair<Light *, int> &item : enabled_lights) {
+      Light *light = item.first;
+      light_index = item.second;
 
       distribution[offset].totarea = totarea;
       distribution[offset].prim = ~light_index;
@@ -402,6 +525,27 @@ void LightManager::device_update_distribution(Device *,
       distribution[offset].lamp.size = light->size;
       totarea += lightarea;
 
+      if (!light_is_infinite(light)) {
+        LightTreeEmitter emitter;
+        if (light->light_type == LIGHT_AREA) {
+          const float3 axisu = light->axisu * (light->sizeu * light->size);
+          const float3 axisv = light->axisv * (light->sizev * light->size);
+          const float3 extent = (fabs(axisu) + fabs(axisv)) * 0.5f;
+          emitter.bounds = BoundBox(light->co - extent, light->co + extent);
+        }
+        else {
+          emitter.bounds = BoundBox(light->co - make_float3(light->size),
+                                    light->co + make_float3(light->size));
+        }
+        emitter.centroid = light->co;
+        emitter.first = offset;
+        emitter.num = 1;
+        emitter.emitter = light_tree_lamp_offset + light_index;
+        light_tree_emitters.push_back(emitter);
+
+        num_light_tree_distribution = offset + 1;
+      }
+
       if (light->light_type == LIGHT_DISTANT) {
         use_lamp_mis |= (light->angle > 0.0f && light->use_mis);
       }
@@ -416,9 +560,10 @@ void LightManager::device_update_distribution(Device *,
         background_mis |= light->use_mis;
       }
 
-      light_index++;
       offset++;
     }
+
+    light_index = num_lights;
   }
 
   /* normalize cumulative distribution functions */
@@ -442,6 +587,48 @@ void LightManager::device_update_distribution(Device *,
   KernelFilm *kfilm = &dscene->data.film;
   kintegrator->use_direct_light = (totarea > 0.0f);
 
+  /* Light tree, only worth it when there is a choice between local emitters. */
+  kintegrator->use_light_tree = false;
+  kintegrator->light_tree_mass = 0.0f;
+  kintegrator->light_tree_num_distribution = 0;
+  kintegrator->light_tree_lamp_offset = light_tree_lamp_offset;
+
+  if (kintegrator->use_direct_light && scene->integrator->get_use_light_tree() &&
+      light_tree_emitters.size() > 1) {
+    int *emitter_leaf = dscene->light_tree_emitter_leaf.alloc(light_tree_lamp_offset +
+                                                              num_lights);
+    std::fill_n(emitter_leaf, light_tree_lamp_offset + num_lights, -1);
+
+    vector<KernelLightTreeNode> nodes;
+    nodes.reserve(light_tree_emitters.size() * 2 - 1);
+    light_tree_build_recursive(light_tree_emitters,
+                               0,
+                               light_tree_emitters.size(),
+                               -1,
+                               distribution,
+                               nodes,
+                               emitter_leaf);
+
+    KernelLightTreeNode *knodes = dscene->light_tree_nodes.alloc(nodes.size());
+    std::copy(nodes.begin(), nodes.end(), knodes);
+
+    dscene->light_tree_nodes.copy_to_device();
+    dscene->light_tree_emitter_leaf.copy_to_device();
+
+    kintegrator->use_light_tree = true;
+    kintegrator->light_tree_num_distribution = num_light_tree_distribution;
+    kintegrator->light_tree_mass = (num_light_tree_distribution == num_distribution) ?
+                                       1.0f :
+                                       distribution[num_light_tree_distribution].totarea;
+
+    VLOG(1) << "Light tree with " << nodes.size() << " nodes for " << light_tree_emitters.size()
+            << " emitters.";
+  }
+  else {
+    dscene->light_tree_nodes.free();
+    dscene->light_tree_emitter_leaf.free();
+  }
+
   if (kintegrator->use_direct_light) {
     /* number of emissives */
     kintegrator->num_distribution = num_distribution;
@@ -997,6 +1184,8 @@ void LightManager::device_free(Device *, DeviceScene *dscene, const bool free_ba
 {
   dscene->light_distribution.free();
   dscene->lights.free();
+  dscene->light_tree_nodes.free();
+  dscene->light_tree_emitter_leaf.free();
   if (free_background) {
     dscene->light_background_marginal_cdf.free();
     dscene->light_background_conditional_cdf.free();
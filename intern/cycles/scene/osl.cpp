@@ -44,6 +44,7 @@ OSLRenderServices *OSLShaderManager::services_shared = NULL;
 int OSLShaderManager::ss_shared_users = 0;
 thread_mutex OSLShaderManager::ss_shared_mutex;
 thread_mutex OSLShaderManager::ss_mutex;
+map<string, OSL::ShaderGroupRef> OSLShaderManager::ss_shared_groups;
 int OSLCompiler::texture_shared_unique_id = 0;
 
 /* Shader Manager */
@@ -99,6 +100,19 @@ void OSLShaderManager::device_update_specific(Device *device,
   /* set texture system */
   scene->image_manager->set_osl_texture_system((void *)ts);
 
+  /* free shader groups no longer used by any shader */
+  {
+    thread_scoped_lock lock(ss_mutex);
+    for (auto it = ss_shared_groups.begin(); it != ss_shared_groups.end();) {
+      if (it->second.use_count() == 1) {
+        it = ss_shared_groups.erase(it);
+      }
+      else {
+        ++it;
+      }
+    }
+  }
+
   /* create shaders */
   OSLGlobals *og = (OSLGlobals *)device->get_cpu_osl_memory();
   Shader *background_shader = scene->background->get_shader(scene);
@@ -303,6 +317,8 @@ void OSLShaderManager::shading_system_free()
   ss_shared_users--;
 
   if (ss_shared_users == 0) {
+    ss_shared_groups.clear();
+
     delete ss_shared;
     ss_shared = NULL;
 
@@ -314,6 +330,20 @@ void OSLShaderManager::shading_system_free()
   services = NULL;
 }
 
+OSL::ShaderGroupRef OSLShaderManager::shader_group_find_or_add(const string &key,
+                                                               OSL::ShaderGroupRef group)
+{
+  /* Caller holds #ss_mutex. */
+  map<string, OSL::ShaderGroupRef>::iterator it = ss_shared_groups.find(key);
+
+  if (it != ss_shared_groups.end()) {
+    return it->second;
+  }
+
+  ss_shared_groups[key] = group;
+  return group;
+}
+
 bool OSLShaderManager::osl_compile(const string &inputfile, const string &outputfile)
 {
   vector<string> options;
@@ -729,13 +759,13 @@ void OSLCompiler::add(ShaderNode *node, const char *name, bool isfilepath)
   /* Create shader of the appropriate type. OSL only distinguishes between "surface"
    * and "displacement" at the moment. */
   if (current_type == SHADER_TYPE_SURFACE)
-    ss->Shader("surface", name, id(node).c_str());
+    ss_shader("surface", name, id(node).c_str());
   else if (current_type == SHADER_TYPE_VOLUME)
-    ss->Shader("surface", name, id(node).c_str());
+    ss_shader("surface", name, id(node).c_str());
   else if (current_type == SHADER_TYPE_DISPLACEMENT)
-    ss->Shader("displacement", name, id(node).c_str());
+    ss_shader("displacement", name, id(node).c_str());
   else if (current_type == SHADER_TYPE_BUMP)
-    ss->Shader("displacement", name, id(node).c_str());
+    ss_shader("displacement", name, id(node).c_str());
   else
     assert(0);
 
@@ -751,7 +781,7 @@ void OSLCompiler::add(ShaderNode *node, const char *name, bool isfilepath)
       string param_from = compatible_name(input->link->parent, input->link);
       string param_to = compatible_name(node, input);
 
-      ss->ConnectShaders(id_from.c_str(), param_from.c_str(), id_to.c_str(), param_to.c_str());
+      ss_connect_shaders(id_from.c_str(), param_from.c_str(), id_to.c_str(), param_to.c_str());
     }
   }
 
@@ -788,6 +818,52 @@ void OSLCompiler::add(ShaderNode *node, const char *name, bool isfilepath)
   }
 }
 
+void OSLCompiler::ss_shader(const char *shadertype, const char *name, const char *layername)
+{
+  ss->Shader(shadertype, name, layername);
+
+  /* Layer names contain node pointers, use the layer index instead so that identical graphs
+   * of different shaders give the same key. */
+  const int layer = current_group_layers.size();
+  current_group_layers[layername] = layer;
+
+  current_group_key += string_printf("shader %s %s %d;", shadertype, name, layer);
+}
+
+void OSLCompiler::ss_parameter(const char *name, TypeDesc type, const void *value)
+{
+  ss->Parameter(name, type, value);
+
+  current_group_key += string_printf("param %s %s ", name, type.c_str());
+
+  if (type.basetype == TypeDesc::STRING) {
+    /* Both ustring and const char * are a single pointer to the characters. */
+    const char *const *strings = (const char *const *)value;
+    for (size_t i = 0; i < type.numelements(); i++) {
+      current_group_key += string(strings[i]) + '\0';
+    }
+  }
+  else {
+    current_group_key.append((const char *)value, type.size());
+  }
+
+  current_group_key += ';';
+}
+
+void OSLCompiler::ss_connect_shaders(const char *srclayer,
+                                     const char *srcparam,
+                                     const char *dstlayer,
+                                     const char *dstparam)
+{
+  ss->ConnectShaders(srclayer, srcparam, dstlayer, dstparam);
+
+  current_group_key += string_printf("connect %d.%s %d.%s;",
+                                     current_group_layers[srclayer],
+                                     srcparam,
+                                     current_group_layers[dstlayer],
+                                     dstparam);
+}
+
 static TypeDesc array_typedesc(TypeDesc typedesc, int arraylength)
 {
   return TypeDesc((TypeDesc::BASETYPE)typedesc.basetype,
@@ -804,59 +880,59 @@ void OSLCompiler::parameter(ShaderNode *node, const char *name)
   switch (socket.type) {
     case SocketType::BOOLEAN: {
       int value = node->get_bool(socket);
-      ss->Parameter(name, TypeDesc::TypeInt, &value);
+      ss_parameter(name, TypeDesc::TypeInt, &value);
       break;
     }
     case SocketType::FLOAT: {
       float value = node->get_float(socket);
-      ss->Parameter(uname, TypeDesc::TypeFloat, &value);
+      ss_parameter(name, TypeDesc::TypeFloat, &value);
       break;
     }
     case SocketType::INT: {
       int value = node->get_int(socket);
-      ss->Parameter(uname, TypeDesc::TypeInt, &value);
+      ss_parameter(name, TypeDesc::TypeInt, &value);
       break;
     }
     case SocketType::COLOR: {
       float3 value = node->get_float3(socket);
-      ss->Parameter(uname, TypeDesc::TypeColor, &value);
+      ss_parameter(name, TypeDesc::TypeColor, &value);
       break;
     }
     case SocketType::VECTOR: {
       float3 value = node->get_float3(socket);
-      ss->Parameter(uname, TypeDesc::TypeVector, &value);
+      ss_parameter(name, TypeDesc::TypeVector, &value);
       break;
     }
     case SocketType::POINT: {
       float3 value = node->get_float3(socket);
-      ss->Parameter(uname, TypeDesc::TypePoint, &value);
+      ss_parameter(name, TypeDesc::TypePoint, &value);
       break;
     }
     case SocketType::NORMAL: {
       float3 value = node->get_float3(socket);
-      ss->Parameter(uname, TypeDesc::TypeNormal, &value);
+      ss_parameter(name, TypeDesc::TypeNormal, &value);
       break;
     }
     case SocketType::POINT2: {
       float2 value = node->get_float2(socket);
-      ss->Parameter(uname, TypeDesc(TypeDesc::FLOAT, TypeDesc::VEC2, TypeDesc::POINT), &value);
+      ss_parameter(name, TypeDesc(TypeDesc::FLOAT, TypeDesc::VEC2, TypeDesc::POINT), &value);
       break;
     }
     case SocketType::STRING: {
       ustring value = node->get_string(socket);
-      ss->Parameter(uname, TypeDesc::TypeString, &value);
+      ss_parameter(name, TypeDesc::TypeString, &value);
       break;
     }
     case SocketType::ENUM: {
       ustring value = node->get_string(socket);
-      ss->Parameter(uname, TypeDesc::TypeString, &value);
+      ss_parameter(name, TypeDesc::TypeString, &value);
       break;
     }
     case SocketType::TRANSFORM: {
       Transform value = node->get_transform(socket);
       ProjectionTransform projection(value);
       projection = projection_transpose(projection);
-      ss->Parameter(uname, TypeDesc::TypeMatrix, &projection);
+      ss_parameter(name, TypeDesc::TypeMatrix, &projection);
       break;
     }
     case SocketType::BOOLEAN_ARRAY: {
@@ -865,17 +941,17 @@ void OSLCompiler::parameter(ShaderNode *node, const char *name)
       array<int> intvalue(value.size());
       for (size_t i = 0; i < value.size(); i++)
         intvalue[i] = value[i];
-      ss->Parameter(uname, array_typedesc(TypeDesc::TypeInt, value.size()), intvalue.data());
+      ss_parameter(name, array_typedesc(TypeDesc::TypeInt, value.size()), intvalue.data());
       break;
     }
     case SocketType::FLOAT_ARRAY: {
       const array<float> &value = node->get_float_array(socket);
-      ss->Parameter(uname, array_typedesc(TypeDesc::TypeFloat, value.size()), value.data());
+      ss_parameter(name, array_typedesc(TypeDesc::TypeFloat, value.size()), value.data());
       break;
     }
     case SocketType::INT_ARRAY: {
       const array<int> &value = node->get_int_array(socket);
-      ss->Parameter(uname, array_typedesc(TypeDesc::TypeInt, value.size()), value.data());
+      ss_parameter(name, array_typedesc(TypeDesc::TypeInt, value.size()), value.data());
       break;
     }
     case SocketType::COLOR_ARRAY:
@@ -911,20 +987,20 @@ void OSLCompiler::parameter(ShaderNode *node, const char *name)
         fvalue[j++] = value[i].z;
       }
 
-      ss->Parameter(uname, array_typedesc(typedesc, value.size()), fvalue.data());
+      ss_parameter(name, array_typedesc(typedesc, value.size()), fvalue.data());
       break;
     }
     case SocketType::POINT2_ARRAY: {
       const array<float2> &value = node->get_float2_array(socket);
-      ss->Parameter(
-          uname,
+      ss_parameter(
+          name,
           array_typedesc(TypeDesc(TypeDesc::FLOAT, TypeDesc::VEC2, TypeDesc::POINT), value.size()),
           value.data());
       break;
     }
     case SocketType::STRING_ARRAY: {
       const array<ustring> &value = node->get_string_array(socket);
-      ss->Parameter(uname, array_typedesc(TypeDesc::TypeString, value.size()), value.data());
+      ss_parameter(name, array_typedesc(TypeDesc::TypeString, value.size()), value.data());
       break;
     }
     case SocketType::TRANSFORM_ARRAY: {
@@ -933,7 +1009,7 @@ void OSLCompiler::parameter(ShaderNode *node, const char *name)
       for (size_t i = 0; i < value.size(); i++) {
         fvalue[i] = projection_transpose(ProjectionTransform(value[i]));
       }
-      ss->Parameter(uname, array_typedesc(TypeDesc::TypeMatrix, fvalue.size()), fvalue.data());
+      ss_parameter(name, array_typedesc(TypeDesc::TypeMatrix, fvalue.size()), fvalue.data());
       break;
     }
     case SocketType::CLOSURE:
@@ -949,57 +1025,57 @@ void OSLCompiler::parameter(ShaderNode *node, const char *name)
 
 void OSLCompiler::parameter(const char *name, float f)
 {
-  ss->Parameter(name, TypeDesc::TypeFloat, &f);
+  ss_parameter(name, TypeDesc::TypeFloat, &f);
 }
 
 void OSLCompiler::parameter_color(const char *name, float3 f)
 {
-  ss->Parameter(name, TypeDesc::TypeColor, &f);
+  ss_parameter(name, TypeDesc::TypeColor, &f);
 }
 
 void OSLCompiler::parameter_point(const char *name, float3 f)
 {
-  ss->Parameter(name, TypeDesc::TypePoint, &f);
+  ss_parameter(name, TypeDesc::TypePoint, &f);
 }
 
 void OSLCompiler::parameter_normal(const char *name, float3 f)
 {
-  ss->Parameter(name, TypeDesc::TypeNormal, &f);
+  ss_parameter(name, TypeDesc::TypeNormal, &f);
 }
 
 void OSLCompiler::parameter_vector(const char *name, float3 f)
 {
-  ss->Parameter(name, TypeDesc::TypeVector, &f);
+  ss_parameter(name, TypeDesc::TypeVector, &f);
 }
 
 void OSLCompiler::parameter(const char *name, int f)
 {
-  ss->Parameter(name, TypeDesc::TypeInt, &f);
+  ss_parameter(name, TypeDesc::TypeInt, &f);
 }
 
 void OSLCompiler::parameter(const char *name, const char *s)
 {
-  ss->Parameter(name, TypeDesc::TypeString, &s);
+  ss_parameter(name, TypeDesc::TypeString, &s);
 }
 
 void OSLCompiler::parameter(const char *name, ustring s)
 {
   const char *str = s.c_str();
-  ss->Parameter(name, TypeDesc::TypeString, &str);
+  ss_parameter(name, TypeDesc::TypeString, &str);
 }
 
 void OSLCompiler::parameter(const char *name, const Transform &tfm)
 {
   ProjectionTransform projection(tfm);
   projection = projection_transpose(projection);
-  ss->Parameter(name, TypeDesc::TypeMatrix, (float *)&projection);
+  ss_parameter(name, TypeDesc::TypeMatrix, (float *)&projection);
 }
 
 void OSLCompiler::parameter_array(const char *name, const float f[], int arraylen)
 {
   TypeDesc type = TypeDesc::TypeFloat;
   type.arraylen = arraylen;
-  ss->Parameter(name, type, f);
+  ss_parameter(name, type, f);
 }
 
 void OSLCompiler::parameter_color_array(const char *name, const array<float3> &f)
@@ -1015,7 +1091,7 @@ void OSLCompiler::parameter_color_array(const char *name, const array<float3> &f
 
   TypeDesc type = TypeDesc::TypeColor;
   type.arraylen = table.size();
-  ss->Parameter(name, type, table.data());
+  ss_parameter(name, type, table.data());
 }
 
 void OSLCompiler::parameter_attribute(const char *name, ustring s)
@@ -1093,6 +1169,8 @@ void OSLCompiler::generate_nodes(const ShaderNodeSet &nodes)
 OSL::ShaderGroupRef OSLCompiler::compile_type(Shader *shader, ShaderGraph *graph, ShaderType type)
 {
   current_type = type;
+  current_group_key = string_printf("type %d;", (int)type);
+  current_group_layers.clear();
 
   OSL::ShaderGroupRef group = ss->ShaderGroupBegin(shader->name.c_str());
 
@@ -1128,7 +1206,9 @@ OSL::ShaderGroupRef OSLCompiler::compile_type(Shader *shader, ShaderGraph *graph
 
   ss->ShaderGroupEnd();
 
-  return group;
+  /* Share the group with identical shaders, in this and other sessions using the shared
+   * shading system. The existing group is already optimized, and the new one will not be. */
+  return manager->shader_group_find_or_add(current_group_key, group);
 }
 
 void OSLCompiler::compile(OSLGlobals *og, Shader *shader)
@@ -82,6 +82,9 @@ class OSLShaderManager : public ShaderManager {
   const char *shader_load_filepath(string filepath);
   OSLShaderInfo *shader_loaded_info(const string &hash);
 
+  /* shader group sharing, returns an existing group with the same serialization if any */
+  OSL::ShaderGroupRef shader_group_find_or_add(const string &key, OSL::ShaderGroupRef group);
+
   /* create OSL node using OSLQuery */
   static OSLNode *osl_node(ShaderGraph *graph,
                            ShaderManager *manager,
@@ -111,6 +114,10 @@ class OSLShaderManager : public ShaderManager {
   static thread_mutex ss_shared_mutex;
   static thread_mutex ss_mutex;
   static int ss_shared_users;
+
+  /* Shader groups in the shared shading system by their serialization, so that identical
+   * groups are only optimized and JIT compiled once. Protected by #ss_mutex. */
+  static map<string, OSL::ShaderGroupRef> ss_shared_groups;
 };
 
 #endif
@@ -169,9 +176,19 @@ class OSLCompiler {
   void find_dependencies(ShaderNodeSet &dependencies, ShaderInput *input);
   void generate_nodes(const ShaderNodeSet &nodes);
 
+  /* Wrappers around the shading system that also record the group serialization. */
+  void ss_shader(const char *shadertype, const char *name, const char *layername);
+  void ss_parameter(const char *name, TypeDesc type, const void *value);
+  void ss_connect_shaders(const char *srclayer,
+                          const char *srcparam,
+                          const char *dstlayer,
+                          const char *dstparam);
+
   OSLShaderManager *manager;
   OSLRenderServices *services;
   OSL::ShadingSystem *ss;
+  string current_group_key;
+  map<string, int> current_group_layers;
 #endif
 
   ShaderType current_type;
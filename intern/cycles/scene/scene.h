@@ -71,7 +71,7 @@ class DeviceScene {
   /* mesh */
   device_vector<packed_float3> tri_verts;
   device_vector<uint> tri_shader;
-  device_vector<packed_float3> tri_vnormal;
+  device_vector<uint> tri_vnormal;
   device_vector<uint4> tri_vindex;
   device_vector<uint> tri_patch;
   device_vector<float2> tri_patch_uv;
@@ -108,9 +108,15 @@ class DeviceScene {
   /* lights */
   device_vector<KernelLightDistribution> light_distribution;
   device_vector<KernelLight> lights;
+  device_vector<KernelLightTreeNode> light_tree_nodes;
+  device_vector<int> light_tree_emitter_leaf;
   device_vector<float2> light_background_marginal_cdf;
   device_vector<float2> light_background_conditional_cdf;
 
+  /* path guiding */
+  device_vector<float> guiding_train;
+  device_vector<float> guiding_distribution;
+
   /* particles */
   device_vector<KernelParticle> particles;
 
@@ -153,6 +159,8 @@ class SceneParams {
   int hair_subdivisions;
   CurveShapeType hair_shape;
   int texture_limit;
+  /* Device memory budget for image textures in bytes, zero for unlimited. */
+  size_t texture_memory_limit;
 
   bool background;
 
@@ -168,6 +176,7 @@ class SceneParams {
     hair_subdivisions = 3;
     hair_shape = CURVE_RIBBON;
     texture_limit = 0;
+    texture_memory_limit = 0;
     background = true;
   }
 
@@ -180,7 +189,8 @@ class SceneParams {
              use_bvh_unaligned_nodes == params.use_bvh_unaligned_nodes &&
              num_bvh_time_steps == params.num_bvh_time_steps &&
              hair_subdivisions == params.hair_subdivisions && hair_shape == params.hair_shape &&
-             texture_limit == params.texture_limit);
+             texture_limit == params.texture_limit &&
+             texture_memory_limit == params.texture_memory_limit);
   }
 
   int curve_subdivisions()
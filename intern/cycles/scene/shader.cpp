@@ -295,6 +295,20 @@ void Shader::set_graph(ShaderGraph *graph_)
   has_volume_connected = (graph->output()->input("Volume")->link != NULL);
 }
 
+bool Shader::update_graph(ShaderGraph *graph_)
+{
+  graph_->remove_proxy_nodes();
+  graph_->compute_content_hash();
+
+  if (graph && !is_modified() && graph->content_hash == graph_->content_hash) {
+    delete graph_;
+    return false;
+  }
+
+  set_graph(graph_);
+  return true;
+}
+
 void Shader::tag_update(Scene *scene)
 {
   /* update tag */
@@ -756,10 +770,10 @@ string ShaderManager::get_cryptomatte_materials(Scene *scene)
   return manifest;
 }
 
-void ShaderManager::tag_update(Scene * /*scene*/, uint32_t /*flag*/)
+void ShaderManager::tag_update(Scene * /*scene*/, uint32_t flag)
 {
-  /* update everything for now */
-  update_flags = ShaderManager::UPDATE_ALL;
+  /* Accumulate flags, the SVM manager uses them to decide which cached shaders to rebuild. */
+  update_flags |= flag;
 }
 
 bool ShaderManager::need_update() const
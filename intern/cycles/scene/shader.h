@@ -138,6 +138,9 @@ class Shader : public Node {
   bool is_constant_emission(float3 *emission);
 
   void set_graph(ShaderGraph *graph);
+  /* Assign the graph only if it differs from the current one or the shader settings changed.
+   * Takes ownership of the graph, and returns false if it was identical and deleted. */
+  bool update_graph(ShaderGraph *graph);
   void tag_update(Scene *scene);
   void tag_used(Scene *scene);
 
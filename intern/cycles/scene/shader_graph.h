@@ -301,6 +301,7 @@ class ShaderGraph : public NodeOwner {
   bool finalized;
   bool simplified;
   string displacement_hash;
+  string content_hash;
 
   ShaderGraph();
   ~ShaderGraph();
@@ -317,6 +318,7 @@ class ShaderGraph : public NodeOwner {
 
   void remove_proxy_nodes();
   void compute_displacement_hash();
+  void compute_content_hash();
   void simplify(Scene *scene);
   void finalize(Scene *scene,
                 bool do_bump = false,
@@ -38,6 +38,12 @@ bool namedSampleCountPairComparator(const NamedSampleCountPair &a, const NamedSa
   return a.samples > b.samples;
 }
 
+bool namedKernelTimeEntryComparator(const NamedKernelTimeEntry &a, const NamedKernelTimeEntry &b)
+{
+  /* We sort in descending order. */
+  return a.time > b.time;
+}
+
 }  // namespace
 
 NamedSizeEntry::NamedSizeEntry() : name(""), size(0)
@@ -211,6 +217,49 @@ string NamedSampleCountStats::full_report(int indent_level)
   return result;
 }
 
+/* Named kernel time statistics. */
+
+NamedKernelTimeEntry::NamedKernelTimeEntry(const string &name,
+                                           const DeviceKernelStatistics &statistics)
+    : name(name),
+      time(statistics.time),
+      num_launches(statistics.num_launches),
+      num_work_items(statistics.num_work_items)
+{
+}
+
+NamedKernelTimeStats::NamedKernelTimeStats() : total_time(0.0)
+{
+}
+
+void NamedKernelTimeStats::add_entry(const NamedKernelTimeEntry &entry)
+{
+  total_time += entry.time;
+  entries.push_back(entry);
+}
+
+string NamedKernelTimeStats::full_report(int indent_level)
+{
+  const string indent(indent_level * kIndentNumSpaces, ' ');
+  string result = "";
+  sort(entries.begin(), entries.end(), namedKernelTimeEntryComparator);
+  foreach (const NamedKernelTimeEntry &entry, entries) {
+    const double percent = (total_time > 0.0) ? 100.0 * entry.time / total_time : 0.0;
+    const double time_per_item = (entry.num_work_items) ?
+                                     entry.time * 1e9 / entry.num_work_items :
+                                     0.0;
+    result += indent +
+              string_printf("%-48s: %.2fs (%3.2f%%), %s launches, %s items, %.2fns per item\n",
+                            entry.name.c_str(),
+                            entry.time,
+                            percent,
+                            string_human_readable_number(entry.num_launches).c_str(),
+                            string_human_readable_number(entry.num_work_items).c_str(),
+                            time_per_item);
+  }
+  return result;
+}
+
 /* Mesh statistics. */
 
 MeshStats::MeshStats()
@@ -244,6 +293,7 @@ string ImageStats::full_report(int indent_level)
 RenderStats::RenderStats()
 {
   has_profiling = false;
+  has_kernel_profiling = false;
 }
 
 void RenderStats::collect_profiling(Scene *scene, Profiler &prof)
@@ -297,6 +347,32 @@ void RenderStats::collect_profiling(Scene *scene, Profiler &prof)
   }
 }
 
+void RenderStats::collect_kernel_profiling(Scene *scene,
+                                           const DeviceKernelProfiling &kernel_profiling)
+{
+  has_kernel_profiling = true;
+
+  gpu_kernels = NamedKernelTimeStats();
+  for (int i = 0; i < DEVICE_KERNEL_NUM; i++) {
+    const DeviceKernelStatistics &statistics = kernel_profiling.kernels[i];
+    if (statistics.num_launches) {
+      gpu_kernels.add_entry(
+          NamedKernelTimeEntry(device_kernel_as_string((DeviceKernel)i), statistics));
+    }
+  }
+
+  gpu_shaders = NamedKernelTimeStats();
+  foreach (Shader *shader, scene->shaders) {
+    if (shader->id >= kernel_profiling.shaders.size()) {
+      continue;
+    }
+    const DeviceKernelStatistics &statistics = kernel_profiling.shaders[shader->id];
+    if (statistics.num_launches) {
+      gpu_shaders.add_entry(NamedKernelTimeEntry(shader->name.string(), statistics));
+    }
+  }
+}
+
 string RenderStats::full_report()
 {
   string result = "";
@@ -307,8 +383,12 @@ string RenderStats::full_report()
     result += "Shader statistics:\n" + shaders.full_report(1);
     result += "Object statistics:\n" + objects.full_report(1);
   }
+  else if (has_kernel_profiling) {
+    result += "Kernel statistics:\n" + gpu_kernels.full_report(1);
+    result += "Shader statistics:\n" + gpu_shaders.full_report(1);
+  }
   else {
-    result += "Profiling information not available (only works with CPU rendering)";
+    result += "Profiling information not available";
   }
   return result;
 }
@@ -6,6 +6,8 @@
 
 #include "scene/scene.h"
 
+#include "device/kernel.h"
+
 #include "util/stats.h"
 #include "util/string.h"
 #include "util/vector.h"
@@ -134,6 +136,34 @@ class NamedSampleCountStats {
   entry_map entries;
 };
 
+/* Named entry with measured execution time, number of launches and number of processed work
+ * items. Used for kernel profiling on the GPU. */
+class NamedKernelTimeEntry {
+ public:
+  NamedKernelTimeEntry(const string &name, const DeviceKernelStatistics &statistics);
+
+  string name;
+  double time;
+  uint64_t num_launches;
+  uint64_t num_work_items;
+};
+
+class NamedKernelTimeStats {
+ public:
+  NamedKernelTimeStats();
+
+  /* Add entry to the statistics. */
+  void add_entry(const NamedKernelTimeEntry &entry);
+
+  /* Generate full human-readable report. */
+  string full_report(int indent_level = 0);
+
+  /* Total time of all entries. */
+  double total_time;
+
+  vector<NamedKernelTimeEntry> entries;
+};
+
 /* Statistics about mesh in the render database. */
 class MeshStats {
  public:
@@ -171,13 +201,20 @@ class RenderStats {
   /* Collect kernel sampling information from Stats. */
   void collect_profiling(Scene *scene, Profiler &prof);
 
+  /* Collect measured kernel execution times of GPU rendering. */
+  void collect_kernel_profiling(Scene *scene, const DeviceKernelProfiling &kernel_profiling);
+
   bool has_profiling;
+  bool has_kernel_profiling;
 
   MeshStats mesh;
   ImageStats image;
   NamedNestedSampleStats kernel;
   NamedSampleCountStats shaders;
   NamedSampleCountStats objects;
+
+  NamedKernelTimeStats gpu_kernels;
+  NamedKernelTimeStats gpu_shaders;
 };
 
 class UpdateTimeStats {
@@ -15,6 +15,7 @@
 
 #include "util/foreach.h"
 #include "util/log.h"
+#include "util/murmurhash.h"
 #include "util/progress.h"
 #include "util/task.h"
 
@@ -32,24 +33,29 @@ SVMShaderManager::~SVMShaderManager()
 
 void SVMShaderManager::reset(Scene * /*scene*/)
 {
+  compiled_shaders.clear();
 }
 
 void SVMShaderManager::device_update_shader(Scene *scene,
                                             Shader *shader,
                                             Progress *progress,
-                                            array<int4> *svm_nodes)
+                                            CompiledShader *compiled)
 {
   if (progress->get_cancel()) {
     return;
   }
   assert(shader->graph);
 
-  svm_nodes->push_back_slow(make_int4(NODE_SHADER_JUMP, 0, 0, 0));
+  array<int4> svm_nodes;
+  svm_nodes.push_back_slow(make_int4(NODE_SHADER_JUMP, 0, 0, 0));
 
   SVMCompiler::Summary summary;
   SVMCompiler compiler(scene);
   compiler.background = (shader == scene->background->get_shader(scene));
-  compiler.compile(shader, *svm_nodes, 0, &summary);
+  compiler.compile(shader, svm_nodes, 0, &summary);
+
+  compiled->svm_nodes.steal_data(svm_nodes);
+  compiled->background = compiler.background;
 
   VLOG(3) << "Compilation summary:\n"
           << "Shader name: " << shader->name << "\n"
@@ -79,36 +85,79 @@ void SVMShaderManager::device_update_specific(Device *device,
   /* test if we need to update */
   device_free(device, dscene, scene);
 
-  /* Build all shaders. */
+  /* Build modified shaders, and shaders that were not compiled before. Compiled nodes of other
+   * shaders are reused, as compiling them again would give the same result. Shaders that were
+   * removed from the scene are dropped from the cache. Shaders whose nodes depend on integrator
+   * settings, like the glossy filter, are rebuilt when those settings change. */
+  Shader *background_shader = scene->background->get_shader(scene);
+  const bool integrator_modified = (update_flags & INTEGRATOR_MODIFIED) != 0;
+  unordered_map<Shader *, CompiledShader> prev_compiled_shaders;
+  prev_compiled_shaders.swap(compiled_shaders);
+
   TaskPool task_pool;
-  vector<array<int4>> shader_svm_nodes(num_shaders);
+  vector<CompiledShader *> shader_compiled(num_shaders);
+  int num_compiled = 0;
   for (int i = 0; i < num_shaders; i++) {
-    task_pool.push(function_bind(&SVMShaderManager::device_update_shader,
-                                 this,
-                                 scene,
-                                 scene->shaders[i],
-                                 &progress,
-                                 &shader_svm_nodes[i]));
+    Shader *shader = scene->shaders[i];
+    CompiledShader &compiled = compiled_shaders[shader];
+    shader_compiled[i] = &compiled;
+
+    auto it = prev_compiled_shaders.find(shader);
+    if (it != prev_compiled_shaders.end() && !shader->is_modified() &&
+        !(integrator_modified && shader->has_integrator_dependency) &&
+        !it->second.svm_nodes.empty() &&
+        it->second.background == (shader == background_shader)) {
+      compiled.svm_nodes.steal_data(it->second.svm_nodes);
+      compiled.background = it->second.background;
+      continue;
+    }
+
+    task_pool.push(function_bind(
+        &SVMShaderManager::device_update_shader, this, scene, shader, &progress, &compiled));
+    num_compiled++;
   }
   task_pool.wait_work();
+  prev_compiled_shaders.clear();
 
   if (progress.get_cancel()) {
     return;
   }
 
   /* The global node list contains a jump table (one node per shader)
-   * followed by the nodes of all shaders. */
+   * followed by the nodes of all shaders. Shaders that compiled to identical nodes, for
+   * example duplicated materials, share the same nodes. */
+  vector<int> shader_offset(num_shaders);
+  vector<bool> shader_owns_nodes(num_shaders, false);
+  unordered_multimap<uint32_t, int> unique_shaders;
   int svm_nodes_size = num_shaders;
   for (int i = 0; i < num_shaders; i++) {
-    /* Since we're not copying the local jump node, the size ends up being one node lower. */
-    svm_nodes_size += shader_svm_nodes[i].size() - 1;
+    const array<int4> &nodes = shader_compiled[i]->svm_nodes;
+    const uint32_t hash = util_murmur_hash3(nodes.data(), sizeof(int4) * nodes.size(), 0);
+
+    shader_offset[i] = -1;
+    auto range = unique_shaders.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (shader_compiled[it->second]->svm_nodes == nodes) {
+        shader_offset[i] = shader_offset[it->second];
+        break;
+      }
+    }
+
+    if (shader_offset[i] == -1) {
+      unique_shaders.emplace(hash, i);
+      shader_owns_nodes[i] = true;
+      shader_offset[i] = svm_nodes_size;
+      /* Since we're not copying the local jump node, the size ends up being one node lower. */
+      svm_nodes_size += nodes.size() - 1;
+    }
   }
 
   int4 *svm_nodes = dscene->svm_nodes.alloc(svm_nodes_size);
 
-  int node_offset = num_shaders;
   for (int i = 0; i < num_shaders; i++) {
     Shader *shader = scene->shaders[i];
+    const array<int4> &nodes = shader_compiled[i]->svm_nodes;
+    const int node_offset = shader_offset[i];
 
     shader->clear_modified();
     if (shader->get_use_mis() && shader->has_surface_emission) {
@@ -119,23 +168,17 @@ void SVMShaderManager::device_update_specific(Device *device,
      * Each compiled shader starts with a jump node that has offsets local
      * to the shader, so copy those and add the offset into the global node list. */
     int4 &global_jump_node = svm_nodes[shader->id];
-    int4 &local_jump_node = shader_svm_nodes[i][0];
+    const int4 &local_jump_node = nodes[0];
 
     global_jump_node.x = NODE_SHADER_JUMP;
     global_jump_node.y = local_jump_node.y - 1 + node_offset;
     global_jump_node.z = local_jump_node.z - 1 + node_offset;
     global_jump_node.w = local_jump_node.w - 1 + node_offset;
 
-    node_offset += shader_svm_nodes[i].size() - 1;
-  }
-
-  /* Copy the nodes of each shader into the correct location. */
-  svm_nodes += num_shaders;
-  for (int i = 0; i < num_shaders; i++) {
-    int shader_size = shader_svm_nodes[i].size() - 1;
-
-    memcpy(svm_nodes, &shader_svm_nodes[i][1], sizeof(int4) * shader_size);
-    svm_nodes += shader_size;
+    /* Copy the nodes of the shader into the correct location. */
+    if (shader_owns_nodes[i]) {
+      memcpy(svm_nodes + node_offset, &nodes[1], sizeof(int4) * (nodes.size() - 1));
+    }
   }
 
   if (progress.get_cancel()) {
@@ -148,7 +191,8 @@ void SVMShaderManager::device_update_specific(Device *device,
 
   update_flags = UPDATE_NONE;
 
-  VLOG(1) << "Shader manager updated " << num_shaders << " shaders in " << time_dt() - start_time
+  VLOG(1) << "Shader manager updated " << num_shaders << " shaders (" << num_compiled
+          << " compiled, " << unique_shaders.size() << " unique) in " << time_dt() - start_time
           << " seconds.";
 }
 
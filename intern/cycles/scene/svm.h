@@ -9,6 +9,7 @@
 #include "scene/shader_graph.h"
 
 #include "util/array.h"
+#include "util/map.h"
 #include "util/set.h"
 #include "util/string.h"
 #include "util/thread.h"
@@ -40,10 +41,19 @@ class SVMShaderManager : public ShaderManager {
   void device_free(Device *device, DeviceScene *dscene, Scene *scene) override;
 
  protected:
+  /* Nodes of a compiled shader, starting with a jump node that has offsets local to the shader.
+   * Kept between updates so that only modified shaders need to be compiled again. */
+  struct CompiledShader {
+    array<int4> svm_nodes;
+    bool background = false;
+  };
+
   void device_update_shader(Scene *scene,
                             Shader *shader,
                             Progress *progress,
-                            array<int4> *svm_nodes);
+                            CompiledShader *compiled);
+
+  unordered_map<Shader *, CompiledShader> compiled_shaders;
 };
 
 /* Graph Compiler */
@@ -247,8 +247,13 @@ void Session::thread_run()
 
 void Session::thread_render()
 {
-  if (params.use_profiling && (params.device.type == DEVICE_CPU)) {
-    profiler.start();
+  if (params.use_profiling) {
+    if (params.device.type == DEVICE_CPU) {
+      profiler.start();
+    }
+    else {
+      path_trace_->set_use_kernel_profiling(true);
+    }
   }
 
   /* session thread loop */
@@ -305,6 +310,7 @@ RenderWork Session::run_update_for_next_iteration()
   if (did_reset || scene->integrator->get_aa_samples() < params.samples) {
     scene->integrator->set_aa_samples(params.samples);
   }
+  scene->integrator->set_start_sample(params.sample_offset);
 
   /* Update denoiser settings. */
   {
@@ -686,8 +692,13 @@ void Session::device_free()
 void Session::collect_statistics(RenderStats *render_stats)
 {
   scene->collect_statistics(render_stats);
-  if (params.use_profiling && (params.device.type == DEVICE_CPU)) {
-    render_stats->collect_profiling(scene, profiler);
+  if (params.use_profiling) {
+    if (params.device.type == DEVICE_CPU) {
+      render_stats->collect_profiling(scene, profiler);
+    }
+    else {
+      render_stats->collect_kernel_profiling(scene, path_trace_->get_kernel_profiling());
+    }
   }
 }
 
@@ -627,6 +627,24 @@ bool TileManager::read_full_buffer_from_disk(const string_view filename,
                                              RenderBuffers *buffers,
                                              DenoiseParams *denoise_params)
 {
+  BufferParams buffer_params;
+  if (!open_full_buffer_from_disk(filename, &buffer_params, denoise_params)) {
+    return false;
+  }
+
+  const bool success = read_full_buffer_rows_from_disk(0, buffer_params.height, buffers);
+
+  close_full_buffer_from_disk();
+
+  return success;
+}
+
+bool TileManager::open_full_buffer_from_disk(const string_view filename,
+                                             BufferParams *buffer_params,
+                                             DenoiseParams *denoise_params)
+{
+  close_full_buffer_from_disk();
+
   unique_ptr<ImageInput> in(ImageInput::open(filename));
   if (!in) {
     LOG(ERROR) << "Error opening tile file " << filename;
@@ -635,27 +653,93 @@ bool TileManager::read_full_buffer_from_disk(const string_view filename,
 
   const ImageSpec &image_spec = in->spec();
 
-  BufferParams buffer_params;
-  if (!buffer_params_from_image_spec_atttributes(&buffer_params, image_spec)) {
+  if (!buffer_params_from_image_spec_atttributes(buffer_params, image_spec)) {
     return false;
   }
-  buffers->reset(buffer_params);
 
   if (!node_from_image_spec_atttributes(denoise_params, image_spec, ATTR_DENOISE_SOCKET_PREFIX)) {
     return false;
   }
 
-  if (!in->read_image(TypeDesc::FLOAT, buffers->buffer.data())) {
-    LOG(ERROR) << "Error reading pixels from the tile file " << in->geterror();
-    return false;
+  /* Rows are read from the file as-is, which requires the buffer to have no overscan. */
+  DCHECK_EQ(buffer_params->window_x, 0);
+  DCHECK_EQ(buffer_params->window_y, 0);
+  DCHECK_EQ(buffer_params->window_width, buffer_params->width);
+  DCHECK_EQ(buffer_params->window_height, buffer_params->height);
+
+  read_state_.tile_in = std::move(in);
+  read_state_.buffer_params = *buffer_params;
+
+  return true;
+}
+
+bool TileManager::read_full_buffer_rows_from_disk(const int y,
+                                                  const int height,
+                                                  RenderBuffers *buffers)
+{
+  DCHECK(read_state_.tile_in);
+
+  ImageInput *in = read_state_.tile_in.get();
+  const ImageSpec &image_spec = in->spec();
+
+  /* Parameters of a band of rows of the full frame. */
+  BufferParams buffer_params = read_state_.buffer_params;
+  buffer_params.full_y += y;
+  buffer_params.height = height;
+  buffer_params.window_height = height;
+  buffer_params.update_offset_stride();
+
+  buffers->reset(buffer_params);
+
+  bool success;
+  if (image_spec.tile_width) {
+    success = in->read_tiles(0,
+                             0,
+                             0,
+                             buffer_params.width,
+                             y,
+                             y + height,
+                             0,
+                             1,
+                             0,
+                             image_spec.nchannels,
+                             TypeDesc::FLOAT,
+                             buffers->buffer.data());
+  }
+  else {
+    success = in->read_scanlines(
+        0, 0, y, y + height, 0, 0, image_spec.nchannels, TypeDesc::FLOAT, buffers->buffer.data());
   }
 
-  if (!in->close()) {
-    LOG(ERROR) << "Error closing tile file " << in->geterror();
+  if (!success) {
+    LOG(ERROR) << "Error reading pixels from the tile file " << in->geterror();
     return false;
   }
 
   return true;
 }
 
+void TileManager::close_full_buffer_from_disk()
+{
+  if (!read_state_.tile_in) {
+    return;
+  }
+
+  if (!read_state_.tile_in->close()) {
+    LOG(ERROR) << "Error closing tile file " << read_state_.tile_in->geterror();
+  }
+
+  read_state_.tile_in = nullptr;
+}
+
+int TileManager::get_full_buffer_read_rows() const
+{
+  const int image_tile_height = read_state_.tile_in ?
+                                    max(read_state_.tile_in->spec().tile_height, 1) :
+                                    IMAGE_TILE_SIZE;
+
+  /* Read as many rows as a render tile has, which fits into memory since it was rendered. */
+  return align_up(max(tile_size_.y, image_tile_height), image_tile_height);
+}
+
 CCL_NAMESPACE_END
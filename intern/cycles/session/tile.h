@@ -105,6 +105,28 @@ class TileManager {
                                   RenderBuffers *buffers,
                                   DenoiseParams *denoise_params);
 
+  /* Open tiles file on disk for reading the full frame render buffer in bands of rows, without
+   * keeping the whole frame in memory.
+   * The buffer parameters of the full frame are stored in the given `buffer_params`.
+   *
+   * Returns true on success. */
+  bool open_full_buffer_from_disk(string_view filename,
+                                  BufferParams *buffer_params,
+                                  DenoiseParams *denoise_params);
+
+  /* Read rows [y, y + height) of the opened full frame file. The buffers are reset to cover only
+   * these rows. The `y` is expected to be a multiple of #get_full_buffer_read_rows().
+   *
+   * Returns true on success. */
+  bool read_full_buffer_rows_from_disk(int y, int height, RenderBuffers *buffers);
+
+  /* Close the file opened by #open_full_buffer_from_disk(). */
+  void close_full_buffer_from_disk();
+
+  /* Number of rows which is read at once when streaming the full frame file, aligned to the
+   * tile size of the image file. */
+  int get_full_buffer_read_rows() const;
+
   /* Compute valid tile size compatible with image saving. */
   int compute_render_tile_size(const int suggested_tile_size) const;
 
@@ -174,6 +196,15 @@ class TileManager {
 
     int num_tiles_written = 0;
   } write_state_;
+
+  /* State of the full frame buffer reading from a file on disk. */
+  struct {
+    /* Input handle of the file, valid between open and close of the full buffer. */
+    unique_ptr<ImageInput> tile_in;
+
+    /* Buffer parameters of the full frame stored in the file. */
+    BufferParams buffer_params;
+  } read_state_;
 };
 
 CCL_NAMESPACE_END
@@ -0,0 +1,62 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright 2011-2022 Blender Foundation */
+
+#include "testing/testing.h"
+
+#include "integrator/work_balancer.h"
+
+CCL_NAMESPACE_BEGIN
+
+TEST(IntegratorWorkBalancer, initial)
+{
+  vector<WorkBalanceInfo> infos(4);
+  work_balance_do_initial(infos);
+
+  for (const WorkBalanceInfo &info : infos) {
+    EXPECT_NEAR(info.weight, 0.25, 1e-6);
+  }
+}
+
+TEST(IntegratorWorkBalancer, rebalance_heterogeneous)
+{
+  /* Second device is three times faster than the first one. */
+  vector<WorkBalanceInfo> infos(2);
+  work_balance_do_initial(infos);
+  infos[0].time_spent = 3.0;
+  infos[1].time_spent = 1.0;
+
+  EXPECT_TRUE(work_balance_do_rebalance(infos));
+  EXPECT_NEAR(infos[0].weight, 0.25, 1e-6);
+  EXPECT_NEAR(infos[1].weight, 0.75, 1e-6);
+  EXPECT_EQ(infos[0].time_spent, 0.0);
+  EXPECT_EQ(infos[1].time_spent, 0.0);
+
+  /* Equal times with the new weights keep the balance. */
+  infos[0].time_spent = 1.0;
+  infos[1].time_spent = 1.0;
+  EXPECT_FALSE(work_balance_do_rebalance(infos));
+  EXPECT_NEAR(infos[0].weight, 0.25, 1e-6);
+  EXPECT_NEAR(infos[1].weight, 0.75, 1e-6);
+}
+
+TEST(IntegratorWorkBalancer, rebalance_small_difference)
+{
+  vector<WorkBalanceInfo> infos(2);
+  work_balance_do_initial(infos);
+
+  /* Difference below the threshold does not change the balance. */
+  infos[0].time_spent = 1.01;
+  infos[1].time_spent = 1.0;
+  EXPECT_FALSE(work_balance_do_rebalance(infos));
+  EXPECT_NEAR(infos[0].weight, 0.5, 1e-6);
+
+  /* Small differences only move halfway towards the target. */
+  infos[0].time_spent = 1.1;
+  infos[1].time_spent = 1.0;
+  EXPECT_TRUE(work_balance_do_rebalance(infos));
+  EXPECT_LT(infos[0].weight, 0.5);
+  EXPECT_GT(infos[0].weight, 0.5 / 2.1);
+  EXPECT_NEAR(infos[0].weight + infos[1].weight, 1.0, 1e-6);
+}
+
+CCL_NAMESPACE_END
@@ -45,4 +45,26 @@ TEST(math, reverse_integer_bits)
   EXPECT_EQ(reverse_integer_bits(0xAAAAAAAA), 0x55555555);
 }
 
+TEST(math, octahedral_encode)
+{
+  EXPECT_EQ(octahedral_encode(zero_float3()), 0);
+  EXPECT_EQ(octahedral_decode(0), zero_float3());
+
+  const float3 directions[] = {make_float3(0.0f, 0.0f, 1.0f),
+                               make_float3(0.0f, 0.0f, -1.0f),
+                               make_float3(1.0f, 0.0f, 0.0f),
+                               make_float3(0.0f, -1.0f, 0.0f),
+                               normalize(make_float3(1.0f, 2.0f, 3.0f)),
+                               normalize(make_float3(-3.0f, 1.0f, -2.0f)),
+                               normalize(make_float3(-1e-4f, -1e-4f, -1.0f))};
+
+  for (const float3 &N : directions) {
+    const uint code = octahedral_encode(N);
+    EXPECT_NE(code, 0);
+
+    const float3 decoded = octahedral_decode(code);
+    EXPECT_NEAR(dot(N, decoded), 1.0f, 1e-6f);
+  }
+}
+
 CCL_NAMESPACE_END
@@ -556,6 +556,50 @@ ccl_device_inline float3 ensure_finite3(float3 v)
   return v;
 }
 
+/* Octahedral encoding of unit vectors into 16 bits per component. The zero code is reserved for
+ * zero vectors, it would otherwise map to the -Z direction which has other codes as well. */
+ccl_device_inline uint octahedral_encode(const float3 N)
+{
+  const float len = fabsf(N.x) + fabsf(N.y) + fabsf(N.z);
+  if (!(len > 0.0f)) {
+    return 0;
+  }
+
+  float u = N.x / len;
+  float v = N.y / len;
+  if (N.z < 0.0f) {
+    const float fold_u = (1.0f - fabsf(v)) * signf(u);
+    const float fold_v = (1.0f - fabsf(u)) * signf(v);
+    u = fold_u;
+    v = fold_v;
+  }
+
+  const uint qu = (uint)(saturatef(u * 0.5f + 0.5f) * 65535.0f + 0.5f);
+  const uint qv = (uint)(saturatef(v * 0.5f + 0.5f) * 65535.0f + 0.5f);
+  const uint code = qu | (qv << 16);
+
+  return (code == 0) ? 0xFFFFFFFF : code;
+}
+
+ccl_device_inline float3 octahedral_decode(const uint code)
+{
+  if (code == 0) {
+    return zero_float3();
+  }
+
+  float u = (code & 0xFFFF) * (2.0f / 65535.0f) - 1.0f;
+  float v = (code >> 16) * (2.0f / 65535.0f) - 1.0f;
+  const float z = 1.0f - fabsf(u) - fabsf(v);
+  if (z < 0.0f) {
+    const float unfold_u = (1.0f - fabsf(v)) * signf(u);
+    const float unfold_v = (1.0f - fabsf(u)) * signf(v);
+    u = unfold_u;
+    v = unfold_v;
+  }
+
+  return normalize(make_float3(u, v, z));
+}
+
 CCL_NAMESPACE_END
 
 #endif /* __UTIL_MATH_FLOAT3_H__ */
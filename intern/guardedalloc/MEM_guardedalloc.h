@@ -172,6 +172,34 @@ extern void (*MEM_reset_peak_memory)(void);
 /** Get the peak memory usage in bytes, including mmap allocations. */
 extern size_t (*MEM_get_peak_memory)(void) ATTR_WARN_UNUSED_RESULT;
 
+/**
+ * Subsystems that allocated memory can be attributed to, see #MEM_category_set.
+ * The lock-free allocator has room for 16 categories in its block header.
+ */
+typedef enum eMEMCategory {
+  MEM_CATEGORY_OTHER = 0,
+  MEM_CATEGORY_MESH,
+  MEM_CATEGORY_IMAGE,
+  MEM_CATEGORY_UNDO,
+  MEM_CATEGORY_GPU_STAGING,
+  MEM_CATEGORY_GEOMETRY_NODES,
+
+  MEM_CATEGORY_NUM,
+} eMEMCategory;
+
+/**
+ * Attribute the following allocations of the calling thread to the given category. Memory keeps
+ * its category when it is freed by another thread.
+ *
+ * \return The previous category of the thread, which should be restored afterwards.
+ *
+ * \note Only the lock-free allocator keeps track of categories.
+ */
+eMEMCategory MEM_category_set(eMEMCategory category);
+/** Memory in use by allocations of the category, in bytes. */
+size_t MEM_get_category_memory_in_use(eMEMCategory category) ATTR_WARN_UNUSED_RESULT;
+const char *MEM_category_name(eMEMCategory category) ATTR_WARN_UNUSED_RESULT;
+
 #ifdef __GNUC__
 #  define MEM_SAFE_FREE(v) \
     do { \
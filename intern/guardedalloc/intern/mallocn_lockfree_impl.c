@@ -6,7 +6,9 @@
  * Memory allocation which keeps track on allocated memory counters
  */
 
+#include <assert.h>
 #include <stdarg.h>
+#include <stdint.h>
 #include <stdio.h> /* printf */
 #include <stdlib.h>
 #include <string.h> /* memcpy */
@@ -14,24 +16,36 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "../../source/blender/blenlib/BLI_assert.h"
+
 /* to ensure strict conversions */
 #include "../../source/blender/blenlib/BLI_strict_flags.h"
 
-#include "atomic_ops.h"
 #include "mallocn_intern.h"
 
+/* The category of a block is stored in the highest bits of its length, lengths never get close to
+ * using them on 64-bit platforms. On 32-bit platforms that would limit blocks to 256 MB, so the
+ * category gets its own member there, right before the length in both headers. */
+#if SIZE_MAX > UINT32_MAX
+#  define MEMHEAD_PACK_CATEGORY
+#endif
+
 typedef struct MemHead {
+#ifndef MEMHEAD_PACK_CATEGORY
+  size_t category;
+#endif
   /* Length of allocated memory block. */
   size_t len;
 } MemHead;
 
 typedef struct MemHeadAligned {
   short alignment;
+#ifndef MEMHEAD_PACK_CATEGORY
+  size_t category;
+#endif
   size_t len;
 } MemHeadAligned;
 
-static unsigned int totblock = 0;
-static size_t mem_in_use = 0, peak_mem = 0;
 static bool malloc_debug_memset = false;
 
 static void (*error_callback)(const char *) = NULL;
@@ -40,23 +54,28 @@ enum {
   MEMHEAD_ALIGN_FLAG = 1,
 };
 
+#ifdef MEMHEAD_PACK_CATEGORY
+#  define MEMHEAD_CATEGORY_BITS 4
+#  define MEMHEAD_CATEGORY_SHIFT (sizeof(size_t) * 8 - MEMHEAD_CATEGORY_BITS)
+#  define MEMHEAD_LEN_MASK ((((size_t)1) << MEMHEAD_CATEGORY_SHIFT) - 1)
+#  define MEMHEAD_CATEGORY(memhead) ((eMEMCategory)((memhead)->len >> MEMHEAD_CATEGORY_SHIFT))
+#  define MEMHEAD_SET_LEN(memhead, length, block_category) \
+    ((memhead)->len = (length) | (((size_t)(block_category)) << MEMHEAD_CATEGORY_SHIFT))
+
+BLI_STATIC_ASSERT(MEM_CATEGORY_NUM <= (1 << MEMHEAD_CATEGORY_BITS),
+                  "Categories don't fit in the block header")
+#else
+#  define MEMHEAD_LEN_MASK (~((size_t)0))
+#  define MEMHEAD_CATEGORY(memhead) ((eMEMCategory)(memhead)->category)
+#  define MEMHEAD_SET_LEN(memhead, length, block_category) \
+    ((memhead)->len = (length), (memhead)->category = (size_t)(block_category))
+#endif
+
 #define MEMHEAD_FROM_PTR(ptr) (((MemHead *)ptr) - 1)
 #define PTR_FROM_MEMHEAD(memhead) (memhead + 1)
 #define MEMHEAD_ALIGNED_FROM_PTR(ptr) (((MemHeadAligned *)ptr) - 1)
 #define MEMHEAD_IS_ALIGNED(memhead) ((memhead)->len & (size_t)MEMHEAD_ALIGN_FLAG)
 
-/* Uncomment this to have proper peak counter. */
-#define USE_ATOMIC_MAX
-
-MEM_INLINE void update_maximum(size_t *maximum_value, size_t value)
-{
-#ifdef USE_ATOMIC_MAX
-  atomic_fetch_and_update_max_z(maximum_value, value);
-#else
-  *maximum_value = value > *maximum_value ? value : *maximum_value;
-#endif
-}
-
 #ifdef __GNUC__
 __attribute__((format(printf, 1, 2)))
 #endif
@@ -79,7 +98,7 @@ print_error(const char *str, ...)
 size_t MEM_lockfree_allocN_len(const void *vmemh)
 {
   if (vmemh) {
-    return MEMHEAD_FROM_PTR(vmemh)->len & ~((size_t)(MEMHEAD_ALIGN_FLAG));
+    return MEMHEAD_FROM_PTR(vmemh)->len & MEMHEAD_LEN_MASK & ~((size_t)(MEMHEAD_ALIGN_FLAG));
   }
 
   return 0;
@@ -102,8 +121,7 @@ void MEM_lockfree_freeN(void *vmemh)
     return;
   }
 
-  atomic_sub_and_fetch_u(&totblock, 1);
-  atomic_sub_and_fetch_z(&mem_in_use, len);
+  memory_usage_block_free(len, MEMHEAD_CATEGORY(memh));
 
   if (UNLIKELY(malloc_debug_memset && len)) {
     memset(memh + 1, 255, len);
@@ -222,17 +240,14 @@ void *MEM_lockfree_callocN(size_t len, const char *str)
   memh = (MemHead *)calloc(1, len + sizeof(MemHead));
 
   if (LIKELY(memh)) {
-    memh->len = len;
-    atomic_add_and_fetch_u(&totblock, 1);
-    atomic_add_and_fetch_z(&mem_in_use, len);
-    update_maximum(&peak_mem, mem_in_use);
+    MEMHEAD_SET_LEN(memh, len, memory_usage_block_alloc(len));
 
     return PTR_FROM_MEMHEAD(memh);
   }
   print_error("Calloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
               SIZET_ARG(len),
               str,
-              (unsigned int)mem_in_use);
+              (unsigned int)memory_usage_current());
   return NULL;
 }
 
@@ -246,7 +261,7 @@ void *MEM_lockfree_calloc_arrayN(size_t len, size_t size, const char *str)
         SIZET_ARG(len),
         SIZET_ARG(size),
         str,
-        (unsigned int)mem_in_use);
+        (unsigned int)memory_usage_current());
     abort();
     return NULL;
   }
@@ -267,17 +282,14 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
       memset(memh + 1, 255, len);
     }
 
-    memh->len = len;
-    atomic_add_and_fetch_u(&totblock, 1);
-    atomic_add_and_fetch_z(&mem_in_use, len);
-    update_maximum(&peak_mem, mem_in_use);
+    MEMHEAD_SET_LEN(memh, len, memory_usage_block_alloc(len));
 
     return PTR_FROM_MEMHEAD(memh);
   }
   print_error("Malloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
               SIZET_ARG(len),
               str,
-              (unsigned int)mem_in_use);
+              (unsigned int)memory_usage_current());
   return NULL;
 }
 
@@ -291,7 +303,7 @@ void *MEM_lockfree_malloc_arrayN(size_t len, size_t size, const char *str)
         SIZET_ARG(len),
         SIZET_ARG(size),
         str,
-        (unsigned int)mem_in_use);
+        (unsigned int)memory_usage_current());
     abort();
     return NULL;
   }
@@ -337,18 +349,15 @@ void *MEM_lockfree_mallocN_aligned(size_t len, size_t alignment, const char *str
       memset(memh + 1, 255, len);
     }
 
-    memh->len = len | (size_t)MEMHEAD_ALIGN_FLAG;
+    MEMHEAD_SET_LEN(memh, len | (size_t)MEMHEAD_ALIGN_FLAG, memory_usage_block_alloc(len));
     memh->alignment = (short)alignment;
-    atomic_add_and_fetch_u(&totblock, 1);
-    atomic_add_and_fetch_z(&mem_in_use, len);
-    update_maximum(&peak_mem, mem_in_use);
 
     return PTR_FROM_MEMHEAD(memh);
   }
   print_error("Malloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
               SIZET_ARG(len),
               str,
-              (unsigned int)mem_in_use);
+              (unsigned int)memory_usage_current());
   return NULL;
 }
 
@@ -368,8 +377,9 @@ void MEM_lockfree_callbackmemlist(void (*func)(void *))
 
 void MEM_lockfree_printmemlist_stats(void)
 {
-  printf("\ntotal memory len: %.3f MB\n", (double)mem_in_use / (double)(1024 * 1024));
-  printf("peak memory len: %.3f MB\n", (double)peak_mem / (double)(1024 * 1024));
+  printf("\ntotal memory len: %.3f MB\n",
+         (double)memory_usage_current() / (double)(1024 * 1024));
+  printf("peak memory len: %.3f MB\n", (double)memory_usage_peak() / (double)(1024 * 1024));
   printf(
       "\nFor more detailed per-block statistics run Blender with memory debugging command line "
       "argument.\n");
@@ -397,23 +407,23 @@ void MEM_lockfree_set_memory_debug(void)
 
 size_t MEM_lockfree_get_memory_in_use(void)
 {
-  return mem_in_use;
+  return memory_usage_current();
 }
 
 unsigned int MEM_lockfree_get_memory_blocks_in_use(void)
 {
-  return totblock;
+  return (unsigned int)memory_usage_block_num();
 }
 
 /* dummy */
 void MEM_lockfree_reset_peak_memory(void)
 {
-  peak_mem = mem_in_use;
+  memory_usage_peak_reset();
 }
 
 size_t MEM_lockfree_get_peak_memory(void)
 {
-  return peak_mem;
+  return memory_usage_peak();
 }
 
 #ifndef NDEBUG
@@ -0,0 +1,255 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup intern_mem
+ *
+ * Memory usage counters of the lock-free allocator.
+ *
+ * Every thread has its own counters, which are only written by that thread, so that allocating
+ * doesn't have to modify a cache line that all threads write to. The counters of all threads are
+ * only summed when the totals are requested, which is much less frequent than allocating.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+#include "MEM_guardedalloc.h"
+#include "mallocn_intern.h"
+
+namespace {
+
+/**
+ * The peak memory usage is only updated when the memory usage of a thread has grown by this
+ * amount since the last update, because it requires summing the counters of all threads.
+ * The peak can be underestimated by at most this amount per thread.
+ */
+constexpr int64_t peak_update_threshold = 1024 * 1024;
+
+struct Local {
+  /* Can be negative when a thread frees memory allocated by another thread. */
+  std::atomic<int64_t> blocks_num = 0;
+  std::atomic<int64_t> mem_in_use = 0;
+  std::atomic<int64_t> mem_in_use_by_category[MEM_CATEGORY_NUM] = {};
+  /* Only used by the owning thread. */
+  int64_t mem_in_use_during_peak_update = 0;
+
+  /* Links in the list of all thread-local counters, protected by #Global::locals_mutex. */
+  Local *prev = nullptr;
+  Local *next = nullptr;
+
+  Local();
+  ~Local();
+};
+
+struct Global {
+  std::mutex locals_mutex;
+  Local *locals_first = nullptr;
+
+  /* Counters of threads that have finished, and of allocations while a thread is finishing. */
+  std::atomic<int64_t> blocks_num_outside_locals = 0;
+  std::atomic<int64_t> mem_in_use_outside_locals = 0;
+  std::atomic<int64_t> mem_in_use_by_category_outside_locals[MEM_CATEGORY_NUM] = {};
+
+  std::atomic<size_t> peak = 0;
+};
+
+/**
+ * The global state is constructed on first use and never destructed, so that it can be used
+ * during static initialization and destruction. It doesn't allocate, because the allocator can
+ * call into this file recursively when C++ allocations go through guardedalloc too.
+ */
+Global &get_global()
+{
+  alignas(Global) static char buffer[sizeof(Global)];
+  static Global *global = new (buffer) Global();
+  return *global;
+}
+
+/* Unlike #Local, these are trivially destructible, so they remain valid after #Local is
+ * destructed when the thread finishes. */
+thread_local bool local_is_destructed = false;
+thread_local eMEMCategory local_category = MEM_CATEGORY_OTHER;
+
+Local &get_local()
+{
+  static thread_local Local local;
+  return local;
+}
+
+Local::Local()
+{
+  Global &global = get_global();
+  std::lock_guard lock{global.locals_mutex};
+  this->next = global.locals_first;
+  if (global.locals_first != nullptr) {
+    global.locals_first->prev = this;
+  }
+  global.locals_first = this;
+}
+
+Local::~Local()
+{
+  Global &global = get_global();
+  std::lock_guard lock{global.locals_mutex};
+  if (this->prev == nullptr) {
+    global.locals_first = this->next;
+  }
+  else {
+    this->prev->next = this->next;
+  }
+  if (this->next != nullptr) {
+    this->next->prev = this->prev;
+  }
+  global.blocks_num_outside_locals += this->blocks_num;
+  global.mem_in_use_outside_locals += this->mem_in_use;
+  for (int i = 0; i < MEM_CATEGORY_NUM; i++) {
+    global.mem_in_use_by_category_outside_locals[i] += this->mem_in_use_by_category[i];
+  }
+  local_is_destructed = true;
+}
+
+/** Add a value to a counter that is only written by the current thread. */
+void add_to_local(std::atomic<int64_t> &counter, const int64_t value)
+{
+  counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+void sum_counters(int64_t &r_blocks_num, int64_t &r_mem_in_use)
+{
+  Global &global = get_global();
+  std::lock_guard lock{global.locals_mutex};
+  r_blocks_num = global.blocks_num_outside_locals;
+  r_mem_in_use = global.mem_in_use_outside_locals;
+  for (const Local *local = global.locals_first; local != nullptr; local = local->next) {
+    r_blocks_num += local->blocks_num.load(std::memory_order_relaxed);
+    r_mem_in_use += local->mem_in_use.load(std::memory_order_relaxed);
+  }
+}
+
+size_t sum_mem_in_use()
+{
+  int64_t blocks_num, mem_in_use;
+  sum_counters(blocks_num, mem_in_use);
+  /* Threads can see each others counters in a different order, clamp the temporary error. */
+  return size_t(std::max<int64_t>(mem_in_use, 0));
+}
+
+void update_peak()
+{
+  const size_t mem_in_use = sum_mem_in_use();
+  Global &global = get_global();
+  size_t peak = global.peak.load(std::memory_order_relaxed);
+  while (mem_in_use > peak && !global.peak.compare_exchange_weak(peak, mem_in_use)) {
+  }
+}
+
+}  // namespace
+
+eMEMCategory memory_usage_block_alloc(size_t size)
+{
+  const eMEMCategory category = local_category;
+  if (UNLIKELY(local_is_destructed)) {
+    Global &global = get_global();
+    global.blocks_num_outside_locals.fetch_add(1, std::memory_order_relaxed);
+    global.mem_in_use_outside_locals.fetch_add(int64_t(size), std::memory_order_relaxed);
+    global.mem_in_use_by_category_outside_locals[category].fetch_add(int64_t(size),
+                                                                     std::memory_order_relaxed);
+    return category;
+  }
+  Local &local = get_local();
+  add_to_local(local.blocks_num, 1);
+  add_to_local(local.mem_in_use, int64_t(size));
+  add_to_local(local.mem_in_use_by_category[category], int64_t(size));
+
+  const int64_t mem_in_use = local.mem_in_use.load(std::memory_order_relaxed);
+  if (mem_in_use - local.mem_in_use_during_peak_update > peak_update_threshold) {
+    local.mem_in_use_during_peak_update = mem_in_use;
+    update_peak();
+  }
+  return category;
+}
+
+void memory_usage_block_free(size_t size, const eMEMCategory category)
+{
+  if (UNLIKELY(local_is_destructed)) {
+    Global &global = get_global();
+    global.blocks_num_outside_locals.fetch_sub(1, std::memory_order_relaxed);
+    global.mem_in_use_outside_locals.fetch_sub(int64_t(size), std::memory_order_relaxed);
+    global.mem_in_use_by_category_outside_locals[category].fetch_sub(int64_t(size),
+                                                                     std::memory_order_relaxed);
+    return;
+  }
+  Local &local = get_local();
+  add_to_local(local.blocks_num, -1);
+  add_to_local(local.mem_in_use, -int64_t(size));
+  add_to_local(local.mem_in_use_by_category[category], -int64_t(size));
+
+  /* Lower the reference point, so that growing again updates the peak in time. */
+  const int64_t mem_in_use = local.mem_in_use.load(std::memory_order_relaxed);
+  local.mem_in_use_during_peak_update = std::min(local.mem_in_use_during_peak_update, mem_in_use);
+}
+
+size_t memory_usage_block_num()
+{
+  int64_t blocks_num, mem_in_use;
+  sum_counters(blocks_num, mem_in_use);
+  return size_t(std::max<int64_t>(blocks_num, 0));
+}
+
+size_t memory_usage_current()
+{
+  return sum_mem_in_use();
+}
+
+size_t memory_usage_peak()
+{
+  update_peak();
+  return get_global().peak;
+}
+
+void memory_usage_peak_reset()
+{
+  get_global().peak = sum_mem_in_use();
+}
+
+eMEMCategory MEM_category_set(const eMEMCategory category)
+{
+  const eMEMCategory prev_category = local_category;
+  local_category = category;
+  return prev_category;
+}
+
+size_t MEM_get_category_memory_in_use(const eMEMCategory category)
+{
+  Global &global = get_global();
+  std::lock_guard lock{global.locals_mutex};
+  int64_t mem_in_use = global.mem_in_use_by_category_outside_locals[category];
+  for (const Local *local = global.locals_first; local != nullptr; local = local->next) {
+    mem_in_use += local->mem_in_use_by_category[category].load(std::memory_order_relaxed);
+  }
+  return size_t(std::max<int64_t>(mem_in_use, 0));
+}
+
+const char *MEM_category_name(const eMEMCategory category)
+{
+  switch (category) {
+    case MEM_CATEGORY_OTHER:
+      return "Other";
+    case MEM_CATEGORY_MESH:
+      return "Mesh";
+    case MEM_CATEGORY_IMAGE:
+      return "Image";
+    case MEM_CATEGORY_UNDO:
+      return "Undo";
+    case MEM_CATEGORY_GPU_STAGING:
+      return "GPU Staging";
+    case MEM_CATEGORY_GEOMETRY_NODES:
+      return "Geometry Nodes";
+    case MEM_CATEGORY_NUM:
+      break;
+  }
+  return "";
+}
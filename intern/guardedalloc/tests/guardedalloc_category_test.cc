@@ -0,0 +1,34 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <thread>
+
+#include "MEM_guardedalloc.h"
+#include "guardedalloc_test_base.h"
+
+TEST_F(LockFreeAllocatorTest, MEM_category)
+{
+  const size_t mesh_mem_before = MEM_get_category_memory_in_use(MEM_CATEGORY_MESH);
+
+  const eMEMCategory prev_category = MEM_category_set(MEM_CATEGORY_MESH);
+  void *mesh_data = MEM_mallocN(1024, __func__);
+  void *mesh_data_aligned = MEM_mallocN_aligned(1024, 64, __func__);
+  EXPECT_EQ(MEM_category_set(prev_category), MEM_CATEGORY_MESH);
+  void *other_data = MEM_mallocN(1024, __func__);
+
+  /* The category must not be visible in the length of the block. */
+  EXPECT_EQ(MEM_allocN_len(mesh_data), 1024);
+  EXPECT_EQ(MEM_allocN_len(mesh_data_aligned), 1024);
+  EXPECT_EQ(MEM_get_category_memory_in_use(MEM_CATEGORY_MESH), mesh_mem_before + 2048);
+
+  /* Freeing from another thread still subtracts from the category of the block. */
+  std::thread thread([&]() {
+    MEM_freeN(mesh_data);
+    MEM_freeN(mesh_data_aligned);
+  });
+  thread.join();
+  EXPECT_EQ(MEM_get_category_memory_in_use(MEM_CATEGORY_MESH), mesh_mem_before);
+
+  MEM_freeN(other_data);
+}
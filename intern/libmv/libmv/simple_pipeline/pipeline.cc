@@ -159,6 +159,16 @@ void InternalCompleteReconstruction(
   LG << "Max track: " << max_track;
   LG << "Max image: " << max_image;
   LG << "Number of markers: " << tracks.NumMarkers();
+
+  // Group the markers by track and by image once, instead of searching all
+  // markers for every track and image in every pass below.
+  vector<vector<Marker>> markers_for_track(max_track + 1);
+  vector<vector<Marker>> markers_in_image(max_image + 1);
+  for (const Marker& marker : tracks.AllMarkers()) {
+    markers_for_track[marker.track].push_back(marker);
+    markers_in_image[marker.image].push_back(marker);
+  }
+
   while (num_resects != 0 || num_intersects != 0) {
     // Do all possible intersections.
     num_intersects = 0;
@@ -167,7 +177,7 @@ void InternalCompleteReconstruction(
         LG << "Skipping point: " << track;
         continue;
       }
-      vector<Marker> all_markers = tracks.MarkersForTrack(track);
+      const vector<Marker>& all_markers = markers_for_track[track];
       LG << "Got " << all_markers.size() << " markers for track " << track;
 
       vector<Marker> reconstructed_markers;
@@ -205,7 +215,7 @@ void InternalCompleteReconstruction(
         LG << "Skipping frame: " << image;
         continue;
       }
-      vector<Marker> all_markers = tracks.MarkersInImage(image);
+      const vector<Marker>& all_markers = markers_in_image[image];
       LG << "Got " << all_markers.size() << " markers for image " << image;
 
       vector<Marker> reconstructed_markers;
@@ -244,7 +254,7 @@ void InternalCompleteReconstruction(
       LG << "Skipping frame: " << image;
       continue;
     }
-    vector<Marker> all_markers = tracks.MarkersInImage(image);
+    const vector<Marker>& all_markers = markers_in_image[image];
 
     vector<Marker> reconstructed_markers;
     for (int i = 0; i < all_markers.size(); ++i) {
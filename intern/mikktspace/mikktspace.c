@@ -238,6 +238,22 @@ MIKK_INLINE SVec3 GetPosition(const SMikkTSpaceContext *pContext, const int inde
 MIKK_INLINE SVec3 GetNormal(const SMikkTSpaceContext *pContext, const int index);
 MIKK_INLINE SVec3 GetTexCoord(const SMikkTSpaceContext *pContext, const int index);
 
+typedef void (*RangeFunc)(void *pData, const int iStart, const int iEnd);
+
+// runs func for all items, split over threads by the application if m_parallelRange is set.
+static void ParallelRange(const SMikkTSpaceContext *pContext,
+                          const int iNrItems,
+                          RangeFunc func,
+                          void *pData)
+{
+  if (iNrItems <= 0)
+    return;
+  if (pContext->m_pInterface->m_parallelRange != NULL)
+    pContext->m_pInterface->m_parallelRange(pContext, iNrItems, func, pData);
+  else
+    func(pData, 0, iNrItems);
+}
+
 // degen triangles
 static void DegenPrologue(STriInfo pTriInfos[],
                           int piTriList_out[],
@@ -831,17 +847,23 @@ static float CalcTexArea(const SMikkTSpaceContext *pContext, const int indices[]
   return fSignedAreaSTx2 < 0 ? (-fSignedAreaSTx2) : fSignedAreaSTx2;
 }
 
-static void InitTriInfo(STriInfo pTriInfos[],
-                        const int piTriListIn[],
-                        const SMikkTSpaceContext *pContext,
-                        const int iNrTrianglesIn)
+typedef struct {
+  STriInfo *pTriInfos;
+  const int *piTriListIn;
+  const SMikkTSpaceContext *pContext;
+} STriInfoRangeData;
+
+// triangles are independent here, so this may run for several ranges at once.
+static void InitTriInfoRange(void *pData, const int iStart, const int iEnd)
 {
-  int f = 0, i = 0, t = 0;
-  // pTriInfos[f].iFlag is cleared in GenerateInitialVerticesIndexList()
-  // which is called before this function.
+  STriInfoRangeData *pRangeData = (STriInfoRangeData *)pData;
+  STriInfo *pTriInfos = pRangeData->pTriInfos;
+  const int *piTriListIn = pRangeData->piTriListIn;
+  const SMikkTSpaceContext *pContext = pRangeData->pContext;
+  int f = 0, i = 0;
 
   // generate neighbor info list
-  for (f = 0; f < iNrTrianglesIn; f++)
+  for (f = iStart; f < iEnd; f++)
     for (i = 0; i < 3; i++) {
       pTriInfos[f].FaceNeighbors[i] = -1;
       pTriInfos[f].AssignedGroup[i] = NULL;
@@ -860,7 +882,7 @@ static void InitTriInfo(STriInfo pTriInfos[],
     }
 
   // evaluate first order derivatives
-  for (f = 0; f < iNrTrianglesIn; f++) {
+  for (f = iStart; f < iEnd; f++) {
     // initial values
     const SVec3 v1 = GetPosition(pContext, piTriListIn[f * 3 + 0]);
     const SVec3 v2 = GetPosition(pContext, piTriListIn[f * 3 + 1]);
@@ -902,6 +924,23 @@ static void InitTriInfo(STriInfo pTriInfos[],
         pTriInfos[f].iFlag &= (~GROUP_WITH_ANY);
     }
   }
+}
+
+static void InitTriInfo(STriInfo pTriInfos[],
+                        const int piTriListIn[],
+                        const SMikkTSpaceContext *pContext,
+                        const int iNrTrianglesIn)
+{
+  int t = 0;
+  // pTriInfos[f].iFlag is cleared in GenerateInitialVerticesIndexList()
+  // which is called before this function.
+  {
+    STriInfoRangeData sRangeData;
+    sRangeData.pTriInfos = pTriInfos;
+    sRangeData.piTriListIn = piTriListIn;
+    sRangeData.pContext = pContext;
+    ParallelRange(pContext, iNrTrianglesIn, InitTriInfoRange, &sRangeData);
+  }
 
   // force otherwise healthy quads to a fixed orientation
   while (t < (iNrTrianglesIn - 1)) {
@@ -1103,24 +1142,50 @@ static STSpace EvalTspace(const int face_indices[],
                           const SMikkTSpaceContext *pContext,
                           const int iVertexRepresentitive);
 
-static tbool GenerateTSpaces(STSpace psTspace[],
-                             const STriInfo pTriInfos[],
-                             const SGroup pGroups[],
-                             const int iNrActiveGroups,
-                             const int piTriListIn[],
-                             const float fThresCos,
-                             const SMikkTSpaceContext *pContext)
+typedef struct {
+  STSpace *pGroupTspaces;  // one per face of each group, indexed by piGroupOffsets
+  const int *piGroupOffsets;
+  tbool *pbGroupFailed;
+  const STriInfo *pTriInfos;
+  const SGroup *pGroups;
+  const int *piTriListIn;
+  float fThresCos;
+  const SMikkTSpaceContext *pContext;
+} SGroupTSpacesData;
+
+static int GroupVertIndex(const STriInfo *pTriInfo, const SGroup *pGroup)
+{
+  int index = -1;
+  if (pTriInfo->AssignedGroup[0] == pGroup)
+    index = 0;
+  else if (pTriInfo->AssignedGroup[1] == pGroup)
+    index = 1;
+  else if (pTriInfo->AssignedGroup[2] == pGroup)
+    index = 2;
+  assert(index >= 0 && index < 3);
+  return index;
+}
+
+// groups only read shared data and write their own part of pGroupTspaces,
+// so this may run for several ranges at once.
+static void GenerateGroupTSpacesRange(void *pData, const int iStart, const int iEnd)
 {
+  SGroupTSpacesData *pRangeData = (SGroupTSpacesData *)pData;
+  const STriInfo *pTriInfos = pRangeData->pTriInfos;
+  const SGroup *pGroups = pRangeData->pGroups;
+  const int *piTriListIn = pRangeData->piTriListIn;
+  const float fThresCos = pRangeData->fThresCos;
+  const SMikkTSpaceContext *pContext = pRangeData->pContext;
   STSpace *pSubGroupTspace = NULL;
   SSubGroup *pUniSubGroups = NULL;
   int *pTmpMembers = NULL;
-  int iMaxNrFaces = 0, iUniqueTspaces = 0, g = 0, i = 0;
-  for (g = 0; g < iNrActiveGroups; g++)
+  int iMaxNrFaces = 0, g = 0, i = 0;
+  for (g = iStart; g < iEnd; g++)
     if (iMaxNrFaces < pGroups[g].iNrFaces)
       iMaxNrFaces = pGroups[g].iNrFaces;
 
   if (iMaxNrFaces == 0)
-    return TTRUE;
+    return;
 
   // make initial allocations
   pSubGroupTspace = (STSpace *)malloc(sizeof(STSpace) * iMaxNrFaces);
@@ -1133,13 +1198,16 @@ static tbool GenerateTSpaces(STSpace psTspace[],
       free(pUniSubGroups);
     if (pTmpMembers != NULL)
       free(pTmpMembers);
-    return TFALSE;
+    for (g = iStart; g < iEnd; g++)
+      pRangeData->pbGroupFailed[g] = TTRUE;
+    return;
   }
 
-  iUniqueTspaces = 0;
-  for (g = 0; g < iNrActiveGroups; g++) {
+  for (g = iStart; g < iEnd; g++) {
     const SGroup *pGroup = &pGroups[g];
+    STSpace *pGroupTspaces = &pRangeData->pGroupTspaces[pRangeData->piGroupOffsets[g]];
     int iUniqueSubGroups = 0, s = 0;
+    tbool bFailed = TFALSE;
 
     for (i = 0; i < pGroup->iNrFaces; i++)  // triangles
     {
@@ -1148,13 +1216,7 @@ static tbool GenerateTSpaces(STSpace psTspace[],
       SSubGroup tmp_group;
       tbool bFound;
       SVec3 n, vOs, vOt;
-      if (pTriInfos[f].AssignedGroup[0] == pGroup)
-        index = 0;
-      else if (pTriInfos[f].AssignedGroup[1] == pGroup)
-        index = 1;
-      else if (pTriInfos[f].AssignedGroup[2] == pGroup)
-        index = 2;
-      assert(index >= 0 && index < 3);
+      index = GroupVertIndex(&pTriInfos[f], pGroup);
 
       iVertIndex = piTriListIn[f * 3 + index];
       assert(iVertIndex == pGroup->iVertexRepresentitive);
@@ -1213,21 +1275,14 @@ static tbool GenerateTSpaces(STSpace psTspace[],
 
       // assign tangent space index
       assert(bFound || l == iUniqueSubGroups);
-      // piTempTangIndices[f*3+index] = iUniqueTspaces+l;
 
       // if no match was found we allocate a new subgroup
       if (!bFound) {
         // insert new subgroup
         int *pIndices = (int *)malloc(sizeof(int) * iMembers);
         if (pIndices == NULL) {
-          // clean up and return false
-          int s = 0;
-          for (s = 0; s < iUniqueSubGroups; s++)
-            free(pUniSubGroups[s].pTriMembers);
-          free(pUniSubGroups);
-          free(pTmpMembers);
-          free(pSubGroupTspace);
-          return TFALSE;
+          bFailed = TTRUE;
+          break;
         }
         pUniSubGroups[iUniqueSubGroups].iNrFaces = iMembers;
         pUniSubGroups[iUniqueSubGroups].pTriMembers = pIndices;
@@ -1241,39 +1296,113 @@ static tbool GenerateTSpaces(STSpace psTspace[],
         ++iUniqueSubGroups;
       }
 
-      // output tspace
-      {
-        const int iOffs = pTriInfos[f].iTSpacesOffs;
-        const int iVert = pTriInfos[f].vert_num[index];
-        STSpace *pTS_out = &psTspace[iOffs + iVert];
-        assert(pTS_out->iCounter < 2);
-        assert(((pTriInfos[f].iFlag & ORIENT_PRESERVING) != 0) == pGroup->bOrientPreservering);
-        if (pTS_out->iCounter == 1) {
-          *pTS_out = AvgTSpace(pTS_out, &pSubGroupTspace[l]);
-          pTS_out->iCounter = 2;  // update counter
-          pTS_out->bOrient = pGroup->bOrientPreservering;
-        }
-        else {
-          assert(pTS_out->iCounter == 0);
-          *pTS_out = pSubGroupTspace[l];
-          pTS_out->iCounter = 1;  // update counter
-          pTS_out->bOrient = pGroup->bOrientPreservering;
-        }
-      }
+      // output tspace, merged into psTspace[] by GenerateTSpaces()
+      pGroupTspaces[i] = pSubGroupTspace[l];
     }
 
-    // clean up and offset iUniqueTspaces
+    // clean up
     for (s = 0; s < iUniqueSubGroups; s++)
       free(pUniSubGroups[s].pTriMembers);
-    iUniqueTspaces += iUniqueSubGroups;
+    pRangeData->pbGroupFailed[g] = bFailed;
   }
 
   // clean up
   free(pUniSubGroups);
   free(pTmpMembers);
   free(pSubGroupTspace);
+}
 
-  return TTRUE;
+static tbool GenerateTSpaces(STSpace psTspace[],
+                             const STriInfo pTriInfos[],
+                             const SGroup pGroups[],
+                             const int iNrActiveGroups,
+                             const int piTriListIn[],
+                             const float fThresCos,
+                             const SMikkTSpaceContext *pContext)
+{
+  SGroupTSpacesData sRangeData;
+  STSpace *pGroupTspaces = NULL;
+  int *piGroupOffsets = NULL;
+  tbool *pbGroupFailed = NULL;
+  tbool bRes = TTRUE;
+  int iNrGroupFaces = 0, g = 0, i = 0;
+  for (g = 0; g < iNrActiveGroups; g++)
+    iNrGroupFaces += pGroups[g].iNrFaces;
+
+  if (iNrGroupFaces == 0)
+    return TTRUE;
+
+  // make initial allocations
+  pGroupTspaces = (STSpace *)malloc(sizeof(STSpace) * iNrGroupFaces);
+  piGroupOffsets = (int *)malloc(sizeof(int) * iNrActiveGroups);
+  pbGroupFailed = (tbool *)malloc(sizeof(tbool) * iNrActiveGroups);
+  if (pGroupTspaces == NULL || piGroupOffsets == NULL || pbGroupFailed == NULL) {
+    if (pGroupTspaces != NULL)
+      free(pGroupTspaces);
+    if (piGroupOffsets != NULL)
+      free(piGroupOffsets);
+    if (pbGroupFailed != NULL)
+      free(pbGroupFailed);
+    return TFALSE;
+  }
+
+  iNrGroupFaces = 0;
+  for (g = 0; g < iNrActiveGroups; g++) {
+    piGroupOffsets[g] = iNrGroupFaces;
+    pbGroupFailed[g] = TFALSE;
+    iNrGroupFaces += pGroups[g].iNrFaces;
+  }
+
+  // groups are split up into subgroups independently of each other
+  sRangeData.pGroupTspaces = pGroupTspaces;
+  sRangeData.piGroupOffsets = piGroupOffsets;
+  sRangeData.pbGroupFailed = pbGroupFailed;
+  sRangeData.pTriInfos = pTriInfos;
+  sRangeData.pGroups = pGroups;
+  sRangeData.piTriListIn = piTriListIn;
+  sRangeData.fThresCos = fThresCos;
+  sRangeData.pContext = pContext;
+  ParallelRange(pContext, iNrActiveGroups, GenerateGroupTSpacesRange, &sRangeData);
+
+  for (g = 0; g < iNrActiveGroups; g++)
+    if (pbGroupFailed[g])
+      bRes = TFALSE;
+
+  // vertices of quads can be shared by two groups, so the output is written
+  // in group order on this thread, which keeps the averaging deterministic.
+  for (g = 0; g < iNrActiveGroups && bRes; g++) {
+    const SGroup *pGroup = &pGroups[g];
+    const STSpace *pGroupTspace = &pGroupTspaces[piGroupOffsets[g]];
+
+    for (i = 0; i < pGroup->iNrFaces; i++)  // triangles
+    {
+      const int f = pGroup->pFaceIndices[i];  // triangle number
+      const int index = GroupVertIndex(&pTriInfos[f], pGroup);
+      const int iOffs = pTriInfos[f].iTSpacesOffs;
+      const int iVert = pTriInfos[f].vert_num[index];
+      STSpace *pTS_out = &psTspace[iOffs + iVert];
+      assert(pTS_out->iCounter < 2);
+      assert(((pTriInfos[f].iFlag & ORIENT_PRESERVING) != 0) == pGroup->bOrientPreservering);
+      if (pTS_out->iCounter == 1) {
+        *pTS_out = AvgTSpace(pTS_out, &pGroupTspace[i]);
+        pTS_out->iCounter = 2;  // update counter
+        pTS_out->bOrient = pGroup->bOrientPreservering;
+      }
+      else {
+        assert(pTS_out->iCounter == 0);
+        *pTS_out = pGroupTspace[i];
+        pTS_out->iCounter = 1;  // update counter
+        pTS_out->bOrient = pGroup->bOrientPreservering;
+      }
+    }
+  }
+
+  // clean up
+  free(pGroupTspaces);
+  free(piGroupOffsets);
+  free(pbGroupFailed);
+
+  return bRes;
 }
 
 static STSpace EvalTspace(const int face_indices[],
@@ -105,6 +105,16 @@ typedef struct {
                       const tbool bIsOrientationPreserving,
                       const int iFace,
                       const int iVert);
+
+  // Optional. When set, the per triangle and per group stages call this function instead of
+  // func(pData, 0, iNrItems) directly. It must call func for sub-ranges which together cover
+  // {0, 1, ..., iNrItems-1} exactly once, from any number of threads, and return when all are
+  // done. The m_get*() call-backs must then be thread safe. The generated tangent spaces are
+  // the same with or without it.
+  void (*m_parallelRange)(const SMikkTSpaceContext *pContext,
+                          const int iNrItems,
+                          void (*func)(void *pData, const int iStart, const int iEnd),
+                          void *pData);
 } SMikkTSpaceInterface;
 
 struct SMikkTSpaceContext {
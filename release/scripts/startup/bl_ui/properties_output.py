@@ -133,6 +133,10 @@ class RENDER_PT_frame_range(RenderOutputButtonsPanel, Panel):
         col.prop(scene, "frame_end", text="End")
         col.prop(scene, "frame_step", text="Step")
 
+        col = layout.column()
+        col.active = scene.frame_step > 1
+        col.prop(scene.render, "use_skip_stepped_frames")
+
 
 class RENDER_PT_time_stretching(RenderOutputButtonsPanel, Panel):
     bl_label = "Time Stretching"
@@ -354,6 +358,9 @@ class RENDER_PT_encoding_video(RenderOutputButtonsPanel, Panel):
         if ffmpeg.codec == 'DNXHD':
             layout.prop(ffmpeg, "use_lossless_output")
 
+        if ffmpeg.codec == 'H264' or ffmpeg.format == 'H264':
+            layout.prop(ffmpeg, "use_hardware_encoder")
+
         # Output quality
         use_crf = needs_codec and ffmpeg.codec in {'H264', 'MPEG4', 'WEBM'}
         if use_crf:
@@ -369,6 +376,7 @@ class RENDER_PT_encoding_video(RenderOutputButtonsPanel, Panel):
         sub = row.row(align=True)
         sub.active = ffmpeg.use_max_b_frames
         sub.prop(ffmpeg, "max_b_frames", text="")
+        layout.prop(ffmpeg, "threads")
 
         if not use_crf or ffmpeg.constant_rate_factor == 'NONE':
             col = layout.column()
@@ -679,6 +679,8 @@ class NODE_PT_quality(bpy.types.Panel):
         col.prop(tree, "use_groupnode_buffer")
         col.prop(tree, "use_two_pass")
         col.prop(tree, "use_viewer_border")
+        if prefs.experimental.use_full_frame_compositor and tree.execution_mode == 'FULL_FRAME':
+            col.prop(tree, "use_cache")
         col.separator()
         col.prop(snode, "use_auto_render")
 
@@ -708,7 +710,9 @@ class NODE_PT_overlay(Panel):
 
         if snode.tree_type == 'GeometryNodeTree':
             col.separator()
-            col.prop(overlay, "show_timing", text="Timings")
+            row = col.row(align=True)
+            row.prop(overlay, "show_timing", text="Timings")
+            row.operator("node.export_timings", text="", icon='EXPORT')
 
 
 class NODE_UL_interface_sockets(bpy.types.UIList):
@@ -2221,6 +2221,8 @@ class SEQUENCER_PT_strip_proxy(SequencerButtonsPanel, Panel):
             col.prop(proxy, "quality", text="Quality")
 
             if strip.type == 'MOVIE':
+                col.prop(proxy, "codec")
+
                 col = layout.column()
 
                 col.prop(proxy, "timecode", text="Timecode Index")
@@ -2302,6 +2304,9 @@ class SEQUENCER_PT_view(SequencerButtonsPanel_Output, Panel):
         col = layout.column()
         if ed:
             col.prop(ed, "use_prefetch")
+            sub = col.column()
+            sub.active = ed.use_prefetch
+            sub.prop(ed, "prefetch_threads", text="Threads")
 
         col.prop(st, "display_channel", text="Channel")
 
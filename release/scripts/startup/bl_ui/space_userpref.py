@@ -637,6 +637,7 @@ class USERPREF_PT_system_memory(SystemPanel, CenterAlignMixIn, Panel):
         col = layout.column()
         col.prop(system, "texture_time_out", text="Texture Time Out")
         col.prop(system, "texture_collection_rate", text="Garbage Collection Rate")
+        col.prop(system, "image_memory_limit", text="Image Memory Limit")
 
         layout.separator()
 
@@ -668,6 +669,10 @@ class USERPREF_PT_system_video_sequencer(SystemPanel, CenterAlignMixIn, Panel):
 
         layout.prop(system, "sequencer_proxy_setup")
 
+        layout.separator()
+
+        layout.prop(system, "use_hardware_video_decoding")
+
 
 # -----------------------------------------------------------------------------
 # Viewport Panels
@@ -732,6 +737,7 @@ class USERPREF_PT_viewport_textures(ViewportPanel, CenterAlignMixIn, Panel):
 
         col = layout.column()
         col.prop(system, "gl_texture_limit", text="Limit Size")
+        col.prop(system, "use_texture_compression")
         col.prop(system, "anisotropic_filter")
         col.prop(system, "gl_clip_alpha", slider=True)
         col.prop(system, "image_draw_method", text="Image Display Method")
@@ -2276,6 +2282,7 @@ class USERPREF_PT_experimental_prototypes(ExperimentalPanel, Panel):
                 ({"property": "use_new_curves_type"}, "T68981"),
                 ({"property": "use_new_point_cloud_type"}, "T75717"),
                 ({"property": "use_full_frame_compositor"}, "T88150"),
+                ({"property": "use_draw_occlusion_culling"}, None),
             ),
         )
 
@@ -595,6 +595,13 @@ void blf_glyph_draw(FontBLF *font, GlyphCacheBLF *gc, GlyphBLF *g, float x, floa
     if (bitmap_len > gc->bitmap_len_alloc) {
       int w = font->tex_size_max;
       int h = bitmap_len / w + 1;
+      /* Grow the texture by at least doubling its height, so that adding glyphs one at a time
+       * (common when a lot of text is drawn for the first time) doesn't re-create the texture and
+       * re-upload the whole bitmap for every new row. */
+      if (gc->texture) {
+        const int h_double = min_ii(GPU_texture_height(gc->texture) * 2, font->tex_size_max);
+        h = max_ii(h, h_double);
+      }
 
       gc->bitmap_len_alloc = w * h;
       gc->bitmap_result = MEM_reallocN(gc->bitmap_result, (size_t)gc->bitmap_len_alloc);
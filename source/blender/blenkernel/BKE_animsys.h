@@ -361,6 +361,18 @@ void BKE_animsys_eval_driver(struct Depsgraph *depsgraph,
 
 void BKE_animsys_update_driver_array(struct ID *id);
 
+/**
+ * Create the cache of resolved RNA paths of the F-Curves and drivers of an evaluated ID.
+ * Paths are only cached for IDs that have this cache.
+ */
+void BKE_animsys_rna_path_cache_ensure(struct ID *id);
+/**
+ * Invalidate the resolved RNA paths of the ID, because the data they point to may have been
+ * reallocated. Must not be called while the ID is evaluated.
+ */
+void BKE_animsys_rna_path_cache_clear(struct ID *id);
+void BKE_animsys_rna_path_cache_free(struct AnimData *adt);
+
 /* ************************************* */
 
 #ifdef __cplusplus
@@ -9,6 +9,7 @@
  * \brief Low-level operations for curves.
  */
 
+#include <memory>
 #include <mutex>
 
 #include "BLI_float4x4.hh"
@@ -23,6 +24,8 @@
 
 #include "FN_generic_virtual_array.hh"
 
+class CurveEval;
+
 namespace blender::bke {
 
 /**
@@ -46,6 +49,16 @@ class CurvesGeometryRuntime {
   mutable Vector<float3> evaluated_normals_cache;
   mutable std::mutex normal_cache_mutex;
   mutable bool normal_cache_dirty = true;
+
+  /**
+   * Legacy curve with the data needed to evaluate the curves, but without radii and generic
+   * attributes. The evaluated points, tangents, normals and lengths are cached on its splines,
+   * so this lets all users of the same curves share them. Cleared whenever the curves change.
+   */
+  mutable std::unique_ptr<CurveEval> curve_eval_cache;
+  mutable std::mutex curve_eval_cache_mutex;
+
+  ~CurvesGeometryRuntime();
 };
 
 /**
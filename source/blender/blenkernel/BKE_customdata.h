@@ -272,6 +272,15 @@ bool CustomData_is_referenced_layer(struct CustomData *data, int type);
  * Duplicate all the layers with flag NOFREE, and remove the flag from duplicated layers.
  */
 void CustomData_duplicate_referenced_layers(CustomData *data, int totelem);
+/**
+ * Like #CustomData_duplicate_referenced_layers, but take over the memory of matching layers in
+ * \a old_data (same type and name, without custom copy or free callbacks) instead of allocating
+ * it, only copying the data when it differs. The taken layers are cleared in \a old_data, which
+ * still has to be freed by the caller. Both must have \a totelem elements.
+ */
+void CustomData_duplicate_referenced_layers_reuse(CustomData *data,
+                                                  CustomData *old_data,
+                                                  int totelem);
 
 /**
  * Set the #CD_FLAG_NOCOPY flag in custom data layers where the mask is
@@ -479,6 +488,11 @@ void CustomData_set_layer_flag(struct CustomData *data, int type, int flag);
 void CustomData_clear_layer_flag(struct CustomData *data, int type, int flag);
 
 void CustomData_bmesh_set_default(struct CustomData *data, void **block);
+/**
+ * Allocate a block from the pool of the layers, freeing the existing block if any.
+ * The data of the block is not initialized.
+ */
+void CustomData_bmesh_alloc_block(struct CustomData *data, void **block);
 void CustomData_bmesh_free_block(struct CustomData *data, void **block);
 /**
  * Same as #CustomData_bmesh_free_block but zero the memory rather than freeing.
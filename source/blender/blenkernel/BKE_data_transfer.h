@@ -13,6 +13,7 @@
 extern "C" {
 #endif
 
+struct DataTransferRemapCache;
 struct Depsgraph;
 struct Object;
 struct ReportList;
@@ -147,6 +148,10 @@ bool BKE_object_data_transfer_mesh(struct Depsgraph *depsgraph,
                                    const char *vgroup_name,
                                    bool invert_vgroup,
                                    struct ReportList *reports);
+/**
+ * \param remap_cache: Optional, keeps the geometry mappings between calls,
+ * they are only computed again when the meshes or the mapping settings changed.
+ */
 bool BKE_object_data_transfer_ex(struct Depsgraph *depsgraph,
                                  struct Scene *scene,
                                  struct Object *ob_src,
@@ -169,8 +174,12 @@ bool BKE_object_data_transfer_ex(struct Depsgraph *depsgraph,
                                  float mix_factor,
                                  const char *vgroup_name,
                                  bool invert_vgroup,
+                                 struct DataTransferRemapCache *remap_cache,
                                  struct ReportList *reports);
 
+struct DataTransferRemapCache *BKE_object_data_transfer_remap_cache_create(void);
+void BKE_object_data_transfer_remap_cache_free(struct DataTransferRemapCache *remap_cache);
+
 #ifdef __cplusplus
 }
 #endif
@@ -81,6 +81,11 @@ typedef struct EffectorCache {
   struct GuideEffectorData *guide_data;
   float guide_loc[4], guide_dir[3], guide_radius;
 
+  /* Particle system effectors: states of the effector particles, evaluated once instead of for
+   * every effected point, and a tree to find the particles in range of a point. */
+  struct EffectorParticleState *particle_states;
+  struct KDTree_3d *particle_tree;
+
   float frame;
   int flag;
 } EffectorCache;
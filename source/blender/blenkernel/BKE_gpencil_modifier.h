@@ -69,6 +69,12 @@ typedef enum {
   eGpencilModifierTypeFlag_NoUserAdd = (1 << 5),
   /** Can't be applied. */
   eGpencilModifierTypeFlag_NoApply = (1 << 6),
+
+  /**
+   * #GpencilModifierTypeInfo.deformStroke can add or remove strokes of the frame, so the strokes
+   * of a frame have to be deformed one after the other. Otherwise they are deformed in parallel.
+   */
+  eGpencilModifierTypeFlag_SerialStrokes = (1 << 7),
 } GpencilModifierTypeFlag;
 
 typedef void (*GreasePencilIDWalkFunc)(void *userData,
@@ -344,6 +344,11 @@ void BKE_image_free_all_gputextures(struct Main *bmain);
  */
 void BKE_image_free_anim_gputextures(struct Main *bmain);
 void BKE_image_free_old_gputextures(struct Main *bmain);
+/**
+ * Free buffers of the least recently used images until the memory used by images is below
+ * #UserDef.image_memory_limit. Modified images are kept, others are reloaded when needed.
+ */
+void BKE_image_free_old_ibufs(struct Main *bmain);
 
 /**
  * Pack image to memory.
@@ -543,6 +548,27 @@ struct GPUTexture *BKE_image_get_gpu_tiles(struct Image *image,
 struct GPUTexture *BKE_image_get_gpu_tilemap(struct Image *image,
                                              struct ImageUser *iuser,
                                              struct ImBuf *ibuf);
+/**
+ * Load the image buffers of images that don't have a #GPUTexture yet on multiple threads, so
+ * that creating their textures afterwards only needs to upload them.
+ * `iusers` items can be NULL.
+ */
+void BKE_image_prefetch_gpu_textures(struct Image **images,
+                                     struct ImageUser **iusers,
+                                     int images_len);
+/**
+ * Same as #BKE_image_prefetch_gpu_textures but returns immediately, images are loaded by worker
+ * threads. While #BKE_image_is_loading_gpu_texture is true drawing should use a placeholder.
+ */
+void BKE_image_load_gpu_textures_async(struct Image **images,
+                                       struct ImageUser **iusers,
+                                       int images_len);
+bool BKE_image_is_loading_gpu_texture(struct Image *image);
+/**
+ * Wait for a background load of the image to finish, must be called before freeing it.
+ * The image cache mutex must not be locked by the caller.
+ */
+void BKE_image_load_gpu_textures_wait(struct Image *image);
 /**
  * Is the alpha of the `GPUTexture` for a given image/ibuf premultiplied.
  */
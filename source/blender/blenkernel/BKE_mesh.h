@@ -109,6 +109,21 @@ void BKE_mesh_looptri_get_real_edges(const struct Mesh *mesh,
  */
 void BKE_mesh_free_data_for_undo(struct Mesh *me);
 void BKE_mesh_clear_geometry(struct Mesh *me);
+/**
+ * Replace the geometry of the mesh with faces described by contiguous arrays. Edges are
+ * calculated from the faces. The mesh is not changed when the arrays are invalid.
+ *
+ * \param face_offsets: The index of the first corner of every face, followed by the total
+ * number of corners, so it has `faces_num + 1` values.
+ * \return An error message when the arrays are invalid, otherwise null.
+ */
+const char *BKE_mesh_assign_from_arrays(struct Mesh *mesh,
+                                        const float (*positions)[3],
+                                        int verts_num,
+                                        const int *face_offsets,
+                                        int faces_num,
+                                        const int *corner_verts,
+                                        int corners_num);
 struct Mesh *BKE_mesh_add(struct Main *bmain, const char *name);
 
 void BKE_mesh_free_editmesh(struct Mesh *mesh);
@@ -484,12 +499,6 @@ void BKE_mesh_calc_normals(struct Mesh *me);
  * Called after calculating all modifiers.
  */
 void BKE_mesh_ensure_normals_for_display(struct Mesh *mesh);
-void BKE_mesh_calc_normals_looptri(struct MVert *mverts,
-                                   int numVerts,
-                                   const struct MLoop *mloop,
-                                   const struct MLoopTri *looptri,
-                                   int looptri_num,
-                                   float (*r_tri_nors)[3]);
 void BKE_mesh_loop_manifold_fan_around_vert_next(const struct MLoop *mloops,
                                                  const struct MPoly *mpolys,
                                                  const int *loop_to_poly,
@@ -1047,9 +1056,24 @@ void BKE_mesh_eval_geometry(struct Depsgraph *depsgraph, struct Mesh *mesh);
 /* Draw Cache */
 void BKE_mesh_batch_cache_dirty_tag(struct Mesh *me, eMeshBatchDirtyMode mode);
 void BKE_mesh_batch_cache_free(struct Mesh *me);
+/**
+ * Take the batch cache out of an evaluated mesh which is about to be freed, so that it can be
+ * given to the next evaluated mesh of the same object with #BKE_mesh_batch_cache_attach.
+ * The draw manager keeps the buffers which are still valid when only the deformation changed.
+ * Only the topology of meshes with `check_topology` is compared, otherwise it is assumed to be
+ * unchanged. No GPU resources are touched, so this can be called from depsgraph evaluation.
+ */
+void *BKE_mesh_batch_cache_detach(struct Mesh *me, bool check_topology);
+/**
+ * Give a cache returned by #BKE_mesh_batch_cache_detach to a new evaluated mesh.
+ * When `me` is NULL the cache is freed.
+ */
+void BKE_mesh_batch_cache_attach(struct Mesh *me, void *batch_cache);
 
 extern void (*BKE_mesh_batch_cache_dirty_tag_cb)(struct Mesh *me, eMeshBatchDirtyMode mode);
 extern void (*BKE_mesh_batch_cache_free_cb)(struct Mesh *me);
+extern void *(*BKE_mesh_batch_cache_detach_cb)(struct Mesh *me, bool check_topology);
+extern void (*BKE_mesh_batch_cache_attach_cb)(struct Mesh *me, void *batch_cache);
 
 /* mesh_debug.c */
 #ifndef NDEBUG
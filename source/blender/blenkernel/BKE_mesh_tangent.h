@@ -10,6 +10,7 @@ extern "C" {
 #endif
 
 struct ReportList;
+struct SMikkTSpaceContext;
 
 /**
  * Compute simplified tangent space normals, i.e.
@@ -71,6 +72,14 @@ void BKE_mesh_add_loop_tangent_named_layer_for_uv(struct CustomData *uv_data,
                                                   struct CustomData *tan_data,
                                                   int numLoopData,
                                                   const char *layer_name);
+/**
+ * Mikktspace's optional `m_parallelRange` call-back, splits the per triangle and per group
+ * stages over the task scheduler. The tangents are the same as when computed on one thread.
+ */
+void BKE_mesh_tangent_mikk_parallel_range(const struct SMikkTSpaceContext *context,
+                                          int items_num,
+                                          void (*func)(void *data, int start, int end),
+                                          void *data);
 
 #define DM_TANGENT_MASK_ORCO (1 << 9)
 /**
@@ -120,6 +120,13 @@ bool BKE_movieclip_put_frame_if_possible(struct MovieClip *clip,
                                          struct MovieClipUser *user,
                                          struct ImBuf *ibuf);
 
+/**
+ * Read the frame of an image sequence clip into the movie cache, unless it is cached already.
+ * The file is read without holding #LOCK_MOVIECLIP, so that other threads can keep using the
+ * cache meanwhile. Frames of movie files are not prefetched, as decoding them requires the lock.
+ */
+void BKE_movieclip_prefetch_sequence_frame(struct MovieClip *clip, struct MovieClipUser *user);
+
 struct GPUTexture *BKE_movieclip_get_gpu_texture(struct MovieClip *clip,
                                                  struct MovieClipUser *cuser);
 
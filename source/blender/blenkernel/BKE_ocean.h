@@ -104,6 +104,14 @@ float BKE_ocean_jminus_to_foam(float jminus, float coverage);
  * Sampling the ocean surface.
  */
 void BKE_ocean_eval_uv(struct Ocean *oc, struct OceanResult *ocr, float u, float v);
+/**
+ * Sample only the displacement at many positions, locking the ocean once for all of them.
+ * This is much cheaper than #BKE_ocean_eval_uv when normals and foam are not needed.
+ */
+void BKE_ocean_eval_uv_displacement_array(struct Ocean *oc,
+                                          const float (*uv)[2],
+                                          float (*r_disp)[3],
+                                          int uv_num);
 /**
  * Use catmullrom interpolation rather than linear.
  */
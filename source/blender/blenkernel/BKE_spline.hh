@@ -690,4 +690,11 @@ std::unique_ptr<CurveEval> curve_eval_from_dna_curve(const Curve &curve,
                                                      const ListBase &nurbs_list);
 std::unique_ptr<CurveEval> curve_eval_from_dna_curve(const Curve &dna_curve);
 std::unique_ptr<CurveEval> curves_to_curve_eval(const Curves &curves);
+/**
+ * Like #curves_to_curve_eval, but the result is stored in the runtime data of the curves and
+ * reused until they are changed, so its evaluated data is only computed once for all users.
+ * It doesn't contain the radii or generic attributes, only the data needed to evaluate the
+ * points, tangents, normals and lengths of the curves.
+ */
+const CurveEval &curves_to_curve_eval_cached(const Curves &curves);
 Curves *curve_eval_to_curves(const CurveEval &curve_eval);
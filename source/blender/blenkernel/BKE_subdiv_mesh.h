@@ -16,6 +16,7 @@ extern "C" {
 struct Mesh;
 struct MEdge;
 struct Subdiv;
+struct SubdivMeshCache;
 
 typedef struct SubdivToMeshSettings {
   /* Resolution at which regular ptex (created for quad polygon) are being
@@ -34,6 +35,17 @@ struct Mesh *BKE_subdiv_to_mesh(struct Subdiv *subdiv,
                                 const SubdivToMeshSettings *settings,
                                 const struct Mesh *coarse_mesh);
 
+/* Same as #BKE_subdiv_to_mesh, but keeps the result in the given cache. When only the positions
+ * of the coarse vertices changed since the previous call, the cached mesh is copied and only
+ * the positions of its vertices are evaluated. The cache is created when needed, and freed when
+ * the result can not be cached. */
+struct Mesh *BKE_subdiv_to_mesh_cached(struct Subdiv *subdiv,
+                                       const SubdivToMeshSettings *settings,
+                                       const struct Mesh *coarse_mesh,
+                                       struct SubdivMeshCache **cache_p);
+
+void BKE_subdiv_mesh_cache_free(struct SubdivMeshCache *cache);
+
 /* Interpolate a position along the `coarse_edge` at the relative `u` coordinate. If `is_simple` is
  * false, this will perform a B-Spline interpolation using the edge neighbors, otherwise a linear
  * interpolation will be done base on the edge vertices. */
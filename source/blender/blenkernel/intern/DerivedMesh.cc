@@ -1616,6 +1616,7 @@ static void mesh_build_data(struct Depsgraph *depsgraph,
 
   Mesh *mesh_eval = nullptr, *mesh_deform_eval = nullptr;
   GeometrySet *geometry_set_eval = nullptr;
+  const eMEMCategory prev_mem_category = MEM_category_set(MEM_CATEGORY_MESH);
   mesh_calc_modifiers(depsgraph,
                       scene,
                       ob,
@@ -1628,6 +1629,7 @@ static void mesh_build_data(struct Depsgraph *depsgraph,
                       &mesh_deform_eval,
                       &mesh_eval,
                       &geometry_set_eval);
+  MEM_category_set(prev_mem_category);
 
   /* The modifier stack evaluation is storing result in mesh->runtime.mesh_eval, but this result
    * is not guaranteed to be owned by object.
@@ -1676,8 +1678,10 @@ static void editbmesh_build_data(struct Depsgraph *depsgraph,
   Mesh *me_final;
   GeometrySet *non_mesh_components;
 
+  const eMEMCategory prev_mem_category = MEM_category_set(MEM_CATEGORY_MESH);
   editbmesh_calc_modifiers(
       depsgraph, scene, obedit, em, dataMask, &me_cage, &me_final, &non_mesh_components);
+  MEM_category_set(prev_mem_category);
 
   /* The modifier stack result is expected to share edit mesh pointer with the input.
    * This is similar `mesh_calc_finalize()`. */
@@ -223,6 +223,7 @@ void BKE_animdata_free(ID *id, const bool do_id_user)
 
       /* free driver array cache */
       MEM_SAFE_FREE(adt->driver_array);
+      BKE_animsys_rna_path_cache_free(adt);
 
       /* free overrides */
       /* TODO... */
@@ -315,6 +316,7 @@ AnimData *BKE_animdata_copy(Main *bmain, AnimData *adt, const int flag)
   /* duplicate drivers (F-Curves) */
   BKE_fcurves_copy(&dadt->drivers, &adt->drivers);
   dadt->driver_array = NULL;
+  dadt->rna_path_cache = NULL;
 
   /* don't copy overrides */
   BLI_listbase_clear(&dadt->overrides);
@@ -1448,6 +1450,7 @@ void BKE_animdata_blend_read_data(BlendDataReader *reader, AnimData *adt)
   BLO_read_list(reader, &adt->drivers);
   BKE_fcurve_blend_read_data(reader, &adt->drivers);
   adt->driver_array = NULL;
+  adt->rna_path_cache = NULL;
 
   /* link overrides */
   /* TODO... */
@@ -16,10 +16,12 @@
 #include "BLI_alloca.h"
 #include "BLI_blenlib.h"
 #include "BLI_dynstr.h"
+#include "BLI_ghash.h"
 #include "BLI_listbase.h"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -409,6 +411,162 @@ bool BKE_animsys_rna_path_resolve(PointerRNA *ptr,
   return true;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name RNA Path Cache
+ *
+ * Resolving the RNA path of every F-Curve on every evaluation is expensive for rigs with many
+ * F-Curves, because the path has to be parsed and every step has to be looked up. The evaluated
+ * copies of IDs keep the resolved paths of their F-Curves and drivers instead. Only paths that
+ * resolve to data inside the ID itself are cached, so that changes of other IDs can't invalidate
+ * them.
+ *
+ * The cache is created when the evaluated copy is made, and it is invalidated when the ID is
+ * tagged for an update or when the dependency graph relations are rebuilt, because the data the
+ * paths point to may be reallocated then. When the F-Curves are reallocated, the path stored in
+ * the cache entry doesn't match anymore, so the entry is resolved again.
+ * \{ */
+
+typedef struct AnimRNAPathCacheEntry {
+  /** Copy of the path that was resolved, null when the entry is not resolved yet. */
+  char *rna_path;
+  int array_index;
+  bool is_valid;
+  PathResolvedRNA result;
+} AnimRNAPathCacheEntry;
+
+typedef struct AnimRNAPathCache {
+  /**
+   * Entries for F-Curves of the animation, keyed by the F-Curve. Only accessed by the animation
+   * evaluation of the ID, which runs in a single thread.
+   */
+  GHash *fcurve_entries;
+  /**
+   * Entries for the drivers, indexed like #AnimData.drivers. Drivers are evaluated in parallel,
+   * but each entry is only accessed by the evaluation of its driver.
+   */
+  AnimRNAPathCacheEntry *driver_entries;
+  int drivers_num;
+} AnimRNAPathCache;
+
+static void rna_path_cache_entry_free(void *entry_v)
+{
+  AnimRNAPathCacheEntry *entry = entry_v;
+  MEM_SAFE_FREE(entry->rna_path);
+  MEM_freeN(entry);
+}
+
+void BKE_animsys_rna_path_cache_ensure(ID *id)
+{
+  AnimData *adt = BKE_animdata_from_id(id);
+  if (adt == NULL || adt->rna_path_cache != NULL) {
+    return;
+  }
+  AnimRNAPathCache *cache = MEM_callocN(sizeof(AnimRNAPathCache), __func__);
+  cache->fcurve_entries = BLI_ghash_ptr_new(__func__);
+  cache->drivers_num = BLI_listbase_count(&adt->drivers);
+  if (cache->drivers_num > 0) {
+    cache->driver_entries = MEM_calloc_arrayN(
+        cache->drivers_num, sizeof(AnimRNAPathCacheEntry), __func__);
+  }
+  adt->rna_path_cache = cache;
+}
+
+void BKE_animsys_rna_path_cache_clear(ID *id)
+{
+  AnimData *adt = BKE_animdata_from_id(id);
+  if (adt == NULL || adt->rna_path_cache == NULL) {
+    return;
+  }
+  AnimRNAPathCache *cache = adt->rna_path_cache;
+  BLI_ghash_clear(cache->fcurve_entries, NULL, rna_path_cache_entry_free);
+  for (int i = 0; i < cache->drivers_num; i++) {
+    MEM_SAFE_FREE(cache->driver_entries[i].rna_path);
+  }
+}
+
+void BKE_animsys_rna_path_cache_free(AnimData *adt)
+{
+  AnimRNAPathCache *cache = adt->rna_path_cache;
+  if (cache == NULL) {
+    return;
+  }
+  BLI_ghash_free(cache->fcurve_entries, NULL, rna_path_cache_entry_free);
+  for (int i = 0; i < cache->drivers_num; i++) {
+    MEM_SAFE_FREE(cache->driver_entries[i].rna_path);
+  }
+  MEM_SAFE_FREE(cache->driver_entries);
+  MEM_freeN(cache);
+  adt->rna_path_cache = NULL;
+}
+
+/** Resolve the path of the F-Curve, using and updating the cache entry. */
+static bool rna_path_cache_entry_resolve(AnimRNAPathCacheEntry *entry,
+                                         PointerRNA *ptr,
+                                         const FCurve *fcu,
+                                         PathResolvedRNA *r_result)
+{
+  if (entry->rna_path != NULL && entry->array_index == fcu->array_index &&
+      STREQ(entry->rna_path, fcu->rna_path)) {
+    *r_result = entry->result;
+    return entry->is_valid;
+  }
+
+  MEM_SAFE_FREE(entry->rna_path);
+  const bool is_valid = BKE_animsys_rna_path_resolve(
+      ptr, fcu->rna_path, fcu->array_index, r_result);
+  if (fcu->rna_path != NULL && (!is_valid || r_result->ptr.owner_id == ptr->owner_id)) {
+    entry->rna_path = BLI_strdup(fcu->rna_path);
+    entry->array_index = fcu->array_index;
+    entry->is_valid = is_valid;
+    entry->result = *r_result;
+  }
+  return is_valid;
+}
+
+/** Get the cache of the ID, when the pointer is the ID itself. */
+static AnimRNAPathCache *rna_path_cache_for_ptr(const PointerRNA *ptr)
+{
+  if (ptr->owner_id == NULL || ptr->data != ptr->owner_id) {
+    return NULL;
+  }
+  const AnimData *adt = BKE_animdata_from_id(ptr->owner_id);
+  return adt ? adt->rna_path_cache : NULL;
+}
+
+/**
+ * Same as #BKE_animsys_rna_path_resolve for the path of an F-Curve of the animation of the ID
+ * that the pointer points to. Must only be called from the animation evaluation of that ID.
+ */
+static bool animsys_rna_path_resolve_fcurve(PointerRNA *ptr,
+                                            const FCurve *fcu,
+                                            PathResolvedRNA *r_result)
+{
+  AnimRNAPathCache *cache = rna_path_cache_for_ptr(ptr);
+  if (cache == NULL) {
+    return BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, r_result);
+  }
+  void **entry_p;
+  if (!BLI_ghash_ensure_p(cache->fcurve_entries, (void *)fcu, &entry_p)) {
+    *entry_p = MEM_callocN(sizeof(AnimRNAPathCacheEntry), __func__);
+  }
+  return rna_path_cache_entry_resolve(*entry_p, ptr, fcu, r_result);
+}
+
+/** Same as #animsys_rna_path_resolve_fcurve for a driver of the ID. */
+static bool animsys_rna_path_resolve_driver(PointerRNA *ptr,
+                                            const int driver_index,
+                                            const FCurve *fcu,
+                                            PathResolvedRNA *r_result)
+{
+  AnimRNAPathCache *cache = rna_path_cache_for_ptr(ptr);
+  if (cache == NULL || driver_index >= cache->drivers_num) {
+    return BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, r_result);
+  }
+  return rna_path_cache_entry_resolve(&cache->driver_entries[driver_index], ptr, fcu, r_result);
+}
+
+/** \} */
+
 /* less than 1.0 evaluates to false, use epsilon to avoid float error */
 #define ANIMSYS_FLOAT_AS_BOOL(value) ((value) > (1.0f - FLT_EPSILON))
 
@@ -579,6 +737,32 @@ static void animsys_write_orig_anim_rna(PointerRNA *ptr,
   }
 }
 
+/* Below this number of F-Curves the evaluation is not worth splitting over threads. */
+#define ANIMSYS_FCURVES_PARALLEL_THRESHOLD 256
+
+typedef struct FCurveEvalItem {
+  FCurve *fcu;
+  PathResolvedRNA anim_rna;
+  float value;
+} FCurveEvalItem;
+
+typedef struct FCurvesEvalData {
+  FCurveEvalItem *items;
+  const AnimationEvalContext *anim_eval_context;
+} FCurvesEvalData;
+
+static void animsys_evaluate_fcurve_task(void *__restrict userdata,
+                                         const int index,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  FCurvesEvalData *data = userdata;
+  FCurveEvalItem *item = &data->items[index];
+  /* Drivers may run Python expressions, they are evaluated in order when writing the values. */
+  if (item->fcu->driver == NULL) {
+    item->value = calculate_fcurve(&item->anim_rna, item->fcu, data->anim_eval_context);
+  }
+}
+
 /**
  * Evaluate all the F-Curves in the given list
  * This performs a set of standard checks. If extra checks are required,
@@ -589,22 +773,65 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
                                      const AnimationEvalContext *anim_eval_context,
                                      bool flush_to_original)
 {
-  /* Calculate then execute each curve. */
-  LISTBASE_FOREACH (FCurve *, fcu, list) {
+  const int fcurves_num = BLI_listbase_count_at_most(list, ANIMSYS_FCURVES_PARALLEL_THRESHOLD);
+
+  if (fcurves_num < ANIMSYS_FCURVES_PARALLEL_THRESHOLD) {
+    /* Calculate then execute each curve. */
+    LISTBASE_FOREACH (FCurve *, fcu, list) {
 
+      if (!is_fcurve_evaluatable(fcu)) {
+        continue;
+      }
+
+      PathResolvedRNA anim_rna;
+      if (animsys_rna_path_resolve_fcurve(ptr, fcu, &anim_rna)) {
+        const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
+        BKE_animsys_write_to_rna_path(&anim_rna, curval);
+        if (flush_to_original) {
+          animsys_write_orig_anim_rna(ptr, fcu->rna_path, fcu->array_index, curval);
+        }
+      }
+    }
+    return;
+  }
+
+  /* For large actions (rigs with many bones, crowds) evaluate the curves in parallel. Paths are
+   * resolved and values written in list order, so the result is the same as the loop above. */
+  FCurveEvalItem *items = MEM_malloc_arrayN(
+      BLI_listbase_count(list), sizeof(FCurveEvalItem), __func__);
+  int items_num = 0;
+  LISTBASE_FOREACH (FCurve *, fcu, list) {
     if (!is_fcurve_evaluatable(fcu)) {
       continue;
     }
+    FCurveEvalItem *item = &items[items_num];
+    if (animsys_rna_path_resolve_fcurve(ptr, fcu, &item->anim_rna)) {
+      item->fcu = fcu;
+      items_num++;
+    }
+  }
 
-    PathResolvedRNA anim_rna;
-    if (BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
-      const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
-      BKE_animsys_write_to_rna_path(&anim_rna, curval);
-      if (flush_to_original) {
-        animsys_write_orig_anim_rna(ptr, fcu->rna_path, fcu->array_index, curval);
-      }
+  FCurvesEvalData data = {
+      .items = items,
+      .anim_eval_context = anim_eval_context,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 64;
+  BLI_task_parallel_range(0, items_num, &data, animsys_evaluate_fcurve_task, &settings);
+
+  for (int i = 0; i < items_num; i++) {
+    FCurveEvalItem *item = &items[i];
+    if (item->fcu->driver != NULL) {
+      item->value = calculate_fcurve(&item->anim_rna, item->fcu, anim_eval_context);
+    }
+    BKE_animsys_write_to_rna_path(&item->anim_rna, item->value);
+    if (flush_to_original) {
+      animsys_write_orig_anim_rna(ptr, item->fcu->rna_path, item->fcu->array_index, item->value);
     }
   }
+
+  MEM_freeN(items);
 }
 
 /* This function assumes that the quaternion is fully keyed, and is stored in array index order. */
@@ -669,7 +896,7 @@ static void animsys_blend_in_fcurves(PointerRNA *ptr,
     }
 
     PathResolvedRNA anim_rna;
-    if (!BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+    if (!animsys_rna_path_resolve_fcurve(ptr, fcu, &anim_rna)) {
       continue;
     }
 
@@ -3481,7 +3708,7 @@ void BKE_animsys_eval_driver(Depsgraph *depsgraph, ID *id, int driver_index, FCu
       // printf("\told val = %f\n", fcu->curval);
 
       PathResolvedRNA anim_rna;
-      if (BKE_animsys_rna_path_resolve(&id_ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+      if (animsys_rna_path_resolve_driver(&id_ptr, driver_index, fcu, &anim_rna)) {
         /* Evaluate driver, and write results to COW-domain destination */
         const float ctime = DEG_get_ctime(depsgraph);
         const AnimationEvalContext anim_eval_context = BKE_animsys_eval_context_construct(
@@ -242,6 +242,18 @@ typedef struct ArmatureUserdata {
   bPoseChannel **pchan_from_defbase;
   int defbase_len;
 
+  /**
+   * Deform matrices of the bones used by the vertex groups, with #premat and #postmat already
+   * applied. Only set when all bones can be evaluated this way, see
+   * #armature_deform_mats_premultiplied_create.
+   */
+  float (*defbase_deform_mats)[4][4];
+  /**
+   * Dual quaternions of the bones used by the vertex groups, conjugated with #premat and
+   * #postmat, see #armature_deform_dquats_premultiplied_create.
+   */
+  DualQuat *defbase_deform_dquats;
+
   float premat[4][4];
   float postmat[4][4];
 
@@ -398,6 +410,122 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
   }
 }
 
+/**
+ * Linear blending of vertex groups using #ArmatureUserdata.defbase_deform_mats, which avoids
+ * transforming every vertex to armature space and back.
+ * Vertices which need the armature space coordinate fall back to the generic code path.
+ */
+static void armature_vert_task_premultiplied(const ArmatureUserdata *data,
+                                             const int i,
+                                             const MDeformVert *dvert)
+{
+  if (dvert == NULL || dvert->totweight == 0) {
+    armature_vert_task_with_dvert(data, i, dvert);
+    return;
+  }
+
+  float armature_weight = 1.0f;
+  if (data->armature_def_nr != -1) {
+    armature_weight = BKE_defvert_find_weight(dvert, data->armature_def_nr);
+    if (data->invert_vgroup) {
+      armature_weight = 1.0f - armature_weight;
+    }
+    if (armature_weight == 0.0f) {
+      return;
+    }
+  }
+
+  float *co = data->vert_coords[i];
+  float vec[3] = {0.0f, 0.0f, 0.0f};
+  float contrib = 0.0f;
+  bool deformed = false;
+  const MDeformWeight *dw = dvert->dw;
+  for (uint j = dvert->totweight; j != 0; j--, dw++) {
+    const uint index = dw->def_nr;
+    if (index < data->defbase_len && data->pchan_from_defbase[index]) {
+      deformed = true;
+      if (dw->weight != 0.0f) {
+        pchan_deform_accumulate(
+            NULL, data->defbase_deform_mats[index], co, dw->weight, vec, NULL, NULL);
+        contrib += dw->weight;
+      }
+    }
+  }
+
+  if (!deformed && data->use_envelope) {
+    /* Envelopes are evaluated in armature space. */
+    armature_vert_task_with_dvert(data, i, dvert);
+    return;
+  }
+
+  if (contrib > 0.0001f) {
+    madd_v3_v3fl(co, vec, armature_weight / contrib);
+  }
+}
+
+/**
+ * Dual quaternion blending of vertex groups using #ArmatureUserdata.defbase_deform_dquats,
+ * the equivalent of #armature_vert_task_premultiplied for #ARM_DEF_QUATERNION.
+ */
+static void armature_vert_task_dual_quat_premultiplied(const ArmatureUserdata *data,
+                                                       const int i,
+                                                       const MDeformVert *dvert)
+{
+  if (dvert == NULL || dvert->totweight == 0) {
+    armature_vert_task_with_dvert(data, i, dvert);
+    return;
+  }
+
+  float armature_weight = 1.0f;
+  if (data->armature_def_nr != -1) {
+    armature_weight = BKE_defvert_find_weight(dvert, data->armature_def_nr);
+    if (data->invert_vgroup) {
+      armature_weight = 1.0f - armature_weight;
+    }
+    if (armature_weight == 0.0f) {
+      return;
+    }
+  }
+
+  DualQuat sumdq;
+  memset(&sumdq, 0, sizeof(DualQuat));
+  float contrib = 0.0f;
+  bool deformed = false;
+  const MDeformWeight *dw = dvert->dw;
+  for (uint j = dvert->totweight; j != 0; j--, dw++) {
+    const uint index = dw->def_nr;
+    if (index < data->defbase_len && data->pchan_from_defbase[index]) {
+      deformed = true;
+      if (dw->weight != 0.0f) {
+        add_weighted_dq_dq(&sumdq, &data->defbase_deform_dquats[index], dw->weight);
+        contrib += dw->weight;
+      }
+    }
+  }
+
+  if (!deformed && data->use_envelope) {
+    /* Envelopes are evaluated in armature space. */
+    armature_vert_task_with_dvert(data, i, dvert);
+    return;
+  }
+
+  if (contrib > 0.0001f) {
+    float *co = data->vert_coords[i];
+    normalize_dq(&sumdq, contrib);
+
+    if (armature_weight != 1.0f) {
+      float dco[3];
+      copy_v3_v3(dco, co);
+      mul_v3m3_dq(dco, NULL, &sumdq);
+      sub_v3_v3(dco, co);
+      madd_v3_v3fl(co, dco, armature_weight);
+    }
+    else {
+      mul_v3m3_dq(co, NULL, &sumdq);
+    }
+  }
+}
+
 static void armature_vert_task(void *__restrict userdata,
                                const int i,
                                const TaskParallelTLS *__restrict UNUSED(tls))
@@ -425,7 +553,15 @@ static void armature_vert_task(void *__restrict userdata,
     dvert = NULL;
   }
 
-  armature_vert_task_with_dvert(data, i, dvert);
+  if (data->defbase_deform_mats) {
+    armature_vert_task_premultiplied(data, i, dvert);
+  }
+  else if (data->defbase_deform_dquats) {
+    armature_vert_task_dual_quat_premultiplied(data, i, dvert);
+  }
+  else {
+    armature_vert_task_with_dvert(data, i, dvert);
+  }
 }
 
 static void armature_vert_task_editmesh(void *__restrict userdata,
@@ -447,6 +583,78 @@ static void armature_vert_task_editmesh_no_dvert(void *__restrict userdata,
   armature_vert_task_with_dvert(data, BM_elem_index_get(v), NULL);
 }
 
+/**
+ * For linear blending the transform from the target object to armature space and back can be
+ * combined with the deform matrix of every bone, instead of being applied to every vertex.
+ * This is only possible when no bone needs the vertex position in armature space, which is the
+ * case for B-Bones and bones multiplying the vertex group weight with their envelope.
+ */
+static float (*armature_deform_mats_premultiplied_create(const ArmatureUserdata *data))[4][4]
+{
+  if (data->use_quaternion || data->vert_deform_mats || data->vert_coords_prev ||
+      !data->use_dverts) {
+    return NULL;
+  }
+
+  float(*defbase_deform_mats)[4][4] = MEM_malloc_arrayN(
+      (size_t)data->defbase_len, sizeof(*defbase_deform_mats), __func__);
+  for (int i = 0; i < data->defbase_len; i++) {
+    const bPoseChannel *pchan = data->pchan_from_defbase[i];
+    if (pchan == NULL) {
+      continue;
+    }
+    const Bone *bone = pchan->bone;
+    if ((bone->flag & BONE_MULT_VG_ENV) ||
+        (bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments)) {
+      MEM_freeN(defbase_deform_mats);
+      return NULL;
+    }
+    mul_m4_series(defbase_deform_mats[i], data->postmat, pchan->chan_mat, data->premat);
+  }
+  return defbase_deform_mats;
+}
+
+/**
+ * Dual quaternion skinning can't combine the transforms into matrices, but when the target object
+ * is in the same space as the armature up to a rigid transform, the bone dual quaternions can be
+ * conjugated with that transform instead. Blending is linear in the dual quaternion components
+ * and the conjugation preserves their length, so the result is the same as blending in armature
+ * space. The same bone types as for #armature_deform_mats_premultiplied_create are excluded.
+ */
+static DualQuat *armature_deform_dquats_premultiplied_create(const ArmatureUserdata *data)
+{
+  if (!data->use_quaternion || data->vert_deform_mats || data->vert_coords_prev ||
+      !data->use_dverts) {
+    return NULL;
+  }
+
+  float premat3[3][3];
+  copy_m3_m4(premat3, data->premat);
+  if (!is_orthonormal_m3(premat3) || determinant_m3_array(premat3) < 0.0f) {
+    return NULL;
+  }
+
+  DualQuat *defbase_deform_dquats = MEM_malloc_arrayN(
+      (size_t)data->defbase_len, sizeof(*defbase_deform_dquats), __func__);
+  for (int i = 0; i < data->defbase_len; i++) {
+    const bPoseChannel *pchan = data->pchan_from_defbase[i];
+    if (pchan == NULL) {
+      continue;
+    }
+    const Bone *bone = pchan->bone;
+    if ((bone->flag & BONE_MULT_VG_ENV) ||
+        (bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments)) {
+      MEM_freeN(defbase_deform_dquats);
+      return NULL;
+    }
+    float basemat[4][4], deform_mat[4][4];
+    mul_m4_m4m4(basemat, data->postmat, bone->arm_mat);
+    mul_m4_series(deform_mat, data->postmat, pchan->chan_mat, data->premat);
+    mat4_to_dquat(&defbase_deform_dquats[i], basemat, deform_mat);
+  }
+  return defbase_deform_dquats;
+}
+
 static void armature_deform_coords_impl(const Object *ob_arm,
                                         const Object *ob_target,
                                         float (*vert_coords)[3],
@@ -593,10 +801,16 @@ static void armature_deform_coords_impl(const Object *ob_arm,
     }
   }
   else {
+    data.defbase_deform_mats = armature_deform_mats_premultiplied_create(&data);
+    data.defbase_deform_dquats = armature_deform_dquats_premultiplied_create(&data);
+
     TaskParallelSettings settings;
     BLI_parallel_range_settings_defaults(&settings);
     settings.min_iter_per_thread = 32;
     BLI_task_parallel_range(0, vert_coords_len, &data, armature_vert_task, &settings);
+
+    MEM_SAFE_FREE(data.defbase_deform_mats);
+    MEM_SAFE_FREE(data.defbase_deform_dquats);
   }
 
   if (pchan_from_defbase) {
@@ -347,15 +347,22 @@ std::unique_ptr<CurveEval> curve_eval_from_dna_curve(const Curve &dna_curve)
   return curve_eval_from_dna_curve(dna_curve, *BKE_curve_nurbs_get_for_read(&dna_curve));
 }
 
+/**
+ * \param only: When not empty, only attributes with these names are copied.
+ */
 static void copy_attributes_between_components(const GeometryComponent &src_component,
                                                GeometryComponent &dst_component,
-                                               Span<std::string> skip)
+                                               Span<std::string> skip,
+                                               Span<std::string> only = {})
 {
   src_component.attribute_foreach(
       [&](const AttributeIDRef &id, const AttributeMetaData meta_data) {
         if (id.is_named() && skip.contains(id.name())) {
           return true;
         }
+        if (!only.is_empty() && !(id.is_named() && only.contains(id.name()))) {
+          return true;
+        }
 
         GVArray src_attribute = src_component.attribute_try_get_for_read(
             id, meta_data.domain, meta_data.data_type);
@@ -375,7 +382,8 @@ static void copy_attributes_between_components(const GeometryComponent &src_comp
       });
 }
 
-std::unique_ptr<CurveEval> curves_to_curve_eval(const Curves &curves)
+static std::unique_ptr<CurveEval> curves_to_curve_eval(const Curves &curves,
+                                                       const bool only_evaluation_data)
 {
   CurveComponent src_component;
   src_component.replace(&const_cast<Curves &>(curves), GeometryOwnershipType::ReadOnly);
@@ -442,6 +450,10 @@ std::unique_ptr<CurveEval> curves_to_curve_eval(const Curves &curves)
   CurveComponentLegacy dst_component;
   dst_component.replace(curve_eval.get(), GeometryOwnershipType::Editable);
 
+  /* The remaining attributes that affect the evaluated points and their normals. */
+  static const Vector<std::string> evaluation_attributes = {
+      "position", "handle_left", "handle_right", "tilt", "resolution", "cyclic"};
+
   copy_attributes_between_components(src_component,
                                      dst_component,
                                      {"curve_type",
@@ -449,11 +461,30 @@ std::unique_ptr<CurveEval> curves_to_curve_eval(const Curves &curves)
                                       "nurbs_order",
                                       "knots_mode",
                                       "handle_type_right",
-                                      "handle_type_left"});
+                                      "handle_type_left"},
+                                     only_evaluation_data ? evaluation_attributes.as_span() :
+                                                            Span<std::string>());
 
   return curve_eval;
 }
 
+std::unique_ptr<CurveEval> curves_to_curve_eval(const Curves &curves)
+{
+  return curves_to_curve_eval(curves, false);
+}
+
+const CurveEval &curves_to_curve_eval_cached(const Curves &curves)
+{
+  const blender::bke::CurvesGeometry &geometry = blender::bke::CurvesGeometry::wrap(
+      curves.geometry);
+  const blender::bke::CurvesGeometryRuntime &runtime = *geometry.runtime;
+  std::lock_guard lock{runtime.curve_eval_cache_mutex};
+  if (!runtime.curve_eval_cache) {
+    runtime.curve_eval_cache = curves_to_curve_eval(curves, true);
+  }
+  return *runtime.curve_eval_cache;
+}
+
 Curves *curve_eval_to_curves(const CurveEval &curve_eval)
 {
   Curves *curves = blender::bke::curves_new_nomain(curve_eval.total_control_point_size(),
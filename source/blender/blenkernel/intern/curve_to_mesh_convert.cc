@@ -288,23 +288,39 @@ static ResultOffsets calculate_result_offsets(Span<SplinePtr> profiles,
   Array<int> loop(total + 1);
   Array<int> poly(total + 1);
 
-  int mesh_index = 0;
+  /* Retrieving the evaluated sizes can require evaluating the splines, so compute the sizes of all
+   * combinations in parallel first, and accumulate them into offsets afterwards. */
+  threading::parallel_for(curves.index_range(), 512, [&](IndexRange curves_range) {
+    for (const int i_spline : curves_range) {
+      const Spline &spline = *curves[i_spline];
+      for (const int i_profile : profiles.index_range()) {
+        const Spline &profile = *profiles[i_profile];
+        const int i_mesh = i_spline * profiles.size() + i_profile;
+        vert[i_mesh] = spline_extrude_vert_size(spline, profile);
+        edge[i_mesh] = spline_extrude_edge_size(spline, profile);
+        loop[i_mesh] = spline_extrude_loop_size(spline, profile, fill_caps);
+        poly[i_mesh] = spline_extrude_poly_size(spline, profile, fill_caps);
+      }
+    }
+  });
+
   int vert_offset = 0;
   int edge_offset = 0;
   int loop_offset = 0;
   int poly_offset = 0;
-  for (const int i_spline : curves.index_range()) {
-    for (const int i_profile : profiles.index_range()) {
-      vert[mesh_index] = vert_offset;
-      edge[mesh_index] = edge_offset;
-      loop[mesh_index] = loop_offset;
-      poly[mesh_index] = poly_offset;
-      vert_offset += spline_extrude_vert_size(*curves[i_spline], *profiles[i_profile]);
-      edge_offset += spline_extrude_edge_size(*curves[i_spline], *profiles[i_profile]);
-      loop_offset += spline_extrude_loop_size(*curves[i_spline], *profiles[i_profile], fill_caps);
-      poly_offset += spline_extrude_poly_size(*curves[i_spline], *profiles[i_profile], fill_caps);
-      mesh_index++;
-    }
+  for (const int i_mesh : IndexRange(total)) {
+    const int vert_size = vert[i_mesh];
+    const int edge_size = edge[i_mesh];
+    const int loop_size = loop[i_mesh];
+    const int poly_size = poly[i_mesh];
+    vert[i_mesh] = vert_offset;
+    edge[i_mesh] = edge_offset;
+    loop[i_mesh] = loop_offset;
+    poly[i_mesh] = poly_offset;
+    vert_offset += vert_size;
+    edge_offset += edge_size;
+    loop_offset += loop_size;
+    poly_offset += poly_size;
   }
   vert.last() = vert_offset;
   edge.last() = edge_offset;
@@ -381,6 +397,14 @@ struct ResultAttributes {
   Vector<std::optional<ResultAttributeData>> profile_point_attributes;
   Vector<std::optional<ResultAttributeData>> profile_spline_attributes;
 
+  /**
+   * The IDs of the point attributes on the curve and profile inputs, in the same order as
+   * #curve_point_attributes and #profile_point_attributes, so that the attributes don't have to
+   * be iterated over again for every spline.
+   */
+  Vector<AttributeIDRef> curve_point_ids;
+  Vector<AttributeIDRef> profile_point_ids;
+
   /**
    * Because some builtin attributes are not stored contiguously, and the curve inputs might have
    * attributes with those names, it's necessary to keep OutputAttributes around to give access to
@@ -401,6 +425,7 @@ static ResultAttributes create_result_attributes(const CurveEval &curve,
   curve.splines().first()->attributes.foreach_attribute(
       [&](const AttributeIDRef &id, const AttributeMetaData &meta_data) {
         curve_attributes.add_new(id);
+        result.curve_point_ids.append(id);
         result.curve_point_attributes.append(
             create_attribute_and_get_span(mesh_component, id, meta_data, result.attributes));
         return true;
@@ -416,6 +441,7 @@ static ResultAttributes create_result_attributes(const CurveEval &curve,
       ATTR_DOMAIN_CURVE);
   profile.splines().first()->attributes.foreach_attribute(
       [&](const AttributeIDRef &id, const AttributeMetaData &meta_data) {
+        result.profile_point_ids.append(id);
         if (curve_attributes.contains(id)) {
           result.profile_point_attributes.append({});
         }
@@ -476,14 +502,11 @@ static void copy_curve_point_data_to_mesh_faces(const Span<T> src,
   }
 }
 
-static void copy_curve_point_attribute_to_mesh(const GSpan src,
+static void copy_curve_point_attribute_to_mesh(const GSpan interpolated,
                                                const ResultInfo &info,
                                                ResultAttributeData &dst)
 {
-  GVArray interpolated_gvarray = info.spline.interpolate_to_evaluated(src);
-  GSpan interpolated = interpolated_gvarray.get_internal_span();
-
-  attribute_math::convert_to_static_type(src.type(), [&](auto dummy) {
+  attribute_math::convert_to_static_type(interpolated.type(), [&](auto dummy) {
     using T = decltype(dummy);
     switch (dst.domain) {
       case ATTR_DOMAIN_POINT:
@@ -542,14 +565,11 @@ static void copy_profile_point_data_to_mesh_faces(const Span<T> src,
   }
 }
 
-static void copy_profile_point_attribute_to_mesh(const GSpan src,
+static void copy_profile_point_attribute_to_mesh(const GSpan interpolated,
                                                  const ResultInfo &info,
                                                  ResultAttributeData &dst)
 {
-  GVArray interpolated_gvarray = info.profile.interpolate_to_evaluated(src);
-  GSpan interpolated = interpolated_gvarray.get_internal_span();
-
-  attribute_math::convert_to_static_type(src.type(), [&](auto dummy) {
+  attribute_math::convert_to_static_type(interpolated.type(), [&](auto dummy) {
     using T = decltype(dummy);
     switch (dst.domain) {
       case ATTR_DOMAIN_POINT:
@@ -571,36 +591,42 @@ static void copy_profile_point_attribute_to_mesh(const GSpan src,
   });
 }
 
+/**
+ * Interpolate the point attributes of a spline that are copied to the result to its evaluated
+ * points. The result is empty for attributes that aren't copied.
+ */
+static Vector<GVArray> interpolate_point_attributes(
+    const Spline &spline,
+    Span<AttributeIDRef> ids,
+    Span<std::optional<ResultAttributeData>> result_attributes)
+{
+  Vector<GVArray> interpolated(ids.size());
+  for (const int i : ids.index_range()) {
+    if (result_attributes[i]) {
+      interpolated[i] = spline.interpolate_to_evaluated(*spline.attributes.get_for_read(ids[i]));
+    }
+  }
+  return interpolated;
+}
+
 static void copy_point_domain_attributes_to_mesh(const ResultInfo &info,
+                                                 Span<GVArray> curve_point_attributes,
+                                                 Span<GVArray> profile_point_attributes,
                                                  ResultAttributes &attributes)
 {
-  if (!attributes.curve_point_attributes.is_empty()) {
-    int i = 0;
-    info.spline.attributes.foreach_attribute(
-        [&](const AttributeIDRef &id, const AttributeMetaData &UNUSED(meta_data)) {
-          if (attributes.curve_point_attributes[i]) {
-            copy_curve_point_attribute_to_mesh(*info.spline.attributes.get_for_read(id),
-                                               info,
-                                               *attributes.curve_point_attributes[i]);
-          }
-          i++;
-          return true;
-        },
-        ATTR_DOMAIN_POINT);
+  for (const int i : attributes.curve_point_attributes.index_range()) {
+    if (attributes.curve_point_attributes[i]) {
+      copy_curve_point_attribute_to_mesh(curve_point_attributes[i].get_internal_span(),
+                                         info,
+                                         *attributes.curve_point_attributes[i]);
+    }
   }
-  if (!attributes.profile_point_attributes.is_empty()) {
-    int i = 0;
-    info.profile.attributes.foreach_attribute(
-        [&](const AttributeIDRef &id, const AttributeMetaData &UNUSED(meta_data)) {
-          if (attributes.profile_point_attributes[i]) {
-            copy_profile_point_attribute_to_mesh(*info.profile.attributes.get_for_read(id),
-                                                 info,
-                                                 *attributes.profile_point_attributes[i]);
-          }
-          i++;
-          return true;
-        },
-        ATTR_DOMAIN_POINT);
+  for (const int i : attributes.profile_point_attributes.index_range()) {
+    if (attributes.profile_point_attributes[i]) {
+      copy_profile_point_attribute_to_mesh(profile_point_attributes[i].get_internal_span(),
+                                           info,
+                                           *attributes.profile_point_attributes[i]);
+    }
   }
 }
 
@@ -701,12 +727,24 @@ Mesh *curve_to_mesh_sweep(const CurveEval &curve, const CurveEval &profile, cons
   mesh_component.replace(mesh, GeometryOwnershipType::Editable);
   ResultAttributes attributes = create_result_attributes(curve, profile, mesh_component);
 
+  /* The evaluated profile attributes are the same for every curve spline, so they are only
+   * interpolated once rather than for every combination. */
+  Array<Vector<GVArray>> profile_point_attributes(profiles.size());
+  threading::parallel_for(profiles.index_range(), 128, [&](IndexRange profiles_range) {
+    for (const int i_profile : profiles_range) {
+      profile_point_attributes[i_profile] = interpolate_point_attributes(
+          *profiles[i_profile], attributes.profile_point_ids, attributes.profile_point_attributes);
+    }
+  });
+
   threading::parallel_for(curves.index_range(), 128, [&](IndexRange curves_range) {
     for (const int i_spline : curves_range) {
       const Spline &spline = *curves[i_spline];
       if (spline.evaluated_points_size() == 0) {
         continue;
       }
+      const Vector<GVArray> spline_point_attributes = interpolate_point_attributes(
+          spline, attributes.curve_point_ids, attributes.curve_point_attributes);
       const int spline_start_index = i_spline * profiles.size();
       threading::parallel_for(profiles.index_range(), 128, [&](IndexRange profiles_range) {
         for (const int i_profile : profiles_range) {
@@ -732,7 +770,8 @@ Mesh *curve_to_mesh_sweep(const CurveEval &curve, const CurveEval &profile, cons
                                       {mesh->mloop, mesh->totloop},
                                       {mesh->mpoly, mesh->totpoly});
 
-          copy_point_domain_attributes_to_mesh(info, attributes);
+          copy_point_domain_attributes_to_mesh(
+              info, spline_point_attributes, profile_point_attributes[i_profile], attributes);
         }
       });
     }
@@ -12,6 +12,7 @@
 
 #include "BKE_attribute_math.hh"
 #include "BKE_curves.hh"
+#include "BKE_spline.hh"
 
 namespace blender::bke {
 
@@ -24,6 +25,17 @@ static const std::string ATTR_CYCLIC = "cyclic";
 /** \name Constructors/Destructor
  * \{ */
 
+CurvesGeometryRuntime::~CurvesGeometryRuntime() = default;
+
+/**
+ * The cached legacy curve isn't updated when the curves are changed, so it is freed before any
+ * mutable access. There can't be other users at that point, so this doesn't need the lock.
+ */
+static void clear_curve_eval_cache(const CurvesGeometry &curves)
+{
+  curves.runtime->curve_eval_cache.reset();
+}
+
 CurvesGeometry::CurvesGeometry() : CurvesGeometry(0, 0)
 {
 }
@@ -101,6 +113,7 @@ static void move_curves_geometry(CurvesGeometry &dst, CurvesGeometry &src)
   MEM_SAFE_FREE(src.curve_offsets);
 
   std::swap(dst.runtime, src.runtime);
+  clear_curve_eval_cache(src);
 
   src.update_customdata_pointers();
   dst.update_customdata_pointers();
@@ -217,6 +230,7 @@ static MutableSpan<T> get_mutable_attribute(CurvesGeometry &curves,
   const int size = domain_size(curves, domain);
   const CustomDataType type = cpp_type_to_custom_data_type(CPPType::get<T>());
   CustomData &custom_data = domain_custom_data(curves, domain);
+  clear_curve_eval_cache(curves);
 
   T *data = (T *)CustomData_duplicate_referenced_layer_named(
       &custom_data, type, name.c_str(), size);
@@ -241,6 +255,7 @@ MutableSpan<int8_t> CurvesGeometry::curve_types()
 
 MutableSpan<float3> CurvesGeometry::positions()
 {
+  clear_curve_eval_cache(*this);
   this->position = (float(*)[3])CustomData_duplicate_referenced_layer_named(
       &this->point_data, CD_PROP_FLOAT3, ATTR_POSITION.c_str(), this->point_size);
   return {(float3 *)this->position, this->point_size};
@@ -252,6 +267,7 @@ Span<float3> CurvesGeometry::positions() const
 
 MutableSpan<int> CurvesGeometry::offsets()
 {
+  clear_curve_eval_cache(*this);
   return {this->curve_offsets, this->curve_size + 1};
 }
 Span<int> CurvesGeometry::offsets() const
@@ -289,16 +305,19 @@ void CurvesGeometry::tag_positions_changed()
   this->runtime->position_cache_dirty = true;
   this->runtime->tangent_cache_dirty = true;
   this->runtime->normal_cache_dirty = true;
+  clear_curve_eval_cache(*this);
 }
 void CurvesGeometry::tag_topology_changed()
 {
   this->runtime->position_cache_dirty = true;
   this->runtime->tangent_cache_dirty = true;
   this->runtime->normal_cache_dirty = true;
+  clear_curve_eval_cache(*this);
 }
 void CurvesGeometry::tag_normals_changed()
 {
   this->runtime->normal_cache_dirty = true;
+  clear_curve_eval_cache(*this);
 }
 
 void CurvesGeometry::translate(const float3 &translation)
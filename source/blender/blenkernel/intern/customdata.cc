@@ -25,7 +25,9 @@
 #include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #ifndef NDEBUG
 #  include "BLI_dynstr.h"
@@ -2088,6 +2090,38 @@ static bool customdata_typemap_is_valid(const CustomData *data)
 }
 #endif
 
+/** Copy of the data of a layer, deferred so that all layers can be copied in parallel. */
+struct CustomDataLayerCopy {
+  const void *src;
+  void *dst;
+  int type;
+};
+
+/* Layers with at least this many bytes are copied in chunks on multiple threads. */
+#define CUSTOMDATA_COPY_PARALLEL_BYTES (1 << 20)
+
+static void customdata_layer_copies_apply(const blender::Span<CustomDataLayerCopy> copies,
+                                          const int totelem)
+{
+  using namespace blender;
+  threading::parallel_for(copies.index_range(), 1, [&](const IndexRange range) {
+    for (const CustomDataLayerCopy &copy : copies.slice(range)) {
+      const LayerTypeInfo *typeInfo = layerType_getInfo(copy.type);
+      if (typeInfo->copy) {
+        typeInfo->copy(copy.src, copy.dst, totelem);
+        continue;
+      }
+      const int64_t size = int64_t(typeInfo->size);
+      const int64_t grain_size = std::max<int64_t>(CUSTOMDATA_COPY_PARALLEL_BYTES / size, 1);
+      threading::parallel_for(IndexRange(totelem), grain_size, [&](const IndexRange sub_range) {
+        memcpy(POINTER_OFFSET(copy.dst, sub_range.start() * size),
+               POINTER_OFFSET(copy.src, sub_range.start() * size),
+               size_t(sub_range.size() * size));
+      });
+    }
+  });
+}
+
 bool CustomData_merge(const struct CustomData *source,
                       struct CustomData *dest,
                       CustomDataMask mask,
@@ -2099,6 +2133,8 @@ bool CustomData_merge(const struct CustomData *source,
   int lasttype = -1, lastactive = 0, lastrender = 0, lastclone = 0, lastmask = 0;
   int number = 0, maxnumber = -1;
   bool changed = false;
+  /* Duplicated layers are allocated here and filled at the end, all at once. */
+  blender::Vector<CustomDataLayerCopy, 16> layer_copies;
 
   for (int i = 0; i < source->totlayer; i++) {
     layer = &source->layers[i];
@@ -2149,6 +2185,20 @@ bool CustomData_merge(const struct CustomData *source,
       newlayer = customData_add_layer__internal(
           dest, type, CD_REFERENCE, data, totelem, layer->name);
     }
+    else if (alloctype == CD_DUPLICATE && data != nullptr && totelem > 0 &&
+             layerType_getInfo(type)->size > 0) {
+      void *copy_data = MEM_malloc_arrayN(
+          size_t(totelem), size_t(layerType_getInfo(type)->size), layerType_getName(type));
+      newlayer = customData_add_layer__internal(
+          dest, type, CD_ASSIGN, copy_data, totelem, layer->name);
+      if (newlayer && newlayer->data == copy_data) {
+        layer_copies.append({data, copy_data, type});
+      }
+      else {
+        /* The layer already existed or could not be added. */
+        MEM_freeN(copy_data);
+      }
+    }
     else {
       newlayer = customData_add_layer__internal(dest, type, alloctype, data, totelem, layer->name);
     }
@@ -2170,6 +2220,8 @@ bool CustomData_merge(const struct CustomData *source,
     }
   }
 
+  customdata_layer_copies_apply(layer_copies, totelem);
+
   CustomData_update_typemap(dest);
   return changed;
 }
@@ -2888,6 +2940,38 @@ void CustomData_duplicate_referenced_layers(CustomData *data, int totelem)
   }
 }
 
+void CustomData_duplicate_referenced_layers_reuse(CustomData *data,
+                                                  CustomData *old_data,
+                                                  const int totelem)
+{
+  for (int i = 0; i < data->totlayer; i++) {
+    CustomDataLayer *layer = &data->layers[i];
+    if ((layer->flag & CD_FLAG_NOFREE) == 0) {
+      continue;
+    }
+    const LayerTypeInfo *typeInfo = layerType_getInfo(layer->type);
+    if (typeInfo->copy == nullptr && typeInfo->free == nullptr) {
+      const int old_layer_index = CustomData_get_named_layer_index(
+          old_data, layer->type, layer->name);
+      if (old_layer_index != -1) {
+        CustomDataLayer *old_layer = &old_data->layers[old_layer_index];
+        if (old_layer->data != nullptr && (old_layer->flag & CD_FLAG_NOFREE) == 0 &&
+            old_layer->anonymous_id == layer->anonymous_id) {
+          const size_t size = (size_t)totelem * (size_t)typeInfo->size;
+          if (memcmp(old_layer->data, layer->data, size) != 0) {
+            memcpy(old_layer->data, layer->data, size);
+          }
+          layer->data = old_layer->data;
+          layer->flag &= ~CD_FLAG_NOFREE;
+          old_layer->data = nullptr;
+          continue;
+        }
+      }
+    }
+    layer->data = customData_duplicate_referenced_layer_index(data, i, totelem);
+  }
+}
+
 bool CustomData_is_referenced_layer(struct CustomData *data, int type)
 {
   /* get the layer index of the first layer of type */
@@ -3681,7 +3765,7 @@ void CustomData_bmesh_free_block_data(CustomData *data, void *block)
   }
 }
 
-static void CustomData_bmesh_alloc_block(CustomData *data, void **block)
+void CustomData_bmesh_alloc_block(CustomData *data, void **block)
 {
   if (*block) {
     CustomData_bmesh_free_block(data, block);
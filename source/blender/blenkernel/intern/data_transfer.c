@@ -1322,6 +1322,154 @@ void BKE_object_data_transfer_layout(struct Depsgraph *depsgraph,
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Geometry Mapping Cache
+ * \{ */
+
+/**
+ * Everything a cached mapping was computed from, stored as plain bytes so that it can be
+ * compared exactly.
+ */
+typedef struct DataTransferRemapKey {
+  uchar *data;
+  size_t len;
+  size_t len_alloc;
+} DataTransferRemapKey;
+
+typedef struct DataTransferRemapCache {
+  /* Vertex, edge, loop and poly mappings, in that order. */
+  MeshPairRemap geom_map[4];
+  /* Input of each mapping, see #data_transfer_remap_cache_test. */
+  DataTransferRemapKey geom_map_key[4];
+  bool geom_map_valid[4];
+  /* Reused to build the key of the current input, to avoid allocating it on every update. */
+  DataTransferRemapKey key_scratch;
+} DataTransferRemapCache;
+
+DataTransferRemapCache *BKE_object_data_transfer_remap_cache_create(void)
+{
+  return MEM_callocN(sizeof(DataTransferRemapCache), __func__);
+}
+
+void BKE_object_data_transfer_remap_cache_free(DataTransferRemapCache *remap_cache)
+{
+  for (int i = 0; i < ARRAY_SIZE(remap_cache->geom_map); i++) {
+    BKE_mesh_remap_free(&remap_cache->geom_map[i]);
+    MEM_SAFE_FREE(remap_cache->geom_map_key[i].data);
+  }
+  MEM_SAFE_FREE(remap_cache->key_scratch.data);
+  MEM_freeN(remap_cache);
+}
+
+typedef struct DataTransferRemapKeyData {
+  DataTransferRemapCache *remap_cache;
+  const Mesh *me_src;
+  const Mesh *me_dst;
+  const SpaceTransform *space_transform;
+  float max_distance;
+  float ray_radius;
+  float islands_precision;
+} DataTransferRemapKeyData;
+
+static void data_transfer_remap_key_add(DataTransferRemapKey *key,
+                                        const void *data,
+                                        const size_t len)
+{
+  if (key->len + len > key->len_alloc) {
+    key->len_alloc = max_zz(key->len + len, key->len_alloc * 2);
+    key->data = MEM_reallocN(key->data, key->len_alloc);
+  }
+  if (len != 0) {
+    memcpy(key->data + key->len, data, len);
+  }
+  key->len += len;
+}
+
+static void data_transfer_remap_key_add_int(DataTransferRemapKey *key, const int value)
+{
+  data_transfer_remap_key_add(key, &value, sizeof(value));
+}
+
+static void data_transfer_remap_key_add_layer(DataTransferRemapKey *key,
+                                              const CustomData *data,
+                                              const int type,
+                                              const int elem_num)
+{
+  const void *layer = CustomData_get_layer(data, type);
+  data_transfer_remap_key_add_int(key, layer != NULL);
+  if (layer) {
+    data_transfer_remap_key_add(key, layer, (size_t)CustomData_sizeof(type) * (size_t)elem_num);
+  }
+}
+
+/**
+ * Everything of a mesh which any mapping mode may depend on: positions and topology, and
+ * what the (split) normals are computed from.
+ */
+static void data_transfer_remap_key_add_mesh(DataTransferRemapKey *key, const Mesh *me)
+{
+  data_transfer_remap_key_add_int(key, me->totvert);
+  data_transfer_remap_key_add_int(key, me->totedge);
+  data_transfer_remap_key_add_int(key, me->totpoly);
+  data_transfer_remap_key_add_int(key, me->totloop);
+  data_transfer_remap_key_add(key, me->mvert, sizeof(*me->mvert) * (size_t)me->totvert);
+  data_transfer_remap_key_add(key, me->medge, sizeof(*me->medge) * (size_t)me->totedge);
+  data_transfer_remap_key_add(key, me->mpoly, sizeof(*me->mpoly) * (size_t)me->totpoly);
+  data_transfer_remap_key_add(key, me->mloop, sizeof(*me->mloop) * (size_t)me->totloop);
+  data_transfer_remap_key_add_layer(key, &me->ldata, CD_CUSTOMLOOPNORMAL, me->totloop);
+  data_transfer_remap_key_add_int(key, me->flag & ME_AUTOSMOOTH);
+  data_transfer_remap_key_add(key, &me->smoothresh, sizeof(me->smoothresh));
+}
+
+/**
+ * \return true when the cached mapping at \a index was computed from the same input,
+ * otherwise the key is updated and the caller is expected to compute the mapping again.
+ */
+static bool data_transfer_remap_cache_test(DataTransferRemapKeyData *key_data,
+                                           const int index,
+                                           const int map_mode,
+                                           const bool use_islands)
+{
+  DataTransferRemapCache *remap_cache = key_data->remap_cache;
+  if (remap_cache == NULL) {
+    return false;
+  }
+
+  DataTransferRemapKey *key = &remap_cache->key_scratch;
+  key->len = 0;
+  data_transfer_remap_key_add_mesh(key, key_data->me_src);
+  data_transfer_remap_key_add_mesh(key, key_data->me_dst);
+  data_transfer_remap_key_add_int(key, map_mode);
+  data_transfer_remap_key_add_int(key, use_islands);
+  data_transfer_remap_key_add_int(key, key_data->space_transform != NULL);
+  if (key_data->space_transform) {
+    data_transfer_remap_key_add(
+        key, key_data->space_transform, sizeof(*key_data->space_transform));
+  }
+  data_transfer_remap_key_add(key, &key_data->max_distance, sizeof(float));
+  data_transfer_remap_key_add(key, &key_data->ray_radius, sizeof(float));
+  data_transfer_remap_key_add(key, &key_data->islands_precision, sizeof(float));
+  if (index == 2) {
+    /* Loop mappings also use the loop normals, which may come from earlier modifiers. */
+    data_transfer_remap_key_add_layer(
+        key, &key_data->me_src->ldata, CD_NORMAL, key_data->me_src->totloop);
+    data_transfer_remap_key_add_layer(
+        key, &key_data->me_dst->ldata, CD_NORMAL, key_data->me_dst->totloop);
+  }
+
+  DataTransferRemapKey *cached_key = &remap_cache->geom_map_key[index];
+  if (remap_cache->geom_map_valid[index] && cached_key->len == key->len &&
+      memcmp(cached_key->data, key->data, key->len) == 0) {
+    return true;
+  }
+  /* Keep the new key, the previous one becomes the scratch buffer. */
+  SWAP(DataTransferRemapKey, *cached_key, *key);
+  remap_cache->geom_map_valid[index] = true;
+  return false;
+}
+
+/** \} */
+
 bool BKE_object_data_transfer_ex(struct Depsgraph *depsgraph,
                                  Scene *scene,
                                  Object *ob_src,
@@ -1344,6 +1492,7 @@ bool BKE_object_data_transfer_ex(struct Depsgraph *depsgraph,
                                  const float mix_factor,
                                  const char *vgroup_name,
                                  const bool invert_vgroup,
+                                 DataTransferRemapCache *remap_cache,
                                  ReportList *reports)
 {
 #define VDATA 0
@@ -1362,7 +1511,9 @@ bool BKE_object_data_transfer_ex(struct Depsgraph *depsgraph,
   int vg_idx = -1;
   float *weights[DATAMAX] = {NULL};
 
-  MeshPairRemap geom_map[DATAMAX] = {{0}};
+  MeshPairRemap geom_map_local[DATAMAX] = {{0}};
+  /* The cache keeps the mappings, so they are not freed at the end. */
+  MeshPairRemap *geom_map = remap_cache ? remap_cache->geom_map : geom_map_local;
   bool geom_map_init[DATAMAX] = {0};
   ListBase lay_map = {NULL};
   bool changed = false;
@@ -1422,6 +1573,16 @@ bool BKE_object_data_transfer_ex(struct Depsgraph *depsgraph,
         me_dst->mvert, me_dst->totvert, me_src, space_transform);
   }
 
+  DataTransferRemapKeyData remap_key_data = {
+      .remap_cache = remap_cache,
+      .me_src = me_src,
+      .me_dst = me_dst,
+      .space_transform = space_transform,
+      .max_distance = max_distance,
+      .ray_radius = ray_radius,
+      .islands_precision = islands_handling_precision,
+  };
+
   /* Check all possible data types.
    * Note item mappings and dest mix weights are cached. */
   for (int i = 0; i < DT_TYPE_MAX; i++) {
@@ -1482,15 +1643,17 @@ bool BKE_object_data_transfer_ex(struct Depsgraph *depsgraph,
           continue;
         }
 
-        BKE_mesh_remap_calc_verts_from_mesh(map_vert_mode,
-                                            space_transform,
-                                            max_distance,
-                                            ray_radius,
-                                            verts_dst,
-                                            num_verts_dst,
-                                            dirty_nors_dst,
-                                            me_src,
-                                            &geom_map[VDATA]);
+        if (!data_transfer_remap_cache_test(&remap_key_data, VDATA, map_vert_mode, false)) {
+          BKE_mesh_remap_calc_verts_from_mesh(map_vert_mode,
+                                              space_transform,
+                                              max_distance,
+                                              ray_radius,
+                                              verts_dst,
+                                              num_verts_dst,
+                                              dirty_nors_dst,
+                                              me_src,
+                                              &geom_map[VDATA]);
+        }
         geom_map_init[VDATA] = true;
       }
 
@@ -1558,17 +1721,19 @@ bool BKE_object_data_transfer_ex(struct Depsgraph *depsgraph,
           continue;
         }
 
-        BKE_mesh_remap_calc_edges_from_mesh(map_edge_mode,
-                                            space_transform,
-                                            max_distance,
-                                            ray_radius,
-                                            verts_dst,
-                                            num_verts_dst,
-                                            edges_dst,
-                                            num_edges_dst,
-                                            dirty_nors_dst,
-                                            me_src,
-                                            &geom_map[EDATA]);
+        if (!data_transfer_remap_cache_test(&remap_key_data, EDATA, map_edge_mode, false)) {
+          BKE_mesh_remap_calc_edges_from_mesh(map_edge_mode,
+                                              space_transform,
+                                              max_distance,
+                                              ray_radius,
+                                              verts_dst,
+                                              num_verts_dst,
+                                              edges_dst,
+                                              num_edges_dst,
+                                              dirty_nors_dst,
+                                              me_src,
+                                              &geom_map[EDATA]);
+        }
         geom_map_init[EDATA] = true;
       }
 
@@ -1643,27 +1808,30 @@ bool BKE_object_data_transfer_ex(struct Depsgraph *depsgraph,
           continue;
         }
 
-        BKE_mesh_remap_calc_loops_from_mesh(map_loop_mode,
-                                            space_transform,
-                                            max_distance,
-                                            ray_radius,
-                                            me_dst,
-                                            verts_dst,
-                                            num_verts_dst,
-                                            edges_dst,
-                                            num_edges_dst,
-                                            loops_dst,
-                                            num_loops_dst,
-                                            polys_dst,
-                                            num_polys_dst,
-                                            ldata_dst,
-                                            (me_dst->flag & ME_AUTOSMOOTH) != 0,
-                                            me_dst->smoothresh,
-                                            dirty_nors_dst,
-                                            me_src,
-                                            island_callback,
-                                            islands_handling_precision,
-                                            &geom_map[LDATA]);
+        if (!data_transfer_remap_cache_test(
+                &remap_key_data, LDATA, map_loop_mode, island_callback != NULL)) {
+          BKE_mesh_remap_calc_loops_from_mesh(map_loop_mode,
+                                              space_transform,
+                                              max_distance,
+                                              ray_radius,
+                                              me_dst,
+                                              verts_dst,
+                                              num_verts_dst,
+                                              edges_dst,
+                                              num_edges_dst,
+                                              loops_dst,
+                                              num_loops_dst,
+                                              polys_dst,
+                                              num_polys_dst,
+                                              ldata_dst,
+                                              (me_dst->flag & ME_AUTOSMOOTH) != 0,
+                                              me_dst->smoothresh,
+                                              dirty_nors_dst,
+                                              me_src,
+                                              island_callback,
+                                              islands_handling_precision,
+                                              &geom_map[LDATA]);
+        }
         geom_map_init[LDATA] = true;
       }
 
@@ -1733,17 +1901,19 @@ bool BKE_object_data_transfer_ex(struct Depsgraph *depsgraph,
           continue;
         }
 
-        BKE_mesh_remap_calc_polys_from_mesh(map_poly_mode,
-                                            space_transform,
-                                            max_distance,
-                                            ray_radius,
-                                            me_dst,
-                                            verts_dst,
-                                            loops_dst,
-                                            polys_dst,
-                                            num_polys_dst,
-                                            me_src,
-                                            &geom_map[PDATA]);
+        if (!data_transfer_remap_cache_test(&remap_key_data, PDATA, map_poly_mode, false)) {
+          BKE_mesh_remap_calc_polys_from_mesh(map_poly_mode,
+                                              space_transform,
+                                              max_distance,
+                                              ray_radius,
+                                              me_dst,
+                                              verts_dst,
+                                              loops_dst,
+                                              polys_dst,
+                                              num_polys_dst,
+                                              me_src,
+                                              &geom_map[PDATA]);
+        }
         geom_map_init[PDATA] = true;
       }
 
@@ -1792,7 +1962,7 @@ bool BKE_object_data_transfer_ex(struct Depsgraph *depsgraph,
   }
 
   for (int i = 0; i < DATAMAX; i++) {
-    BKE_mesh_remap_free(&geom_map[i]);
+    BKE_mesh_remap_free(&geom_map_local[i]);
     MEM_SAFE_FREE(weights[i]);
   }
 
@@ -1850,5 +2020,6 @@ bool BKE_object_data_transfer_mesh(struct Depsgraph *depsgraph,
                                      mix_factor,
                                      vgroup_name,
                                      invert_vgroup,
+                                     NULL,
                                      reports);
 }
@@ -5019,11 +5019,21 @@ static void dynamicPaint_doSmudge(DynamicPaintSurface *surface,
   }
 }
 
+/**
+ * The two neighbors a point drips into, see #surface_determineForceTargetPoints.
+ * They only depend on the force, so they are found once per frame instead of for every step.
+ */
+typedef struct DynamicPaintDripTargets {
+  int closest_id[2];
+  float closest_d[2];
+} DynamicPaintDripTargets;
+
 typedef struct DynamicPaintEffectData {
   const DynamicPaintSurface *surface;
   Scene *scene;
 
   float *force;
+  DynamicPaintDripTargets *drip_targets;
   ListBase *effectors;
   const void *prevPoint;
   const float eff_scale;
@@ -5098,6 +5108,11 @@ static void dynamic_paint_prepare_effect_cb(void *__restrict userdata,
 
   /* force strength, and normalize force vec */
   force[index * 4 + 3] = normalize_v3_v3(&force[index * 4], forc);
+
+  /* get force affect points */
+  DynamicPaintDripTargets *drip_target = &data->drip_targets[index];
+  surface_determineForceTargetPoints(
+      sData, index, &force[index * 4], drip_target->closest_d, drip_target->closest_id);
 }
 
 static int dynamicPaint_prepareEffectStep(struct Depsgraph *depsgraph,
@@ -5105,6 +5120,7 @@ static int dynamicPaint_prepareEffectStep(struct Depsgraph *depsgraph,
                                           Scene *scene,
                                           Object *ob,
                                           float **force,
+                                          DynamicPaintDripTargets **drip_targets,
                                           float timescale)
 {
   double average_force = 0.0f;
@@ -5121,12 +5137,15 @@ static int dynamicPaint_prepareEffectStep(struct Depsgraph *depsgraph,
 
     /* allocate memory for force data (dir vector + strength) */
     *force = MEM_mallocN(sizeof(float[4]) * sData->total_points, "PaintEffectForces");
+    *drip_targets = MEM_mallocN(sizeof(DynamicPaintDripTargets) * sData->total_points,
+                                "PaintEffectDripTargets");
 
     if (*force) {
       DynamicPaintEffectData data = {
           .surface = surface,
           .scene = scene,
           .force = *force,
+          .drip_targets = *drip_targets,
           .effectors = effectors,
       };
       TaskParallelSettings settings;
@@ -5311,8 +5330,8 @@ static void dynamic_paint_effect_drip_cb(void *__restrict userdata,
 
   uint8_t *point_locks = data->point_locks;
 
-  int closest_id[2];
-  float closest_d[2];
+  const int *closest_id = data->drip_targets[index].closest_id;
+  const float *closest_d = data->drip_targets[index].closest_d;
 
   /* adjust drip speed depending on wetness */
   float w_factor = pPoint_prev->wetness - 0.025f;
@@ -5323,9 +5342,6 @@ static void dynamic_paint_effect_drip_cb(void *__restrict userdata,
 
   float ppoint_wetness_diff = 0.0f;
 
-  /* get force affect points */
-  surface_determineForceTargetPoints(sData, index, &force[index * 4], closest_d, closest_id);
-
   /* Apply movement towards those two points */
   for (int i = 0; i < 2; i++) {
     const int n_idx = closest_id[i];
@@ -5418,6 +5434,7 @@ static void dynamicPaint_doEffectStep(
     /* Cannot be const, because it is assigned to non-const variable.
      * NOLINTNEXTLINE: readability-non-const-parameter. */
     float *force,
+    DynamicPaintDripTargets *drip_targets,
     PaintPoint *prevPoint,
     float timescale,
     float steps)
@@ -5493,6 +5510,7 @@ static void dynamicPaint_doEffectStep(
         .prevPoint = prevPoint,
         .eff_scale = eff_scale,
         .force = force,
+        .drip_targets = drip_targets,
         .point_locks = point_locks,
     };
     TaskParallelSettings settings;
@@ -6303,6 +6321,7 @@ static int dynamicPaint_doStep(Depsgraph *depsgraph,
       int steps = 1, s;
       PaintPoint *prevPoint;
       float *force = NULL;
+      DynamicPaintDripTargets *drip_targets = NULL;
 
       /* Allocate memory for surface previous points to read unchanged values from */
       prevPoint = MEM_mallocN(sData->total_points * sizeof(struct PaintPoint),
@@ -6312,9 +6331,10 @@ static int dynamicPaint_doStep(Depsgraph *depsgraph,
       }
 
       /* Prepare effects and get number of required steps */
-      steps = dynamicPaint_prepareEffectStep(depsgraph, surface, scene, ob, &force, timescale);
+      steps = dynamicPaint_prepareEffectStep(
+          depsgraph, surface, scene, ob, &force, &drip_targets, timescale);
       for (s = 0; s < steps; s++) {
-        dynamicPaint_doEffectStep(surface, force, prevPoint, timescale, (float)steps);
+        dynamicPaint_doEffectStep(surface, force, drip_targets, prevPoint, timescale, (float)steps);
       }
 
       /* Free temporary effect data */
@@ -6324,6 +6344,7 @@ static int dynamicPaint_doStep(Depsgraph *depsgraph,
       if (force) {
         MEM_freeN(force);
       }
+      MEM_SAFE_FREE(drip_targets);
     }
 
     /* paint island border pixels */
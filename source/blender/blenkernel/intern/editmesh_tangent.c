@@ -254,6 +254,7 @@ static void emDM_calc_loop_tangents_thread(TaskPool *__restrict UNUSED(pool), vo
     sInterface.m_getTexCoord = emdm_ts_GetTextureCoordinate;
     sInterface.m_getNormal = emdm_ts_GetNormal;
     sInterface.m_setTSpaceBasic = emdm_ts_SetTSpace;
+    sInterface.m_parallelRange = BKE_mesh_tangent_mikk_parallel_range;
     /* 0 if failed */
     genTangSpaceDefault(&sContext);
   }
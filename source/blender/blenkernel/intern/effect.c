@@ -26,6 +26,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
+#include "BLI_kdtree.h"
 #include "BLI_math.h"
 #include "BLI_noise.h"
 #include "BLI_rand.h"
@@ -132,6 +133,91 @@ void BKE_partdeflect_free(PartDeflect *pd)
 
 /******************** EFFECTOR RELATIONS ***********************/
 
+/** State of an effector particle, as used by #get_effector_data. */
+typedef struct EffectorParticleState {
+  float co[3];
+  float nor[3];
+  float size;
+  bool valid;
+} EffectorParticleState;
+
+/** Only every n-th particle of a particle system is used as effector. */
+static int effector_particle_step(const ParticleSystem *psys)
+{
+  const int totpart = psys->totpart;
+  const int amount = psys->part->effector_amount;
+  if (amount && totpart > amount) {
+    return (int)ceil((float)totpart / (float)amount);
+  }
+  return 1;
+}
+
+static bool effector_uses_single_particle(const PartDeflect *pd)
+{
+  /* Every point is mapped to only one harmonic effector particle. */
+  return pd->forcefield == PFIELD_HARMONIC && (pd->flag & PFIELD_MULTIPLE_SPRINGS) == 0;
+}
+
+/**
+ * The state of the effector particles doesn't depend on the effected point, so evaluate it once
+ * for all points. When the effect is zero beyond a maximum distance, also build a tree, so that
+ * only the particles in that range have to be visited for every point.
+ */
+static void precalculate_effector_particles(EffectorCache *eff)
+{
+  ParticleSystem *psys = eff->psys;
+  PartDeflect *pd = eff->pd;
+  const int totpart = psys->totpart;
+  const bool single_particle = effector_uses_single_particle(pd);
+  const int step = single_particle ? 1 : effector_particle_step(psys);
+
+  if (totpart == 0) {
+    return;
+  }
+
+  ParticleSimulationData sim = {NULL};
+  sim.depsgraph = eff->depsgraph;
+  sim.scene = eff->scene;
+  sim.ob = eff->ob;
+  sim.psys = psys;
+
+  const float cfra = DEG_get_ctime(eff->depsgraph);
+  eff->particle_states = MEM_calloc_arrayN(
+      (size_t)totpart, sizeof(EffectorParticleState), "EffectorParticleState");
+
+  const bool use_tree = !single_particle && pd->falloff == PFIELD_FALL_SPHERE &&
+                        (pd->flag & PFIELD_USEMAX);
+  if (use_tree) {
+    eff->particle_tree = BLI_kdtree_3d_new((uint)(totpart / step + 1));
+  }
+
+  for (int p = 0; p < totpart; p += step) {
+    EffectorParticleState *particle_state = &eff->particle_states[p];
+    ParticleKey state;
+
+    /* TODO: time from actual previous calculated frame (step might not be 1) */
+    state.time = cfra - 1.0f;
+    particle_state->valid = psys_get_particle_state(&sim, p, &state, 0);
+
+    copy_v3_v3(particle_state->co, state.co);
+
+    /* rather than use the velocity use rotated x-axis (defaults to velocity) */
+    particle_state->nor[0] = 1.0f;
+    particle_state->nor[1] = particle_state->nor[2] = 0.0f;
+    mul_qt_v3(state.rot, particle_state->nor);
+
+    particle_state->size = psys->particles[p].size;
+
+    if (use_tree && particle_state->valid) {
+      BLI_kdtree_3d_insert(eff->particle_tree, p, particle_state->co);
+    }
+  }
+
+  if (use_tree) {
+    BLI_kdtree_3d_balance(eff->particle_tree);
+  }
+}
+
 static void precalculate_effector(struct Depsgraph *depsgraph, EffectorCache *eff)
 {
   float ctime = DEG_get_ctime(depsgraph);
@@ -167,6 +253,10 @@ static void precalculate_effector(struct Depsgraph *depsgraph, EffectorCache *ef
   }
   else if (eff->psys) {
     psys_update_particle_tree(eff->psys, ctime);
+
+    if (eff->pd->shape != PFIELD_SHAPE_POINTS) {
+      precalculate_effector_particles(eff);
+    }
   }
 }
 
@@ -373,6 +463,10 @@ void BKE_effectors_free(ListBase *lb)
       if (eff->guide_data) {
         MEM_freeN(eff->guide_data);
       }
+      MEM_SAFE_FREE(eff->particle_states);
+      if (eff->particle_tree) {
+        BLI_kdtree_3d_free(eff->particle_tree);
+      }
     }
 
     BLI_freelistN(lb);
@@ -673,6 +767,28 @@ bool closest_point_on_surface(SurfaceModifierData *surmd,
 
   return false;
 }
+static void effector_data_finalize(EffectorCache *eff, EffectorData *efd, EffectedPoint *point)
+{
+  sub_v3_v3v3(efd->vec_to_point, point->loc, efd->loc);
+  efd->distance = len_v3(efd->vec_to_point);
+
+  /* Rest length for harmonic effector,
+   * will have to see later if this could be extended to other effectors. */
+  if (eff->pd && eff->pd->forcefield == PFIELD_HARMONIC && eff->pd->f_size) {
+    mul_v3_fl(efd->vec_to_point, (efd->distance - eff->pd->f_size) / efd->distance);
+  }
+
+  if (eff->flag & PE_USE_NORMAL_DATA) {
+    copy_v3_v3(efd->vec_to_point2, efd->vec_to_point);
+    copy_v3_v3(efd->nor2, efd->nor);
+  }
+  else {
+    /* for some effectors we need the object center every time */
+    sub_v3_v3v3(efd->vec_to_point2, point->loc, eff->ob->obmat[3]);
+    normalize_v3_v3(efd->nor2, eff->ob->obmat[2]);
+  }
+}
+
 bool get_effector_data(EffectorCache *eff,
                        EffectorData *efd,
                        EffectedPoint *point,
@@ -784,28 +900,39 @@ bool get_effector_data(EffectorCache *eff,
   }
 
   if (ret) {
-    sub_v3_v3v3(efd->vec_to_point, point->loc, efd->loc);
-    efd->distance = len_v3(efd->vec_to_point);
+    effector_data_finalize(eff, efd, point);
+  }
 
-    /* Rest length for harmonic effector,
-     * will have to see later if this could be extended to other effectors. */
-    if (eff->pd && eff->pd->forcefield == PFIELD_HARMONIC && eff->pd->f_size) {
-      mul_v3_fl(efd->vec_to_point, (efd->distance - eff->pd->f_size) / efd->distance);
-    }
+  return ret;
+}
 
-    if (eff->flag & PE_USE_NORMAL_DATA) {
-      copy_v3_v3(efd->vec_to_point2, efd->vec_to_point);
-      copy_v3_v3(efd->nor2, efd->nor);
-    }
-    else {
-      /* for some effectors we need the object center every time */
-      sub_v3_v3v3(efd->vec_to_point2, point->loc, eff->ob->obmat[3]);
-      normalize_v3_v3(efd->nor2, eff->ob->obmat[2]);
-    }
+/**
+ * Same as #get_effector_data for particle system effectors, but using the particle states that
+ * were evaluated in advance.
+ */
+static bool get_effector_particle_data_cached(EffectorCache *eff,
+                                              EffectorData *efd,
+                                              EffectedPoint *point)
+{
+  const int index = *efd->index;
+  const EffectorParticleState *particle_state = &eff->particle_states[index];
+
+  /* exclude the particle itself for self effecting particles */
+  if (eff->psys == point->psys && index == point->index) {
+    return false;
+  }
+  if (!particle_state->valid) {
+    return false;
   }
 
-  return ret;
+  copy_v3_v3(efd->loc, particle_state->co);
+  copy_v3_v3(efd->nor, particle_state->nor);
+  efd->size = particle_state->size;
+
+  effector_data_finalize(eff, efd, point);
+  return true;
 }
+
 static void get_effector_tot(
     EffectorCache *eff, EffectorData *efd, EffectedPoint *point, int *tot, int *p, int *step)
 {
@@ -834,18 +961,14 @@ static void get_effector_tot(
        */
       efd->charge = eff->pd->f_strength;
     }
-    else if (eff->pd->forcefield == PFIELD_HARMONIC &&
-             (eff->pd->flag & PFIELD_MULTIPLE_SPRINGS) == 0) {
+    else if (effector_uses_single_particle(eff->pd)) {
       /* every particle is mapped to only one harmonic effector particle */
       *p = point->index % eff->psys->totpart;
       *tot = *p + 1;
     }
 
     if (eff->psys->part->effector_amount) {
-      int totpart = eff->psys->totpart;
-      int amount = eff->psys->part->effector_amount;
-
-      *step = (totpart > amount) ? (int)ceil((float)totpart / (float)amount) : 1;
+      *step = effector_particle_step(eff->psys);
     }
   }
   else {
@@ -1113,6 +1236,77 @@ static void do_physical_effector(EffectorCache *eff,
   }
 }
 
+typedef struct EffectorApplyData {
+  EffectorCache *eff;
+  /* The effector element to evaluate is #EffectorData.index. */
+  EffectorData *efd;
+  ListBase *colliders;
+  EffectorWeights *weights;
+  EffectedPoint *point;
+  float *force;
+  float *wind_force;
+  float *impulse;
+} EffectorApplyData;
+
+static void effector_apply_index(const EffectorApplyData *data)
+{
+  EffectorCache *eff = data->eff;
+  EffectorData *efd = data->efd;
+  EffectedPoint *point = data->point;
+  float *force = data->force;
+  float *wind_force = data->wind_force;
+  float *impulse = data->impulse;
+
+  const bool has_data = eff->particle_states ? get_effector_particle_data_cached(eff, efd, point) :
+                                               get_effector_data(eff, efd, point, 0);
+
+  if (has_data) {
+    efd->falloff = effector_falloff(eff, efd, point, data->weights);
+
+    if (efd->falloff > 0.0f) {
+      efd->falloff *= eff_calc_visibility(data->colliders, eff, efd, point);
+    }
+    if (efd->falloff > 0.0f) {
+      float out_force[3] = {0, 0, 0};
+
+      if (eff->pd->forcefield == PFIELD_TEXTURE) {
+        do_texture_effector(eff, efd, point, out_force);
+      }
+      else {
+        do_physical_effector(eff, efd, point, out_force);
+
+        /* for softbody backward compatibility */
+        if (point->flag & PE_WIND_AS_SPEED && impulse) {
+          sub_v3_v3v3(impulse, impulse, out_force);
+        }
+      }
+
+      if (wind_force) {
+        madd_v3_v3fl(force, out_force, 1.0f - eff->pd->f_wind_factor);
+        madd_v3_v3fl(wind_force, out_force, eff->pd->f_wind_factor);
+      }
+      else {
+        add_v3_v3(force, out_force);
+      }
+    }
+  }
+  else if (eff->flag & PE_VELOCITY_TO_IMPULSE && impulse) {
+    /* special case for harmonic effector */
+    add_v3_v3v3(impulse, impulse, efd->vel);
+  }
+}
+
+static bool effector_apply_in_range_cb(void *user_data,
+                                       int index,
+                                       const float UNUSED(co[3]),
+                                       float UNUSED(dist_sq))
+{
+  const EffectorApplyData *data = user_data;
+  *data->efd->index = index;
+  effector_apply_index(data);
+  return true;
+}
+
 void BKE_effectors_apply(ListBase *effectors,
                          ListBase *colliders,
                          EffectorWeights *weights,
@@ -1158,46 +1352,33 @@ void BKE_effectors_apply(ListBase *effectors,
   /* Check for min distance here? (yes would be cool to add that, ton) */
 
   if (effectors) {
+    EffectorApplyData data = {
+        .efd = &efd,
+        .colliders = colliders,
+        .weights = weights,
+        .point = point,
+        .force = force,
+        .wind_force = wind_force,
+        .impulse = impulse,
+    };
+
     for (eff = effectors->first; eff; eff = eff->next) {
       /* object effectors were fully checked to be OK to evaluate! */
+      data.eff = eff;
 
       get_effector_tot(eff, &efd, point, &tot, &p, &step);
 
-      for (; p < tot; p += step) {
-        if (get_effector_data(eff, &efd, point, 0)) {
-          efd.falloff = effector_falloff(eff, &efd, point, weights);
+      if (eff->particle_tree && tot - p > step) {
+        /* Particles beyond the maximum distance have no effect. The range is a bit larger, so
+         * that rounding never skips a particle the falloff would include. */
+        const float range = eff->pd->maxdist * (1.0f + FLT_EPSILON * 4.0f) + FLT_EPSILON;
+        BLI_kdtree_3d_range_search_cb(
+            eff->particle_tree, point->loc, range, effector_apply_in_range_cb, &data);
+        continue;
+      }
 
-          if (efd.falloff > 0.0f) {
-            efd.falloff *= eff_calc_visibility(colliders, eff, &efd, point);
-          }
-          if (efd.falloff > 0.0f) {
-            float out_force[3] = {0, 0, 0};
-
-            if (eff->pd->forcefield == PFIELD_TEXTURE) {
-              do_texture_effector(eff, &efd, point, out_force);
-            }
-            else {
-              do_physical_effector(eff, &efd, point, out_force);
-
-              /* for softbody backward compatibility */
-              if (point->flag & PE_WIND_AS_SPEED && impulse) {
-                sub_v3_v3v3(impulse, impulse, out_force);
-              }
-            }
-
-            if (wind_force) {
-              madd_v3_v3fl(force, out_force, 1.0f - eff->pd->f_wind_factor);
-              madd_v3_v3fl(wind_force, out_force, eff->pd->f_wind_factor);
-            }
-            else {
-              add_v3_v3(force, out_force);
-            }
-          }
-        }
-        else if (eff->flag & PE_VELOCITY_TO_IMPULSE && impulse) {
-          /* special case for harmonic effector */
-          add_v3_v3v3(impulse, impulse, efd.vel);
-        }
+      for (; p < tot; p += step) {
+        effector_apply_index(&data);
       }
     }
   }
@@ -2035,6 +2035,20 @@ static float evaluate_fcurve_ex(FCurve *fcu, float evaltime, float cvalue)
 {
   float devaltime;
 
+  /* Most animation curves have no modifiers, skip counting them and setting up their storage. */
+  if (BLI_listbase_is_empty(&fcu->modifiers)) {
+    if (fcu->bezt) {
+      cvalue = fcurve_eval_keyframes(fcu, fcu->bezt, evaltime);
+    }
+    else if (fcu->fpt) {
+      cvalue = fcurve_eval_samples(fcu, fcu->fpt, evaltime);
+    }
+    if (fcu->flag & FCURVE_INT_VALUES) {
+      cvalue = floorf(cvalue + 0.5f);
+    }
+    return cvalue;
+  }
+
   /* Evaluate modifiers which modify time to evaluate the base curve at. */
   FModifiersStackStorage storage;
   storage.modifier_count = BLI_listbase_count(&fcu->modifiers);
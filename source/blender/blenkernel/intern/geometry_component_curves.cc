@@ -203,15 +203,15 @@ VArray<float3> curve_normals_varray(const CurveComponent &component, const Attri
   if (component.is_empty()) {
     return nullptr;
   }
-  const std::unique_ptr<CurveEval> curve = curves_to_curve_eval(*component.get_for_read());
+  const CurveEval &curve = curves_to_curve_eval_cached(*component.get_for_read());
 
   if (domain == ATTR_DOMAIN_POINT) {
-    Array<float3> normals = curve_normal_point_domain(*curve);
+    Array<float3> normals = curve_normal_point_domain(curve);
     return VArray<float3>::ForContainer(std::move(normals));
   }
 
   if (domain == ATTR_DOMAIN_CURVE) {
-    Array<float3> point_normals = curve_normal_point_domain(*curve);
+    Array<float3> point_normals = curve_normal_point_domain(curve);
     VArray<float3> varray = VArray<float3>::ForContainer(std::move(point_normals));
     return component.attribute_try_adapt_domain<float3>(
         std::move(varray), ATTR_DOMAIN_POINT, ATTR_DOMAIN_CURVE);
@@ -125,25 +125,36 @@ static void geometry_set_collect_recursive(const GeometrySet &geometry_set,
     Span<float4x4> transforms = instances_component.instance_transforms();
     Span<int> handles = instances_component.instance_reference_handles();
     Span<InstanceReference> references = instances_component.references();
-    for (const int i : transforms.index_range()) {
-      const InstanceReference &reference = references[handles[i]];
-      const float4x4 instance_transform = transform * transforms[i];
 
+    /* Gather the geometry of every used reference only once, relative to the instance. Every
+     * instance then only adds its transforms to the groups of its reference, so that each unique
+     * geometry is only processed once by the caller, even when it is instanced many times. */
+    Array<bool> reference_used(references.size(), false);
+    for (const int handle : handles) {
+      reference_used[handle] = true;
+    }
+    Array<Vector<GeometryInstanceGroup>> reference_groups(references.size());
+    for (const int handle : references.index_range()) {
+      if (!reference_used[handle]) {
+        continue;
+      }
+      const InstanceReference &reference = references[handle];
+      const float4x4 identity = float4x4::identity();
       switch (reference.type()) {
         case InstanceReference::Type::Object: {
           Object &object = reference.object();
-          geometry_set_collect_recursive_object(object, instance_transform, r_sets);
+          geometry_set_collect_recursive_object(object, identity, reference_groups[handle]);
           break;
         }
         case InstanceReference::Type::Collection: {
           Collection &collection = reference.collection();
           geometry_set_collect_recursive_collection_instance(
-              collection, instance_transform, r_sets);
+              collection, identity, reference_groups[handle]);
           break;
         }
         case InstanceReference::Type::GeometrySet: {
           const GeometrySet &geometry_set = reference.geometry_set();
-          geometry_set_collect_recursive(geometry_set, instance_transform, r_sets);
+          geometry_set_collect_recursive(geometry_set, identity, reference_groups[handle]);
           break;
         }
         case InstanceReference::Type::None: {
@@ -151,6 +162,29 @@ static void geometry_set_collect_recursive(const GeometrySet &geometry_set,
         }
       }
     }
+
+    Array<Vector<GeometryInstanceGroup>> result_groups(references.size());
+    for (const int handle : references.index_range()) {
+      for (const GeometryInstanceGroup &group : reference_groups[handle]) {
+        result_groups[handle].append({group.geometry_set, {}});
+      }
+    }
+    for (const int i : transforms.index_range()) {
+      const int handle = handles[i];
+      const float4x4 instance_transform = transform * transforms[i];
+      const Span<GeometryInstanceGroup> groups = reference_groups[handle];
+      for (const int group_index : groups.index_range()) {
+        Vector<float4x4> &result_transforms = result_groups[handle][group_index].transforms;
+        for (const float4x4 &local_transform : groups[group_index].transforms) {
+          result_transforms.append(instance_transform * local_transform);
+        }
+      }
+    }
+    for (Vector<GeometryInstanceGroup> &groups : result_groups) {
+      for (GeometryInstanceGroup &group : groups) {
+        r_sets.append(std::move(group));
+      }
+    }
   }
 }
 
@@ -13,6 +13,7 @@
 #include "BLI_math_geom.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -747,6 +748,117 @@ void BKE_gpencil_prepare_eval_data(Depsgraph *depsgraph, Scene *scene, Object *o
   gpencil_copy_visible_frames_to_eval(depsgraph, scene, ob);
 }
 
+typedef struct GpencilModifierDeformData {
+  GpencilModifierData *md;
+  const GpencilModifierTypeInfo *mti;
+  Depsgraph *depsgraph;
+  Object *ob;
+  /** Layers with a frame to deform, and their frames. */
+  bGPDlayer **layers;
+  bGPDframe **frames;
+  /** All strokes of the frames above and the index of their frame, when deforming strokes. */
+  bGPDstroke **strokes;
+  int *stroke_frame_indices;
+} GpencilModifierDeformData;
+
+static void gpencil_modifier_deform_frame_fn(void *__restrict userdata,
+                                             const int i,
+                                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  GpencilModifierDeformData *data = (GpencilModifierDeformData *)userdata;
+  bGPDlayer *gpl = data->layers[i];
+  bGPDframe *gpf = data->frames[i];
+  LISTBASE_FOREACH_MUTABLE (bGPDstroke *, gps, &gpf->strokes) {
+    data->mti->deformStroke(data->md, data->depsgraph, data->ob, gpl, gpf, gps);
+  }
+}
+
+static void gpencil_modifier_deform_stroke_fn(void *__restrict userdata,
+                                              const int i,
+                                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  GpencilModifierDeformData *data = (GpencilModifierDeformData *)userdata;
+  const int frame_index = data->stroke_frame_indices[i];
+  data->mti->deformStroke(data->md,
+                          data->depsgraph,
+                          data->ob,
+                          data->layers[frame_index],
+                          data->frames[frame_index],
+                          data->strokes[i]);
+}
+
+/**
+ * Apply a deform modifier to the (time remapped) frame of every layer. Layers are independent,
+ * and unless the modifier can change the list of strokes, so are the strokes of a frame.
+ */
+static void gpencil_modifier_deform_strokes(GpencilModifierData *md,
+                                            const GpencilModifierTypeInfo *mti,
+                                            Depsgraph *depsgraph,
+                                            Scene *scene,
+                                            Object *ob)
+{
+  bGPdata *gpd = (bGPdata *)ob->data;
+  const int layers_len = BLI_listbase_count(&gpd->layers);
+  if (layers_len == 0) {
+    return;
+  }
+
+  GpencilModifierDeformData data = {
+      .md = md,
+      .mti = mti,
+      .depsgraph = depsgraph,
+      .ob = ob,
+      .layers = MEM_malloc_arrayN(layers_len, sizeof(bGPDlayer *), __func__),
+      .frames = MEM_malloc_arrayN(layers_len, sizeof(bGPDframe *), __func__),
+      .strokes = NULL,
+      .stroke_frame_indices = NULL,
+  };
+
+  int frames_len = 0;
+  int strokes_len = 0;
+  LISTBASE_FOREACH (bGPDlayer *, gpl, &gpd->layers) {
+    bGPDframe *gpf = BKE_gpencil_frame_retime_get(depsgraph, scene, ob, gpl);
+    if (gpf == NULL) {
+      continue;
+    }
+    data.layers[frames_len] = gpl;
+    data.frames[frames_len] = gpf;
+    frames_len++;
+    strokes_len += BLI_listbase_count(&gpf->strokes);
+  }
+
+  /* Without a deform callback, only the frame lookup above is needed for time remapping. */
+  if (mti->deformStroke != NULL) {
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+
+    if (mti->flags & eGpencilModifierTypeFlag_SerialStrokes) {
+      settings.min_iter_per_thread = 1;
+      BLI_task_parallel_range(0, frames_len, &data, gpencil_modifier_deform_frame_fn, &settings);
+    }
+    else if (strokes_len > 0) {
+      data.strokes = MEM_malloc_arrayN(strokes_len, sizeof(bGPDstroke *), __func__);
+      data.stroke_frame_indices = MEM_malloc_arrayN(strokes_len, sizeof(int), __func__);
+      int stroke_index = 0;
+      for (int i = 0; i < frames_len; i++) {
+        LISTBASE_FOREACH (bGPDstroke *, gps, &data.frames[i]->strokes) {
+          data.strokes[stroke_index] = gps;
+          data.stroke_frame_indices[stroke_index] = i;
+          stroke_index++;
+        }
+      }
+      settings.min_iter_per_thread = 16;
+      BLI_task_parallel_range(
+          0, strokes_len, &data, gpencil_modifier_deform_stroke_fn, &settings);
+      MEM_freeN(data.strokes);
+      MEM_freeN(data.stroke_frame_indices);
+    }
+  }
+
+  MEM_freeN(data.layers);
+  MEM_freeN(data.frames);
+}
+
 void BKE_gpencil_modifiers_calc(Depsgraph *depsgraph, Scene *scene, Object *ob)
 {
   bGPdata *gpd = (bGPdata *)ob->data;
@@ -789,18 +901,7 @@ void BKE_gpencil_modifiers_calc(Depsgraph *depsgraph, Scene *scene, Object *ob)
 
       /* Apply deform modifiers and Time remap (only change geometry). */
       if ((time_remap) || (mti && mti->deformStroke)) {
-        LISTBASE_FOREACH (bGPDlayer *, gpl, &gpd->layers) {
-          bGPDframe *gpf = BKE_gpencil_frame_retime_get(depsgraph, scene, ob, gpl);
-          if (gpf == NULL) {
-            continue;
-          }
-
-          if (mti->deformStroke) {
-            LISTBASE_FOREACH (bGPDstroke *, gps, &gpf->strokes) {
-              mti->deformStroke(md, depsgraph, ob, gpl, gpf, gps);
-            }
-          }
-        }
+        gpencil_modifier_deform_strokes(md, mti, depsgraph, scene, ob);
       }
     }
   }
@@ -5,6 +5,7 @@
  * \ingroup bke
  */
 
+#include <algorithm>
 #include <cctype>
 #include <cmath>
 #include <cstdio>
@@ -19,6 +20,7 @@
 #include <ctime>
 
 #include "BLI_array.hh"
+#include "BLI_vector.hh"
 
 #include "CLG_log.h"
 
@@ -49,6 +51,7 @@
 #include "DNA_scene_types.h"
 #include "DNA_sequence_types.h"
 #include "DNA_simulation_types.h"
+#include "DNA_userdef_types.h"
 #include "DNA_world_types.h"
 
 #include "BLI_blenlib.h"
@@ -202,6 +205,8 @@ static void image_free_data(ID *id)
 {
   Image *image = (Image *)id;
 
+  BKE_image_load_gpu_textures_wait(image);
+
   /* Also frees animations (#Image.anims list). */
   BKE_image_free_buffers(image);
 
@@ -1453,6 +1458,59 @@ void BKE_image_free_all_textures(Main *bmain)
 #endif
 }
 
+void BKE_image_free_old_ibufs(Main *bmain)
+{
+  static int lasttime = 0;
+  const int ctime = PIL_check_seconds_timer_i();
+
+  /* Measuring memory goes over all cached buffers, don't do it on every redraw. */
+  if (U.image_memory_limit == 0 || ctime == lasttime || G.is_rendering) {
+    return;
+  }
+  lasttime = ctime;
+
+  const uintptr_t mem_limit = (uintptr_t)U.image_memory_limit * 1024 * 1024;
+  uintptr_t mem_in_use = 0;
+  blender::Vector<std::pair<Image *, uintptr_t>> candidates;
+
+  LISTBASE_FOREACH (Image *, ima, &bmain->images) {
+    const uintptr_t size = image_mem_size(ima);
+    mem_in_use += size;
+
+    /* Only images which can be loaded again. */
+    if (size != 0 && ELEM(ima->source, IMA_SRC_FILE, IMA_SRC_TILED) &&
+        (ima->flag & IMA_NOCOLLECT) == 0 && !BKE_image_is_dirty(ima)) {
+      candidates.append({ima, size});
+    }
+  }
+
+  if (mem_in_use <= mem_limit) {
+    return;
+  }
+
+  std::sort(candidates.begin(),
+            candidates.end(),
+            [](const std::pair<Image *, uintptr_t> &a, const std::pair<Image *, uintptr_t> &b) {
+              return a.first->lastused < b.first->lastused;
+            });
+
+  for (const std::pair<Image *, uintptr_t> &candidate : candidates) {
+    if (mem_in_use <= mem_limit) {
+      break;
+    }
+    Image *ima = candidate.first;
+
+    /* GPU textures are kept, drawing only needs the buffers again when they change. */
+    BLI_mutex_lock(static_cast<ThreadMutex *>(ima->runtime.cache_mutex));
+    if (ima->cache != nullptr) {
+      IMB_moviecache_cleanup(ima->cache, imagecache_check_dirty, nullptr);
+    }
+    BLI_mutex_unlock(static_cast<ThreadMutex *>(ima->runtime.cache_mutex));
+
+    mem_in_use -= candidate.second - image_mem_size(ima);
+  }
+}
+
 static bool imagecache_check_free_anim(ImBuf *ibuf, void *UNUSED(userkey), void *userdata)
 {
   if (ibuf == nullptr) {
@@ -3257,6 +3315,14 @@ void BKE_image_path_from_imtype(char *string,
   do_makepicstring(string, base, relbase, frame, imtype, nullptr, use_ext, use_frames, suffix);
 }
 
+static int openanim_flags(int flags)
+{
+  if (U.video_flag & USER_VIDEO_HARDWARE_DECODING) {
+    flags |= IB_animhwdecode;
+  }
+  return flags;
+}
+
 struct anim *openanim_noload(const char *name,
                              int flags,
                              int streamindex,
@@ -3264,7 +3330,7 @@ struct anim *openanim_noload(const char *name,
 {
   struct anim *anim;
 
-  anim = IMB_open_anim(name, flags, streamindex, colorspace);
+  anim = IMB_open_anim(name, openanim_flags(flags), streamindex, colorspace);
   return anim;
 }
 
@@ -3273,7 +3339,7 @@ struct anim *openanim(const char *name, int flags, int streamindex, char colorsp
   struct anim *anim;
   struct ImBuf *ibuf;
 
-  anim = IMB_open_anim(name, flags, streamindex, colorspace);
+  anim = IMB_open_anim(name, openanim_flags(flags), streamindex, colorspace);
   if (anim == nullptr) {
     return nullptr;
   }
@@ -11,7 +11,11 @@
 #include "BLI_boxpack_2d.h"
 #include "BLI_linklist.h"
 #include "BLI_listbase.h"
+#include "BLI_set.hh"
+#include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
+#include "BLI_vector.hh"
 
 #include "DNA_image_types.h"
 #include "DNA_userdef_types.h"
@@ -344,6 +348,30 @@ static void image_gpu_texture_partial_update_changes_available(
   }
 }
 
+static bool gpu_texture_is_compressed(GPUTexture *tex)
+{
+  return ELEM(GPU_texture_format(tex),
+              GPU_SRGB8_A8_DXT1,
+              GPU_SRGB8_A8_DXT3,
+              GPU_SRGB8_A8_DXT5,
+              GPU_RGBA8_DXT1,
+              GPU_RGBA8_DXT3,
+              GPU_RGBA8_DXT5);
+}
+
+static bool image_has_compressed_gpu_texture(Image *ima)
+{
+  for (int eye = 0; eye < 2; eye++) {
+    for (int resolution = 0; resolution < IMA_TEXTURE_RESOLUTION_LEN; resolution++) {
+      GPUTexture *tex = ima->gputexture[TEXTARGET_2D][eye][resolution];
+      if (tex != nullptr && gpu_texture_is_compressed(tex)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 static void image_gpu_texture_try_partial_update(Image *image, ImageUser *iuser)
 {
   PartialUpdateChecker<ImageTileData> checker(image, iuser, image->runtime.partial_update_user);
@@ -355,6 +383,12 @@ static void image_gpu_texture_try_partial_update(Image *image, ImageUser *iuser)
     }
 
     case ePartialUpdateCollectResult::PartialChangesDetected: {
+      /* Compressed textures can't be partially updated, recreate them uncompressed since the
+       * image buffer is now dirty. */
+      if (image_has_compressed_gpu_texture(image)) {
+        image_free_gpu(image, true);
+        break;
+      }
       image_gpu_texture_partial_update_changes_available(image, changes);
       break;
     }
@@ -454,14 +488,23 @@ static GPUTexture *image_get_gpu_texture(Image *ima,
     const bool store_premultiplied = BKE_image_has_gpu_texture_premultiplied_alpha(ima,
                                                                                    ibuf_intern);
 
-    *tex = IMB_create_gpu_texture(
-        ima->id.name + 2, ibuf_intern, use_high_bitdepth, store_premultiplied, limit_resolution);
+    const bool use_compression = (U.gpu_flag & USER_GPU_FLAG_TEXTURE_COMPRESSION) != 0;
+
+    *tex = IMB_create_gpu_texture(ima->id.name + 2,
+                                  ibuf_intern,
+                                  use_high_bitdepth,
+                                  store_premultiplied,
+                                  limit_resolution,
+                                  use_compression);
 
     if (*tex) {
       GPU_texture_wrap_mode(*tex, true, false);
 
       if (GPU_mipmap_enabled()) {
-        GPU_texture_generate_mipmap(*tex);
+        /* Compressed textures are created with their complete mipmap chain. */
+        if (!gpu_texture_is_compressed(*tex)) {
+          GPU_texture_generate_mipmap(*tex);
+        }
         if (ima) {
           ima->gpuflag |= IMA_GPU_MIPMAP_COMPLETE;
         }
@@ -513,6 +556,161 @@ GPUTexture *BKE_image_get_gpu_tilemap(Image *image, ImageUser *iuser, ImBuf *ibu
   return image_get_gpu_texture(image, iuser, ibuf, TEXTARGET_TILE_MAPPING);
 }
 
+struct ImagePrefetchItem {
+  Image *image;
+  ImageUser iuser;
+};
+
+void BKE_image_prefetch_gpu_textures(Image **images, ImageUser **iusers, const int images_len)
+{
+  blender::Vector<ImagePrefetchItem> items;
+
+  for (int i = 0; i < images_len; i++) {
+    Image *ima = images[i];
+    if (ima == nullptr || !ELEM(ima->source, IMA_SRC_FILE, IMA_SRC_TILED) ||
+        BKE_image_has_opengl_texture(ima) || BKE_image_is_loading_gpu_texture(ima)) {
+      continue;
+    }
+    bool is_duplicate = false;
+    for (const ImagePrefetchItem &item : items) {
+      is_duplicate |= (item.image == ima);
+    }
+    if (is_duplicate) {
+      continue;
+    }
+
+    if (ima->source == IMA_SRC_TILED) {
+      /* Every tile is a separate file. */
+      LISTBASE_FOREACH (ImageTile *, tile, &ima->tiles) {
+        ImagePrefetchItem item = {ima};
+        BKE_imageuser_default(&item.iuser);
+        item.iuser.tile = tile->tile_number;
+        items.append(item);
+      }
+    }
+    else {
+      ImagePrefetchItem item = {ima};
+      if (iusers[i]) {
+        item.iuser = *iusers[i];
+      }
+      else {
+        BKE_imageuser_default(&item.iuser);
+      }
+      items.append(item);
+    }
+  }
+
+  /* A single image is loaded when creating its texture. */
+  if (items.size() < 2) {
+    return;
+  }
+
+  /* Loading is protected by the cache mutex of each image, so different images and tiles are
+   * read and decoded at the same time. Buffers stay in the image cache for the texture upload. */
+  blender::threading::parallel_for(items.index_range(), 1, [&](const blender::IndexRange range) {
+    for (const int i : range) {
+      ImagePrefetchItem &item = items[i];
+      ImBuf *ibuf = BKE_image_acquire_ibuf(item.image, &item.iuser, nullptr);
+      BKE_image_release_ibuf(item.image, ibuf, nullptr);
+    }
+  });
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Background Image Loading
+ *
+ * Images are read and decoded on worker threads while drawing uses a placeholder. Uploading the
+ * texture still happens on the drawing thread once the buffer is in the image cache.
+ * \{ */
+
+static ThreadMutex image_load_mutex = BLI_MUTEX_INITIALIZER;
+/* Pool of the running loads, freed once all loads finished. Protected by #image_load_mutex. */
+static TaskPool *image_load_pool = nullptr;
+/* Images that are being loaded by #image_load_pool. Protected by #image_load_mutex. */
+static blender::Set<Image *> images_loading;
+
+static void image_load_task_run(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  ImagePrefetchItem *item = static_cast<ImagePrefetchItem *>(taskdata);
+
+  ImBuf *ibuf = BKE_image_acquire_ibuf(item->image, &item->iuser, nullptr);
+  BKE_image_release_ibuf(item->image, ibuf, nullptr);
+
+  BLI_mutex_lock(&image_load_mutex);
+  images_loading.remove(item->image);
+  BLI_mutex_unlock(&image_load_mutex);
+}
+
+void BKE_image_load_gpu_textures_async(Image **images, ImageUser **iusers, const int images_len)
+{
+  /* Tasks would only run when waiting for them without worker threads. */
+  if (BLI_system_thread_count() < 2) {
+    BKE_image_prefetch_gpu_textures(images, iusers, images_len);
+    return;
+  }
+
+  BLI_mutex_lock(&image_load_mutex);
+
+  if (image_load_pool && images_loading.is_empty()) {
+    BLI_task_pool_work_and_wait(image_load_pool);
+    BLI_task_pool_free(image_load_pool);
+    image_load_pool = nullptr;
+  }
+
+  for (int i = 0; i < images_len; i++) {
+    Image *ima = images[i];
+    /* Tiled images need all tiles at once for their texture, they are loaded when drawing. */
+    if (ima == nullptr || ima->source != IMA_SRC_FILE || BKE_image_has_opengl_texture(ima) ||
+        images_loading.contains(ima) || BKE_image_has_loaded_ibuf(ima)) {
+      continue;
+    }
+
+    ImagePrefetchItem *item = MEM_cnew<ImagePrefetchItem>(__func__);
+    item->image = ima;
+    if (iusers[i]) {
+      item->iuser = *iusers[i];
+    }
+    else {
+      BKE_imageuser_default(&item->iuser);
+    }
+
+    if (image_load_pool == nullptr) {
+      image_load_pool = BLI_task_pool_create(nullptr, TASK_PRIORITY_LOW);
+    }
+    images_loading.add(ima);
+    BLI_task_pool_push(image_load_pool, image_load_task_run, item, true, nullptr);
+  }
+
+  BLI_mutex_unlock(&image_load_mutex);
+}
+
+bool BKE_image_is_loading_gpu_texture(Image *image)
+{
+  BLI_mutex_lock(&image_load_mutex);
+  const bool is_loading = images_loading.contains(image);
+  BLI_mutex_unlock(&image_load_mutex);
+  return is_loading;
+}
+
+void BKE_image_load_gpu_textures_wait(Image *image)
+{
+  /* Also frees the pool when all loads finished, so it doesn't outlive the images. */
+  BLI_mutex_lock(&image_load_mutex);
+  TaskPool *pool = nullptr;
+  if (images_loading.contains(image) || images_loading.is_empty()) {
+    pool = image_load_pool;
+    image_load_pool = nullptr;
+  }
+  BLI_mutex_unlock(&image_load_mutex);
+
+  if (pool) {
+    BLI_task_pool_work_and_wait(pool);
+    BLI_task_pool_free(pool);
+  }
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -15,6 +15,7 @@
 #include "BLI_endian_switch.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -604,6 +605,11 @@ static void rel_flerp(int tot, float *in, const float *ref, const float *out, fl
 {
   int a;
 
+  /* Elements masked out by a vertex group are not changed. */
+  if (fac == 0.0f) {
+    return;
+  }
+
   for (a = 0; a < tot; a++) {
     in[a] -= fac * (ref[a] - out[a]);
   }
@@ -921,6 +927,9 @@ static void key_evaluate_relative(const int start,
         poin += start * poinsize;
         reffrom += key->elemsize * start; /* key elemsize yes! */
         from += key->elemsize * start;
+        if (weights) {
+          weights += start / step;
+        }
 
         for (b = start; b < end; b += step) {
 
@@ -1376,6 +1385,34 @@ static void keyblock_free_per_block_weights(Key *key,
   MEM_freeN(per_keyblock_weights);
 }
 
+/* Number of vertices blended by a single task, see #do_mesh_key. */
+#define KEY_MESH_TASK_CHUNK_SIZE 4096
+
+typedef struct KeyMeshRelativeData {
+  char *out;
+  int tot;
+  Key *key;
+  KeyBlock *actkb;
+  float **per_keyblock_weights;
+} KeyMeshRelativeData;
+
+static void key_evaluate_relative_mesh_task(void *__restrict userdata,
+                                            const int chunk,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  KeyMeshRelativeData *data = userdata;
+  const int start = chunk * KEY_MESH_TASK_CHUNK_SIZE;
+  const int end = min_ii(start + KEY_MESH_TASK_CHUNK_SIZE, data->tot);
+  key_evaluate_relative(start,
+                        end,
+                        data->tot,
+                        data->out,
+                        data->key,
+                        data->actkb,
+                        data->per_keyblock_weights,
+                        KEY_MODE_DUMMY);
+}
+
 static void do_mesh_key(Object *ob, Key *key, char *out, const int tot)
 {
   KeyBlock *k[4], *actkb = BKE_keyblock_from_object(ob);
@@ -1386,8 +1423,32 @@ static void do_mesh_key(Object *ob, Key *key, char *out, const int tot)
     WeightsArrayCache cache = {0, NULL};
     float **per_keyblock_weights;
     per_keyblock_weights = keyblock_get_per_block_weights(ob, key, &cache);
-    key_evaluate_relative(
-        0, tot, tot, (char *)out, key, actkb, per_keyblock_weights, KEY_MODE_DUMMY);
+
+    /* Every vertex only depends on the same vertex of the key blocks, so ranges of vertices can
+     * be blended in parallel with the same result. In edit-mode the active key is copied from the
+     * BMesh for every call, so don't split the work then. */
+    const Mesh *me = (const Mesh *)key->from;
+    if (tot > KEY_MESH_TASK_CHUNK_SIZE && me->edit_mesh == NULL) {
+      KeyMeshRelativeData data = {
+          .out = out,
+          .tot = tot,
+          .key = key,
+          .actkb = actkb,
+          .per_keyblock_weights = per_keyblock_weights,
+      };
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      settings.min_iter_per_thread = 1;
+      BLI_task_parallel_range(0,
+                              (tot + KEY_MESH_TASK_CHUNK_SIZE - 1) / KEY_MESH_TASK_CHUNK_SIZE,
+                              &data,
+                              key_evaluate_relative_mesh_task,
+                              &settings);
+    }
+    else {
+      key_evaluate_relative(
+          0, tot, tot, (char *)out, key, actkb, per_keyblock_weights, KEY_MODE_DUMMY);
+    }
     keyblock_free_per_block_weights(key, per_keyblock_weights, &cache);
   }
   else {
@@ -2008,17 +2008,23 @@ void BKE_library_make_local(Main *bmain,
    * ID in a separated loop,
    * as lbarray ordering is not enough to ensure us we did catch all dependencies
    * (e.g. if making local a parent object before its child...). See T48907. */
-  /* TODO: This is now the biggest step by far (in term of processing time).
-   * We may be able to gain here by using again main->relations mapping, but...
-   * this implies BKE_libblock_remap & co to be able to update main->relations on the fly.
-   * Have to think about it a bit more, and see whether new code is OK first, anyway. */
+  /* All IDs are remapped at once, so that Main is only walked once instead of once per copied
+   * ID, this used to be the biggest step by far (in term of processing time). */
+  struct IDRemapper *id_remapper = BKE_id_remapper_create();
   for (LinkNode *it = copied_ids; it; it = it->next) {
     ID *id = it->link;
 
     BLI_assert(id->newid != NULL);
     BLI_assert(ID_IS_LINKED(id));
 
-    BKE_libblock_remap(bmain, id, id->newid, ID_REMAP_SKIP_INDIRECT_USAGE);
+    BKE_id_remapper_add(id_remapper, id, id->newid);
+  }
+  BKE_libblock_remap_multiple(bmain, id_remapper, ID_REMAP_SKIP_INDIRECT_USAGE);
+  BKE_id_remapper_free(id_remapper);
+
+  for (LinkNode *it = copied_ids; it; it = it->next) {
+    ID *id = it->link;
+
     if (old_to_new_ids) {
       BLI_ghash_insert(old_to_new_ids, id, id->newid);
     }
@@ -2271,11 +2271,53 @@ static int lib_override_libraries_index_define(Main *bmain)
   return library_indirect_level_max;
 }
 
+/**
+ * Tag which library indirect levels contain overrides that are part of a hierarchy, i.e. that may
+ * need to be resynced. Levels without any such override can be skipped entirely, which avoids
+ * building the relations of the whole Main and tagging all hierarchies again for each of them.
+ *
+ * \return false if there are no such overrides at all.
+ */
+static bool lib_override_library_main_resync_levels_tag(Main *bmain,
+                                                        const int library_indirect_level_max,
+                                                        bool *r_level_has_overrides)
+{
+  memset(r_level_has_overrides,
+         0,
+         sizeof(*r_level_has_overrides) * (size_t)(library_indirect_level_max + 1));
+
+  bool has_overrides = false;
+  ID *id;
+  FOREACH_MAIN_ID_BEGIN (bmain, id) {
+    if (!ID_IS_OVERRIDE_LIBRARY_REAL(id) ||
+        (id->override_library->flag & IDOVERRIDE_LIBRARY_FLAG_NO_HIERARCHY) != 0) {
+      continue;
+    }
+    const int id_lib_level = ID_IS_LINKED(id) ? id->lib->temp_index : 0;
+    BLI_assert(id_lib_level <= library_indirect_level_max);
+    r_level_has_overrides[id_lib_level] = true;
+    has_overrides = true;
+  }
+  FOREACH_MAIN_ID_END;
+
+  return has_overrides;
+}
+
 void BKE_lib_override_library_main_resync(Main *bmain,
                                           Scene *scene,
                                           ViewLayer *view_layer,
                                           BlendFileReadReport *reports)
 {
+  int library_indirect_level = lib_override_libraries_index_define(bmain);
+  bool *level_has_overrides = MEM_mallocN(
+      sizeof(*level_has_overrides) * (size_t)(library_indirect_level + 1), __func__);
+  if (!lib_override_library_main_resync_levels_tag(
+          bmain, library_indirect_level, level_has_overrides)) {
+    /* Nothing to resync, don't add and remove the residual storage collection for nothing. */
+    MEM_freeN(level_has_overrides);
+    return;
+  }
+
   /* We use a specific collection to gather/store all 'orphaned' override collections and objects
    * generated by re-sync-process. This avoids putting them in scene's master collection. */
 #define OVERRIDE_RESYNC_RESIDUAL_STORAGE_NAME "OVERRIDE_RESYNC_LEFTOVERS"
@@ -2296,17 +2338,20 @@ void BKE_lib_override_library_main_resync(Main *bmain,
    * Ref. T73411. */
   BKE_layer_collection_resync_forbid();
 
-  int library_indirect_level = lib_override_libraries_index_define(bmain);
   while (library_indirect_level >= 0) {
-    /* Update overrides from each indirect level separately. */
-    lib_override_library_main_resync_on_library_indirect_level(bmain,
-                                                               scene,
-                                                               view_layer,
-                                                               override_resync_residual_storage,
-                                                               library_indirect_level,
-                                                               reports);
+    /* Update overrides from each indirect level separately. Resyncing a level only creates new
+     * overrides in that same level, so levels without overrides can still be skipped. */
+    if (level_has_overrides[library_indirect_level]) {
+      lib_override_library_main_resync_on_library_indirect_level(bmain,
+                                                                 scene,
+                                                                 view_layer,
+                                                                 override_resync_residual_storage,
+                                                                 library_indirect_level,
+                                                                 reports);
+    }
     library_indirect_level--;
   }
+  MEM_freeN(level_has_overrides);
 
   BKE_layer_collection_resync_allow();
 
@@ -2349,18 +2394,19 @@ void BKE_lib_override_library_delete(Main *bmain, ID *id_root)
   BKE_main_relations_free(bmain);
   lib_override_group_tag_data_clear(&data);
 
+  /* Remap the whole local IDs to use the linked data, all at once. */
+  struct IDRemapper *remapper = BKE_id_remapper_create();
   ID *id;
   FOREACH_MAIN_ID_BEGIN (bmain, id) {
     if (id->tag & LIB_TAG_DOIT) {
       if (ID_IS_OVERRIDE_LIBRARY_REAL(id)) {
-        ID *id_override_reference = id->override_library->reference;
-
-        /* Remap the whole local IDs to use the linked data. */
-        BKE_libblock_remap(bmain, id, id_override_reference, ID_REMAP_SKIP_INDIRECT_USAGE);
+        BKE_id_remapper_add(remapper, id, id->override_library->reference);
       }
     }
   }
   FOREACH_MAIN_ID_END;
+  BKE_libblock_remap_multiple(bmain, remapper, ID_REMAP_SKIP_INDIRECT_USAGE);
+  BKE_id_remapper_free(remapper);
 
   /* Delete the override IDs. */
   BKE_id_multi_tagged_delete(bmain);
@@ -5,6 +5,8 @@
  * \ingroup bke
  */
 
+#include <atomic>
+
 #include "MEM_guardedalloc.h"
 
 /* Allow using deprecated functionality for .blend file I/O. */
@@ -1003,6 +1005,95 @@ static void mesh_ensure_cdlayers_primary(Mesh *mesh, bool do_tessface)
   }
 }
 
+static const char *mesh_arrays_validate(const int verts_num,
+                                        const int *face_offsets,
+                                        const int faces_num,
+                                        const int *corner_verts,
+                                        const int corners_num)
+{
+  using namespace blender;
+  if (face_offsets[0] != 0 || face_offsets[faces_num] != corners_num) {
+    return "Face offsets must start at zero and end at the number of corners";
+  }
+  std::atomic<bool> faces_valid = true;
+  threading::parallel_for(IndexRange(faces_num), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      if (face_offsets[i + 1] - face_offsets[i] < 3) {
+        faces_valid = false;
+        return;
+      }
+    }
+  });
+  if (!faces_valid) {
+    return "Faces must have at least 3 corners and offsets must be increasing";
+  }
+  std::atomic<bool> corners_valid = true;
+  threading::parallel_for(IndexRange(corners_num), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      if (corner_verts[i] < 0 || corner_verts[i] >= verts_num) {
+        corners_valid = false;
+        return;
+      }
+    }
+  });
+  if (!corners_valid) {
+    return "Corner vertex indices must be in the range of vertices";
+  }
+  return nullptr;
+}
+
+const char *BKE_mesh_assign_from_arrays(Mesh *mesh,
+                                        const float (*positions)[3],
+                                        const int verts_num,
+                                        const int *face_offsets,
+                                        const int faces_num,
+                                        const int *corner_verts,
+                                        const int corners_num)
+{
+  using namespace blender;
+  if (mesh->edit_mesh) {
+    return "Mesh is in edit mode";
+  }
+  if (mesh->key) {
+    return "Mesh has shape keys";
+  }
+  if (const char *error = mesh_arrays_validate(
+          verts_num, face_offsets, faces_num, corner_verts, corners_num)) {
+    return error;
+  }
+
+  BKE_mesh_runtime_clear_cache(mesh);
+  mesh_clear_geometry(mesh);
+  mesh->totvert = verts_num;
+  mesh->totloop = corners_num;
+  mesh->totpoly = faces_num;
+  mesh_ensure_cdlayers_primary(mesh, false);
+  BKE_mesh_update_customdata_pointers(mesh, false);
+
+  threading::parallel_for(IndexRange(verts_num), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      copy_v3_v3(mesh->mvert[i].co, positions[i]);
+    }
+  });
+  threading::parallel_for(IndexRange(faces_num), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      MPoly &poly = mesh->mpoly[i];
+      poly.loopstart = face_offsets[i];
+      poly.totloop = face_offsets[i + 1] - face_offsets[i];
+    }
+  });
+  threading::parallel_for(IndexRange(corners_num), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      mesh->mloop[i].v = uint(corner_verts[i]);
+    }
+  });
+
+  /* Also assigns the edge indices of the corners. */
+  BKE_mesh_calc_edges(mesh, false, false);
+  BKE_mesh_normals_tag_dirty(mesh);
+  return nullptr;
+}
+
 Mesh *BKE_mesh_new_nomain(
     int verts_len, int edges_len, int tessface_len, int loops_len, int polys_len)
 {
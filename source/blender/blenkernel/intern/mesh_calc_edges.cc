@@ -10,7 +10,6 @@
 
 #include "BLI_map.hh"
 #include "BLI_task.hh"
-#include "BLI_threads.h"
 #include "BLI_timeit.hh"
 
 #include "BKE_customdata.h"
@@ -117,8 +116,14 @@ static void add_polygon_edges_to_hash_maps(Mesh *mesh,
   });
 }
 
+/**
+ * \param r_orig_edge_indices: When not empty, the index of the original edge of every new edge is
+ * written into it, or -1 for edges that did not exist before.
+ */
 static void serialize_and_initialize_deduplicated_edges(MutableSpan<EdgeMap> edge_maps,
+                                                        const Span<MEdge> orig_edges,
                                                         MutableSpan<MEdge> new_edges,
+                                                        MutableSpan<int> r_orig_edge_indices,
                                                         short new_edge_flag)
 {
   /* All edges are distributed in the hash tables now. They have to be serialized into a single
@@ -147,6 +152,9 @@ static void serialize_and_initialize_deduplicated_edges(MutableSpan<EdgeMap> edg
         new_edge.v2 = item.key.v_high;
         new_edge.flag = new_edge_flag;
       }
+      if (!r_orig_edge_indices.is_empty()) {
+        r_orig_edge_indices[new_edge_index] = orig_edge ? int(orig_edge - orig_edges.data()) : -1;
+      }
       item.value.index = new_edge_index;
       new_edge_index++;
     }
@@ -191,10 +199,29 @@ static int get_parallel_maps_count(const Mesh *mesh)
   if (mesh->totpoly < 1000) {
     return 1;
   }
-  /* Use at most 8 separate hash tables. Using more threads has diminishing returns. These threads
-   * can better do something more useful instead. */
-  const int system_thread_count = BLI_system_thread_count();
-  return power_of_2_min_i(std::min(8, system_thread_count));
+  /* Use 8 separate hash tables. Using more threads has diminishing returns. These threads can
+   * better do something more useful instead. The number does not depend on the number of threads
+   * of the system, because the order of the new edges depends on it. That way the same mesh gets
+   * the same edge indices on every computer. */
+  return 8;
+}
+
+/**
+ * Copy the edge attributes of the original edges to the new edges. Edges that did not exist
+ * before keep their zero-initialized values.
+ */
+static void copy_orig_edge_custom_data(const CustomData &orig_edata,
+                                       CustomData &new_edata,
+                                       const Span<int> orig_edge_indices)
+{
+  threading::parallel_for(orig_edge_indices.index_range(), 4096, [&](IndexRange range) {
+    for (const int new_edge_index : range) {
+      const int orig_edge_index = orig_edge_indices[new_edge_index];
+      if (orig_edge_index != -1) {
+        CustomData_copy_data(&orig_edata, &new_edata, orig_edge_index, new_edge_index, 1);
+      }
+    }
+  });
 }
 
 static void clear_hash_tables(MutableSpan<EdgeMap> edge_maps)
@@ -230,17 +257,35 @@ void BKE_mesh_calc_edges(Mesh *mesh, bool keep_existing_edges, const bool select
     new_totedge += edge_map.size();
   }
 
-  /* Create new edges. */
+  /* Create new edges. When existing edges are kept, their attributes are copied as well. */
+  CustomData new_edata;
+  const bool keep_edge_attributes = keep_existing_edges &&
+                                    CustomData_number_of_layers_typemask(
+                                        &mesh->edata, CD_MASK_EVERYTHING.emask & ~CD_MASK_MEDGE);
+  if (keep_edge_attributes) {
+    CustomData_copy(&mesh->edata, &new_edata, CD_MASK_EVERYTHING.emask, CD_CALLOC, new_totedge);
+  }
+  else {
+    CustomData_reset(&new_edata);
+  }
+  if (!CustomData_has_layer(&new_edata, CD_MEDGE)) {
+    CustomData_add_layer(&new_edata, CD_MEDGE, CD_CALLOC, nullptr, new_totedge);
+  }
   MutableSpan<MEdge> new_edges{
-      static_cast<MEdge *>(MEM_calloc_arrayN(new_totedge, sizeof(MEdge), __func__)), new_totedge};
+      static_cast<MEdge *>(CustomData_get_layer(&new_edata, CD_MEDGE)), new_totedge};
+  Array<int> orig_edge_indices(keep_edge_attributes ? new_totedge : 0);
+
   const short new_edge_flag = (ME_EDGEDRAW | ME_EDGERENDER) | (select_new_edges ? SELECT : 0);
-  calc_edges::serialize_and_initialize_deduplicated_edges(edge_maps, new_edges, new_edge_flag);
+  calc_edges::serialize_and_initialize_deduplicated_edges(
+      edge_maps, {mesh->medge, mesh->totedge}, new_edges, orig_edge_indices, new_edge_flag);
   calc_edges::update_edge_indices_in_poly_loops(mesh, edge_maps, parallel_mask);
+  if (keep_edge_attributes) {
+    calc_edges::copy_orig_edge_custom_data(mesh->edata, new_edata, orig_edge_indices);
+  }
 
   /* Free old CustomData and assign new one. */
   CustomData_free(&mesh->edata, mesh->totedge);
-  CustomData_reset(&mesh->edata);
-  CustomData_add_layer(&mesh->edata, CD_MEDGE, CD_ASSIGN, new_edges.data(), new_totedge);
+  mesh->edata = new_edata;
   mesh->totedge = new_totedge;
   mesh->medge = new_edges.data();
 
@@ -22,6 +22,7 @@
 #include "BLI_memarena.h"
 #include "BLI_polyfill_2d.h"
 #include "BLI_rand.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_bvhutils.h"
@@ -470,6 +471,179 @@ typedef struct IslandResult {
 /* Will be enough in 99% of cases. */
 #define MREMAP_DEFAULT_BUFSIZE 32
 
+typedef struct MeshRemapVertsNearestData {
+  int mode;
+  const SpaceTransform *space_transform;
+  float max_dist_sq;
+  const MVert *verts_dst;
+  BVHTreeFromMesh *treedata;
+
+  const MEdge *edges_src;
+  const MPoly *polys_src;
+  const MLoop *loops_src;
+  const float (*vcos_src)[3];
+
+  /* Results, one per destination vertex, no source found when `sources_num` is zero. */
+  int *r_sources_num;
+  int (*r_indices)[2];
+  float (*r_weights)[2];
+} MeshRemapVertsNearestData;
+
+/**
+ * Each thread keeps its own last nearest hit,
+ * for the local proximity heuristics of #mesh_remap_bvhtree_query_nearest.
+ */
+typedef struct MeshRemapVertsNearestTLS {
+  BVHTreeNearest nearest;
+} MeshRemapVertsNearestTLS;
+
+static void mesh_remap_verts_nearest_cb(void *__restrict userdata,
+                                        const int i,
+                                        const TaskParallelTLS *__restrict tls)
+{
+  const MeshRemapVertsNearestData *data = userdata;
+  MeshRemapVertsNearestTLS *tls_data = tls->userdata_chunk;
+  BVHTreeNearest *nearest = &tls_data->nearest;
+  const int mode = data->mode;
+  float hit_dist;
+  float tmp_co[3];
+
+  copy_v3_v3(tmp_co, data->verts_dst[i].co);
+
+  /* Convert the vertex to tree coordinates, if needed. */
+  if (data->space_transform) {
+    BLI_space_transform_apply(data->space_transform, tmp_co);
+  }
+
+  data->r_sources_num[i] = 0;
+
+  if (!mesh_remap_bvhtree_query_nearest(
+          data->treedata, nearest, tmp_co, data->max_dist_sq, &hit_dist)) {
+    /* No source for this dest vertex! */
+    return;
+  }
+
+  int *indices = data->r_indices[i];
+  float *weights = data->r_weights[i];
+
+  if (mode == MREMAP_MODE_VERT_NEAREST) {
+    indices[0] = nearest->index;
+    weights[0] = 1.0f;
+    data->r_sources_num[i] = 1;
+  }
+  else if (ELEM(mode, MREMAP_MODE_VERT_EDGE_NEAREST, MREMAP_MODE_VERT_EDGEINTERP_NEAREST)) {
+    const MEdge *me = &data->edges_src[nearest->index];
+    const float *v1cos = data->vcos_src[me->v1];
+    const float *v2cos = data->vcos_src[me->v2];
+
+    if (mode == MREMAP_MODE_VERT_EDGE_NEAREST) {
+      const float dist_v1 = len_squared_v3v3(tmp_co, v1cos);
+      const float dist_v2 = len_squared_v3v3(tmp_co, v2cos);
+      indices[0] = (int)((dist_v1 > dist_v2) ? me->v2 : me->v1);
+      weights[0] = 1.0f;
+      data->r_sources_num[i] = 1;
+    }
+    else {
+      indices[0] = (int)me->v1;
+      indices[1] = (int)me->v2;
+
+      /* Weight is inverse of point factor here... */
+      weights[0] = line_point_factor_v3(tmp_co, v2cos, v1cos);
+      CLAMP(weights[0], 0.0f, 1.0f);
+      weights[1] = 1.0f - weights[0];
+      data->r_sources_num[i] = 2;
+    }
+  }
+  else if (mode == MREMAP_MODE_VERT_POLY_NEAREST) {
+    /* Closest vertex of the nearest polygon,
+     * same as #mesh_remap_interp_poly_data_get with `r_closest_index`. */
+    const MLoopTri *lt = &data->treedata->looptri[nearest->index];
+    const MPoly *mp = &data->polys_src[lt->poly];
+    const MLoop *ml = &data->loops_src[mp->loopstart];
+    float ref_dist_sq = FLT_MAX;
+
+    for (int j = 0; j < mp->totloop; j++, ml++) {
+      const float dist_sq = len_squared_v3v3(nearest->co, data->vcos_src[ml->v]);
+      if (dist_sq < ref_dist_sq) {
+        ref_dist_sq = dist_sq;
+        indices[0] = (int)ml->v;
+      }
+    }
+    weights[0] = 1.0f;
+    data->r_sources_num[i] = 1;
+  }
+}
+
+/**
+ * Vertex mappings which use a single nearest query per destination vertex and at most two
+ * sources, computed in parallel. Only storing the results in the map's memory arena is serial.
+ */
+static void mesh_remap_calc_verts_nearest(const int mode,
+                                          const SpaceTransform *space_transform,
+                                          const float max_dist_sq,
+                                          const MVert *verts_dst,
+                                          const int numverts_dst,
+                                          Mesh *me_src,
+                                          MeshPairRemap *r_map)
+{
+  BVHTreeFromMesh treedata = {NULL};
+  float(*vcos_src)[3] = NULL;
+
+  if (mode == MREMAP_MODE_VERT_NEAREST) {
+    BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_VERTS, 2);
+  }
+  else if (ELEM(mode, MREMAP_MODE_VERT_EDGE_NEAREST, MREMAP_MODE_VERT_EDGEINTERP_NEAREST)) {
+    vcos_src = BKE_mesh_vert_coords_alloc(me_src, NULL);
+    BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_EDGES, 2);
+  }
+  else {
+    BLI_assert(mode == MREMAP_MODE_VERT_POLY_NEAREST);
+    vcos_src = BKE_mesh_vert_coords_alloc(me_src, NULL);
+    BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_LOOPTRI, 2);
+  }
+
+  MeshRemapVertsNearestData data = {
+      .mode = mode,
+      .space_transform = space_transform,
+      .max_dist_sq = max_dist_sq,
+      .verts_dst = verts_dst,
+      .treedata = &treedata,
+      .edges_src = me_src->medge,
+      .polys_src = me_src->mpoly,
+      .loops_src = me_src->mloop,
+      .vcos_src = (const float(*)[3])vcos_src,
+      .r_sources_num = MEM_mallocN(sizeof(*data.r_sources_num) * (size_t)numverts_dst, __func__),
+      .r_indices = MEM_mallocN(sizeof(*data.r_indices) * (size_t)numverts_dst, __func__),
+      .r_weights = MEM_mallocN(sizeof(*data.r_weights) * (size_t)numverts_dst, __func__),
+  };
+
+  MeshRemapVertsNearestTLS tls = {{0}};
+  tls.nearest.index = -1;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (numverts_dst > 1024);
+  settings.userdata_chunk = &tls;
+  settings.userdata_chunk_size = sizeof(tls);
+  BLI_task_parallel_range(0, numverts_dst, &data, mesh_remap_verts_nearest_cb, &settings);
+
+  for (int i = 0; i < numverts_dst; i++) {
+    if (data.r_sources_num[i]) {
+      mesh_remap_item_define(
+          r_map, i, FLT_MAX, 0, data.r_sources_num[i], data.r_indices[i], data.r_weights[i]);
+    }
+    else {
+      BKE_mesh_remap_item_define_invalid(r_map, i);
+    }
+  }
+
+  MEM_freeN(data.r_sources_num);
+  MEM_freeN(data.r_indices);
+  MEM_freeN(data.r_weights);
+  MEM_SAFE_FREE(vcos_src);
+  free_bvhtree_from_mesh(&treedata);
+}
+
 void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
                                          const SpaceTransform *space_transform,
                                          const float max_dist,
@@ -501,80 +675,15 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
     float hit_dist;
     float tmp_co[3], tmp_no[3];
 
-    if (mode == MREMAP_MODE_VERT_NEAREST) {
-      BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_VERTS, 2);
-      nearest.index = -1;
-
-      for (i = 0; i < numverts_dst; i++) {
-        copy_v3_v3(tmp_co, verts_dst[i].co);
-
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
-
-        if (mesh_remap_bvhtree_query_nearest(
-                &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-          mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &nearest.index, &full_weight);
-        }
-        else {
-          /* No source for this dest vertex! */
-          BKE_mesh_remap_item_define_invalid(r_map, i);
-        }
-      }
-    }
-    else if (ELEM(mode, MREMAP_MODE_VERT_EDGE_NEAREST, MREMAP_MODE_VERT_EDGEINTERP_NEAREST)) {
-      MEdge *edges_src = me_src->medge;
-      float(*vcos_src)[3] = BKE_mesh_vert_coords_alloc(me_src, NULL);
-
-      BKE_bvhtree_from_mesh_get(&treedata, me_src, BVHTREE_FROM_EDGES, 2);
-      nearest.index = -1;
-
-      for (i = 0; i < numverts_dst; i++) {
-        copy_v3_v3(tmp_co, verts_dst[i].co);
-
-        /* Convert the vertex to tree coordinates, if needed. */
-        if (space_transform) {
-          BLI_space_transform_apply(space_transform, tmp_co);
-        }
-
-        if (mesh_remap_bvhtree_query_nearest(
-                &treedata, &nearest, tmp_co, max_dist_sq, &hit_dist)) {
-          MEdge *me = &edges_src[nearest.index];
-          const float *v1cos = vcos_src[me->v1];
-          const float *v2cos = vcos_src[me->v2];
-
-          if (mode == MREMAP_MODE_VERT_EDGE_NEAREST) {
-            const float dist_v1 = len_squared_v3v3(tmp_co, v1cos);
-            const float dist_v2 = len_squared_v3v3(tmp_co, v2cos);
-            const int index = (int)((dist_v1 > dist_v2) ? me->v2 : me->v1);
-            mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &index, &full_weight);
-          }
-          else if (mode == MREMAP_MODE_VERT_EDGEINTERP_NEAREST) {
-            int indices[2];
-            float weights[2];
-
-            indices[0] = (int)me->v1;
-            indices[1] = (int)me->v2;
-
-            /* Weight is inverse of point factor here... */
-            weights[0] = line_point_factor_v3(tmp_co, v2cos, v1cos);
-            CLAMP(weights[0], 0.0f, 1.0f);
-            weights[1] = 1.0f - weights[0];
-
-            mesh_remap_item_define(r_map, i, hit_dist, 0, 2, indices, weights);
-          }
-        }
-        else {
-          /* No source for this dest vertex! */
-          BKE_mesh_remap_item_define_invalid(r_map, i);
-        }
-      }
-
-      MEM_freeN(vcos_src);
+    if (ELEM(mode,
+             MREMAP_MODE_VERT_NEAREST,
+             MREMAP_MODE_VERT_EDGE_NEAREST,
+             MREMAP_MODE_VERT_EDGEINTERP_NEAREST,
+             MREMAP_MODE_VERT_POLY_NEAREST)) {
+      mesh_remap_calc_verts_nearest(
+          mode, space_transform, max_dist_sq, verts_dst, numverts_dst, me_src, r_map);
     }
     else if (ELEM(mode,
-                  MREMAP_MODE_VERT_POLY_NEAREST,
                   MREMAP_MODE_VERT_POLYINTERP_NEAREST,
                   MREMAP_MODE_VERT_POLYINTERP_VNORPROJ)) {
       MPoly *polys_src = me_src->mpoly;
@@ -640,37 +749,19 @@ void BKE_mesh_remap_calc_verts_from_mesh(const int mode,
             const MLoopTri *lt = &treedata.looptri[nearest.index];
             MPoly *mp = &polys_src[lt->poly];
 
-            if (mode == MREMAP_MODE_VERT_POLY_NEAREST) {
-              int index;
-              mesh_remap_interp_poly_data_get(mp,
-                                              loops_src,
-                                              (const float(*)[3])vcos_src,
-                                              nearest.co,
-                                              &tmp_buff_size,
-                                              &vcos,
-                                              false,
-                                              &indices,
-                                              &weights,
-                                              false,
-                                              &index);
+            const int sources_num = mesh_remap_interp_poly_data_get(mp,
+                                                                    loops_src,
+                                                                    (const float(*)[3])vcos_src,
+                                                                    nearest.co,
+                                                                    &tmp_buff_size,
+                                                                    &vcos,
+                                                                    false,
+                                                                    &indices,
+                                                                    &weights,
+                                                                    true,
+                                                                    NULL);
 
-              mesh_remap_item_define(r_map, i, hit_dist, 0, 1, &index, &full_weight);
-            }
-            else if (mode == MREMAP_MODE_VERT_POLYINTERP_NEAREST) {
-              const int sources_num = mesh_remap_interp_poly_data_get(mp,
-                                                                      loops_src,
-                                                                      (const float(*)[3])vcos_src,
-                                                                      nearest.co,
-                                                                      &tmp_buff_size,
-                                                                      &vcos,
-                                                                      false,
-                                                                      &indices,
-                                                                      &weights,
-                                                                      true,
-                                                                      NULL);
-
-              mesh_remap_item_define(r_map, i, hit_dist, 0, sources_num, indices, weights);
-            }
+            mesh_remap_item_define(r_map, i, hit_dist, 0, sources_num, indices, weights);
           }
           else {
             /* No source for this dest vertex! */
@@ -19,6 +19,8 @@
 #include "BLI_math_vec_types.hh"
 #include "BLI_math_vector.h"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
+#include "BLI_virtual_array.hh"
 
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
@@ -45,9 +47,11 @@
 
 using blender::Array;
 using blender::float3;
+using blender::IndexMask;
 using blender::IndexRange;
 using blender::MutableSpan;
 using blender::Span;
+using blender::VArray;
 
 #ifdef WITH_QUADRIFLOW
 static Mesh *remesh_quadriflow(const Mesh *input_mesh,
@@ -192,16 +196,20 @@ static openvdb::FloatGrid::Ptr remesh_voxel_level_set_create(const Mesh *mesh,
   std::vector<openvdb::Vec3s> points(mesh->totvert);
   std::vector<openvdb::Vec3I> triangles(looptris.size());
 
-  for (const int i : IndexRange(mesh->totvert)) {
-    const float3 co = mesh->mvert[i].co;
-    points[i] = openvdb::Vec3s(co.x, co.y, co.z);
-  }
+  blender::threading::parallel_for(IndexRange(mesh->totvert), 4096, [&](IndexRange range) {
+    for (const int i : range) {
+      const float3 co = mesh->mvert[i].co;
+      points[i] = openvdb::Vec3s(co.x, co.y, co.z);
+    }
+  });
 
-  for (const int i : IndexRange(looptris.size())) {
-    const MLoopTri &loop_tri = looptris[i];
-    triangles[i] = openvdb::Vec3I(
-        mloop[loop_tri.tri[0]].v, mloop[loop_tri.tri[1]].v, mloop[loop_tri.tri[2]].v);
-  }
+  blender::threading::parallel_for(looptris.index_range(), 4096, [&](IndexRange range) {
+    for (const int i : range) {
+      const MLoopTri &loop_tri = looptris[i];
+      triangles[i] = openvdb::Vec3I(
+          mloop[loop_tri.tri[0]].v, mloop[loop_tri.tri[1]].v, mloop[loop_tri.tri[2]].v);
+    }
+  });
 
   openvdb::math::Transform::Ptr transform = openvdb::math::Transform::createLinearTransform(
       voxel_size);
@@ -228,31 +236,37 @@ static Mesh *remesh_voxel_volume_to_mesh(const openvdb::FloatGrid::Ptr level_set
   MutableSpan<MLoop> mloops{mesh->mloop, mesh->totloop};
   MutableSpan<MPoly> mpolys{mesh->mpoly, mesh->totpoly};
 
-  for (const int i : mverts.index_range()) {
-    copy_v3_v3(mverts[i].co, float3(vertices[i].x(), vertices[i].y(), vertices[i].z()));
-  }
-
-  for (const int i : IndexRange(quads.size())) {
-    MPoly &poly = mpolys[i];
-    const int loopstart = i * 4;
-    poly.loopstart = loopstart;
-    poly.totloop = 4;
-    mloops[loopstart].v = quads[i][0];
-    mloops[loopstart + 1].v = quads[i][3];
-    mloops[loopstart + 2].v = quads[i][2];
-    mloops[loopstart + 3].v = quads[i][1];
-  }
+  blender::threading::parallel_for(mverts.index_range(), 4096, [&](IndexRange range) {
+    for (const int i : range) {
+      copy_v3_v3(mverts[i].co, float3(vertices[i].x(), vertices[i].y(), vertices[i].z()));
+    }
+  });
+
+  blender::threading::parallel_for(IndexRange(quads.size()), 4096, [&](IndexRange range) {
+    for (const int i : range) {
+      MPoly &poly = mpolys[i];
+      const int loopstart = i * 4;
+      poly.loopstart = loopstart;
+      poly.totloop = 4;
+      mloops[loopstart].v = quads[i][0];
+      mloops[loopstart + 1].v = quads[i][3];
+      mloops[loopstart + 2].v = quads[i][2];
+      mloops[loopstart + 3].v = quads[i][1];
+    }
+  });
 
   const int triangle_loop_start = quads.size() * 4;
-  for (const int i : IndexRange(tris.size())) {
-    MPoly &poly = mpolys[quads.size() + i];
-    const int loopstart = triangle_loop_start + i * 3;
-    poly.loopstart = loopstart;
-    poly.totloop = 3;
-    mloops[loopstart].v = tris[i][2];
-    mloops[loopstart + 1].v = tris[i][1];
-    mloops[loopstart + 2].v = tris[i][0];
-  }
+  blender::threading::parallel_for(IndexRange(tris.size()), 4096, [&](IndexRange range) {
+    for (const int i : range) {
+      MPoly &poly = mpolys[quads.size() + i];
+      const int loopstart = triangle_loop_start + i * 3;
+      poly.loopstart = loopstart;
+      poly.totloop = 3;
+      mloops[loopstart].v = tris[i][2];
+      mloops[loopstart + 1].v = tris[i][1];
+      mloops[loopstart + 2].v = tris[i][0];
+    }
+  });
 
   BKE_mesh_calc_edges(mesh, false, false);
   BKE_mesh_normals_tag_dirty(mesh);
@@ -275,6 +289,11 @@ Mesh *BKE_mesh_remesh_voxel(const Mesh *mesh,
 #endif
 }
 
+static float3 get_vertex_position(const MVert &vert)
+{
+  return vert.co;
+}
+
 void BKE_mesh_remesh_reproject_paint_mask(Mesh *target, Mesh *source)
 {
   BVHTreeFromMesh bvhtree = {nullptr};
@@ -299,17 +318,20 @@ void BKE_mesh_remesh_reproject_paint_mask(Mesh *target, Mesh *source)
         &source->vdata, CD_PAINT_MASK, CD_CALLOC, nullptr, source->totvert);
   }
 
-  for (int i = 0; i < target->totvert; i++) {
-    float from_co[3];
-    BVHTreeNearest nearest;
-    nearest.index = -1;
-    nearest.dist_sq = FLT_MAX;
-    copy_v3_v3(from_co, target_verts[i].co);
-    BLI_bvhtree_find_nearest(bvhtree.tree, from_co, &nearest, bvhtree.nearest_callback, &bvhtree);
-    if (nearest.index != -1) {
-      target_mask[i] = source_mask[nearest.index];
-    }
-  }
+  const VArray<float3> target_positions = VArray<float3>::ForDerivedSpan<MVert,
+                                                                          get_vertex_position>(
+      {target_verts, target->totvert});
+  BLI_bvhtree_find_nearest_batch(bvhtree.tree,
+                                 IndexMask(target->totvert),
+                                 target_positions,
+                                 FLT_MAX,
+                                 bvhtree.nearest_callback,
+                                 &bvhtree,
+                                 [&](const int64_t i, const BVHTreeNearest &nearest) {
+                                   if (nearest.index != -1) {
+                                     target_mask[i] = source_mask[nearest.index];
+                                   }
+                                 });
   free_bvhtree_from_mesh(&bvhtree);
 }
 
@@ -342,30 +364,59 @@ void BKE_remesh_reproject_sculpt_face_sets(Mesh *target, Mesh *source)
   const MLoopTri *looptri = BKE_mesh_runtime_looptri_ensure(source);
   BKE_bvhtree_from_mesh_get(&bvhtree, source, BVHTREE_FROM_LOOPTRI, 2);
 
-  for (int i = 0; i < target->totpoly; i++) {
-    float from_co[3];
-    BVHTreeNearest nearest;
-    nearest.index = -1;
-    nearest.dist_sq = FLT_MAX;
-    const MPoly *mpoly = &target_polys[i];
-    BKE_mesh_calc_poly_center(mpoly, &target_loops[mpoly->loopstart], target_verts, from_co);
-    BLI_bvhtree_find_nearest(bvhtree.tree, from_co, &nearest, bvhtree.nearest_callback, &bvhtree);
-    if (nearest.index != -1) {
-      target_face_sets[i] = source_face_sets[looptri[nearest.index].poly];
+  Array<float3> poly_centers(target->totpoly);
+  blender::threading::parallel_for(poly_centers.index_range(), 1024, [&](IndexRange range) {
+    for (const int i : range) {
+      const MPoly *mpoly = &target_polys[i];
+      BKE_mesh_calc_poly_center(
+          mpoly, &target_loops[mpoly->loopstart], target_verts, poly_centers[i]);
     }
-    else {
-      target_face_sets[i] = 1;
-    }
-  }
+  });
+
+  BLI_bvhtree_find_nearest_batch(bvhtree.tree,
+                                 IndexMask(target->totpoly),
+                                 VArray<float3>::ForSpan(poly_centers),
+                                 FLT_MAX,
+                                 bvhtree.nearest_callback,
+                                 &bvhtree,
+                                 [&](const int64_t i, const BVHTreeNearest &nearest) {
+                                   if (nearest.index != -1) {
+                                     target_face_sets[i] =
+                                         source_face_sets[looptri[nearest.index].poly];
+                                   }
+                                   else {
+                                     target_face_sets[i] = 1;
+                                   }
+                                 });
   free_bvhtree_from_mesh(&bvhtree);
 }
 
 void BKE_remesh_reproject_vertex_paint(Mesh *target, const Mesh *source)
 {
+  int tot_color_layer = CustomData_number_of_layers(&source->vdata, CD_PROP_COLOR);
+  if (tot_color_layer == 0) {
+    return;
+  }
+
   BVHTreeFromMesh bvhtree = {nullptr};
   BKE_bvhtree_from_mesh_get(&bvhtree, source, BVHTREE_FROM_VERTS, 2);
 
-  int tot_color_layer = CustomData_number_of_layers(&source->vdata, CD_PROP_COLOR);
+  /* The nearest source vertex is the same for all layers, only look it up once. */
+  const MVert *target_verts = (const MVert *)CustomData_get_layer(&target->vdata, CD_MVERT);
+  const VArray<float3> target_positions = VArray<float3>::ForDerivedSpan<MVert,
+                                                                          get_vertex_position>(
+      {target_verts, target->totvert});
+  Array<int> nearest_indices(target->totvert);
+  BLI_bvhtree_find_nearest_batch(bvhtree.tree,
+                                 IndexMask(target->totvert),
+                                 target_positions,
+                                 FLT_MAX,
+                                 bvhtree.nearest_callback,
+                                 &bvhtree,
+                                 [&](const int64_t i, const BVHTreeNearest &nearest) {
+                                   nearest_indices[i] = nearest.index;
+                                 });
+  free_bvhtree_from_mesh(&bvhtree);
 
   for (int layer_n = 0; layer_n < tot_color_layer; layer_n++) {
     const char *layer_name = CustomData_get_layer_name(&source->vdata, CD_PROP_COLOR, layer_n);
@@ -374,21 +425,16 @@ void BKE_remesh_reproject_vertex_paint(Mesh *target, const Mesh *source)
 
     MPropCol *target_color = (MPropCol *)CustomData_get_layer_n(
         &target->vdata, CD_PROP_COLOR, layer_n);
-    MVert *target_verts = (MVert *)CustomData_get_layer(&target->vdata, CD_MVERT);
     const MPropCol *source_color = (const MPropCol *)CustomData_get_layer_n(
         &source->vdata, CD_PROP_COLOR, layer_n);
-    for (int i = 0; i < target->totvert; i++) {
-      BVHTreeNearest nearest;
-      nearest.index = -1;
-      nearest.dist_sq = FLT_MAX;
-      BLI_bvhtree_find_nearest(
-          bvhtree.tree, target_verts[i].co, &nearest, bvhtree.nearest_callback, &bvhtree);
-      if (nearest.index != -1) {
-        copy_v4_v4(target_color[i].color, source_color[nearest.index].color);
+    blender::threading::parallel_for(nearest_indices.index_range(), 4096, [&](IndexRange range) {
+      for (const int i : range) {
+        if (nearest_indices[i] != -1) {
+          copy_v4_v4(target_color[i].color, source_color[nearest_indices[i]].color);
+        }
       }
-    }
+    });
   }
-  free_bvhtree_from_mesh(&bvhtree);
 }
 
 struct Mesh *BKE_mesh_remesh_voxel_fix_poles(const Mesh *mesh)
@@ -271,6 +271,8 @@ void BKE_mesh_runtime_clear_geometry(Mesh *mesh)
 /* Draw Engine */
 void (*BKE_mesh_batch_cache_dirty_tag_cb)(Mesh *me, eMeshBatchDirtyMode mode) = NULL;
 void (*BKE_mesh_batch_cache_free_cb)(Mesh *me) = NULL;
+void *(*BKE_mesh_batch_cache_detach_cb)(Mesh *me, bool check_topology) = NULL;
+void (*BKE_mesh_batch_cache_attach_cb)(Mesh *me, void *batch_cache) = NULL;
 
 void BKE_mesh_batch_cache_dirty_tag(Mesh *me, eMeshBatchDirtyMode mode)
 {
@@ -284,6 +286,19 @@ void BKE_mesh_batch_cache_free(Mesh *me)
     BKE_mesh_batch_cache_free_cb(me);
   }
 }
+void *BKE_mesh_batch_cache_detach(Mesh *me, const bool check_topology)
+{
+  if (me->runtime.batch_cache) {
+    return BKE_mesh_batch_cache_detach_cb(me, check_topology);
+  }
+  return NULL;
+}
+void BKE_mesh_batch_cache_attach(Mesh *me, void *batch_cache)
+{
+  if (batch_cache) {
+    BKE_mesh_batch_cache_attach_cb(me, batch_cache);
+  }
+}
 
 /** \} */
 
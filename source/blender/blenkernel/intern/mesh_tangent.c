@@ -29,6 +29,49 @@
 #include "atomic_ops.h"
 #include "mikktspace.h"
 
+/* -------------------------------------------------------------------- */
+/** \name Mikktspace Threading
+ * \{ */
+
+/* Number of triangles or groups handled by one task. */
+#define MIKK_PARALLEL_CHUNK_SIZE 1024
+
+typedef struct MikkParallelRangeData {
+  void (*func)(void *data, int start, int end);
+  void *data;
+  int items_num;
+} MikkParallelRangeData;
+
+static void mikk_parallel_range_chunk_cb(void *__restrict userdata,
+                                         const int chunk,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const MikkParallelRangeData *data = userdata;
+  const int start = chunk * MIKK_PARALLEL_CHUNK_SIZE;
+  data->func(data->data, start, min_ii(start + MIKK_PARALLEL_CHUNK_SIZE, data->items_num));
+}
+
+void BKE_mesh_tangent_mikk_parallel_range(const struct SMikkTSpaceContext *UNUSED(context),
+                                          const int items_num,
+                                          void (*func)(void *data, int start, int end),
+                                          void *data)
+{
+  MikkParallelRangeData range_data = {
+      .func = func,
+      .data = data,
+      .items_num = items_num,
+  };
+  const int chunks_num = (items_num + MIKK_PARALLEL_CHUNK_SIZE - 1) / MIKK_PARALLEL_CHUNK_SIZE;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = chunks_num > 1;
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, chunks_num, &range_data, mikk_parallel_range_chunk_cb, &settings);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Mesh Tangent Calculations (Single Layer)
  * \{ */
@@ -143,6 +186,7 @@ void BKE_mesh_calc_loop_tangent_single_ex(const MVert *mverts,
   s_interface.m_getTexCoord = get_texture_coordinate;
   s_interface.m_getNormal = get_normal;
   s_interface.m_setTSpaceBasic = set_tspace;
+  s_interface.m_parallelRange = BKE_mesh_tangent_mikk_parallel_range;
 
   /* 0 if failed */
   if (genTangSpaceDefault(&s_context) == false) {
@@ -440,6 +484,7 @@ static void DM_calc_loop_tangents_thread(TaskPool *__restrict UNUSED(pool), void
     sInterface.m_getTexCoord = dm_ts_GetTextureCoordinate;
     sInterface.m_getNormal = dm_ts_GetNormal;
     sInterface.m_setTSpaceBasic = dm_ts_SetTSpace;
+    sInterface.m_parallelRange = BKE_mesh_tangent_mikk_parallel_range;
 
     /* 0 if failed */
     genTangSpaceDefault(&sContext);
@@ -37,6 +37,7 @@
 #include "BLI_session_uuid.h"
 #include "BLI_string.h"
 #include "BLI_string_utils.h"
+#include "BLI_trace.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -1002,7 +1003,16 @@ struct Mesh *BKE_modifier_modify_mesh(ModifierData *md,
   if (mti->dependsOnNormals && mti->dependsOnNormals(md)) {
     modwrap_dependsOnNormals(me);
   }
-  return mti->modifyMesh(md, ctx, me);
+
+  const bool use_trace = BLI_trace_is_enabled();
+  if (use_trace) {
+    BLI_trace_begin("modifier", md->name);
+  }
+  struct Mesh *result = mti->modifyMesh(md, ctx, me);
+  if (use_trace) {
+    BLI_trace_end();
+  }
+  return result;
 }
 
 void BKE_modifier_deform_verts(ModifierData *md,
@@ -1015,7 +1025,15 @@ void BKE_modifier_deform_verts(ModifierData *md,
   if (me && mti->dependsOnNormals && mti->dependsOnNormals(md)) {
     modwrap_dependsOnNormals(me);
   }
+
+  const bool use_trace = BLI_trace_is_enabled();
+  if (use_trace) {
+    BLI_trace_begin("modifier", md->name);
+  }
   mti->deformVerts(md, ctx, me, vertexCos, numVerts);
+  if (use_trace) {
+    BLI_trace_end();
+  }
 }
 
 void BKE_modifier_deform_vertsEM(ModifierData *md,
@@ -1966,6 +1966,22 @@ bool BKE_movieclip_put_frame_if_possible(MovieClip *clip, MovieClipUser *user, I
   return result;
 }
 
+void BKE_movieclip_prefetch_sequence_frame(MovieClip *clip, MovieClipUser *user)
+{
+  if (clip->source != MCLIP_SRC_SEQUENCE) {
+    return;
+  }
+  if (BKE_movieclip_has_cached_frame(clip, user)) {
+    return;
+  }
+
+  ImBuf *ibuf = movieclip_load_sequence_file(clip, user, user->framenr, clip->flag);
+  if (ibuf != NULL) {
+    BKE_movieclip_put_frame_if_possible(clip, user, ibuf);
+    IMB_freeImBuf(ibuf);
+  }
+}
+
 static void movieclip_selection_sync(MovieClip *clip_dst, const MovieClip *clip_src)
 {
   BLI_assert(clip_dst != clip_src);
@@ -2091,7 +2107,7 @@ GPUTexture *BKE_movieclip_get_gpu_texture(MovieClip *clip, MovieClipUser *cuser)
   const bool high_bitdepth = false;
   const bool store_premultiplied = ibuf->rect_float ? false : true;
   *tex = IMB_create_gpu_texture(
-      clip->id.name + 2, ibuf, high_bitdepth, store_premultiplied, false);
+      clip->id.name + 2, ibuf, high_bitdepth, store_premultiplied, false, false);
 
   /* Do not generate mips for movieclips... too slow. */
   GPU_texture_mipmap_mode(*tex, false, true);
@@ -39,6 +39,7 @@
 #include "BKE_material.h"
 #include "BKE_mball.h"
 #include "BKE_mesh.h"
+#include "BKE_modifier.h"
 #include "BKE_object.h"
 #include "BKE_particle.h"
 #include "BKE_pointcache.h"
@@ -329,12 +330,74 @@ void BKE_object_batch_cache_dirty_tag(Object *ob)
   BKE_object_data_batch_cache_dirty_tag(ob->data);
 }
 
+/**
+ * Whether the evaluated mesh can have a different topology or different UVs than the previous
+ * evaluation. This is not the case when the original mesh wasn't modified and all modifiers only
+ * deform it.
+ */
+static bool object_eval_mesh_topology_may_change(Scene *scene, Object *ob)
+{
+  /* `ob->data` is still the previous evaluated mesh, which doesn't have the update tags of the
+   * original mesh. Those are only copied to the copy-on-write mesh. */
+  const ID *mesh_id = ob->runtime.data_orig ? ob->runtime.data_orig : ob->data;
+  if (mesh_id->recalc & ID_RECALC_GEOMETRY) {
+    return true;
+  }
+  VirtualModifierData virtual_modifier_data;
+  for (ModifierData *md = BKE_modifiers_get_virtual_modifierlist(ob, &virtual_modifier_data); md;
+       md = md->next) {
+    if (!BKE_modifier_is_enabled(scene, md, eModifierMode_Realtime)) {
+      continue;
+    }
+    if (BKE_modifier_get_info(md->type)->type != eModifierTypeType_OnlyDeform) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * The evaluated mesh owned by the object is replaced by a new one on every evaluation.
+ * Detach its batch cache before it is freed, so that buffers which don't depend on the
+ * deformation can be re-used by the new evaluated mesh. The GPU buffers are only checked and
+ * discarded by the draw manager when the object is drawn.
+ */
+static void *object_eval_mesh_batch_cache_detach(Scene *scene, Object *ob)
+{
+  if (ob->type != OB_MESH || ob->runtime.data_eval == NULL || !ob->runtime.is_data_eval_owned) {
+    return NULL;
+  }
+  Mesh *mesh_eval = (Mesh *)ob->runtime.data_eval;
+  if (GS(mesh_eval->id.name) != ID_ME || mesh_eval->edit_mesh != NULL || ob->sculpt != NULL) {
+    return NULL;
+  }
+  return BKE_mesh_batch_cache_detach(mesh_eval, object_eval_mesh_topology_may_change(scene, ob));
+}
+
+static void object_eval_mesh_batch_cache_attach(Object *ob, void *batch_cache)
+{
+  if (batch_cache == NULL) {
+    return;
+  }
+  Mesh *mesh_eval = (Mesh *)ob->runtime.data_eval;
+  if (mesh_eval != NULL &&
+      (!ob->runtime.is_data_eval_owned || GS(mesh_eval->id.name) != ID_ME)) {
+    /* Not owned evaluated meshes can be shared with other objects, free the cache instead. */
+    mesh_eval = NULL;
+  }
+  BKE_mesh_batch_cache_attach(mesh_eval, batch_cache);
+}
+
 void BKE_object_eval_uber_data(Depsgraph *depsgraph, Scene *scene, Object *ob)
 {
   DEG_debug_print_eval(depsgraph, __func__, ob->id.name, ob);
   BLI_assert(ob->type != OB_ARMATURE);
+  void *mesh_batch_cache = object_eval_mesh_batch_cache_detach(scene, ob);
   BKE_object_handle_data_update(depsgraph, scene, ob);
   BKE_object_batch_cache_dirty_tag(ob);
+  /* The new evaluated mesh has no batch cache yet, so tagging doesn't affect the detached cache.
+   * The draw manager discards its buffers which the new evaluation invalidated. */
+  object_eval_mesh_batch_cache_attach(ob, mesh_batch_cache);
 }
 
 void BKE_object_eval_ptcache_reset(Depsgraph *depsgraph, Scene *scene, Object *object)
@@ -254,6 +254,61 @@ void BKE_ocean_eval_uv(struct Ocean *oc, struct OceanResult *ocr, float u, float
   BLI_rw_mutex_unlock(&oc->oceanmutex);
 }
 
+void BKE_ocean_eval_uv_displacement_array(struct Ocean *oc,
+                                          const float (*uv)[2],
+                                          float (*r_disp)[3],
+                                          const int uv_num)
+{
+  const int M = oc->_M;
+  const int N = oc->_N;
+
+  BLI_rw_mutex_lock(&oc->oceanmutex, THREAD_LOCK_READ);
+
+  for (int i = 0; i < uv_num; i++) {
+    float u = fmodf(uv[i][0], 1.0f);
+    float v = fmodf(uv[i][1], 1.0f);
+    if (u < 0) {
+      u += 1.0f;
+    }
+    if (v < 0) {
+      v += 1.0f;
+    }
+
+    const float uu = u * M;
+    const float vv = v * N;
+    int i0 = (int)uu;
+    int j0 = (int)vv;
+    const float frac_x = uu - i0;
+    const float frac_z = vv - j0;
+    const int i1 = (i0 + 1) % M;
+    const int j1 = (j0 + 1) % N;
+    i0 = i0 % M;
+    j0 = j0 % N;
+
+    const int ofs_00 = i0 * N + j0;
+    const int ofs_01 = i0 * N + j1;
+    const int ofs_10 = i1 * N + j0;
+    const int ofs_11 = i1 * N + j1;
+
+#  define BILERP(m) \
+    (interpf(interpf(m[ofs_11], m[ofs_01], frac_x), interpf(m[ofs_10], m[ofs_00], frac_x), frac_z))
+
+    r_disp[i][1] = oc->_do_disp_y ? BILERP(oc->_disp_y) : 0.0f;
+    if (oc->_do_chop) {
+      r_disp[i][0] = BILERP(oc->_disp_x);
+      r_disp[i][2] = BILERP(oc->_disp_z);
+    }
+    else {
+      r_disp[i][0] = 0.0f;
+      r_disp[i][2] = 0.0f;
+    }
+
+#  undef BILERP
+  }
+
+  BLI_rw_mutex_unlock(&oc->oceanmutex);
+}
+
 void BKE_ocean_eval_uv_catrom(struct Ocean *oc, struct OceanResult *ocr, float u, float v)
 {
   int i0, i1, i2, i3, j0, j1, j2, j3;
@@ -653,6 +708,15 @@ void BKE_ocean_simulate(struct Ocean *o, float t, float scale, float chop_amount
 
   BLI_rw_mutex_lock(&o->oceanmutex, THREAD_LOCK_WRITE);
 
+  /* The modifier evaluates the same frame several times, e.g. when the evaluated copy is created
+   * and when the modifier stack runs. The spectrum only depends on these parameters. */
+  if (o->_sim_is_valid && o->_sim_time == t && o->_sim_scale == scale &&
+      o->_sim_chop_amount == chop_amount) {
+    BLI_rw_mutex_unlock(&o->oceanmutex);
+    BLI_task_pool_free(pool);
+    return;
+  }
+
   /* Note about multi-threading here: we have to run a first set of computations (htilda one)
    * before we can run all others, since they all depend on it.
    * So we make a first parallelized forloop run for htilda,
@@ -689,6 +753,11 @@ void BKE_ocean_simulate(struct Ocean *o, float t, float scale, float chop_amount
 
   BLI_task_pool_work_and_wait(pool);
 
+  o->_sim_time = t;
+  o->_sim_scale = scale;
+  o->_sim_chop_amount = chop_amount;
+  o->_sim_is_valid = true;
+
   BLI_rw_mutex_unlock(&o->oceanmutex);
 
   BLI_task_pool_free(pool);
@@ -835,6 +904,7 @@ bool BKE_ocean_init(struct Ocean *o,
   o->_wz = -sin(w);        /* wave direction */
   o->_L = V * V / GRAVITY; /* largest wave for a given velocity V */
   o->time = time;
+  o->_sim_is_valid = false;
 
   /* Spectrum to use. */
   o->_spectrum = spectrum;
@@ -1568,6 +1638,14 @@ void BKE_ocean_eval_uv(struct Ocean *UNUSED(oc),
 {
 }
 
+void BKE_ocean_eval_uv_displacement_array(struct Ocean *UNUSED(oc),
+                                          const float (*uv)[2],
+                                          float (*r_disp)[3],
+                                          const int UNUSED(uv_num))
+{
+  UNUSED_VARS(uv, r_disp);
+}
+
 /* use catmullrom interpolation rather than linear */
 void BKE_ocean_eval_uv_catrom(struct Ocean *UNUSED(oc),
                               struct OceanResult *UNUSED(ocr),
@@ -41,6 +41,12 @@ typedef struct Ocean {
   float normalize_factor; /* init w */
   float time;
 
+  /* Parameters of the last simulation, to skip simulating the same state again. */
+  float _sim_time;
+  float _sim_scale;
+  float _sim_chop_amount;
+  bool _sim_is_valid;
+
   short _do_disp_y;
   short _do_normals;
   short _do_spray;
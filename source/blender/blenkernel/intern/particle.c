@@ -626,6 +626,21 @@ static void psys_free_path_cache_buffers(ParticleCacheKey **cache, ListBase *buf
   BLI_freelistN(bufs);
 }
 
+/**
+ * Check whether buffers allocated with #psys_alloc_path_cache_buffers for \a tot paths can be
+ * reused for paths with \a totkeys keys, so that they don't have to be reallocated on every update.
+ */
+static bool psys_path_cache_buffers_fit(const ListBase *bufs, int tot, int totkeys)
+{
+  const LinkData *buf = bufs->first;
+  if (buf == NULL) {
+    return false;
+  }
+  tot = MAX2(tot, 1);
+  return MEM_allocN_len(buf->data) ==
+         sizeof(ParticleCacheKey) * (size_t)MIN2(tot, PATH_CACHE_BUF_SIZE) * (size_t)totkeys;
+}
+
 /************************************************/
 /*          Getting stuff                       */
 /************************************************/
@@ -3196,6 +3211,12 @@ void psys_cache_child_paths(ParticleSimulationData *sim,
   if (editupdate && sim->psys->childcache && totchild == sim->psys->totchildcache) {
     /* just overwrite the existing cache */
   }
+  else if (sim->psys->childcache && totchild == sim->psys->totchildcache &&
+           psys_path_cache_buffers_fit(&sim->psys->childcachebufs,
+                                       totchild,
+                                       ctx.segments + ctx.extra_segments + 1)) {
+    /* The layout didn't change, every path is written again below. */
+  }
   else {
     /* clear out old and create new empty path cache */
     free_child_path_cache(sim->psys);
@@ -30,6 +30,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_edgehash.h"
+#include "BLI_hash.h"
 #include "BLI_kdopbvh.h"
 #include "BLI_kdtree.h"
 #include "BLI_linklist.h"
@@ -3682,10 +3683,21 @@ typedef struct DynamicStepSolverTaskData {
   float cfra;
   float timestep;
   float dtime;
+  /* Seed of the per-particle random numbers of the Newtonian solver. */
+  unsigned int rng_seed;
 
   SpinLock spin;
 } DynamicStepSolverTaskData;
 
+/**
+ * Thread local copy of the simulation data for the Newtonian solver, with its own random number
+ * generator. The generator is seeded for every particle, so that the result doesn't depend on
+ * how the particles are distributed over threads.
+ */
+typedef struct DynamicStepNewtonTLS {
+  ParticleSimulationData sim;
+} DynamicStepNewtonTLS;
+
 static void dynamics_step_sphdata_reduce(const void *__restrict UNUSED(userdata),
                                          void *__restrict join_v,
                                          void *__restrict chunk_v)
@@ -3806,6 +3818,49 @@ static void dynamics_step_sph_classical_integrate_task_cb_ex(void *__restrict us
   }
 }
 
+static void dynamics_step_newton_task_cb_ex(void *__restrict userdata,
+                                            const int p,
+                                            const TaskParallelTLS *__restrict tls)
+{
+  DynamicStepSolverTaskData *data = userdata;
+  DynamicStepNewtonTLS *newton_tls = tls->userdata_chunk;
+  ParticleSimulationData *sim = &newton_tls->sim;
+  ParticleSettings *part = sim->psys->part;
+
+  ParticleData *pa;
+
+  if ((pa = sim->psys->particles + p)->state.time <= 0.0f) {
+    return;
+  }
+
+  /* Created lazily, because the chunk is copied for every task. */
+  if (sim->rng == NULL) {
+    sim->rng = BLI_rng_new(0);
+  }
+  BLI_rng_seed(sim->rng, BLI_hash_int_2d((unsigned int)p, data->rng_seed));
+
+  /* do global forces & effectors */
+  basic_integrate(sim, p, pa->state.time, data->cfra);
+
+  /* deflection */
+  if (sim->colliders) {
+    collision_check(sim, p, pa->state.time, data->cfra);
+  }
+
+  /* rotations */
+  basic_rotate(part, pa, pa->state.time, data->timestep);
+}
+
+static void dynamics_step_newton_free(const void *__restrict UNUSED(userdata),
+                                      void *__restrict chunk_v)
+{
+  DynamicStepNewtonTLS *newton_tls = chunk_v;
+  if (newton_tls->sim.rng) {
+    BLI_rng_free(newton_tls->sim.rng);
+    newton_tls->sim.rng = NULL;
+  }
+}
+
 /* unbaked particles are calculated dynamically */
 static void dynamics_step(ParticleSimulationData *sim, float cfra)
 {
@@ -3934,19 +3989,28 @@ static void dynamics_step(ParticleSimulationData *sim, float cfra)
 
   switch (part->phystype) {
     case PART_PHYS_NEWTON: {
-      LOOP_DYNAMIC_PARTICLES
-      {
-        /* do global forces & effectors */
-        basic_integrate(sim, p, pa->state.time, cfra);
-
-        /* deflection */
-        if (sim->colliders) {
-          collision_check(sim, p, pa->state.time, cfra);
-        }
+      DynamicStepSolverTaskData task_data = {
+          .sim = sim,
+          .cfra = cfra,
+          .timestep = timestep,
+          .dtime = dtime,
+          /* Include the sub-frame, so that sub-steps get different random numbers. */
+          .rng_seed = BLI_hash_int_2d(31415926 + (unsigned int)psys->seed,
+                                      (unsigned int)(int)(cfra * 1000.0f)),
+      };
 
-        /* rotations */
-        basic_rotate(part, pa, pa->state.time, timestep);
-      }
+      DynamicStepNewtonTLS newton_tls = {.sim = *sim};
+      newton_tls.sim.rng = NULL;
+
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      settings.use_threading = (psys->totpart > 100);
+      settings.min_iter_per_thread = 64;
+      settings.userdata_chunk = &newton_tls;
+      settings.userdata_chunk_size = sizeof(newton_tls);
+      settings.func_free = dynamics_step_newton_free;
+      BLI_task_parallel_range(
+          0, psys->totpart, &task_data, dynamics_step_newton_task_cb_ex, &settings);
       break;
     }
     case PART_PHYS_BOIDS: {
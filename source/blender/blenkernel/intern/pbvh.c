@@ -234,16 +234,18 @@ void pbvh_grow_nodes(PBVH *pbvh, int totnode)
 
 /* Add a vertex to the map, with a positive value for unique vertices and
  * a negative value for additional vertices */
-static int map_insert_vert(
-    PBVH *pbvh, GHash *map, unsigned int *face_verts, unsigned int *uniq_verts, int vertex)
+static int map_insert_vert(GHash *map,
+                           unsigned int *face_verts,
+                           unsigned int *uniq_verts,
+                           const bool is_unique,
+                           int vertex)
 {
   void *key, **value_p;
 
   key = POINTER_FROM_INT(vertex);
   if (!BLI_ghash_ensure_p(map, key, &value_p)) {
     int value_i;
-    if (BLI_BITMAP_TEST(pbvh->vert_bitmap, vertex) == 0) {
-      BLI_BITMAP_ENABLE(pbvh->vert_bitmap, vertex);
+    if (is_unique) {
       value_i = *uniq_verts;
       (*uniq_verts)++;
     }
@@ -258,9 +260,11 @@ static int map_insert_vert(
   return POINTER_AS_INT(*value_p);
 }
 
-/* Find vertices used by the faces in this node and update the draw buffers */
-static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node)
+/* Find vertices used by the faces in this node and update the draw buffers.
+ * A vertex is unique to the node if the node is its owner in `vert_owners`. */
+static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node, const int *vert_owners)
 {
+  const int node_index = (int)(node - pbvh->nodes);
   bool has_visible = false;
 
   node->uniq_verts = node->face_verts = 0;
@@ -280,8 +284,12 @@ static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node)
   for (int i = 0; i < totface; i++) {
     const MLoopTri *lt = &pbvh->looptri[node->prim_indices[i]];
     for (int j = 0; j < 3; j++) {
-      face_vert_indices[i][j] = map_insert_vert(
-          pbvh, map, &node->face_verts, &node->uniq_verts, pbvh->mloop[lt->tri[j]].v);
+      const int vertex = pbvh->mloop[lt->tri[j]].v;
+      face_vert_indices[i][j] = map_insert_vert(map,
+                                                &node->face_verts,
+                                                &node->uniq_verts,
+                                                vert_owners[vertex] == node_index,
+                                                vertex);
     }
 
     if (has_visible == false) {
@@ -325,13 +333,12 @@ static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node)
   BLI_ghash_free(map, NULL, NULL);
 }
 
-static void update_vb(PBVH *pbvh, PBVHNode *node, BBC *prim_bbc, int offset, int count)
+static void update_vb(PBVH *pbvh, BB *vb, BBC *prim_bbc, int offset, int count)
 {
-  BB_reset(&node->vb);
+  BB_reset(vb);
   for (int i = offset + count - 1; i >= offset; i--) {
-    BB_expand_with_bb(&node->vb, (BB *)(&prim_bbc[pbvh->prim_indices[i]]));
+    BB_expand_with_bb(vb, (BB *)(&prim_bbc[pbvh->prim_indices[i]]));
   }
-  node->orig_vb = node->vb;
 }
 
 int BKE_pbvh_count_grid_quads(BLI_bitmap **grid_hidden,
@@ -394,24 +401,77 @@ static void build_grid_leaf_node(PBVH *pbvh, PBVHNode *node)
   BKE_pbvh_node_mark_rebuild_draw(node);
 }
 
-static void build_leaf(PBVH *pbvh, int node_index, BBC *prim_bbc, int offset, int count)
+typedef struct PBVHLeafBuildData {
+  PBVH *pbvh;
+  const int *leaf_indices;
+  /* For each vertex, the index of the leaf it is unique to. */
+  int *vert_owners;
+} PBVHLeafBuildData;
+
+/* Make the leaf with the lowest index that uses a vertex its owner. Unlike giving the vertex to
+ * the first leaf that is built, this doesn't depend on the order the leaves are built in. */
+static void mesh_leaf_claim_verts_task_cb(void *__restrict userdata,
+                                          const int n,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  pbvh->nodes[node_index].flag |= PBVH_Leaf;
+  PBVHLeafBuildData *data = userdata;
+  PBVH *pbvh = data->pbvh;
+  const int node_index = data->leaf_indices[n];
+  const PBVHNode *node = &pbvh->nodes[node_index];
 
-  pbvh->nodes[node_index].prim_indices = pbvh->prim_indices + offset;
-  pbvh->nodes[node_index].totprim = count;
+  for (int i = 0; i < node->totprim; i++) {
+    const MLoopTri *lt = &pbvh->looptri[node->prim_indices[i]];
+    for (int j = 0; j < 3; j++) {
+      int *owner = &data->vert_owners[pbvh->mloop[lt->tri[j]].v];
+      int old_owner = *owner;
+      while (node_index < old_owner) {
+        const int prev_owner = atomic_cas_int32(owner, old_owner, node_index);
+        if (prev_owner == old_owner) {
+          break;
+        }
+        old_owner = prev_owner;
+      }
+    }
+  }
+}
 
-  /* Still need vb for searches */
-  update_vb(pbvh, &pbvh->nodes[node_index], prim_bbc, offset, count);
+static void build_leaf_task_cb(void *__restrict userdata,
+                               const int n,
+                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PBVHLeafBuildData *data = userdata;
+  PBVH *pbvh = data->pbvh;
+  PBVHNode *node = &pbvh->nodes[data->leaf_indices[n]];
 
   if (pbvh->looptri) {
-    build_mesh_leaf_node(pbvh, pbvh->nodes + node_index);
+    build_mesh_leaf_node(pbvh, node, data->vert_owners);
   }
   else {
-    build_grid_leaf_node(pbvh, pbvh->nodes + node_index);
+    build_grid_leaf_node(pbvh, node);
   }
 }
 
+static void build_leaves(PBVH *pbvh, const int *leaf_indices, int totleaf)
+{
+  PBVHLeafBuildData data = {
+      .pbvh = pbvh,
+      .leaf_indices = leaf_indices,
+  };
+
+  TaskParallelSettings settings;
+  BKE_pbvh_parallel_range_settings(&settings, true, totleaf);
+
+  if (pbvh->looptri) {
+    data.vert_owners = MEM_mallocN(sizeof(int) * pbvh->totvert, "bvh vert owners");
+    copy_vn_i(data.vert_owners, pbvh->totvert, INT_MAX);
+    BLI_task_parallel_range(0, totleaf, &data, mesh_leaf_claim_verts_task_cb, &settings);
+  }
+
+  BLI_task_parallel_range(0, totleaf, &data, build_leaf_task_cb, &settings);
+
+  MEM_SAFE_FREE(data.vert_owners);
+}
+
 /* Return zero if all primitives in the node can be drawn with the
  * same material (including flat/smooth shading), non-zero otherwise */
 static bool leaf_needs_material_split(PBVH *pbvh, int offset, int count)
@@ -446,6 +506,22 @@ static bool leaf_needs_material_split(PBVH *pbvh, int offset, int count)
   return false;
 }
 
+/* Node of the tree while it is built. The tree is built with temporary nodes so that
+ * sub-trees can be built in parallel, the nodes are moved to #PBVH.nodes afterwards. */
+typedef struct PBVHBuildNode {
+  struct PBVHBuildNode *children[2];
+  BB vb;
+  int offset, count;
+} PBVHBuildNode;
+
+typedef struct PBVHBuildData {
+  PBVH *pbvh;
+  BBC *prim_bbc;
+  int totleaf;
+} PBVHBuildData;
+
+static void build_sub_task(TaskPool *__restrict pool, void *taskdata);
+
 /* Recursively build a node in the tree
  *
  * vb is the voxel box around all of the primitives contained in
@@ -454,30 +530,32 @@ static bool leaf_needs_material_split(PBVH *pbvh, int offset, int count)
  * cb is the bounding box around all the centroids of the primitives
  * contained in this node
  *
- * offset and start indicate a range in the array of primitive indices
+ * offset and count indicate a range in the array of primitive indices
+ *
+ * Large sub-trees are pushed to the pool to be built by other threads.
  */
 
-static void build_sub(PBVH *pbvh, int node_index, BB *cb, BBC *prim_bbc, int offset, int count)
+static void build_sub(PBVHBuildData *data, TaskPool *pool, PBVHBuildNode *node, BB *cb)
 {
+  PBVH *pbvh = data->pbvh;
+  BBC *prim_bbc = data->prim_bbc;
+  const int offset = node->offset;
+  const int count = node->count;
   int end;
   BB cb_backing;
 
+  /* Leaves still need vb for searches */
+  update_vb(pbvh, &node->vb, prim_bbc, offset, count);
+
   /* Decide whether this is a leaf or not */
   const bool below_leaf_limit = count <= pbvh->leaf_limit;
   if (below_leaf_limit) {
     if (!leaf_needs_material_split(pbvh, offset, count)) {
-      build_leaf(pbvh, node_index, prim_bbc, offset, count);
+      atomic_add_and_fetch_int32(&data->totleaf, 1);
       return;
     }
   }
 
-  /* Add two child nodes */
-  pbvh->nodes[node_index].children_offset = pbvh->totnode;
-  pbvh_grow_nodes(pbvh, pbvh->totnode + 2);
-
-  /* Update parent node bounding box */
-  update_vb(pbvh, &pbvh->nodes[node_index], prim_bbc, offset, count);
-
   if (!below_leaf_limit) {
     /* Find axis with widest range of primitive centroids */
     if (!cb) {
@@ -502,14 +580,58 @@ static void build_sub(PBVH *pbvh, int node_index, BB *cb, BBC *prim_bbc, int off
     end = partition_indices_material(pbvh, offset, offset + count - 1);
   }
 
-  /* Build children */
-  build_sub(pbvh, pbvh->nodes[node_index].children_offset, NULL, prim_bbc, offset, end - offset);
-  build_sub(pbvh,
-            pbvh->nodes[node_index].children_offset + 1,
-            NULL,
-            prim_bbc,
-            end,
-            offset + count - end);
+  /* Add two child nodes */
+  for (int i = 0; i < 2; i++) {
+    PBVHBuildNode *child = MEM_callocN(sizeof(PBVHBuildNode), "PBVHBuildNode");
+    child->offset = i == 0 ? offset : end;
+    child->count = i == 0 ? end - offset : offset + count - end;
+    node->children[i] = child;
+  }
+
+  /* Build children, the first one on another thread when it is large enough to be worth it. */
+  if (node->children[0]->count > pbvh->leaf_limit * 4) {
+    BLI_task_pool_push(pool, build_sub_task, node->children[0], false, NULL);
+  }
+  else {
+    build_sub(data, pool, node->children[0], NULL);
+  }
+  build_sub(data, pool, node->children[1], NULL);
+}
+
+static void build_sub_task(TaskPool *__restrict pool, void *taskdata)
+{
+  build_sub(BLI_task_pool_user_data(pool), pool, taskdata, NULL);
+}
+
+/* Move the built nodes to #PBVH.nodes, in the same order as a serial build would add them.
+ * The indices of the leaf nodes are added to `r_leaf_indices`. */
+static void build_flatten(PBVH *pbvh,
+                          int node_index,
+                          PBVHBuildNode *build_node,
+                          int *r_leaf_indices,
+                          int *r_totleaf)
+{
+  PBVHNode *node = &pbvh->nodes[node_index];
+  node->vb = build_node->vb;
+  node->orig_vb = build_node->vb;
+
+  if (build_node->children[0] == NULL) {
+    node->flag |= PBVH_Leaf;
+    node->prim_indices = pbvh->prim_indices + build_node->offset;
+    node->totprim = build_node->count;
+    r_leaf_indices[(*r_totleaf)++] = node_index;
+  }
+  else {
+    const int children_offset = pbvh->totnode;
+    node->children_offset = children_offset;
+    /* May reallocate the nodes, `node` is invalid afterwards. */
+    pbvh_grow_nodes(pbvh, pbvh->totnode + 2);
+
+    build_flatten(pbvh, children_offset, build_node->children[0], r_leaf_indices, r_totleaf);
+    build_flatten(pbvh, children_offset + 1, build_node->children[1], r_leaf_indices, r_totleaf);
+  }
+
+  MEM_freeN(build_node);
 }
 
 static void pbvh_build(PBVH *pbvh, BB *cb, BBC *prim_bbc, int totprim)
@@ -533,8 +655,106 @@ static void pbvh_build(PBVH *pbvh, BB *cb, BBC *prim_bbc, int totprim)
     }
   }
 
+  PBVHBuildData data = {
+      .pbvh = pbvh,
+      .prim_bbc = prim_bbc,
+      .totleaf = 0,
+  };
+  PBVHBuildNode *root = MEM_callocN(sizeof(PBVHBuildNode), "PBVHBuildNode");
+  root->offset = 0;
+  root->count = totprim;
+
+  TaskPool *pool = BLI_task_pool_create(&data, TASK_PRIORITY_HIGH);
+  build_sub(&data, pool, root, cb);
+  BLI_task_pool_work_and_wait(pool);
+  BLI_task_pool_free(pool);
+
+  int *leaf_indices = MEM_mallocN(sizeof(int) * data.totleaf, "bvh leaf indices");
+  int totleaf = 0;
   pbvh->totnode = 1;
-  build_sub(pbvh, 0, cb, prim_bbc, 0, totprim);
+  build_flatten(pbvh, 0, root, leaf_indices, &totleaf);
+  BLI_assert(totleaf == data.totleaf);
+
+  build_leaves(pbvh, leaf_indices, totleaf);
+  MEM_freeN(leaf_indices);
+}
+
+typedef struct PBVHPrimBoundsData {
+  PBVH *pbvh;
+  BBC *prim_bbc;
+} PBVHPrimBoundsData;
+
+static void mesh_prim_bounds_task_cb(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict tls)
+{
+  PBVHPrimBoundsData *data = userdata;
+  PBVH *pbvh = data->pbvh;
+  const MLoopTri *lt = &pbvh->looptri[i];
+  const int sides = 3;
+  BBC *bbc = data->prim_bbc + i;
+
+  BB_reset((BB *)bbc);
+
+  for (int j = 0; j < sides; j++) {
+    BB_expand((BB *)bbc, pbvh->verts[pbvh->mloop[lt->tri[j]].v].co);
+  }
+
+  BBC_update_centroid(bbc);
+
+  BB_expand(tls->userdata_chunk, bbc->bcentroid);
+}
+
+static void grid_prim_bounds_task_cb(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict tls)
+{
+  PBVHPrimBoundsData *data = userdata;
+  PBVH *pbvh = data->pbvh;
+  const CCGKey *key = &pbvh->gridkey;
+  CCGElem *grid = pbvh->grids[i];
+  BBC *bbc = data->prim_bbc + i;
+
+  BB_reset((BB *)bbc);
+
+  for (int j = 0; j < key->grid_area; j++) {
+    BB_expand((BB *)bbc, CCG_elem_offset_co(key, grid, j));
+  }
+
+  BBC_update_centroid(bbc);
+
+  BB_expand(tls->userdata_chunk, bbc->bcentroid);
+}
+
+static void prim_bounds_reduce(const void *__restrict UNUSED(userdata),
+                               void *__restrict chunk_join,
+                               void *__restrict chunk)
+{
+  BB_expand_with_bb(chunk_join, chunk);
+}
+
+/* For each primitive, store the AABB and the AABB centroid, and compute the bounding box of
+ * all the centroids in `r_cb`. */
+static void calc_prim_bounds(PBVH *pbvh,
+                             TaskParallelRangeFunc func,
+                             BBC *prim_bbc,
+                             int totprim,
+                             BB *r_cb)
+{
+  PBVHPrimBoundsData data = {
+      .pbvh = pbvh,
+      .prim_bbc = prim_bbc,
+  };
+
+  BB_reset(r_cb);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  settings.userdata_chunk = r_cb;
+  settings.userdata_chunk_size = sizeof(BB);
+  settings.func_reduce = prim_bounds_reduce;
+  BLI_task_parallel_range(0, totprim, &data, func, &settings);
 }
 
 void BKE_pbvh_build_mesh(PBVH *pbvh,
@@ -570,35 +790,15 @@ void BKE_pbvh_build_mesh(PBVH *pbvh,
   pbvh->face_sets_color_seed = mesh->face_sets_color_seed;
   pbvh->face_sets_color_default = mesh->face_sets_color_default;
 
-  BB_reset(&cb);
-
   /* For each face, store the AABB and the AABB centroid */
   prim_bbc = MEM_mallocN(sizeof(BBC) * looptri_num, "prim_bbc");
-
-  for (int i = 0; i < looptri_num; i++) {
-    const MLoopTri *lt = &looptri[i];
-    const int sides = 3;
-    BBC *bbc = prim_bbc + i;
-
-    BB_reset((BB *)bbc);
-
-    for (int j = 0; j < sides; j++) {
-      BB_expand((BB *)bbc, verts[pbvh->mloop[lt->tri[j]].v].co);
-    }
-
-    BBC_update_centroid(bbc);
-
-    BB_expand(&cb, bbc->bcentroid);
-  }
+  calc_prim_bounds(pbvh, mesh_prim_bounds_task_cb, prim_bbc, looptri_num, &cb);
 
   if (looptri_num) {
     pbvh_build(pbvh, &cb, prim_bbc, looptri_num);
   }
 
   MEM_freeN(prim_bbc);
-
-  /* Clear the bitmap so it can be used as an update tag later on. */
-  BLI_bitmap_set_all(pbvh->vert_bitmap, false, totvert);
 }
 
 void BKE_pbvh_build_grids(PBVH *pbvh,
@@ -621,25 +821,10 @@ void BKE_pbvh_build_grids(PBVH *pbvh,
   pbvh->leaf_limit = max_ii(LEAF_LIMIT / (gridsize * gridsize), 1);
 
   BB cb;
-  BB_reset(&cb);
 
   /* For each grid, store the AABB and the AABB centroid */
   BBC *prim_bbc = MEM_mallocN(sizeof(BBC) * totgrid, "prim_bbc");
-
-  for (int i = 0; i < totgrid; i++) {
-    CCGElem *grid = grids[i];
-    BBC *bbc = prim_bbc + i;
-
-    BB_reset((BB *)bbc);
-
-    for (int j = 0; j < gridsize * gridsize; j++) {
-      BB_expand((BB *)bbc, CCG_elem_offset_co(key, grid, j));
-    }
-
-    BBC_update_centroid(bbc);
-
-    BB_expand(&cb, bbc->bcentroid);
-  }
+  calc_prim_bounds(pbvh, grid_prim_bounds_task_cb, prim_bbc, totgrid, &cb);
 
   if (totgrid) {
     pbvh_build(pbvh, &cb, prim_bbc, totgrid);
@@ -1328,6 +1513,24 @@ static void pbvh_update_draw_buffer_cb(void *__restrict userdata,
   }
 }
 
+/* Draw buffers are updated in about this many batches, with a minimum number of nodes per batch
+ * to keep all threads busy while filling a batch. */
+#define PBVH_DRAW_UPDATE_BATCHES 4
+#define PBVH_DRAW_UPDATE_MIN_BATCH 64
+
+static void pbvh_update_draw_buffers_batch(PBVHUpdateData *data)
+{
+  TaskParallelSettings settings;
+  BKE_pbvh_parallel_range_settings(&settings, true, data->totnode);
+  BLI_task_parallel_range(0, data->totnode, data, pbvh_update_draw_buffer_cb, &settings);
+}
+
+static void pbvh_update_draw_buffers_batch_task(TaskPool *__restrict pool,
+                                                void *UNUSED(taskdata))
+{
+  pbvh_update_draw_buffers_batch(BLI_task_pool_user_data(pool));
+}
+
 static void pbvh_update_draw_buffers(PBVH *pbvh, PBVHNode **nodes, int totnode, int update_flag)
 {
   if ((update_flag & PBVH_RebuildDrawBuffers) || ELEM(pbvh->type, PBVH_GRIDS, PBVH_BMESH)) {
@@ -1350,25 +1553,44 @@ static void pbvh_update_draw_buffers(PBVH *pbvh, PBVHNode **nodes, int totnode,
     }
   }
 
-  /* Parallel creation and update of draw buffers. */
-  PBVHUpdateData data = {
-      .pbvh = pbvh,
-      .nodes = nodes,
-  };
+  /* Parallel creation and update of draw buffers. The nodes are processed in batches, so that
+   * the next batch is filled by other threads while the buffers of the current batch are flushed,
+   * instead of all threads waiting for the flush. */
+  const int batch_size = max_ii(totnode / PBVH_DRAW_UPDATE_BATCHES, PBVH_DRAW_UPDATE_MIN_BATCH);
+  PBVHUpdateData batch_data[2] = {{.pbvh = pbvh}, {.pbvh = pbvh}};
 
-  TaskParallelSettings settings;
-  BKE_pbvh_parallel_range_settings(&settings, true, totnode);
-  BLI_task_parallel_range(0, totnode, &data, pbvh_update_draw_buffer_cb, &settings);
+  batch_data[0].nodes = nodes;
+  batch_data[0].totnode = min_ii(batch_size, totnode);
+  pbvh_update_draw_buffers_batch(&batch_data[0]);
 
-  for (int i = 0; i < totnode; i++) {
-    PBVHNode *node = nodes[i];
+  for (int start = 0, batch = 0; start < totnode; batch ^= 1) {
+    const int end = start + batch_data[batch].totnode;
+
+    TaskPool *pool = NULL;
+    if (end < totnode) {
+      PBVHUpdateData *next_data = &batch_data[batch ^ 1];
+      next_data->nodes = nodes + end;
+      next_data->totnode = min_ii(batch_size, totnode - end);
+      pool = BLI_task_pool_create(next_data, TASK_PRIORITY_HIGH);
+      BLI_task_pool_push(pool, pbvh_update_draw_buffers_batch_task, NULL, false, NULL);
+    }
+
+    for (int i = start; i < end; i++) {
+      PBVHNode *node = nodes[i];
 
-    if (node->flag & PBVH_UpdateDrawBuffers) {
-      /* Flush buffers uses OpenGL, so not in parallel. */
-      GPU_pbvh_buffers_update_flush(node->draw_buffers);
+      if (node->flag & PBVH_UpdateDrawBuffers) {
+        /* Flush buffers uses OpenGL, so not in parallel. */
+        GPU_pbvh_buffers_update_flush(node->draw_buffers);
+      }
+
+      node->flag &= ~(PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers);
     }
 
-    node->flag &= ~(PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers);
+    if (pool) {
+      BLI_task_pool_work_and_wait(pool);
+      BLI_task_pool_free(pool);
+    }
+    start = end;
   }
 }
 
@@ -2824,10 +3046,7 @@ void BKE_pbvh_vert_coords_apply(PBVH *pbvh, const float (*vertCos)[3], const int
       }
     }
 
-    /* coordinates are new -- normals should also be updated */
-    BKE_mesh_calc_normals_looptri(
-        pbvh->verts, pbvh->totvert, pbvh->mloop, pbvh->looptri, pbvh->totprim, NULL);
-
+    /* Coordinates are new, normals are recalculated with the node update tags. */
     for (int a = 0; a < pbvh->totnode; a++) {
       BKE_pbvh_node_mark_update(&pbvh->nodes[a]);
     }
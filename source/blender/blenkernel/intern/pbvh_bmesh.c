@@ -11,6 +11,7 @@
 #include "BLI_heap_simple.h"
 #include "BLI_math.h"
 #include "BLI_memarena.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_DerivedMesh.h"
@@ -926,17 +927,22 @@ static void short_edge_queue_edge_add(EdgeQueueContext *eq_ctx, BMEdge *e)
   }
 }
 
-static void long_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
+static bool edge_queue_face_in_range(const EdgeQueue *q, BMFace *f)
 {
 #ifdef USE_EDGEQUEUE_FRONTFACE
-  if (eq_ctx->q->use_view_normal) {
-    if (dot_v3v3(f->no, eq_ctx->q->view_normal) < 0.0f) {
-      return;
+  if (q->use_view_normal) {
+    if (dot_v3v3(f->no, q->view_normal) < 0.0f) {
+      return false;
     }
   }
 #endif
 
-  if (eq_ctx->q->edge_queue_tri_in_range(eq_ctx->q, f)) {
+  return q->edge_queue_tri_in_range(q, f);
+}
+
+static void long_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
+{
+  if (edge_queue_face_in_range(eq_ctx->q, f)) {
     /* Check each edge of the face */
     BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
     BMLoop *l_iter = l_first;
@@ -954,26 +960,114 @@ static void long_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
   }
 }
 
-static void short_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
+/* Edge of a face in range that is longer or shorter than the limit of the queue. */
+typedef struct EdgeQueueCandidate {
+  BMLoop *l;
+  float len_sq;
+} EdgeQueueCandidate;
+
+typedef struct EdgeQueueGatherData {
+  const EdgeQueue *q;
+  PBVHNode **nodes;
+  bool use_long_edges;
+
+  /* Candidates of each node, in the order of the node's faces. */
+  EdgeQueueCandidate **candidates;
+  int *candidates_num;
+} EdgeQueueGatherData;
+
+static void edge_queue_gather_task_cb(void *__restrict userdata,
+                                      const int n,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
 {
-#ifdef USE_EDGEQUEUE_FRONTFACE
-  if (eq_ctx->q->use_view_normal) {
-    if (dot_v3v3(f->no, eq_ctx->q->view_normal) < 0.0f) {
-      return;
-    }
-  }
-#endif
+  EdgeQueueGatherData *data = userdata;
+  const EdgeQueue *q = data->q;
+  PBVHNode *node = data->nodes[n];
+
+  EdgeQueueCandidate *candidates = MEM_mallocN(
+      sizeof(*candidates) * 3 * BLI_gset_len(node->bm_faces), __func__);
+  int candidates_num = 0;
+
+  GSetIterator gs_iter;
+  GSET_ITER (gs_iter, node->bm_faces) {
+    BMFace *f = BLI_gsetIterator_getKey(&gs_iter);
+    BLI_assert(f->len == 3);
 
-  if (eq_ctx->q->edge_queue_tri_in_range(eq_ctx->q, f)) {
-    BMLoop *l_iter;
-    BMLoop *l_first;
+    if (!edge_queue_face_in_range(q, f)) {
+      continue;
+    }
 
     /* Check each edge of the face */
-    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+    BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
+    BMLoop *l_iter = l_first;
     do {
-      short_edge_queue_edge_add(eq_ctx, l_iter->e);
+      const float len_sq = BM_edge_calc_length_squared(l_iter->e);
+      if (data->use_long_edges ? len_sq > q->limit_len_squared :
+                                 len_sq < q->limit_len_squared) {
+        candidates[candidates_num].l = l_iter;
+        candidates[candidates_num].len_sq = len_sq;
+        candidates_num++;
+      }
     } while ((l_iter = l_iter->next) != l_first);
   }
+
+  data->candidates[n] = candidates;
+  data->candidates_num[n] = candidates_num;
+}
+
+/* Add the edges of the faces in range to the queue, for the leaf nodes marked for topology
+ * update. The faces of all nodes are tested in parallel, the BMesh and the heap are only
+ * modified afterwards, in the same order as testing the faces one by one. */
+static void edge_queue_add_nodes(EdgeQueueContext *eq_ctx, PBVH *pbvh, const bool use_long_edges)
+{
+  PBVHNode **nodes = MEM_mallocN(sizeof(*nodes) * pbvh->totnode, __func__);
+  int totnode = 0;
+  for (int n = 0; n < pbvh->totnode; n++) {
+    PBVHNode *node = &pbvh->nodes[n];
+
+    /* Check leaf nodes marked for topology update */
+    if ((node->flag & PBVH_Leaf) && (node->flag & PBVH_UpdateTopology) &&
+        !(node->flag & PBVH_FullyHidden)) {
+      nodes[totnode++] = node;
+    }
+  }
+
+  EdgeQueueGatherData data = {
+      .q = eq_ctx->q,
+      .nodes = nodes,
+      .use_long_edges = use_long_edges,
+      .candidates = MEM_mallocN(sizeof(*data.candidates) * totnode, __func__),
+      .candidates_num = MEM_mallocN(sizeof(*data.candidates_num) * totnode, __func__),
+  };
+
+  TaskParallelSettings settings;
+  BKE_pbvh_parallel_range_settings(&settings, true, totnode);
+  BLI_task_parallel_range(0, totnode, &data, edge_queue_gather_task_cb, &settings);
+
+  for (int n = 0; n < totnode; n++) {
+    for (int i = 0; i < data.candidates_num[n]; i++) {
+      const EdgeQueueCandidate *candidate = &data.candidates[n][i];
+      if (use_long_edges) {
+#ifdef USE_EDGEQUEUE_EVEN_SUBDIV
+        long_edge_queue_edge_add_recursive(eq_ctx,
+                                           candidate->l->radial_next,
+                                           candidate->l,
+                                           candidate->len_sq,
+                                           eq_ctx->q->limit_len);
+#else
+        long_edge_queue_edge_add(eq_ctx, candidate->l->e);
+#endif
+      }
+      else {
+        short_edge_queue_edge_add(eq_ctx, candidate->l->e);
+      }
+    }
+    MEM_freeN(data.candidates[n]);
+  }
+
+  MEM_freeN(data.candidates);
+  MEM_freeN(data.candidates_num);
+  MEM_freeN(nodes);
 }
 
 /* Create a priority queue containing vertex pairs connected by a long
@@ -1021,22 +1115,7 @@ static void long_edge_queue_create(EdgeQueueContext *eq_ctx,
   pbvh_bmesh_edge_tag_verify(pbvh);
 #endif
 
-  for (int n = 0; n < pbvh->totnode; n++) {
-    PBVHNode *node = &pbvh->nodes[n];
-
-    /* Check leaf nodes marked for topology update */
-    if ((node->flag & PBVH_Leaf) && (node->flag & PBVH_UpdateTopology) &&
-        !(node->flag & PBVH_FullyHidden)) {
-      GSetIterator gs_iter;
-
-      /* Check each face */
-      GSET_ITER (gs_iter, node->bm_faces) {
-        BMFace *f = BLI_gsetIterator_getKey(&gs_iter);
-
-        long_edge_queue_face_add(eq_ctx, f);
-      }
-    }
-  }
+  edge_queue_add_nodes(eq_ctx, pbvh, true);
 }
 
 /* Create a priority queue containing vertex pairs connected by a
@@ -1080,22 +1159,7 @@ static void short_edge_queue_create(EdgeQueueContext *eq_ctx,
     eq_ctx->q->edge_queue_tri_in_range = edge_queue_tri_in_sphere;
   }
 
-  for (int n = 0; n < pbvh->totnode; n++) {
-    PBVHNode *node = &pbvh->nodes[n];
-
-    /* Check leaf nodes marked for topology update */
-    if ((node->flag & PBVH_Leaf) && (node->flag & PBVH_UpdateTopology) &&
-        !(node->flag & PBVH_FullyHidden)) {
-      GSetIterator gs_iter;
-
-      /* Check each face */
-      GSET_ITER (gs_iter, node->bm_faces) {
-        BMFace *f = BLI_gsetIterator_getKey(&gs_iter);
-
-        short_edge_queue_face_add(eq_ctx, f);
-      }
-    }
-  }
+  edge_queue_add_nodes(eq_ctx, pbvh, false);
 }
 
 /*************************** Topology update **************************/
@@ -76,6 +76,8 @@
 #  include "LzmaLib.h"
 #endif
 
+#include <zstd.h>
+
 /* needed for directory lookup */
 #ifndef WIN32
 #  include <dirent.h>
@@ -1490,6 +1492,36 @@ static void ptcache_file_close(PTCacheFile *pf)
   }
 }
 
+/* The values in cache data are 4 bytes wide. Grouping the first bytes of all values, then the
+ * second bytes, etc. makes the data much more compressible, since the sign and exponent bytes
+ * of nearby values are often the same. */
+#define PTCACHE_SHUFFLE_STRIDE 4
+
+static void ptcache_bytes_shuffle(unsigned char *dst, const unsigned char *src, size_t len)
+{
+  const size_t values_num = len / PTCACHE_SHUFFLE_STRIDE;
+  for (size_t i = 0; i < values_num; i++) {
+    for (size_t b = 0; b < PTCACHE_SHUFFLE_STRIDE; b++) {
+      dst[b * values_num + i] = src[i * PTCACHE_SHUFFLE_STRIDE + b];
+    }
+  }
+  /* Remaining bytes are kept as they are. */
+  const size_t shuffled_len = values_num * PTCACHE_SHUFFLE_STRIDE;
+  memcpy(dst + shuffled_len, src + shuffled_len, len - shuffled_len);
+}
+
+static void ptcache_bytes_unshuffle(unsigned char *dst, const unsigned char *src, size_t len)
+{
+  const size_t values_num = len / PTCACHE_SHUFFLE_STRIDE;
+  for (size_t i = 0; i < values_num; i++) {
+    for (size_t b = 0; b < PTCACHE_SHUFFLE_STRIDE; b++) {
+      dst[i * PTCACHE_SHUFFLE_STRIDE + b] = src[b * values_num + i];
+    }
+  }
+  const size_t shuffled_len = values_num * PTCACHE_SHUFFLE_STRIDE;
+  memcpy(dst + shuffled_len, src + shuffled_len, len - shuffled_len);
+}
+
 static int ptcache_file_compressed_read(PTCacheFile *pf, unsigned char *result, unsigned int len)
 {
   int r = 0;
@@ -1528,6 +1560,17 @@ static int ptcache_file_compressed_read(PTCacheFile *pf, unsigned char *result,
         r = LzmaUncompress(result, &leno, in, &leni, props, sizeOfIt);
       }
 #endif
+      if (compressed == PTCACHE_COMPRESS_ZSTD) {
+        unsigned char *shuffled = MEM_mallocN(len, "pointcache_zstd_buffer");
+        const size_t out_size = ZSTD_decompress(shuffled, len, in, in_len);
+        if (out_size == len) {
+          ptcache_bytes_unshuffle(result, shuffled, len);
+        }
+        else {
+          r = 1;
+        }
+        MEM_freeN(shuffled);
+      }
       MEM_freeN(in);
     }
   }
@@ -1589,6 +1632,24 @@ static int ptcache_file_compressed_write(
     }
   }
 #endif
+  unsigned char *out_zstd = NULL;
+  if (mode == PTCACHE_COMPRESS_ZSTD) {
+    unsigned char *shuffled = MEM_mallocN(in_len, "pointcache_zstd_buffer");
+    ptcache_bytes_shuffle(shuffled, in, in_len);
+
+    const size_t out_bound = ZSTD_compressBound(in_len);
+    out_zstd = MEM_mallocN(out_bound, "pointcache_zstd_buffer");
+    out_len = ZSTD_compress(out_zstd, out_bound, shuffled, in_len, ZSTD_CLEVEL_DEFAULT);
+    MEM_freeN(shuffled);
+
+    if (ZSTD_isError(out_len) || (out_len >= in_len)) {
+      compressed = 0;
+    }
+    else {
+      compressed = PTCACHE_COMPRESS_ZSTD;
+      out = out_zstd;
+    }
+  }
 
   ptcache_file_write(pf, &compressed, 1, sizeof(unsigned char));
   if (compressed) {
@@ -1606,6 +1667,7 @@ static int ptcache_file_compressed_write(
     ptcache_file_write(pf, props, size, sizeof(unsigned char));
   }
 
+  MEM_SAFE_FREE(out_zstd);
   MEM_freeN(props);
 
   return r;
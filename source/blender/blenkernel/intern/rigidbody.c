@@ -1661,17 +1661,29 @@ static void rigidbody_update_sim_world(Scene *scene, RigidBodyWorld *rbw)
   rigidbody_update_ob_array(rbw);
 }
 
-static void rigidbody_update_sim_ob(
-    Depsgraph *depsgraph, Scene *scene, RigidBodyWorld *rbw, Object *ob, RigidBodyOb *rbo)
+/**
+ * \param effectors: The effectors of the world, created once for all objects. Objects with a force
+ * field themselves are not effected, so they don't need to be excluded from it.
+ */
+static void rigidbody_update_sim_ob(Depsgraph *depsgraph,
+                                    Scene *scene,
+                                    RigidBodyWorld *rbw,
+                                    ListBase *effectors,
+                                    Object *ob,
+                                    RigidBodyOb *rbo)
 {
   /* only update if rigid body exists */
   if (rbo->shared->physics_object == NULL) {
     return;
   }
 
-  ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
-  Base *base = BKE_view_layer_base_find(view_layer, ob);
-  const bool is_selected = base ? (base->flag & BASE_SELECTED) != 0 : false;
+  /* The selection only matters while transforming, avoid the lookup for every object otherwise. */
+  bool is_selected = false;
+  if (G.moving & G_TRANSFORM_OBJ) {
+    ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
+    Base *base = BKE_view_layer_base_find(view_layer, ob);
+    is_selected = base ? (base->flag & BASE_SELECTED) != 0 : false;
+  }
 
   if (rbo->shape == RB_SHAPE_TRIMESH && rbo->flag & RBO_FLAG_USE_DEFORM) {
     Mesh *mesh = ob->runtime.mesh_deform_eval;
@@ -1719,10 +1731,7 @@ static void rigidbody_update_sim_ob(
            ((ob->pd == NULL) || (ob->pd->forcefield == PFIELD_NULL))) {
     EffectorWeights *effector_weights = rbw->effector_weights;
     EffectedPoint epoint;
-    ListBase *effectors;
 
-    /* get effectors present in the group specified by effector_weights */
-    effectors = BKE_effectors_create(depsgraph, ob, NULL, effector_weights, false);
     if (effectors) {
       float eff_force[3] = {0.0f, 0.0f, 0.0f};
       float eff_loc[3], eff_vel[3];
@@ -1755,9 +1764,6 @@ static void rigidbody_update_sim_ob(
     else if (G.f & G_DEBUG) {
       printf("\tno forces to apply to '%s'\n", ob->id.name + 2);
     }
-
-    /* cleanup */
-    BKE_effectors_free(effectors);
   }
   /* NOTE: passive objects don't need to be updated since they don't move */
 
@@ -1805,6 +1811,10 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
     FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
   }
 
+  /* Get effectors present in the group specified by effector_weights. Creating them evaluates
+   * all effectors, so do it once for all objects instead of for every object. */
+  ListBase *effectors = BKE_effectors_create(depsgraph, NULL, NULL, rbw->effector_weights, false);
+
   /* update objects */
   FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (rbw->group, ob) {
     if (ob->type == OB_MESH) {
@@ -1855,11 +1865,13 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
       rbo->flag &= ~(RBO_FLAG_NEEDS_VALIDATE | RBO_FLAG_NEEDS_RESHAPE);
 
       /* update simulation object... */
-      rigidbody_update_sim_ob(depsgraph, scene, rbw, ob, rbo);
+      rigidbody_update_sim_ob(depsgraph, scene, rbw, effectors, ob, rbo);
     }
   }
   FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
 
+  BKE_effectors_free(effectors);
+
   /* update constraints */
   if (rbw->constraints == NULL) { /* no constraints, move on */
     return;
@@ -1998,6 +2010,11 @@ static void rigidbody_free_substep_data(ListBase *substep_targets)
 }
 static void rigidbody_update_simulation_post_step(Depsgraph *depsgraph, RigidBodyWorld *rbw)
 {
+  /* Only objects that are being transformed have to be reset. */
+  if ((G.moving & G_TRANSFORM_OBJ) == 0) {
+    return;
+  }
+
   ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
 
   FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (rbw->group, ob) {
@@ -41,6 +41,7 @@
 #include "DNA_scene_types.h"
 
 #include "BLI_ghash.h"
+#include "BLI_kdtree.h"
 #include "BLI_listbase.h"
 #include "BLI_math.h"
 #include "BLI_threads.h"
@@ -119,6 +120,9 @@ typedef struct SB_thread_context {
   int do_deflector;
   float fieldfactor;
   float windfactor;
+  /* Positions of all body points, for the ball self collision. */
+  const KDTree_3d *selfcollision_tree;
+  float colball_max;
   int nr;
   int tot;
 } SB_thread_context;
@@ -1937,6 +1941,57 @@ static void sb_spring_force(
   madd_v3_v3fl(bp1->force, dir, -kd);
 }
 
+typedef struct SelfCollisionData {
+  Object *ob;
+  SoftBody *sb;
+  BodyPoint *bp;
+  int bpi;
+} SelfCollisionData;
+
+/* Ball self collision of one body point with another one close to it. */
+static bool sb_self_collision_cb(void *user_data,
+                                 int index,
+                                 const float UNUSED(co[3]),
+                                 float UNUSED(dist_sq))
+{
+  SelfCollisionData *scd = user_data;
+  SoftBody *sb = scd->sb;
+  BodyPoint *bp = scd->bp;
+  BodyPoint *obp = &sb->bpoint[index];
+  BodySpring *bs;
+  float velcenter[3], dvel[3], def[3];
+  float distance;
+  const float compare = (obp->colball + bp->colball);
+  const float bstune = sb->ballstiff;
+  int b;
+
+  /* Running in a slice we must not assume anything done with obp
+   * neither alter the data of obp. */
+  sub_v3_v3v3(def, bp->pos, obp->pos);
+  distance = normalize_v3(def);
+  if (distance >= compare) {
+    return true;
+  }
+
+  /* exclude body points attached with a spring */
+  for (b = obp->nofsprings; b > 0; b--) {
+    bs = sb->bspring + obp->springs[b - 1];
+    if (ELEM(scd->bpi, bs->v2, bs->v1)) {
+      return true;
+    }
+  }
+
+  float f = bstune / (distance) + bstune / (compare * compare) * distance - 2.0f * bstune / compare;
+
+  mid_v3_v3v3(velcenter, bp->vec, obp->vec);
+  sub_v3_v3v3(dvel, velcenter, bp->vec);
+  mul_v3_fl(dvel, _final_mass(scd->ob, bp));
+
+  madd_v3_v3fl(bp->force, def, f * (1.0f - sb->balldamp));
+  madd_v3_v3fl(bp->force, dvel, sb->balldamp);
+  return true;
+}
+
 /* since this is definitely the most CPU consuming task here .. try to spread it */
 /* core function _softbody_calc_forces_slice_in_a_thread */
 /* result is int to be able to flag user break */
@@ -1950,7 +2005,9 @@ static int _softbody_calc_forces_slice_in_a_thread(Scene *scene,
                                                    ListBase *effectors,
                                                    int do_deflector,
                                                    float fieldfactor,
-                                                   float windfactor)
+                                                   float windfactor,
+                                                   const KDTree_3d *selfcollision_tree,
+                                                   float colball_max)
 {
   float iks;
   int bb, do_selfcollision, do_springcollision, do_aero;
@@ -1988,49 +2045,10 @@ static int _softbody_calc_forces_slice_in_a_thread(Scene *scene,
     /* naive ball self collision */
     /* needs to be done if goal snaps or not */
     if (do_selfcollision) {
-      int attached;
-      BodyPoint *obp;
-      BodySpring *bs;
-      int c, b;
-      float velcenter[3], dvel[3], def[3];
-      float distance;
-      float compare;
-      float bstune = sb->ballstiff;
-
-      /* Running in a slice we must not assume anything done with obp
-       * neither alter the data of obp. */
-      for (c = sb->totpoint, obp = sb->bpoint; c > 0; c--, obp++) {
-        compare = (obp->colball + bp->colball);
-        sub_v3_v3v3(def, bp->pos, obp->pos);
-        /* rather check the AABBoxes before ever calculating the real distance */
-        /* mathematically it is completely nuts, but performance is pretty much (3) times faster */
-        if ((fabsf(def[0]) > compare) || (fabsf(def[1]) > compare) || (fabsf(def[2]) > compare)) {
-          continue;
-        }
-        distance = normalize_v3(def);
-        if (distance < compare) {
-          /* exclude body points attached with a spring */
-          attached = 0;
-          for (b = obp->nofsprings; b > 0; b--) {
-            bs = sb->bspring + obp->springs[b - 1];
-            if (ELEM(ilast - bb, bs->v2, bs->v1)) {
-              attached = 1;
-              continue;
-            }
-          }
-          if (!attached) {
-            float f = bstune / (distance) + bstune / (compare * compare) * distance -
-                      2.0f * bstune / compare;
-
-            mid_v3_v3v3(velcenter, bp->vec, obp->vec);
-            sub_v3_v3v3(dvel, velcenter, bp->vec);
-            mul_v3_fl(dvel, _final_mass(ob, bp));
-
-            madd_v3_v3fl(bp->force, def, f * (1.0f - sb->balldamp));
-            madd_v3_v3fl(bp->force, dvel, sb->balldamp);
-          }
-        }
-      }
+      SelfCollisionData scd = {ob, sb, bp, ilast - bb};
+      /* Only the points within the largest possible sum of the ball sizes can touch. */
+      BLI_kdtree_3d_range_search_cb(
+          selfcollision_tree, bp->pos, bp->colball + colball_max, sb_self_collision_cb, &scd);
     }
     /* naive ball self collision done */
 
@@ -2175,7 +2193,9 @@ static void *exec_softbody_calc_forces(void *data)
                                           pctx->effectors,
                                           pctx->do_deflector,
                                           pctx->fieldfactor,
-                                          pctx->windfactor);
+                                          pctx->windfactor,
+                                          pctx->selfcollision_tree,
+                                          pctx->colball_max);
   return NULL;
 }
 
@@ -2188,7 +2208,9 @@ static void sb_cf_threads_run(Scene *scene,
                               struct ListBase *effectors,
                               int do_deflector,
                               float fieldfactor,
-                              float windfactor)
+                              float windfactor,
+                              const KDTree_3d *selfcollision_tree,
+                              float colball_max)
 {
   ListBase threads;
   SB_thread_context *sb_threads;
@@ -2228,6 +2250,8 @@ static void sb_cf_threads_run(Scene *scene,
     sb_threads[i].do_deflector = do_deflector;
     sb_threads[i].fieldfactor = fieldfactor;
     sb_threads[i].windfactor = windfactor;
+    sb_threads[i].selfcollision_tree = selfcollision_tree;
+    sb_threads[i].colball_max = colball_max;
     sb_threads[i].nr = i;
     sb_threads[i].tot = totthread;
   }
@@ -2287,6 +2311,19 @@ static void softbody_calc_forces(
     do_deflector = sb_detect_aabb_collisionCached(defforce, ob, timenow);
   }
 
+  /* The naive ball self collision compared every pair of points,
+   * look up only the points that are close enough instead. */
+  KDTree_3d *selfcollision_tree = NULL;
+  float colball_max = 0.0f;
+  if ((ob->softflag & OB_SB_EDGES) && (sb->bspring) && (ob->softflag & OB_SB_SELF)) {
+    selfcollision_tree = BLI_kdtree_3d_new(sb->totpoint);
+    for (int a = 0; a < sb->totpoint; a++) {
+      BLI_kdtree_3d_insert(selfcollision_tree, a, sb->bpoint[a].pos);
+      colball_max = max_ff(colball_max, sb->bpoint[a].colball);
+    }
+    BLI_kdtree_3d_balance(selfcollision_tree);
+  }
+
   sb_cf_threads_run(scene,
                     ob,
                     forcetime,
@@ -2296,7 +2333,13 @@ static void softbody_calc_forces(
                     effectors,
                     do_deflector,
                     fieldfactor,
-                    windfactor);
+                    windfactor,
+                    selfcollision_tree,
+                    colball_max);
+
+  if (selfcollision_tree) {
+    BLI_kdtree_3d_free(selfcollision_tree);
+  }
 
   /* finally add forces caused by face collision */
   if (ob->softflag & OB_SB_FACECOLL) {
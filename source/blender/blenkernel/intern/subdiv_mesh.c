@@ -16,9 +16,12 @@
 
 #include "BLI_alloca.h"
 #include "BLI_math_vector.h"
+#include "BLI_string.h"
+#include "BLI_task.h"
 
 #include "BKE_customdata.h"
 #include "BKE_key.h"
+#include "BKE_lib_id.h"
 #include "BKE_mesh.h"
 #include "BKE_subdiv.h"
 #include "BKE_subdiv_eval.h"
@@ -46,6 +49,11 @@ typedef struct SubdivMeshContext {
   /* Per-subdivided vertex counter of averaged values. */
   int *accumulated_counters;
   bool have_displacement;
+  /* Location of every subdivided vertex on the limit surface, only recorded when the result is
+   * going to be stored in a #SubdivMeshCache. */
+  bool record_vertex_ptex;
+  int *vertex_ptex_face_index;
+  float (*vertex_ptex_uv)[2];
 } SubdivMeshContext;
 
 static void subdiv_mesh_ctx_cache_uv_layers(SubdivMeshContext *ctx)
@@ -79,9 +87,24 @@ static void subdiv_mesh_prepare_accumulator(SubdivMeshContext *ctx, int num_vert
       num_vertices, sizeof(*ctx->accumulated_counters), "subdiv accumulated counters");
 }
 
+static void subdiv_mesh_prepare_vertex_ptex(SubdivMeshContext *ctx, int num_vertices)
+{
+  if (!ctx->record_vertex_ptex) {
+    return;
+  }
+  ctx->vertex_ptex_face_index = MEM_malloc_arrayN(
+      num_vertices, sizeof(*ctx->vertex_ptex_face_index), "subdiv vertex ptex face index");
+  ctx->vertex_ptex_uv = MEM_malloc_arrayN(
+      num_vertices, sizeof(*ctx->vertex_ptex_uv), "subdiv vertex ptex uv");
+  /* Vertices which are not evaluated on the limit surface keep the invalid index. */
+  copy_vn_i(ctx->vertex_ptex_face_index, num_vertices, -1);
+}
+
 static void subdiv_mesh_context_free(SubdivMeshContext *ctx)
 {
   MEM_SAFE_FREE(ctx->accumulated_counters);
+  MEM_SAFE_FREE(ctx->vertex_ptex_face_index);
+  MEM_SAFE_FREE(ctx->vertex_ptex_uv);
 }
 
 /** \} */
@@ -464,6 +487,7 @@ static bool subdiv_mesh_topology_info(const SubdivForeachContext *foreach_contex
       subdiv_context->coarse_mesh, num_vertices, num_edges, 0, num_loops, num_polygons, mask);
   subdiv_mesh_ctx_cache_custom_data_layers(subdiv_context);
   subdiv_mesh_prepare_accumulator(subdiv_context, num_vertices);
+  subdiv_mesh_prepare_vertex_ptex(subdiv_context, num_vertices);
   return true;
 }
 
@@ -505,6 +529,20 @@ static void subdiv_vertex_data_interpolate(const SubdivMeshContext *ctx,
   }
 }
 
+static void subdiv_mesh_record_vertex_ptex(const SubdivMeshContext *ctx,
+                                           const int ptex_face_index,
+                                           const float u,
+                                           const float v,
+                                           const int subdiv_vertex_index)
+{
+  if (ctx->vertex_ptex_face_index == NULL) {
+    return;
+  }
+  ctx->vertex_ptex_face_index[subdiv_vertex_index] = ptex_face_index;
+  ctx->vertex_ptex_uv[subdiv_vertex_index][0] = u;
+  ctx->vertex_ptex_uv[subdiv_vertex_index][1] = v;
+}
+
 static void evaluate_vertex_and_apply_displacement_copy(const SubdivMeshContext *ctx,
                                                         const int ptex_face_index,
                                                         const float u,
@@ -524,6 +562,7 @@ static void evaluate_vertex_and_apply_displacement_copy(const SubdivMeshContext
   /* Copy custom data and evaluate position. */
   subdiv_vertex_data_copy(ctx, coarse_vert, subdiv_vert);
   BKE_subdiv_eval_limit_point(ctx->subdiv, ptex_face_index, u, v, subdiv_vert->co);
+  subdiv_mesh_record_vertex_ptex(ctx, ptex_face_index, u, v, subdiv_vertex_index);
   /* Apply displacement. */
   add_v3_v3(subdiv_vert->co, D);
   /* Remove facedot flag. This can happen if there is more than one subsurf modifier. */
@@ -550,6 +589,7 @@ static void evaluate_vertex_and_apply_displacement_interpolate(
   /* Interpolate custom data and evaluate position. */
   subdiv_vertex_data_interpolate(ctx, subdiv_vert, vertex_interpolation, u, v);
   BKE_subdiv_eval_limit_point(ctx->subdiv, ptex_face_index, u, v, subdiv_vert->co);
+  subdiv_mesh_record_vertex_ptex(ctx, ptex_face_index, u, v, subdiv_vertex_index);
   /* Apply displacement. */
   add_v3_v3(subdiv_vert->co, D);
 }
@@ -717,6 +757,7 @@ static void subdiv_mesh_vertex_inner(const SubdivForeachContext *foreach_context
   subdiv_mesh_ensure_vertex_interpolation(ctx, tls, coarse_poly, coarse_corner);
   subdiv_vertex_data_interpolate(ctx, subdiv_vert, &tls->vertex_interpolation, u, v);
   BKE_subdiv_eval_final_point(subdiv, ptex_face_index, u, v, subdiv_vert->co);
+  subdiv_mesh_record_vertex_ptex(ctx, ptex_face_index, u, v, subdiv_vertex_index);
   subdiv_mesh_tag_center_vertex(coarse_poly, subdiv_vert, u, v);
 }
 
@@ -1104,13 +1145,229 @@ static void setup_foreach_callbacks(const SubdivMeshContext *subdiv_context,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Position-only update cache
+ * \{ */
+
+typedef struct SubdivMeshCache {
+  /* Settings the cached mesh was created with. */
+  SubdivSettings subdiv_settings;
+  SubdivToMeshSettings settings;
+  /* Copy of the coarse mesh, used to detect changes of anything other than vertex positions. */
+  Mesh *coarse_mesh;
+  /* Result of the last full evaluation. */
+  Mesh *subdiv_mesh;
+  /* Location of every vertex of the subdivided mesh on the limit surface. */
+  int *vertex_ptex_face_index;
+  float (*vertex_ptex_uv)[2];
+} SubdivMeshCache;
+
+void BKE_subdiv_mesh_cache_free(SubdivMeshCache *cache)
+{
+  if (cache == NULL) {
+    return;
+  }
+  BKE_id_free(NULL, cache->coarse_mesh);
+  BKE_id_free(NULL, cache->subdiv_mesh);
+  MEM_freeN(cache->vertex_ptex_face_index);
+  MEM_freeN(cache->vertex_ptex_uv);
+  MEM_freeN(cache);
+}
+
+static bool mverts_equal_except_positions(const MVert *mvert_a,
+                                          const MVert *mvert_b,
+                                          const int num_vertices)
+{
+  for (int i = 0; i < num_vertices; i++) {
+    if (mvert_a[i].flag != mvert_b[i].flag || mvert_a[i].bweight != mvert_b[i].bweight) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool mdeformverts_equal(const MDeformVert *dvert_a,
+                               const MDeformVert *dvert_b,
+                               const int num_vertices)
+{
+  for (int i = 0; i < num_vertices; i++) {
+    if (dvert_a[i].totweight != dvert_b[i].totweight || dvert_a[i].flag != dvert_b[i].flag) {
+      return false;
+    }
+    if (dvert_a[i].totweight != 0 &&
+        memcmp(dvert_a[i].dw, dvert_b[i].dw, sizeof(MDeformWeight) * dvert_a[i].totweight) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Compare all layers of custom data, ignoring vertex positions.
+ * Layers which store pointers to data of arbitrary size are considered to never match. */
+static bool customdata_equal_except_positions(const CustomData *data_a,
+                                              const CustomData *data_b,
+                                              const int totelem)
+{
+  if (data_a->totlayer != data_b->totlayer) {
+    return false;
+  }
+  for (int i = 0; i < data_a->totlayer; i++) {
+    const CustomDataLayer *layer_a = &data_a->layers[i];
+    const CustomDataLayer *layer_b = &data_b->layers[i];
+    if (layer_a->type != layer_b->type || layer_a->flag != layer_b->flag ||
+        layer_a->active != layer_b->active || layer_a->active_rnd != layer_b->active_rnd ||
+        layer_a->active_clone != layer_b->active_clone ||
+        layer_a->active_mask != layer_b->active_mask || !STREQ(layer_a->name, layer_b->name)) {
+      return false;
+    }
+    if (layer_a->data == NULL || layer_b->data == NULL) {
+      if (layer_a->data != layer_b->data) {
+        return false;
+      }
+      continue;
+    }
+    switch (layer_a->type) {
+      case CD_MVERT:
+        if (!mverts_equal_except_positions(layer_a->data, layer_b->data, totelem)) {
+          return false;
+        }
+        break;
+      case CD_MDEFORMVERT:
+        if (!mdeformverts_equal(layer_a->data, layer_b->data, totelem)) {
+          return false;
+        }
+        break;
+      case CD_MDISPS:
+      case CD_GRID_PAINT_MASK:
+      case CD_BM_ELEM_PYPTR:
+        return false;
+      default:
+        if (memcmp(layer_a->data,
+                   layer_b->data,
+                   (size_t)CustomData_sizeof(layer_a->type) * (size_t)totelem) != 0) {
+          return false;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+static bool subdiv_mesh_cache_is_valid(const SubdivMeshCache *cache,
+                                       const Subdiv *subdiv,
+                                       const SubdivToMeshSettings *settings,
+                                       const Mesh *coarse_mesh)
+{
+  if (cache == NULL) {
+    return false;
+  }
+  if (subdiv->displacement_evaluator != NULL) {
+    return false;
+  }
+  if (cache->settings.resolution != settings->resolution ||
+      cache->settings.use_optimal_display != settings->use_optimal_display ||
+      !BKE_subdiv_settings_equal(&cache->subdiv_settings, &subdiv->settings)) {
+    return false;
+  }
+  const Mesh *cached_mesh = cache->coarse_mesh;
+  if (cached_mesh->totvert != coarse_mesh->totvert ||
+      cached_mesh->totedge != coarse_mesh->totedge ||
+      cached_mesh->totloop != coarse_mesh->totloop ||
+      cached_mesh->totpoly != coarse_mesh->totpoly) {
+    return false;
+  }
+  return customdata_equal_except_positions(
+             &cached_mesh->vdata, &coarse_mesh->vdata, coarse_mesh->totvert) &&
+         customdata_equal_except_positions(
+             &cached_mesh->edata, &coarse_mesh->edata, coarse_mesh->totedge) &&
+         customdata_equal_except_positions(
+             &cached_mesh->ldata, &coarse_mesh->ldata, coarse_mesh->totloop) &&
+         customdata_equal_except_positions(
+             &cached_mesh->pdata, &coarse_mesh->pdata, coarse_mesh->totpoly);
+}
+
+/* Store the result of a full evaluation, taking ownership of the recorded vertex locations.
+ * Returns false when the result can not be updated from positions only, for example when there
+ * is loose geometry which is not evaluated on the limit surface. */
+static bool subdiv_mesh_cache_store(SubdivMeshCache **cache_p,
+                                    SubdivMeshContext *ctx,
+                                    const Mesh *result)
+{
+  const int num_vertices = result->totvert;
+  for (int i = 0; i < num_vertices; i++) {
+    if (ctx->vertex_ptex_face_index[i] == -1) {
+      return false;
+    }
+  }
+  SubdivMeshCache *cache = *cache_p;
+  if (cache == NULL) {
+    cache = MEM_callocN(sizeof(*cache), "subdiv mesh cache");
+    *cache_p = cache;
+  }
+  else {
+    BKE_id_free(NULL, cache->coarse_mesh);
+    BKE_id_free(NULL, cache->subdiv_mesh);
+    MEM_freeN(cache->vertex_ptex_face_index);
+    MEM_freeN(cache->vertex_ptex_uv);
+  }
+  cache->subdiv_settings = ctx->subdiv->settings;
+  cache->settings = *ctx->settings;
+  cache->coarse_mesh = BKE_mesh_copy_for_eval(ctx->coarse_mesh, false);
+  cache->subdiv_mesh = BKE_mesh_copy_for_eval(result, false);
+  cache->vertex_ptex_face_index = ctx->vertex_ptex_face_index;
+  cache->vertex_ptex_uv = ctx->vertex_ptex_uv;
+  ctx->vertex_ptex_face_index = NULL;
+  ctx->vertex_ptex_uv = NULL;
+  return true;
+}
+
+typedef struct SubdivMeshCacheEvalData {
+  Subdiv *subdiv;
+  const SubdivMeshCache *cache;
+  MVert *mvert;
+} SubdivMeshCacheEvalData;
+
+static void subdiv_mesh_cache_eval_position_cb(void *__restrict userdata,
+                                               const int vertex_index,
+                                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SubdivMeshCacheEvalData *data = userdata;
+  const SubdivMeshCache *cache = data->cache;
+  BKE_subdiv_eval_limit_point(data->subdiv,
+                              cache->vertex_ptex_face_index[vertex_index],
+                              cache->vertex_ptex_uv[vertex_index][0],
+                              cache->vertex_ptex_uv[vertex_index][1],
+                              data->mvert[vertex_index].co);
+}
+
+/* Create the subdivided mesh from the cached one, only evaluating new vertex positions. */
+static Mesh *subdiv_mesh_from_cache(Subdiv *subdiv, const SubdivMeshCache *cache)
+{
+  BKE_subdiv_stats_begin(&subdiv->stats, SUBDIV_STATS_SUBDIV_TO_MESH_GEOMETRY);
+  Mesh *result = BKE_mesh_copy_for_eval(cache->subdiv_mesh, false);
+  SubdivMeshCacheEvalData data = {
+      .subdiv = subdiv,
+      .cache = cache,
+      .mvert = result->mvert,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, result->totvert, &data, subdiv_mesh_cache_eval_position_cb, &settings);
+  BKE_subdiv_stats_end(&subdiv->stats, SUBDIV_STATS_SUBDIV_TO_MESH_GEOMETRY);
+  return result;
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Public entry point
  * \{ */
 
-Mesh *BKE_subdiv_to_mesh(Subdiv *subdiv,
-                         const SubdivToMeshSettings *settings,
-                         const Mesh *coarse_mesh)
+Mesh *BKE_subdiv_to_mesh_cached(Subdiv *subdiv,
+                                const SubdivToMeshSettings *settings,
+                                const Mesh *coarse_mesh,
+                                SubdivMeshCache **cache_p)
 {
   BKE_subdiv_stats_begin(&subdiv->stats, SUBDIV_STATS_SUBDIV_TO_MESH);
   /* Make sure evaluator is up to date with possible new topology, and that
@@ -1127,12 +1384,21 @@ Mesh *BKE_subdiv_to_mesh(Subdiv *subdiv,
       return NULL;
     }
   }
+  /* When nothing but the positions of the coarse vertices changed since the last evaluation,
+   * all the custom data and topology of the result is the same. */
+  if (cache_p != NULL && subdiv_mesh_cache_is_valid(*cache_p, subdiv, settings, coarse_mesh)) {
+    Mesh *result = subdiv_mesh_from_cache(subdiv, *cache_p);
+    BKE_subdiv_stats_end(&subdiv->stats, SUBDIV_STATS_SUBDIV_TO_MESH);
+    BKE_mesh_normals_tag_dirty(result);
+    return result;
+  }
   /* Initialize subdivision mesh creation context. */
   SubdivMeshContext subdiv_context = {0};
   subdiv_context.settings = settings;
   subdiv_context.coarse_mesh = coarse_mesh;
   subdiv_context.subdiv = subdiv;
   subdiv_context.have_displacement = (subdiv->displacement_evaluator != NULL);
+  subdiv_context.record_vertex_ptex = (cache_p != NULL && !subdiv_context.have_displacement);
   /* Multi-threaded traversal/evaluation. */
   BKE_subdiv_stats_begin(&subdiv->stats, SUBDIV_STATS_SUBDIV_TO_MESH_GEOMETRY);
   SubdivForeachContext foreach_context;
@@ -1151,9 +1417,23 @@ Mesh *BKE_subdiv_to_mesh(Subdiv *subdiv,
    * calculating them here. The work may have been pointless anyway if the mesh is deformed or
    * changed afterwards. */
   BKE_mesh_normals_tag_dirty(result);
+  if (cache_p != NULL) {
+    if (!subdiv_context.record_vertex_ptex ||
+        !subdiv_mesh_cache_store(cache_p, &subdiv_context, result)) {
+      BKE_subdiv_mesh_cache_free(*cache_p);
+      *cache_p = NULL;
+    }
+  }
   /* Free used memory. */
   subdiv_mesh_context_free(&subdiv_context);
   return result;
 }
 
+Mesh *BKE_subdiv_to_mesh(Subdiv *subdiv,
+                         const SubdivToMeshSettings *settings,
+                         const Mesh *coarse_mesh)
+{
+  return BKE_subdiv_to_mesh_cached(subdiv, settings, coarse_mesh, NULL);
+}
+
 /** \} */
@@ -703,12 +703,66 @@ static void autotrack_context_reduce(const void *__restrict UNUSED(userdata),
   BLI_movelisttolist(&autotrack_tls_join->results, &autotrack_tls->results);
 }
 
+typedef struct AutoTrackPrefetchData {
+  MovieClip *clip;
+  MovieClipUser user;
+} AutoTrackPrefetchData;
+
+static void autotrack_prefetch_frame_cb(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  AutoTrackPrefetchData *prefetch_data = (AutoTrackPrefetchData *)taskdata;
+  BKE_movieclip_prefetch_sequence_frame(prefetch_data->clip, &prefetch_data->user);
+}
+
+/* Read the frames which will be tracked to on the next step into the movie cache, while the
+ * current step is being tracked. */
+static TaskPool *autotrack_prefetch_next_step_frames(AutoTrackContext *context)
+{
+  const int frame_delta = context->is_backwards ? -1 : 1;
+  bool is_clip_handled[MAX_ACCESSOR_CLIP] = {false};
+  TaskPool *task_pool = NULL;
+
+  for (int i = 0; i < context->num_autotrack_markers; ++i) {
+    const libmv_Marker *libmv_marker = &context->autotrack_markers[i].libmv_marker;
+    const int clip_index = libmv_marker->clip;
+    if (is_clip_handled[clip_index]) {
+      continue;
+    }
+    is_clip_handled[clip_index] = true;
+
+    MovieClip *clip = context->autotrack_clips[clip_index].clip;
+    if (clip->source != MCLIP_SRC_SEQUENCE) {
+      continue;
+    }
+
+    AutoTrackPrefetchData *prefetch_data = MEM_callocN(sizeof(AutoTrackPrefetchData),
+                                                       "autotrack prefetch data");
+    prefetch_data->clip = clip;
+    BKE_movieclip_user_set_frame(
+        &prefetch_data->user,
+        BKE_movieclip_remap_clip_to_scene_frame(clip, libmv_marker->frame + 2 * frame_delta));
+    prefetch_data->user.render_size = MCLIP_PROXY_RENDER_SIZE_FULL;
+    prefetch_data->user.render_flag = 0;
+
+    if (task_pool == NULL) {
+      task_pool = BLI_task_pool_create(NULL, TASK_PRIORITY_LOW);
+    }
+    BLI_task_pool_push(task_pool, autotrack_prefetch_frame_cb, prefetch_data, true, NULL);
+  }
+
+  return task_pool;
+}
+
 bool BKE_autotrack_context_step(AutoTrackContext *context)
 {
   if (context->num_autotrack_markers == 0) {
     return false;
   }
 
+  /* Reading a frame from disk is usually slower than tracking all markers to it, so read ahead
+   * in the background instead of stalling all tracking threads on the next step. */
+  TaskPool *prefetch_task_pool = autotrack_prefetch_next_step_frames(context);
+
   AutoTrackTLS tls;
   BLI_listbase_clear(&tls.results);
 
@@ -722,6 +776,11 @@ bool BKE_autotrack_context_step(AutoTrackContext *context)
   BLI_task_parallel_range(
       0, context->num_autotrack_markers, context, autotrack_context_step_cb, &settings);
 
+  if (prefetch_task_pool != NULL) {
+    BLI_task_pool_work_and_wait(prefetch_task_pool);
+    BLI_task_pool_free(prefetch_task_pool);
+  }
+
   /* Prepare next tracking step by updating the AutoTrack context with new markers and moving
    * tracked markers as an input for the next iteration. */
   context->num_autotrack_markers = 0;
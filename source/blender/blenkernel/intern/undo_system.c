@@ -141,7 +141,9 @@ static bool undosys_step_encode(bContext *C, Main *bmain, UndoStack *ustack, Und
 {
   CLOG_INFO(&LOG, 2, "addr=%p, name='%s', type='%s'", us, us->name, us->type->name);
   UNDO_NESTED_CHECK_BEGIN;
+  const eMEMCategory prev_mem_category = MEM_category_set(MEM_CATEGORY_UNDO);
   bool ok = us->type->step_encode(C, bmain, us);
+  MEM_category_set(prev_mem_category);
   UNDO_NESTED_CHECK_END;
   if (ok) {
     if (us->type->step_foreach_ID_ref != NULL) {
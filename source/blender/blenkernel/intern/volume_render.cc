@@ -10,6 +10,7 @@
 #include "BLI_math_matrix.h"
 #include "BLI_math_vec_types.hh"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
 #include "BLI_vector.hh"
 
 #include "DNA_volume_types.h"
@@ -36,6 +37,90 @@ static void extract_dense_voxels(const openvdb::GridBase &grid,
   openvdb::tools::copyToDense(static_cast<const GridType &>(grid), dense);
 }
 
+/**
+ * Same result as #extract_dense_voxels, but only visits the parts of the tree that are actually
+ * stored instead of every voxel in the bounding box. Sparse volumes like clouds are mostly empty
+ * space, which is left untouched in the zero-initialized \a r_voxels. Therefore this is only valid
+ * when the background value of the grid is zero.
+ */
+template<typename GridType, typename VoxelType>
+static void extract_dense_voxels_sparse(const GridType &grid,
+                                        const openvdb::CoordBBox bbox,
+                                        VoxelType *r_voxels)
+{
+  using TreeType = typename GridType::TreeType;
+  using ValueType = typename GridType::ValueType;
+  using LeafType = typename TreeType::LeafNodeType;
+
+  const ValueType zero = openvdb::zeroVal<ValueType>();
+  const openvdb::Coord min = bbox.min();
+  const int64_t stride_y = bbox.dim().x();
+  const int64_t stride_z = stride_y * bbox.dim().y();
+  auto voxel_offset = [&](const int x, const int y, const int z) {
+    return int64_t(x - min.x()) + int64_t(y - min.y()) * stride_y +
+           int64_t(z - min.z()) * stride_z;
+  };
+
+  /* Tiles of the root and internal nodes, each covering a box of voxels. */
+  typename TreeType::ValueAllCIter tile_iter = grid.tree().cbeginValueAll();
+  tile_iter.setMaxDepth(TreeType::DEPTH - 2);
+  for (; tile_iter; ++tile_iter) {
+    if (*tile_iter == zero) {
+      continue;
+    }
+    openvdb::CoordBBox tile_bbox;
+    tile_iter.getBoundingBox(tile_bbox);
+    tile_bbox.intersect(bbox);
+    if (tile_bbox.empty()) {
+      continue;
+    }
+    const VoxelType value = VoxelType(*tile_iter);
+    for (int z = tile_bbox.min().z(); z <= tile_bbox.max().z(); z++) {
+      for (int y = tile_bbox.min().y(); y <= tile_bbox.max().y(); y++) {
+        std::fill_n(r_voxels + voxel_offset(tile_bbox.min().x(), y, z),
+                    tile_bbox.dim().x(),
+                    value);
+      }
+    }
+  }
+
+  /* Leaves don't overlap each other or the tiles, so they can be copied in parallel. */
+  blender::Vector<const LeafType *> leaves;
+  for (typename TreeType::LeafCIter leaf_iter = grid.tree().cbeginLeaf(); leaf_iter; ++leaf_iter) {
+    leaves.append(leaf_iter.getLeaf());
+  }
+  blender::threading::parallel_for(leaves.index_range(), 16, [&](const blender::IndexRange range) {
+    for (const int i : range) {
+      for (auto iter = leaves[i]->cbeginValueAll(); iter; ++iter) {
+        const openvdb::Coord xyz = iter.getCoord();
+        if (*iter == zero || !bbox.isInside(xyz)) {
+          continue;
+        }
+        r_voxels[voxel_offset(xyz.x(), xyz.y(), xyz.z())] = VoxelType(*iter);
+      }
+    }
+  });
+}
+
+/** Extract the voxels, using #extract_dense_voxels_sparse when possible. */
+template<typename GridType, typename VoxelType>
+static void extract_dense_voxels_auto(const openvdb::GridBase &grid_base,
+                                      const openvdb::CoordBBox bbox,
+                                      VoxelType *r_voxels)
+{
+  BLI_assert(grid_base.isType<GridType>());
+  const GridType &grid = static_cast<const GridType &>(grid_base);
+  if (grid.background() == openvdb::zeroVal<typename GridType::ValueType>()) {
+    extract_dense_voxels_sparse<GridType, VoxelType>(grid, bbox, r_voxels);
+  }
+  else {
+    extract_dense_voxels<GridType, VoxelType>(grid, bbox, r_voxels);
+  }
+}
+
+/**
+ * \param r_voxels: Must be zero-initialized.
+ */
 static void extract_dense_float_voxels(const VolumeGridType grid_type,
                                        const openvdb::GridBase &grid,
                                        const openvdb::CoordBBox &bbox,
@@ -45,23 +130,23 @@ static void extract_dense_float_voxels(const VolumeGridType grid_type,
     case VOLUME_GRID_BOOLEAN:
       return extract_dense_voxels<openvdb::BoolGrid, float>(grid, bbox, r_voxels);
     case VOLUME_GRID_FLOAT:
-      return extract_dense_voxels<openvdb::FloatGrid, float>(grid, bbox, r_voxels);
+      return extract_dense_voxels_auto<openvdb::FloatGrid, float>(grid, bbox, r_voxels);
     case VOLUME_GRID_DOUBLE:
-      return extract_dense_voxels<openvdb::DoubleGrid, float>(grid, bbox, r_voxels);
+      return extract_dense_voxels_auto<openvdb::DoubleGrid, float>(grid, bbox, r_voxels);
     case VOLUME_GRID_INT:
-      return extract_dense_voxels<openvdb::Int32Grid, float>(grid, bbox, r_voxels);
+      return extract_dense_voxels_auto<openvdb::Int32Grid, float>(grid, bbox, r_voxels);
     case VOLUME_GRID_INT64:
-      return extract_dense_voxels<openvdb::Int64Grid, float>(grid, bbox, r_voxels);
+      return extract_dense_voxels_auto<openvdb::Int64Grid, float>(grid, bbox, r_voxels);
     case VOLUME_GRID_MASK:
       return extract_dense_voxels<openvdb::MaskGrid, float>(grid, bbox, r_voxels);
     case VOLUME_GRID_VECTOR_FLOAT:
-      return extract_dense_voxels<openvdb::Vec3fGrid, openvdb::Vec3f>(
+      return extract_dense_voxels_auto<openvdb::Vec3fGrid, openvdb::Vec3f>(
           grid, bbox, reinterpret_cast<openvdb::Vec3f *>(r_voxels));
     case VOLUME_GRID_VECTOR_DOUBLE:
-      return extract_dense_voxels<openvdb::Vec3dGrid, openvdb::Vec3f>(
+      return extract_dense_voxels_auto<openvdb::Vec3dGrid, openvdb::Vec3f>(
           grid, bbox, reinterpret_cast<openvdb::Vec3f *>(r_voxels));
     case VOLUME_GRID_VECTOR_INT:
-      return extract_dense_voxels<openvdb::Vec3IGrid, openvdb::Vec3f>(
+      return extract_dense_voxels_auto<openvdb::Vec3IGrid, openvdb::Vec3f>(
           grid, bbox, reinterpret_cast<openvdb::Vec3f *>(r_voxels));
     case VOLUME_GRID_POINTS:
     case VOLUME_GRID_UNKNOWN:
@@ -107,7 +192,8 @@ bool BKE_volume_grid_dense_floats(const Volume *volume,
                              static_cast<int64_t>(resolution[2]);
   const int channels = BKE_volume_grid_channels(volume_grid);
   const int elem_size = sizeof(float) * channels;
-  float *voxels = static_cast<float *>(MEM_malloc_arrayN(num_voxels, elem_size, __func__));
+  /* Zero-initialized, so that empty space doesn't have to be written by sparse extraction. */
+  float *voxels = static_cast<float *>(MEM_calloc_arrayN(num_voxels, elem_size, __func__));
   if (voxels == nullptr) {
     return false;
   }
@@ -53,6 +53,9 @@
 
 struct StampData;
 
+/* Number of frames #BKE_ffmpeg_append can be ahead of the encoder thread. */
+#  define FFMPEG_ENCODE_QUEUE_SIZE 4
+
 typedef struct FFMpegContext {
   int ffmpeg_type;
   int ffmpeg_codec;
@@ -67,6 +70,8 @@ typedef struct FFMpegContext {
 
   int ffmpeg_crf;    /* set to 0 to not use CRF mode; we have another flag for lossless anyway. */
   int ffmpeg_preset; /* see eFFMpegPreset */
+  int ffmpeg_threads;
+  bool ffmpeg_use_hw_encoder;
 
   AVFormatContext *outfile;
   AVCodecContext *video_codec;
@@ -93,6 +98,19 @@ typedef struct FFMpegContext {
 #  ifdef WITH_AUDASPACE
   AUD_Device *audio_mixdown_device;
 #  endif
+
+  /* Asynchronous encoding: appending a frame only copies the pixels into the queue, the encode
+   * thread converts and encodes them and writes them to the file together with the audio. */
+  bool encode_thread_running;
+  bool encode_thread_stop;
+  bool encode_failed;
+  ListBase encode_threads;
+  ThreadMutex encode_mutex;
+  ThreadCondition encode_cond;
+  AVFrame *encode_queue[FFMPEG_ENCODE_QUEUE_SIZE];
+  double encode_queue_audio_pts[FFMPEG_ENCODE_QUEUE_SIZE];
+  int encode_queue_start;
+  int encode_queue_len;
 } FFMpegContext;
 
 #  define FFMPEG_AUTOSPLIT_SIZE 2000000000
@@ -102,6 +120,7 @@ typedef struct FFMpegContext {
     printf
 
 static void ffmpeg_dict_set_int(AVDictionary **dict, const char *key, int value);
+static void ffmpeg_encode_thread_start(FFMpegContext *context);
 static void ffmpeg_filepath_get(FFMpegContext *context,
                                 char *string,
                                 const struct RenderData *rd,
@@ -356,21 +375,11 @@ static int write_video_frame(FFMpegContext *context, AVFrame *frame, ReportList
   return success;
 }
 
-/* read and encode a frame of video from the buffer */
-static AVFrame *generate_video_frame(FFMpegContext *context, const uint8_t *pixels)
+/* Copy the Blender pixels into an RGBA frame. */
+static void copy_pixels_to_frame(FFMpegContext *context, const uint8_t *pixels, AVFrame *rgb_frame)
 {
   AVCodecParameters *codec = context->video_stream->codecpar;
   int height = codec->height;
-  AVFrame *rgb_frame;
-
-  if (context->img_convert_frame != NULL) {
-    /* Pixel format conversion is needed. */
-    rgb_frame = context->img_convert_frame;
-  }
-  else {
-    /* The output pixel format is Blender's internal pixel format. */
-    rgb_frame = context->current_frame;
-  }
 
   /* Copy the Blender pixels into the FFmpeg datastructure, taking care of endianness and flipping
    * the image vertically. */
@@ -397,22 +406,45 @@ static AVFrame *generate_video_frame(FFMpegContext *context, const uint8_t *pixe
 #    error ENDIAN_ORDER should either be L_ENDIAN or B_ENDIAN.
 #  endif
   }
+}
 
-  /* Convert to the output pixel format, if it's different that Blender's internal one. */
-  if (context->img_convert_frame != NULL) {
-    BLI_assert(context->img_convert_ctx != NULL);
-    sws_scale(context->img_convert_ctx,
-              (const uint8_t *const *)rgb_frame->data,
-              rgb_frame->linesize,
-              0,
-              codec->height,
-              context->current_frame->data,
-              context->current_frame->linesize);
+/* Convert to the output pixel format, if it's different that Blender's internal one. */
+static AVFrame *convert_video_frame(FFMpegContext *context, AVFrame *rgb_frame)
+{
+  if (context->img_convert_ctx == NULL) {
+    return rgb_frame;
   }
 
+  sws_scale(context->img_convert_ctx,
+            (const uint8_t *const *)rgb_frame->data,
+            rgb_frame->linesize,
+            0,
+            context->video_stream->codecpar->height,
+            context->current_frame->data,
+            context->current_frame->linesize);
+
   return context->current_frame;
 }
 
+/* read and encode a frame of video from the buffer */
+static AVFrame *generate_video_frame(FFMpegContext *context, const uint8_t *pixels)
+{
+  AVFrame *rgb_frame;
+
+  if (context->img_convert_frame != NULL) {
+    /* Pixel format conversion is needed. */
+    rgb_frame = context->img_convert_frame;
+  }
+  else {
+    /* The output pixel format is Blender's internal pixel format. */
+    rgb_frame = context->current_frame;
+  }
+
+  copy_pixels_to_frame(context, pixels, rgb_frame);
+
+  return convert_video_frame(context, rgb_frame);
+}
+
 static AVRational calc_time_base(uint den, double num, int codec_id)
 {
   /* Convert the input 'num' to an integer. Simply shift the decimal places until we get an integer
@@ -455,36 +487,46 @@ static AVRational calc_time_base(uint den, double num, int codec_id)
   return time_base;
 }
 
-/* prepare a video stream for the output file */
+/* Hardware H.264 encoders to try before the software one, in order of preference. They all take
+ * frames from system memory, so the conversion from Blender's pixels stays the same. */
+static const char *ffmpeg_hw_encoder_names[] = {
+    "h264_nvenc",
+    "h264_qsv",
+    "h264_amf",
+    "h264_videotoolbox",
+};
 
-static AVStream *alloc_video_stream(FFMpegContext *context,
-                                    RenderData *rd,
-                                    int codec_id,
-                                    AVFormatContext *of,
-                                    int rectx,
-                                    int recty,
-                                    char *error,
-                                    int error_size)
+static enum AVPixelFormat hw_encoder_pix_fmt_get(const AVCodec *codec)
 {
-  AVStream *st;
-  const AVCodec *codec;
-  AVDictionary *opts = NULL;
-
-  error[0] = '\0';
-
-  st = avformat_new_stream(of, NULL);
-  if (!st) {
-    return NULL;
+  if (codec->pix_fmts == NULL) {
+    return AV_PIX_FMT_NONE;
   }
-  st->id = 0;
+  for (const enum AVPixelFormat *p = codec->pix_fmts; *p != AV_PIX_FMT_NONE; p++) {
+    if (ELEM(*p, AV_PIX_FMT_NV12, AV_PIX_FMT_YUV420P)) {
+      return *p;
+    }
+  }
+  return AV_PIX_FMT_NONE;
+}
 
-  /* Set up the codec context */
+/* Set up and open the codec context for the video stream, on failure the context is freed again
+ * so another encoder can be tried. */
+static bool open_video_codec(FFMpegContext *context,
+                             RenderData *rd,
+                             const AVCodec *codec,
+                             int codec_id,
+                             AVFormatContext *of,
+                             AVStream *st,
+                             int rectx,
+                             int recty,
+                             bool is_hardware,
+                             char *error,
+                             int error_size)
+{
+  AVDictionary *opts = NULL;
 
-  codec = avcodec_find_encoder(codec_id);
-  if (!codec) {
-    fprintf(stderr, "Couldn't find valid video codec\n");
-    context->video_codec = NULL;
-    return NULL;
+  if (is_hardware && hw_encoder_pix_fmt_get(codec) == AV_PIX_FMT_NONE) {
+    return false;
   }
 
   context->video_codec = avcodec_alloc_context3(codec);
@@ -528,7 +570,25 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
   c->gop_size = context->ffmpeg_gop_size;
   c->max_b_frames = context->ffmpeg_max_b_frames;
 
-  if (context->ffmpeg_type == FFMPEG_WEBM && context->ffmpeg_crf == 0) {
+  if (is_hardware) {
+    /* Hardware encoders don't support CRF or the x264 presets. Use their own constant quality
+     * mode where there is one (unknown options are ignored by FFmpeg), the bit rate otherwise. */
+    if (context->ffmpeg_crf > 0 && STREQ(codec->name, "h264_nvenc")) {
+      c->bit_rate = 0;
+      ffmpeg_dict_set_int(&opts, "cq", context->ffmpeg_crf);
+    }
+    else if (context->ffmpeg_crf > 0 && STREQ(codec->name, "h264_qsv")) {
+      c->bit_rate = 0;
+      c->global_quality = context->ffmpeg_crf;
+    }
+    else {
+      c->bit_rate = context->ffmpeg_video_bitrate * 1000;
+      c->rc_max_rate = rd->ffcodecdata.rc_max_rate * 1000;
+      c->rc_min_rate = rd->ffcodecdata.rc_min_rate * 1000;
+      c->rc_buffer_size = rd->ffcodecdata.rc_buffer_size * 1024;
+    }
+  }
+  else if (context->ffmpeg_type == FFMPEG_WEBM && context->ffmpeg_crf == 0) {
     ffmpeg_dict_set_int(&opts, "lossless", 1);
   }
   else if (context->ffmpeg_crf >= 0) {
@@ -546,7 +606,7 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
     c->rc_buffer_size = rd->ffcodecdata.rc_buffer_size * 1024;
   }
 
-  if (context->ffmpeg_preset) {
+  if (context->ffmpeg_preset && !is_hardware) {
     /* 'preset' is used by h.264, 'deadline' is used by webm/vp9. I'm not
      * setting those properties conditionally based on the video codec,
      * as the FFmpeg encoder simply ignores unknown settings anyway. */
@@ -578,7 +638,10 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
 
   /* Be sure to use the correct pixel format(e.g. RGB, YUV) */
 
-  if (codec->pix_fmts) {
+  if (is_hardware) {
+    c->pix_fmt = hw_encoder_pix_fmt_get(codec);
+  }
+  else if (codec->pix_fmts) {
     c->pix_fmt = codec->pix_fmts[0];
   }
   else {
@@ -622,7 +685,8 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
   if (codec_id == AV_CODEC_ID_VP9 && rd->im_format.planes == R_IMF_PLANES_RGBA) {
     c->pix_fmt = AV_PIX_FMT_YUVA420P;
   }
-  else if (ELEM(codec_id, AV_CODEC_ID_H264, AV_CODEC_ID_VP9) && (context->ffmpeg_crf == 0)) {
+  else if (ELEM(codec_id, AV_CODEC_ID_H264, AV_CODEC_ID_VP9) && (context->ffmpeg_crf == 0) &&
+           !is_hardware) {
     /* Use 4:4:4 instead of 4:2:0 pixel format for lossless rendering. */
     c->pix_fmt = AV_PIX_FMT_YUV444P;
   }
@@ -644,7 +708,10 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
                                                             255);
   st->avg_frame_rate = av_inv_q(c->time_base);
 
-  if (codec->capabilities & AV_CODEC_CAP_AUTO_THREADS) {
+  if (context->ffmpeg_threads > 0) {
+    c->thread_count = context->ffmpeg_threads;
+  }
+  else if (codec->capabilities & AV_CODEC_CAP_AUTO_THREADS) {
     c->thread_count = 0;
   }
   else {
@@ -659,16 +726,80 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
   }
 
   int ret = avcodec_open2(c, codec, &opts);
+  av_dict_free(&opts);
 
   if (ret < 0) {
-    fprintf(stderr, "Couldn't initialize video codec: %s\n", av_err2str(ret));
+    fprintf(stderr, "Couldn't initialize video codec %s: %s\n", codec->name, av_err2str(ret));
     BLI_strncpy(error, IMB_ffmpeg_last_error(), error_size);
-    av_dict_free(&opts);
     avcodec_free_context(&c);
     context->video_codec = NULL;
+    return false;
+  }
+
+  return true;
+}
+
+/* prepare a video stream for the output file */
+
+static AVStream *alloc_video_stream(FFMpegContext *context,
+                                    RenderData *rd,
+                                    int codec_id,
+                                    AVFormatContext *of,
+                                    int rectx,
+                                    int recty,
+                                    char *error,
+                                    int error_size)
+{
+  AVStream *st;
+  const AVCodec *codec = NULL;
+
+  error[0] = '\0';
+
+  st = avformat_new_stream(of, NULL);
+  if (!st) {
     return NULL;
   }
-  av_dict_free(&opts);
+  st->id = 0;
+
+  /* Set up the codec context */
+
+  if (context->ffmpeg_use_hw_encoder && codec_id == AV_CODEC_ID_H264) {
+    for (int i = 0; i < ARRAY_SIZE(ffmpeg_hw_encoder_names); i++) {
+      const AVCodec *hw_codec = avcodec_find_encoder_by_name(ffmpeg_hw_encoder_names[i]);
+      if (hw_codec && open_video_codec(context,
+                                       rd,
+                                       hw_codec,
+                                       codec_id,
+                                       of,
+                                       st,
+                                       rectx,
+                                       recty,
+                                       true,
+                                       error,
+                                       error_size)) {
+        PRINT("Using hardware video encoder %s\n", hw_codec->name);
+        codec = hw_codec;
+        break;
+      }
+    }
+    /* Not having a usable GPU is not an error, fall back to software encoding. */
+    error[0] = '\0';
+  }
+
+  if (codec == NULL) {
+    codec = avcodec_find_encoder(codec_id);
+    if (!codec) {
+      fprintf(stderr, "Couldn't find valid video codec\n");
+      context->video_codec = NULL;
+      return NULL;
+    }
+    if (!open_video_codec(
+            context, rd, codec, codec_id, of, st, rectx, recty, false, error, error_size)) {
+      return NULL;
+    }
+  }
+
+  AVCodecContext *c = context->video_codec;
 
   /* FFmpeg expects its data in the output pixel format. */
   context->current_frame = alloc_picture(c->pix_fmt, c->width, c->height);
@@ -881,6 +1012,8 @@ static int start_ffmpeg_impl(FFMpegContext *context,
   context->ffmpeg_autosplit = rd->ffcodecdata.flags & FFMPEG_AUTOSPLIT_OUTPUT;
   context->ffmpeg_crf = rd->ffcodecdata.constant_rate_factor;
   context->ffmpeg_preset = rd->ffcodecdata.ffmpeg_preset;
+  context->ffmpeg_threads = rd->ffcodecdata.threads;
+  context->ffmpeg_use_hw_encoder = (rd->ffcodecdata.flags & FFMPEG_USE_HARDWARE_ENCODER) != 0;
 
   if ((rd->ffcodecdata.flags & FFMPEG_USE_MAX_B_FRAMES) != 0) {
     context->ffmpeg_max_b_frames = rd->ffcodecdata.max_b_frames;
@@ -1245,6 +1378,12 @@ int BKE_ffmpeg_start(void *context_v,
         scene, specs, preview ? rd->psfra : rd->sfra, rd->ffcodecdata.audio_volume);
   }
 #  endif
+
+  /* Auto-split restarts the output from #BKE_ffmpeg_append, keep that on the render thread. */
+  if (success && context->video_stream && !context->ffmpeg_autosplit) {
+    ffmpeg_encode_thread_start(context);
+  }
+
   return success;
 }
 
@@ -1265,6 +1404,109 @@ static void write_audio_frames(FFMpegContext *context, double to_pts)
 }
 #  endif
 
+static void *ffmpeg_encode_thread(void *context_v)
+{
+  FFMpegContext *context = context_v;
+
+  BLI_mutex_lock(&context->encode_mutex);
+  while (true) {
+    while (context->encode_queue_len == 0 && !context->encode_thread_stop) {
+      BLI_condition_wait(&context->encode_cond, &context->encode_mutex);
+    }
+    if (context->encode_queue_len == 0) {
+      /* Stopped and every queued frame is written. */
+      break;
+    }
+    const int index = context->encode_queue_start;
+    BLI_mutex_unlock(&context->encode_mutex);
+
+    /* The frame at the start of the queue is not touched by #BKE_ffmpeg_append until it's
+     * removed from the queue below. */
+    AVFrame *avframe = convert_video_frame(context, context->encode_queue[index]);
+    const bool success = write_video_frame(context, avframe, NULL) == 1;
+#  ifdef WITH_AUDASPACE
+    write_audio_frames(context, context->encode_queue_audio_pts[index]);
+#  endif
+
+    BLI_mutex_lock(&context->encode_mutex);
+    if (!success) {
+      context->encode_failed = true;
+    }
+    context->encode_queue_start = (index + 1) % FFMPEG_ENCODE_QUEUE_SIZE;
+    context->encode_queue_len--;
+    BLI_condition_notify_all(&context->encode_cond);
+  }
+  BLI_mutex_unlock(&context->encode_mutex);
+
+  return NULL;
+}
+
+static void ffmpeg_encode_thread_start(FFMpegContext *context)
+{
+  AVCodecParameters *codec = context->video_stream->codecpar;
+
+  for (int i = 0; i < FFMPEG_ENCODE_QUEUE_SIZE; i++) {
+    context->encode_queue[i] = alloc_picture(AV_PIX_FMT_RGBA, codec->width, codec->height);
+  }
+  context->encode_queue_start = 0;
+  context->encode_queue_len = 0;
+  context->encode_thread_stop = false;
+  context->encode_failed = false;
+
+  BLI_mutex_init(&context->encode_mutex);
+  BLI_condition_init(&context->encode_cond);
+  BLI_threadpool_init(&context->encode_threads, ffmpeg_encode_thread, 1);
+  BLI_threadpool_insert(&context->encode_threads, context);
+  context->encode_thread_running = true;
+}
+
+/* Wait for the queued frames to be written and stop the encode thread. */
+static void ffmpeg_encode_thread_end(FFMpegContext *context)
+{
+  if (!context->encode_thread_running) {
+    return;
+  }
+
+  BLI_mutex_lock(&context->encode_mutex);
+  context->encode_thread_stop = true;
+  BLI_condition_notify_all(&context->encode_cond);
+  BLI_mutex_unlock(&context->encode_mutex);
+
+  BLI_threadpool_end(&context->encode_threads);
+  BLI_condition_end(&context->encode_cond);
+  BLI_mutex_end(&context->encode_mutex);
+
+  for (int i = 0; i < FFMPEG_ENCODE_QUEUE_SIZE; i++) {
+    delete_picture(context->encode_queue[i]);
+    context->encode_queue[i] = NULL;
+  }
+  context->encode_thread_running = false;
+}
+
+static bool ffmpeg_encode_thread_push(FFMpegContext *context,
+                                      const uint8_t *pixels,
+                                      double audio_pts)
+{
+  BLI_mutex_lock(&context->encode_mutex);
+  while (context->encode_queue_len == FFMPEG_ENCODE_QUEUE_SIZE) {
+    BLI_condition_wait(&context->encode_cond, &context->encode_mutex);
+  }
+  const int index = (context->encode_queue_start + context->encode_queue_len) %
+                    FFMPEG_ENCODE_QUEUE_SIZE;
+  const bool failed = context->encode_failed;
+  BLI_mutex_unlock(&context->encode_mutex);
+
+  copy_pixels_to_frame(context, pixels, context->encode_queue[index]);
+  context->encode_queue_audio_pts[index] = audio_pts;
+
+  BLI_mutex_lock(&context->encode_mutex);
+  context->encode_queue_len++;
+  BLI_condition_notify_all(&context->encode_cond);
+  BLI_mutex_unlock(&context->encode_mutex);
+
+  return !failed;
+}
+
 int BKE_ffmpeg_append(void *context_v,
                       RenderData *rd,
                       int start_frame,
@@ -1281,7 +1523,16 @@ int BKE_ffmpeg_append(void *context_v,
 
   PRINT("Writing frame %i, render width=%d, render height=%d\n", frame, rectx, recty);
 
-  if (context->video_stream) {
+  if (context->encode_thread_running) {
+    /* Add +1 frame because we want to encode audio up until the next video frame. */
+    const double audio_pts = (frame - start_frame + 1) /
+                             (((double)rd->frs_sec) / (double)rd->frs_sec_base);
+    if (!ffmpeg_encode_thread_push(context, (const uint8_t *)pixels, audio_pts)) {
+      BKE_report(reports, RPT_ERROR, "Error writing frame");
+      success = 0;
+    }
+  }
+  else if (context->video_stream) {
     avframe = generate_video_frame(context, (unsigned char *)pixels);
     success = (avframe && write_video_frame(context, avframe, reports));
 #  ifdef WITH_AUDASPACE
@@ -1309,6 +1560,8 @@ static void end_ffmpeg_impl(FFMpegContext *context, int is_autosplit)
 {
   PRINT("Closing ffmpeg...\n");
 
+  ffmpeg_encode_thread_end(context);
+
 #  ifdef WITH_AUDASPACE
   if (is_autosplit == false) {
     if (context->audio_mixdown_device) {
@@ -245,6 +245,35 @@ template<typename Pointer> struct PointerKeyInfo {
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Batched Operations
+ *
+ * When many keys are added or looked up at once, most of the time is spent waiting for the slots
+ * to be loaded from memory, because the slots of consecutive keys are usually far apart. Batched
+ * operations first compute the hashes of a few keys and prefetch their initial slots, so that
+ * the memory accesses overlap, and only then probe the slots of the same keys.
+ *
+ * \{ */
+
+/**
+ * Number of keys whose slots are prefetched before they are probed. It should be large enough to
+ * hide the memory latency, but small enough that the prefetched cache lines are not evicted again
+ * before they are used.
+ */
+static constexpr int64_t hash_table_batch_size = 16;
+
+/** Hint to the processor that the memory at the given address will be read soon. */
+inline void hash_table_prefetch(const void *address)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(address);
+#else
+  UNUSED_VARS(address);
+#endif
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Hash Table Stats
  *
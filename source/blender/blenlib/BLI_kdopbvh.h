@@ -191,6 +191,16 @@ BVHTreeOverlap *BLI_bvhtree_overlap(const BVHTree *tree1,
                                     unsigned int *r_overlap_tot,
                                     BVHTree_OverlapCallback callback,
                                     void *userdata);
+/**
+ * Same as overlapping a tree with itself, but every pair of different leaves is only tested and
+ * reported once, with the lower index as `indexA`. This is about twice as fast.
+ *
+ * \param callback: optional, to test the overlap before adding (must be thread-safe!).
+ */
+BVHTreeOverlap *BLI_bvhtree_overlap_self(const BVHTree *tree,
+                                         unsigned int *r_overlap_tot,
+                                         BVHTree_OverlapCallback callback,
+                                         void *userdata);
 
 int *BLI_bvhtree_intersect_plane(BVHTree *tree, float plane[4], uint *r_intersect_tot);
 
@@ -324,3 +334,56 @@ extern const float bvhtree_kdop_axes[13][3];
 #ifdef __cplusplus
 }
 #endif
+
+#ifdef __cplusplus
+
+#  include "BLI_function_ref.hh"
+#  include "BLI_index_mask.hh"
+#  include "BLI_math_vec_types.hh"
+#  include "BLI_virtual_array.hh"
+
+namespace blender {
+
+/**
+ * Find the nearest element for every position in the mask.
+ *
+ * The queries are ordered along a space filling curve and distributed over threads, so that
+ * consecutive queries on a thread mostly visit the same nodes of the tree.
+ *
+ * \param dist_sq: The squared search radius of every query.
+ * \param result_fn: Called with the result of every query, also when nothing was found (the
+ * index of the result is -1 then).
+ * \note The callbacks are called from multiple threads.
+ */
+void BLI_bvhtree_find_nearest_batch(BVHTree *tree,
+                                    IndexMask mask,
+                                    const VArray<float3> &positions,
+                                    float dist_sq,
+                                    BVHTree_NearestPointCallback callback,
+                                    void *userdata,
+                                    FunctionRef<void(int64_t i, const BVHTreeNearest &nearest)>
+                                        result_fn);
+
+/**
+ * Cast a ray for every index in the mask, like #BLI_bvhtree_find_nearest_batch.
+ *
+ * \param directions: The ray directions, they don't have to be normalized.
+ * \param lengths: The maximum distance of every ray.
+ * \param result_fn: Called with the result of every ray, also when nothing was hit (the index of
+ * the hit is -1 then).
+ * \return The number of rays that hit something.
+ */
+int64_t BLI_bvhtree_ray_cast_batch(BVHTree *tree,
+                                   IndexMask mask,
+                                   const VArray<float3> &origins,
+                                   const VArray<float3> &directions,
+                                   const VArray<float> &lengths,
+                                   float radius,
+                                   BVHTree_RayCastCallback callback,
+                                   void *userdata,
+                                   FunctionRef<void(int64_t i, const BVHTreeRayHit &hit)>
+                                       result_fn);
+
+}  // namespace blender
+
+#endif
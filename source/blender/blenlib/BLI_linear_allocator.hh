@@ -6,6 +6,9 @@
  * A linear allocator is the simplest form of an allocator. It never reuses any memory, and
  * therefore does not need a deallocation method. It simply hands out consecutive buffers of
  * memory. When the current buffer is full, it reallocates a new larger buffer and continues.
+ *
+ * All memory can be made available again at once with #LinearAllocator::reset, which allows
+ * using the same allocator as a scratch arena for many short-lived tasks.
  */
 
 #pragma once
@@ -19,8 +22,10 @@ namespace blender {
 template<typename Allocator = GuardedAllocator> class LinearAllocator : NonCopyable, NonMovable {
  private:
   Allocator allocator_;
-  Vector<void *> owned_buffers_;
-  Vector<Span<char>> unused_borrowed_buffers_;
+  Vector<Span<char>> owned_buffers_;
+  Vector<Span<char>> borrowed_buffers_;
+  /** Owned or borrowed buffers that no allocation has been made from yet. */
+  Vector<Span<char>> unused_buffers_;
 
   uintptr_t current_begin_;
   uintptr_t current_end_;
@@ -42,8 +47,8 @@ template<typename Allocator = GuardedAllocator> class LinearAllocator : NonCopya
 
   ~LinearAllocator()
   {
-    for (void *ptr : owned_buffers_) {
-      allocator_.deallocate(ptr);
+    for (Span<char> buffer : owned_buffers_) {
+      allocator_.deallocate(const_cast<char *>(buffer.data()));
     }
   }
 
@@ -191,7 +196,8 @@ template<typename Allocator = GuardedAllocator> class LinearAllocator : NonCopya
    */
   void provide_buffer(void *buffer, uint size)
   {
-    unused_borrowed_buffers_.append(Span<char>(static_cast<char *>(buffer), size));
+    borrowed_buffers_.append(Span<char>(static_cast<char *>(buffer), size));
+    unused_buffers_.append(borrowed_buffers_.last());
   }
 
   template<size_t Size, size_t Alignment>
@@ -200,18 +206,71 @@ template<typename Allocator = GuardedAllocator> class LinearAllocator : NonCopya
     this->provide_buffer(aligned_buffer.ptr(), Size);
   }
 
+  /**
+   * Make the memory of all previous allocations available for new allocations again, without
+   * giving it back to the system. Values constructed in the allocator must have been destructed
+   * before, and previously allocated buffers must not be used anymore.
+   *
+   * \param max_kept_bytes: Owned buffers beyond this total size are freed, so that a single large
+   * task doesn't keep its memory alive when the allocator is reused for smaller tasks.
+   */
+  void reset(const int64_t max_kept_bytes = INT64_MAX)
+  {
+    unused_buffers_ = borrowed_buffers_;
+    int64_t kept_bytes = 0;
+    int64_t kept_num = 0;
+    for (const Span<char> buffer : owned_buffers_) {
+      if (kept_bytes + buffer.size() <= max_kept_bytes) {
+        kept_bytes += buffer.size();
+        owned_buffers_[kept_num++] = buffer;
+        unused_buffers_.append(buffer);
+      }
+      else {
+        allocator_.deallocate(const_cast<char *>(buffer.data()));
+      }
+    }
+    owned_buffers_.resize(kept_num);
+    current_begin_ = 0;
+    current_end_ = 0;
+#ifdef DEBUG
+    debug_allocated_amount_ = 0;
+#endif
+  }
+
  private:
-  void allocate_new_buffer(int64_t min_allocation_size, int64_t min_alignment)
+  /**
+   * Remove the smallest unused buffer that can hold an allocation with the given size and
+   * alignment from the unused buffers. Returns an empty span if there is no such buffer.
+   */
+  Span<char> take_unused_buffer(const int64_t min_size, const int64_t alignment)
   {
-    for (int64_t i : unused_borrowed_buffers_.index_range()) {
-      Span<char> buffer = unused_borrowed_buffers_[i];
-      if (buffer.size() >= min_allocation_size) {
-        unused_borrowed_buffers_.remove_and_reorder(i);
-        current_begin_ = (uintptr_t)buffer.begin();
-        current_end_ = (uintptr_t)buffer.end();
-        return;
+    const uintptr_t alignment_mask = alignment - 1;
+    int64_t best_index = -1;
+    for (const int64_t i : unused_buffers_.index_range()) {
+      const Span<char> buffer = unused_buffers_[i];
+      const uintptr_t aligned_begin = ((uintptr_t)buffer.begin() + alignment_mask) &
+                                      ~alignment_mask;
+      if (aligned_begin + min_size <= (uintptr_t)buffer.end() &&
+          (best_index == -1 || buffer.size() < unused_buffers_[best_index].size())) {
+        best_index = i;
       }
     }
+    if (best_index == -1) {
+      return {};
+    }
+    const Span<char> buffer = unused_buffers_[best_index];
+    unused_buffers_.remove_and_reorder(best_index);
+    return buffer;
+  }
+
+  void allocate_new_buffer(int64_t min_allocation_size, int64_t min_alignment)
+  {
+    const Span<char> unused_buffer = this->take_unused_buffer(min_allocation_size, 1);
+    if (!unused_buffer.is_empty()) {
+      current_begin_ = (uintptr_t)unused_buffer.begin();
+      current_end_ = (uintptr_t)unused_buffer.end();
+      return;
+    }
 
     /* Possibly allocate more bytes than necessary for the current allocation. This way more small
      * allocations can be packed together. Large buffers are allocated exactly to avoid wasting too
@@ -225,15 +284,21 @@ template<typename Allocator = GuardedAllocator> class LinearAllocator : NonCopya
     }
 
     void *buffer = allocator_.allocate(size_in_bytes, min_alignment, __func__);
-    owned_buffers_.append(buffer);
+    owned_buffers_.append(Span<char>(static_cast<char *>(buffer), size_in_bytes));
     current_begin_ = (uintptr_t)buffer;
     current_end_ = current_begin_ + size_in_bytes;
   }
 
   void *allocator_large_buffer(const int64_t size, const int64_t alignment)
   {
+    const Span<char> unused_buffer = this->take_unused_buffer(size, alignment);
+    if (!unused_buffer.is_empty()) {
+      const uintptr_t alignment_mask = alignment - 1;
+      return reinterpret_cast<void *>(((uintptr_t)unused_buffer.begin() + alignment_mask) &
+                                      ~alignment_mask);
+    }
     void *buffer = allocator_.allocate(size, alignment, __func__);
-    owned_buffers_.append(buffer);
+    owned_buffers_.append(Span<char>(static_cast<char *>(buffer), size));
     return buffer;
   }
 };
@@ -270,6 +270,26 @@ class Map {
         std::forward<ForwardKey>(key), hash_(key), std::forward<ForwardValue>(value)...);
   }
 
+  /**
+   * Add many key-value-pairs to the map at once. Keys that are in the map already are ignored, as
+   * in `add`. This is faster than adding the pairs one by one for large maps, because the slots of
+   * multiple keys are prefetched at once.
+   */
+  void add_multiple(const Span<Key> keys, const Span<Value> values)
+  {
+    BLI_assert(keys.size() == values.size());
+    for (int64_t start = 0; start < keys.size(); start += hash_table_batch_size) {
+      const IndexRange batch(start, std::min(hash_table_batch_size, keys.size() - start));
+      /* Grow before the slots are prefetched, so that adding the keys doesn't invalidate them. */
+      if (occupied_and_removed_slots_ + batch.size() > usable_slots_) {
+        this->realloc_and_reinsert(this->size() + batch.size());
+      }
+      this->foreach_key_prefetched(keys, batch, [&](const int64_t i, const uint64_t hash) {
+        this->add__impl(keys[i], hash, values[i]);
+      });
+    }
+  }
+
   /**
    * Adds a key-value-pair to the map. If the map contained the key already, the corresponding
    * value will be replaced.
@@ -503,6 +523,20 @@ class Map {
     return *ptr;
   }
 
+  /**
+   * Copy the values that correspond to the given keys into the output span. All keys have to be
+   * in the map. This is faster than looking up the keys one by one for large maps, because the
+   * slots of multiple keys are prefetched at once.
+   */
+  void lookup_multiple(const Span<Key> keys, MutableSpan<Value> r_values) const
+  {
+    BLI_assert(keys.size() == r_values.size());
+    this->foreach_key_prefetched(
+        keys, keys.index_range(), [&](const int64_t i, const uint64_t hash) {
+          r_values[i] = *this->lookup_slot(keys[i], hash).value();
+        });
+  }
+
   /**
    * Returns a copy of the value that corresponds to the given key. If the key is not in the
    * map, the provided default_value is returned.
@@ -1226,6 +1260,27 @@ class Map {
       BLI_assert(occupied_and_removed_slots_ < usable_slots_);
     }
   }
+
+  /**
+   * Call the function for the index of every key in the range with its hash, after the initial
+   * slots of a batch of keys have been prefetched.
+   */
+  template<typename Fn>
+  void foreach_key_prefetched(const Span<Key> keys, const IndexRange range, const Fn &fn) const
+  {
+    uint64_t hashes[hash_table_batch_size];
+    const int64_t end = range.one_after_last();
+    for (int64_t start = range.start(); start < end; start += hash_table_batch_size) {
+      const IndexRange batch(start, std::min(hash_table_batch_size, end - start));
+      for (const int64_t i : batch) {
+        hashes[i - start] = hash_(keys[i]);
+        hash_table_prefetch(&slots_[ProbingStrategy(hashes[i - start]).get() & slot_mask_]);
+      }
+      for (const int64_t i : batch) {
+        fn(i, hashes[i - start]);
+      }
+    }
+  }
 };
 
 /**
@@ -82,6 +82,32 @@ void *BLI_mempool_as_arrayN(BLI_mempool *pool,
 void BLI_mempool_set_memory_debug(void);
 #endif
 
+/**
+ * Thread local allocation.
+ *
+ * A pool isn't thread-safe, but every thread can allocate and free elements of the same pool
+ * through its own #BLI_mempool_local. It reserves a chunk worth of elements from the pool at
+ * once, so the pool is only locked once per chunk. Elements can be freed through any local of
+ * the pool, not only the one they were allocated from.
+ *
+ * While locals exist, the pool itself must not be used by other threads, and elements that are
+ * reserved by a local count as used in #BLI_mempool_len. Reserved elements are skipped by
+ * iteration, which is valid again once all threads are done allocating.
+ */
+typedef struct BLI_mempool_local BLI_mempool_local;
+
+BLI_mempool_local *BLI_mempool_local_create(BLI_mempool *pool)
+    ATTR_MALLOC ATTR_WARN_UNUSED_RESULT ATTR_RETURNS_NONNULL ATTR_NONNULL(1);
+void *BLI_mempool_local_alloc(BLI_mempool_local *local)
+    ATTR_MALLOC ATTR_WARN_UNUSED_RESULT ATTR_RETURNS_NONNULL ATTR_NONNULL(1);
+void *BLI_mempool_local_calloc(BLI_mempool_local *local)
+    ATTR_MALLOC ATTR_WARN_UNUSED_RESULT ATTR_RETURNS_NONNULL ATTR_NONNULL(1);
+void BLI_mempool_local_free(BLI_mempool_local *local, void *addr) ATTR_NONNULL(1, 2);
+/**
+ * Give the unused reserved elements back to the pool and free the local.
+ */
+void BLI_mempool_local_destroy(BLI_mempool_local *local) ATTR_NONNULL(1);
+
 /**
  * Iteration stuff.
  * \note this may easy to produce bugs with.
@@ -50,9 +50,8 @@
  * - Use a branch-less loop over slots in grow function (measured ~10% performance improvement when
  *   the distribution of occupied slots is sufficiently random).
  * - Support max load factor customization.
- * - Improve performance with large data sets through software prefetching. I got fairly
- *   significant improvements in simple tests (~30% faster). It still needs to be investigated how
- *   to make a nice interface for this functionality.
+ * - Use software prefetching in more batched operations. Currently only `add_multiple` and
+ *   `add_multiple_new` prefetch slots.
  */
 
 #include <unordered_set>
@@ -267,14 +266,13 @@ class Set {
    * Convenience function to add many keys to the set at once. Duplicates are removed
    * automatically.
    *
-   * We might be able to make this faster than sequentially adding all keys, but that is not
-   * implemented yet.
+   * This is faster than adding the keys one by one for large sets, because the slots of multiple
+   * keys are prefetched at once.
    */
   void add_multiple(Span<Key> keys)
   {
-    for (const Key &key : keys) {
-      this->add(key);
-    }
+    this->foreach_key_prefetched(
+        keys, [&](const Key &key, const uint64_t hash) { this->add__impl(key, hash); });
   }
 
   /**
@@ -283,9 +281,8 @@ class Set {
    */
   void add_multiple_new(Span<Key> keys)
   {
-    for (const Key &key : keys) {
-      this->add_new(key);
-    }
+    this->foreach_key_prefetched(
+        keys, [&](const Key &key, const uint64_t hash) { this->add_new__impl(key, hash); });
   }
 
   /**
@@ -835,6 +832,30 @@ class Set {
       BLI_assert(occupied_and_removed_slots_ < usable_slots_);
     }
   }
+
+  /**
+   * Call the function for every key with its hash, after the initial slots of a batch of keys
+   * have been prefetched. The set grows before every batch if necessary, so that the function
+   * can add the key without invalidating the prefetched slots.
+   */
+  template<typename Fn> void foreach_key_prefetched(const Span<Key> keys, const Fn &fn)
+  {
+    uint64_t hashes[hash_table_batch_size];
+    for (int64_t start = 0; start < keys.size(); start += hash_table_batch_size) {
+      const Span<Key> batch = keys.slice(start,
+                                         std::min(hash_table_batch_size, keys.size() - start));
+      if (occupied_and_removed_slots_ + batch.size() > usable_slots_) {
+        this->realloc_and_reinsert(this->size() + batch.size());
+      }
+      for (const int64_t i : batch.index_range()) {
+        hashes[i] = hash_(batch[i]);
+        hash_table_prefetch(&slots_[ProbingStrategy(hashes[i]).get() & slot_mask_]);
+      }
+      for (const int64_t i : batch.index_range()) {
+        fn(batch[i], hashes[i]);
+      }
+    }
+  }
 };
 
 /**
@@ -0,0 +1,48 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Recording of timed events and counters from any thread, written as Chrome trace JSON that can
+ * be opened in `chrome://tracing` or https://ui.perfetto.dev to see a timeline.
+ *
+ * Tracing is disabled by default (see `--debug-trace`). While disabled, the cost of a trace
+ * point is a call to #BLI_trace_is_enabled, so callers should only build event names after
+ * checking it.
+ *
+ * Time stamps use #PIL_check_seconds_timer, so code that already measures its time with it can
+ * pass those measurements to #BLI_trace_complete.
+ */
+
+#include "BLI_sys_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Start recording events, they are written to the given file by #BLI_trace_exit. */
+void BLI_trace_enable(const char *filepath);
+bool BLI_trace_is_enabled(void);
+
+/**
+ * Begin an event on the calling thread. Events on the same thread must be nested, every call has
+ * to be matched by a #BLI_trace_end on the same thread. The strings are copied.
+ */
+void BLI_trace_begin(const char *category, const char *name);
+void BLI_trace_end(void);
+/** Add an event that has been timed by the caller, in seconds of #PIL_check_seconds_timer. */
+void BLI_trace_complete(const char *category,
+                        const char *name,
+                        double start_time,
+                        double duration);
+/** Record the current value of a counter, it is displayed as a graph over time. */
+void BLI_trace_counter(const char *name, double value);
+
+/** Write the recorded events to the file given to #BLI_trace_enable and free them. */
+void BLI_trace_exit(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,37 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ */
+
+#include "BLI_trace.h"
+#include "BLI_utility_mixins.hh"
+
+namespace blender {
+
+/**
+ * Records a trace event for the lifetime of the object, see #BLI_trace_begin.
+ */
+class ScopedTraceEvent : NonCopyable, NonMovable {
+ private:
+  bool enabled_;
+
+ public:
+  ScopedTraceEvent(const char *category, const char *name) : enabled_(BLI_trace_is_enabled())
+  {
+    if (enabled_) {
+      BLI_trace_begin(category, name);
+    }
+  }
+
+  ~ScopedTraceEvent()
+  {
+    if (enabled_) {
+      BLI_trace_end();
+    }
+  }
+};
+
+}  // namespace blender
@@ -1158,4 +1158,40 @@ inline void devirtualize_varray2(const VArray<T1> &varray1,
   func(varray1, varray2);
 }
 
+/**
+ * Same as `devirtualize_varray2`, but for three virtual arrays. Not all combinations of spans and
+ * single values are optimized, to limit the number of instantiations. The cases handled here are
+ * the common ones, where the leading inputs come from attributes and the trailing inputs are
+ * constant parameters.
+ */
+template<typename T1, typename T2, typename T3, typename Func>
+inline void devirtualize_varray3(const VArray<T1> &varray1,
+                                 const VArray<T2> &varray2,
+                                 const VArray<T3> &varray3,
+                                 const Func &func,
+                                 bool enable = true)
+{
+  /* Support disabling the devirtualization to simplify benchmarking. */
+  if (enable) {
+    const bool is_span1 = varray1.is_span();
+    const bool is_span2 = varray2.is_span();
+    const bool is_span3 = varray3.is_span();
+    const bool is_single2 = varray2.is_single();
+    const bool is_single3 = varray3.is_single();
+    if (is_span1 && is_span2 && is_span3) {
+      func(varray1.get_internal_span(), varray2.get_internal_span(), varray3.get_internal_span());
+      return;
+    }
+    if (is_span1 && is_span2 && is_single3) {
+      func(varray1.get_internal_span(), varray2.get_internal_span(), SingleAsSpan(varray3));
+      return;
+    }
+    if (is_span1 && is_single2 && is_single3) {
+      func(varray1.get_internal_span(), SingleAsSpan(varray2), SingleAsSpan(varray3));
+      return;
+    }
+  }
+  func(varray1, varray2, varray3);
+}
+
 }  // namespace blender
@@ -99,6 +99,9 @@ typedef struct BVHOverlapData_Shared {
   /* use for callbacks */
   BVHTree_OverlapCallback callback;
   void *userdata;
+
+  /* Report pairs with the lower index first, for self overlap. */
+  bool sort_pairs;
 } BVHOverlapData_Shared;
 
 typedef struct BVHOverlapData_Thread {
@@ -1018,17 +1021,49 @@ bool BLI_bvhtree_update_node(
   return true;
 }
 
+static void bvhtree_update_tree_task_cb(void *__restrict userdata,
+                                        const int j,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BVHTree *tree = userdata;
+  node_join(tree, tree->nodes[tree->totleaf + j]);
+}
+
 void BLI_bvhtree_update_tree(BVHTree *tree)
 {
   /* Update bottom=>top
    * TRICKY: the way we build the tree all the children have an index greater than the parent
    * This allows us todo a bottom up update by starting on the bigger numbered branch. */
 
-  BVHNode **root = tree->nodes + tree->totleaf;
-  BVHNode **index = tree->nodes + tree->totleaf + tree->totbranch - 1;
+  if (tree->totleaf <= KDOPBVH_THREAD_LEAF_THRESHOLD) {
+    BVHNode **root = tree->nodes + tree->totleaf;
+    BVHNode **index = tree->nodes + tree->totleaf + tree->totbranch - 1;
 
-  for (; index >= root; index--) {
-    node_join(tree, *index);
+    for (; index >= root; index--) {
+      node_join(tree, *index);
+    }
+    return;
+  }
+
+  /* The branches are stored level by level (see #non_recursive_bvh_div_nodes),
+   * so all branches of a level can be joined in parallel once the level below is done. */
+  const int tree_offset = 2 - tree->tree_type;
+  int level_start[32];
+  int levels_num = 0;
+  for (int i = 1; i <= tree->totbranch; i = i * tree->tree_type + tree_offset) {
+    BLI_assert(levels_num < (int)ARRAY_SIZE(level_start));
+    level_start[levels_num++] = i - 1;
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 256;
+
+  int level_end = tree->totbranch;
+  for (int level = levels_num - 1; level >= 0; level--) {
+    BLI_task_parallel_range(
+        level_start[level], level_end, tree, bvhtree_update_tree_task_cb, &settings);
+    level_end = level_start[level];
   }
 }
 int BLI_bvhtree_get_len(const BVHTree *tree)
@@ -1152,12 +1187,18 @@ static void tree_overlap_traverse_cb(BVHOverlapData_Thread *data_thread,
           return;
         }
 
+        int index_a = node1->index, index_b = node2->index;
+        if (data->sort_pairs && index_a > index_b) {
+          SWAP(int, index_a, index_b);
+        }
+
         /* only difference to tree_overlap_traverse! */
-        if (data->callback(data->userdata, node1->index, node2->index, data_thread->thread)) {
+        if (!data->callback ||
+            data->callback(data->userdata, index_a, index_b, data_thread->thread)) {
           /* both leafs, insert overlap! */
           overlap = BLI_stack_push_r(data_thread->overlap);
-          overlap->indexA = node1->index;
-          overlap->indexB = node2->index;
+          overlap->indexA = index_a;
+          overlap->indexB = index_b;
         }
       }
       else {
@@ -1312,6 +1353,7 @@ BVHTreeOverlap *BLI_bvhtree_overlap_ex(
   /* can be NULL */
   data_shared.callback = callback;
   data_shared.userdata = userdata;
+  data_shared.sort_pairs = false;
 
   for (j = 0; j < thread_num; j++) {
     /* init BVHOverlapData_Thread */
@@ -1377,6 +1419,91 @@ BVHTreeOverlap *BLI_bvhtree_overlap(
                                 BVH_OVERLAP_USE_THREADING | BVH_OVERLAP_RETURN_PAIRS);
 }
 
+/**
+ * Find the overlapping leaf pairs within a single subtree. Pairs of a leaf with itself are
+ * skipped, and each pair is only visited once, unlike when overlapping the tree with itself.
+ */
+static void tree_overlap_traverse_self(BVHOverlapData_Thread *data_thread, const BVHNode *node)
+{
+  for (int j = 0; j < node->totnode; j++) {
+    const BVHNode *child = node->children[j];
+    tree_overlap_traverse_self(data_thread, child);
+    for (int k = j + 1; k < node->totnode; k++) {
+      tree_overlap_traverse_cb(data_thread, child, node->children[k]);
+    }
+  }
+}
+
+static void bvhtree_overlap_self_task_cb(void *__restrict userdata,
+                                         const int j,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BVHOverlapData_Thread *data = &((BVHOverlapData_Thread *)userdata)[j];
+  const BVHTree *tree = data->shared->tree1;
+  const BVHNode *root = tree->nodes[tree->totleaf];
+  const BVHNode *child = root->children[j];
+
+  tree_overlap_traverse_self(data, child);
+  for (int k = j + 1; k < root->totnode; k++) {
+    tree_overlap_traverse_cb(data, child, root->children[k]);
+  }
+}
+
+BVHTreeOverlap *BLI_bvhtree_overlap_self(const BVHTree *tree,
+                                         uint *r_overlap_tot,
+                                         BVHTree_OverlapCallback callback,
+                                         void *userdata)
+{
+  const bool use_threading = tree->totleaf > KDOPBVH_THREAD_LEAF_THRESHOLD;
+  const BVHNode *root = tree->nodes[tree->totleaf];
+  const int root_node_len = BLI_bvhtree_overlap_thread_num(tree);
+  const int thread_num = use_threading ? root_node_len : 1;
+  BVHOverlapData_Shared data_shared;
+  BVHOverlapData_Thread *data = BLI_array_alloca(data, (size_t)thread_num);
+
+  data_shared.tree1 = tree;
+  data_shared.tree2 = tree;
+  data_shared.start_axis = tree->start_axis;
+  data_shared.stop_axis = tree->stop_axis;
+  data_shared.callback = callback;
+  data_shared.userdata = userdata;
+  data_shared.sort_pairs = true;
+
+  for (int j = 0; j < thread_num; j++) {
+    data[j].shared = &data_shared;
+    data[j].overlap = BLI_stack_new(sizeof(BVHTreeOverlap), __func__);
+    data[j].max_interactions = 0;
+    data[j].thread = j;
+  }
+
+  if (use_threading) {
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1;
+    BLI_task_parallel_range(0, root_node_len, data, bvhtree_overlap_self_task_cb, &settings);
+  }
+  else {
+    tree_overlap_traverse_self(data, root);
+  }
+
+  size_t total = 0;
+  for (int j = 0; j < thread_num; j++) {
+    total += BLI_stack_count(data[j].overlap);
+  }
+
+  BVHTreeOverlap *overlap = MEM_mallocN(sizeof(BVHTreeOverlap) * total, "BVHTreeOverlap");
+  BVHTreeOverlap *to = overlap;
+  for (int j = 0; j < thread_num; j++) {
+    uint count = (uint)BLI_stack_count(data[j].overlap);
+    BLI_stack_pop_n(data[j].overlap, to, count);
+    BLI_stack_free(data[j].overlap);
+    to += count;
+  }
+  *r_overlap_tot = (uint)total;
+
+  return overlap;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -0,0 +1,156 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ *
+ * Queries of many points or rays at once on a #BVHTree.
+ */
+
+#include <algorithm>
+
+#include "BLI_array.hh"
+#include "BLI_kdopbvh.h"
+#include "BLI_math_vector.hh"
+#include "BLI_task.hh"
+
+#include "atomic_ops.h"
+
+#ifdef WITH_TBB
+#  include <tbb/parallel_sort.h>
+#endif
+
+namespace blender {
+
+/** Below this number of queries, ordering them costs more than it saves. */
+static constexpr int64_t sort_queries_threshold = 4096;
+static constexpr int64_t query_grain_size = 256;
+
+/** Spread the lowest 10 bits of the value so that there are two zero bits between each bit. */
+static uint32_t morton_spread_bits(uint32_t v)
+{
+  v = (v | (v << 16)) & 0x030000FF;
+  v = (v | (v << 8)) & 0x0300F00F;
+  v = (v | (v << 4)) & 0x030C30C3;
+  v = (v | (v << 2)) & 0x09249249;
+  return v;
+}
+
+/**
+ * Order the indices in the mask along a Z-order curve through the bounding box of the tree,
+ * so that queries that are close in space are processed after each other.
+ */
+static Array<int64_t> sort_queries_spatially(const BVHTree *tree,
+                                             const IndexMask mask,
+                                             const VArray<float3> &positions)
+{
+  float3 bb_min, bb_max;
+  BLI_bvhtree_get_bounding_box(const_cast<BVHTree *>(tree), bb_min, bb_max);
+  const float3 size = bb_max - bb_min;
+  const float3 scale(size.x > 0.0f ? 1023.0f / size.x : 0.0f,
+                     size.y > 0.0f ? 1023.0f / size.y : 0.0f,
+                     size.z > 0.0f ? 1023.0f / size.z : 0.0f);
+
+  Array<std::pair<uint32_t, int64_t>> keys(mask.size());
+  threading::parallel_for(mask.index_range(), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const int64_t index = mask[i];
+      const float3 co = (positions[index] - bb_min) * scale;
+      const uint32_t x = uint32_t(std::clamp(co.x, 0.0f, 1023.0f));
+      const uint32_t y = uint32_t(std::clamp(co.y, 0.0f, 1023.0f));
+      const uint32_t z = uint32_t(std::clamp(co.z, 0.0f, 1023.0f));
+      keys[i] = {morton_spread_bits(x) | (morton_spread_bits(y) << 1) |
+                     (morton_spread_bits(z) << 2),
+                 index};
+    }
+  });
+
+#ifdef WITH_TBB
+  tbb::parallel_sort(keys.begin(), keys.end());
+#else
+  std::sort(keys.begin(), keys.end());
+#endif
+
+  Array<int64_t> sorted_indices(mask.size());
+  threading::parallel_for(mask.index_range(), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      sorted_indices[i] = keys[i].second;
+    }
+  });
+  return sorted_indices;
+}
+
+/**
+ * Call the function for all indices in the mask, in parallel and in a spatially coherent order
+ * for large masks.
+ */
+static void foreach_query_index(const BVHTree *tree,
+                                const IndexMask mask,
+                                const VArray<float3> &positions,
+                                const FunctionRef<void(Span<int64_t> indices)> fn)
+{
+  if (mask.size() < sort_queries_threshold) {
+    threading::parallel_for(mask.index_range(), query_grain_size, [&](const IndexRange range) {
+      fn(mask.slice(range).indices());
+    });
+    return;
+  }
+
+  const Array<int64_t> sorted_indices = sort_queries_spatially(tree, mask, positions);
+  threading::parallel_for(
+      sorted_indices.index_range(), query_grain_size, [&](const IndexRange range) {
+        fn(sorted_indices.as_span().slice(range));
+      });
+}
+
+void BLI_bvhtree_find_nearest_batch(BVHTree *tree,
+                                    const IndexMask mask,
+                                    const VArray<float3> &positions,
+                                    const float dist_sq,
+                                    BVHTree_NearestPointCallback callback,
+                                    void *userdata,
+                                    const FunctionRef<void(int64_t i, const BVHTreeNearest &nearest)>
+                                        result_fn)
+{
+  foreach_query_index(tree, mask, positions, [&](const Span<int64_t> indices) {
+    for (const int64_t i : indices) {
+      const float3 position = positions[i];
+      BVHTreeNearest nearest;
+      nearest.index = -1;
+      nearest.dist_sq = dist_sq;
+      BLI_bvhtree_find_nearest(tree, position, &nearest, callback, userdata);
+      result_fn(i, nearest);
+    }
+  });
+}
+
+int64_t BLI_bvhtree_ray_cast_batch(BVHTree *tree,
+                                   const IndexMask mask,
+                                   const VArray<float3> &origins,
+                                   const VArray<float3> &directions,
+                                   const VArray<float> &lengths,
+                                   const float radius,
+                                   BVHTree_RayCastCallback callback,
+                                   void *userdata,
+                                   const FunctionRef<void(int64_t i, const BVHTreeRayHit &hit)>
+                                       result_fn)
+{
+  int64_t hit_count = 0;
+  foreach_query_index(tree, mask, origins, [&](const Span<int64_t> indices) {
+    int64_t sub_hit_count = 0;
+    for (const int64_t i : indices) {
+      const float3 origin = origins[i];
+      const float3 direction = math::normalize(directions[i]);
+      BVHTreeRayHit hit;
+      hit.index = -1;
+      hit.dist = lengths[i];
+      if (BLI_bvhtree_ray_cast(tree, origin, direction, radius, &hit, callback, userdata) != -1) {
+        sub_hit_count++;
+      }
+      result_fn(i, hit);
+    }
+    atomic_add_and_fetch_int64(&hit_count, sub_hit_count);
+  });
+  return hit_count;
+}
+
+}  // namespace blender
@@ -11,6 +11,7 @@
  * - Freeing chunks.
  * - Iterating over allocated chunks
  *   (optionally when using the #BLI_MEMPOOL_ALLOW_ITER flag).
+ * - Allocating from multiple threads with a #BLI_mempool_local per thread.
  */
 
 #include <stdlib.h>
@@ -22,6 +23,7 @@
 
 #include "BLI_mempool.h"         /* own include */
 #include "BLI_mempool_private.h" /* own include */
+#include "BLI_threads.h"
 
 #include "MEM_guardedalloc.h"
 
@@ -114,8 +116,10 @@ struct BLI_mempool {
   BLI_freenode *free;
   /** Use to know how many chunks to keep for #BLI_mempool_clear. */
   uint maxchunks;
-  /** Number of elements currently in use. */
+  /** Number of elements currently in use, including elements reserved by #BLI_mempool_local. */
   uint totused;
+  /** Protects the pool when it is used through #BLI_mempool_local. */
+  SpinLock local_lock;
 #ifdef USE_TOTALLOC
   /** Number of elements allocated in total. */
   uint totalloc;
@@ -300,6 +304,7 @@ BLI_mempool *BLI_mempool_create(uint esize, uint totelem, uint pchunk, uint flag
   pool->totalloc = 0;
 #endif
   pool->totused = 0;
+  BLI_spin_init(&pool->local_lock);
 
   if (totelem) {
     /* Allocate the actual chunks. */
@@ -351,6 +356,46 @@ void *BLI_mempool_calloc(BLI_mempool *pool)
   return retval;
 }
 
+/**
+ * Free all chunks except the first, only valid when no element is in use.
+ */
+static void mempool_free_chunks_except_first(BLI_mempool *pool)
+{
+  const uint esize = pool->esize;
+  BLI_freenode *curnode;
+  uint j;
+  BLI_mempool_chunk *first;
+
+  first = pool->chunks;
+  mempool_chunk_free_all(first->next);
+  first->next = NULL;
+  pool->chunk_tail = first;
+
+#ifdef USE_TOTALLOC
+  pool->totalloc = pool->pchunk;
+#endif
+
+  /* Temp alloc so valgrind doesn't complain when setting free'd blocks 'next'. */
+#ifdef WITH_MEM_VALGRIND
+  VALGRIND_MEMPOOL_ALLOC(pool, CHUNK_DATA(first), pool->csize);
+#endif
+
+  curnode = CHUNK_DATA(first);
+  pool->free = curnode;
+
+  j = pool->pchunk;
+  while (j--) {
+    curnode->next = NODE_STEP_NEXT(curnode);
+    curnode = curnode->next;
+  }
+  curnode = NODE_STEP_PREV(curnode);
+  curnode->next = NULL; /* terminate the list */
+
+#ifdef WITH_MEM_VALGRIND
+  VALGRIND_MEMPOOL_FREE(pool, CHUNK_DATA(first));
+#endif
+}
+
 void BLI_mempool_free(BLI_mempool *pool, void *addr)
 {
   BLI_freenode *newhead = addr;
@@ -395,47 +440,164 @@ void BLI_mempool_free(BLI_mempool *pool, void *addr)
 
   /* Nothing is in use; free all the chunks except the first. */
   if (UNLIKELY(pool->totused == 0) && (pool->chunks->next)) {
-    const uint esize = pool->esize;
-    BLI_freenode *curnode;
-    uint j;
-    BLI_mempool_chunk *first;
+    mempool_free_chunks_except_first(pool);
+  }
+}
+
+int BLI_mempool_len(const BLI_mempool *pool)
+{
+  return (int)pool->totused;
+}
 
-    first = pool->chunks;
-    mempool_chunk_free_all(first->next);
-    first->next = NULL;
-    pool->chunk_tail = first;
+/* -------------------------------------------------------------------- */
+/** \name Thread Local Allocation
+ * \{ */
 
-#ifdef USE_TOTALLOC
-    pool->totalloc = pool->pchunk;
-#endif
+struct BLI_mempool_local {
+  BLI_mempool *pool;
+  /** Free elements reserved from the pool, in the same format as #BLI_mempool.free. */
+  BLI_freenode *free;
+  uint free_len;
+};
+
+/**
+ * Move a chunk worth of elements from the pool to the local free list, keeping their order
+ * so that elements allocated after each other are close in memory.
+ */
+static void mempool_local_reserve(BLI_mempool_local *local)
+{
+  BLI_mempool *pool = local->pool;
+  const uint reserve_len = pool->pchunk;
+  BLI_freenode *first = NULL;
+  BLI_freenode *last = NULL;
+
+  BLI_spin_lock(&pool->local_lock);
+  for (uint i = 0; i < reserve_len; i++) {
+    if (UNLIKELY(pool->free == NULL)) {
+      BLI_mempool_chunk *mpchunk = mempool_chunk_alloc(pool);
+      mempool_chunk_add(pool, mpchunk, NULL);
+    }
+    BLI_freenode *node = pool->free;
+    pool->free = node->next;
+    if (last) {
+      last->next = node;
+    }
+    else {
+      first = node;
+    }
+    last = node;
+  }
+  pool->totused += reserve_len;
+  BLI_spin_unlock(&pool->local_lock);
+
+  last->next = local->free;
+  local->free = first;
+  local->free_len += reserve_len;
+}
+
+/** Give the first \a release_len elements of the local free list back to the pool. */
+static void mempool_local_release(BLI_mempool_local *local, const uint release_len)
+{
+  BLI_mempool *pool = local->pool;
+  BLI_freenode *first = local->free;
+  BLI_freenode *last = first;
+  for (uint i = 1; i < release_len; i++) {
+    last = last->next;
+  }
+  local->free = last->next;
+  local->free_len -= release_len;
+
+  BLI_spin_lock(&pool->local_lock);
+  last->next = pool->free;
+  pool->free = first;
+  pool->totused -= release_len;
+  if (UNLIKELY(pool->totused == 0) && (pool->chunks->next)) {
+    mempool_free_chunks_except_first(pool);
+  }
+  BLI_spin_unlock(&pool->local_lock);
+}
+
+BLI_mempool_local *BLI_mempool_local_create(BLI_mempool *pool)
+{
+  BLI_mempool_local *local = MEM_mallocN(sizeof(BLI_mempool_local), __func__);
+  local->pool = pool;
+  local->free = NULL;
+  local->free_len = 0;
+  return local;
+}
+
+void *BLI_mempool_local_alloc(BLI_mempool_local *local)
+{
+  BLI_mempool *pool = local->pool;
+
+  if (UNLIKELY(local->free == NULL)) {
+    mempool_local_reserve(local);
+  }
+
+  BLI_freenode *free_pop = local->free;
+  if (pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
+    free_pop->freeword = USEDWORD;
+  }
+  local->free = free_pop->next;
+  local->free_len--;
 
-    /* Temp alloc so valgrind doesn't complain when setting free'd blocks 'next'. */
 #ifdef WITH_MEM_VALGRIND
-    VALGRIND_MEMPOOL_ALLOC(pool, CHUNK_DATA(first), pool->csize);
+  VALGRIND_MEMPOOL_ALLOC(pool, free_pop, pool->esize);
 #endif
 
-    curnode = CHUNK_DATA(first);
-    pool->free = curnode;
+  return (void *)free_pop;
+}
 
-    j = pool->pchunk;
-    while (j--) {
-      curnode->next = NODE_STEP_NEXT(curnode);
-      curnode = curnode->next;
-    }
-    curnode = NODE_STEP_PREV(curnode);
-    curnode->next = NULL; /* terminate the list */
+void *BLI_mempool_local_calloc(BLI_mempool_local *local)
+{
+  void *retval = BLI_mempool_local_alloc(local);
+  memset(retval, 0, (size_t)local->pool->esize);
+  return retval;
+}
+
+void BLI_mempool_local_free(BLI_mempool_local *local, void *addr)
+{
+  BLI_mempool *pool = local->pool;
+  BLI_freenode *newhead = addr;
+
+#ifndef NDEBUG
+  if (UNLIKELY(mempool_debug_memset)) {
+    memset(addr, 255, pool->esize);
+  }
+#endif
+
+  if (pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
+#ifndef NDEBUG
+    /* This will detect double free's. */
+    BLI_assert(newhead->freeword != FREEWORD);
+#endif
+    newhead->freeword = FREEWORD;
+  }
+
+  newhead->next = local->free;
+  local->free = newhead;
+  local->free_len++;
 
 #ifdef WITH_MEM_VALGRIND
-    VALGRIND_MEMPOOL_FREE(pool, CHUNK_DATA(first));
+  VALGRIND_MEMPOOL_FREE(pool, addr);
 #endif
+
+  /* Don't let a thread that mostly frees hold on to a lot of memory. */
+  if (UNLIKELY(local->free_len > pool->pchunk * 2)) {
+    mempool_local_release(local, pool->pchunk);
   }
 }
 
-int BLI_mempool_len(const BLI_mempool *pool)
+void BLI_mempool_local_destroy(BLI_mempool_local *local)
 {
-  return (int)pool->totused;
+  if (local->free_len) {
+    mempool_local_release(local, local->free_len);
+  }
+  MEM_freeN(local);
 }
 
+/** \} */
+
 void *BLI_mempool_findelem(BLI_mempool *pool, uint index)
 {
   BLI_assert(pool->flag & BLI_MEMPOOL_ALLOW_ITER);
@@ -707,6 +869,7 @@ void BLI_mempool_clear(BLI_mempool *pool)
 void BLI_mempool_destroy(BLI_mempool *pool)
 {
   mempool_chunk_free_all(pool->chunks);
+  BLI_spin_end(&pool->local_lock);
 
 #ifdef WITH_MEM_VALGRIND
   VALGRIND_DESTROY_MEMPOOL(pool);
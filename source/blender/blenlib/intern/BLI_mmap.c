@@ -175,6 +175,22 @@ BLI_mmap_file *BLI_mmap_open(int fd)
   return file;
 }
 
+#ifndef WIN32
+/* Reads that are at least this large are treated specially, see #BLI_mmap_read. */
+#  define MMAP_LARGE_READ_SIZE (1 << 20)
+
+/* Apply `madvise` to all whole pages within the given region of the mapped file. */
+static void mmap_advise_pages(BLI_mmap_file *file, size_t offset, size_t length, int advice)
+{
+  const size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+  const size_t begin = (offset + page_size - 1) / page_size * page_size;
+  const size_t end = (offset + length) / page_size * page_size;
+  if (begin < end) {
+    madvise(file->memory + begin, end - begin, advice);
+  }
+}
+#endif
+
 bool BLI_mmap_read(BLI_mmap_file *file, void *dest, size_t offset, size_t length)
 {
   /* If a previous read has already failed or we try to read past the end,
@@ -184,9 +200,23 @@ bool BLI_mmap_read(BLI_mmap_file *file, void *dest, size_t offset, size_t length
   }
 
 #ifndef WIN32
+  const bool is_large_read = length >= MMAP_LARGE_READ_SIZE;
+  if (is_large_read) {
+    /* Let the kernel read the whole range at once instead of faulting in page by page. */
+    mmap_advise_pages(file, offset, length, MADV_WILLNEED);
+  }
+
   /* If an error occurs in this call, sigbus_handler will be called and will set
    * file->io_error to true. */
   memcpy(dest, file->memory + offset, length);
+
+  if (is_large_read && !file->io_error) {
+    /* Large arrays are rarely read twice. Release the mapped pages now that the data has been
+     * copied, so that they don't count towards the resident memory of the process for as long
+     * as the file is open. The mapping is read-only, so accessing the pages again later just
+     * reads them from the page cache again. */
+    mmap_advise_pages(file, offset, length, MADV_DONTNEED);
+  }
 #else
   /* On Windows, we use exception handling to be notified of errors. */
   __try {
@@ -8,6 +8,7 @@
 
 #include "BLI_kdtree_impl.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_strict_flags.h"
 #include "BLI_utildefines.h"
 
@@ -852,6 +853,193 @@ static void deduplicate_recursive(const struct DeDuplicateParams *p, uint i)
   }
 }
 
+/**
+ * Number of points whose neighbors are searched in parallel at once,
+ * before they are merged in order.
+ */
+#define KD_DEDUPLICATE_BATCH_SIZE 65536u
+/** When a batch has more neighbors than this, it is searched serially to bound memory usage. */
+#define KD_DEDUPLICATE_BATCH_NEIGHBORS_MAX ((size_t)1 << 24)
+
+/**
+ * Like #deduplicate_recursive, but collects all points in range regardless of whether they are
+ * already merged. When \a r_neighbors is null, the points are only counted.
+ */
+static void deduplicate_neighbors_recursive(const struct DeDuplicateParams *p,
+                                            const float search_co[KD_DIMS],
+                                            const int search,
+                                            uint i,
+                                            int *r_neighbors,
+                                            int *r_neighbors_len)
+{
+  const KDTreeNode *node = &p->nodes[i];
+  if (search_co[node->d] + p->range <= node->co[node->d]) {
+    if (node->left != KD_NODE_UNSET) {
+      deduplicate_neighbors_recursive(
+          p, search_co, search, node->left, r_neighbors, r_neighbors_len);
+    }
+  }
+  else if (search_co[node->d] - p->range >= node->co[node->d]) {
+    if (node->right != KD_NODE_UNSET) {
+      deduplicate_neighbors_recursive(
+          p, search_co, search, node->right, r_neighbors, r_neighbors_len);
+    }
+  }
+  else {
+    if ((search != node->index) && (len_squared_vnvn(node->co, search_co) <= p->range_sq)) {
+      if (r_neighbors) {
+        r_neighbors[*r_neighbors_len] = node->index;
+      }
+      *r_neighbors_len += 1;
+    }
+    if (node->left != KD_NODE_UNSET) {
+      deduplicate_neighbors_recursive(
+          p, search_co, search, node->left, r_neighbors, r_neighbors_len);
+    }
+    if (node->right != KD_NODE_UNSET) {
+      deduplicate_neighbors_recursive(
+          p, search_co, search, node->right, r_neighbors, r_neighbors_len);
+    }
+  }
+}
+
+struct DeDuplicateBatchData {
+  const struct DeDuplicateParams *params;
+  const KDTree *tree;
+  /** Optional, see #kdtree_order. */
+  const uint *order;
+  uint batch_start;
+  /** Number of neighbors, then their offsets in #neighbors for every point of the batch. */
+  int *neighbors_offset;
+  int *neighbors;
+};
+
+/** Get the node and the index of the point at the given position of the iteration order. */
+static void deduplicate_iter_point(const KDTree *tree,
+                                   const uint *order,
+                                   const uint i,
+                                   uint *r_node_index,
+                                   int *r_index)
+{
+  if (order) {
+    *r_node_index = order[i];
+    *r_index = (int)i;
+  }
+  else {
+    *r_node_index = i;
+    *r_index = tree->nodes[i].index;
+  }
+}
+
+static void deduplicate_batch_count_cb(void *__restrict userdata,
+                                       const int j,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  struct DeDuplicateBatchData *data = userdata;
+  const struct DeDuplicateParams *p = data->params;
+  uint node_index;
+  int index;
+  deduplicate_iter_point(data->tree, data->order, data->batch_start + (uint)j, &node_index, &index);
+
+  int neighbors_len = 0;
+  /* Points that are already merged are skipped, this can only change from -1 to merged later. */
+  if (ELEM(p->duplicates[index], -1, index)) {
+    deduplicate_neighbors_recursive(
+        p, p->nodes[node_index].co, index, data->tree->root, NULL, &neighbors_len);
+  }
+  data->neighbors_offset[j] = neighbors_len;
+}
+
+static void deduplicate_batch_fill_cb(void *__restrict userdata,
+                                      const int j,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  struct DeDuplicateBatchData *data = userdata;
+  const struct DeDuplicateParams *p = data->params;
+  if (data->neighbors_offset[j] == data->neighbors_offset[j + 1]) {
+    return;
+  }
+  uint node_index;
+  int index;
+  deduplicate_iter_point(data->tree, data->order, data->batch_start + (uint)j, &node_index, &index);
+
+  int neighbors_len = 0;
+  deduplicate_neighbors_recursive(p,
+                                  p->nodes[node_index].co,
+                                  index,
+                                  data->tree->root,
+                                  &data->neighbors[data->neighbors_offset[j]],
+                                  &neighbors_len);
+  BLI_assert(neighbors_len == data->neighbors_offset[j + 1] - data->neighbors_offset[j]);
+}
+
+/**
+ * Find the duplicates of the points in the given range of the iteration order.
+ * The neighbors of all points are searched in parallel, then merged in order,
+ * so the result is the same as the serial search of #deduplicate_recursive.
+ *
+ * \return False when the batch has too many neighbors, nothing is changed then.
+ */
+static bool deduplicate_batch(struct DeDuplicateParams *p,
+                              const KDTree *tree,
+                              const uint *order,
+                              const uint batch_start,
+                              const uint batch_len,
+                              int *neighbors_offset)
+{
+  struct DeDuplicateBatchData data = {
+      .params = p,
+      .tree = tree,
+      .order = order,
+      .batch_start = batch_start,
+      .neighbors_offset = neighbors_offset,
+      .neighbors = NULL,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+
+  BLI_task_parallel_range(0, (int)batch_len, &data, deduplicate_batch_count_cb, &settings);
+
+  size_t neighbors_len = 0;
+  for (uint j = 0; j < batch_len; j++) {
+    const int len = neighbors_offset[j];
+    neighbors_offset[j] = (int)neighbors_len;
+    neighbors_len += (size_t)len;
+  }
+  if (neighbors_len > KD_DEDUPLICATE_BATCH_NEIGHBORS_MAX) {
+    return false;
+  }
+  neighbors_offset[batch_len] = (int)neighbors_len;
+
+  data.neighbors = MEM_mallocN(sizeof(int) * MAX2(neighbors_len, (size_t)1), __func__);
+  BLI_task_parallel_range(0, (int)batch_len, &data, deduplicate_batch_fill_cb, &settings);
+
+  for (uint j = 0; j < batch_len; j++) {
+    uint node_index;
+    int index;
+    deduplicate_iter_point(tree, order, batch_start + j, &node_index, &index);
+    if (ELEM(p->duplicates[index], -1, index)) {
+      const int found_prev = *p->duplicates_found;
+      for (int k = neighbors_offset[j]; k < neighbors_offset[j + 1]; k++) {
+        const int neighbor = data.neighbors[k];
+        if (p->duplicates[neighbor] == -1) {
+          p->duplicates[neighbor] = index;
+          *p->duplicates_found += 1;
+        }
+      }
+      if (*p->duplicates_found != found_prev) {
+        /* Prevent chains of doubles. */
+        p->duplicates[index] = index;
+      }
+    }
+  }
+
+  MEM_freeN(data.neighbors);
+  return true;
+}
+
 /**
  * Find duplicate points in \a range.
  * Favors speed over quality since it doesn't find the best target vertex for merging.
@@ -869,6 +1057,7 @@ static void deduplicate_recursive(const struct DeDuplicateParams *p, uint i)
  * \returns The number of merges found (includes any merges already in the \a duplicates array).
  *
  * \note Merging is always a single step (target indices won't be marked for merging).
+ * \note The neighbors of large trees are searched in parallel, the result doesn't depend on it.
  */
 int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
                                          const float range,
@@ -884,28 +1073,24 @@ int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
       .duplicates_found = &found,
   };
 
-  if (use_index_order) {
-    uint *order = kdtree_order(tree);
-    for (uint i = 0; i < tree->nodes_len; i++) {
-      const uint node_index = order[i];
-      const int index = (int)i;
-      if (ELEM(duplicates[index], -1, index)) {
-        p.search = index;
-        copy_vn_vn(p.search_co, tree->nodes[node_index].co);
-        int found_prev = found;
-        deduplicate_recursive(&p, tree->root);
-        if (found != found_prev) {
-          /* Prevent chains of doubles. */
-          duplicates[index] = index;
-        }
-      }
-    }
-    MEM_freeN(order);
+  uint *order = use_index_order ? kdtree_order(tree) : NULL;
+  int *neighbors_offset = NULL;
+  if (tree->nodes_len > 1024) {
+    neighbors_offset = MEM_mallocN(
+        sizeof(int) * (MIN2(tree->nodes_len, KD_DEDUPLICATE_BATCH_SIZE) + 1), __func__);
   }
-  else {
-    for (uint i = 0; i < tree->nodes_len; i++) {
-      const uint node_index = i;
-      const int index = p.nodes[node_index].index;
+
+  for (uint batch_start = 0; batch_start < tree->nodes_len;
+       batch_start += KD_DEDUPLICATE_BATCH_SIZE) {
+    const uint batch_len = MIN2(tree->nodes_len - batch_start, KD_DEDUPLICATE_BATCH_SIZE);
+    if (neighbors_offset &&
+        deduplicate_batch(&p, tree, order, batch_start, batch_len, neighbors_offset)) {
+      continue;
+    }
+    for (uint i = batch_start; i < batch_start + batch_len; i++) {
+      uint node_index;
+      int index;
+      deduplicate_iter_point(tree, order, i, &node_index, &index);
       if (ELEM(duplicates[index], -1, index)) {
         p.search = index;
         copy_vn_vn(p.search_co, tree->nodes[node_index].co);
@@ -918,6 +1103,9 @@ int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
       }
     }
   }
+
+  MEM_SAFE_FREE(neighbors_offset);
+  MEM_SAFE_FREE(order);
   return found;
 }
 
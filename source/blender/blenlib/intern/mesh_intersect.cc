@@ -2738,17 +2738,24 @@ static CDT_data calc_cluster_subdivided(const CoplanarClusterInfo &clinfo,
 
 static IMesh union_tri_subdivides(const blender::Array<IMesh> &tri_subdivided)
 {
+  /* Offsets of each subdivided triangle's faces in the result, so they can be copied in
+   * parallel while keeping the serial order. */
+  Array<int> face_offsets(tri_subdivided.size() + 1);
   int tot_tri = 0;
-  for (const IMesh &m : tri_subdivided) {
-    tot_tri += m.face_size();
+  for (int t : tri_subdivided.index_range()) {
+    face_offsets[t] = tot_tri;
+    tot_tri += tri_subdivided[t].face_size();
   }
+  face_offsets.last() = tot_tri;
   Array<Face *> faces(tot_tri);
-  int face_index = 0;
-  for (const IMesh &m : tri_subdivided) {
-    for (Face *f : m.faces()) {
-      faces[face_index++] = f;
+  threading::parallel_for(tri_subdivided.index_range(), 2048, [&](IndexRange range) {
+    for (int t : range) {
+      int face_index = face_offsets[t];
+      for (Face *f : tri_subdivided[t].faces()) {
+        faces[face_index++] = f;
+      }
     }
-  }
+  });
   return IMesh(faces);
 }
 
@@ -3035,10 +3042,15 @@ IMesh trimesh_nary_intersect(const IMesh &tm_in,
   std::cout << "subdivided non-cluster tris found, time = " << subdivided_tris_time - itt_time
             << "\n";
 #  endif
+  /* The clusters are independent, so their CDTs can be computed in parallel. Their faces are
+   * still added to the arena serially by #calc_cluster_tris, to keep the result repeatable. */
   Array<CDT_data> cluster_subdivided(clinfo.tot_cluster());
-  for (int c : clinfo.index_range()) {
-    cluster_subdivided[c] = calc_cluster_subdivided(clinfo, c, *tm_clean, tri_ov, itt_map, arena);
-  }
+  threading::parallel_for(clinfo.index_range(), 1, [&](IndexRange range) {
+    for (int c : range) {
+      cluster_subdivided[c] = calc_cluster_subdivided(
+          clinfo, c, *tm_clean, tri_ov, itt_map, arena);
+    }
+  });
 #  ifdef PERFDEBUG
   double cluster_subdivide_time = PIL_check_seconds_timer();
   std::cout << "subdivided clusters found, time = "
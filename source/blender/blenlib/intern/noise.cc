@@ -9,6 +9,7 @@
 #include "BLI_math_base_safe.h"
 #include "BLI_math_vector.hh"
 #include "BLI_noise.hh"
+#include "BLI_simd.h"
 #include "BLI_utildefines.h"
 
 namespace blender::noise {
@@ -384,6 +385,146 @@ BLI_INLINE float floor_fraction(float x, int &i)
   return x - i;
 }
 
+#ifdef BLI_HAVE_SSE2
+
+/* The gradients of the corners of a cell are computed four at a time. The hash functions and
+ * gradients below do the same operations as their scalar versions on every lane, so the results
+ * are identical. */
+
+template<int k> BLI_INLINE __m128i hash_bit_rotate_x4(__m128i x)
+{
+  return _mm_or_si128(_mm_slli_epi32(x, k), _mm_srli_epi32(x, 32 - k));
+}
+
+BLI_INLINE void hash_bit_mix_x4(__m128i &a, __m128i &b, __m128i &c)
+{
+  a = _mm_sub_epi32(a, c);
+  a = _mm_xor_si128(a, hash_bit_rotate_x4<4>(c));
+  c = _mm_add_epi32(c, b);
+  b = _mm_sub_epi32(b, a);
+  b = _mm_xor_si128(b, hash_bit_rotate_x4<6>(a));
+  a = _mm_add_epi32(a, c);
+  c = _mm_sub_epi32(c, b);
+  c = _mm_xor_si128(c, hash_bit_rotate_x4<8>(b));
+  b = _mm_add_epi32(b, a);
+  a = _mm_sub_epi32(a, c);
+  a = _mm_xor_si128(a, hash_bit_rotate_x4<16>(c));
+  c = _mm_add_epi32(c, b);
+  b = _mm_sub_epi32(b, a);
+  b = _mm_xor_si128(b, hash_bit_rotate_x4<19>(a));
+  a = _mm_add_epi32(a, c);
+  c = _mm_sub_epi32(c, b);
+  c = _mm_xor_si128(c, hash_bit_rotate_x4<4>(b));
+  b = _mm_add_epi32(b, a);
+}
+
+BLI_INLINE void hash_bit_final_x4(__m128i &a, __m128i &b, __m128i &c)
+{
+  c = _mm_xor_si128(c, b);
+  c = _mm_sub_epi32(c, hash_bit_rotate_x4<14>(b));
+  a = _mm_xor_si128(a, c);
+  a = _mm_sub_epi32(a, hash_bit_rotate_x4<11>(c));
+  b = _mm_xor_si128(b, a);
+  b = _mm_sub_epi32(b, hash_bit_rotate_x4<25>(a));
+  c = _mm_xor_si128(c, b);
+  c = _mm_sub_epi32(c, hash_bit_rotate_x4<16>(b));
+  a = _mm_xor_si128(a, c);
+  a = _mm_sub_epi32(a, hash_bit_rotate_x4<4>(c));
+  b = _mm_xor_si128(b, a);
+  b = _mm_sub_epi32(b, hash_bit_rotate_x4<14>(a));
+  c = _mm_xor_si128(c, b);
+  c = _mm_sub_epi32(c, hash_bit_rotate_x4<24>(b));
+}
+
+BLI_INLINE __m128i hash_x4(__m128i kx, __m128i ky)
+{
+  __m128i a, b, c;
+  a = b = c = _mm_set1_epi32(int(0xdeadbeef + (2 << 2) + 13));
+
+  b = _mm_add_epi32(b, ky);
+  a = _mm_add_epi32(a, kx);
+  hash_bit_final_x4(a, b, c);
+
+  return c;
+}
+
+BLI_INLINE __m128i hash_x4(__m128i kx, __m128i ky, __m128i kz)
+{
+  __m128i a, b, c;
+  a = b = c = _mm_set1_epi32(int(0xdeadbeef + (3 << 2) + 13));
+
+  c = _mm_add_epi32(c, kz);
+  b = _mm_add_epi32(b, ky);
+  a = _mm_add_epi32(a, kx);
+  hash_bit_final_x4(a, b, c);
+
+  return c;
+}
+
+BLI_INLINE __m128i hash_x4(__m128i kx, __m128i ky, __m128i kz, __m128i kw)
+{
+  __m128i a, b, c;
+  a = b = c = _mm_set1_epi32(int(0xdeadbeef + (4 << 2) + 13));
+
+  a = _mm_add_epi32(a, kx);
+  b = _mm_add_epi32(b, ky);
+  c = _mm_add_epi32(c, kz);
+  hash_bit_mix_x4(a, b, c);
+
+  a = _mm_add_epi32(a, kw);
+  hash_bit_final_x4(a, b, c);
+
+  return c;
+}
+
+/* Select a where the mask is set, b otherwise. */
+BLI_INLINE __m128 select_x4(__m128i mask, __m128 a, __m128 b)
+{
+  const __m128 mask_ps = _mm_castsi128_ps(mask);
+  return _mm_or_ps(_mm_and_ps(mask_ps, a), _mm_andnot_ps(mask_ps, b));
+}
+
+/* Flip the sign of the value where the bit is set in the hash. */
+BLI_INLINE __m128 negate_if_x4(__m128 value, __m128i hash, int bit)
+{
+  const __m128i bit_v = _mm_set1_epi32(bit);
+  const __m128i is_set = _mm_cmpeq_epi32(_mm_and_si128(hash, bit_v), bit_v);
+  const __m128i sign = _mm_and_si128(is_set, _mm_set1_epi32(int(0x80000000)));
+  return _mm_xor_ps(value, _mm_castsi128_ps(sign));
+}
+
+BLI_INLINE __m128 noise_grad_x4(__m128i hash, __m128 x, __m128 y)
+{
+  const __m128i h = _mm_and_si128(hash, _mm_set1_epi32(7));
+  const __m128i h_lt_4 = _mm_cmplt_epi32(h, _mm_set1_epi32(4));
+  const __m128 u = select_x4(h_lt_4, x, y);
+  const __m128 v = _mm_mul_ps(_mm_set1_ps(2.0f), select_x4(h_lt_4, y, x));
+  return _mm_add_ps(negate_if_x4(u, h, 1), negate_if_x4(v, h, 2));
+}
+
+BLI_INLINE __m128 noise_grad_x4(__m128i hash, __m128 x, __m128 y, __m128 z)
+{
+  const __m128i h = _mm_and_si128(hash, _mm_set1_epi32(15));
+  const __m128 u = select_x4(_mm_cmplt_epi32(h, _mm_set1_epi32(8)), x, y);
+  const __m128i h_12_or_14 = _mm_or_si128(_mm_cmpeq_epi32(h, _mm_set1_epi32(12)),
+                                          _mm_cmpeq_epi32(h, _mm_set1_epi32(14)));
+  const __m128 vt = select_x4(h_12_or_14, x, z);
+  const __m128 v = select_x4(_mm_cmplt_epi32(h, _mm_set1_epi32(4)), y, vt);
+  return _mm_add_ps(negate_if_x4(u, h, 1), negate_if_x4(v, h, 2));
+}
+
+BLI_INLINE __m128 noise_grad_x4(__m128i hash, __m128 x, __m128 y, __m128 z, __m128 w)
+{
+  const __m128i h = _mm_and_si128(hash, _mm_set1_epi32(31));
+  const __m128 u = select_x4(_mm_cmplt_epi32(h, _mm_set1_epi32(24)), x, y);
+  const __m128 v = select_x4(_mm_cmplt_epi32(h, _mm_set1_epi32(16)), y, z);
+  const __m128 s = select_x4(_mm_cmplt_epi32(h, _mm_set1_epi32(8)), z, w);
+  return _mm_add_ps(_mm_add_ps(negate_if_x4(u, h, 1), negate_if_x4(v, h, 2)),
+                    negate_if_x4(s, h, 4));
+}
+
+#endif /* BLI_HAVE_SSE2 */
+
 BLI_INLINE float perlin_noise(float position)
 {
   int X;
@@ -407,12 +548,23 @@ BLI_INLINE float perlin_noise(float2 position)
   float u = fade(fx);
   float v = fade(fy);
 
+#ifdef BLI_HAVE_SSE2
+  const __m128i corner_x = _mm_setr_epi32(X, X + 1, X, X + 1);
+  const __m128i corner_y = _mm_setr_epi32(Y, Y, Y + 1, Y + 1);
+  const __m128 offset_x = _mm_setr_ps(fx, fx - 1.0f, fx, fx - 1.0f);
+  const __m128 offset_y = _mm_setr_ps(fy, fy, fy - 1.0f, fy - 1.0f);
+  float g[4];
+  _mm_storeu_ps(g, noise_grad_x4(hash_x4(corner_x, corner_y), offset_x, offset_y));
+
+  float r = mix(g[0], g[1], g[2], g[3], u, v);
+#else
   float r = mix(noise_grad(hash(X, Y), fx, fy),
                 noise_grad(hash(X + 1, Y), fx - 1.0, fy),
                 noise_grad(hash(X, Y + 1), fx, fy - 1.0),
                 noise_grad(hash(X + 1, Y + 1), fx - 1.0, fy - 1.0),
                 u,
                 v);
+#endif
 
   return r;
 }
@@ -429,6 +581,25 @@ BLI_INLINE float perlin_noise(float3 position)
   float v = fade(fy);
   float w = fade(fz);
 
+#ifdef BLI_HAVE_SSE2
+  const __m128i corner_x = _mm_setr_epi32(X, X + 1, X, X + 1);
+  const __m128i corner_y = _mm_setr_epi32(Y, Y, Y + 1, Y + 1);
+  const __m128 offset_x = _mm_setr_ps(fx, fx - 1.0f, fx, fx - 1.0f);
+  const __m128 offset_y = _mm_setr_ps(fy, fy, fy - 1.0f, fy - 1.0f);
+  float g[8];
+  _mm_storeu_ps(g,
+                noise_grad_x4(hash_x4(corner_x, corner_y, _mm_set1_epi32(Z)),
+                              offset_x,
+                              offset_y,
+                              _mm_set1_ps(fz)));
+  _mm_storeu_ps(g + 4,
+                noise_grad_x4(hash_x4(corner_x, corner_y, _mm_set1_epi32(Z + 1)),
+                              offset_x,
+                              offset_y,
+                              _mm_set1_ps(fz - 1.0f)));
+
+  float r = mix(g[0], g[1], g[2], g[3], g[4], g[5], g[6], g[7], u, v, w);
+#else
   float r = mix(noise_grad(hash(X, Y, Z), fx, fy, fz),
                 noise_grad(hash(X + 1, Y, Z), fx - 1, fy, fz),
                 noise_grad(hash(X, Y + 1, Z), fx, fy - 1, fz),
@@ -440,6 +611,7 @@ BLI_INLINE float perlin_noise(float3 position)
                 u,
                 v,
                 w);
+#endif
 
   return r;
 }
@@ -458,6 +630,48 @@ BLI_INLINE float perlin_noise(float4 position)
   float t = fade(fz);
   float s = fade(fw);
 
+#ifdef BLI_HAVE_SSE2
+  const __m128i corner_x = _mm_setr_epi32(X, X + 1, X, X + 1);
+  const __m128i corner_y = _mm_setr_epi32(Y, Y, Y + 1, Y + 1);
+  const __m128 offset_x = _mm_setr_ps(fx, fx - 1.0f, fx, fx - 1.0f);
+  const __m128 offset_y = _mm_setr_ps(fy, fy, fy - 1.0f, fy - 1.0f);
+  float g[16];
+  for (int i = 0; i < 4; i++) {
+    /* Corners are ordered by z first, then by w. */
+    const int dz = i & 1;
+    const int dw = i >> 1;
+    _mm_storeu_ps(g + i * 4,
+                  noise_grad_x4(hash_x4(corner_x,
+                                        corner_y,
+                                        _mm_set1_epi32(Z + dz),
+                                        _mm_set1_epi32(W + dw)),
+                                offset_x,
+                                offset_y,
+                                _mm_set1_ps(dz ? fz - 1.0f : fz),
+                                _mm_set1_ps(dw ? fw - 1.0f : fw)));
+  }
+
+  float r = mix(g[0],
+                g[1],
+                g[2],
+                g[3],
+                g[4],
+                g[5],
+                g[6],
+                g[7],
+                g[8],
+                g[9],
+                g[10],
+                g[11],
+                g[12],
+                g[13],
+                g[14],
+                g[15],
+                u,
+                v,
+                t,
+                s);
+#else
   float r = mix(
       noise_grad(hash(X, Y, Z, W), fx, fy, fz, fw),
       noise_grad(hash(X + 1, Y, Z, W), fx - 1.0, fy, fz, fw),
@@ -479,6 +693,7 @@ BLI_INLINE float perlin_noise(float4 position)
       v,
       t,
       s);
+#endif
 
   return r;
 }
@@ -105,15 +105,30 @@ class Task {
  * Subclass since there seems to be no other way to set priority. */
 
 #ifdef WITH_TBB
+#  if TBB_INTERFACE_VERSION_MAJOR >= 12
+/* Arena for the tasks of low priority pools. Worker threads only join it when the arenas with
+ * normal priority have no work, so interactive work is not slowed down by background work. */
+static tbb::task_arena &low_priority_arena()
+{
+  static tbb::task_arena arena(tbb::task_arena::automatic, 1, tbb::task_arena::priority::low);
+  return arena;
+}
+#  endif
+
 class TBBTaskGroup : public tbb::task_group {
+#  if TBB_INTERFACE_VERSION_MAJOR >= 12
+  /* Priorities are only available as part of task arenas in TBB 2021, no longer for task
+   * groups. Tasks of low priority pools are spawned in and waited for from a separate arena. */
+  tbb::task_arena *arena_ = nullptr;
+#  endif
+
  public:
   TBBTaskGroup(eTaskPriority priority)
   {
 #  if TBB_INTERFACE_VERSION_MAJOR >= 12
-    /* TODO: support priorities in TBB 2021, where they are only available as
-     * part of task arenas, no longer for task groups. Or remove support for
-     * task priorities if they are no longer useful. */
-    UNUSED_VARS(priority);
+    if (priority == TASK_PRIORITY_LOW) {
+      arena_ = &low_priority_arena();
+    }
 #  else
     switch (priority) {
       case TASK_PRIORITY_LOW:
@@ -125,6 +140,28 @@ class TBBTaskGroup : public tbb::task_group {
     }
 #  endif
   }
+
+  void run_task(Task &&task)
+  {
+#  if TBB_INTERFACE_VERSION_MAJOR >= 12
+    if (arena_) {
+      arena_->execute([&]() { this->run(std::move(task)); });
+      return;
+    }
+#  endif
+    this->run(std::move(task));
+  }
+
+  void wait_tasks()
+  {
+#  if TBB_INTERFACE_VERSION_MAJOR >= 12
+    if (arena_) {
+      arena_->execute([&]() { this->wait(); });
+      return;
+    }
+#  endif
+    this->wait();
+  }
 };
 #endif
 
@@ -205,7 +242,7 @@ static void tbb_task_pool_run(TaskPool *pool, Task &&task)
 #ifdef WITH_TBB
   else if (pool->use_threads) {
     /* Execute in TBB task group. */
-    pool->tbb_group.run(std::move(task));
+    pool->tbb_group.run_task(std::move(task));
   }
 #endif
   else {
@@ -234,7 +271,7 @@ static void tbb_task_pool_work_and_wait(TaskPool *pool)
     /* This is called wait(), but internally it can actually do work. This
      * matters because we don't want recursive usage of task pools to run
      * out of threads and get stuck. */
-    pool->tbb_group.wait();
+    pool->tbb_group.wait_tasks();
   }
 #endif
 }
@@ -244,7 +281,7 @@ static void tbb_task_pool_cancel(TaskPool *pool)
 #ifdef WITH_TBB
   if (pool->use_threads) {
     pool->tbb_group.cancel();
-    pool->tbb_group.wait();
+    pool->tbb_group.wait_tasks();
   }
 #else
   UNUSED_VARS(pool);
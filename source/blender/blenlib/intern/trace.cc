@@ -0,0 +1,201 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "BLI_fileops.h"
+#include "BLI_threads.h"
+#include "BLI_trace.h"
+
+#include "PIL_time.h"
+
+namespace blender::trace {
+
+struct TraceEvent {
+  std::string category;
+  std::string name;
+  /* In seconds of #PIL_check_seconds_timer. */
+  double start_time;
+  double duration;
+  /* Counters have a value instead of a duration. */
+  bool is_counter;
+  double value;
+};
+
+/**
+ * Events are stored per thread, so that recording them does not need any locking. Only the
+ * creation of the storage for a new thread is locked.
+ */
+struct ThreadTrace {
+  int thread_index;
+  bool is_main_thread;
+  std::vector<TraceEvent> events;
+  /* Indices of the events that have begun but not ended yet. */
+  std::vector<int64_t> open_events;
+};
+
+static std::atomic<bool> trace_enabled = false;
+static std::string trace_filepath;
+static std::mutex trace_mutex;
+static std::vector<std::unique_ptr<ThreadTrace>> trace_threads;
+static thread_local ThreadTrace *thread_trace = nullptr;
+
+static ThreadTrace &thread_trace_ensure()
+{
+  if (thread_trace == nullptr) {
+    std::lock_guard lock{trace_mutex};
+    std::unique_ptr<ThreadTrace> new_trace = std::make_unique<ThreadTrace>();
+    new_trace->thread_index = int(trace_threads.size());
+    new_trace->is_main_thread = BLI_thread_is_main();
+    thread_trace = new_trace.get();
+    trace_threads.push_back(std::move(new_trace));
+  }
+  return *thread_trace;
+}
+
+static void write_json_string(FILE *file, const std::string &str)
+{
+  fputc('"', file);
+  for (const char c : str) {
+    if (c == '"' || c == '\\') {
+      fputc('\\', file);
+      fputc(c, file);
+    }
+    else if (uchar(c) < 0x20) {
+      fprintf(file, "\\u%04x", c);
+    }
+    else {
+      fputc(c, file);
+    }
+  }
+  fputc('"', file);
+}
+
+static void write_chrome_trace(FILE *file, const double trace_start_time)
+{
+  fprintf(file, "{\"traceEvents\":[\n");
+  bool first = true;
+  for (const std::unique_ptr<ThreadTrace> &thread : trace_threads) {
+    /* Meta-data event that names the thread in the timeline. */
+    fprintf(file,
+            "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+            "\"args\":{\"name\":\"%s %d\"}}",
+            first ? "" : ",\n",
+            thread->thread_index,
+            thread->is_main_thread ? "Main" : "Thread",
+            thread->thread_index);
+    first = false;
+
+    for (const TraceEvent &event : thread->events) {
+      /* Time stamps are in microseconds. */
+      const double ts = (event.start_time - trace_start_time) * 1e6;
+      fprintf(file, ",\n{\"name\":");
+      write_json_string(file, event.name);
+      if (event.is_counter) {
+        fprintf(file,
+                ",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"tid\":%d,\"args\":{\"value\":%g}}",
+                ts,
+                thread->thread_index,
+                event.value);
+      }
+      else {
+        fprintf(file, ",\"cat\":");
+        write_json_string(file, event.category);
+        fprintf(file,
+                ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+                ts,
+                event.duration * 1e6,
+                thread->thread_index);
+      }
+    }
+  }
+  fprintf(file, "\n]}\n");
+}
+
+}  // namespace blender::trace
+
+using namespace blender::trace;
+
+void BLI_trace_enable(const char *filepath)
+{
+  trace_filepath = filepath;
+  trace_enabled = true;
+}
+
+bool BLI_trace_is_enabled(void)
+{
+  return trace_enabled.load(std::memory_order_relaxed);
+}
+
+void BLI_trace_begin(const char *category, const char *name)
+{
+  ThreadTrace &thread = thread_trace_ensure();
+  thread.open_events.push_back(int64_t(thread.events.size()));
+  thread.events.push_back({category, name, PIL_check_seconds_timer(), 0.0, false, 0.0});
+}
+
+void BLI_trace_end(void)
+{
+  ThreadTrace &thread = thread_trace_ensure();
+  if (thread.open_events.empty()) {
+    return;
+  }
+  TraceEvent &event = thread.events[thread.open_events.back()];
+  thread.open_events.pop_back();
+  event.duration = PIL_check_seconds_timer() - event.start_time;
+}
+
+void BLI_trace_complete(const char *category,
+                        const char *name,
+                        const double start_time,
+                        const double duration)
+{
+  ThreadTrace &thread = thread_trace_ensure();
+  thread.events.push_back({category, name, start_time, duration, false, 0.0});
+}
+
+void BLI_trace_counter(const char *name, const double value)
+{
+  ThreadTrace &thread = thread_trace_ensure();
+  thread.events.push_back({"", name, PIL_check_seconds_timer(), 0.0, true, value});
+}
+
+void BLI_trace_exit(void)
+{
+  if (!trace_enabled) {
+    return;
+  }
+  trace_enabled = false;
+
+  std::lock_guard lock{trace_mutex};
+
+  /* Start the timeline at the first recorded event. */
+  double trace_start_time = PIL_check_seconds_timer();
+  for (const std::unique_ptr<ThreadTrace> &thread : trace_threads) {
+    for (const TraceEvent &event : thread->events) {
+      trace_start_time = std::min(trace_start_time, event.start_time);
+    }
+  }
+
+  FILE *file = BLI_fopen(trace_filepath.c_str(), "w");
+  if (file == nullptr) {
+    printf("Error: could not write trace to '%s'\n", trace_filepath.c_str());
+  }
+  else {
+    write_chrome_trace(file, trace_start_time);
+    fclose(file);
+    printf("Trace written to '%s'\n", trace_filepath.c_str());
+  }
+
+  trace_threads.clear();
+  trace_filepath.clear();
+}
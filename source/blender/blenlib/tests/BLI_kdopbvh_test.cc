@@ -2,6 +2,8 @@
 
 #include "testing/testing.h"
 
+#include <algorithm>
+
 /* TODO: ray intersection, overlap ... etc. */
 
 #include "MEM_guardedalloc.h"
@@ -132,3 +134,57 @@ TEST(kdopbvh, OptimalFindNearest_500)
 {
   find_nearest_points_test(500, 1.0, 1000, 12, true);
 }
+
+static bool overlap_lower_index_first_callback(void * /*userdata*/,
+                                               int index_a,
+                                               int index_b,
+                                               int /*thread*/)
+{
+  return index_a < index_b;
+}
+
+static void overlap_self_test(int points_len, float epsilon, int random_seed)
+{
+  struct RNG *rng = BLI_rng_new(random_seed);
+  BVHTree *tree = BLI_bvhtree_new(points_len, epsilon, 4, 8);
+
+  for (int i = 0; i < points_len; i++) {
+    float co[3];
+    rng_v3_round(co, 3, rng, 1000, 1.0f);
+    BLI_bvhtree_insert(tree, i, co, 1);
+  }
+  BLI_bvhtree_balance(tree);
+
+  uint expected_len = 0;
+  BVHTreeOverlap *expected = BLI_bvhtree_overlap(
+      tree, tree, &expected_len, overlap_lower_index_first_callback, nullptr);
+  uint result_len = 0;
+  BVHTreeOverlap *result = BLI_bvhtree_overlap_self(tree, &result_len, nullptr, nullptr);
+
+  auto pair_less = [](const BVHTreeOverlap &a, const BVHTreeOverlap &b) {
+    return a.indexA < b.indexA || (a.indexA == b.indexA && a.indexB < b.indexB);
+  };
+  std::sort(expected, expected + expected_len, pair_less);
+  std::sort(result, result + result_len, pair_less);
+
+  EXPECT_GT(result_len, 0);
+  ASSERT_EQ(result_len, expected_len);
+  for (uint i = 0; i < result_len; i++) {
+    EXPECT_EQ(result[i].indexA, expected[i].indexA);
+    EXPECT_EQ(result[i].indexB, expected[i].indexB);
+  }
+
+  MEM_SAFE_FREE(expected);
+  MEM_SAFE_FREE(result);
+  BLI_bvhtree_free(tree);
+  BLI_rng_free(rng);
+}
+
+TEST(kdopbvh, OverlapSelf_100)
+{
+  overlap_self_test(100, 0.1f, 1234);
+}
+TEST(kdopbvh, OverlapSelf_5000)
+{
+  overlap_self_test(5000, 0.02f, 123);
+}
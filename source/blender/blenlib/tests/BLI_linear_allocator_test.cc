@@ -149,4 +149,28 @@ TEST(linear_allocator, ConstructArray)
   }
 }
 
+TEST(linear_allocator, ResetReusesMemory)
+{
+  LinearAllocator<> allocator;
+  void *small_buffer1 = allocator.allocate(100, 8);
+  void *large_buffer1 = allocator.allocate(1024 * 1024, 8);
+  allocator.reset();
+  void *small_buffer2 = allocator.allocate(100, 8);
+  void *large_buffer2 = allocator.allocate(1024 * 1024, 8);
+  EXPECT_EQ(small_buffer1, small_buffer2);
+  EXPECT_EQ(large_buffer1, large_buffer2);
+}
+
+TEST(linear_allocator, ResetWithProvidedBuffer)
+{
+  AlignedBuffer<256, 8> stack_buffer;
+  LinearAllocator<> allocator;
+  allocator.provide_buffer(stack_buffer);
+  void *buffer1 = allocator.allocate(64, 8);
+  EXPECT_EQ(buffer1, stack_buffer.ptr());
+  allocator.reset(0);
+  void *buffer2 = allocator.allocate(64, 8);
+  EXPECT_EQ(buffer2, stack_buffer.ptr());
+}
+
 }  // namespace blender::tests
@@ -653,6 +653,28 @@ TEST(map, LookupKey)
   EXPECT_EQ(map.lookup_key_ptr("a"), map.lookup_key_ptr_as("a"));
 }
 
+TEST(map, AddMultipleAndLookupMultiple)
+{
+  Vector<int> keys;
+  Vector<int> values;
+  for (int i = 0; i < 1000; i++) {
+    keys.append(i % 300);
+    values.append(i);
+  }
+  Map<int, int> map;
+  map.add(5, -1);
+  map.add_multiple(keys, values);
+  EXPECT_EQ(map.size(), 300);
+  EXPECT_EQ(map.lookup(5), -1);
+  EXPECT_EQ(map.lookup(299), 299);
+
+  Array<int> result(keys.size());
+  map.lookup_multiple(keys, result);
+  for (const int64_t i : keys.index_range()) {
+    EXPECT_EQ(result[i], map.lookup(keys[i]));
+  }
+}
+
 /**
  * Set this to 1 to activate the benchmark. It is disabled by default, because it prints a lot.
  */
@@ -0,0 +1,109 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_mempool.h"
+#include "BLI_set.hh"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
+
+namespace blender::tests {
+
+struct MempoolTestElem {
+  int64_t value;
+  int64_t unused;
+};
+
+static constexpr int mempool_test_threads_num = 8;
+static constexpr int mempool_test_elems_per_thread = 1000;
+
+TEST(mempool, LocalAllocFreeThreaded)
+{
+  BLI_mempool *pool = BLI_mempool_create(
+      sizeof(MempoolTestElem), 0, 64, BLI_MEMPOOL_ALLOW_ITER);
+
+  /* Every thread allocates its elements and frees every second one again. */
+  Array<Vector<MempoolTestElem *>> kept_elems(mempool_test_threads_num);
+  threading::parallel_for(IndexRange(mempool_test_threads_num), 1, [&](const IndexRange range) {
+    for (const int thread : range) {
+      BLI_mempool_local *local = BLI_mempool_local_create(pool);
+      for (const int i : IndexRange(mempool_test_elems_per_thread)) {
+        MempoolTestElem *elem = static_cast<MempoolTestElem *>(BLI_mempool_local_alloc(local));
+        elem->value = thread * mempool_test_elems_per_thread + i;
+        if (i % 2 == 0) {
+          kept_elems[thread].append(elem);
+        }
+        else {
+          BLI_mempool_local_free(local, elem);
+        }
+      }
+      BLI_mempool_local_destroy(local);
+    }
+  });
+
+  const int kept_num = mempool_test_threads_num * mempool_test_elems_per_thread / 2;
+  EXPECT_EQ(BLI_mempool_len(pool), kept_num);
+
+  /* Iteration finds every kept element once, and skips the freed ones. */
+  Set<int64_t> values;
+  BLI_mempool_iter iter;
+  BLI_mempool_iternew(pool, &iter);
+  while (MempoolTestElem *elem = static_cast<MempoolTestElem *>(BLI_mempool_iterstep(&iter))) {
+    EXPECT_EQ(elem->value % 2, 0);
+    EXPECT_TRUE(values.add(elem->value));
+  }
+  EXPECT_EQ(values.size(), kept_num);
+
+  for (const Vector<MempoolTestElem *> &elems : kept_elems) {
+    for (MempoolTestElem *elem : elems) {
+      BLI_mempool_free(pool, elem);
+    }
+  }
+  EXPECT_EQ(BLI_mempool_len(pool), 0);
+  BLI_mempool_destroy(pool);
+}
+
+TEST(mempool, LocalFreeFromOtherThread)
+{
+  BLI_mempool *pool = BLI_mempool_create(
+      sizeof(MempoolTestElem), 0, 64, BLI_MEMPOOL_ALLOW_ITER);
+
+  Array<Vector<MempoolTestElem *>> elems(mempool_test_threads_num);
+  threading::parallel_for(IndexRange(mempool_test_threads_num), 1, [&](const IndexRange range) {
+    for (const int thread : range) {
+      BLI_mempool_local *local = BLI_mempool_local_create(pool);
+      for (const int i : IndexRange(mempool_test_elems_per_thread)) {
+        MempoolTestElem *elem = static_cast<MempoolTestElem *>(BLI_mempool_local_calloc(local));
+        EXPECT_EQ(elem->value, 0);
+        elem->value = thread * mempool_test_elems_per_thread + i;
+        elems[thread].append(elem);
+      }
+      BLI_mempool_local_destroy(local);
+    }
+  });
+  EXPECT_EQ(BLI_mempool_len(pool), mempool_test_threads_num * mempool_test_elems_per_thread);
+
+  /* Free the elements through the local of another thread than the one they came from. */
+  threading::parallel_for(IndexRange(mempool_test_threads_num), 1, [&](const IndexRange range) {
+    for (const int thread : range) {
+      BLI_mempool_local *local = BLI_mempool_local_create(pool);
+      for (MempoolTestElem *elem : elems[(thread + 1) % mempool_test_threads_num]) {
+        BLI_mempool_local_free(local, elem);
+      }
+      BLI_mempool_local_destroy(local);
+    }
+  });
+  EXPECT_EQ(BLI_mempool_len(pool), 0);
+
+  /* The freed elements can be allocated again. */
+  BLI_mempool_iter iter;
+  BLI_mempool_iternew(pool, &iter);
+  EXPECT_EQ(BLI_mempool_iterstep(&iter), nullptr);
+  void *elem = BLI_mempool_alloc(pool);
+  EXPECT_EQ(BLI_mempool_len(pool), 1);
+  BLI_mempool_free(pool, elem);
+  BLI_mempool_destroy(pool);
+}
+
+}  // namespace blender::tests
@@ -192,6 +192,27 @@ TEST(set, AddMultipleNew)
   EXPECT_TRUE(a.contains(6));
 }
 
+TEST(set, AddMultipleLarge)
+{
+  Vector<int> keys;
+  for (int i = 0; i < 1000; i++) {
+    keys.append(i * 7 % 500);
+  }
+  Set<int> a;
+  a.add(3);
+  a.add_multiple(keys);
+  EXPECT_EQ(a.size(), 500);
+  for (int i = 0; i < 500; i++) {
+    EXPECT_TRUE(a.contains(i));
+  }
+
+  Set<int> b;
+  b.add_multiple_new(keys.as_span().take_front(500));
+  EXPECT_EQ(b.size(), 500);
+  EXPECT_TRUE(b.contains(499));
+  EXPECT_FALSE(b.contains(500));
+}
+
 TEST(set, Iterator)
 {
   Set<int> set = {1, 3, 2, 5, 4};
@@ -0,0 +1,166 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <string>
+
+#include "BLI_array.hh"
+#include "BLI_index_mask.hh"
+#include "BLI_map.hh"
+#include "BLI_rand.hh"
+#include "BLI_set.hh"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
+#include "BLI_virtual_array.hh"
+
+#include "PIL_time.h"
+
+/* Run with `--gtest_output=json:<file>` to get the timings in machine-readable form. */
+
+namespace blender::tests {
+
+/**
+ * Call the function a number of times after one warm-up call, then print the average time of a
+ * single call and record it in microseconds as a property of the current test.
+ */
+template<typename Fn> static void run_benchmark(const char *name, const int runs, const Fn &fn)
+{
+  fn();
+
+  const double start_time = PIL_check_seconds_timer();
+  for (int i = 0; i < runs; i++) {
+    fn();
+  }
+  const double average_time = (PIL_check_seconds_timer() - start_time) / runs;
+
+  printf("%s: %.3f ms\n", name, average_time * 1000.0);
+  ::testing::Test::RecordProperty(name, std::to_string(average_time * 1000000.0));
+}
+
+static Array<int> random_keys(const int64_t amount)
+{
+  RandomNumberGenerator rng{0};
+  Array<int> keys(amount);
+  for (int &key : keys) {
+    key = rng.get_int32();
+  }
+  return keys;
+}
+
+static Vector<int64_t> every_other_index(const int64_t size)
+{
+  Vector<int64_t> indices;
+  for (int64_t i = 0; i < size; i += 2) {
+    indices.append(i);
+  }
+  return indices;
+}
+
+TEST(containers_performance, Map)
+{
+  const Array<int> keys = random_keys(1000000);
+  Map<int, int> map;
+  int found = 0;
+
+  run_benchmark("map_add", 10, [&]() {
+    map.clear();
+    for (const int key : keys) {
+      map.add(key, key);
+    }
+  });
+  run_benchmark("map_lookup", 10, [&]() {
+    found = 0;
+    for (const int key : keys) {
+      found += map.contains(key);
+    }
+  });
+  EXPECT_EQ(found, keys.size());
+  run_benchmark("map_copy_and_remove", 10, [&]() {
+    Map<int, int> map_copy = map;
+    for (const int key : keys) {
+      map_copy.remove(key);
+    }
+  });
+}
+
+TEST(containers_performance, Set)
+{
+  const Array<int> keys = random_keys(1000000);
+  Set<int> set;
+  int found = 0;
+
+  run_benchmark("set_add", 10, [&]() {
+    set.clear();
+    for (const int key : keys) {
+      set.add(key);
+    }
+  });
+  run_benchmark("set_lookup", 10, [&]() {
+    found = 0;
+    for (const int key : keys) {
+      found += set.contains(key);
+    }
+  });
+  EXPECT_EQ(found, keys.size());
+}
+
+TEST(containers_performance, Vector)
+{
+  const int64_t size = 10000000;
+  Vector<int> vector;
+
+  run_benchmark("vector_append", 10, [&]() {
+    vector.clear_and_make_inline();
+    for (const int64_t i : IndexRange(size)) {
+      vector.append(int(i));
+    }
+  });
+  run_benchmark("vector_append_reserved", 10, [&]() {
+    vector.clear();
+    vector.reserve(size);
+    for (const int64_t i : IndexRange(size)) {
+      vector.append_unchecked(int(i));
+    }
+  });
+  EXPECT_EQ(vector.size(), size);
+}
+
+TEST(containers_performance, ParallelForGrainSize)
+{
+  Array<float> values(10000000, 1.0f);
+
+  for (const int64_t grain_size : {1, 64, 512, 4096, 65536}) {
+    const std::string name = "parallel_for_grain_" + std::to_string(grain_size);
+    run_benchmark(name.c_str(), 10, [&]() {
+      threading::parallel_for(values.index_range(), grain_size, [&](const IndexRange range) {
+        for (const int64_t i : range) {
+          values[i] = values[i] * 0.5f + 0.5f;
+        }
+      });
+    });
+  }
+  EXPECT_EQ(values[0], 1.0f);
+}
+
+TEST(containers_performance, VArrayMaterialize)
+{
+  const int64_t size = 10000000;
+  const Array<int> data(size, 5);
+  const Vector<int64_t> sparse_indices = every_other_index(size);
+  Array<int> dst(size);
+
+  const VArray<int> varray_span = VArray<int>::ForSpan(data);
+  const VArray<int> varray_single = VArray<int>::ForSingle(5, size);
+  const VArray<int> varray_func = VArray<int>::ForFunc(size,
+                                                        [](const int64_t i) { return int(i); });
+
+  run_benchmark("varray_span_materialize", 10, [&]() { varray_span.materialize(dst); });
+  run_benchmark("varray_span_materialize_sparse", 10, [&]() {
+    varray_span.materialize(IndexMask(sparse_indices), dst);
+  });
+  run_benchmark("varray_single_materialize", 10, [&]() { varray_single.materialize(dst); });
+  run_benchmark("varray_func_materialize", 10, [&]() { varray_func.materialize(dst); });
+  EXPECT_EQ(dst[3], 3);
+}
+
+}  // namespace blender::tests
@@ -172,6 +172,12 @@ BlendFileData *BLO_read_from_memfile(struct Main *oldmain,
  */
 void BLO_blendfiledata_free(BlendFileData *bfd);
 
+/**
+ * Free the parsed DNA of previously read files, which is cached to avoid parsing it again when
+ * reading other files with the same DNA. DNA still used by open files is freed when they close.
+ */
+void BLO_file_dna_cache_clear(void);
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
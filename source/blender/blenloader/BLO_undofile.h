@@ -18,8 +18,13 @@ typedef struct {
   const char *buf;
   /** Size in bytes. */
   size_t size;
-  /** When true, this chunk doesn't own the memory, it's shared with a previous #MemFileChunk */
+  /** When true, this chunk is identical to the matching chunk of the previous step, and shares
+   * its memory. */
   bool is_identical;
+  /** When true, this chunk doesn't own the memory, it's shared with a previous #MemFileChunk.
+   * Always set for identical chunks, but also for chunks found by content elsewhere in the
+   * previous step. */
+  bool is_shared;
   /** When true, this chunk is also identical to the one in the next step (used by undo code to
    * detect unchanged IDs).
    * Defined when writing the next step (i.e. last undo step has those always false). */
@@ -27,6 +32,11 @@ typedef struct {
   /** Session UUID of the ID being currently written (MAIN_ID_SESSION_UUID_UNSET when not writing
    * ID-related data). Used to find matching chunks in previous memundo step. */
   uint id_session_uuid;
+  /** Unique identifier of #MemFileChunk.buf, shared by all chunks using the same buffer.
+   * Unlike the pointer it is never reused, so it can tell whether a chunk was already written. */
+  uint64_t buf_uid;
+  /** Hash of the content of #MemFileChunk.buf, used to find identical chunks by content. */
+  uint buf_hash;
 } MemFileChunk;
 
 typedef struct MemFile {
@@ -43,8 +53,26 @@ typedef struct MemFileWriteData {
 
   /** Maps an ID session uuid to its first reference MemFileChunk, if existing. */
   struct GHash *id_session_uuid_mapping;
+  /** Maps a content hash to a reference MemFileChunk with that hash, if existing. */
+  struct GHash *buf_hash_mapping;
 } MemFileWriteData;
 
+typedef struct MemFileWrittenChunk {
+  uint64_t buf_uid;
+  size_t size;
+} MemFileWrittenChunk;
+
+/** Layout of the chunks last written to a file, see #BLO_memfile_write_file_incremental. */
+typedef struct MemFileWrittenLayout {
+  char filename[1024]; /* FILE_MAX */
+  /** Size and modification time of the file after writing, to detect outside changes. */
+  int64_t file_size;
+  int64_t file_mtime;
+
+  MemFileWrittenChunk *chunks;
+  uint chunks_len;
+} MemFileWrittenLayout;
+
 typedef struct MemFileUndoData {
   char filename[1024]; /* FILE_MAX */
   MemFile memfile;
@@ -99,5 +127,18 @@ extern struct Main *BLO_memfile_main_get(struct MemFile *memfile,
  * \return success.
  */
 extern bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename);
+/**
+ * Saves .blend using undo buffer, only writing the chunks that changed since \a layout was
+ * written to the same file. Chunks are skipped as long as all chunks before them kept their size,
+ * so the file stays a regular .blend file. Falls back to writing the whole file when the file was
+ * changed by something else.
+ *
+ * \param layout: The chunks written by a previous call, updated to the chunks of \a memfile.
+ * \return success.
+ */
+extern bool BLO_memfile_write_file_incremental(struct MemFile *memfile,
+                                               const char *filename,
+                                               MemFileWrittenLayout *layout);
+extern void BLO_memfile_written_layout_free(MemFileWrittenLayout *layout);
 
 FileReader *BLO_memfile_new_filereader(MemFile *memfile, int undo_direction);
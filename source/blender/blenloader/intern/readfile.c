@@ -53,6 +53,7 @@
 #include "BLI_math.h"
 #include "BLI_memarena.h"
 #include "BLI_mempool.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "PIL_time.h"
@@ -1037,6 +1038,177 @@ static void decode_blender_header(FileData *fd)
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name File DNA Cache
+ *
+ * Parsing the DNA of a file and comparing it with the current DNA is done every time a file is
+ * opened, which includes every link or append from a library, and every file read by the file
+ * browser. Most files share the exact same DNA (e.g. all files saved by the same Blender version),
+ * so the parsed DNA is cached at process level, keyed on the raw DNA block, file version and
+ * endianness, and shared between all #FileData using it.
+ * \{ */
+
+/** Maximum number of unused parsed DNA kept around. */
+#define FILE_DNA_CACHE_UNUSED_MAX 8
+
+typedef struct FileDNA {
+  struct FileDNA *next, *prev;
+
+  /* Key. */
+  void *data;
+  int data_len;
+  int fileversion;
+  int subversion;
+  bool do_endian_swap;
+
+  struct SDNA *filesdna;
+  /** Array of #eSDNA_StructCompare. */
+  const char *compflags;
+  struct DNA_ReconstructInfo *reconstruct_info;
+  int id_name_offset;
+  int id_asset_data_offset;
+
+  /** Number of #FileData using this, unused ones are kept in the cache until evicted. */
+  int users;
+} FileDNA;
+
+static struct {
+  /** Most recently used first. */
+  ListBase list;
+  int unused_len;
+} g_file_dna_cache = {{NULL, NULL}, 0};
+static ThreadMutex g_file_dna_cache_lock = BLI_MUTEX_INITIALIZER;
+
+static void file_dna_free(FileDNA *file_dna)
+{
+  DNA_sdna_free(file_dna->filesdna);
+  MEM_freeN((void *)file_dna->compflags);
+  DNA_reconstruct_info_free(file_dna->reconstruct_info);
+  MEM_freeN(file_dna->data);
+  MEM_freeN(file_dna);
+}
+
+static FileDNA *file_dna_new(const void *data,
+                             const int data_len,
+                             const int fileversion,
+                             const int subversion,
+                             const bool do_endian_swap,
+                             const struct SDNA *memsdna,
+                             const char **r_error_message)
+{
+  struct SDNA *filesdna = DNA_sdna_from_data(
+      data, data_len, do_endian_swap, true, r_error_message);
+  if (filesdna == NULL) {
+    return NULL;
+  }
+  blo_do_versions_dna(filesdna, fileversion, subversion);
+
+  FileDNA *file_dna = MEM_callocN(sizeof(*file_dna), __func__);
+  file_dna->data = MEM_mallocN((size_t)data_len, __func__);
+  memcpy(file_dna->data, data, (size_t)data_len);
+  file_dna->data_len = data_len;
+  file_dna->fileversion = fileversion;
+  file_dna->subversion = subversion;
+  file_dna->do_endian_swap = do_endian_swap;
+
+  file_dna->filesdna = filesdna;
+  file_dna->compflags = DNA_struct_get_compareflags(filesdna, memsdna);
+  file_dna->reconstruct_info = DNA_reconstruct_info_create(
+      filesdna, memsdna, file_dna->compflags);
+  /* used to retrieve ID names from (bhead+1) */
+  file_dna->id_name_offset = DNA_elem_offset(filesdna, "ID", "char", "name[]");
+  BLI_assert(file_dna->id_name_offset != -1);
+  file_dna->id_asset_data_offset = DNA_elem_offset(
+      filesdna, "ID", "AssetMetaData", "*asset_data");
+  return file_dna;
+}
+
+/**
+ * Get the parsed DNA matching the given DNA block, parsing it only when it is not cached yet.
+ * Must be released with #file_dna_release.
+ */
+static FileDNA *file_dna_acquire(const void *data,
+                                 const int data_len,
+                                 const int fileversion,
+                                 const int subversion,
+                                 const bool do_endian_swap,
+                                 const struct SDNA *memsdna,
+                                 const char **r_error_message)
+{
+  BLI_mutex_lock(&g_file_dna_cache_lock);
+
+  LISTBASE_FOREACH (FileDNA *, file_dna, &g_file_dna_cache.list) {
+    if (file_dna->data_len == data_len && file_dna->fileversion == fileversion &&
+        file_dna->subversion == subversion && file_dna->do_endian_swap == do_endian_swap &&
+        memcmp(file_dna->data, data, (size_t)data_len) == 0) {
+      if (file_dna->users++ == 0) {
+        g_file_dna_cache.unused_len--;
+      }
+      BLI_remlink(&g_file_dna_cache.list, file_dna);
+      BLI_addhead(&g_file_dna_cache.list, file_dna);
+      BLI_mutex_unlock(&g_file_dna_cache_lock);
+      return file_dna;
+    }
+  }
+
+  /* Parsing isn't done with the lock held, it's fine if another thread adds the same DNA in the
+   * meantime, both will be used and eventually evicted. */
+  BLI_mutex_unlock(&g_file_dna_cache_lock);
+  FileDNA *file_dna = file_dna_new(
+      data, data_len, fileversion, subversion, do_endian_swap, memsdna, r_error_message);
+  if (file_dna == NULL) {
+    return NULL;
+  }
+  file_dna->users = 1;
+
+  BLI_mutex_lock(&g_file_dna_cache_lock);
+  BLI_addhead(&g_file_dna_cache.list, file_dna);
+  BLI_mutex_unlock(&g_file_dna_cache_lock);
+  return file_dna;
+}
+
+static void file_dna_release(FileDNA *file_dna)
+{
+  BLI_mutex_lock(&g_file_dna_cache_lock);
+
+  BLI_assert(file_dna->users > 0);
+  if (--file_dna->users == 0) {
+    g_file_dna_cache.unused_len++;
+  }
+
+  /* Evict the least recently used unused DNA. */
+  for (FileDNA *file_dna_iter = g_file_dna_cache.list.last, *file_dna_prev;
+       file_dna_iter != NULL && g_file_dna_cache.unused_len > FILE_DNA_CACHE_UNUSED_MAX;
+       file_dna_iter = file_dna_prev) {
+    file_dna_prev = file_dna_iter->prev;
+    if (file_dna_iter->users == 0) {
+      BLI_remlink(&g_file_dna_cache.list, file_dna_iter);
+      file_dna_free(file_dna_iter);
+      g_file_dna_cache.unused_len--;
+    }
+  }
+
+  BLI_mutex_unlock(&g_file_dna_cache_lock);
+}
+
+void BLO_file_dna_cache_clear(void)
+{
+  BLI_mutex_lock(&g_file_dna_cache_lock);
+
+  LISTBASE_FOREACH_MUTABLE (FileDNA *, file_dna, &g_file_dna_cache.list) {
+    /* Files still open keep using their DNA, it is freed when they are closed. */
+    if (file_dna->users == 0) {
+      BLI_remlink(&g_file_dna_cache.list, file_dna);
+      file_dna_free(file_dna);
+    }
+  }
+  g_file_dna_cache.unused_len = 0;
+
+  BLI_mutex_unlock(&g_file_dna_cache_lock);
+}
+
+/** \} */
+
 /**
  * \return Success if the file is read correctly, else set \a r_error_message.
  */
@@ -1064,18 +1236,19 @@ static bool read_file_dna(FileData *fd, const char **r_error_message)
     else if (bhead->code == DNA1) {
       const bool do_endian_swap = (fd->flags & FD_FLAGS_SWITCH_ENDIAN) != 0;
 
-      fd->filesdna = DNA_sdna_from_data(
-          &bhead[1], bhead->len, do_endian_swap, true, r_error_message);
-      if (fd->filesdna) {
-        blo_do_versions_dna(fd->filesdna, fd->fileversion, subversion);
-        fd->compflags = DNA_struct_get_compareflags(fd->filesdna, fd->memsdna);
-        fd->reconstruct_info = DNA_reconstruct_info_create(
-            fd->filesdna, fd->memsdna, fd->compflags);
-        /* used to retrieve ID names from (bhead+1) */
-        fd->id_name_offset = DNA_elem_offset(fd->filesdna, "ID", "char", "name[]");
-        BLI_assert(fd->id_name_offset != -1);
-        fd->id_asset_data_offset = DNA_elem_offset(
-            fd->filesdna, "ID", "AssetMetaData", "*asset_data");
+      fd->file_dna = file_dna_acquire(&bhead[1],
+                                      bhead->len,
+                                      fd->fileversion,
+                                      subversion,
+                                      do_endian_swap,
+                                      fd->memsdna,
+                                      r_error_message);
+      if (fd->file_dna) {
+        fd->filesdna = fd->file_dna->filesdna;
+        fd->compflags = fd->file_dna->compflags;
+        fd->reconstruct_info = fd->file_dna->reconstruct_info;
+        fd->id_name_offset = fd->file_dna->id_name_offset;
+        fd->id_asset_data_offset = fd->file_dna->id_asset_data_offset;
 
         return true;
       }
@@ -1352,14 +1525,8 @@ void blo_filedata_free(FileData *fd)
 #endif
     fd->file->close(fd->file);
 
-    if (fd->filesdna) {
-      DNA_sdna_free(fd->filesdna);
-    }
-    if (fd->compflags) {
-      MEM_freeN((void *)fd->compflags);
-    }
-    if (fd->reconstruct_info) {
-      DNA_reconstruct_info_free(fd->reconstruct_info);
+    if (fd->file_dna) {
+      file_dna_release(fd->file_dna);
     }
 
     if (fd->datamap) {
@@ -1846,6 +2013,68 @@ static void switch_endian_structs(const struct SDNA *filesdna, BHead *bhead)
   }
 }
 
+/**
+ * Arrays of structs with at least this many elements are reconstructed on multiple threads.
+ * Those are typically the large geometry arrays (vertices, loops, custom data layers...) that
+ * dominate the time spent in DNA reconstruction when loading files from other versions.
+ */
+#define RECONSTRUCT_PARALLEL_MIN_BLOCKS 8192
+/** Number of structs reconstructed by a single task. */
+#define RECONSTRUCT_PARALLEL_CHUNK_SIZE 4096
+
+typedef struct ReconstructParallelData {
+  const struct DNA_ReconstructInfo *reconstruct_info;
+  int old_struct_nr;
+  int blocks;
+  const void *old_blocks;
+  void *new_blocks;
+} ReconstructParallelData;
+
+static void reconstruct_parallel_chunk_fn(void *__restrict userdata,
+                                          const int chunk_index,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ReconstructParallelData *data = userdata;
+  const int start = chunk_index * RECONSTRUCT_PARALLEL_CHUNK_SIZE;
+  const int blocks = MIN2(RECONSTRUCT_PARALLEL_CHUNK_SIZE, data->blocks - start);
+  DNA_struct_reconstruct_range(data->reconstruct_info,
+                               data->old_struct_nr,
+                               start,
+                               blocks,
+                               data->old_blocks,
+                               data->new_blocks);
+}
+
+/**
+ * Same as #DNA_struct_reconstruct, but large arrays are split into chunks
+ * that are reconstructed in parallel.
+ */
+static void *read_struct_reconstruct(FileData *fd, BHead *bh)
+{
+  if (bh->nr < RECONSTRUCT_PARALLEL_MIN_BLOCKS) {
+    return DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, (bh + 1));
+  }
+
+  ReconstructParallelData data = {
+      .reconstruct_info = fd->reconstruct_info,
+      .old_struct_nr = bh->SDNAnr,
+      .blocks = bh->nr,
+      .old_blocks = (bh + 1),
+  };
+  data.new_blocks = DNA_struct_reconstruct_alloc(data.reconstruct_info, bh->SDNAnr, bh->nr);
+  if (data.new_blocks == NULL) {
+    return NULL;
+  }
+
+  const int chunks_num = (data.blocks + RECONSTRUCT_PARALLEL_CHUNK_SIZE - 1) /
+                         RECONSTRUCT_PARALLEL_CHUNK_SIZE;
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  BLI_task_parallel_range(0, chunks_num, &data, reconstruct_parallel_chunk_fn, &settings);
+
+  return data.new_blocks;
+}
+
 static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
 {
   void *temp = NULL;
@@ -1880,7 +2109,7 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
           }
         }
 #endif
-        temp = DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, (bh + 1));
+        temp = read_struct_reconstruct(fd, bh);
       }
       else {
         /* SDNA_CMP_EQUAL */
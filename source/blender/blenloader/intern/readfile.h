@@ -60,6 +60,8 @@ typedef struct FileData {
   char relabase[FILE_MAX];
 
   /** General reading variables. */
+  /** Shared parsed DNA of the file, which owns #filesdna, #compflags and #reconstruct_info. */
+  struct FileDNA *file_dna;
   struct SDNA *filesdna;
   const struct SDNA *memsdna;
   /** Array of #eSDNA_StructCompare. */
@@ -25,6 +25,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
+#include "BLI_hash_mm2a.h"
 
 #include "BLO_readfile.h"
 #include "BLO_undofile.h"
@@ -38,12 +39,15 @@
 
 /* **************** support for memory-write, for undo buffers *************** */
 
+/** Source of #MemFileChunk.buf_uid, undo steps are only written from the main thread. */
+static uint64_t memfile_chunk_buf_uid_last = 0;
+
 void BLO_memfile_free(MemFile *memfile)
 {
   MemFileChunk *chunk;
 
   while ((chunk = BLI_pophead(&memfile->chunks))) {
-    if (chunk->is_identical == false) {
+    if (chunk->is_shared == false) {
       MEM_freeN((void *)chunk->buf);
     }
     MEM_freeN(chunk);
@@ -60,20 +64,25 @@ void BLO_memfile_merge(MemFile *first, MemFile *second)
 
   /* First, detect all memchunks in second memfile that are not owned by it. */
   for (MemFileChunk *sc = second->chunks.first; sc != NULL; sc = sc->next) {
-    if (sc->is_identical) {
-      BLI_ghash_insert(buffer_to_second_memchunk, (void *)sc->buf, sc);
+    if (sc->is_shared) {
+      /* Chunks found by content can share the same buffer, one of them is enough. */
+      void **entry;
+      if (!BLI_ghash_ensure_p(buffer_to_second_memchunk, (void *)sc->buf, &entry)) {
+        *entry = sc;
+      }
     }
   }
 
   /* Now, check all chunks from first memfile (the one we are removing), and if a memchunk owned by
    * it is also used by the second memfile, transfer the ownership. */
   for (MemFileChunk *fc = first->chunks.first; fc != NULL; fc = fc->next) {
-    if (!fc->is_identical) {
+    if (!fc->is_shared) {
       MemFileChunk *sc = BLI_ghash_lookup(buffer_to_second_memchunk, fc->buf);
       if (sc != NULL) {
-        BLI_assert(sc->is_identical);
+        BLI_assert(sc->is_shared);
         sc->is_identical = false;
-        fc->is_identical = true;
+        sc->is_shared = false;
+        fc->is_shared = true;
       }
       /* Note that if the second memfile does not use that chunk, we assume that the first one
        * fully owns it without sharing it with any other memfile, and hence it should be freed with
@@ -100,6 +109,8 @@ void BLO_memfile_write_init(MemFileWriteData *mem_data,
   mem_data->written_memfile = written_memfile;
   mem_data->reference_memfile = reference_memfile;
   mem_data->reference_current_chunk = reference_memfile ? reference_memfile->chunks.first : NULL;
+  mem_data->id_session_uuid_mapping = NULL;
+  mem_data->buf_hash_mapping = NULL;
 
   /* If we have a reference memfile, we generate a mapping between the session_uuid's of the
    * IDs stored in that previous undo step, and its first matching memchunk. This will allow
@@ -124,6 +135,19 @@ void BLO_memfile_write_init(MemFileWriteData *mem_data,
         }
       }
     }
+
+    /* Data that moved, e.g. after arrays were reallocated or other data was inserted before it,
+     * doesn't match the chunk at the same position anymore. This mapping allows to still share
+     * its memory with the previous step. */
+    mem_data->buf_hash_mapping = BLI_ghash_new(
+        BLI_ghashutil_inthash_p_simple, BLI_ghashutil_intcmp, __func__);
+    LISTBASE_FOREACH (MemFileChunk *, mem_chunk, &reference_memfile->chunks) {
+      void **entry;
+      if (!BLI_ghash_ensure_p(
+              mem_data->buf_hash_mapping, POINTER_FROM_UINT(mem_chunk->buf_hash), &entry)) {
+        *entry = mem_chunk;
+      }
+    }
   }
 }
 
@@ -132,6 +156,9 @@ void BLO_memfile_write_finalize(MemFileWriteData *mem_data)
   if (mem_data->id_session_uuid_mapping != NULL) {
     BLI_ghash_free(mem_data->id_session_uuid_mapping, NULL, NULL);
   }
+  if (mem_data->buf_hash_mapping != NULL) {
+    BLI_ghash_free(mem_data->buf_hash_mapping, NULL, NULL);
+  }
 }
 
 void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t size)
@@ -143,6 +170,7 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
   curchunk->size = size;
   curchunk->buf = NULL;
   curchunk->is_identical = false;
+  curchunk->is_shared = false;
   /* This is unsafe in the sense that an app handler or other code that does not
    * perform an undo push may make changes after the last undo push that
    * will then not be undo. Though it's not entirely clear that is wrong behavior. */
@@ -156,7 +184,10 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
     if (compchunk->size == curchunk->size) {
       if (memcmp(compchunk->buf, buf, size) == 0) {
         curchunk->buf = compchunk->buf;
+        curchunk->buf_uid = compchunk->buf_uid;
+        curchunk->buf_hash = compchunk->buf_hash;
         curchunk->is_identical = true;
+        curchunk->is_shared = true;
         compchunk->is_identical_future = true;
       }
     }
@@ -165,9 +196,26 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
 
   /* not equal... */
   if (curchunk->buf == NULL) {
+    curchunk->buf_hash = BLI_hash_mm2((const uchar *)buf, size, 0);
+
+    /* Look for the same content elsewhere in the previous step. Such a chunk only shares memory,
+     * it's not identical in the sense that the data it belongs to is unchanged. */
+    if (mem_data->buf_hash_mapping != NULL) {
+      MemFileChunk *hashchunk = BLI_ghash_lookup(mem_data->buf_hash_mapping,
+                                                 POINTER_FROM_UINT(curchunk->buf_hash));
+      if (hashchunk != NULL && hashchunk->size == size &&
+          memcmp(hashchunk->buf, buf, size) == 0) {
+        curchunk->buf = hashchunk->buf;
+        curchunk->buf_uid = hashchunk->buf_uid;
+        curchunk->is_shared = true;
+        return;
+      }
+    }
+
     char *buf_new = MEM_mallocN(size, "Chunk buffer");
     memcpy(buf_new, buf, size);
     curchunk->buf = buf_new;
+    curchunk->buf_uid = ++memfile_chunk_buf_uid_last;
     memfile->size += size;
   }
 }
@@ -195,9 +243,8 @@ struct Main *BLO_memfile_main_get(struct MemFile *memfile,
   return bmain_undo;
 }
 
-bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename)
+static int memfile_file_open(const char *filename, const bool use_truncate)
 {
-  MemFileChunk *chunk;
   int file, oflags;
 
   /* NOTE: This is currently used for autosave and 'quit.blend',
@@ -206,7 +253,10 @@ bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename)
    * we may want to allow writing to symlinks.
    */
 
-  oflags = O_BINARY | O_WRONLY | O_CREAT | O_TRUNC;
+  oflags = O_BINARY | O_WRONLY | O_CREAT;
+  if (use_truncate) {
+    oflags |= O_TRUNC;
+  }
 #ifdef O_NOFOLLOW
   /* use O_NOFOLLOW to avoid writing to a symlink - use 'O_EXCL' (CVE-2008-1103) */
   oflags |= O_NOFOLLOW;
@@ -223,16 +273,30 @@ bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename)
             "Unable to save '%s': %s\n",
             filename,
             errno ? strerror(errno) : "Unknown error opening file");
-    return false;
   }
+  return file;
+}
 
-  for (chunk = memfile->chunks.first; chunk; chunk = chunk->next) {
+static bool memfile_chunk_write(int file, const MemFileChunk *chunk)
+{
 #ifdef _WIN32
-    if ((size_t)write(file, chunk->buf, (uint)chunk->size) != chunk->size)
+  return (size_t)write(file, chunk->buf, (uint)chunk->size) == chunk->size;
 #else
-    if ((size_t)write(file, chunk->buf, chunk->size) != chunk->size)
+  return (size_t)write(file, chunk->buf, chunk->size) == chunk->size;
 #endif
-    {
+}
+
+bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename)
+{
+  MemFileChunk *chunk;
+  int file = memfile_file_open(filename, true);
+
+  if (file == -1) {
+    return false;
+  }
+
+  for (chunk = memfile->chunks.first; chunk; chunk = chunk->next) {
+    if (!memfile_chunk_write(file, chunk)) {
       break;
     }
   }
@@ -249,6 +313,121 @@ bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename)
   return true;
 }
 
+void BLO_memfile_written_layout_free(MemFileWrittenLayout *layout)
+{
+  MEM_SAFE_FREE(layout->chunks);
+  layout->chunks_len = 0;
+  layout->filename[0] = '\0';
+}
+
+static bool memfile_written_layout_matches_file(const MemFileWrittenLayout *layout,
+                                                const char *filename)
+{
+  if (layout->chunks == NULL || !STREQ(layout->filename, filename)) {
+    return false;
+  }
+  BLI_stat_t st;
+  if (BLI_stat(filename, &st) == -1) {
+    return false;
+  }
+  return ((int64_t)st.st_size == layout->file_size) &&
+         ((int64_t)st.st_mtime == layout->file_mtime);
+}
+
+static bool memfile_file_truncate(int file, size_t size)
+{
+#ifdef _WIN32
+  return _chsize_s(file, (__int64)size) == 0;
+#else
+  return ftruncate(file, (off_t)size) == 0;
+#endif
+}
+
+bool BLO_memfile_write_file_incremental(struct MemFile *memfile,
+                                        const char *filename,
+                                        MemFileWrittenLayout *layout)
+{
+  const bool use_layout = memfile_written_layout_matches_file(layout, filename);
+  int file = memfile_file_open(filename, !use_layout);
+
+  if (file == -1) {
+    BLO_memfile_written_layout_free(layout);
+    return false;
+  }
+
+  const uint chunks_len = (uint)BLI_listbase_count(&memfile->chunks);
+  MemFileWrittenChunk *written_chunks = MEM_malloc_arrayN(
+      MAX2(chunks_len, 1u), sizeof(*written_chunks), __func__);
+
+  /* Chunks can only be skipped while they are at the same offset as in the file, which is the
+   * case as long as all previous chunks kept their size. */
+  bool is_aligned = use_layout;
+  bool use_seek = false;
+  bool is_error = false;
+  size_t offset = 0;
+  uint i = 0;
+
+  LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+    const MemFileWrittenChunk *written_chunk = (is_aligned && i < layout->chunks_len) ?
+                                                   &layout->chunks[i] :
+                                                   NULL;
+    if (written_chunk == NULL || written_chunk->size != chunk->size) {
+      is_aligned = false;
+    }
+
+    if (is_aligned && written_chunk->buf_uid == chunk->buf_uid) {
+      use_seek = true;
+    }
+    else {
+      if (use_seek) {
+        if (BLI_lseek(file, (int64_t)offset, SEEK_SET) == -1) {
+          is_error = true;
+          break;
+        }
+        use_seek = false;
+      }
+      if (!memfile_chunk_write(file, chunk)) {
+        is_error = true;
+        break;
+      }
+    }
+
+    written_chunks[i].buf_uid = chunk->buf_uid;
+    written_chunks[i].size = chunk->size;
+    offset += chunk->size;
+    i++;
+  }
+
+  if (!is_error && use_layout && (int64_t)offset < layout->file_size) {
+    is_error = !memfile_file_truncate(file, offset);
+  }
+
+  BLI_stat_t st;
+  if (!is_error && BLI_fstat(file, &st) == -1) {
+    is_error = true;
+  }
+
+  close(file);
+
+  BLO_memfile_written_layout_free(layout);
+
+  if (is_error) {
+    fprintf(stderr,
+            "Unable to save '%s': %s\n",
+            filename,
+            errno ? strerror(errno) : "Unknown error writing file");
+    MEM_freeN(written_chunks);
+    return false;
+  }
+
+  BLI_strncpy(layout->filename, filename, sizeof(layout->filename));
+  layout->file_size = (int64_t)offset;
+  layout->file_mtime = (int64_t)st.st_mtime;
+  layout->chunks = written_chunks;
+  layout->chunks_len = chunks_len;
+  return true;
+}
+
 static ssize_t undo_read(FileReader *reader, void *buffer, size_t size)
 {
   UndoReader *undo = (UndoReader *)reader;
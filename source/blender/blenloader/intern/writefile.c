@@ -168,10 +168,18 @@ struct WriteWrap {
     ListBase threadpool;
     ListBase tasks;
     ThreadMutex mutex;
-    ThreadCondition condition;
     int next_frame;
     int num_frames;
 
+    /** Compressed blocks waiting for earlier frames, sorted by frame number. */
+    ListBase pending_blocks;
+    /** True while a thread writes out the pending blocks, only one thread writes at a time. */
+    bool is_writing;
+
+    /** Compression contexts reused between blocks, one per worker thread. */
+    ZSTD_CCtx **contexts;
+    int num_free_contexts;
+
     int level;
     ListBase frames;
 
@@ -209,35 +217,29 @@ typedef struct {
   void *data;
   size_t size;
   int frame_number;
+  /** Set once the block has been compressed, the thread can be joined without waiting. */
+  bool is_done;
   WriteWrap *ww;
 } ZstdWriteBlockTask;
 
-static void *zstd_write_task(void *userdata)
-{
-  ZstdWriteBlockTask *task = userdata;
-  WriteWrap *ww = task->ww;
-
-  size_t out_buf_len = ZSTD_compressBound(task->size);
-  void *out_buf = MEM_mallocN(out_buf_len, "Zstd out buffer");
-  size_t out_size = ZSTD_compress(
-      out_buf, out_buf_len, task->data, task->size, ZSTD_COMPRESSION_LEVEL);
-
-  MEM_freeN(task->data);
-
-  BLI_mutex_lock(&ww->zstd.mutex);
-
-  while (ww->zstd.next_frame != task->frame_number) {
-    BLI_condition_wait(&ww->zstd.condition, &ww->zstd.mutex);
-  }
+typedef struct ZstdCompressedBlock {
+  struct ZstdCompressedBlock *next, *prev;
+  void *data;
+  size_t size;
+  size_t uncompressed_size;
+  int frame_number;
+} ZstdCompressedBlock;
 
-  if (ZSTD_isError(out_size)) {
+static void zstd_write_compressed_block(WriteWrap *ww, ZstdCompressedBlock *block)
+{
+  if (ZSTD_isError(block->size)) {
     ww->zstd.write_error = true;
   }
-  else {
-    if (ww_write_none(ww, out_buf, out_size) == out_size) {
+  else if (!ww->zstd.write_error) {
+    if (ww_write_none(ww, block->data, block->size) == block->size) {
       ZstdFrame *frameinfo = MEM_mallocN(sizeof(ZstdFrame), "zstd frameinfo");
-      frameinfo->uncompressed_size = task->size;
-      frameinfo->compressed_size = out_size;
+      frameinfo->uncompressed_size = block->uncompressed_size;
+      frameinfo->compressed_size = block->size;
       BLI_addtail(&ww->zstd.frames, frameinfo);
     }
     else {
@@ -245,12 +247,63 @@ static void *zstd_write_task(void *userdata)
     }
   }
 
-  ww->zstd.next_frame++;
+  MEM_freeN(block->data);
+  MEM_freeN(block);
+}
+
+static void *zstd_write_task(void *userdata)
+{
+  ZstdWriteBlockTask *task = userdata;
+  WriteWrap *ww = task->ww;
 
+  BLI_mutex_lock(&ww->zstd.mutex);
+  BLI_assert(ww->zstd.num_free_contexts > 0);
+  ZSTD_CCtx *ctx = ww->zstd.contexts[--ww->zstd.num_free_contexts];
   BLI_mutex_unlock(&ww->zstd.mutex);
-  BLI_condition_notify_all(&ww->zstd.condition);
 
-  MEM_freeN(out_buf);
+  ZstdCompressedBlock *block = MEM_mallocN(sizeof(ZstdCompressedBlock), "zstd block");
+  size_t out_buf_len = ZSTD_compressBound(task->size);
+  block->data = MEM_mallocN(out_buf_len, "Zstd out buffer");
+  block->size = ZSTD_compressCCtx(
+      ctx, block->data, out_buf_len, task->data, task->size, ZSTD_COMPRESSION_LEVEL);
+  block->uncompressed_size = task->size;
+  block->frame_number = task->frame_number;
+
+  MEM_freeN(task->data);
+  task->data = NULL;
+
+  BLI_mutex_lock(&ww->zstd.mutex);
+  ww->zstd.contexts[ww->zstd.num_free_contexts++] = ctx;
+
+  /* Keep the pending list sorted, blocks usually finish in order so search from the back. */
+  ZstdCompressedBlock *prev = ww->zstd.pending_blocks.last;
+  while (prev && prev->frame_number > block->frame_number) {
+    prev = prev->prev;
+  }
+  BLI_insertlinkafter(&ww->zstd.pending_blocks, prev, block);
+
+  /* Don't wait for earlier frames, whichever thread finishes the next frame in order writes out
+   * every consecutive block that is ready, so the worker can move on to the next block. The file
+   * is written outside of the lock, other threads only need it to queue their blocks. */
+  if (!ww->zstd.is_writing) {
+    ww->zstd.is_writing = true;
+    ZstdCompressedBlock *next;
+    while ((next = ww->zstd.pending_blocks.first) &&
+           next->frame_number == ww->zstd.next_frame) {
+      BLI_remlink(&ww->zstd.pending_blocks, next);
+      BLI_mutex_unlock(&ww->zstd.mutex);
+
+      zstd_write_compressed_block(ww, next);
+
+      BLI_mutex_lock(&ww->zstd.mutex);
+      ww->zstd.next_frame++;
+    }
+    ww->zstd.is_writing = false;
+  }
+
+  /* Only set once this thread is done writing, so that joining it never blocks. */
+  task->is_done = true;
+  BLI_mutex_unlock(&ww->zstd.mutex);
   return NULL;
 }
 
@@ -264,7 +317,12 @@ static bool ww_open_zstd(WriteWrap *ww, const char *filepath)
   int num_threads = max_ii(1, BLI_system_thread_count() - 1);
   BLI_threadpool_init(&ww->zstd.threadpool, zstd_write_task, num_threads);
   BLI_mutex_init(&ww->zstd.mutex);
-  BLI_condition_init(&ww->zstd.condition);
+
+  ww->zstd.contexts = MEM_mallocN(sizeof(*ww->zstd.contexts) * num_threads, __func__);
+  for (int i = 0; i < num_threads; i++) {
+    ww->zstd.contexts[i] = ZSTD_createCCtx();
+  }
+  ww->zstd.num_free_contexts = num_threads;
 
   return true;
 }
@@ -315,8 +373,15 @@ static bool ww_close_zstd(WriteWrap *ww)
   BLI_threadpool_end(&ww->zstd.threadpool);
   BLI_freelistN(&ww->zstd.tasks);
 
+  /* All frames are written in order once the last worker finished. */
+  BLI_assert(BLI_listbase_is_empty(&ww->zstd.pending_blocks));
+
   BLI_mutex_end(&ww->zstd.mutex);
-  BLI_condition_end(&ww->zstd.condition);
+
+  for (int i = 0; i < ww->zstd.num_free_contexts; i++) {
+    ZSTD_freeCCtx(ww->zstd.contexts[i]);
+  }
+  MEM_freeN(ww->zstd.contexts);
 
   zstd_write_seekable_frames(ww);
   BLI_freelistN(&ww->zstd.frames);
@@ -335,26 +400,37 @@ static size_t ww_write_zstd(WriteWrap *ww, const char *buf, size_t buf_len)
   memcpy(task->data, buf, buf_len);
   task->size = buf_len;
   task->frame_number = ww->zstd.num_frames++;
+  task->is_done = false;
   task->ww = ww;
 
-  BLI_mutex_lock(&ww->zstd.mutex);
-  BLI_addtail(&ww->zstd.tasks, task);
-
   /* If there's a free worker thread, just push the block into that thread.
-   * Otherwise, we wait for the earliest thread to finish.
-   * We look up the earliest thread while holding the mutex, but release it
-   * before joining the thread to prevent a deadlock. */
-  ZstdWriteBlockTask *first_task = ww->zstd.tasks.first;
-  BLI_mutex_unlock(&ww->zstd.mutex);
+   * Otherwise, join every thread that already finished compressing, those don't block.
+   * Only if none did, we wait for the earliest thread to finish.
+   * The task list is only modified by this thread, but the done flags are read while holding
+   * the mutex, which is released before joining threads to prevent a deadlock. */
   if (!BLI_available_threads(&ww->zstd.threadpool)) {
-    BLI_threadpool_remove(&ww->zstd.threadpool, first_task);
+    ListBase finished_tasks = {NULL, NULL};
+    BLI_mutex_lock(&ww->zstd.mutex);
+    LISTBASE_FOREACH_MUTABLE (ZstdWriteBlockTask *, other_task, &ww->zstd.tasks) {
+      if (other_task->is_done) {
+        BLI_remlink(&ww->zstd.tasks, other_task);
+        BLI_addtail(&finished_tasks, other_task);
+      }
+    }
+    BLI_mutex_unlock(&ww->zstd.mutex);
 
-    /* If the task list was empty before we pushed our task, there should
-     * always be a free thread. */
-    BLI_assert(first_task != task);
-    BLI_remlink(&ww->zstd.tasks, first_task);
-    MEM_freeN(first_task);
+    if (BLI_listbase_is_empty(&finished_tasks)) {
+      ZstdWriteBlockTask *first_task = ww->zstd.tasks.first;
+      BLI_remlink(&ww->zstd.tasks, first_task);
+      BLI_addtail(&finished_tasks, first_task);
+    }
+    LISTBASE_FOREACH_MUTABLE (ZstdWriteBlockTask *, finished_task, &finished_tasks) {
+      BLI_threadpool_remove(&ww->zstd.threadpool, finished_task);
+      MEM_freeN(finished_task);
+    }
   }
+
+  BLI_addtail(&ww->zstd.tasks, task);
   BLI_threadpool_insert(&ww->zstd.threadpool, task);
 
   return buf_len;
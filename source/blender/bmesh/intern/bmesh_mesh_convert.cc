@@ -83,6 +83,7 @@
 #include "BLI_listbase.h"
 #include "BLI_math_vector.h"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 
 #include "BKE_customdata.h"
 #include "BKE_mesh.h"
@@ -104,6 +105,7 @@ static CLG_LogRef LOG = {"bmesh.mesh.convert"};
 using blender::Array;
 using blender::IndexRange;
 using blender::Span;
+namespace threading = blender::threading;
 
 void BM_mesh_cd_flag_ensure(BMesh *bm, Mesh *mesh, const char cd_flag)
 {
@@ -355,6 +357,10 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *me, const struct BMeshFromMeshPar
                                            CustomData_get_offset(&bm->vdata, CD_SHAPE_KEYINDEX) :
                                            -1;
 
+  /* Elements are created and connected serially since that allocates from the pools and links
+   * the disk and radial cycles. Their custom-data blocks are allocated along the way, but filled
+   * in parallel afterwards. */
+
   Span<MVert> mvert{me->mvert, me->totvert};
   Array<BMVert *> vtable(me->totvert);
   for (const int i : mvert.index_range()) {
@@ -370,33 +376,41 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *me, const struct BMeshFromMeshPar
       BM_vert_select_set(bm, v, true);
     }
 
-    if (vert_normals) {
-      copy_v3_v3(v->no, vert_normals[i]);
-    }
+    CustomData_bmesh_alloc_block(&bm->vdata, &v->head.data);
+  }
+  if (is_new) {
+    bm->elem_index_dirty &= ~BM_VERT; /* Added in order, clear dirty flag. */
+  }
 
-    /* Copy Custom Data */
-    CustomData_to_bmesh_block(&me->vdata, &bm->vdata, i, &v->head.data, true);
+  threading::parallel_for(mvert.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      BMVert *v = vtable[i];
 
-    if (cd_vert_bweight_offset != -1) {
-      BM_ELEM_CD_SET_FLOAT(v, cd_vert_bweight_offset, (float)mvert[i].bweight / 255.0f);
-    }
+      if (vert_normals) {
+        copy_v3_v3(v->no, vert_normals[i]);
+      }
 
-    /* Set shape key original index. */
-    if (cd_shape_keyindex_offset != -1) {
-      BM_ELEM_CD_SET_INT(v, cd_shape_keyindex_offset, i);
-    }
+      /* Copy Custom Data */
+      CustomData_to_bmesh_block(&me->vdata, &bm->vdata, i, &v->head.data, true);
 
-    /* Set shape-key data. */
-    if (tot_shape_keys) {
-      float(*co_dst)[3] = (float(*)[3])BM_ELEM_CD_GET_VOID_P(v, cd_shape_key_offset);
-      for (int j = 0; j < tot_shape_keys; j++, co_dst++) {
-        copy_v3_v3(*co_dst, shape_key_table[j][i]);
+      if (cd_vert_bweight_offset != -1) {
+        BM_ELEM_CD_SET_FLOAT(v, cd_vert_bweight_offset, (float)mvert[i].bweight / 255.0f);
+      }
+
+      /* Set shape key original index. */
+      if (cd_shape_keyindex_offset != -1) {
+        BM_ELEM_CD_SET_INT(v, cd_shape_keyindex_offset, i);
+      }
+
+      /* Set shape-key data. */
+      if (tot_shape_keys) {
+        float(*co_dst)[3] = (float(*)[3])BM_ELEM_CD_GET_VOID_P(v, cd_shape_key_offset);
+        for (int j = 0; j < tot_shape_keys; j++, co_dst++) {
+          copy_v3_v3(*co_dst, shape_key_table[j][i]);
+        }
       }
     }
-  }
-  if (is_new) {
-    bm->elem_index_dirty &= ~BM_VERT; /* Added in order, clear dirty flag. */
-  }
+  });
 
   Span<MEdge> medge{me->medge, me->totedge};
   Array<BMEdge *> etable(me->totedge);
@@ -413,37 +427,37 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *me, const struct BMeshFromMeshPar
       BM_edge_select_set(bm, e, true);
     }
 
-    /* Copy Custom Data */
-    CustomData_to_bmesh_block(&me->edata, &bm->edata, i, &e->head.data, true);
-
-    if (cd_edge_bweight_offset != -1) {
-      BM_ELEM_CD_SET_FLOAT(e, cd_edge_bweight_offset, (float)medge[i].bweight / 255.0f);
-    }
-    if (cd_edge_crease_offset != -1) {
-      BM_ELEM_CD_SET_FLOAT(e, cd_edge_crease_offset, (float)medge[i].crease / 255.0f);
-    }
+    CustomData_bmesh_alloc_block(&bm->edata, &e->head.data);
   }
   if (is_new) {
     bm->elem_index_dirty &= ~BM_EDGE; /* Added in order, clear dirty flag. */
   }
 
+  threading::parallel_for(medge.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      BMEdge *e = etable[i];
+
+      /* Copy Custom Data */
+      CustomData_to_bmesh_block(&me->edata, &bm->edata, i, &e->head.data, true);
+
+      if (cd_edge_bweight_offset != -1) {
+        BM_ELEM_CD_SET_FLOAT(e, cd_edge_bweight_offset, (float)medge[i].bweight / 255.0f);
+      }
+      if (cd_edge_crease_offset != -1) {
+        BM_ELEM_CD_SET_FLOAT(e, cd_edge_crease_offset, (float)medge[i].crease / 255.0f);
+      }
+    }
+  });
+
   Span<MPoly> mpoly{me->mpoly, me->totpoly};
   Span<MLoop> mloop{me->mloop, me->totloop};
 
-  /* Only needed for selection. */
-
-  Array<BMFace *> ftable;
-  if (me->mselect && me->totselect != 0) {
-    ftable.reinitialize(me->totpoly);
-  }
+  Array<BMFace *> ftable(me->totpoly);
 
   int totloops = 0;
   for (const int i : mpoly.index_range()) {
-    BMFace *f = bm_face_create_from_mpoly(
+    BMFace *f = ftable[i] = bm_face_create_from_mpoly(
         *bm, mloop.slice(mpoly[i].loopstart, mpoly[i].totloop), vtable, etable);
-    if (!ftable.is_empty()) {
-      ftable[i] = f;
-    }
 
     if (UNLIKELY(f == nullptr)) {
       printf(
@@ -471,28 +485,45 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *me, const struct BMeshFromMeshPar
       bm->act_face = f;
     }
 
-    int j = mpoly[i].loopstart;
     BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
     BMLoop *l_iter = l_first;
     do {
-      /* Don't use 'j' since we may have skipped some faces, hence some loops. */
+      /* Don't use the #MLoop index since we may have skipped some faces, hence some loops. */
       BM_elem_index_set(l_iter, totloops++); /* set_ok */
 
-      /* Save index of corresponding #MLoop. */
-      CustomData_to_bmesh_block(&me->ldata, &bm->ldata, j++, &l_iter->head.data, true);
+      CustomData_bmesh_alloc_block(&bm->ldata, &l_iter->head.data);
     } while ((l_iter = l_iter->next) != l_first);
 
-    /* Copy Custom Data */
-    CustomData_to_bmesh_block(&me->pdata, &bm->pdata, i, &f->head.data, true);
-
-    if (params->calc_face_normal) {
-      BM_face_normal_update(f);
-    }
+    CustomData_bmesh_alloc_block(&bm->pdata, &f->head.data);
   }
   if (is_new) {
     bm->elem_index_dirty &= ~(BM_FACE | BM_LOOP); /* Added in order, clear dirty flag. */
   }
 
+  threading::parallel_for(mpoly.index_range(), 512, [&](const IndexRange range) {
+    for (const int i : range) {
+      BMFace *f = ftable[i];
+      if (f == nullptr) {
+        continue;
+      }
+
+      int j = mpoly[i].loopstart;
+      BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
+      BMLoop *l_iter = l_first;
+      do {
+        /* Save index of corresponding #MLoop. */
+        CustomData_to_bmesh_block(&me->ldata, &bm->ldata, j++, &l_iter->head.data, true);
+      } while ((l_iter = l_iter->next) != l_first);
+
+      /* Copy Custom Data */
+      CustomData_to_bmesh_block(&me->pdata, &bm->pdata, i, &f->head.data, true);
+
+      if (params->calc_face_normal) {
+        BM_face_normal_update(f);
+      }
+    }
+  });
+
   /* -------------------------------------------------------------------- */
   /* MSelect clears the array elements (to avoid adding multiple times).
    *
@@ -805,37 +836,40 @@ static void bm_to_mesh_shape(BMesh *bm,
       }
       currkey_data = (float(*)[3])currkey->data;
 
-      int i;
-      BM_ITER_MESH_INDEX (eve, &iter, bm, BM_VERTS_OF_MESH, i) {
-        float *co_orig = (float *)BM_ELEM_CD_GET_VOID_P(eve, cd_shape_offset);
-
-        if (currkey == actkey) {
-          copy_v3_v3(currkey_data[i], eve->co);
-
-          if (update_vertex_coords_from_refkey) {
-            BLI_assert(actkey != key->refkey);
-            keyi = BM_ELEM_CD_GET_INT(eve, cd_shape_keyindex_offset);
-            if (keyi != ORIGINDEX_NONE) {
-              float *co_refkey = (float *)BM_ELEM_CD_GET_VOID_P(eve, cd_shape_offset_refkey);
-              copy_v3_v3(mvert[i].co, co_refkey);
+      /* The vertex table is ensured by the caller. */
+      threading::parallel_for(IndexRange(bm->totvert), 2048, [&](const IndexRange range) {
+        for (const int i : range) {
+          BMVert *eve = bm->vtable[i];
+          float *co_orig = (float *)BM_ELEM_CD_GET_VOID_P(eve, cd_shape_offset);
+
+          if (currkey == actkey) {
+            copy_v3_v3(currkey_data[i], eve->co);
+
+            if (update_vertex_coords_from_refkey) {
+              BLI_assert(actkey != key->refkey);
+              const int keyi = BM_ELEM_CD_GET_INT(eve, cd_shape_keyindex_offset);
+              if (keyi != ORIGINDEX_NONE) {
+                float *co_refkey = (float *)BM_ELEM_CD_GET_VOID_P(eve, cd_shape_offset_refkey);
+                copy_v3_v3(mvert[i].co, co_refkey);
+              }
             }
           }
-        }
-        else {
-          copy_v3_v3(currkey_data[i], co_orig);
-        }
+          else {
+            copy_v3_v3(currkey_data[i], co_orig);
+          }
 
-        /* Propagate edited basis offsets to other shapes. */
-        if (apply_offset) {
-          add_v3_v3(currkey_data[i], ofs[i]);
-        }
+          /* Propagate edited basis offsets to other shapes. */
+          if (apply_offset) {
+            add_v3_v3(currkey_data[i], ofs[i]);
+          }
 
-        /* Apply back new coordinates shape-keys that have offset into #BMesh.
-         * Otherwise, in case we call again #BM_mesh_bm_to_me on same #BMesh,
-         * we'll apply diff from previous call to #BM_mesh_bm_to_me,
-         * to shape-key values from original creation of the #BMesh. See T50524. */
-        copy_v3_v3(co_orig, currkey_data[i]);
-      }
+          /* Apply back new coordinates shape-keys that have offset into #BMesh.
+           * Otherwise, in case we call again #BM_mesh_bm_to_me on same #BMesh,
+           * we'll apply diff from previous call to #BM_mesh_bm_to_me,
+           * to shape-key values from original creation of the #BMesh. See T50524. */
+          copy_v3_v3(co_orig, currkey_data[i]);
+        }
+      });
     }
     else {
       /* No original layer data, use fallback information. */
@@ -907,10 +941,7 @@ BLI_INLINE void bmesh_quick_edgedraw_flag(MEdge *med, BMEdge *e)
 
 void BM_mesh_bm_to_me(Main *bmain, BMesh *bm, Mesh *me, const struct BMeshToMeshParams *params)
 {
-  MEdge *med;
-  BMVert *v, *eve;
-  BMEdge *e;
-  BMFace *f;
+  BMVert *eve;
   BMIter iter;
   int i, j;
 
@@ -970,90 +1001,105 @@ void BM_mesh_bm_to_me(Main *bmain, BMesh *bm, Mesh *me, const struct BMeshToMesh
   /* This is called again, 'dotess' arg is used there. */
   BKE_mesh_update_customdata_pointers(me, false);
 
-  i = 0;
-  BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
-    copy_v3_v3(mvert->co, v->co);
+  /* The elements are written in parallel, through the element tables which have the same order
+   * as iterating over the elements. */
+  BM_mesh_elem_table_ensure(bm, BM_VERT | BM_EDGE | BM_FACE);
 
-    mvert->flag = BM_vert_flag_to_mflag(v);
+  threading::parallel_for(IndexRange(bm->totvert), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      BMVert *v = bm->vtable[i];
+      MVert *mv = &mvert[i];
+      copy_v3_v3(mv->co, v->co);
 
-    BM_elem_index_set(v, i); /* set_inline */
+      mv->flag = BM_vert_flag_to_mflag(v);
 
-    /* Copy over custom-data. */
-    CustomData_from_bmesh_block(&bm->vdata, &me->vdata, v->head.data, i);
+      BM_elem_index_set(v, i); /* set_inline */
 
-    if (cd_vert_bweight_offset != -1) {
-      mvert->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(v, cd_vert_bweight_offset);
-    }
+      /* Copy over custom-data. */
+      CustomData_from_bmesh_block(&bm->vdata, &me->vdata, v->head.data, i);
 
-    i++;
-    mvert++;
+      if (cd_vert_bweight_offset != -1) {
+        mv->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(v, cd_vert_bweight_offset);
+      }
 
-    BM_CHECK_ELEMENT(v);
-  }
+      BM_CHECK_ELEMENT(v);
+    }
+  });
   bm->elem_index_dirty &= ~BM_VERT;
 
-  med = medge;
-  i = 0;
-  BM_ITER_MESH (e, &iter, bm, BM_EDGES_OF_MESH) {
-    med->v1 = BM_elem_index_get(e->v1);
-    med->v2 = BM_elem_index_get(e->v2);
+  threading::parallel_for(IndexRange(bm->totedge), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      BMEdge *e = bm->etable[i];
+      MEdge *med = &medge[i];
+      med->v1 = BM_elem_index_get(e->v1);
+      med->v2 = BM_elem_index_get(e->v2);
 
-    med->flag = BM_edge_flag_to_mflag(e);
+      med->flag = BM_edge_flag_to_mflag(e);
 
-    BM_elem_index_set(e, i); /* set_inline */
+      BM_elem_index_set(e, i); /* set_inline */
 
-    /* Copy over custom-data. */
-    CustomData_from_bmesh_block(&bm->edata, &me->edata, e->head.data, i);
+      /* Copy over custom-data. */
+      CustomData_from_bmesh_block(&bm->edata, &me->edata, e->head.data, i);
 
-    bmesh_quick_edgedraw_flag(med, e);
+      bmesh_quick_edgedraw_flag(med, e);
 
-    if (cd_edge_crease_offset != -1) {
-      med->crease = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(e, cd_edge_crease_offset);
-    }
-    if (cd_edge_bweight_offset != -1) {
-      med->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(e, cd_edge_bweight_offset);
-    }
+      if (cd_edge_crease_offset != -1) {
+        med->crease = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(e, cd_edge_crease_offset);
+      }
+      if (cd_edge_bweight_offset != -1) {
+        med->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(e, cd_edge_bweight_offset);
+      }
 
-    i++;
-    med++;
-    BM_CHECK_ELEMENT(e);
-  }
+      BM_CHECK_ELEMENT(e);
+    }
+  });
   bm->elem_index_dirty &= ~BM_EDGE;
 
-  i = 0;
+  Array<int> loopstarts(bm->totface);
   j = 0;
-  BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
-    BMLoop *l_iter, *l_first;
-    mpoly->loopstart = j;
-    mpoly->totloop = f->len;
-    mpoly->mat_nr = f->mat_nr;
-    mpoly->flag = BM_face_flag_to_mflag(f);
-
-    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
-    do {
-      mloop->e = BM_elem_index_get(l_iter->e);
-      mloop->v = BM_elem_index_get(l_iter->v);
+  for (i = 0; i < bm->totface; i++) {
+    loopstarts[i] = j;
+    j += bm->ftable[i]->len;
+  }
 
-      /* Copy over custom-data. */
-      CustomData_from_bmesh_block(&bm->ldata, &me->ldata, l_iter->head.data, j);
+  threading::parallel_for(IndexRange(bm->totface), 512, [&](const IndexRange range) {
+    for (const int i : range) {
+      BMFace *f = bm->ftable[i];
+      MPoly *mp = &mpoly[i];
+      mp->loopstart = loopstarts[i];
+      mp->totloop = f->len;
+      mp->mat_nr = f->mat_nr;
+      mp->flag = BM_face_flag_to_mflag(f);
+
+      int loop_i = mp->loopstart;
+      BMLoop *l_iter, *l_first;
+      l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+      do {
+        MLoop *ml = &mloop[loop_i];
+        ml->e = BM_elem_index_get(l_iter->e);
+        ml->v = BM_elem_index_get(l_iter->v);
+
+        /* Copy over custom-data. */
+        CustomData_from_bmesh_block(&bm->ldata, &me->ldata, l_iter->head.data, loop_i);
+
+        loop_i++;
+        BM_CHECK_ELEMENT(l_iter);
+        BM_CHECK_ELEMENT(l_iter->e);
+        BM_CHECK_ELEMENT(l_iter->v);
+      } while ((l_iter = l_iter->next) != l_first);
+
+      BM_elem_index_set(f, i); /* set_inline */
 
-      j++;
-      mloop++;
-      BM_CHECK_ELEMENT(l_iter);
-      BM_CHECK_ELEMENT(l_iter->e);
-      BM_CHECK_ELEMENT(l_iter->v);
-    } while ((l_iter = l_iter->next) != l_first);
+      /* Copy over custom-data. */
+      CustomData_from_bmesh_block(&bm->pdata, &me->pdata, f->head.data, i);
 
-    if (f == bm->act_face) {
-      me->act_face = i;
+      BM_CHECK_ELEMENT(f);
     }
+  });
+  bm->elem_index_dirty &= ~BM_FACE;
 
-    /* Copy over custom-data. */
-    CustomData_from_bmesh_block(&bm->pdata, &me->pdata, f->head.data, i);
-
-    i++;
-    mpoly++;
-    BM_CHECK_ELEMENT(f);
+  if (bm->act_face) {
+    me->act_face = BM_elem_index_get(bm->act_face);
   }
 
   /* Patch hook indices and vertex parents. */
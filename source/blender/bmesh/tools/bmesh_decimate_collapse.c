@@ -18,6 +18,7 @@
 #include "BLI_polyfill_2d.h"
 #include "BLI_polyfill_2d_beautify.h"
 #include "BLI_quadric.h"
+#include "BLI_task.h"
 #include "BLI_utildefines_stack.h"
 
 #include "BKE_customdata.h"
@@ -222,18 +223,23 @@ static float bm_decim_build_edge_cost_single__topology(BMEdge *e)
 
 #endif /* USE_TOPOLOGY_FALLBACK */
 
-static void bm_decim_build_edge_cost_single(BMEdge *e,
-                                            const Quadric *vquadrics,
-                                            const float *vweights,
-                                            const float vweight_factor,
-                                            Heap *eheap,
-                                            HeapNode **eheap_table)
+/**
+ * Calculate the collapse cost of \a e.
+ * Only reads mesh data, so it can run in parallel for different edges.
+ *
+ * \return false when the edge must not be collapsed.
+ */
+static bool bm_decim_calc_edge_cost(BMEdge *e,
+                                    const Quadric *vquadrics,
+                                    const float *vweights,
+                                    const float vweight_factor,
+                                    float *r_cost)
 {
   float cost;
 
   if (UNLIKELY(vweights && ((vweights[BM_elem_index_get(e->v1)] == 0.0f) ||
                             (vweights[BM_elem_index_get(e->v2)] == 0.0f)))) {
-    goto clear;
+    return false;
   }
 
   /* check we can collapse, some edges we better not touch */
@@ -243,7 +249,7 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
     else {
       /* only collapse tri's */
-      goto clear;
+      return false;
     }
   }
   else if (BM_edge_is_manifold(e)) {
@@ -252,11 +258,11 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
     else {
       /* only collapse tri's */
-      goto clear;
+      return false;
     }
   }
   else {
-    goto clear;
+    return false;
   }
   /* end sanity check */
 
@@ -308,10 +314,24 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
   }
 
-  BLI_heap_insert_or_update(eheap, &eheap_table[BM_elem_index_get(e)], cost, e);
-  return;
+  *r_cost = cost;
+  return true;
+}
+
+static void bm_decim_build_edge_cost_single(BMEdge *e,
+                                            const Quadric *vquadrics,
+                                            const float *vweights,
+                                            const float vweight_factor,
+                                            Heap *eheap,
+                                            HeapNode **eheap_table)
+{
+  float cost;
+
+  if (bm_decim_calc_edge_cost(e, vquadrics, vweights, vweight_factor, &cost)) {
+    BLI_heap_insert_or_update(eheap, &eheap_table[BM_elem_index_get(e)], cost, e);
+    return;
+  }
 
-clear:
   if (eheap_table[BM_elem_index_get(e)]) {
     BLI_heap_remove(eheap, eheap_table[BM_elem_index_get(e)]);
   }
@@ -326,6 +346,25 @@ static void bm_decim_invalid_edge_cost_single(BMEdge *e, Heap *eheap, HeapNode *
   eheap_table[BM_elem_index_get(e)] = BLI_heap_insert(eheap, COST_INVALID, e);
 }
 
+typedef struct EdgeCostData {
+  const Quadric *vquadrics;
+  const float *vweights;
+  float vweight_factor;
+  float *edge_costs;
+  bool *edge_use;
+} EdgeCostData;
+
+static void bm_decim_calc_edge_cost_cb(void *__restrict userdata,
+                                       MempoolIterData *mp_e,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  EdgeCostData *data = userdata;
+  BMEdge *e = (BMEdge *)mp_e;
+  const int i = BM_elem_index_get(e);
+  data->edge_use[i] = bm_decim_calc_edge_cost(
+      e, data->vquadrics, data->vweights, data->vweight_factor, &data->edge_costs[i]);
+}
+
 static void bm_decim_build_edge_cost(BMesh *bm,
                                      const Quadric *vquadrics,
                                      const float *vweights,
@@ -337,11 +376,28 @@ static void bm_decim_build_edge_cost(BMesh *bm,
   BMEdge *e;
   uint i;
 
+  /* Optimizing the quadric of every edge is the expensive part, do that in parallel and fill
+   * the heap afterwards, in the same order as when calculating the costs one by one. */
+  EdgeCostData data = {
+      .vquadrics = vquadrics,
+      .vweights = vweights,
+      .vweight_factor = vweight_factor,
+      .edge_costs = MEM_malloc_arrayN(bm->totedge, sizeof(float), __func__),
+      .edge_use = MEM_malloc_arrayN(bm->totedge, sizeof(bool), __func__),
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_mempool_settings_defaults(&settings);
+  settings.use_threading = bm->totedge >= BM_OMP_LIMIT;
+  BM_iter_parallel(bm, BM_EDGES_OF_MESH, bm_decim_calc_edge_cost_cb, &data, &settings);
+
   BM_ITER_MESH_INDEX (e, &iter, bm, BM_EDGES_OF_MESH, i) {
-    /* keep sanity check happy */
-    eheap_table[i] = NULL;
-    bm_decim_build_edge_cost_single(e, vquadrics, vweights, vweight_factor, eheap, eheap_table);
+    BLI_assert(BM_elem_index_get(e) == (int)i);
+    eheap_table[i] = data.edge_use[i] ? BLI_heap_insert(eheap, data.edge_costs[i], e) : NULL;
   }
+
+  MEM_freeN(data.edge_costs);
+  MEM_freeN(data.edge_use);
 }
 
 #ifdef USE_SYMMETRY
@@ -348,8 +348,9 @@ void COM_deinitialize(void);
 /**
  * \brief Clear all compositor caches. (Compositor system will still remain available).
  * To deinitialize the compositor use the COM_deinitialize method.
+ * Caches are freed on next execution, so this can be called while compositing.
  */
-// void COM_clear_caches(void); // NOT YET WRITTEN
+void COM_clear_caches(void);
 
 #ifdef __cplusplus
 }
@@ -6,6 +6,7 @@
 #include "BLT_translation.h"
 
 #include "COM_Debug.h"
+#include "COM_OperationCache.h"
 #include "COM_ViewerOperation.h"
 #include "COM_WorkScheduler.h"
 
@@ -27,6 +28,9 @@ FullFrameExecutionModel::FullFrameExecutionModel(CompositorContext &context,
     priorities_.append(eCompositorPriority::Medium);
     priorities_.append(eCompositorPriority::Low);
   }
+
+  const bNodeTree *node_tree = context.get_bnodetree();
+  use_cache_ = (node_tree->flag & NTREE_COM_USE_CACHE) && !context.is_rendering();
 }
 
 void FullFrameExecutionModel::execute(ExecutionSystem &exec_system)
@@ -36,8 +40,20 @@ void FullFrameExecutionModel::execute(ExecutionSystem &exec_system)
 
   DebugInfo::graphviz(&exec_system, "compositor_prior_rendering");
 
+  if (use_cache_) {
+    OperationCache::execution_started();
+  }
+  else if (!context_.is_rendering()) {
+    /* Free cached results when caching gets disabled. */
+    OperationCache::clear();
+  }
+
   determine_areas_to_render_and_reads();
   render_operations();
+
+  if (use_cache_) {
+    OperationCache::execution_finished();
+  }
 }
 
 void FullFrameExecutionModel::determine_areas_to_render_and_reads()
@@ -45,17 +61,56 @@ void FullFrameExecutionModel::determine_areas_to_render_and_reads()
   const bool is_rendering = context_.is_rendering();
   const bNodeTree *node_tree = context_.get_bnodetree();
 
-  rcti area;
+  Vector<NodeOperation *> output_ops;
   for (eCompositorPriority priority : priorities_) {
     for (NodeOperation *op : operations_) {
       op->set_bnodetree(node_tree);
       if (op->is_output_operation(is_rendering) && op->get_render_priority() == priority) {
-        get_output_render_area(op, area);
-        determine_areas_to_render(op, area);
-        determine_reads(op);
+        output_ops.append(op);
       }
     }
   }
+
+  rcti area;
+  for (NodeOperation *op : output_ops) {
+    get_output_render_area(op, area);
+    determine_areas_to_render(op, area);
+  }
+
+  /* Reads depend on which operations are reused from the cache. */
+  if (use_cache_) {
+    determine_cached_operations();
+  }
+
+  for (NodeOperation *op : output_ops) {
+    determine_reads(op);
+  }
+}
+
+void FullFrameExecutionModel::determine_cached_operations()
+{
+  Map<NodeOperation *, std::optional<uint64_t>> keys;
+  for (NodeOperation *op : operations_) {
+    if (!op->get_flags().can_be_cached || op->get_width() == 0 || op->get_height() == 0) {
+      continue;
+    }
+
+    const Vector<rcti> areas = active_buffers_.get_areas_to_render(
+        op, -op->get_canvas().xmin, -op->get_canvas().ymin);
+    if (areas.is_empty()) {
+      continue;
+    }
+
+    const std::optional<uint64_t> key = OperationCache::generate_key(op, context_, keys);
+    if (!key) {
+      continue;
+    }
+    cache_keys_.add_new(op, *key);
+
+    if (MemoryBuffer *cached_buffer = OperationCache::get_buffer(*key, areas)) {
+      cached_buffers_.add_new(op, cached_buffer);
+    }
+  }
 }
 
 Vector<MemoryBuffer *> FullFrameExecutionModel::get_input_buffers(NodeOperation *op,
@@ -91,8 +146,29 @@ MemoryBuffer *FullFrameExecutionModel::create_operation_buffer(NodeOperation *op
   return new MemoryBuffer(data_type, rect, is_a_single_elem);
 }
 
+void FullFrameExecutionModel::render_cached_operation(NodeOperation *op,
+                                                      MemoryBuffer *cached_buffer)
+{
+  /* Cached buffer stays owned by the cache, share its data. */
+  active_buffers_.set_rendered_buffer(
+      op,
+      std::make_unique<MemoryBuffer>(cached_buffer->get_buffer(),
+                                     cached_buffer->get_num_channels(),
+                                     cached_buffer->get_rect(),
+                                     cached_buffer->is_a_single_elem()));
+
+  /* Inputs are not rendered, so there are no reads to report. */
+  num_operations_finished_++;
+  update_progress_bar();
+}
+
 void FullFrameExecutionModel::render_operation(NodeOperation *op)
 {
+  if (MemoryBuffer *cached_buffer = cached_buffers_.lookup_default(op, nullptr)) {
+    render_cached_operation(op, cached_buffer);
+    return;
+  }
+
   /* Output has no offset for easier image algorithms implementation on operations. */
   constexpr int output_x = 0;
   constexpr int output_y = 0;
@@ -110,6 +186,17 @@ void FullFrameExecutionModel::render_operation(NodeOperation *op)
     for (MemoryBuffer *buf : input_bufs) {
       delete buf;
     }
+
+    const uint64_t *cache_key = cache_keys_.lookup_ptr(op);
+    if (cache_key && !is_breaked()) {
+      /* Move buffer to the cache and share its data for this execution. */
+      MemoryBuffer *cached_buffer = OperationCache::set_buffer(
+          *cache_key, std::unique_ptr<MemoryBuffer>(op_buf), areas);
+      op_buf = new MemoryBuffer(cached_buffer->get_buffer(),
+                                cached_buffer->get_num_channels(),
+                                cached_buffer->get_rect(),
+                                cached_buffer->is_a_single_elem());
+    }
   }
   /* Even if operation has no resolution set the empty buffer. It will be clipped with a
    * TranslateOperation from convert resolutions if linked to an operation with resolution. */
@@ -144,7 +231,8 @@ void FullFrameExecutionModel::render_operations()
  * Returns all dependencies from inputs to outputs. A dependency may be repeated when
  * several operations depend on it.
  */
-static Vector<NodeOperation *> get_operation_dependencies(NodeOperation *operation)
+static Vector<NodeOperation *> get_operation_dependencies(
+    NodeOperation *operation, const Map<NodeOperation *, MemoryBuffer *> &cached_buffers)
 {
   /* Get dependencies from outputs to inputs. */
   Vector<NodeOperation *> dependencies;
@@ -154,6 +242,10 @@ static Vector<NodeOperation *> get_operation_dependencies(NodeOperation *operati
     Vector<NodeOperation *> outputs(next_outputs);
     next_outputs.clear();
     for (NodeOperation *output : outputs) {
+      /* Cached operations don't need their inputs. */
+      if (cached_buffers.contains(output)) {
+        continue;
+      }
       for (int i = 0; i < output->get_number_of_input_sockets(); i++) {
         next_outputs.append(output->get_input_operation(i));
       }
@@ -170,7 +262,7 @@ static Vector<NodeOperation *> get_operation_dependencies(NodeOperation *operati
 void FullFrameExecutionModel::render_output_dependencies(NodeOperation *output_op)
 {
   BLI_assert(output_op->is_output_operation(context_.is_rendering()));
-  Vector<NodeOperation *> dependencies = get_operation_dependencies(output_op);
+  Vector<NodeOperation *> dependencies = get_operation_dependencies(output_op, cached_buffers_);
   for (NodeOperation *op : dependencies) {
     if (!active_buffers_.is_operation_rendered(op)) {
       render_operation(op);
@@ -218,6 +310,9 @@ void FullFrameExecutionModel::determine_reads(NodeOperation *output_op)
   stack.append(output_op);
   while (stack.size() > 0) {
     NodeOperation *operation = stack.pop_last();
+    if (cached_buffers_.contains(operation)) {
+      continue;
+    }
     const int num_inputs = operation->get_number_of_input_sockets();
     for (int i = 0; i < num_inputs; i++) {
       NodeOperation *input_op = operation->get_input_operation(i);
@@ -267,6 +362,12 @@ void FullFrameExecutionModel::operation_finished(NodeOperation *operation)
   update_progress_bar();
 }
 
+bool FullFrameExecutionModel::is_breaked() const
+{
+  const bNodeTree *tree = context_.get_bnodetree();
+  return tree->test_break && tree->test_break(tree->tbh);
+}
+
 void FullFrameExecutionModel::update_progress_bar()
 {
   const bNodeTree *tree = context_.get_bnodetree();
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "BLI_map.hh"
+#include "BLI_set.hh"
 #include "BLI_vector.hh"
 
 #include "COM_Enums.h"
@@ -42,6 +44,21 @@ class FullFrameExecutionModel : public ExecutionModel {
    */
   Vector<eCompositorPriority> priorities_;
 
+  /**
+   * Whether results of expensive operations are kept between executions.
+   */
+  bool use_cache_;
+
+  /**
+   * Keys of operations whose results are stored in the #OperationCache.
+   */
+  Map<NodeOperation *, uint64_t> cache_keys_;
+
+  /**
+   * Operations whose buffer is reused from the #OperationCache. Their inputs are not rendered.
+   */
+  Map<NodeOperation *, MemoryBuffer *> cached_buffers_;
+
  public:
   FullFrameExecutionModel(CompositorContext &context,
                           SharedOperationBuffers &shared_buffers,
@@ -51,6 +68,11 @@ class FullFrameExecutionModel : public ExecutionModel {
 
  private:
   void determine_areas_to_render_and_reads();
+  /**
+   * Generates cache keys of the operations that can be cached and looks up the ones that can be
+   * reused from previous executions. Requires areas to render to be determined.
+   */
+  void determine_cached_operations();
   /**
    * Render output operations in order of priority.
    */
@@ -63,6 +85,7 @@ class FullFrameExecutionModel : public ExecutionModel {
   Vector<MemoryBuffer *> get_input_buffers(NodeOperation *op, int output_x, int output_y);
   MemoryBuffer *create_operation_buffer(NodeOperation *op, int output_x, int output_y);
   void render_operation(NodeOperation *op);
+  void render_cached_operation(NodeOperation *op, MemoryBuffer *cached_buffer);
 
   void operation_finished(NodeOperation *operation);
 
@@ -81,6 +104,11 @@ class FullFrameExecutionModel : public ExecutionModel {
    */
   void determine_reads(NodeOperation *output_op);
 
+  /**
+   * Whether execution has been canceled, partially rendered buffers must not be cached.
+   */
+  bool is_breaked() const;
+
   void update_progress_bar();
 
 #ifdef WITH_CXX_GUARDEDALLOC
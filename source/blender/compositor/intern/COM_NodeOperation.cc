@@ -20,6 +20,7 @@ NodeOperation::NodeOperation()
   canvas_input_index_ = 0;
   canvas_ = COM_AREA_NONE;
   btree_ = nullptr;
+  bnode_ = nullptr;
 }
 
 float NodeOperation::get_constant_value_default(float default_value)
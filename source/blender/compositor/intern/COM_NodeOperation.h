@@ -237,6 +237,12 @@ struct NodeOperationFlags {
    */
   bool can_be_constant : 1;
 
+  /**
+   * Whether operation is expensive enough for its result to be kept between executions, when the
+   * node tree uses the result cache. Only used by the full frame execution model.
+   */
+  bool can_be_cached : 1;
+
   NodeOperationFlags()
   {
     complex = false;
@@ -255,6 +261,7 @@ struct NodeOperationFlags {
     is_fullframe_operation = false;
     is_constant_operation = false;
     can_be_constant = false;
+    can_be_cached = false;
   }
 };
 
@@ -274,6 +281,11 @@ struct NodeOperationHash {
     return operation_;
   }
 
+  size_t get_params_hash() const
+  {
+    return params_hash_;
+  }
+
   bool operator==(const NodeOperationHash &other) const
   {
     return type_hash_ == other.type_hash_ && parents_hash_ == other.parents_hash_ &&
@@ -333,6 +345,11 @@ class NodeOperation {
    */
   const bNodeTree *btree_;
 
+  /**
+   * \brief Node this operation was converted from, null for operations added by the compositor.
+   */
+  const bNode *bnode_;
+
  protected:
   /**
    * Compositor execution model.
@@ -435,6 +452,16 @@ class NodeOperation {
     btree_ = tree;
   }
 
+  void set_bnode(const bNode *node)
+  {
+    bnode_ = node;
+  }
+
+  const bNode *get_bnode() const
+  {
+    return bnode_;
+  }
+
   void set_execution_system(ExecutionSystem *system)
   {
     exec_system_ = system;
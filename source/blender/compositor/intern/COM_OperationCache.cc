@@ -0,0 +1,235 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. */
+
+#include <atomic>
+#include <typeinfo>
+
+#include "BLI_ghash.h"
+#include "BLI_hash.hh"
+#include "BLI_hash_mm2a.h"
+#include "BLI_listbase.h"
+#include "BLI_vector.hh"
+
+#include "DNA_ID.h"
+
+#include "DEG_depsgraph_query.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "COM_CompositorContext.h"
+#include "COM_ConstantOperation.h"
+#include "COM_MemoryBuffer.h"
+#include "COM_NodeOperation.h"
+#include "COM_OperationCache.h"
+
+namespace blender::compositor {
+
+struct CacheEntry {
+  std::unique_ptr<MemoryBuffer> buffer;
+  Vector<rcti> areas;
+  /** Last execution the entry was used by. */
+  int last_used;
+};
+
+static struct {
+  Map<uint64_t, CacheEntry> entries;
+  int execution = 0;
+  std::atomic<bool> needs_clear = false;
+} g_cache;
+
+static void combine_hash(uint64_t &combined, const uint64_t other)
+{
+  combined = BLI_ghashutil_combine_hash(combined, other);
+}
+
+/** Hash of a guarded allocation, like node storage and socket values. */
+static uint64_t hash_allocation(const void *data)
+{
+  if (data == nullptr) {
+    return 0;
+  }
+  return BLI_hash_mm2(static_cast<const unsigned char *>(data), MEM_allocN_len(data), 0);
+}
+
+/**
+ * Hash a referenced ID. Changes to ID data are not visible in the node, so only IDs whose changes
+ * are accounted for are supported. Render results are invalidated with #COM_clear_caches after
+ * rendering. Pointers to evaluated IDs change every execution, hash the original ones.
+ */
+static std::optional<uint64_t> hash_id(const ID *id)
+{
+  if (id == nullptr) {
+    return 0;
+  }
+  if (!ELEM(GS(id->name), ID_SCE, ID_IM)) {
+    return std::nullopt;
+  }
+  return get_default_hash(DEG_get_original_id(const_cast<ID *>(id)));
+}
+
+static std::optional<uint64_t> hash_node(const bNode &node)
+{
+  const std::optional<uint64_t> id_hash = hash_id(node.id);
+  if (!id_hash) {
+    return std::nullopt;
+  }
+
+  uint64_t hash = get_default_hash_3(node.type, node.custom1, node.custom2);
+  combine_hash(hash, *id_hash);
+  combine_hash(hash, get_default_hash_2(node.custom3, node.custom4));
+  combine_hash(hash, hash_allocation(node.storage));
+  LISTBASE_FOREACH (const bNodeSocket *, socket, &node.inputs) {
+    combine_hash(hash, hash_allocation(socket->default_value));
+  }
+  return hash;
+}
+
+static uint64_t hash_context(const CompositorContext &context)
+{
+  uint64_t hash = get_default_hash_3(
+      context.get_framenumber(), context.get_quality(), context.is_fast_calculation());
+  combine_hash(hash, get_default_hash(context.get_render_percentage_as_factor()));
+  combine_hash(hash, get_default_hash(StringRef(context.get_view_name())));
+  return hash;
+}
+
+static std::optional<uint64_t> generate_operation_key(
+    NodeOperation *operation,
+    const CompositorContext &context,
+    Map<NodeOperation *, std::optional<uint64_t>> &r_keys)
+{
+  const rcti &canvas = operation->get_canvas();
+  uint64_t key = get_default_hash_4(canvas.xmin, canvas.xmax, canvas.ymin, canvas.ymax);
+  combine_hash(key, typeid(*operation).hash_code());
+  combine_hash(key, hash_context(context));
+
+  if (operation->get_number_of_output_sockets() > 0) {
+    const DataType data_type = operation->get_output_socket()->get_data_type();
+    combine_hash(key, get_default_hash(data_type));
+
+    if (operation->get_flags().is_constant_operation) {
+      const float *elem = static_cast<ConstantOperation *>(operation)->get_constant_elem();
+      for (const int i : IndexRange(COM_data_type_num_channels(data_type))) {
+        combine_hash(key, get_default_hash(elem[i]));
+      }
+      return key;
+    }
+  }
+
+  if (const bNode *node = operation->get_bnode()) {
+    const std::optional<uint64_t> node_hash = hash_node(*node);
+    if (!node_hash) {
+      return std::nullopt;
+    }
+    combine_hash(key, *node_hash);
+  }
+
+  /* Parameters not set from node settings, only available for some operations. */
+  if (const std::optional<NodeOperationHash> operation_hash = operation->generate_hash()) {
+    combine_hash(key, operation_hash->get_params_hash());
+  }
+
+  for (const int i : IndexRange(operation->get_number_of_input_sockets())) {
+    NodeOperation *input = operation->get_input_operation(i);
+    if (input == nullptr) {
+      combine_hash(key, 0);
+      continue;
+    }
+
+    const std::optional<uint64_t> input_key = OperationCache::generate_key(input, context, r_keys);
+    if (!input_key) {
+      return std::nullopt;
+    }
+    combine_hash(key, *input_key);
+  }
+
+  return key;
+}
+
+std::optional<uint64_t> OperationCache::generate_key(
+    NodeOperation *operation,
+    const CompositorContext &context,
+    Map<NodeOperation *, std::optional<uint64_t>> &r_keys)
+{
+  if (const std::optional<uint64_t> *key = r_keys.lookup_ptr(operation)) {
+    return *key;
+  }
+
+  const std::optional<uint64_t> key = generate_operation_key(operation, context, r_keys);
+  r_keys.add_new(operation, key);
+  return key;
+}
+
+static bool is_area_cached(const CacheEntry &entry, const rcti &area)
+{
+  for (const rcti &cached_area : entry.areas) {
+    if (BLI_rcti_inside_rcti(&cached_area, &area)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+MemoryBuffer *OperationCache::get_buffer(const uint64_t key, Span<rcti> areas)
+{
+  CacheEntry *entry = g_cache.entries.lookup_ptr(key);
+  if (entry == nullptr) {
+    return nullptr;
+  }
+
+  for (const rcti &area : areas) {
+    if (!is_area_cached(*entry, area)) {
+      return nullptr;
+    }
+  }
+
+  entry->last_used = g_cache.execution;
+  return entry->buffer.get();
+}
+
+MemoryBuffer *OperationCache::set_buffer(const uint64_t key,
+                                         std::unique_ptr<MemoryBuffer> buffer,
+                                         Span<rcti> areas)
+{
+  CacheEntry entry;
+  entry.buffer = std::move(buffer);
+  entry.areas = areas;
+  entry.last_used = g_cache.execution;
+
+  MemoryBuffer *cached_buffer = entry.buffer.get();
+  g_cache.entries.add_overwrite(key, std::move(entry));
+  return cached_buffer;
+}
+
+void OperationCache::execution_started()
+{
+  if (g_cache.needs_clear.exchange(false)) {
+    clear();
+  }
+  g_cache.execution++;
+}
+
+void OperationCache::execution_finished()
+{
+  Vector<uint64_t> unused_keys;
+  for (const auto item : g_cache.entries.items()) {
+    if (item.value.last_used < g_cache.execution - 1) {
+      unused_keys.append(item.key);
+    }
+  }
+  for (const uint64_t key : unused_keys) {
+    g_cache.entries.remove(key);
+  }
+}
+
+void OperationCache::clear()
+{
+  g_cache.entries.clear();
+}
+
+void OperationCache::tag_clear()
+{
+  g_cache.needs_clear = true;
+}
+
+}  // namespace blender::compositor
@@ -0,0 +1,70 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. */
+
+#pragma once
+
+#include <memory>
+#include <optional>
+
+#include "BLI_map.hh"
+#include "BLI_span.hh"
+
+#include "DNA_vec_types.h"
+
+#ifdef WITH_CXX_GUARDEDALLOC
+#  include "MEM_guardedalloc.h"
+#endif
+
+namespace blender::compositor {
+
+class CompositorContext;
+class MemoryBuffer;
+class NodeOperation;
+
+/**
+ * Keeps rendered buffers of expensive operations between compositor executions, keyed on a hash
+ * of the operation and everything upstream of it. Only accessed during executions, which are
+ * serialized by the compositor.
+ */
+struct OperationCache {
+  /**
+   * Generate a key identifying the operation result across executions, or `std::nullopt` when
+   * the result depends on data whose changes can't be detected.
+   * \param r_keys: Keys of already visited operations, shared between calls of one execution.
+   */
+  static std::optional<uint64_t> generate_key(
+      NodeOperation *operation,
+      const CompositorContext &context,
+      Map<NodeOperation *, std::optional<uint64_t>> &r_keys);
+
+  /**
+   * Get the cached buffer for given key if it has been rendered for all given areas, otherwise
+   * null. The buffer remains owned by the cache.
+   */
+  static MemoryBuffer *get_buffer(uint64_t key, Span<rcti> areas);
+
+  /**
+   * Store a rendered buffer with the areas rendered in it, replacing any previous buffer stored
+   * for the same key.
+   */
+  static MemoryBuffer *set_buffer(uint64_t key,
+                                  std::unique_ptr<MemoryBuffer> buffer,
+                                  Span<rcti> areas);
+
+  /** Start an execution. Frees all buffers if a clear was requested. */
+  static void execution_started();
+
+  /**
+   * Finish an execution, freeing buffers not used by the last two executions. The buffers of
+   * both passes of two pass compositing are kept this way.
+   */
+  static void execution_finished();
+
+  /** Free all cached buffers. */
+  static void clear();
+
+  /** Request freeing all cached buffers on next execution. Can be called from any thread. */
+  static void tag_clear();
+};
+
+}  // namespace blender::compositor
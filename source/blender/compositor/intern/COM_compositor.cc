@@ -9,6 +9,7 @@
 #include "BKE_scene.h"
 
 #include "COM_ExecutionSystem.h"
+#include "COM_OperationCache.h"
 #include "COM_WorkScheduler.h"
 #include "COM_compositor.h"
 
@@ -103,10 +104,16 @@ void COM_execute(RenderData *render_data,
   BLI_mutex_unlock(&g_compositor.mutex);
 }
 
+void COM_clear_caches()
+{
+  blender::compositor::OperationCache::tag_clear();
+}
+
 void COM_deinitialize()
 {
   if (g_compositor.is_initialized) {
     BLI_mutex_lock(&g_compositor.mutex);
+    blender::compositor::OperationCache::clear();
     blender::compositor::WorkScheduler::deinitialize();
     g_compositor.is_initialized = false;
     BLI_mutex_unlock(&g_compositor.mutex);
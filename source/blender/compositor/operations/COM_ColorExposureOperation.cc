@@ -1,6 +1,8 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later
  * Copyright 2020 Blender Foundation. */
 
+#include "BLI_simd.h"
+
 #include "COM_ColorExposureOperation.h"
 
 namespace blender::compositor {
@@ -40,14 +42,30 @@ void ExposureOperation::execute_pixel_sampled(float output[4],
 
 void ExposureOperation::update_memory_buffer_row(PixelCursor &p)
 {
+  /* Exposure is usually constant, only recompute the multiplier when it changes. */
+  float last_exposure = 0.0f;
+  float multiplier = 1.0f;
+#ifdef BLI_HAVE_SSE2
+  const __m128 alpha_mask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+#endif
   for (; p.out < p.row_end; p.next()) {
     const float *in_value = p.ins[0];
     const float *in_exposure = p.ins[1];
-    const float exposure = pow(2, in_exposure[0]);
-    p.out[0] = in_value[0] * exposure;
-    p.out[1] = in_value[1] * exposure;
-    p.out[2] = in_value[2] * exposure;
+    if (in_exposure[0] != last_exposure) {
+      last_exposure = in_exposure[0];
+      multiplier = pow(2, last_exposure);
+    }
+#ifdef BLI_HAVE_SSE2
+    const __m128 color = _mm_loadu_ps(in_value);
+    const __m128 result = _mm_mul_ps(color, _mm_set1_ps(multiplier));
+    _mm_storeu_ps(p.out,
+                  _mm_or_ps(_mm_andnot_ps(alpha_mask, result), _mm_and_ps(alpha_mask, color)));
+#else
+    p.out[0] = in_value[0] * multiplier;
+    p.out[1] = in_value[1] * multiplier;
+    p.out[2] = in_value[2] * multiplier;
     p.out[3] = in_value[3];
+#endif
   }
 }
 
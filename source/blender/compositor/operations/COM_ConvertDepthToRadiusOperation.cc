@@ -29,6 +29,20 @@ float ConvertDepthToRadiusOperation::determine_focal_distance()
   return 10.0f;
 }
 
+void ConvertDepthToRadiusOperation::hash_output_params()
+{
+  hash_params(f_stop_, max_radius_);
+  if (blur_post_operation_) {
+    /* Post blur is set on execution, operations with different post blurs can't be merged. */
+    hash_param(blur_post_operation_->get_id());
+  }
+  if (camera_object_ && camera_object_->type == OB_CAMERA) {
+    const Camera *camera = (const Camera *)camera_object_->data;
+    hash_params(camera->lens, (int)camera->sensor_fit, camera->sensor_x);
+    hash_params(camera->sensor_y, BKE_camera_object_dof_distance(camera_object_));
+  }
+}
+
 void ConvertDepthToRadiusOperation::init_execution()
 {
   float cam_sensor = DEFAULT_SENSOR_WIDTH;
@@ -4,6 +4,8 @@
 #include "COM_GlareGhostOperation.h"
 #include "COM_FastGaussianBlurOperation.h"
 
+#include "BLI_task.hh"
+
 namespace blender::compositor {
 
 static float smooth_mask(float x, float y)
@@ -24,9 +26,9 @@ void GlareGhostOperation::generate_glare(float *data,
 {
   const int qt = 1 << settings->quality;
   const float s1 = 4.0f / (float)qt, s2 = 2.0f * s1;
-  int x, y, n, p, np;
-  fRGB c, tc, cm[64];
-  float sc, isc, u, v, sm, s, t, ofs, scalef[64];
+  int x, y, n;
+  fRGB cm[64];
+  float sc, isc, ofs, scalef[64];
   const float cmo = 1.0f - settings->colmod;
 
   MemoryBuffer gbuf(*input_tile);
@@ -87,51 +89,60 @@ void GlareGhostOperation::generate_glare(float *data,
 
   sc = 2.13;
   isc = -0.97;
-  for (y = 0; y < gbuf.get_height() && (!breaked); y++) {
-    v = ((float)y + 0.5f) / (float)gbuf.get_height();
-    for (x = 0; x < gbuf.get_width(); x++) {
-      u = ((float)x + 0.5f) / (float)gbuf.get_width();
-      s = (u - 0.5f) * sc + 0.5f;
-      t = (v - 0.5f) * sc + 0.5f;
-      tbuf1.read_bilinear(c, s * gbuf.get_width(), t * gbuf.get_height());
-      sm = smooth_mask(s, t);
-      mul_v3_fl(c, sm);
-      s = (u - 0.5f) * isc + 0.5f;
-      t = (v - 0.5f) * isc + 0.5f;
-      tbuf2.read_bilinear(tc, s * gbuf.get_width() - 0.5f, t * gbuf.get_height() - 0.5f);
-      sm = smooth_mask(s, t);
-      madd_v3_v3fl(c, tc, sm);
-
-      gbuf.write_pixel(x, y, c);
-    }
-    if (is_braked()) {
-      breaked = true;
-    }
+  /* Rows are independent of each other, generate them in parallel. */
+  if (!breaked) {
+    threading::parallel_for(IndexRange(gbuf.get_height()), 32, [&](const IndexRange sub_y) {
+      fRGB c, tc;
+      for (const int y : sub_y) {
+        const float v = ((float)y + 0.5f) / (float)gbuf.get_height();
+        for (int x = 0; x < gbuf.get_width(); x++) {
+          const float u = ((float)x + 0.5f) / (float)gbuf.get_width();
+          float s = (u - 0.5f) * sc + 0.5f;
+          float t = (v - 0.5f) * sc + 0.5f;
+          tbuf1.read_bilinear(c, s * gbuf.get_width(), t * gbuf.get_height());
+          float sm = smooth_mask(s, t);
+          mul_v3_fl(c, sm);
+          s = (u - 0.5f) * isc + 0.5f;
+          t = (v - 0.5f) * isc + 0.5f;
+          tbuf2.read_bilinear(tc, s * gbuf.get_width() - 0.5f, t * gbuf.get_height() - 0.5f);
+          sm = smooth_mask(s, t);
+          madd_v3_v3fl(c, tc, sm);
+
+          gbuf.write_pixel(x, y, c);
+        }
+      }
+    });
+  }
+  if (is_braked()) {
+    breaked = true;
   }
 
   memset(tbuf1.get_buffer(),
          0,
          tbuf1.get_width() * tbuf1.get_height() * COM_DATA_TYPE_COLOR_CHANNELS * sizeof(float));
   for (n = 1; n < settings->iter && (!breaked); n++) {
-    for (y = 0; y < gbuf.get_height() && (!breaked); y++) {
-      v = ((float)y + 0.5f) / (float)gbuf.get_height();
-      for (x = 0; x < gbuf.get_width(); x++) {
-        u = ((float)x + 0.5f) / (float)gbuf.get_width();
-        tc[0] = tc[1] = tc[2] = 0.0f;
-        for (p = 0; p < 4; p++) {
-          np = (n << 2) + p;
-          s = (u - 0.5f) * scalef[np] + 0.5f;
-          t = (v - 0.5f) * scalef[np] + 0.5f;
-          gbuf.read_bilinear(c, s * gbuf.get_width() - 0.5f, t * gbuf.get_height() - 0.5f);
-          mul_v3_v3(c, cm[np]);
-          sm = smooth_mask(s, t) * 0.25f;
-          madd_v3_v3fl(tc, c, sm);
+    threading::parallel_for(IndexRange(gbuf.get_height()), 32, [&](const IndexRange sub_y) {
+      fRGB c, tc;
+      for (const int y : sub_y) {
+        const float v = ((float)y + 0.5f) / (float)gbuf.get_height();
+        for (int x = 0; x < gbuf.get_width(); x++) {
+          const float u = ((float)x + 0.5f) / (float)gbuf.get_width();
+          tc[0] = tc[1] = tc[2] = 0.0f;
+          for (int p = 0; p < 4; p++) {
+            const int np = (n << 2) + p;
+            const float s = (u - 0.5f) * scalef[np] + 0.5f;
+            const float t = (v - 0.5f) * scalef[np] + 0.5f;
+            gbuf.read_bilinear(c, s * gbuf.get_width() - 0.5f, t * gbuf.get_height() - 0.5f);
+            mul_v3_v3(c, cm[np]);
+            const float sm = smooth_mask(s, t) * 0.25f;
+            madd_v3_v3fl(tc, c, sm);
+          }
+          tbuf1.add_pixel(x, y, tc);
         }
-        tbuf1.add_pixel(x, y, tc);
-      }
-      if (is_braked()) {
-        breaked = true;
       }
+    });
+    if (is_braked()) {
+      breaked = true;
     }
     memcpy(gbuf.get_buffer(),
            tbuf1.get_buffer(),
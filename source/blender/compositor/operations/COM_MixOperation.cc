@@ -5,6 +5,13 @@
 
 namespace blender::compositor {
 
+#ifdef BLI_HAVE_SSE2
+static inline __m128 abs_ps(const __m128 value)
+{
+  return _mm_andnot_ps(_mm_set1_ps(-0.0f), value);
+}
+#endif
+
 /* ******** Mix Base Operation ******** */
 
 MixBaseOperation::MixBaseOperation()
@@ -150,6 +157,11 @@ void MixAddOperation::execute_pixel_sampled(float output[4],
 
 void MixAddOperation::update_memory_buffer_row(PixelCursor &p)
 {
+#ifdef BLI_HAVE_SSE2
+  update_memory_buffer_row_sse(p, [](__m128 value, __m128 color1, __m128 color2) {
+    return _mm_add_ps(color1, _mm_mul_ps(value, color2));
+  });
+#else
   while (p.out < p.row_end) {
     float value = p.value[0];
     if (this->use_value_alpha_multiply()) {
@@ -163,6 +175,7 @@ void MixAddOperation::update_memory_buffer_row(PixelCursor &p)
     clamp_if_needed(p.out);
     p.next();
   }
+#endif
 }
 
 /* ******** Mix Blend Operation ******** */
@@ -196,6 +209,12 @@ void MixBlendOperation::execute_pixel_sampled(float output[4],
 
 void MixBlendOperation::update_memory_buffer_row(PixelCursor &p)
 {
+#ifdef BLI_HAVE_SSE2
+  update_memory_buffer_row_sse(p, [](__m128 value, __m128 color1, __m128 color2) {
+    return _mm_add_ps(_mm_mul_ps(_mm_sub_ps(_mm_set1_ps(1.0f), value), color1),
+                      _mm_mul_ps(value, color2));
+  });
+#else
   while (p.out < p.row_end) {
     float value = p.value[0];
     if (this->use_value_alpha_multiply()) {
@@ -210,6 +229,7 @@ void MixBlendOperation::update_memory_buffer_row(PixelCursor &p)
     clamp_if_needed(p.out);
     p.next();
   }
+#endif
 }
 
 /* ******** Mix Burn Operation ******** */
@@ -432,6 +452,12 @@ void MixDarkenOperation::execute_pixel_sampled(float output[4],
 
 void MixDarkenOperation::update_memory_buffer_row(PixelCursor &p)
 {
+#ifdef BLI_HAVE_SSE2
+  update_memory_buffer_row_sse(p, [](__m128 value, __m128 color1, __m128 color2) {
+    return _mm_add_ps(_mm_mul_ps(_mm_min_ps(color1, color2), value),
+                      _mm_mul_ps(color1, _mm_sub_ps(_mm_set1_ps(1.0f), value)));
+  });
+#else
   while (p.out < p.row_end) {
     float value = p.value[0];
     if (this->use_value_alpha_multiply()) {
@@ -446,6 +472,7 @@ void MixDarkenOperation::update_memory_buffer_row(PixelCursor &p)
     clamp_if_needed(p.out);
     p.next();
   }
+#endif
 }
 
 /* ******** Mix Difference Operation ******** */
@@ -478,6 +505,12 @@ void MixDifferenceOperation::execute_pixel_sampled(float output[4],
 
 void MixDifferenceOperation::update_memory_buffer_row(PixelCursor &p)
 {
+#ifdef BLI_HAVE_SSE2
+  update_memory_buffer_row_sse(p, [](__m128 value, __m128 color1, __m128 color2) {
+    return _mm_add_ps(_mm_mul_ps(_mm_sub_ps(_mm_set1_ps(1.0f), value), color1),
+                      _mm_mul_ps(value, abs_ps(_mm_sub_ps(color1, color2))));
+  });
+#else
   while (p.out < p.row_end) {
     float value = p.value[0];
     if (this->use_value_alpha_multiply()) {
@@ -492,6 +525,7 @@ void MixDifferenceOperation::update_memory_buffer_row(PixelCursor &p)
     clamp_if_needed(p.out);
     p.next();
   }
+#endif
 }
 
 /* ******** Mix Difference Operation ******** */
@@ -895,6 +929,11 @@ void MixLightenOperation::execute_pixel_sampled(float output[4],
 
 void MixLightenOperation::update_memory_buffer_row(PixelCursor &p)
 {
+#ifdef BLI_HAVE_SSE2
+  update_memory_buffer_row_sse(p, [](__m128 value, __m128 color1, __m128 color2) {
+    return _mm_max_ps(_mm_mul_ps(value, color2), color1);
+  });
+#else
   while (p.out < p.row_end) {
     float value = p.value[0];
     if (this->use_value_alpha_multiply()) {
@@ -915,6 +954,7 @@ void MixLightenOperation::update_memory_buffer_row(PixelCursor &p)
     clamp_if_needed(p.out);
     p.next();
   }
+#endif
 }
 
 /* ******** Mix Linear Light Operation ******** */
@@ -1023,6 +1063,12 @@ void MixMultiplyOperation::execute_pixel_sampled(float output[4],
 
 void MixMultiplyOperation::update_memory_buffer_row(PixelCursor &p)
 {
+#ifdef BLI_HAVE_SSE2
+  update_memory_buffer_row_sse(p, [](__m128 value, __m128 color1, __m128 color2) {
+    return _mm_mul_ps(color1,
+                      _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), value), _mm_mul_ps(value, color2)));
+  });
+#else
   while (p.out < p.row_end) {
     float value = p.value[0];
     if (this->use_value_alpha_multiply()) {
@@ -1038,6 +1084,7 @@ void MixMultiplyOperation::update_memory_buffer_row(PixelCursor &p)
     clamp_if_needed(p.out);
     p.next();
   }
+#endif
 }
 
 /* ******** Mix Overlay Operation ******** */
@@ -1217,6 +1264,15 @@ void MixScreenOperation::execute_pixel_sampled(float output[4],
 
 void MixScreenOperation::update_memory_buffer_row(PixelCursor &p)
 {
+#ifdef BLI_HAVE_SSE2
+  update_memory_buffer_row_sse(p, [](__m128 value, __m128 color1, __m128 color2) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    return _mm_sub_ps(one,
+                      _mm_mul_ps(_mm_add_ps(_mm_sub_ps(one, value),
+                                            _mm_mul_ps(value, _mm_sub_ps(one, color2))),
+                                 _mm_sub_ps(one, color1)));
+  });
+#else
   while (p.out < p.row_end) {
     float value = p.value[0];
     if (this->use_value_alpha_multiply()) {
@@ -1232,6 +1288,7 @@ void MixScreenOperation::update_memory_buffer_row(PixelCursor &p)
     clamp_if_needed(p.out);
     p.next();
   }
+#endif
 }
 
 /* ******** Mix Soft Light Operation ******** */
@@ -1332,6 +1389,11 @@ void MixSubtractOperation::execute_pixel_sampled(float output[4],
 
 void MixSubtractOperation::update_memory_buffer_row(PixelCursor &p)
 {
+#ifdef BLI_HAVE_SSE2
+  update_memory_buffer_row_sse(p, [](__m128 value, __m128 color1, __m128 color2) {
+    return _mm_sub_ps(color1, _mm_mul_ps(value, color2));
+  });
+#else
   while (p.out < p.row_end) {
     float value = p.value[0];
     if (this->use_value_alpha_multiply()) {
@@ -1345,6 +1407,7 @@ void MixSubtractOperation::update_memory_buffer_row(PixelCursor &p)
     clamp_if_needed(p.out);
     p.next();
   }
+#endif
 }
 
 /* ******** Mix Value Operation ******** */
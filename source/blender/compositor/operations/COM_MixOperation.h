@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "BLI_simd.h"
+
 #include "COM_MultiThreadedOperation.h"
 
 namespace blender::compositor {
@@ -93,6 +95,36 @@ class MixBaseOperation : public MultiThreadedOperation {
 
  protected:
   virtual void update_memory_buffer_row(PixelCursor &p);
+
+#ifdef BLI_HAVE_SSE2
+  /**
+   * Mix a row with one pixel per SSE register, calling `blend_fn(value, color1, color2)` to
+   * compute the color channels of each pixel. The alpha of the first color is kept and the
+   * result is clamped when needed.
+   */
+  template<typename BlendFn> void update_memory_buffer_row_sse(PixelCursor &p, BlendFn blend_fn)
+  {
+    const __m128 alpha_mask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const bool value_alpha_multiply = value_alpha_multiply_;
+    const bool use_clamp = use_clamp_;
+    for (; p.out < p.row_end; p.next()) {
+      float value = p.value[0];
+      if (value_alpha_multiply) {
+        value *= p.color2[3];
+      }
+      const __m128 color1 = _mm_loadu_ps(p.color1);
+      const __m128 color2 = _mm_loadu_ps(p.color2);
+      __m128 result = blend_fn(_mm_set1_ps(value), color1, color2);
+      result = _mm_or_ps(_mm_andnot_ps(alpha_mask, result), _mm_and_ps(alpha_mask, color1));
+      if (use_clamp) {
+        result = _mm_min_ps(_mm_max_ps(result, zero), one);
+      }
+      _mm_storeu_ps(p.out, result);
+    }
+  }
+#endif
 };
 
 class MixAddOperation : public MixBaseOperation {
@@ -18,6 +18,7 @@ VariableSizeBokehBlurOperation::VariableSizeBokehBlurOperation()
   this->add_output_socket(DataType::Color);
   flags_.complex = true;
   flags_.open_cl = true;
+  flags_.can_be_cached = true;
 
   input_program_ = nullptr;
   input_bokeh_program_ = nullptr;
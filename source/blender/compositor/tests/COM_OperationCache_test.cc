@@ -0,0 +1,83 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. */
+
+#include "testing/testing.h"
+
+#include "COM_MemoryBuffer.h"
+#include "COM_OperationCache.h"
+
+namespace blender::compositor::tests {
+
+static std::unique_ptr<MemoryBuffer> create_buffer(const rcti &rect)
+{
+  return std::make_unique<MemoryBuffer>(DataType::Value, rect);
+}
+
+TEST(OperationCache, get_buffer)
+{
+  rcti full_area;
+  BLI_rcti_init(&full_area, 0, 4, 0, 4);
+  rcti partial_area;
+  BLI_rcti_init(&partial_area, 0, 2, 1, 3);
+
+  OperationCache::clear();
+  OperationCache::execution_started();
+
+  MemoryBuffer *buffer = OperationCache::set_buffer(1, create_buffer(full_area), {partial_area});
+  EXPECT_EQ(OperationCache::get_buffer(1, {partial_area}), buffer);
+  EXPECT_EQ(OperationCache::get_buffer(1, {full_area}), nullptr);
+  EXPECT_EQ(OperationCache::get_buffer(2, {partial_area}), nullptr);
+
+  /* Storing with the same key replaces the buffer. */
+  buffer = OperationCache::set_buffer(1, create_buffer(full_area), {full_area});
+  EXPECT_EQ(OperationCache::get_buffer(1, {full_area}), buffer);
+  EXPECT_EQ(OperationCache::get_buffer(1, {partial_area, full_area}), buffer);
+
+  OperationCache::execution_finished();
+  OperationCache::clear();
+  EXPECT_EQ(OperationCache::get_buffer(1, {full_area}), nullptr);
+}
+
+TEST(OperationCache, free_unused_buffers)
+{
+  rcti area;
+  BLI_rcti_init(&area, 0, 4, 0, 4);
+
+  OperationCache::clear();
+  OperationCache::execution_started();
+  MemoryBuffer *buffer = OperationCache::set_buffer(1, create_buffer(area), {area});
+  OperationCache::execution_finished();
+
+  /* Buffers used by the previous execution are kept. */
+  OperationCache::execution_started();
+  OperationCache::execution_finished();
+  OperationCache::execution_started();
+  EXPECT_EQ(OperationCache::get_buffer(1, {area}), buffer);
+  OperationCache::execution_finished();
+
+  OperationCache::execution_started();
+  OperationCache::execution_finished();
+  OperationCache::execution_started();
+  OperationCache::execution_finished();
+  OperationCache::execution_started();
+  EXPECT_EQ(OperationCache::get_buffer(1, {area}), nullptr);
+  OperationCache::execution_finished();
+}
+
+TEST(OperationCache, tag_clear)
+{
+  rcti area;
+  BLI_rcti_init(&area, 0, 4, 0, 4);
+
+  OperationCache::clear();
+  OperationCache::execution_started();
+  OperationCache::set_buffer(1, create_buffer(area), {area});
+  OperationCache::execution_finished();
+
+  OperationCache::tag_clear();
+  OperationCache::execution_started();
+  EXPECT_EQ(OperationCache::get_buffer(1, {area}), nullptr);
+  OperationCache::execution_finished();
+}
+
+}  // namespace blender::compositor::tests
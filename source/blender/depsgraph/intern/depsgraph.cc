@@ -196,6 +196,22 @@ Relation *Depsgraph::check_nodes_connected(const Node *from,
                                            const Node *to,
                                            const char *description)
 {
+  /* Scan whichever side of the relation has less links. Nodes like the time source or the scene
+   * parameters can be connected to every object of the scene, so always scanning the outgoing
+   * links makes building relations quadratic in the number of objects. */
+  if (to->inlinks.size() < from->outlinks.size()) {
+    for (Relation *rel : to->inlinks) {
+      BLI_assert(rel->to == to);
+      if (rel->from != from) {
+        continue;
+      }
+      if (description != nullptr && !STREQ(rel->name, description)) {
+        continue;
+      }
+      return rel;
+    }
+    return nullptr;
+  }
   for (Relation *rel : from->outlinks) {
     BLI_assert(rel->from == from);
     if (rel->to != to) {
@@ -28,6 +28,7 @@
 #include "DNA_windowmanager_types.h"
 
 #include "BKE_anim_data.h"
+#include "BKE_animsys.h"
 #include "BKE_global.h"
 #include "BKE_idtype.h"
 #include "BKE_node.h"
@@ -654,6 +655,10 @@ void graph_id_tag_update(
    * Allows to have more granularity than a node-factory based flags. */
   if (id_node != nullptr) {
     id_node->id_cow->recalc |= flag;
+    /* Resolved paths can point to data which is about to be re-allocated. */
+    if (deg_copy_on_write_is_expanded(id_node->id_cow)) {
+      BKE_animsys_rna_path_cache_clear(id_node->id_cow);
+    }
   }
   /* When ID is tagged for update based on an user edits store the recalc flags in the original ID.
    * This way IDs in the undo steps will have this flag preserved, making it possible to restore
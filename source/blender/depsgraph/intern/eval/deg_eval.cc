@@ -9,12 +9,18 @@
 
 #include "intern/eval/deg_eval.h"
 
+#include <algorithm>
+
+#include "MEM_guardedalloc.h"
+
 #include "PIL_time.h"
 
 #include "BLI_compiler_attrs.h"
 #include "BLI_gsqueue.h"
 #include "BLI_task.h"
+#include "BLI_trace.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_global.h"
 
@@ -62,6 +68,21 @@ void schedule_node_to_pool(OperationNode *node, const int UNUSED(thread_id), Tas
   BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
 }
 
+void schedule_node_to_vector(OperationNode *node,
+                             const int /*thread_id*/,
+                             Vector<OperationNode *> *nodes)
+{
+  nodes->append(node);
+}
+
+/* Weight of the last evaluation time in the moving average of operation evaluation times. */
+constexpr double eval_time_history_factor = 0.25;
+
+/* Minimum number of operations to evaluate for scheduling them along the critical path. For small
+ * updates, such as moving a single object, the scheduling order doesn't matter much and computing
+ * the critical path would only add overhead. */
+constexpr int64_t critical_path_min_operations = 64;
+
 /* Denotes which part of dependency graph is being evaluated. */
 enum class EvaluationStage {
   /* Stage 1: Only  Copy-on-Write operations are to be evaluated, prior to anything else.
@@ -82,6 +103,8 @@ enum class EvaluationStage {
 struct DepsgraphEvalState {
   Depsgraph *graph;
   bool do_stats;
+  /* Operations on the critical path are evaluated first, see #critical_path_min_operations. */
+  bool use_critical_path;
   EvaluationStage stage;
   bool need_single_thread_pass;
 };
@@ -92,14 +115,39 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
 
   /* Sanity checks. */
   BLI_assert_msg(!operation_node->is_noop(), "NOOP nodes should not actually be scheduled");
-  /* Perform operation. */
+  /* Perform operation. The time is always measured, it's used to prioritize operations on the
+   * critical path in the next evaluations. */
+  const double start_time = PIL_check_seconds_timer();
+  operation_node->evaluate(depsgraph);
+  const double eval_time = PIL_check_seconds_timer() - start_time;
+
+  if (BLI_trace_is_enabled()) {
+    BLI_trace_complete(
+        "depsgraph", operation_node->full_identifier().c_str(), start_time, eval_time);
+  }
   if (state->do_stats) {
-    const double start_time = PIL_check_seconds_timer();
-    operation_node->evaluate(depsgraph);
-    operation_node->stats.current_time += PIL_check_seconds_timer() - start_time;
+    operation_node->stats.current_time += eval_time;
+  }
+  if (operation_node->average_eval_time == 0.0) {
+    operation_node->average_eval_time = eval_time;
   }
   else {
-    operation_node->evaluate(depsgraph);
+    operation_node->average_eval_time += (eval_time - operation_node->average_eval_time) *
+                                         eval_time_history_factor;
+  }
+}
+
+bool operation_critical_path_time_greater(const OperationNode *a, const OperationNode *b)
+{
+  return a->critical_path_time > b->critical_path_time;
+}
+
+/* Push nodes to the pool in order of priority, so that the critical path is picked first. */
+void push_nodes_to_pool(Vector<OperationNode *> &nodes, TaskPool *pool)
+{
+  std::sort(nodes.begin(), nodes.end(), operation_critical_path_time_greater);
+  for (OperationNode *node : nodes) {
+    schedule_node_to_pool(node, 0, pool);
   }
 }
 
@@ -108,15 +156,38 @@ void deg_task_run_func(TaskPool *pool, void *taskdata)
   void *userdata_v = BLI_task_pool_user_data(pool);
   DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
 
-  /* Evaluate node. */
   OperationNode *operation_node = reinterpret_cast<OperationNode *>(taskdata);
-  evaluate_node(state, operation_node);
+  if (!state->use_critical_path) {
+    evaluate_node(state, operation_node);
+    schedule_children(state, operation_node, schedule_node_to_pool, pool);
+    return;
+  }
+
+  Vector<OperationNode *> ready_nodes;
+  while (operation_node != nullptr) {
+    /* Evaluate node. */
+    evaluate_node(state, operation_node);
 
-  /* Schedule children. */
-  schedule_children(state, operation_node, schedule_node_to_pool, pool);
+    /* Schedule children. The child with the longest remaining path is evaluated right away in
+     * this thread, so that long chains of operations don't wait for other tasks in the pool. */
+    ready_nodes.clear();
+    schedule_children(state, operation_node, schedule_node_to_vector, &ready_nodes);
+    if (ready_nodes.is_empty()) {
+      break;
+    }
+    int64_t next_index = 0;
+    for (const int64_t i : ready_nodes.index_range().drop_front(1)) {
+      if (operation_critical_path_time_greater(ready_nodes[i], ready_nodes[next_index])) {
+        next_index = i;
+      }
+    }
+    operation_node = ready_nodes[next_index];
+    ready_nodes.remove_and_reorder(next_index);
+    push_nodes_to_pool(ready_nodes, pool);
+  }
 }
 
-bool check_operation_node_visible(OperationNode *op_node)
+bool check_operation_node_visible(const OperationNode *op_node)
 {
   const ComponentNode *comp_node = op_node->owner;
   /* Special exception, copy on write component is to be always evaluated,
@@ -166,10 +237,84 @@ void calculate_pending_parents(Depsgraph *graph)
   }
 }
 
+bool need_evaluate_operation(const OperationNode *node)
+{
+  return check_operation_node_visible(node) &&
+         (node->flag & DEPSOP_FLAG_NEEDS_UPDATE) != 0;
+}
+
+/* Estimate how long evaluating every operation and the longest chain of operations depending on
+ * it takes, based on the evaluation times of previous evaluations. Operations which were never
+ * evaluated still count a little bit, so the number of remaining operations is taken into
+ * account too. */
+void calculate_critical_path_times(Depsgraph *graph)
+{
+  const double min_eval_time = 1e-7;
+  /* Negative value marks nodes for which the time is not calculated yet. */
+  for (OperationNode *node : graph->operations) {
+    node->critical_path_time = -1.0;
+  }
+  /* Iterative depth-first traversal, a node is finished once all of its children are. */
+  Vector<std::pair<OperationNode *, int64_t>> stack;
+  for (OperationNode *root : graph->operations) {
+    if (root->critical_path_time >= 0.0) {
+      continue;
+    }
+    if (!need_evaluate_operation(root)) {
+      root->critical_path_time = 0.0;
+      continue;
+    }
+    /* Mark as being visited, so cycles that were not detected as such still terminate. */
+    root->critical_path_time = 0.0;
+    stack.append({root, 0});
+    while (!stack.is_empty()) {
+      auto &[node, rel_index] = stack.last();
+      if (rel_index < node->outlinks.size()) {
+        const Relation *rel = node->outlinks[rel_index++];
+        OperationNode *child = (OperationNode *)rel->to;
+        if ((rel->flag & RELATION_FLAG_CYCLIC) != 0 || child->critical_path_time >= 0.0) {
+          continue;
+        }
+        child->critical_path_time = 0.0;
+        if (need_evaluate_operation(child)) {
+          stack.append({child, 0});
+        }
+        continue;
+      }
+      double children_time = 0.0;
+      for (const Relation *rel : node->outlinks) {
+        if ((rel->flag & RELATION_FLAG_CYCLIC) == 0) {
+          const OperationNode *child = (const OperationNode *)rel->to;
+          children_time = std::max(children_time, child->critical_path_time);
+        }
+      }
+      const double own_time = node->is_noop() ? 0.0 :
+                                                std::max(node->average_eval_time, min_eval_time);
+      node->critical_path_time = own_time + children_time;
+      stack.remove_last();
+    }
+  }
+}
+
+int64_t count_operations_to_evaluate(Depsgraph *graph)
+{
+  int64_t num_operations = 0;
+  for (const OperationNode *node : graph->operations) {
+    if (need_evaluate_operation(node)) {
+      num_operations++;
+    }
+  }
+  return num_operations;
+}
+
 void initialize_execution(DepsgraphEvalState *state, Depsgraph *graph)
 {
   const bool do_stats = state->do_stats;
   calculate_pending_parents(graph);
+  state->use_critical_path = count_operations_to_evaluate(graph) >= critical_path_min_operations;
+  if (state->use_critical_path) {
+    calculate_critical_path_times(graph);
+  }
   /* Clear tags and other things which needs to be clear. */
   for (OperationNode *node : graph->operations) {
     if (do_stats) {
@@ -274,6 +419,17 @@ void schedule_graph(DepsgraphEvalState *state,
   }
 }
 
+void schedule_graph_to_pool(DepsgraphEvalState *state, TaskPool *pool)
+{
+  if (!state->use_critical_path) {
+    schedule_graph(state, schedule_node_to_pool, pool);
+    return;
+  }
+  Vector<OperationNode *> ready_nodes;
+  schedule_graph(state, schedule_node_to_vector, &ready_nodes);
+  push_nodes_to_pool(ready_nodes, pool);
+}
+
 template<typename ScheduleFunction, typename... ScheduleFunctionArgs>
 void schedule_children(DepsgraphEvalState *state,
                        OperationNode *node,
@@ -353,6 +509,7 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   }
 
   graph->debug.begin_graph_evaluation();
+  ScopedTraceEvent trace_event("depsgraph", "Depsgraph Evaluation");
 
 #ifdef WITH_PYTHON
   /* Release the GIL so that Python drivers can be evaluated. See T91046. */
@@ -373,14 +530,14 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   /* First, process all Copy-On-Write nodes. */
   state.stage = EvaluationStage::COPY_ON_WRITE;
   TaskPool *task_pool = deg_evaluate_task_pool_create(&state);
-  schedule_graph(&state, schedule_node_to_pool, task_pool);
+  schedule_graph_to_pool(&state, task_pool);
   BLI_task_pool_work_and_wait(task_pool);
   BLI_task_pool_free(task_pool);
 
   /* After that, process all other nodes. */
   state.stage = EvaluationStage::THREADED_EVALUATION;
   task_pool = deg_evaluate_task_pool_create(&state);
-  schedule_graph(&state, schedule_node_to_pool, task_pool);
+  schedule_graph_to_pool(&state, task_pool);
   BLI_task_pool_work_and_wait(task_pool);
   BLI_task_pool_free(task_pool);
 
@@ -404,6 +561,10 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
 #endif
 
   graph->debug.end_graph_evaluation();
+
+  if (BLI_trace_is_enabled()) {
+    BLI_trace_counter("Memory In Use", double(MEM_get_memory_in_use()));
+  }
 }
 
 }  // namespace blender::deg
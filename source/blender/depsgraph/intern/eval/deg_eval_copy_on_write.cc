@@ -270,7 +270,7 @@ struct ValidateData {
 
 /* Similar to generic BKE_id_copy() but does not require main and assumes pointer
  * is already allocated. */
-bool id_copy_inplace_no_main(const ID *id, ID *newid)
+bool id_copy_inplace_no_main(const ID *id, ID *newid, const int extra_flag = 0)
 {
   const ID *id_for_copy = id;
 
@@ -291,7 +291,7 @@ bool id_copy_inplace_no_main(const ID *id, ID *newid)
                                 (ID *)id_for_copy,
                                 &newid,
                                 (LIB_ID_COPY_LOCALIZE | LIB_ID_CREATE_NO_ALLOCATE |
-                                 LIB_ID_COPY_SET_COPIED_ON_WRITE)) != nullptr);
+                                 LIB_ID_COPY_SET_COPIED_ON_WRITE | extra_flag)) != nullptr);
 
 #ifdef NESTED_ID_NASTY_WORKAROUND
   if (result) {
@@ -749,6 +749,7 @@ void update_id_after_copy(const Depsgraph *depsgraph,
   }
   update_edit_mode_pointers(depsgraph, id_orig, id_cow);
   BKE_animsys_update_driver_array(id_cow);
+  BKE_animsys_rna_path_cache_ensure(id_cow);
 }
 
 /* This callback is used to validate that all nested ID data-blocks are
@@ -770,8 +771,12 @@ int foreach_libblock_validate_callback(LibraryIDLinkCallbackData *cb_data)
 /* Actual implementation of logic which "expands" all the data which was not
  * yet copied-on-write.
  *
- * NOTE: Expects that CoW datablock is empty. */
-ID *deg_expand_copy_on_write_datablock(const Depsgraph *depsgraph, const IDNode *id_node)
+ * NOTE: Expects that CoW datablock is empty.
+ *
+ * \param backup: Runtime backup of the previous copy, which is restored afterwards. */
+ID *deg_expand_copy_on_write_datablock(const Depsgraph *depsgraph,
+                                       const IDNode *id_node,
+                                       const RuntimeBackup &backup)
 {
   const ID *id_orig = id_node->id_orig;
   ID *id_cow = id_node->id_cow;
@@ -816,8 +821,12 @@ ID *deg_expand_copy_on_write_datablock(const Depsgraph *depsgraph, const IDNode
       break;
     }
     case ID_ME: {
-      /* TODO(sergey): Ideally we want to handle meshes in a special
-       * manner here to avoid initial copy of all the geometry arrays. */
+      /* When the arrays of the previous copy are kept in the backup, only reference the
+       * original geometry arrays here. Restoring the backup copies the data into the kept
+       * arrays, avoiding the allocation of a new copy of all the geometry arrays. */
+      if (backup.mesh_backup.has_layers) {
+        done = id_copy_inplace_no_main(id_orig, id_cow, LIB_ID_COPY_CD_REFERENCE);
+      }
       break;
     }
     default:
@@ -897,7 +906,7 @@ ID *deg_update_copy_on_write_datablock(const Depsgraph *depsgraph, const IDNode
   RuntimeBackup backup(depsgraph);
   backup.init_from_id(id_cow);
   deg_free_copy_on_write_datablock(id_cow);
-  deg_expand_copy_on_write_datablock(depsgraph, id_node);
+  deg_expand_copy_on_write_datablock(depsgraph, id_node, backup);
   backup.restore_to_id(id_cow);
   return id_cow;
 }
@@ -25,7 +25,8 @@ RuntimeBackup::RuntimeBackup(const Depsgraph *depsgraph)
       drawdata_ptr(nullptr),
       movieclip_backup(depsgraph),
       volume_backup(depsgraph),
-      gpencil_backup(depsgraph)
+      gpencil_backup(depsgraph),
+      mesh_backup(depsgraph)
 {
   drawdata_backup.first = drawdata_backup.last = nullptr;
 }
@@ -62,6 +63,10 @@ void RuntimeBackup::init_from_id(ID *id)
       break;
     case ID_GD:
       gpencil_backup.init_from_gpencil(reinterpret_cast<bGPdata *>(id));
+      break;
+    case ID_ME:
+      mesh_backup.init_from_mesh(reinterpret_cast<Mesh *>(id));
+      break;
     default:
       break;
   }
@@ -104,6 +109,10 @@ void RuntimeBackup::restore_to_id(ID *id)
       break;
     case ID_GD:
       gpencil_backup.restore_to_gpencil(reinterpret_cast<bGPdata *>(id));
+      break;
+    case ID_ME:
+      mesh_backup.restore_to_mesh(reinterpret_cast<Mesh *>(id));
+      break;
     default:
       break;
   }
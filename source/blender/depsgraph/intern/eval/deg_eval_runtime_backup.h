@@ -11,6 +11,7 @@
 
 #include "intern/eval/deg_eval_runtime_backup_animation.h"
 #include "intern/eval/deg_eval_runtime_backup_gpencil.h"
+#include "intern/eval/deg_eval_runtime_backup_mesh.h"
 #include "intern/eval/deg_eval_runtime_backup_movieclip.h"
 #include "intern/eval/deg_eval_runtime_backup_object.h"
 #include "intern/eval/deg_eval_runtime_backup_scene.h"
@@ -57,6 +58,7 @@ class RuntimeBackup {
   MovieClipBackup movieclip_backup;
   VolumeBackup volume_backup;
   GPencilBackup gpencil_backup;
+  MeshBackup mesh_backup;
 };
 
 }  // namespace deg
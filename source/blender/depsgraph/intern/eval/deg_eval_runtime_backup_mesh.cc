@@ -0,0 +1,84 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. All rights reserved. */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "intern/eval/deg_eval_runtime_backup_mesh.h"
+
+#include "BLI_utildefines.h"
+
+#include "DNA_mesh_types.h"
+
+#include "BKE_customdata.h"
+#include "BKE_mesh.h"
+
+namespace blender::deg {
+
+MeshBackup::MeshBackup(const Depsgraph * /*depsgraph*/)
+    : has_layers(false), totvert(0), totedge(0), totloop(0), totpoly(0)
+{
+  CustomData_reset(&vdata);
+  CustomData_reset(&edata);
+  CustomData_reset(&ldata);
+  CustomData_reset(&pdata);
+}
+
+void MeshBackup::init_from_mesh(Mesh *mesh)
+{
+  /* Edit-mode pointers are set up for the copied arrays, keep the regular copy there. */
+  if (mesh->edit_mesh != nullptr) {
+    return;
+  }
+
+  /* Take the layers out of the mesh, so freeing the copied mesh leaves them alive. */
+  vdata = mesh->vdata;
+  edata = mesh->edata;
+  ldata = mesh->ldata;
+  pdata = mesh->pdata;
+  totvert = mesh->totvert;
+  totedge = mesh->totedge;
+  totloop = mesh->totloop;
+  totpoly = mesh->totpoly;
+  CustomData_reset(&mesh->vdata);
+  CustomData_reset(&mesh->edata);
+  CustomData_reset(&mesh->ldata);
+  CustomData_reset(&mesh->pdata);
+  BKE_mesh_update_customdata_pointers(mesh, false);
+
+  has_layers = true;
+}
+
+static void restore_layers(CustomData *data,
+                           const int totelem,
+                           CustomData *old_data,
+                           const int old_totelem)
+{
+  if (totelem == old_totelem) {
+    CustomData_duplicate_referenced_layers_reuse(data, old_data, totelem);
+  }
+  else {
+    CustomData_duplicate_referenced_layers(data, totelem);
+  }
+  CustomData_free(old_data, old_totelem);
+}
+
+void MeshBackup::restore_to_mesh(Mesh *mesh)
+{
+  if (!has_layers) {
+    return;
+  }
+
+  /* The new copy references the layers of the original mesh, give it its own data while
+   * re-using the memory of the previous copy, only layers that changed are copied. */
+  restore_layers(&mesh->vdata, mesh->totvert, &vdata, totvert);
+  restore_layers(&mesh->edata, mesh->totedge, &edata, totedge);
+  restore_layers(&mesh->ldata, mesh->totloop, &ldata, totloop);
+  restore_layers(&mesh->pdata, mesh->totpoly, &pdata, totpoly);
+  BKE_mesh_update_customdata_pointers(mesh, false);
+
+  has_layers = false;
+}
+
+}  // namespace blender::deg
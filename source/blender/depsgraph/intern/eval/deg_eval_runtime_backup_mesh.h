@@ -0,0 +1,37 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. All rights reserved. */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#pragma once
+
+#include "DNA_customdata_types.h"
+
+struct Mesh;
+
+namespace blender {
+namespace deg {
+
+struct Depsgraph;
+
+/* Backup of the geometry arrays of mesh datablocks, so that they can be re-used by the new
+ * copy instead of allocating and copying all of them again. */
+class MeshBackup {
+ public:
+  MeshBackup(const Depsgraph *depsgraph);
+
+  void init_from_mesh(Mesh *mesh);
+  void restore_to_mesh(Mesh *mesh);
+
+  /* True when the copy can reference the original layers, #restore_to_mesh() then makes them
+   * owned by the copy again. */
+  bool has_layers;
+
+  CustomData vdata, edata, ldata, pdata;
+  int totvert, totedge, totloop, totpoly;
+};
+
+}  // namespace deg
+}  // namespace blender
@@ -256,6 +256,13 @@ struct OperationNode : public Node {
   uint32_t num_links_pending;
   bool scheduled;
 
+  /* Moving average of the time spent evaluating this operation, kept across evaluations. */
+  double average_eval_time;
+  /* Estimated time needed to evaluate this operation and the longest chain of operations which
+   * depend on it. Calculated before every evaluation, operations on the critical path are
+   * evaluated first. */
+  double critical_path_time;
+
   /* Identifier for the operation being performed. */
   OperationCode opcode;
   int name_tag;
@@ -53,6 +53,9 @@
 #  define IRRADIANCE_FORMAT GPU_RGBA8
 #endif
 
+/* Number of irradiance grid samples rendered with the same draw manager cache. */
+#define GRID_SAMPLE_BATCH_LEN 16
+
 /* OpenGL 3.3 core requirement, can be extended but it's already very big */
 #define IRRADIANCE_MAX_POOL_LAYER 256
 #define IRRADIANCE_MAX_POOL_SIZE 1024
@@ -116,6 +119,8 @@ typedef struct EEVEE_LightBake {
   int grid_sample;
   /** Total number of samples for the current grid. */
   int grid_sample_len;
+  /** Number of samples of the current grid to render in one pass, starting at `grid_sample`. */
+  int grid_sample_batch_len;
   /** Nth grid in the cache being rendered. */
   int grid_curr;
   /** The current light bounce being evaluated. */
@@ -1096,12 +1101,10 @@ static void grid_loc_to_world_loc(EEVEE_LightGrid *egrid, const int local_cell[3
   madd_v3_v3fl(r_pos, egrid->increment_z, local_cell[2]);
 }
 
-static void eevee_lightbake_render_grid_sample(void *ved, void *user_data)
+static void eevee_lightbake_render_grid_sample(EEVEE_Data *vedata, EEVEE_LightBake *lbake)
 {
-  EEVEE_Data *vedata = (EEVEE_Data *)ved;
   EEVEE_ViewLayerData *sldata = EEVEE_view_layer_data_ensure();
   EEVEE_CommonUniformBuffer *common_data = &sldata->common_data;
-  EEVEE_LightBake *lbake = (EEVEE_LightBake *)user_data;
   EEVEE_LightGrid *egrid = lbake->grid;
   LightProbe *prb = *lbake->probe;
   Scene *scene_eval = DEG_get_evaluated_scene(lbake->depsgraph);
@@ -1117,10 +1120,6 @@ static void eevee_lightbake_render_grid_sample(void *ved, void *user_data)
   /* Use the previous bounce for rendering this bounce. */
   SWAP(GPUTexture *, lbake->grid_prev, lcache->grid_tx.tex);
 
-  /* TODO: do this once for the whole bake when we have independent DRWManagers.
-   * Warning: Some of the things above require this. */
-  eevee_lightbake_cache_create(vedata, lbake);
-
   /* Compute sample position */
   compute_cell_id(egrid, prb, lbake->grid_sample, &sample_id, grid_loc, &stride);
   sample_offset = egrid->offset + sample_id;
@@ -1181,6 +1180,33 @@ static void eevee_lightbake_render_grid_sample(void *ved, void *user_data)
   }
 }
 
+static void eevee_lightbake_render_grid_samples(void *ved, void *user_data)
+{
+  EEVEE_Data *vedata = (EEVEE_Data *)ved;
+  EEVEE_LightBake *lbake = (EEVEE_LightBake *)user_data;
+  Scene *scene_eval = DEG_get_evaluated_scene(lbake->depsgraph);
+  LightCache *lcache = scene_eval->eevee.light_cache_data;
+  const int sample_end = lbake->grid_sample + lbake->grid_sample_batch_len;
+
+  /* No bias for rendering the probe. */
+  lbake->grid->level_bias = 1.0f;
+
+  /* The scene doesn't change between the samples of the same grid, so its cache is shared by a
+   * whole batch of samples, instead of being created again for each of them.
+   * TODO: do this once for the whole bake when we have independent DRWManagers.
+   * Warning: The cache has to be created with the previous bounce in place. */
+  SWAP(GPUTexture *, lbake->grid_prev, lcache->grid_tx.tex);
+  eevee_lightbake_cache_create(vedata, lbake);
+  SWAP(GPUTexture *, lbake->grid_prev, lcache->grid_tx.tex);
+
+  for (; lbake->grid_sample < sample_end; lbake->grid_sample++) {
+    if (G.is_break == true || *lbake->stop) {
+      break;
+    }
+    eevee_lightbake_render_grid_sample(vedata, lbake);
+  }
+}
+
 static void eevee_lightbake_render_probe_sample(void *ved, void *user_data)
 {
   EEVEE_Data *vedata = (EEVEE_Data *)ved;
@@ -1336,8 +1362,12 @@ void EEVEE_lightbake_update(void *custom_data)
   DEG_id_tag_update(&scene_orig->id, ID_RECALC_COPY_ON_WRITE);
 }
 
+/**
+ * \param sample_len: Number of samples rendered by the callback, for the progress.
+ */
 static bool lightbake_do_sample(EEVEE_LightBake *lbake,
-                                void (*render_callback)(void *ved, void *user_data))
+                                void (*render_callback)(void *ved, void *user_data),
+                                int sample_len)
 {
   if (G.is_break == true || *lbake->stop) {
     return false;
@@ -1348,7 +1378,7 @@ static bool lightbake_do_sample(EEVEE_LightBake *lbake,
   /* TODO: make DRW manager instantiable (and only lock on drawing) */
   eevee_lightbake_context_enable(lbake);
   DRW_custom_pipeline(&draw_engine_eevee_type, depsgraph, render_callback, lbake);
-  lbake->done += 1;
+  lbake->done += sample_len;
   *lbake->progress = lbake->done / (float)lbake->total;
   *lbake->do_update = 1;
   eevee_lightbake_context_disable(lbake);
@@ -1412,7 +1442,7 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
   /* Render world irradiance and reflection first */
   if (lcache->flag & LIGHTCACHE_UPDATE_WORLD) {
     lbake->probe = NULL;
-    lightbake_do_sample(lbake, eevee_lightbake_render_world_sample);
+    lightbake_do_sample(lbake, eevee_lightbake_render_world_sample, 1);
   }
 
   /* Render irradiance grids */
@@ -1426,9 +1456,12 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
         LightProbe *prb = *lbake->probe;
         lbake->grid_sample_len = prb->grid_resolution_x * prb->grid_resolution_y *
                                  prb->grid_resolution_z;
-        for (lbake->grid_sample = 0; lbake->grid_sample < lbake->grid_sample_len;
-             ++lbake->grid_sample) {
-          lightbake_do_sample(lbake, eevee_lightbake_render_grid_sample);
+        for (int sample = 0; sample < lbake->grid_sample_len; sample += GRID_SAMPLE_BATCH_LEN) {
+          lbake->grid_sample = sample;
+          lbake->grid_sample_batch_len = min_ii(GRID_SAMPLE_BATCH_LEN,
+                                                lbake->grid_sample_len - sample);
+          lightbake_do_sample(
+              lbake, eevee_lightbake_render_grid_samples, lbake->grid_sample_batch_len);
         }
       }
     }
@@ -1441,7 +1474,7 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
     lbake->cube = lcache->cube_data + 1;
     for (lbake->cube_offset = 1; lbake->cube_offset < lbake->cube_len;
          lbake->cube_offset++, lbake->probe++, lbake->cube++) {
-      lightbake_do_sample(lbake, eevee_lightbake_render_probe_sample);
+      lightbake_do_sample(lbake, eevee_lightbake_render_probe_sample, 1);
     }
   }
 
@@ -549,6 +549,8 @@ typedef struct EEVEE_LightsInfo {
   uchar shadow_cascade_light_indices[MAX_SHADOW_CASCADE];
   /* Update bitmap. */
   BLI_bitmap sh_cube_update[BLI_BITMAP_SIZE(MAX_SHADOW_CUBE)];
+  /* Update bitmap of the individual faces of the cubes, indexed by `cube * 6 + face`. */
+  BLI_bitmap sh_cube_face_update[BLI_BITMAP_SIZE(MAX_SHADOW_CUBE * 6)];
   /* Lights tracking */
   struct BoundSphere shadow_bounds[MAX_LIGHT]; /* Tightly packed light bounds. */
   /* List of bbox and update bitmap. Double buffered. */
@@ -1166,12 +1168,36 @@ void EEVEE_shadows_cube_add(EEVEE_LightsInfo *linfo, EEVEE_Light *evli, struct O
  * Return true if sample has changed and light needs to be updated.
  */
 bool EEVEE_shadows_cube_setup(EEVEE_LightsInfo *linfo, const EEVEE_Light *evli, int sample_ofs);
+/**
+ * Tag the faces of the shadow cube that can see the shadow caster bounds for update.
+ */
+void EEVEE_shadows_cube_caster_update(EEVEE_LightsInfo *linfo,
+                                      int cube_index,
+                                      const EEVEE_BoundBox *caster_bbox);
+/**
+ * Return true if any face of the shadow cube needs to be rendered again.
+ */
+bool EEVEE_shadows_cube_needs_update(const EEVEE_LightsInfo *linfo, int cube_index);
+/**
+ * Return true if the given face of the shadow cube can be seen from the view.
+ */
+bool EEVEE_shadows_cube_face_visible(const EEVEE_LightsInfo *linfo,
+                                     int cube_index,
+                                     int face,
+                                     const struct DRWView *view);
 void EEVEE_shadows_cascade_add(EEVEE_LightsInfo *linfo, EEVEE_Light *evli, struct Object *ob);
 /**
  * This refresh lights shadow buffers.
  */
 void EEVEE_shadows_draw(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata, struct DRWView *view);
-void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata, int cube_index);
+/**
+ * Render the faces of the shadow cube that need an update and are visible.
+ * Faces that are not visible keep their update tag until they are.
+ */
+void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata,
+                                EEVEE_Data *vedata,
+                                int cube_index,
+                                const BLI_bitmap *cube_face_visible);
 void EEVEE_shadows_draw_cascades(EEVEE_ViewLayerData *sldata,
                                  EEVEE_Data *vedata,
                                  DRWView *view,
@@ -525,6 +525,9 @@ static void eevee_render_draw_background(EEVEE_Data *vedata)
   GPU_framebuffer_bind(fbl->main_fb);
 }
 
+/* Number of samples submitted to the GPU before waiting for them to finish. */
+#define RENDER_SAMPLES_PER_GPU_FINISH 4
+
 void EEVEE_render_draw(EEVEE_Data *vedata, RenderEngine *engine, RenderLayer *rl, const rcti *rect)
 {
   const char *viewname = RE_GetActiveRenderView(engine->re);
@@ -643,8 +646,17 @@ void EEVEE_render_draw(EEVEE_Data *vedata, RenderEngine *engine, RenderLayer *rl
     /* Post Process */
     EEVEE_draw_effects(sldata, vedata);
 
-    /* XXX Seems to fix TDR issue with NVidia drivers on linux. */
-    GPU_finish();
+    /* Only wait for the GPU every few samples, so that the CPU can already submit the next
+     * samples while the previous ones are rendering. Waiting regularly still keeps the amount of
+     * queued work bounded.
+     * XXX Seems to fix TDR issue with NVidia drivers on linux. */
+    if (((render_samples + 1) % RENDER_SAMPLES_PER_GPU_FINISH) == 0 ||
+        (render_samples + 1) == tot_sample) {
+      GPU_finish();
+    }
+    else {
+      GPU_flush();
+    }
 
     RE_engine_update_progress(engine, (float)(render_samples++) / (float)tot_sample);
   }
@@ -241,6 +241,8 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   }
 
   /* TODO(fclem): This part can be slow, optimize it. */
+  /* Only the faces of the cubes that can see the shadow caster are updated,
+   * the other faces keep their content from the previous redraws. */
   EEVEE_BoundBox *bbox = backbuffer->bbox;
   BoundSphere *bsphere = linfo->shadow_bounds;
   /* Search for deleted shadow casters or if shcaster WAS in shadow radius. */
@@ -250,7 +252,7 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
       for (int j = 0; j < linfo->cube_len; j++) {
         if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
           if (sphere_bbox_intersect(&bsphere[j], &bbox[i])) {
-            BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], j);
+            EEVEE_shadows_cube_caster_update(linfo, j, &bbox[i]);
           }
         }
       }
@@ -264,7 +266,7 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
       for (int j = 0; j < linfo->cube_len; j++) {
         if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
           if (sphere_bbox_intersect(&bsphere[j], &bbox[i])) {
-            BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], j);
+            EEVEE_shadows_cube_caster_update(linfo, j, &bbox[i]);
           }
         }
       }
@@ -290,11 +292,20 @@ void EEVEE_shadows_draw(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata, DRWView
 
   /* Precompute all shadow/view test before rendering and trashing the culling cache. */
   BLI_bitmap *cube_visible = BLI_BITMAP_NEW_ALLOCA(MAX_SHADOW_CUBE);
+  BLI_bitmap *cube_face_visible = BLI_BITMAP_NEW_ALLOCA(MAX_SHADOW_CUBE * 6);
   bool any_visible = linfo->cascade_len > 0;
   for (int cube = 0; cube < linfo->cube_len; cube++) {
     if (DRW_culling_sphere_test(view, linfo->shadow_bounds + cube)) {
       BLI_BITMAP_ENABLE(cube_visible, cube);
       any_visible = true;
+
+      if (EEVEE_shadows_cube_needs_update(linfo, cube)) {
+        for (int face = 0; face < 6; face++) {
+          if (EEVEE_shadows_cube_face_visible(linfo, cube, face, view)) {
+            BLI_BITMAP_ENABLE(cube_face_visible, cube * 6 + face);
+          }
+        }
+      }
     }
   }
 
@@ -306,8 +317,8 @@ void EEVEE_shadows_draw(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata, DRWView
   DRW_stats_group_start("Cube Shadow Maps");
   {
     for (int cube = 0; cube < linfo->cube_len; cube++) {
-      if (BLI_BITMAP_TEST(cube_visible, cube) && BLI_BITMAP_TEST(linfo->sh_cube_update, cube)) {
-        EEVEE_shadows_draw_cubemap(sldata, vedata, cube);
+      if (BLI_BITMAP_TEST(cube_visible, cube) && EEVEE_shadows_cube_needs_update(linfo, cube)) {
+        EEVEE_shadows_draw_cubemap(sldata, vedata, cube, cube_face_visible);
       }
     }
   }
@@ -120,6 +120,100 @@ bool EEVEE_shadows_cube_setup(EEVEE_LightsInfo *linfo, const EEVEE_Light *evli,
   return update;
 }
 
+/* Size of the side of a cube face at unit distance, see #eevee_ensure_cube_views. */
+static float shadow_cube_face_side(int cube_res)
+{
+  /* This half texel offset is used to ensure correct filtering between faces. */
+  return ((float)cube_res + 1.0f) / (float)(cube_res);
+}
+
+/* Smallest absolute value inside the interval. */
+static float interval_min_abs(float min, float max)
+{
+  if (min > 0.0f) {
+    return min;
+  }
+  if (max < 0.0f) {
+    return -max;
+  }
+  return 0.0f;
+}
+
+void EEVEE_shadows_cube_caster_update(EEVEE_LightsInfo *linfo,
+                                      int cube_index,
+                                      const EEVEE_BoundBox *caster_bbox)
+{
+  const EEVEE_ShadowCube *cube_data = linfo->shadow_cube_data + cube_index;
+  const float side = shadow_cube_face_side(linfo->shadow_cube_size);
+
+  /* Bounds of the caster in the space of the cube, where the faces are aligned with the axes. */
+  float min[3], max[3];
+  INIT_MINMAX(min, max);
+  for (int i = 0; i < 8; i++) {
+    float co[3];
+    for (int axis = 0; axis < 3; axis++) {
+      co[axis] = caster_bbox->center[axis] +
+                 ((i & (1 << axis)) ? caster_bbox->halfdim[axis] : -caster_bbox->halfdim[axis]);
+    }
+    mul_m4_v3(cube_data->shadowmat, co);
+    minmax_v3v3_v3(min, max, co);
+  }
+
+  /* A face sees a point when its distance along the face axis is larger than its distance along
+   * the two other axes. Faces are ordered +X, -X, +Y, -Y, +Z, -Z like #cubefacemat. */
+  for (int face = 0; face < 6; face++) {
+    const int axis = face / 2;
+    const float dist = (face % 2 == 0) ? max[axis] : -min[axis];
+    const float dist_u = interval_min_abs(min[(axis + 1) % 3], max[(axis + 1) % 3]);
+    const float dist_v = interval_min_abs(min[(axis + 2) % 3], max[(axis + 2) % 3]);
+    if (dist >= 0.0f && dist * side >= dist_u && dist * side >= dist_v) {
+      BLI_BITMAP_ENABLE(linfo->sh_cube_face_update, cube_index * 6 + face);
+    }
+  }
+}
+
+bool EEVEE_shadows_cube_needs_update(const EEVEE_LightsInfo *linfo, int cube_index)
+{
+  if (BLI_BITMAP_TEST(linfo->sh_cube_update, cube_index)) {
+    return true;
+  }
+  for (int face = 0; face < 6; face++) {
+    if (BLI_BITMAP_TEST(linfo->sh_cube_face_update, cube_index * 6 + face)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool EEVEE_shadows_cube_face_visible(const EEVEE_LightsInfo *linfo,
+                                     int cube_index,
+                                     int face,
+                                     const DRWView *view)
+{
+  const EEVEE_ShadowCube *cube_data = linfo->shadow_cube_data + cube_index;
+  const EEVEE_Light *evli = linfo->light_data + linfo->shadow_cube_light_indices[cube_index];
+  const EEVEE_Shadow *shdw_data = linfo->shadow_data + (int)evli->shadow_id;
+  const float side = shadow_cube_face_side(linfo->shadow_cube_size);
+  const int axis = face / 2;
+  const float sign = (face % 2 == 0) ? 1.0f : -1.0f;
+
+  float cubemat[4][4];
+  invert_m4_m4(cubemat, (float(*)[4])cube_data->shadowmat);
+
+  /* Frustum of the face, from the near to the far clip distance. */
+  BoundBox bbox;
+  for (int i = 0; i < 8; i++) {
+    const float dist = (i < 4) ? shdw_data->near : shdw_data->far;
+    float *co = bbox.vec[i];
+    co[axis] = sign * dist;
+    co[(axis + 1) % 3] = ((i & 1) ? dist : -dist) * side;
+    co[(axis + 2) % 3] = ((i & 2) ? dist : -dist) * side;
+    mul_m4_v3(cubemat, co);
+  }
+
+  return DRW_culling_box_test(view, &bbox);
+}
+
 static void eevee_ensure_cube_views(
     float near, float far, int cube_res, const float viewmat[4][4], DRWView *view[6])
 {
@@ -162,7 +256,10 @@ static bool spot_angle_fit_single_face(const EEVEE_Light *evli)
   return cos_beta > cosf(DEG2RADF(42.0f));
 }
 
-void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata, int cube_index)
+void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata,
+                                EEVEE_Data *vedata,
+                                int cube_index,
+                                const BLI_bitmap *cube_face_visible)
 {
   EEVEE_PassList *psl = vedata->psl;
   EEVEE_StorageList *stl = vedata->stl;
@@ -173,6 +270,14 @@ void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata,
   EEVEE_Shadow *shdw_data = linfo->shadow_data + (int)evli->shadow_id;
   EEVEE_ShadowCube *cube_data = linfo->shadow_cube_data + (int)shdw_data->type_data_id;
 
+  /* Updating the whole cube is the same as updating all its faces. */
+  if (BLI_BITMAP_TEST(linfo->sh_cube_update, cube_index)) {
+    for (int j = 0; j < 6; j++) {
+      BLI_BITMAP_ENABLE(linfo->sh_cube_face_update, cube_index * 6 + j);
+    }
+    BLI_BITMAP_DISABLE(linfo->sh_cube_update, cube_index);
+  }
+
   eevee_ensure_cube_views(shdw_data->near,
                           shdw_data->far,
                           linfo->shadow_cube_size,
@@ -184,18 +289,26 @@ void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata,
    * The only time it's more beneficial is when the CPU culling overhead
    * outweigh the instancing overhead. which is rarely the case. */
   for (int j = 0; j < 6; j++) {
+    const int face_index = cube_index * 6 + j;
+    if (!BLI_BITMAP_TEST(linfo->sh_cube_face_update, face_index)) {
+      continue;
+    }
     /* Optimization: Only render the needed faces. */
     /* Skip all but -Z face. */
     if (evli->light_type == LA_SPOT && j != 5 && spot_angle_fit_single_face(evli)) {
+      BLI_BITMAP_DISABLE(linfo->sh_cube_face_update, face_index);
       continue;
     }
     /* Skip +Z face. */
     if (evli->light_type != LA_LOCAL && j == 4) {
+      BLI_BITMAP_DISABLE(linfo->sh_cube_face_update, face_index);
+      continue;
+    }
+    /* Faces that are not visible in the view are rendered once they become visible. */
+    if (!BLI_BITMAP_TEST(cube_face_visible, face_index)) {
       continue;
     }
-    /* TODO(fclem): some cube sides can be invisible in the main views. Cull them. */
-    // if (frustum_intersect(g_data->cube_views[j], main_view))
-    //   continue;
+    BLI_BITMAP_DISABLE(linfo->sh_cube_face_update, face_index);
 
     DRW_view_set_active(g_data->cube_views[j]);
     int layer = cube_index * 6 + j;
@@ -204,6 +317,4 @@ void EEVEE_shadows_draw_cubemap(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata,
     GPU_framebuffer_clear_depth(sldata->shadow_fb, 1.0f);
     DRW_draw_pass(psl->shadow_pass);
   }
-
-  BLI_BITMAP_SET(&linfo->sh_cube_update[0], cube_index, false);
 }
@@ -348,6 +348,7 @@ void EEVEE_temporal_sampling_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data
     if (effects->enabled_effects & EFFECT_TAA_REPROJECT) {
       DefaultTextureList *dtxl = DRW_viewport_texture_list_get();
       DRW_shgroup_uniform_texture_ref(grp, "depthBuffer", &dtxl->depth);
+      DRW_shgroup_uniform_texture_ref(grp, "depthHistoryBuffer", &txl->depth_double_buffer);
       DRW_shgroup_uniform_mat4(grp, "prevViewProjectionMatrix", effects->prev_drw_persmat);
     }
     else {
@@ -384,15 +385,11 @@ void EEVEE_temporal_sampling_draw(EEVEE_Data *vedata)
       SWAP_BUFFERS_TAA();
     }
     else {
-      /* Save the depth buffer for the next frame.
-       * This saves us from doing anything special
-       * in the other mode engines. */
-      GPU_framebuffer_blit(fbl->main_fb, 0, fbl->double_buffer_depth_fb, 0, GPU_DEPTH_BIT);
-
       /* Do reprojection for noise reduction */
       /* TODO: do AA jitter if in only render view. */
       if (!DRW_state_is_image_render() && (effects->enabled_effects & EFFECT_TAA_REPROJECT) != 0 &&
           stl->g_data->valid_taa_history) {
+        /* The depth double buffer still contains the depth of the previous frame here. */
         GPU_framebuffer_bind(effects->target_buffer);
         DRW_draw_pass(psl->taa_resolve);
         SWAP_BUFFERS_TAA();
@@ -403,6 +400,11 @@ void EEVEE_temporal_sampling_draw(EEVEE_Data *vedata)
                                                fbl->main_color_fb;
         GPU_framebuffer_blit(source_fb, 0, fbl->taa_history_color_fb, 0, GPU_COLOR_BIT);
       }
+
+      /* Save the depth buffer for the next frame.
+       * This saves us from doing anything special
+       * in the other mode engines. */
+      GPU_framebuffer_blit(fbl->main_fb, 0, fbl->double_buffer_depth_fb, 0, GPU_DEPTH_BIT);
     }
 
     /* Make each loop count when doing a render. */
@@ -4,6 +4,7 @@
 
 uniform sampler2D colorBuffer;
 uniform sampler2D depthBuffer;
+uniform sampler2D depthHistoryBuffer;
 uniform sampler2D colorHistoryBuffer;
 
 uniform mat4 prevViewProjectionMatrix;
@@ -45,11 +46,20 @@ void main()
   /* Compute pixel position in previous frame. */
   float depth = textureLod(depthBuffer, uv, 0.0).r;
   vec3 pos = get_world_space_from_depth(uv, depth);
-  vec2 uv_history = project_point(prevViewProjectionMatrix, pos).xy * 0.5 + 0.5;
+  vec3 ndc_history = project_point(prevViewProjectionMatrix, pos);
+  vec2 uv_history = ndc_history.xy * 0.5 + 0.5;
+
+  /* Reject the history of surfaces that were hidden in the previous frame. The color clamping
+   * alone lets the occluding surface ghost over them. Both depths are linearized with the current
+   * projection, which doesn't change while navigating. */
+  float z_history = get_view_z_from_depth(textureLod(depthHistoryBuffer, uv_history, 0.0).r);
+  float z_expected = get_view_z_from_depth(ndc_history.z * 0.5 + 0.5);
+  bool disoccluded = abs(z_history - z_expected) > max(0.05 * abs(z_expected), 0.01);
 
   /* HACK: Reject lookdev spheres from TAA reprojection. */
   if (depth == 0.0) {
     uv_history = uv;
+    disoccluded = false;
   }
 
   ivec2 texel_history = ivec2(uv_history * screen_res);
@@ -95,7 +105,7 @@ void main()
   color_history = mix(color_history, color, alpha);
 
   bool out_of_view = any(greaterThanEqual(abs(uv_history - 0.5), vec2(0.5)));
-  color_history = (out_of_view) ? color : color_history;
+  color_history = (out_of_view || disoccluded) ? color : color_history;
 
   FragColor = safe_color(color_history);
   /* There is some ghost issue if we use the alpha
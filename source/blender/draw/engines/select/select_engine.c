@@ -9,6 +9,8 @@
 
 #include "DNA_screen_types.h"
 
+#include "GPU_capabilities.h"
+
 #include "UI_resources.h"
 
 #include "DRW_engine.h"
@@ -29,6 +31,8 @@ static struct {
   struct GPUTexture *texture_u32;
 
   SELECTID_Shaders sh_data[GPU_SHADER_CFG_LEN];
+  /* Reduces the id buffer to a bitmap, doesn't depend on the shader configuration. */
+  struct GPUShader *select_id_bitmap;
   struct SELECTID_Context context;
   uint runtime_new_objects;
 } e_data = {NULL}; /* Engine data */
@@ -37,6 +41,7 @@ static struct {
 extern char datatoc_common_view_lib_glsl[];
 extern char datatoc_selection_id_3D_vert_glsl[];
 extern char datatoc_selection_id_frag_glsl[];
+extern char datatoc_selection_id_bitmap_comp_glsl[];
 
 /* -------------------------------------------------------------------- */
 /** \name Utils
@@ -325,6 +330,7 @@ static void select_engine_free(void)
     DRW_SHADER_FREE_SAFE(sh_data->select_id_flat);
     DRW_SHADER_FREE_SAFE(sh_data->select_id_uniform);
   }
+  DRW_SHADER_FREE_SAFE(e_data.select_id_bitmap);
 
   DRW_TEXTURE_FREE_SAFE(e_data.texture_u32);
   GPU_FRAMEBUFFER_FREE_SAFE(e_data.framebuffer_select_id);
@@ -401,6 +407,18 @@ GPUTexture *DRW_engine_select_texture_get(void)
   return e_data.texture_u32;
 }
 
+GPUShader *DRW_engine_select_bitmap_shader_get(void)
+{
+  if (!GPU_compute_shader_support() || !GPU_shader_storage_buffer_objects_support()) {
+    return NULL;
+  }
+  if (!e_data.select_id_bitmap) {
+    e_data.select_id_bitmap = GPU_shader_create_compute(
+        datatoc_selection_id_bitmap_comp_glsl, NULL, NULL, "select_id_bitmap");
+  }
+  return e_data.select_id_bitmap;
+}
+
 /** \} */
 
 #undef SELECT_ENGINE
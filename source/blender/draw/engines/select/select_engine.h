@@ -20,3 +20,8 @@ struct SELECTID_Context *DRW_select_engine_context_get(void);
 
 struct GPUFrameBuffer *DRW_engine_select_framebuffer_get(void);
 struct GPUTexture *DRW_engine_select_texture_get(void);
+/**
+ * Compute shader that reduces a rectangle of the select texture to a bitmap of the ids.
+ * \returns NULL when compute shaders or storage buffers are not supported.
+ */
+struct GPUShader *DRW_engine_select_bitmap_shader_get(void);
@@ -0,0 +1,30 @@
+
+/* Reduce the selection ids inside a rectangle of the id buffer to a bitmap with one bit per
+ * element, so that only the bitmap needs to be read back instead of every pixel. */
+
+layout(local_size_x = 8, local_size_y = 8) in;
+
+uniform usampler2D idBuffer;
+/* Lower left corner and size of the rectangle, in pixels. */
+uniform ivec4 rect;
+/* Number of bits in the bitmap, ids from 1 to bitmapLen are stored. */
+uniform int bitmapLen;
+
+layout(std430, binding = 0) buffer selectBitmap
+{
+  uint bitmap[];
+};
+
+void main()
+{
+  ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+  if (any(greaterThanEqual(texel, rect.zw))) {
+    return;
+  }
+
+  /* Intentionally wrap to max value if the id is zero (nothing drawn). */
+  uint index = texelFetch(idBuffer, rect.xy + texel, 0).r - 1u;
+  if (index < uint(bitmapLen)) {
+    atomicOr(bitmap[index >> 5u], 1u << (index & 31u));
+  }
+}
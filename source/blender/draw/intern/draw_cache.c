@@ -3419,10 +3419,21 @@ void drw_batch_cache_generate_requested(Object *ob)
 
   struct Mesh *mesh_eval = BKE_object_get_evaluated_mesh_no_subsurf(ob);
   switch (ob->type) {
-    case OB_MESH:
-      DRW_mesh_batch_cache_create_requested(
-          DST.task_graph, ob, (Mesh *)ob->data, scene, is_paint_mode, use_hide);
+    case OB_MESH: {
+      Mesh *mesh = (Mesh *)ob->data;
+      /* Outside of edit and paint modes the extraction doesn't depend on the object state, so the
+       * meshes of all objects are extracted together and waited on at the end of cache populate.
+       * This keeps all threads busy in scenes with many small meshes. */
+      if (!is_paint_mode && !use_hide && (mesh->edit_mesh == NULL) && (ob->sculpt == NULL)) {
+        DRW_mesh_batch_cache_create_requested_no_sync(DST.task_graph, ob, mesh, scene);
+        BLI_gset_add(DST.pending_extraction_meshes, mesh);
+      }
+      else {
+        DRW_mesh_batch_cache_create_requested(
+            DST.task_graph, ob, mesh, scene, is_paint_mode, use_hide);
+      }
       break;
+    }
     case OB_CURVES_LEGACY:
     case OB_FONT:
       DRW_curve_batch_cache_create_requested(ob, scene);
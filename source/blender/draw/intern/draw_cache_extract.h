@@ -13,6 +13,8 @@ struct TaskGraph;
 
 #include "DNA_customdata_types.h"
 
+#include "BLI_threads.h"
+
 #include "BKE_attribute.h"
 #include "BKE_object.h"
 
@@ -308,6 +310,23 @@ typedef struct MeshBatchCache {
   float tot_area, tot_uv_area;
 
   bool no_loose_wire;
+
+  /* Task graph running an extraction of this cache which hasn't been waited on yet.
+   * Only set by `DRW_mesh_batch_cache_create_requested_no_sync`. */
+  struct TaskGraph *pending_task_graph;
+  /* Serializes extractor init of the tasks extracting this cache, they write to its buffers. */
+  ThreadMutex extract_init_mutex;
+
+  /* Topology of the mesh this cache was detached from, see `DRW_mesh_batch_cache_detach`.
+   * Only computed when `check_topology` is set. */
+  uint32_t topology_hash;
+  /* Element counts of the mesh the buffers were extracted from, these are always compared. */
+  int topology_totvert, topology_totedge, topology_totloop, topology_totpoly;
+  bool topology_has_ngons;
+  bool check_topology;
+  /* Attached to a new evaluated mesh, the buffers which can't be re-used are discarded
+   * in #DRW_mesh_batch_cache_validate. */
+  bool is_reattached;
 } MeshBatchCache;
 
 #define MBC_EDITUV \
@@ -198,6 +198,7 @@ BLI_INLINE void extract_init(const MeshRenderData *mr,
                              MeshBufferList *mbuflist,
                              void *data_stack)
 {
+  BLI_mutex_lock(&cache->extract_init_mutex);
   uint32_t data_offset = 0;
   for (ExtractorRunData &run_data : extractors) {
     const MeshExtract *extractor = run_data.extractor;
@@ -206,6 +207,7 @@ BLI_INLINE void extract_init(const MeshRenderData *mr,
     extractor->init(mr, cache, run_data.buffer, POINTER_OFFSET(data_stack, data_offset));
     data_offset += (uint32_t)extractor->data_size;
   }
+  BLI_mutex_unlock(&cache->extract_init_mutex);
 }
 
 BLI_INLINE void extract_finish(const MeshRenderData *mr,
@@ -47,6 +47,19 @@ void DRW_curve_batch_cache_free(struct Curve *cu);
 void DRW_mesh_batch_cache_dirty_tag(struct Mesh *me, eMeshBatchDirtyMode mode);
 void DRW_mesh_batch_cache_validate(struct Object *object, struct Mesh *me);
 void DRW_mesh_batch_cache_free(struct Mesh *me);
+/**
+ * Detach the batch cache from an evaluated mesh which is about to be replaced by a new evaluation.
+ * Returns NULL when nothing from the cache can be re-used, the cache stays on the mesh then.
+ * Called from depsgraph evaluation, so no GPU resources are touched.
+ */
+void *DRW_mesh_batch_cache_detach(struct Mesh *me, bool check_topology);
+/**
+ * Give a cache returned by #DRW_mesh_batch_cache_detach to the new evaluated mesh. When only the
+ * vertex positions changed, the topology dependent buffers (index buffers, UVs) are kept and only
+ * positions and normals are extracted again, see #DRW_mesh_batch_cache_validate. The cache is
+ * freed when `me` is NULL or can't take it.
+ */
+void DRW_mesh_batch_cache_attach(struct Mesh *me, void *batch_cache);
 
 void DRW_lattice_batch_cache_dirty_tag(struct Lattice *lt, int mode);
 void DRW_lattice_batch_cache_validate(struct Lattice *lt);
@@ -146,6 +159,11 @@ void DRW_displist_vertbuf_create_loop_pos_and_nor_and_uv_and_tan(struct ListBase
                                                                  struct GPUVertBuf *vbo_uv,
                                                                  struct GPUVertBuf *vbo_tan,
                                                                  const struct Scene *scene);
+/**
+ * Forget about the extraction started by #DRW_mesh_batch_cache_create_requested_no_sync.
+ * Must be called once its task graph has been waited on, before the task graph is freed.
+ */
+void DRW_mesh_batch_cache_pending_extraction_clear(struct Mesh *me);
 void DRW_displist_indexbuf_create_lines_in_order(struct ListBase *lb, struct GPUIndexBuf *ibo);
 void DRW_displist_indexbuf_create_triangles_in_order(struct ListBase *lb, struct GPUIndexBuf *ibo);
 void DRW_displist_indexbuf_create_triangles_loop_split_by_material(struct ListBase *lb,
@@ -215,6 +233,21 @@ void DRW_mesh_batch_cache_create_requested(struct TaskGraph *task_graph,
                                            const struct Scene *scene,
                                            bool is_paint_mode,
                                            bool use_hide);
+/**
+ * Same as #DRW_mesh_batch_cache_create_requested, but doesn't wait for the extraction to finish,
+ * so that the extraction of many meshes can run together in the same task graph.
+ * Only supported for meshes outside of edit and paint modes. The task graph has to be waited on
+ * before the batch cache of this mesh is validated or requested again, and before drawing.
+ */
+void DRW_mesh_batch_cache_create_requested_no_sync(struct TaskGraph *task_graph,
+                                                   struct Object *ob,
+                                                   struct Mesh *me,
+                                                   const struct Scene *scene);
+/**
+ * Forget about the extraction started by #DRW_mesh_batch_cache_create_requested_no_sync.
+ * Must be called once its task graph has been waited on, before the task graph is freed.
+ */
+void DRW_mesh_batch_cache_pending_extraction_clear(struct Mesh *me);
 
 struct GPUBatch *DRW_mesh_batch_cache_get_all_verts(struct Mesh *me);
 struct GPUBatch *DRW_mesh_batch_cache_get_all_edges(struct Mesh *me);
@@ -17,6 +17,7 @@
 #include "BLI_math_vector.h"
 #include "BLI_math_vector.hh"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_curves_types.h"
@@ -32,7 +33,9 @@
 #include "draw_hair_private.h" /* own include */
 
 using blender::float3;
+using blender::float4;
 using blender::IndexRange;
+using blender::MutableSpan;
 using blender::Span;
 
 static void curves_batch_cache_clear(Curves *curves);
@@ -45,6 +48,15 @@ struct HairBatchCache {
 
   /* settings to determine if cache is invalid */
   bool is_dirty;
+
+  /**
+   * Copy of the curve offsets the strand data was created with. When the cache is tagged dirty
+   * but the topology is unchanged, like after sculpting, only the point buffers are recreated.
+   * The strand data and the index buffers only depend on the topology, so they are kept.
+   */
+  int *curve_offsets;
+  int curve_offsets_len;
+  int curve_offsets_point_len;
 };
 
 /* GPUBatch cache management. */
@@ -55,6 +67,37 @@ static bool curves_batch_cache_valid(Curves *curves)
   return (cache && cache->is_dirty == false);
 }
 
+static bool curves_batch_cache_topology_matches(const HairBatchCache *cache, const Curves *curves)
+{
+  if (cache->curve_offsets == nullptr) {
+    return false;
+  }
+  if (cache->curve_offsets_len != curves->geometry.curve_size + 1 ||
+      cache->curve_offsets_point_len != curves->geometry.point_size) {
+    return false;
+  }
+  return memcmp(cache->curve_offsets,
+                curves->geometry.curve_offsets,
+                sizeof(int) * cache->curve_offsets_len) == 0;
+}
+
+/**
+ * Free the buffers that depend on the point positions, so they are recreated when drawn.
+ * The interpolated points are freed for every subdivision level, since only the level that is
+ * drawn is updated when the points change.
+ */
+static void curves_batch_cache_clear_points(HairBatchCache *cache)
+{
+  GPU_VERTBUF_DISCARD_SAFE(cache->hair.proc_point_buf);
+  GPU_VERTBUF_DISCARD_SAFE(cache->hair.proc_length_buf);
+  GPU_TEXTURE_FREE_SAFE(cache->hair.point_tex);
+  GPU_TEXTURE_FREE_SAFE(cache->hair.length_tex);
+  for (int i = 0; i < MAX_HAIR_SUBDIV; i++) {
+    GPU_VERTBUF_DISCARD_SAFE(cache->hair.final[i].proc_buf);
+    GPU_TEXTURE_FREE_SAFE(cache->hair.final[i].proc_tex);
+  }
+}
+
 static void curves_batch_cache_init(Curves *curves)
 {
   HairBatchCache *cache = static_cast<HairBatchCache *>(curves->batch_cache);
@@ -72,6 +115,12 @@ static void curves_batch_cache_init(Curves *curves)
 
 void DRW_curves_batch_cache_validate(Curves *curves)
 {
+  HairBatchCache *cache = static_cast<HairBatchCache *>(curves->batch_cache);
+  if (cache && cache->is_dirty && curves_batch_cache_topology_matches(cache, curves)) {
+    curves_batch_cache_clear_points(cache);
+    cache->is_dirty = false;
+    return;
+  }
   if (!curves_batch_cache_valid(curves)) {
     curves_batch_cache_clear(curves);
     curves_batch_cache_init(curves);
@@ -107,6 +156,7 @@ static void curves_batch_cache_clear(Curves *curves)
   }
 
   particle_batch_cache_clear_hair(&cache->hair);
+  MEM_SAFE_FREE(cache->curve_offsets);
 }
 
 void DRW_curves_batch_cache_free(Curves *curves)
@@ -128,8 +178,8 @@ static void ensure_seg_pt_count(Curves *curves, ParticleHairCache *curves_cache)
 }
 
 static void curves_batch_cache_fill_segments_proc_pos(Curves *curves,
-                                                      GPUVertBufRaw *attr_step,
-                                                      GPUVertBufRaw *length_step)
+                                                      MutableSpan<float4> posTime_data,
+                                                      MutableSpan<float> hairLength_data)
 {
   /* TODO: use hair radius layer if available. */
   const int curve_size = curves->geometry.curve_size;
@@ -137,34 +187,33 @@ static void curves_batch_cache_fill_segments_proc_pos(Curves *curves,
       curves->geometry);
   Span<float3> positions = geometry.positions();
 
-  for (const int i : IndexRange(curve_size)) {
-    const IndexRange curve_range = geometry.range_for_curve(i);
-
-    Span<float3> spline_positions = positions.slice(curve_range);
-    float total_len = 0.0f;
-    float *seg_data_first;
-    for (const int i_spline : spline_positions.index_range()) {
-      float *seg_data = (float *)GPU_vertbuf_raw_step(attr_step);
-      copy_v3_v3(seg_data, spline_positions[i_spline]);
-      if (i_spline == 0) {
-        seg_data_first = seg_data;
-      }
-      else {
-        total_len += blender::math::distance(spline_positions[i_spline - 1],
-                                             spline_positions[i_spline]);
+  blender::threading::parallel_for(IndexRange(curve_size), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const IndexRange curve_range = geometry.range_for_curve(i);
+
+      Span<float3> spline_positions = positions.slice(curve_range);
+      MutableSpan<float4> spline_posTime_data = posTime_data.slice(curve_range);
+      float total_len = 0.0f;
+      for (const int i_spline : spline_positions.index_range()) {
+        if (i_spline > 0) {
+          total_len += blender::math::distance(spline_positions[i_spline - 1],
+                                               spline_positions[i_spline]);
+        }
+        spline_posTime_data[i_spline] = float4(spline_positions[i_spline].x,
+                                               spline_positions[i_spline].y,
+                                               spline_positions[i_spline].z,
+                                               total_len);
       }
-      seg_data[3] = total_len;
-    }
-    /* Assign length value. */
-    *(float *)GPU_vertbuf_raw_step(length_step) = total_len;
-    if (total_len > 0.0f) {
-      /* Divide by total length to have a [0-1] number. */
-      for ([[maybe_unused]] const int i_spline : spline_positions.index_range()) {
-        seg_data_first[3] /= total_len;
-        seg_data_first += 4;
+      /* Assign length value. */
+      hairLength_data[i] = total_len;
+      if (total_len > 0.0f) {
+        /* Divide by total length to have a [0-1] number. */
+        for (float4 &posTime : spline_posTime_data) {
+          posTime.w /= total_len;
+        }
       }
     }
-  }
+  });
 }
 
 static void curves_batch_cache_ensure_procedural_pos(Curves *curves,
@@ -174,25 +223,25 @@ static void curves_batch_cache_ensure_procedural_pos(Curves *curves,
   if (cache->proc_point_buf == nullptr) {
     /* initialize vertex format */
     GPUVertFormat format = {0};
-    uint pos_id = GPU_vertformat_attr_add(&format, "posTime", GPU_COMP_F32, 4, GPU_FETCH_FLOAT);
+    GPU_vertformat_attr_add(&format, "posTime", GPU_COMP_F32, 4, GPU_FETCH_FLOAT);
 
     cache->proc_point_buf = GPU_vertbuf_create_with_format(&format);
     GPU_vertbuf_data_alloc(cache->proc_point_buf, cache->point_len);
 
-    GPUVertBufRaw point_step;
-    GPU_vertbuf_attr_get_raw_data(cache->proc_point_buf, pos_id, &point_step);
+    /* Both buffers only have a single attribute, so their data can be written directly. */
+    MutableSpan<float4> posTime_data{
+        static_cast<float4 *>(GPU_vertbuf_get_data(cache->proc_point_buf)), cache->point_len};
 
     GPUVertFormat length_format = {0};
-    uint length_id = GPU_vertformat_attr_add(
-        &length_format, "hairLength", GPU_COMP_F32, 1, GPU_FETCH_FLOAT);
+    GPU_vertformat_attr_add(&length_format, "hairLength", GPU_COMP_F32, 1, GPU_FETCH_FLOAT);
 
     cache->proc_length_buf = GPU_vertbuf_create_with_format(&length_format);
     GPU_vertbuf_data_alloc(cache->proc_length_buf, cache->strands_len);
 
-    GPUVertBufRaw length_step;
-    GPU_vertbuf_attr_get_raw_data(cache->proc_length_buf, length_id, &length_step);
+    MutableSpan<float> hairLength_data{
+        static_cast<float *>(GPU_vertbuf_get_data(cache->proc_length_buf)), cache->strands_len};
 
-    curves_batch_cache_fill_segments_proc_pos(curves, &point_step, &length_step);
+    curves_batch_cache_fill_segments_proc_pos(curves, posTime_data, hairLength_data);
 
     /* Create vbo immediately to bind to texture buffer. */
     GPU_vertbuf_use(cache->proc_point_buf);
@@ -227,8 +276,9 @@ static void curves_batch_cache_fill_strands_data(Curves *curves,
 }
 
 static void curves_batch_cache_ensure_procedural_strand_data(Curves *curves,
-                                                             ParticleHairCache *cache)
+                                                             HairBatchCache *batch_cache)
 {
+  ParticleHairCache *cache = &batch_cache->hair;
   GPUVertBufRaw data_step, seg_step;
 
   GPUVertFormat format_data = {0};
@@ -255,6 +305,12 @@ static void curves_batch_cache_ensure_procedural_strand_data(Curves *curves,
   GPU_vertbuf_use(cache->proc_strand_seg_buf);
   cache->strand_seg_tex = GPU_texture_create_from_vertbuf("curves_strand_seg",
                                                           cache->proc_strand_seg_buf);
+
+  MEM_SAFE_FREE(batch_cache->curve_offsets);
+  batch_cache->curve_offsets_len = curves->geometry.curve_size + 1;
+  batch_cache->curve_offsets = static_cast<int *>(
+      MEM_dupallocN(curves->geometry.curve_offsets));
+  batch_cache->curve_offsets_point_len = curves->geometry.point_size;
 }
 
 static void curves_batch_cache_ensure_procedural_final_points(ParticleHairCache *cache, int subdiv)
@@ -352,7 +408,7 @@ bool hair_ensure_procedural_data(Object *object,
 
   /* Refreshed if active layer or custom data changes. */
   if ((*r_hair_cache)->strand_tex == nullptr) {
-    curves_batch_cache_ensure_procedural_strand_data(curves, &cache->hair);
+    curves_batch_cache_ensure_procedural_strand_data(curves, cache);
   }
 
   /* Refreshed only on subdiv count change. */
@@ -13,6 +13,7 @@
 #include "BLI_bitmap.h"
 #include "BLI_buffer.h"
 #include "BLI_edgehash.h"
+#include "BLI_hash_mm2a.h"
 #include "BLI_listbase.h"
 #include "BLI_math_bits.h"
 #include "BLI_math_vector.h"
@@ -224,7 +225,8 @@ static DRWBatchFlag g_buffer_deps_d[ARRAY_SIZE(g_buffer_deps)] = {0};
 #endif
 
 static void mesh_batch_cache_discard_surface_batches(MeshBatchCache *cache);
-static void mesh_batch_cache_clear(Mesh *me);
+static void mesh_batch_cache_clear(MeshBatchCache *cache);
+static void mesh_batch_cache_reattach(Mesh *me, MeshBatchCache *cache);
 
 static void mesh_batch_cache_discard_batch(MeshBatchCache *cache, const DRWBatchFlag batch_map)
 {
@@ -822,8 +824,10 @@ static void mesh_batch_cache_init(Object *object, Mesh *me)
     cache = me->runtime.batch_cache = MEM_callocN(sizeof(*cache), __func__);
   }
   else {
+    BLI_mutex_end(&cache->extract_init_mutex);
     memset(cache, 0, sizeof(*cache));
   }
+  BLI_mutex_init(&cache->extract_init_mutex);
 
   cache->is_editmode = me->edit_mesh != NULL;
 
@@ -845,10 +849,33 @@ static void mesh_batch_cache_init(Object *object, Mesh *me)
   drw_mesh_weight_state_clear(&cache->weight_state);
 }
 
+static void mesh_batch_cache_pending_extraction_wait(Mesh *me)
+{
+  MeshBatchCache *cache = me->runtime.batch_cache;
+  if (cache && cache->pending_task_graph) {
+    BLI_task_graph_work_and_wait(cache->pending_task_graph);
+    cache->pending_task_graph = NULL;
+  }
+}
+
+void DRW_mesh_batch_cache_pending_extraction_clear(Mesh *me)
+{
+  MeshBatchCache *cache = me->runtime.batch_cache;
+  if (cache) {
+    cache->pending_task_graph = NULL;
+  }
+}
+
 void DRW_mesh_batch_cache_validate(Object *object, Mesh *me)
 {
+  /* Buffers can't be discarded while they are being extracted. */
+  mesh_batch_cache_pending_extraction_wait(me);
+  MeshBatchCache *cache = me->runtime.batch_cache;
+  if (cache && cache->is_reattached) {
+    mesh_batch_cache_reattach(me, cache);
+  }
   if (!mesh_batch_cache_valid(object, me)) {
-    mesh_batch_cache_clear(me);
+    mesh_batch_cache_clear(me->runtime.batch_cache);
     mesh_batch_cache_init(object, me);
   }
 }
@@ -1050,9 +1077,8 @@ static void mesh_batch_cache_free_subdiv_cache(MeshBatchCache *cache)
   }
 }
 
-static void mesh_batch_cache_clear(Mesh *me)
+static void mesh_batch_cache_clear(MeshBatchCache *cache)
 {
-  MeshBatchCache *cache = me->runtime.batch_cache;
   if (!cache) {
     return;
   }
@@ -1083,8 +1109,167 @@ static void mesh_batch_cache_clear(Mesh *me)
 
 void DRW_mesh_batch_cache_free(Mesh *me)
 {
-  mesh_batch_cache_clear(me);
-  MEM_SAFE_FREE(me->runtime.batch_cache);
+  mesh_batch_cache_pending_extraction_wait(me);
+  MeshBatchCache *cache = me->runtime.batch_cache;
+  if (cache) {
+    mesh_batch_cache_clear(cache);
+    BLI_mutex_end(&cache->extract_init_mutex);
+    MEM_freeN(cache);
+    me->runtime.batch_cache = NULL;
+  }
+}
+
+/**
+ * Hash everything the buffers kept by #DRW_mesh_batch_cache_attach depend on.
+ * Vertex positions are deliberately not part of it.
+ */
+static uint32_t mesh_batch_cache_topology_hash(const Mesh *me, bool *r_has_ngons)
+{
+  BLI_HashMurmur2A mm2;
+  BLI_hash_mm2a_init(&mm2, 0);
+  BLI_hash_mm2a_add_int(&mm2, me->totvert);
+  BLI_hash_mm2a_add_int(&mm2, me->totedge);
+  BLI_hash_mm2a_add_int(&mm2, me->totloop);
+  BLI_hash_mm2a_add_int(&mm2, me->totpoly);
+  if (me->medge) {
+    BLI_hash_mm2a_add(&mm2, (const uchar *)me->medge, sizeof(*me->medge) * (size_t)me->totedge);
+  }
+  if (me->mloop) {
+    BLI_hash_mm2a_add(&mm2, (const uchar *)me->mloop, sizeof(*me->mloop) * (size_t)me->totloop);
+  }
+  if (me->mpoly) {
+    BLI_hash_mm2a_add(&mm2, (const uchar *)me->mpoly, sizeof(*me->mpoly) * (size_t)me->totpoly);
+  }
+  /* Layer names and the active layers end up in the attribute names of the UV buffer. */
+  BLI_hash_mm2a_add_int(&mm2, CustomData_get_active_layer(&me->ldata, CD_MLOOPUV));
+  BLI_hash_mm2a_add_int(&mm2, CustomData_get_render_layer(&me->ldata, CD_MLOOPUV));
+  BLI_hash_mm2a_add_int(&mm2, CustomData_get_stencil_layer(&me->ldata, CD_MLOOPUV));
+  for (int i = 0; i < me->ldata.totlayer; i++) {
+    const CustomDataLayer *layer = &me->ldata.layers[i];
+    if (layer->type != CD_MLOOPUV) {
+      continue;
+    }
+    BLI_hash_mm2a_add(&mm2, (const uchar *)layer->name, strlen(layer->name));
+    BLI_hash_mm2a_add(&mm2, (const uchar *)layer->data, sizeof(MLoopUV) * (size_t)me->totloop);
+  }
+
+  /* N-gons are triangulated based on the vertex positions. */
+  *r_has_ngons = false;
+  for (int i = 0; i < me->totpoly; i++) {
+    if (me->mpoly[i].totloop > 4) {
+      *r_has_ngons = true;
+      break;
+    }
+  }
+  return BLI_hash_mm2a_end(&mm2);
+}
+
+void *DRW_mesh_batch_cache_detach(Mesh *me, const bool check_topology)
+{
+  MeshBatchCache *cache = me->runtime.batch_cache;
+  if (cache->is_editmode || cache->is_dirty || cache->subdiv_cache ||
+      cache->pending_task_graph) {
+    return NULL;
+  }
+  me->runtime.batch_cache = NULL;
+  /* A cache which was never drawn since the last evaluation keeps the topology it had then. */
+  if (!cache->is_reattached) {
+    cache->topology_totvert = me->totvert;
+    cache->topology_totedge = me->totedge;
+    cache->topology_totloop = me->totloop;
+    cache->topology_totpoly = me->totpoly;
+  }
+  if (!cache->is_reattached || !cache->check_topology) {
+    cache->check_topology = check_topology;
+    if (check_topology) {
+      cache->topology_hash = mesh_batch_cache_topology_hash(me, &cache->topology_has_ngons);
+    }
+  }
+  return cache;
+}
+
+void DRW_mesh_batch_cache_attach(Mesh *me, void *batch_cache)
+{
+  MeshBatchCache *cache = batch_cache;
+  if ((me == NULL) || (me->runtime.batch_cache != NULL) || (me->edit_mesh != NULL)) {
+    mesh_batch_cache_clear(cache);
+    BLI_mutex_end(&cache->extract_init_mutex);
+    MEM_freeN(cache);
+    return;
+  }
+  cache->is_reattached = true;
+  me->runtime.batch_cache = cache;
+}
+
+/**
+ * Discard what a cache given to a new evaluated mesh by #DRW_mesh_batch_cache_attach can't re-use.
+ * This runs in the draw manager sync, as GPU resources can't be freed during evaluation.
+ */
+static void mesh_batch_cache_reattach(Mesh *me, MeshBatchCache *cache)
+{
+  cache->is_reattached = false;
+
+  /* The update tags used to skip the topology hash can't be relied on for every change, but the
+   * kept index buffers must never reference elements which don't exist anymore. */
+  if ((me->totvert != cache->topology_totvert) || (me->totedge != cache->topology_totedge) ||
+      (me->totloop != cache->topology_totloop) || (me->totpoly != cache->topology_totpoly)) {
+    cache->is_dirty = true;
+    return;
+  }
+
+  bool has_ngons = false;
+  if (cache->check_topology) {
+    if ((mesh_batch_cache_topology_hash(me, &has_ngons) != cache->topology_hash) ||
+        (has_ngons != cache->topology_has_ngons)) {
+      /* Everything is extracted again. */
+      cache->is_dirty = true;
+      return;
+    }
+  }
+  else {
+    /* N-gons are triangulated based on the vertex positions. */
+    for (int i = 0; i < me->totpoly; i++) {
+      if (me->mpoly[i].totloop > 4) {
+        has_ngons = true;
+        break;
+      }
+    }
+  }
+
+  /* Only keep the buffers which don't depend on the vertex positions. Positions and normals are
+   * extracted again into the existing cache, everything topology related is kept. */
+  MeshBufferList *mbuflist = &cache->final.buff;
+  GPUVertBuf **vbos = (GPUVertBuf **)&mbuflist->vbo;
+  for (int i = 0; i < sizeof(mbuflist->vbo) / sizeof(void *); i++) {
+    if (&vbos[i] != &mbuflist->vbo.uv) {
+      GPU_VERTBUF_DISCARD_SAFE(vbos[i]);
+    }
+  }
+  GPUIndexBuf **ibos = (GPUIndexBuf **)&mbuflist->ibo;
+  for (int i = 0; i < sizeof(mbuflist->ibo) / sizeof(void *); i++) {
+    GPUIndexBuf **ibo = &ibos[i];
+    if (ibo == &mbuflist->ibo.lines || ibo == &mbuflist->ibo.lines_loose) {
+      continue;
+    }
+    if (!has_ngons && (ibo == &mbuflist->ibo.tris || ibo == &mbuflist->ibo.lines_adjacency)) {
+      continue;
+    }
+    GPU_INDEXBUF_DISCARD_SAFE(*ibo);
+  }
+  if (has_ngons) {
+    for (int i = 0; i < cache->mat_len; i++) {
+      GPU_INDEXBUF_DISCARD_SAFE(cache->tris_per_mat[i]);
+    }
+  }
+
+  /* Batches are cheap to create again, and they reference the buffers discarded above. */
+  for (int i = 0; i < sizeof(cache->batch) / sizeof(void *); i++) {
+    GPUBatch **batch = (GPUBatch **)&cache->batch;
+    GPU_BATCH_DISCARD_SAFE(batch[i]);
+  }
+  mesh_batch_cache_discard_surface_batches(cache);
+  cache->batch_ready = 0;
+  drw_mesh_weight_state_clear(&cache->weight_state);
 }
 
 /** \} */
@@ -1535,14 +1720,16 @@ static void drw_mesh_batch_cache_check_available(struct TaskGraph *task_graph, M
 }
 #endif
 
-void DRW_mesh_batch_cache_create_requested(struct TaskGraph *task_graph,
-                                           Object *ob,
-                                           Mesh *me,
-                                           const Scene *scene,
-                                           const bool is_paint_mode,
-                                           const bool use_hide)
+static void mesh_batch_cache_create_requested_ex(struct TaskGraph *task_graph,
+                                                 Object *ob,
+                                                 Mesh *me,
+                                                 const Scene *scene,
+                                                 const bool is_paint_mode,
+                                                 const bool use_hide,
+                                                 const bool use_sync)
 {
   BLI_assert(task_graph);
+  mesh_batch_cache_pending_extraction_wait(me);
   const ToolSettings *ts = NULL;
   if (scene) {
     ts = scene->toolsettings;
@@ -2095,6 +2282,12 @@ void DRW_mesh_batch_cache_create_requested(struct TaskGraph *task_graph,
                                      ts,
                                      use_hide);
 
+  if (!use_sync) {
+    /* The caller waits for the extraction of all objects at once. */
+    cache->pending_task_graph = task_graph;
+    return;
+  }
+
   /* Ensure that all requested batches have finished.
    * Ideally we want to remove this sync, but there are cases where this doesn't work.
    * See T79038 for example.
@@ -2108,4 +2301,23 @@ void DRW_mesh_batch_cache_create_requested(struct TaskGraph *task_graph,
 #endif
 }
 
+void DRW_mesh_batch_cache_create_requested(struct TaskGraph *task_graph,
+                                           Object *ob,
+                                           Mesh *me,
+                                           const Scene *scene,
+                                           const bool is_paint_mode,
+                                           const bool use_hide)
+{
+  mesh_batch_cache_create_requested_ex(task_graph, ob, me, scene, is_paint_mode, use_hide, true);
+}
+
+void DRW_mesh_batch_cache_create_requested_no_sync(struct TaskGraph *task_graph,
+                                                   Object *ob,
+                                                   Mesh *me,
+                                                   const Scene *scene)
+{
+  BLI_assert(me->edit_mesh == NULL);
+  mesh_batch_cache_create_requested_ex(task_graph, ob, me, scene, false, false, false);
+}
+
 /** \} */
@@ -206,6 +206,8 @@ struct DRW_Global {
 
   struct GPUTexture *ramp;
   struct GPUTexture *weight_ramp;
+  /** Bound in place of images that are still being loaded. */
+  struct GPUTexture *image_placeholder;
 
   struct GPUUniformBuf *view_ubo;
 };
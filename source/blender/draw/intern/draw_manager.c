@@ -14,6 +14,7 @@
 #include "BLI_string.h"
 #include "BLI_task.h"
 #include "BLI_threads.h"
+#include "BLI_trace.h"
 
 #include "BLF_api.h"
 
@@ -155,10 +156,28 @@ static void drw_task_graph_init(void)
   BLI_assert(DST.task_graph == NULL);
   DST.task_graph = BLI_task_graph_create();
   DST.delayed_extraction = BLI_gset_ptr_new(__func__);
+  DST.pending_extraction_meshes = BLI_gset_ptr_new(__func__);
+}
+
+/**
+ * Wait for the mesh extractions pushed without waiting by #drw_batch_cache_generate_requested.
+ * Engines may use the batches in `cache_finish`, so this has to happen before it, like the wait
+ * after every mesh did before (see T79038).
+ */
+static void drw_task_graph_pending_extraction_wait(void)
+{
+  if (DST.pending_extraction_meshes == NULL ||
+      BLI_gset_len(DST.pending_extraction_meshes) == 0) {
+    return;
+  }
+  BLI_task_graph_work_and_wait(DST.task_graph);
+  BLI_gset_clear(DST.pending_extraction_meshes,
+                 (void (*)(void *key))DRW_mesh_batch_cache_pending_extraction_clear);
 }
 
 static void drw_task_graph_deinit(void)
 {
+  drw_task_graph_pending_extraction_wait();
   BLI_task_graph_work_and_wait(DST.task_graph);
 
   BLI_gset_free(DST.delayed_extraction,
@@ -166,6 +185,11 @@ static void drw_task_graph_deinit(void)
   DST.delayed_extraction = NULL;
   BLI_task_graph_work_and_wait(DST.task_graph);
 
+  /* Delayed extraction may have pushed more meshes. */
+  BLI_gset_free(DST.pending_extraction_meshes,
+                (void (*)(void *key))DRW_mesh_batch_cache_pending_extraction_clear);
+  DST.pending_extraction_meshes = NULL;
+
   BLI_task_graph_free(DST.task_graph);
   DST.task_graph = NULL;
 }
@@ -369,6 +393,7 @@ static void draw_unit_state_create(void)
 
   /* TODO(fclem): get rid of this. */
   culling->bsphere.radius = -1.0f;
+  culling->occlusion_flag = 0;
   culling->user_data = NULL;
 
   DRW_handle_increment(&DST.resource_handle);
@@ -476,6 +501,9 @@ void DRW_viewport_data_free(DRWData *drw_data)
     MEM_freeN(drw_data->matrices_ubo);
     MEM_freeN(drw_data->obinfos_ubo);
   }
+  if (drw_data->occlusion != NULL) {
+    drw_occlusion_buffer_free(drw_data->occlusion);
+  }
   MEM_freeN(drw_data);
 }
 
@@ -1073,6 +1101,8 @@ static void drw_engines_cache_populate(Object *ob)
 
 static void drw_engines_cache_finish(void)
 {
+  drw_task_graph_pending_extraction_wait();
+
   DRW_ENABLED_ENGINE_ITER (DST.view_data_active, engine, data) {
     if (engine->cache_finish) {
       engine->cache_finish(data);
@@ -1308,6 +1338,11 @@ void DRW_notify_view_update(const DRWUpdateContext *update_ctx)
   DST.viewport = viewport;
   DST.vmempool = drw_viewport_data_ensure(DST.viewport);
 
+  if (DST.vmempool->occlusion != NULL) {
+    /* The depth of previous redraws may not match the scene anymore. */
+    DST.vmempool->occlusion->scene_updated = true;
+  }
+
   /* Separate update for each stereo view. */
   int view_count = GPU_viewport_is_stereo_get(viewport) ? 2 : 1;
   for (int view = 0; view < view_count; view++) {
@@ -1626,6 +1661,19 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
   drw_manager_init(&DST, viewport, NULL);
   DRW_viewport_colormanagement_set(viewport);
 
+  /* Occlusion culling needs further redraws to fix objects wrongly culled using the previous
+   * redraw, which are not possible for image renders. */
+  const bool use_occlusion_culling = USER_EXPERIMENTAL_TEST(&U, use_draw_occlusion_culling) &&
+                                     !DST.options.is_image_render && !XRAY_ENABLED(v3d) &&
+                                     DST.view_default != NULL;
+  if (use_occlusion_culling) {
+    DST.occlusion = drw_occlusion_buffer_sync(DST.vmempool, DST.view_default);
+  }
+  else if (DST.vmempool->occlusion != NULL) {
+    drw_occlusion_buffer_free(DST.vmempool->occlusion);
+    DST.vmempool->occlusion = NULL;
+  }
+
   const int object_type_exclude_viewport = v3d->object_type_exclude_viewport;
   /* Check if scene needs to perform the populate loop */
   const bool internal_engine = (engine_type->flag & RE_INTERNAL) != 0;
@@ -1651,8 +1699,13 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
   /* Init engines */
   drw_engines_init();
 
+  const bool use_trace = BLI_trace_is_enabled();
+
   /* Cache filling */
   {
+    if (use_trace) {
+      BLI_trace_begin("draw", "Draw Cache Populate");
+    }
     PROFILE_START(stime);
     drw_engines_cache_init();
     drw_engines_world_update(scene);
@@ -1686,6 +1739,9 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
     double *cache_time = DRW_view_data_cache_time_get(DST.view_data_active);
     PROFILE_END_UPDATE(*cache_time, stime);
 #endif
+    if (use_trace) {
+      BLI_trace_end();
+    }
   }
 
   DRW_stats_begin();
@@ -1702,7 +1758,19 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
 
   DRW_draw_callbacks_pre_scene();
 
+  /* Only measures the submission of the draw commands, not the GPU time. */
+  if (use_trace) {
+    BLI_trace_begin("draw", "Draw Scene");
+  }
   drw_engines_draw_scene();
+  if (use_trace) {
+    BLI_trace_end();
+  }
+
+  if (use_occlusion_culling) {
+    drw_occlusion_buffer_update(
+        DST.occlusion, DST.vmempool, DST.default_framebuffer, DST.view_default);
+  }
 
   /* Fix 3D view "lagging" on APPLE and WIN32+NVIDIA. (See T56996, T61474) */
   GPU_flush();
@@ -2925,6 +2993,8 @@ void DRW_engines_register(void)
 
     BKE_mesh_batch_cache_dirty_tag_cb = DRW_mesh_batch_cache_dirty_tag;
     BKE_mesh_batch_cache_free_cb = DRW_mesh_batch_cache_free;
+    BKE_mesh_batch_cache_detach_cb = DRW_mesh_batch_cache_detach;
+    BKE_mesh_batch_cache_attach_cb = DRW_mesh_batch_cache_attach;
 
     BKE_lattice_batch_cache_dirty_tag_cb = DRW_lattice_batch_cache_dirty_tag;
     BKE_lattice_batch_cache_free_cb = DRW_lattice_batch_cache_free;
@@ -2991,6 +3061,7 @@ void DRW_engines_free(void)
   DRW_UBO_FREE_SAFE(G_draw.view_ubo);
   DRW_TEXTURE_FREE_SAFE(G_draw.ramp);
   DRW_TEXTURE_FREE_SAFE(G_draw.weight_ramp);
+  DRW_TEXTURE_FREE_SAFE(G_draw.image_placeholder);
 
   if (DST.draw_list) {
     GPU_draw_list_discard(DST.draw_list);
@@ -104,10 +104,54 @@ typedef struct DRWCullingState {
   /* Culling: Using Bounding Sphere for now for faster culling.
    * Not ideal for planes. Could be extended. */
   BoundSphere bsphere;
+  /** #eDRWOcclusionFlag. */
+  uchar occlusion_flag;
   /* Grrr only used by EEVEE. */
   void *user_data;
 } DRWCullingState;
 
+typedef enum eDRWOcclusionFlag {
+  /** The object can be skipped when it is hidden behind other objects. */
+  DRW_OCCLUSION_TEST = (1 << 0),
+  /** The object was skipped by the last occlusion test of the default view. */
+  DRW_OCCLUSION_CULLED = (1 << 1),
+} eDRWOcclusionFlag;
+
+#define DRW_OCCLUSION_MIP_MAX 12
+
+/**
+ * Farthest depth pyramid of a previous redraw of a viewport, used for occlusion culling.
+ * The depth is read back asynchronously, so the pyramid can be a few redraws old.
+ */
+typedef struct DRWOcclusionBuffer {
+  /** Matrix of the view the depth was rendered with. */
+  float persmat[4][4];
+  /** Size of the depth buffer the pyramid was built from, in pixels. */
+  int src_size[2];
+  int mip_len;
+  int mip_size[DRW_OCCLUSION_MIP_MAX][2];
+  /** Farthest window space depth of each texel. */
+  float *mips[DRW_OCCLUSION_MIP_MAX];
+  /** Redraw the pyramid was built from. */
+  uint redraw;
+
+  /** Depth read of a redraw which isn't available yet. */
+  struct GPUDepthReadBack *readback;
+  float *readback_depth;
+  float readback_persmat[4][4];
+  int readback_size[2];
+  uint readback_redraw;
+  bool readback_pending;
+
+  /** Incremented for every redraw of the viewport. */
+  uint redraw_count;
+  /** Last redraw after which the scene was modified, see #DRW_notify_view_update. */
+  uint scene_update_redraw;
+  bool scene_updated;
+  /** The pyramid was drawn with the current view and scene, so culling with it is exact. */
+  bool is_exact;
+} DRWOcclusionBuffer;
+
 /* Minimum max UBO size is 64KiB. We take the largest
  * UBO struct and alloc the max number.
  * `((1 << 16) / sizeof(DRWObjectMatrix)) = 512`
@@ -531,6 +575,8 @@ typedef struct DRWData {
   struct GPUUniformBuf **obinfos_ubo;
   struct GHash *obattrs_ubo_pool;
   uint ubo_len;
+  /** Occlusion culling data from the previous redraw. */
+  DRWOcclusionBuffer *occlusion;
   /** Texture pool to reuse temp texture across engines. */
   /* TODO(@fclem): The pool could be shared even between view-ports. */
   struct DRWTexturePool *texture_pool;
@@ -629,6 +675,10 @@ typedef struct DRWManager {
   struct TaskGraph *task_graph;
   /* Contains list of objects that needs to be extracted from other objects. */
   struct GSet *delayed_extraction;
+  /* Meshes of which the extraction has been pushed to the task graph without waiting for it. */
+  struct GSet *pending_extraction_meshes;
+  /** Occlusion culling data used by the default view. NULL if occlusion culling is disabled. */
+  DRWOcclusionBuffer *occlusion;
 
   /* ---------- Nothing after this point is cleared after use ----------- */
 
@@ -675,6 +725,21 @@ void drw_batch_cache_generate_requested_evaluated_mesh(Object *ob);
 
 void drw_resource_buffer_finish(DRWData *vmempool);
 
+/**
+ * Get the occlusion buffer of the viewport for the culling of this redraw. The pyramid is
+ * updated from the depth of a previous redraw if its read-back is available.
+ */
+DRWOcclusionBuffer *drw_occlusion_buffer_sync(DRWData *vmempool, const DRWView *view);
+/**
+ * Start reading back the depth of the frame that was just drawn, and request another redraw if
+ * objects were culled using a pyramid which may not match this one.
+ */
+void drw_occlusion_buffer_update(DRWOcclusionBuffer *occlusion,
+                                 DRWData *vmempool,
+                                 GPUFrameBuffer *depth_fb,
+                                 const DRWView *view);
+void drw_occlusion_buffer_free(DRWOcclusionBuffer *occlusion);
+
 /* Procedural Drawing */
 GPUBatch *drw_cache_procedural_points_get(void);
 GPUBatch *drw_cache_procedural_lines_get(void);
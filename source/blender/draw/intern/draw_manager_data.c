@@ -21,6 +21,7 @@
 #include "DNA_meta_types.h"
 
 #include "BLI_alloca.h"
+#include "BLI_ghash.h"
 #include "BLI_hash.h"
 #include "BLI_link_utils.h"
 #include "BLI_listbase.h"
@@ -42,34 +43,121 @@
 /** \name Uniform Buffer Object (DRW_uniformbuffer)
  * \{ */
 
-static void draw_call_sort(DRWCommand *array, DRWCommand *array_tmp, int array_len)
-{
-  /* Count unique batches. Tt's not really important if
-   * there is collisions. If there is a lot of different batches,
-   * the sorting benefit will be negligible.
-   * So at least sort fast! */
-  uchar idx[128] = {0};
-  /* Shift by 6 positions knowing each GPUBatch is > 64 bytes */
-#define KEY(a) ((((size_t)((a).draw.batch)) >> 6) % ARRAY_SIZE(idx))
-  BLI_assert(array_len <= ARRAY_SIZE(idx));
-
-  for (int i = 0; i < array_len; i++) {
-    /* Early out if nothing to sort. */
-    if (++idx[KEY(array[i])] == array_len) {
-      return;
+/**
+ * Reusable storage for sorting runs of #DRWCommandDraw that can span many command chunks.
+ */
+typedef struct DRWCommandSort {
+  /** #GPUBatch to bucket index (+1). */
+  GHash *batch_buckets;
+  DRWCommand *commands;
+  uint *keys;
+  uint *order;
+  uint *bucket_offsets;
+  uint len_alloc;
+} DRWCommandSort;
+
+static void draw_call_sort_ensure(DRWCommandSort *sort, uint len)
+{
+  if (len <= sort->len_alloc) {
+    return;
+  }
+  sort->len_alloc = max_uu(len, sort->len_alloc * 2);
+  /* Only the commands need to be preserved, the other arrays are filled when sorting. */
+  sort->commands = MEM_reallocN(sort->commands, sizeof(*sort->commands) * sort->len_alloc);
+  MEM_SAFE_FREE(sort->keys);
+  MEM_SAFE_FREE(sort->order);
+  MEM_SAFE_FREE(sort->bucket_offsets);
+  sort->keys = MEM_mallocN(sizeof(*sort->keys) * sort->len_alloc, __func__);
+  sort->order = MEM_mallocN(sizeof(*sort->order) * sort->len_alloc, __func__);
+  sort->bucket_offsets = MEM_mallocN(sizeof(*sort->bucket_offsets) * sort->len_alloc, __func__);
+}
+
+/**
+ * Group the draw commands of a run by batch so that #draw_call_batching_do can merge them into
+ * instanced draws and multi-draw-indirect submissions. Batches keep the order of their first
+ * appearance and draws of the same batch keep the order of their resource ID's.
+ */
+static void draw_call_sort(DRWCommandSort *sort,
+                           DRWCommandChunk *run_chunk,
+                           int run_index,
+                           uint run_len)
+{
+  if (run_len < 2) {
+    return;
+  }
+
+  DRWCommand *commands = sort->commands;
+  uint transitions = 0;
+  for (uint i = 1; i < run_len; i++) {
+    if (commands[i].draw.batch != commands[i - 1].draw.batch) {
+      transitions++;
+    }
+  }
+  /* Early out if nothing to sort. */
+  if (transitions == 0) {
+    return;
+  }
+
+  BLI_ghash_clear(sort->batch_buckets, NULL, NULL);
+  uint buckets_len = 0;
+  for (uint i = 0; i < run_len; i++) {
+    void **val;
+    if (!BLI_ghash_ensure_p(sort->batch_buckets, commands[i].draw.batch, &val)) {
+      sort->bucket_offsets[buckets_len] = 0;
+      *val = POINTER_FROM_UINT(++buckets_len);
     }
+    sort->keys[i] = POINTER_AS_UINT(*val) - 1;
+    sort->bucket_offsets[sort->keys[i]]++;
   }
-  /* Accumulate batch indices */
-  for (int i = 1; i < ARRAY_SIZE(idx); i++) {
-    idx[i] += idx[i - 1];
+  /* Every batch is already contiguous. */
+  if (buckets_len == transitions + 1) {
+    return;
   }
-  /* Traverse in reverse to not change the order of the resource ID's. */
-  for (int src = array_len - 1; src >= 0; src--) {
-    array_tmp[--idx[KEY(array[src])]] = array[src];
+  /* Accumulate batch indices. */
+  uint offset = 0;
+  for (uint i = 0; i < buckets_len; i++) {
+    const uint count = sort->bucket_offsets[i];
+    sort->bucket_offsets[i] = offset;
+    offset += count;
+  }
+  for (uint i = 0; i < run_len; i++) {
+    sort->order[sort->bucket_offsets[sort->keys[i]]++] = i;
+  }
+  /* Write back, the run is contiguous but can span many chunks. */
+  DRWCommandChunk *chunk = run_chunk;
+  uint index = (uint)run_index;
+  for (uint i = 0; i < run_len; i++, index++) {
+    if (index == chunk->command_used) {
+      chunk = chunk->next;
+      index = 0;
+    }
+    chunk->commands[index] = commands[sort->order[i]];
   }
-#undef KEY
+}
 
-  memcpy(array, array_tmp, sizeof(*array) * array_len);
+static void draw_shgroup_sort_calls(DRWCommandSort *sort, DRWShadingGroup *shgroup)
+{
+  DRWCommandChunk *run_chunk = NULL;
+  int run_index = 0;
+  uint run_len = 0;
+  /* We can only sort runs of #DRWCommandDraw. Other commands (state changes, select ID, clears,
+   * ...) act as barriers. */
+  for (DRWCommandChunk *chunk = shgroup->cmd.first; chunk; chunk = chunk->next) {
+    for (int i = 0; i < chunk->command_used; i++) {
+      if (command_type_get(chunk->command_type, i) != DRW_CMD_DRAW) {
+        draw_call_sort(sort, run_chunk, run_index, run_len);
+        run_len = 0;
+        continue;
+      }
+      if (run_len == 0) {
+        run_chunk = chunk;
+        run_index = i;
+      }
+      draw_call_sort_ensure(sort, run_len + 1);
+      sort->commands[run_len++] = chunk->commands[i];
+    }
+  }
+  draw_call_sort(sort, run_chunk, run_index, run_len);
 }
 
 void drw_resource_buffer_finish(DRWData *vmempool)
@@ -116,24 +204,20 @@ void drw_resource_buffer_finish(DRWData *vmempool)
 
   DRW_uniform_attrs_pool_flush_all(vmempool->obattrs_ubo_pool);
 
-  /* Aligned alloc to avoid unaligned memcpy. */
-  DRWCommandChunk *chunk_tmp = MEM_mallocN_aligned(sizeof(DRWCommandChunk), 16, "tmp call chunk");
-  DRWCommandChunk *chunk;
+  DRWCommandSort sort = {
+      .batch_buckets = BLI_ghash_ptr_new(__func__),
+  };
+  DRWShadingGroup *shgroup;
   BLI_memblock_iter iter;
-  BLI_memblock_iternew(vmempool->commands, &iter);
-  while ((chunk = BLI_memblock_iterstep(&iter))) {
-    bool sortable = true;
-    /* We can only sort chunks that contain #DRWCommandDraw only. */
-    for (int i = 0; i < ARRAY_SIZE(chunk->command_type) && sortable; i++) {
-      if (chunk->command_type[i] != 0) {
-        sortable = false;
-      }
-    }
-    if (sortable) {
-      draw_call_sort(chunk->commands, chunk_tmp->commands, chunk->command_used);
-    }
+  BLI_memblock_iternew(vmempool->shgroups, &iter);
+  while ((shgroup = BLI_memblock_iterstep(&iter))) {
+    draw_shgroup_sort_calls(&sort, shgroup);
   }
-  MEM_freeN(chunk_tmp);
+  BLI_ghash_free(sort.batch_buckets, NULL, NULL);
+  MEM_SAFE_FREE(sort.commands);
+  MEM_SAFE_FREE(sort.keys);
+  MEM_SAFE_FREE(sort.order);
+  MEM_SAFE_FREE(sort.bucket_offsets);
 }
 
 /** \} */
@@ -608,6 +692,13 @@ static void drw_call_culling_init(DRWCullingState *cull, Object *ob)
     /* Bypass test. */
     cull->bsphere.radius = -1.0f;
   }
+  /* Only meshes drawn with depth test can be hidden by other objects. Overlays of other object
+   * types and modes can draw through surfaces. */
+  cull->occlusion_flag = 0;
+  if (ob != NULL && ob->type == OB_MESH && ob->mode == OB_MODE_OBJECT &&
+      (ob->dtx & OB_DRAW_IN_FRONT) == 0) {
+    cull->occlusion_flag = DRW_OCCLUSION_TEST;
+  }
   /* Reset user data */
   cull->user_data = NULL;
 }
@@ -1430,17 +1521,55 @@ static void drw_shgroup_material_texture(DRWShadingGroup *grp,
   GPU_texture_ref(gputex);
 }
 
+static GPUTexture *drw_image_placeholder_texture_get(void)
+{
+  if (G_draw.image_placeholder == NULL) {
+    const float color[4] = {0.5f, 0.5f, 0.5f, 1.0f};
+    G_draw.image_placeholder = GPU_texture_create_2d(
+        "image_placeholder", 1, 1, 1, GPU_RGBA8, color);
+  }
+  return G_draw.image_placeholder;
+}
+
 void DRW_shgroup_add_material_resources(DRWShadingGroup *grp, struct GPUMaterial *material)
 {
   ListBase textures = GPU_material_textures(material);
 
+  /* Load all images of the material which don't have a texture yet at once. */
+  Image *images[32];
+  ImageUser *iusers[32];
+  int images_len = 0;
+  LISTBASE_FOREACH (GPUMaterialTexture *, tex, &textures) {
+    if (tex->ima && images_len < ARRAY_SIZE(images)) {
+      images[images_len] = tex->ima;
+      iusers[images_len] = tex->iuser_available ? &tex->iuser : NULL;
+      images_len++;
+    }
+  }
+  /* Final renders need every texture, in the viewport images are loaded in the background and
+   * drawn with a placeholder until they are ready. */
+  const bool use_async_load = !DRW_state_is_image_render();
+  if (use_async_load && images_len > 0) {
+    BKE_image_load_gpu_textures_async(images, iusers, images_len);
+  }
+  /* Tiled images and images which are not loaded in the background. */
+  if (images_len > 1) {
+    BKE_image_prefetch_gpu_textures(images, iusers, images_len);
+  }
+
   /* Bind all textures needed by the material. */
   LISTBASE_FOREACH (GPUMaterialTexture *, tex, &textures) {
     if (tex->ima) {
       /* Image */
       GPUTexture *gputex;
       ImageUser *iuser = tex->iuser_available ? &tex->iuser : NULL;
-      if (tex->tiled_mapping_name[0]) {
+      if (use_async_load && BKE_image_is_loading_gpu_texture(tex->ima)) {
+        drw_shgroup_material_texture(
+            grp, drw_image_placeholder_texture_get(), tex->sampler_name, tex->sampler_state);
+        /* Redraw until the image is loaded. */
+        DRW_viewport_request_redraw();
+      }
+      else if (tex->tiled_mapping_name[0]) {
         gputex = BKE_image_get_gpu_tiles(tex->ima, iuser, NULL);
         drw_shgroup_material_texture(grp, gputex, tex->sampler_name, tex->sampler_state);
         gputex = BKE_image_get_gpu_tilemap(tex->ima, iuser, NULL);
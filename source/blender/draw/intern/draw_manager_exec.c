@@ -460,6 +460,75 @@ void DRW_culling_frustum_planes_get(const DRWView *view, float planes[6][4])
   memcpy(planes, view->frustum_planes, sizeof(float[6][4]));
 }
 
+/* Size in pixels of the texels of the first level of the occlusion pyramid, as a shift. */
+#define OCCLUSION_MIP0_SHIFT 2
+
+/**
+ * Return true if the sphere is hidden behind the depth of the occlusion buffer.
+ * Conservative: anything that cannot be tested reliably is reported as visible.
+ */
+static bool draw_culling_occlusion_test(const DRWOcclusionBuffer *occlusion,
+                                        const BoundSphere *bsphere)
+{
+  /* Window space bounds of the bounding box of the sphere. */
+  float min[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+  float max[2] = {-FLT_MAX, -FLT_MAX};
+  for (int i = 0; i < 8; i++) {
+    float co[4] = {
+        bsphere->center[0] + ((i & 1) ? bsphere->radius : -bsphere->radius),
+        bsphere->center[1] + ((i & 2) ? bsphere->radius : -bsphere->radius),
+        bsphere->center[2] + ((i & 4) ? bsphere->radius : -bsphere->radius),
+        1.0f,
+    };
+    mul_m4_v4(occlusion->persmat, co);
+    if (co[3] <= FLT_EPSILON) {
+      /* Crosses the camera plane. */
+      return false;
+    }
+    mul_v3_fl(co, 1.0f / co[3]);
+    min[0] = min_ff(min[0], co[0]);
+    min[1] = min_ff(min[1], co[1]);
+    min[2] = min_ff(min[2], co[2]);
+    max[0] = max_ff(max[0], co[0]);
+    max[1] = max_ff(max[1], co[1]);
+  }
+  if (min[2] < -1.0f) {
+    /* Crosses the near clip plane. */
+    return false;
+  }
+  const float depth = min[2] * 0.5f + 0.5f;
+
+  /* Pixel bounds, clamped to the screen. */
+  int px_min[2], px_max[2];
+  for (int i = 0; i < 2; i++) {
+    const float size = (float)occlusion->src_size[i];
+    px_min[i] = (int)(clamp_f(min[i] * 0.5f + 0.5f, 0.0f, 1.0f) * size);
+    px_max[i] = (int)(clamp_f(max[i] * 0.5f + 0.5f, 0.0f, 1.0f) * size);
+    px_max[i] = min_ii(px_max[i], occlusion->src_size[i] - 1);
+    px_min[i] = min_ii(px_min[i], px_max[i]);
+  }
+
+  /* Use the first level where the bounds cover at most 2x2 texels. */
+  int level = 0;
+  for (; level < occlusion->mip_len - 1; level++) {
+    const int shift = OCCLUSION_MIP0_SHIFT + level;
+    if ((px_max[0] >> shift) - (px_min[0] >> shift) <= 1 &&
+        (px_max[1] >> shift) - (px_min[1] >> shift) <= 1) {
+      break;
+    }
+  }
+  const int shift = OCCLUSION_MIP0_SHIFT + level;
+  const int *mip_size = occlusion->mip_size[level];
+  const float *mip = occlusion->mips[level];
+  float farthest = 0.0f;
+  for (int y = px_min[1] >> shift; y <= min_ii(px_max[1] >> shift, mip_size[1] - 1); y++) {
+    for (int x = px_min[0] >> shift; x <= min_ii(px_max[0] >> shift, mip_size[0] - 1); x++) {
+      farthest = max_ff(farthest, mip[y * mip_size[0] + x]);
+    }
+  }
+  return depth > farthest;
+}
+
 static void draw_compute_culling(DRWView *view)
 {
   view = view->parent ? view->parent : view;
@@ -494,6 +563,13 @@ static void draw_compute_culling(DRWView *view)
       }
 #endif
 
+      if (!culled && DST.occlusion != NULL && DST.occlusion->mip_len > 0 &&
+          view == DST.view_default &&
+          (cull->occlusion_flag & DRW_OCCLUSION_TEST)) {
+        culled = draw_culling_occlusion_test(DST.occlusion, &cull->bsphere);
+        SET_FLAG_FROM_TEST(cull->occlusion_flag, culled, DRW_OCCLUSION_CULLED);
+      }
+
       if (view->visibility_fn) {
         culled = !view->visibility_fn(!culled, cull->user_data);
       }
@@ -505,6 +581,144 @@ static void draw_compute_culling(DRWView *view)
   view->is_dirty = false;
 }
 
+static void draw_occlusion_buffer_mips_free(DRWOcclusionBuffer *occlusion)
+{
+  for (int i = 0; i < occlusion->mip_len; i++) {
+    MEM_freeN(occlusion->mips[i]);
+  }
+  occlusion->mip_len = 0;
+}
+
+void drw_occlusion_buffer_free(DRWOcclusionBuffer *occlusion)
+{
+  draw_occlusion_buffer_mips_free(occlusion);
+  GPU_depth_readback_free(occlusion->readback);
+  MEM_SAFE_FREE(occlusion->readback_depth);
+  MEM_freeN(occlusion);
+}
+
+static void draw_occlusion_buffer_mips_alloc(DRWOcclusionBuffer *occlusion, const int size[2])
+{
+  copy_v2_v2_int(occlusion->src_size, size);
+
+  const int mip0_len = 1 << OCCLUSION_MIP0_SHIFT;
+  int mip_size[2] = {divide_ceil_u(size[0], mip0_len), divide_ceil_u(size[1], mip0_len)};
+  for (int i = 0; i < DRW_OCCLUSION_MIP_MAX; i++) {
+    copy_v2_v2_int(occlusion->mip_size[i], mip_size);
+    occlusion->mips[i] = MEM_mallocN(sizeof(float) * mip_size[0] * mip_size[1], __func__);
+    occlusion->mip_len++;
+    if (mip_size[0] == 1 && mip_size[1] == 1) {
+      break;
+    }
+    mip_size[0] = divide_ceil_u(mip_size[0], 2);
+    mip_size[1] = divide_ceil_u(mip_size[1], 2);
+  }
+}
+
+/** Store the farthest depth of each block of pixels in the pyramid levels. */
+static void draw_occlusion_buffer_build(DRWOcclusionBuffer *occlusion, const float *depth)
+{
+  const int *src_size = occlusion->src_size;
+  const int *mip0_size = occlusion->mip_size[0];
+  for (int y = 0; y < mip0_size[1]; y++) {
+    const int src_y_end = min_ii((y + 1) << OCCLUSION_MIP0_SHIFT, src_size[1]);
+    for (int x = 0; x < mip0_size[0]; x++) {
+      const int src_x_end = min_ii((x + 1) << OCCLUSION_MIP0_SHIFT, src_size[0]);
+      float farthest = 0.0f;
+      for (int src_y = y << OCCLUSION_MIP0_SHIFT; src_y < src_y_end; src_y++) {
+        for (int src_x = x << OCCLUSION_MIP0_SHIFT; src_x < src_x_end; src_x++) {
+          farthest = max_ff(farthest, depth[src_y * src_size[0] + src_x]);
+        }
+      }
+      occlusion->mips[0][y * mip0_size[0] + x] = farthest;
+    }
+  }
+
+  for (int i = 1; i < occlusion->mip_len; i++) {
+    const int *prev_size = occlusion->mip_size[i - 1];
+    const int *size = occlusion->mip_size[i];
+    const float *prev = occlusion->mips[i - 1];
+    for (int y = 0; y < size[1]; y++) {
+      const int y0 = y * 2, y1 = min_ii(y * 2 + 1, prev_size[1] - 1);
+      for (int x = 0; x < size[0]; x++) {
+        const int x0 = x * 2, x1 = min_ii(x * 2 + 1, prev_size[0] - 1);
+        occlusion->mips[i][y * size[0] + x] = max_ff(
+            max_ff(prev[y0 * prev_size[0] + x0], prev[y0 * prev_size[0] + x1]),
+            max_ff(prev[y1 * prev_size[0] + x0], prev[y1 * prev_size[0] + x1]));
+      }
+    }
+  }
+}
+
+DRWOcclusionBuffer *drw_occlusion_buffer_sync(DRWData *vmempool, const DRWView *view)
+{
+  DRWOcclusionBuffer *occlusion = vmempool->occlusion;
+  if (occlusion == NULL) {
+    occlusion = vmempool->occlusion = MEM_callocN(sizeof(*occlusion), __func__);
+    occlusion->readback = GPU_depth_readback_create();
+  }
+  occlusion->redraw_count++;
+  if (occlusion->scene_updated) {
+    occlusion->scene_update_redraw = occlusion->redraw_count;
+    occlusion->scene_updated = false;
+  }
+
+  /* Never waits for the GPU, the depth of a previous redraw is used until it is available. */
+  if (occlusion->readback_pending &&
+      GPU_depth_readback_result(occlusion->readback, occlusion->readback_depth)) {
+    occlusion->readback_pending = false;
+    if (!equals_v2v2_int(occlusion->src_size, occlusion->readback_size)) {
+      draw_occlusion_buffer_mips_free(occlusion);
+      draw_occlusion_buffer_mips_alloc(occlusion, occlusion->readback_size);
+    }
+    draw_occlusion_buffer_build(occlusion, occlusion->readback_depth);
+    copy_m4_m4(occlusion->persmat, occlusion->readback_persmat);
+    occlusion->redraw = occlusion->readback_redraw;
+  }
+
+  occlusion->is_exact = occlusion->mip_len > 0 &&
+                        occlusion->redraw >= occlusion->scene_update_redraw &&
+                        equals_m4m4(occlusion->persmat, view->storage.persmat);
+  return occlusion;
+}
+
+void drw_occlusion_buffer_update(DRWOcclusionBuffer *occlusion,
+                                 DRWData *vmempool,
+                                 GPUFrameBuffer *depth_fb,
+                                 const DRWView *view)
+{
+  /* Only one read is in flight, so that slow GPUs still get a result. */
+  if (!occlusion->readback_pending) {
+    const int size[2] = {(int)DST.size[0], (int)DST.size[1]};
+    if (!equals_v2v2_int(occlusion->readback_size, size)) {
+      MEM_SAFE_FREE(occlusion->readback_depth);
+      occlusion->readback_depth = MEM_mallocN(sizeof(float) * size[0] * size[1], __func__);
+      copy_v2_v2_int(occlusion->readback_size, size);
+    }
+    GPU_depth_readback_start(occlusion->readback, depth_fb, size[0], size[1]);
+    copy_m4_m4(occlusion->readback_persmat, view->storage.persmat);
+    occlusion->readback_redraw = occlusion->redraw_count;
+    occlusion->readback_pending = true;
+  }
+
+  if (occlusion->is_exact) {
+    return;
+  }
+
+  /* Objects culled with the depth of another view or scene state can be visible
+   * (e.g. the view or an occluder moved). Redraw until the depth of the current state is
+   * available. */
+  BLI_memblock_iter iter;
+  BLI_memblock_iternew(vmempool->cullstates, &iter);
+  DRWCullingState *cull;
+  while ((cull = BLI_memblock_iterstep(&iter))) {
+    if (cull->occlusion_flag & DRW_OCCLUSION_CULLED) {
+      DRW_viewport_request_redraw();
+      break;
+    }
+  }
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -12,11 +12,16 @@
 #include "BLI_array_utils.h"
 #include "BLI_bitmap.h"
 #include "BLI_bitmap_draw_2d.h"
+#include "BLI_math_base.h"
 #include "BLI_rect.h"
 
 #include "DNA_screen_types.h"
 
+#include "GPU_capabilities.h"
+#include "GPU_compute.h"
 #include "GPU_select.h"
+#include "GPU_state.h"
+#include "GPU_vertex_buffer.h"
 
 #include "DEG_depsgraph.h"
 #include "DEG_depsgraph_query.h"
@@ -106,6 +111,93 @@ uint *DRW_select_buffer_read(struct Depsgraph *depsgraph,
  *
  * \{ */
 
+/**
+ * Reduce the ids inside the rect to a bitmap on the GPU, so that only the bitmap is read back
+ * instead of every pixel, which is much smaller for large rectangles.
+ *
+ * \returns false when the GPU doesn't support it and the pixels have to be read instead.
+ */
+static bool select_buffer_bitmap_from_rect_gpu(struct Depsgraph *depsgraph,
+                                               struct ARegion *region,
+                                               struct View3D *v3d,
+                                               const rcti *rect,
+                                               uint **r_bitmap,
+                                               uint *r_bitmap_len)
+{
+  if (!GPU_compute_shader_support() || !GPU_shader_storage_buffer_objects_support()) {
+    return false;
+  }
+
+  *r_bitmap = NULL;
+
+  /* Clamp rect, see #DRW_select_buffer_read. */
+  rcti r = {
+      .xmin = 0,
+      .xmax = region->winx,
+      .ymin = 0,
+      .ymax = region->winy,
+  };
+  rcti rect_clamp = *rect;
+  if (!BLI_rcti_isect(&r, &rect_clamp, &rect_clamp)) {
+    return true;
+  }
+
+  struct SELECTID_Context *select_ctx = DRW_select_engine_context_get();
+
+  DRW_opengl_context_enable();
+  /* Update the drawing. */
+  DRW_draw_select_id(depsgraph, region, v3d, rect);
+  GPU_framebuffer_restore();
+
+  if (select_ctx->index_drawn_len > 1) {
+    GPUShader *shader = DRW_engine_select_bitmap_shader_get();
+    GPUTexture *texture = DRW_engine_select_texture_get();
+    const uint bitmap_len = select_ctx->index_drawn_len - 1;
+    const uint bitmap_words_len = BLI_BITMAP_SIZE(bitmap_len) / sizeof(BLI_bitmap);
+
+    static GPUVertFormat format = {0};
+    if (format.attr_len == 0) {
+      GPU_vertformat_attr_add(&format, "bits", GPU_COMP_U32, 1, GPU_FETCH_INT);
+    }
+    GPUVertBuf *bitmap_vbo = GPU_vertbuf_create_with_format_ex(&format, GPU_USAGE_STATIC);
+    GPU_vertbuf_data_alloc(bitmap_vbo, bitmap_words_len);
+    memset(GPU_vertbuf_get_data(bitmap_vbo), 0, bitmap_words_len * sizeof(BLI_bitmap));
+
+    const int rect_data[4] = {
+        rect_clamp.xmin,
+        rect_clamp.ymin,
+        BLI_rcti_size_x(&rect_clamp),
+        BLI_rcti_size_y(&rect_clamp),
+    };
+
+    GPU_shader_bind(shader);
+    GPU_texture_bind(texture, GPU_shader_get_texture_binding(shader, "idBuffer"));
+    GPU_shader_uniform_vector_int(shader, GPU_shader_get_uniform(shader, "rect"), 4, 1, rect_data);
+    GPU_shader_uniform_1i(shader, "bitmapLen", (int)bitmap_len);
+    GPU_vertbuf_bind_as_ssbo(bitmap_vbo, GPU_shader_get_ssbo(shader, "selectBitmap"));
+
+    GPU_compute_dispatch(
+        shader, divide_ceil_u(rect_data[2], 8), divide_ceil_u(rect_data[3], 8), 1);
+    GPU_memory_barrier(GPU_BARRIER_SHADER_STORAGE);
+
+    const void *data = GPU_vertbuf_read(bitmap_vbo);
+    if (data != NULL) {
+      *r_bitmap = GPU_vertbuf_unmap(bitmap_vbo, data);
+      if (r_bitmap_len) {
+        *r_bitmap_len = bitmap_len;
+      }
+    }
+
+    GPU_shader_unbind();
+    GPU_texture_unbind(texture);
+    GPU_vertbuf_discard(bitmap_vbo);
+  }
+
+  DRW_opengl_context_disable();
+
+  return true;
+}
+
 uint *DRW_select_buffer_bitmap_from_rect(struct Depsgraph *depsgraph,
                                          struct ARegion *region,
                                          struct View3D *v3d,
@@ -118,6 +210,12 @@ uint *DRW_select_buffer_bitmap_from_rect(struct Depsgraph *depsgraph,
   rect_px.xmax += 1;
   rect_px.ymax += 1;
 
+  uint *bitmap_gpu;
+  if (select_buffer_bitmap_from_rect_gpu(
+          depsgraph, region, v3d, &rect_px, &bitmap_gpu, r_bitmap_len)) {
+    return bitmap_gpu;
+  }
+
   uint buf_len;
   uint *buf = DRW_select_buffer_read(depsgraph, region, v3d, &rect_px, &buf_len);
   if (buf == NULL) {
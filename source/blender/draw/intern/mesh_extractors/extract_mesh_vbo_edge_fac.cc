@@ -48,10 +48,11 @@ static void extract_edge_fac_init(const MeshRenderData *mr,
                                   void *tls_data)
 {
   GPUVertBuf *vbo = static_cast<GPUVertBuf *>(buf);
-  static GPUVertFormat format = {0};
-  if (format.attr_len == 0) {
+  static GPUVertFormat format = []() {
+    GPUVertFormat format = {0};
     GPU_vertformat_attr_add(&format, "wd", GPU_COMP_U8, 1, GPU_FETCH_INT_TO_FLOAT_UNIT);
-  }
+    return format;
+  }();
 
   GPU_vertbuf_init_with_format(vbo, &format);
   GPU_vertbuf_data_alloc(vbo, mr->loop_len + mr->loop_loose_len);
@@ -178,10 +179,11 @@ static void extract_edge_fac_finish(const MeshRenderData *mr,
     /* Some AMD drivers strangely crash with VBO's with a one byte format.
      * To workaround we reinitialize the VBO with another format and convert
      * all bytes to floats. */
-    static GPUVertFormat format = {0};
-    if (format.attr_len == 0) {
+    static GPUVertFormat format = []() {
+      GPUVertFormat format = {0};
       GPU_vertformat_attr_add(&format, "wd", GPU_COMP_F32, 1, GPU_FETCH_FLOAT);
-    }
+      return format;
+    }();
     /* We keep the data reference in data->vbo_data. */
     data->vbo_data = static_cast<uchar *>(GPU_vertbuf_steal_data(vbo));
     GPU_vertbuf_clear(vbo);
@@ -204,15 +206,16 @@ static void extract_edge_fac_finish(const MeshRenderData *mr,
  * the buggy AMD driver case. */
 static GPUVertFormat *get_subdiv_edge_fac_format()
 {
-  static GPUVertFormat format = {0};
-  if (format.attr_len == 0) {
+  static GPUVertFormat format = []() {
+    GPUVertFormat format = {0};
     if (GPU_crappy_amd_driver()) {
       GPU_vertformat_attr_add(&format, "wd", GPU_COMP_F32, 1, GPU_FETCH_FLOAT);
     }
     else {
       GPU_vertformat_attr_add(&format, "wd", GPU_COMP_U8, 1, GPU_FETCH_INT_TO_FLOAT_UNIT);
     }
-  }
+    return format;
+  }();
   return &format;
 }
 
@@ -102,12 +102,13 @@ static void mesh_render_data_vert_flag(const MeshRenderData *mr,
 
 static GPUVertFormat *get_edit_data_format()
 {
-  static GPUVertFormat format = {0};
-  if (format.attr_len == 0) {
+  static GPUVertFormat format = []() {
+    GPUVertFormat format = {0};
     /* WARNING: Adjust #EditLoopData struct accordingly. */
     GPU_vertformat_attr_add(&format, "data", GPU_COMP_U8, 4, GPU_FETCH_INT);
     GPU_vertformat_alias_add(&format, "flag");
-  }
+    return format;
+  }();
   return &format;
 }
 
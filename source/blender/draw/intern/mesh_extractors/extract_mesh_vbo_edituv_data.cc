@@ -27,12 +27,13 @@ static void extract_edituv_data_init_common(const MeshRenderData *mr,
                                             MeshExtract_EditUVData_Data *data,
                                             uint loop_len)
 {
-  static GPUVertFormat format = {0};
-  if (format.attr_len == 0) {
+  static GPUVertFormat format = []() {
+    GPUVertFormat format = {0};
     /* WARNING: Adjust #EditLoopData struct accordingly. */
     GPU_vertformat_attr_add(&format, "data", GPU_COMP_U8, 4, GPU_FETCH_INT);
     GPU_vertformat_alias_add(&format, "flag");
-  }
+    return format;
+  }();
 
   GPU_vertbuf_init_with_format(vbo, &format);
   GPU_vertbuf_data_alloc(vbo, loop_len);
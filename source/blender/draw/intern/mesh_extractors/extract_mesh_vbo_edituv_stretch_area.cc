@@ -25,10 +25,11 @@ static void extract_edituv_stretch_area_init(const MeshRenderData *mr,
                                              void *UNUSED(tls_data))
 {
   GPUVertBuf *vbo = static_cast<GPUVertBuf *>(buf);
-  static GPUVertFormat format = {0};
-  if (format.attr_len == 0) {
+  static GPUVertFormat format = []() {
+    GPUVertFormat format = {0};
     GPU_vertformat_attr_add(&format, "ratio", GPU_COMP_I16, 1, GPU_FETCH_INT_TO_FLOAT_UNIT);
-  }
+    return format;
+  }();
 
   GPU_vertbuf_init_with_format(vbo, &format);
   GPU_vertbuf_data_alloc(vbo, mr->loop_len);
@@ -138,10 +139,11 @@ static void extract_edituv_stretch_area_init_subdiv(const DRWSubdivCache *subdiv
 
   /* Initialize final buffer. */
   GPUVertBuf *vbo = static_cast<GPUVertBuf *>(buffer);
-  static GPUVertFormat format = {0};
-  if (format.attr_len == 0) {
+  static GPUVertFormat format = []() {
+    GPUVertFormat format = {0};
     GPU_vertformat_attr_add(&format, "ratio", GPU_COMP_F32, 1, GPU_FETCH_FLOAT);
-  }
+    return format;
+  }();
 
   GPU_vertbuf_init_build_on_device(vbo, &format, subdiv_cache->num_subdiv_loops);
 
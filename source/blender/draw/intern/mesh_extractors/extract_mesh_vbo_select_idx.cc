@@ -20,11 +20,12 @@ static void extract_select_idx_init_impl(const MeshRenderData *UNUSED(mr),
                                          void *tls_data)
 {
   GPUVertBuf *vbo = static_cast<GPUVertBuf *>(buf);
-  static GPUVertFormat format = {0};
-  if (format.attr_len == 0) {
+  static GPUVertFormat format = []() {
+    GPUVertFormat format = {0};
     /* TODO: rename "color" to something more descriptive. */
     GPU_vertformat_attr_add(&format, "color", GPU_COMP_U32, 1, GPU_FETCH_INT);
-  }
+    return format;
+  }();
   GPU_vertbuf_init_with_format(vbo, &format);
   GPU_vertbuf_data_alloc(vbo, len);
   *(uint32_t **)tls_data = (uint32_t *)GPU_vertbuf_get_data(vbo);
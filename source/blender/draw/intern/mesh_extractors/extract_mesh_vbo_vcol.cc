@@ -57,12 +57,13 @@ static void init_vcol_format(GPUVertFormat *format,
  * case. */
 static GPUVertFormat *get_coarse_vcol_format()
 {
-  static GPUVertFormat format = {0};
-  if (format.attr_len == 0) {
+  static GPUVertFormat format = []() {
+    GPUVertFormat format = {0};
     GPU_vertformat_attr_add(&format, "cCol", GPU_COMP_F32, 4, GPU_FETCH_FLOAT);
     GPU_vertformat_alias_add(&format, "c");
     GPU_vertformat_alias_add(&format, "ac");
-  }
+    return format;
+  }();
   return &format;
 }
 
@@ -6,6 +6,7 @@
 
 #include <fstream>
 #include <iomanip>
+#include <mutex>
 #include <optional>
 
 #include "ED_asset_indexer.h"
@@ -424,6 +425,11 @@ struct AssetLibraryIndex {
    * Contains absolute paths to the indices.
    */
   Set<std::string> unused_file_indices;
+  /**
+   * Blend files are indexed in parallel. Guards #unused_file_indices and the creation of the
+   * #indices_base_path directory.
+   */
+  std::mutex mutex;
 
   /**
    * \brief Absolute path where the indices of `library` are stored.
@@ -507,6 +513,7 @@ struct AssetLibraryIndex {
 
   void mark_as_used(const std::string &filename)
   {
+    std::lock_guard lock{mutex};
     unused_file_indices.remove(filename);
   }
 
@@ -667,6 +674,7 @@ class AssetIndexFile : public AbstractFile {
 
   bool ensure_parent_path_exists() const
   {
+    std::lock_guard lock{library_index.mutex};
     /* `BLI_make_existing_file` only ensures parent path, otherwise than expected from the name of
      * the function. */
     return BLI_make_existing_file(get_file_path());
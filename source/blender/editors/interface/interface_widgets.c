@@ -1113,8 +1113,9 @@ static void widgetbase_set_uniform_colors_ubv(uiWidgetBase *wtb,
 /** \name Widget Base Drawing #GPUBatch Cache
  * \{ */
 
-/* keep in sync with shader */
-#define MAX_WIDGET_BASE_BATCH 6
+/* Keep in sync with shader. 16 widgets use 768 uniform components, which stays below the
+ * minimum of 1024 vertex uniform components guaranteed by OpenGL 3.3. */
+#define MAX_WIDGET_BASE_BATCH 16
 #define MAX_WIDGET_PARAMETERS 12
 
 static struct {
@@ -340,6 +340,7 @@ static int wm_usd_import_exec(bContext *C, wmOperator *op)
   const bool import_subdiv = RNA_boolean_get(op->ptr, "import_subdiv");
 
   const bool import_instance_proxies = RNA_boolean_get(op->ptr, "import_instance_proxies");
+  const bool load_payloads = RNA_boolean_get(op->ptr, "load_payloads");
 
   const bool import_visible_only = RNA_boolean_get(op->ptr, "import_visible_only");
 
@@ -387,6 +388,7 @@ static int wm_usd_import_exec(bContext *C, wmOperator *op)
                                    .prim_path_mask = prim_path_mask,
                                    .import_subdiv = import_subdiv,
                                    .import_instance_proxies = import_instance_proxies,
+                                   .load_payloads = load_payloads,
                                    .create_collection = create_collection,
                                    .import_guide = import_guide,
                                    .import_proxy = import_proxy,
@@ -428,6 +430,7 @@ static void wm_usd_import_draw(bContext *UNUSED(C), wmOperator *op)
   col = uiLayoutColumnWithHeading(box, true, IFACE_("Include"));
   uiItemR(col, ptr, "import_subdiv", 0, IFACE_("Subdivision"), ICON_NONE);
   uiItemR(col, ptr, "import_instance_proxies", 0, NULL, ICON_NONE);
+  uiItemR(col, ptr, "load_payloads", 0, NULL, ICON_NONE);
   uiItemR(col, ptr, "import_visible_only", 0, NULL, ICON_NONE);
   uiItemR(col, ptr, "import_guide", 0, NULL, ICON_NONE);
   uiItemR(col, ptr, "import_proxy", 0, NULL, ICON_NONE);
@@ -502,7 +505,16 @@ void WM_OT_usd_import(struct wmOperatorType *ot)
                   "import_instance_proxies",
                   true,
                   "Import Instance Proxies",
-                  "Create unique Blender objects for USD instances");
+                  "Create unique Blender objects for USD instances. When disabled, the prototype "
+                  "of the instances is imported once and the instances become collection "
+                  "instances");
+
+  RNA_def_boolean(ot->srna,
+                  "load_payloads",
+                  true,
+                  "Load Payloads",
+                  "Load all payloads of the USD stage. When disabled, only the payloads of the "
+                  "prim path mask are loaded");
 
   RNA_def_boolean(ot->srna,
                   "import_visible_only",
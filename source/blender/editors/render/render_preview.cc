@@ -21,6 +21,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "PIL_time.h"
@@ -1661,6 +1662,8 @@ static void icon_preview_endjob(void *customdata)
  *
  * Note that this will use the OS thumbnail cache, i.e. load a preview from there or add it if not
  * there yet. These two cases may lead to different performance.
+ *
+ * Loading is mostly waiting for the file system, so multiple previews are loaded in parallel.
  */
 class PreviewLoadJob {
   struct RequestedPreview {
@@ -1674,6 +1677,9 @@ class PreviewLoadJob {
   /** All unfinished preview requests, #update_fn() calls #finish_preview_request() on loaded
    * previews and removes them from this list. Only access from the main thread! */
   std::list<struct RequestedPreview> requested_previews_;
+  /** Job flags of #run_fn(), for the loading tasks. */
+  short *stop_ = nullptr;
+  short *do_update_ = nullptr;
 
  public:
   PreviewLoadJob();
@@ -1686,6 +1692,7 @@ class PreviewLoadJob {
 
  private:
   static void run_fn(void *, short *, short *, float *);
+  static void load_fn(TaskPool *__restrict, void *);
   static void update_fn(void *);
   static void end_fn(void *);
   static void free_fn(void *);
@@ -1754,42 +1761,60 @@ void PreviewLoadJob::run_fn(void *customdata,
                             float *UNUSED(progress))
 {
   PreviewLoadJob *job_data = reinterpret_cast<PreviewLoadJob *>(customdata);
+  /* Passed to the tasks as pool user data. */
+  job_data->stop_ = stop;
+  job_data->do_update_ = do_update;
 
   IMB_thumb_locks_acquire();
 
+  TaskPool *pool = BLI_task_pool_create_background(job_data, TASK_PRIORITY_LOW);
+
   while (RequestedPreview *request = reinterpret_cast<RequestedPreview *>(
              BLI_thread_queue_pop_timeout(job_data->todo_queue_, 100))) {
     if (*stop) {
       break;
     }
+    BLI_task_pool_push(pool, load_fn, request, false, nullptr);
+  }
 
-    PreviewImage *preview = request->preview;
+  BLI_task_pool_work_and_wait(pool);
+  BLI_task_pool_free(pool);
 
-    const char *deferred_data = static_cast<char *>(PRV_DEFERRED_DATA(preview));
-    const ThumbSource source = static_cast<ThumbSource>(deferred_data[0]);
-    const char *path = &deferred_data[1];
+  IMB_thumb_locks_release();
+}
 
-    //    printf("loading deferred %d×%d preview for %s\n", request->sizex, request->sizey, path);
+void PreviewLoadJob::load_fn(TaskPool *__restrict pool, void *taskdata)
+{
+  PreviewLoadJob *job_data = static_cast<PreviewLoadJob *>(BLI_task_pool_user_data(pool));
+  RequestedPreview *request = static_cast<RequestedPreview *>(taskdata);
+  if (*job_data->stop_) {
+    return;
+  }
 
-    IMB_thumb_path_lock(path);
-    ImBuf *thumb = IMB_thumb_manage(path, THB_LARGE, source);
-    IMB_thumb_path_unlock(path);
+  PreviewImage *preview = request->preview;
 
-    if (thumb) {
-      /* PreviewImage assumes premultiplied alpha... */
-      IMB_premultiply_alpha(thumb);
+  const char *deferred_data = static_cast<char *>(PRV_DEFERRED_DATA(preview));
+  const ThumbSource source = static_cast<ThumbSource>(deferred_data[0]);
+  const char *path = &deferred_data[1];
 
-      icon_copy_rect(thumb,
-                     preview->w[request->icon_size],
-                     preview->h[request->icon_size],
-                     preview->rect[request->icon_size]);
-      IMB_freeImBuf(thumb);
-    }
+  //    printf("loading deferred %d×%d preview for %s\n", request->sizex, request->sizey, path);
 
-    *do_update = true;
+  IMB_thumb_path_lock(path);
+  ImBuf *thumb = IMB_thumb_manage(path, THB_LARGE, source);
+  IMB_thumb_path_unlock(path);
+
+  if (thumb) {
+    /* PreviewImage assumes premultiplied alpha... */
+    IMB_premultiply_alpha(thumb);
+
+    icon_copy_rect(thumb,
+                   preview->w[request->icon_size],
+                   preview->h[request->icon_size],
+                   preview->rect[request->icon_size]);
+    IMB_freeImBuf(thumb);
   }
 
-  IMB_thumb_locks_release();
+  *job_data->do_update_ = true;
 }
 
 /* Only execute on the main thread! */
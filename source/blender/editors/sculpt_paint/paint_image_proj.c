@@ -5156,6 +5156,16 @@ static void do_projectpaint_thread(TaskPool *__restrict UNUSED(pool), void *ph_v
   /* mem arena for this brush projection only */
   MemArena *softenArena = NULL;
 
+  /* Gradient fill line, the same for all pixels. */
+  float gradient_tangent[2];
+  float gradient_line_len_sq_inv = 0.0f, gradient_line_len = 0.0f;
+  if ((ps->source == PROJ_SRC_VIEW_FILL) && (brush->flag & BRUSH_USE_GRADIENT)) {
+    sub_v2_v2v2(gradient_tangent, pos, lastpos);
+    gradient_line_len = len_squared_v2(gradient_tangent);
+    gradient_line_len_sq_inv = 1.0f / gradient_line_len;
+    gradient_line_len = sqrtf(gradient_line_len);
+  }
+
   if (tool == PAINT_TOOL_SMEAR) {
     pos_ofs[0] = pos[0] - lastpos[0];
     pos_ofs[1] = pos[1] - lastpos[1];
@@ -5202,9 +5212,6 @@ static void do_projectpaint_thread(TaskPool *__restrict UNUSED(pool), void *ph_v
         /* fill tools */
         if (ps->source == PROJ_SRC_VIEW_FILL) {
           if (brush->flag & BRUSH_USE_GRADIENT) {
-            /* these could probably be cached instead of being done per pixel */
-            float tangent[2];
-            float line_len_sq_inv, line_len;
             float f;
             float color_f[4];
             const float p[2] = {
@@ -5212,19 +5219,14 @@ static void do_projectpaint_thread(TaskPool *__restrict UNUSED(pool), void *ph_v
                 projPixel->projCoSS[1] - lastpos[1],
             };
 
-            sub_v2_v2v2(tangent, pos, lastpos);
-            line_len = len_squared_v2(tangent);
-            line_len_sq_inv = 1.0f / line_len;
-            line_len = sqrtf(line_len);
-
             switch (brush->gradient_fill_mode) {
               case BRUSH_GRADIENT_LINEAR: {
-                f = dot_v2v2(p, tangent) * line_len_sq_inv;
+                f = dot_v2v2(p, gradient_tangent) * gradient_line_len_sq_inv;
                 break;
               }
               case BRUSH_GRADIENT_RADIAL:
               default: {
-                f = len_v2(p) / line_len;
+                f = len_v2(p) / gradient_line_len;
                 break;
               }
             }
@@ -178,6 +178,13 @@ typedef struct SculptUndoNode {
   /* Sculpt Face Sets */
   int *face_sets;
 
+  /* Once the undo step is complete, #co, #orig_co, #mask and #col are kept compressed
+   * together here until the step is undone or redone. The number of floats of each array
+   * is stored to restore them. */
+  void *compressed_data;
+  size_t compressed_size;
+  size_t compressed_lens[4];
+
   size_t undo_size;
 } SculptUndoNode;
 
@@ -7,6 +7,7 @@
  */
 
 #include <stddef.h>
+#include <zstd.h>
 
 #include "MEM_guardedalloc.h"
 
@@ -869,6 +870,9 @@ static void sculpt_undo_free_list(ListBase *lb)
     if (unode->mask) {
       MEM_freeN(unode->mask);
     }
+    if (unode->col) {
+      MEM_freeN(unode->col);
+    }
 
     if (unode->bm_entry) {
       BM_log_entry_drop(unode->bm_entry);
@@ -882,6 +886,10 @@ static void sculpt_undo_free_list(ListBase *lb)
       MEM_freeN(unode->face_sets);
     }
 
+    if (unode->compressed_data) {
+      MEM_freeN(unode->compressed_data);
+    }
+
     MEM_freeN(unode);
 
     unode = unode_next;
@@ -1410,6 +1418,176 @@ void SCULPT_undo_push_end_ex(const bool use_nested_undo)
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Undo Node Compression
+ *
+ * The per vertex arrays of a complete undo step are only needed again when the step is undone
+ * or redone, so they are compressed in the meantime. The compression is lossless, undo has to
+ * restore the exact coordinates. The bytes of the floats are split into planes before
+ * compression, which puts the similar sign and exponent bytes of neighboring values next to
+ * each other.
+ * \{ */
+
+#define SCULPT_UNDO_COMPRESSION_LEVEL 1
+
+/* The arrays that are compressed, in the order of #SculptUndoNode.compressed_lens. */
+static void sculpt_undo_node_float_arrays(SculptUndoNode *unode, float **r_arrays[4])
+{
+  r_arrays[0] = (float **)&unode->co;
+  r_arrays[1] = (float **)&unode->orig_co;
+  r_arrays[2] = &unode->mask;
+  r_arrays[3] = (float **)&unode->col;
+}
+
+static void sculpt_undo_node_compress(SculptUndoNode *unode)
+{
+  BLI_assert(unode->compressed_data == NULL);
+
+  float **arrays[4];
+  sculpt_undo_node_float_arrays(unode, arrays);
+
+  size_t totfloat = 0;
+  for (int i = 0; i < ARRAY_SIZE(arrays); i++) {
+    unode->compressed_lens[i] = *arrays[i] ? MEM_allocN_len(*arrays[i]) / sizeof(float) : 0;
+    totfloat += unode->compressed_lens[i];
+  }
+  if (totfloat == 0) {
+    return;
+  }
+
+  const size_t planes_size = totfloat * sizeof(float);
+  uchar *planes = MEM_mallocN(planes_size, __func__);
+  size_t offset = 0;
+  for (int i = 0; i < ARRAY_SIZE(arrays); i++) {
+    const uchar *bytes = (const uchar *)*arrays[i];
+    for (size_t j = 0; j < unode->compressed_lens[i]; j++) {
+      for (int b = 0; b < sizeof(float); b++) {
+        planes[b * totfloat + offset + j] = bytes[j * sizeof(float) + b];
+      }
+    }
+    offset += unode->compressed_lens[i];
+  }
+
+  const size_t bound = ZSTD_compressBound(planes_size);
+  void *compressed = MEM_mallocN(bound, "SculptUndoNode.compressed_data");
+  const size_t compressed_size = ZSTD_compress(
+      compressed, bound, planes, planes_size, SCULPT_UNDO_COMPRESSION_LEVEL);
+  MEM_freeN(planes);
+
+  if (ZSTD_isError(compressed_size)) {
+    /* Keep the arrays uncompressed. */
+    MEM_freeN(compressed);
+    return;
+  }
+
+  unode->compressed_data = MEM_reallocN(compressed, compressed_size);
+  unode->compressed_size = compressed_size;
+  for (int i = 0; i < ARRAY_SIZE(arrays); i++) {
+    MEM_SAFE_FREE(*arrays[i]);
+  }
+}
+
+static void sculpt_undo_node_decompress(SculptUndoNode *unode)
+{
+  if (unode->compressed_data == NULL) {
+    return;
+  }
+
+  float **arrays[4];
+  sculpt_undo_node_float_arrays(unode, arrays);
+
+  size_t totfloat = 0;
+  for (int i = 0; i < ARRAY_SIZE(arrays); i++) {
+    totfloat += unode->compressed_lens[i];
+  }
+
+  const size_t planes_size = totfloat * sizeof(float);
+  uchar *planes = MEM_mallocN(planes_size, __func__);
+  const size_t decompressed_size = ZSTD_decompress(
+      planes, planes_size, unode->compressed_data, unode->compressed_size);
+  BLI_assert(decompressed_size == planes_size);
+  UNUSED_VARS_NDEBUG(decompressed_size);
+
+  size_t offset = 0;
+  for (int i = 0; i < ARRAY_SIZE(arrays); i++) {
+    if (unode->compressed_lens[i] == 0) {
+      continue;
+    }
+    uchar *bytes = MEM_mallocN(unode->compressed_lens[i] * sizeof(float), "SculptUndoNode array");
+    for (size_t j = 0; j < unode->compressed_lens[i]; j++) {
+      for (int b = 0; b < sizeof(float); b++) {
+        bytes[j * sizeof(float) + b] = planes[b * totfloat + offset + j];
+      }
+    }
+    *arrays[i] = (float *)bytes;
+    offset += unode->compressed_lens[i];
+  }
+  MEM_freeN(planes);
+
+  MEM_freeN(unode->compressed_data);
+  unode->compressed_data = NULL;
+  unode->compressed_size = 0;
+}
+
+typedef struct SculptUndoCompressData {
+  SculptUndoNode **nodes;
+  bool compress;
+} SculptUndoCompressData;
+
+static void sculpt_undo_compress_task_cb(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SculptUndoCompressData *data = userdata;
+  if (data->compress) {
+    sculpt_undo_node_compress(data->nodes[i]);
+  }
+  else {
+    sculpt_undo_node_decompress(data->nodes[i]);
+  }
+}
+
+static void sculpt_undo_compress_list(ListBase *lb, const bool compress)
+{
+  const int totnode = BLI_listbase_count(lb);
+  if (totnode == 0) {
+    return;
+  }
+
+  SculptUndoNode **nodes = MEM_mallocN(sizeof(*nodes) * totnode, __func__);
+  int i = 0;
+  LISTBASE_FOREACH (SculptUndoNode *, unode, lb) {
+    nodes[i++] = unode;
+  }
+
+  SculptUndoCompressData data = {
+      .nodes = nodes,
+      .compress = compress,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  BLI_task_parallel_range(0, totnode, &data, sculpt_undo_compress_task_cb, &settings);
+
+  MEM_freeN(nodes);
+}
+
+/* Compress the arrays of a complete undo step, and update its memory usage. */
+static void sculpt_undo_compress_step(UndoSculpt *usculpt)
+{
+  sculpt_undo_compress_list(&usculpt->nodes, true);
+
+  LISTBASE_FOREACH (SculptUndoNode *, unode, &usculpt->nodes) {
+    if (unode->compressed_data) {
+      for (int i = 0; i < ARRAY_SIZE(unode->compressed_lens); i++) {
+        usculpt->undo_size -= unode->compressed_lens[i] * sizeof(float);
+      }
+      usculpt->undo_size += unode->compressed_size;
+    }
+  }
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Implements ED Undo System
  * \{ */
@@ -1434,6 +1612,7 @@ static bool sculpt_undosys_step_encode(struct bContext *UNUSED(C),
   /* Dummy, encoding is done along the way by adding tiles
    * to the current 'SculptUndoStep' added by encode_init. */
   SculptUndoStep *us = (SculptUndoStep *)us_p;
+  sculpt_undo_compress_step(&us->data);
   us->step.data_size = us->data.undo_size;
 
   SculptUndoNode *unode = us->data.nodes.last;
@@ -1454,7 +1633,9 @@ static void sculpt_undosys_step_decode_undo_impl(struct bContext *C,
                                                  SculptUndoStep *us)
 {
   BLI_assert(us->step.is_applied == true);
+  sculpt_undo_compress_list(&us->data.nodes, false);
   sculpt_undo_restore_list(C, depsgraph, &us->data.nodes);
+  sculpt_undo_compress_list(&us->data.nodes, true);
   us->step.is_applied = false;
 }
 
@@ -1463,7 +1644,9 @@ static void sculpt_undosys_step_decode_redo_impl(struct bContext *C,
                                                  SculptUndoStep *us)
 {
   BLI_assert(us->step.is_applied == false);
+  sculpt_undo_compress_list(&us->data.nodes, false);
   sculpt_undo_restore_list(C, depsgraph, &us->data.nodes);
+  sculpt_undo_compress_list(&us->data.nodes, true);
   us->step.is_applied = true;
 }
 
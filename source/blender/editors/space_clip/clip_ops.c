@@ -1542,6 +1542,7 @@ static int clip_rebuild_proxy_exec(bContext *C, wmOperator *UNUSED(op))
     pj->index_context = IMB_anim_index_rebuild_context(clip->anim,
                                                        clip->proxy.build_tc_flag,
                                                        clip->proxy.build_size_flag,
+                                                       IMB_PROXY_CODEC_H264,
                                                        clip->proxy.quality,
                                                        true,
                                                        NULL,
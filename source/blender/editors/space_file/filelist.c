@@ -3577,6 +3577,83 @@ static bool filelist_readjob_should_recurse_into_entry(const int max_recursion,
   return true;
 }
 
+/** Maximum number of directories (and libraries) listed in parallel. */
+#define FILELIST_READJOB_DIRS_PARALLEL_MAX 64
+
+/**
+ * A directory (or library) listed by #filelist_readjob_list_dirs_fn.
+ */
+typedef struct FileListReadJobDir {
+  char *dir;
+  int recursion_level;
+
+  /** Result of the listing. */
+  ListBase entries;
+  int nbr_entries;
+  bool is_lib;
+} FileListReadJobDir;
+
+typedef struct FileListReadJobListDirsData {
+  const bool do_lib;
+  const int max_recursion;
+  const bool assets_only;
+  const char *filter_glob;
+  const char *main_name;
+  FileIndexer *indexer_runtime;
+  const short *stop;
+
+  FileListReadJobDir *dirs;
+} FileListReadJobListDirsData;
+
+/**
+ * Reading the directory contents and the libraries is mostly waiting for the file system,
+ * especially on network storage, so multiple directories are listed in parallel.
+ */
+static void filelist_readjob_list_dirs_fn(void *__restrict userdata,
+                                          const int index,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const FileListReadJobListDirsData *data = userdata;
+  FileListReadJobDir *job_dir = &data->dirs[index];
+  const bool skip_currpar = (job_dir->recursion_level > 1);
+
+  if (*data->stop) {
+    return;
+  }
+
+  if (data->do_lib) {
+    ListLibOptions list_lib_options = 0;
+    if (!skip_currpar) {
+      list_lib_options |= LIST_LIB_ADD_PARENT;
+    }
+
+    /* Libraries are loaded recursively when max_recursion is set. It doesn't check if there is
+     * still a recursion level over. */
+    if (data->max_recursion > 0) {
+      list_lib_options |= LIST_LIB_RECURSIVE;
+    }
+    /* Only load assets when browsing an asset library. For normal file browsing we return all
+     * entries. `FLF_ASSETS_ONLY` filter can be enabled/disabled by the user. */
+    if (data->assets_only) {
+      list_lib_options |= LIST_LIB_ASSETS_ONLY;
+    }
+    job_dir->nbr_entries = filelist_readjob_list_lib(
+        job_dir->dir, &job_dir->entries, list_lib_options, data->indexer_runtime);
+    if (job_dir->nbr_entries > 0) {
+      job_dir->is_lib = true;
+    }
+  }
+
+  if (!job_dir->is_lib) {
+    job_dir->nbr_entries = filelist_readjob_list_dir(job_dir->dir,
+                                                     &job_dir->entries,
+                                                     data->filter_glob,
+                                                     data->do_lib,
+                                                     data->main_name,
+                                                     skip_currpar);
+  }
+}
+
 static void filelist_readjob_recursive_dir_add_items(const bool do_lib,
                                                      FileListReadJob *job_params,
                                                      const short *stop,
@@ -3584,7 +3661,6 @@ static void filelist_readjob_recursive_dir_add_items(const bool do_lib,
                                                      float *progress)
 {
   FileList *filelist = job_params->tmp_filelist; /* Use the thread-safe filelist queue. */
-  ListBase entries = {0};
   BLI_Stack *todo_dirs;
   TodoDir *td_dir;
   char dir[FILE_MAX_LIBEXTRA];
@@ -3609,93 +3685,92 @@ static void filelist_readjob_recursive_dir_add_items(const bool do_lib,
     indexer_runtime.user_data = indexer_runtime.callbacks->init_user_data(dir, sizeof(dir));
   }
 
-  while (!BLI_stack_is_empty(todo_dirs) && !(*stop)) {
-    FileListInternEntry *entry;
-    int nbr_entries = 0;
-
-    char *subdir;
-    char rel_subdir[FILE_MAX_LIBEXTRA];
-    int recursion_level;
-    bool skip_currpar;
-
-    td_dir = BLI_stack_peek(todo_dirs);
-    subdir = td_dir->dir;
-    recursion_level = td_dir->level;
-    skip_currpar = (recursion_level > 1);
-
-    BLI_stack_discard(todo_dirs);
-
-    /* ARRRG! We have to be very careful *not to use* common BLI_path_util helpers over
-     * entry->relpath itself (nor any path containing it), since it may actually be a datablock
-     * name inside .blend file, which can have slashes and backslashes! See T46827.
-     * Note that in the end, this means we 'cache' valid relative subdir once here,
-     * this is actually better. */
-    BLI_strncpy(rel_subdir, subdir, sizeof(rel_subdir));
-    BLI_path_normalize_dir(root, rel_subdir);
-    BLI_path_rel(rel_subdir, root);
-
-    bool is_lib = false;
-    if (do_lib) {
-      ListLibOptions list_lib_options = 0;
-      if (!skip_currpar) {
-        list_lib_options |= LIST_LIB_ADD_PARENT;
-      }
+  FileListReadJobDir *job_dirs = MEM_mallocN(
+      sizeof(*job_dirs) * FILELIST_READJOB_DIRS_PARALLEL_MAX, __func__);
+  FileListReadJobListDirsData list_dirs_data = {
+      .do_lib = do_lib,
+      .max_recursion = max_recursion,
+      .assets_only = filelist->asset_library_ref != NULL,
+      .filter_glob = filter_glob,
+      .main_name = job_params->main_name,
+      .indexer_runtime = &indexer_runtime,
+      .stop = stop,
+      .dirs = job_dirs,
+  };
 
-      /* Libraries are loaded recursively when max_recursion is set. It doesn't check if there is
-       * still a recursion level over. */
-      if (max_recursion > 0) {
-        list_lib_options |= LIST_LIB_RECURSIVE;
-      }
-      /* Only load assets when browsing an asset library. For normal file browsing we return all
-       * entries. `FLF_ASSETS_ONLY` filter can be enabled/disabled by the user. */
-      if (filelist->asset_library_ref) {
-        list_lib_options |= LIST_LIB_ASSETS_ONLY;
-      }
-      nbr_entries = filelist_readjob_list_lib(
-          subdir, &entries, list_lib_options, &indexer_runtime);
-      if (nbr_entries > 0) {
-        is_lib = true;
-      }
+  while (!BLI_stack_is_empty(todo_dirs) && !(*stop)) {
+    /* List as many of the pending directories as possible at once. */
+    int job_dirs_len = 0;
+    while (!BLI_stack_is_empty(todo_dirs) && job_dirs_len < FILELIST_READJOB_DIRS_PARALLEL_MAX) {
+      td_dir = BLI_stack_peek(todo_dirs);
+      FileListReadJobDir *job_dir = &job_dirs[job_dirs_len++];
+      memset(job_dir, 0, sizeof(*job_dir));
+      job_dir->dir = td_dir->dir;
+      job_dir->recursion_level = td_dir->level;
+      BLI_stack_discard(todo_dirs);
     }
 
-    if (!is_lib) {
-      nbr_entries = filelist_readjob_list_dir(
-          subdir, &entries, filter_glob, do_lib, job_params->main_name, skip_currpar);
-    }
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1;
+    BLI_task_parallel_range(
+        0, job_dirs_len, &list_dirs_data, filelist_readjob_list_dirs_fn, &settings);
 
-    for (entry = entries.first; entry; entry = entry->next) {
-      entry->uid = filelist_uid_generate(filelist);
-
-      /* When loading entries recursive, the rel_path should be relative from the root dir.
-       * we combine the relative path to the subdir with the relative path of the entry. */
-      BLI_join_dirfile(dir, sizeof(dir), rel_subdir, entry->relpath);
-      MEM_freeN(entry->relpath);
-      entry->relpath = BLI_strdup(dir + 2); /* + 2 to remove '//'
-                                             * added by BLI_path_rel to rel_subdir. */
-      entry->name = fileentry_uiname(root, entry->relpath, entry->typeflag, dir);
-      entry->free_name = true;
-
-      if (filelist_readjob_should_recurse_into_entry(
-              max_recursion, is_lib, recursion_level, entry)) {
-        /* We have a directory we want to list, add it to todo list! */
-        BLI_join_dirfile(dir, sizeof(dir), root, entry->relpath);
-        BLI_path_normalize_dir(job_params->main_name, dir);
-        td_dir = BLI_stack_push_r(todo_dirs);
-        td_dir->level = recursion_level + 1;
-        td_dir->dir = BLI_strdup(dir);
-        nbr_todo_dirs++;
+    for (int i = 0; i < job_dirs_len; i++) {
+      FileListReadJobDir *job_dir = &job_dirs[i];
+      FileListInternEntry *entry;
+      char *subdir = job_dir->dir;
+      char rel_subdir[FILE_MAX_LIBEXTRA];
+      const int recursion_level = job_dir->recursion_level;
+
+      /* ARRRG! We have to be very careful *not to use* common BLI_path_util helpers over
+       * entry->relpath itself (nor any path containing it), since it may actually be a datablock
+       * name inside .blend file, which can have slashes and backslashes! See T46827.
+       * Note that in the end, this means we 'cache' valid relative subdir once here,
+       * this is actually better. */
+      BLI_strncpy(rel_subdir, subdir, sizeof(rel_subdir));
+      BLI_path_normalize_dir(root, rel_subdir);
+      BLI_path_rel(rel_subdir, root);
+
+      for (entry = job_dir->entries.first; entry; entry = entry->next) {
+        entry->uid = filelist_uid_generate(filelist);
+
+        /* When loading entries recursive, the rel_path should be relative from the root dir.
+         * we combine the relative path to the subdir with the relative path of the entry. */
+        BLI_join_dirfile(dir, sizeof(dir), rel_subdir, entry->relpath);
+        MEM_freeN(entry->relpath);
+        entry->relpath = BLI_strdup(dir + 2); /* + 2 to remove '//'
+                                               * added by BLI_path_rel to rel_subdir. */
+        entry->name = fileentry_uiname(root, entry->relpath, entry->typeflag, dir);
+        entry->free_name = true;
+
+        if (!(*stop) && filelist_readjob_should_recurse_into_entry(
+                            max_recursion, job_dir->is_lib, recursion_level, entry)) {
+          /* We have a directory we want to list, add it to todo list! */
+          BLI_join_dirfile(dir, sizeof(dir), root, entry->relpath);
+          BLI_path_normalize_dir(job_params->main_name, dir);
+          td_dir = BLI_stack_push_r(todo_dirs);
+          td_dir->level = recursion_level + 1;
+          td_dir->dir = BLI_strdup(dir);
+          nbr_todo_dirs++;
+        }
       }
-    }
 
-    filelist_readjob_append_entries(job_params, &entries, nbr_entries, do_update);
+      filelist_readjob_append_entries(
+          job_params, &job_dir->entries, job_dir->nbr_entries, do_update);
 
-    nbr_done_dirs++;
+      nbr_done_dirs++;
+      MEM_freeN(subdir);
+    }
     *progress = (float)nbr_done_dirs / (float)nbr_todo_dirs;
-    MEM_freeN(subdir);
   }
 
-  /* Finalize and free indexer. */
-  if (indexer_runtime.callbacks->filelist_finished && BLI_stack_is_empty(todo_dirs)) {
+  MEM_freeN(job_dirs);
+
+  /* Finalize and free indexer. When stopped, some of the last listed directories may have been
+   * skipped even though the stack is empty. */
+  if (indexer_runtime.callbacks->filelist_finished && BLI_stack_is_empty(todo_dirs) &&
+      !(*stop)) {
     indexer_runtime.callbacks->filelist_finished(indexer_runtime.user_data);
   }
   if (indexer_runtime.callbacks->free_user_data && indexer_runtime.user_data) {
@@ -702,6 +702,8 @@ static void image_main_region_draw(const bContext *C, ARegion *region)
 
   WM_gizmomap_draw(region->gizmo_map, C, WM_GIZMOMAP_DRAWSTEP_2D);
   draw_image_cache(C, region);
+
+  BKE_image_free_old_ibufs(CTX_data_main(C));
 }
 
 static void image_main_region_listener(const wmRegionListenerParams *params)
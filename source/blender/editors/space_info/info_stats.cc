@@ -644,6 +644,25 @@ static const char *info_statusbar_string(Main *bmain,
     uintptr_t mem_in_use = MEM_get_memory_in_use();
     BLI_str_format_byte_unit(formatted_mem, mem_in_use, false);
     ofs += BLI_snprintf_rlen(info + ofs, len, TIP_("Memory: %s"), formatted_mem);
+
+    /* Show the subsystem that uses the most memory, if it is known. */
+    eMEMCategory largest_category = MEM_CATEGORY_OTHER;
+    size_t largest_category_mem = 0;
+    for (int i = MEM_CATEGORY_OTHER + 1; i < MEM_CATEGORY_NUM; i++) {
+      const size_t category_mem = MEM_get_category_memory_in_use(eMEMCategory(i));
+      if (category_mem > largest_category_mem) {
+        largest_category = eMEMCategory(i);
+        largest_category_mem = category_mem;
+      }
+    }
+    if (largest_category != MEM_CATEGORY_OTHER) {
+      BLI_str_format_byte_unit(formatted_mem, largest_category_mem, false);
+      ofs += BLI_snprintf_rlen(info + ofs,
+                               len - ofs,
+                               " (%s %s)",
+                               IFACE_(MEM_category_name(largest_category)),
+                               formatted_mem);
+    }
   }
 
   /* GPU VRAM status. */
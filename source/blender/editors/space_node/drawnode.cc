@@ -1971,6 +1971,25 @@ static void nodelink_batch_add_link(const SpaceNode &snode,
   }
 }
 
+/**
+ * A bezier curve lies inside the bounds of its control points, so links outside of the view
+ * can be skipped before looking up their colors and adding them to the batch.
+ */
+static bool node_link_bezier_is_visible(const View2D &v2d,
+                                        const SpaceNode &snode,
+                                        const float vec[4][2])
+{
+  rctf bounds;
+  BLI_rctf_init_minmax(&bounds);
+  for (int i = 0; i < 4; i++) {
+    BLI_rctf_do_minmax_v(&bounds, vec[i]);
+  }
+  /* Account for the width of the drawn line and the arrow of reroute links. */
+  const float margin = snode.runtime->aspect * (LINK_WIDTH * 2.0f + ARROW_SIZE);
+  BLI_rctf_pad(&bounds, margin, margin);
+  return BLI_rctf_isect(&bounds, &v2d.cur, nullptr);
+}
+
 void node_draw_link_bezier(const bContext &C,
                            const View2D &v2d,
                            const SpaceNode &snode,
@@ -1999,6 +2018,9 @@ void node_draw_link_bezier(const bContext &C,
   float vec[4][2];
   const bool highlighted = link.flag & NODE_LINK_TEMP_HIGHLIGHT;
   if (node_link_bezier_handles(&v2d, &snode, link, vec)) {
+    if (!node_link_bezier_is_visible(v2d, snode, vec)) {
+      return;
+    }
     int drawarrow = ((link.tonode && (link.tonode->type == NODE_REROUTE)) &&
                      (link.fromnode && (link.fromnode->type == NODE_REROUTE)));
     int drawmuted = (link.flag & NODE_LINK_MUTED);
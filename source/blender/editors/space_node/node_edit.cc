@@ -9,6 +9,10 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_fileops.hh"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+
 #include "DNA_light_types.h"
 #include "DNA_material_types.h"
 #include "DNA_node_types.h"
@@ -25,6 +29,7 @@
 #include "BKE_node_tree_update.h"
 #include "BKE_report.h"
 #include "BKE_scene.h"
+#include "BKE_screen.h"
 #include "BKE_workspace.h"
 
 #include "DEG_depsgraph.h"
@@ -57,6 +62,7 @@
 
 #include "NOD_composite.h"
 #include "NOD_geometry.h"
+#include "NOD_geometry_nodes_eval_log.hh"
 #include "NOD_shader.h"
 #include "NOD_texture.h"
 #include "node_intern.hh" /* own include */
@@ -79,6 +85,9 @@ struct CompoJob {
   ViewLayer *view_layer;
   bNodeTree *ntree;
   int recalc_flags;
+  /* Part of the viewer image visible in node editor backdrops. */
+  bool use_backdrop_border;
+  rctf backdrop_border;
   /* Evaluated state/ */
   Depsgraph *compositor_depsgraph;
   bNodeTree *localtree;
@@ -160,6 +169,81 @@ static int compo_get_recalc_flags(const bContext *C)
   return recalc_flags;
 }
 
+/**
+ * Get the normalized part of the viewer image visible in the node editor backdrops, with a margin
+ * so small view changes don't need compositing again. Returns false when the whole image is
+ * needed, for example when the viewer image is also shown in an image editor.
+ */
+static bool compo_get_backdrop_border(const bContext *C,
+                                      const bNodeTree *nodetree,
+                                      rctf *r_border)
+{
+  Main *bmain = CTX_data_main(C);
+  wmWindowManager *wm = CTX_wm_manager(C);
+
+  Image *ima = BKE_image_ensure_viewer(bmain, IMA_TYPE_COMPOSITE, "Viewer Node");
+  void *lock;
+  ImBuf *ibuf = BKE_image_acquire_ibuf(ima, nullptr, &lock);
+  const int backdrop_width = ibuf ? ibuf->x : 0;
+  const int backdrop_height = ibuf ? ibuf->y : 0;
+  BKE_image_release_ibuf(ima, ibuf, lock);
+
+  Vector<SpaceNode *> backdrop_snodes;
+  bool use_border = backdrop_width > 0 && backdrop_height > 0;
+  bool has_backdrop = false;
+  BLI_rctf_init_minmax(r_border);
+
+  LISTBASE_FOREACH (wmWindow *, win, &wm->windows) {
+    const bScreen *screen = WM_window_get_active_screen(win);
+
+    LISTBASE_FOREACH (ScrArea *, area, &screen->areabase) {
+      if (area->spacetype == SPACE_IMAGE) {
+        SpaceImage *sima = (SpaceImage *)area->spacedata.first;
+        if (sima->image && sima->image->type == IMA_TYPE_COMPOSITE) {
+          use_border = false;
+        }
+      }
+      else if (area->spacetype == SPACE_NODE) {
+        SpaceNode *snode = (SpaceNode *)area->spacedata.first;
+        if (snode->nodetree != nodetree || snode->runtime == nullptr) {
+          continue;
+        }
+        backdrop_snodes.append(snode);
+
+        const ARegion *region = BKE_area_find_region_type(area, RGN_TYPE_WINDOW);
+        if (!(snode->flag & SNODE_BACKDRAW) || region == nullptr) {
+          continue;
+        }
+        if (use_border) {
+          rctf border;
+          node_backdrop_visible_border(*snode, *region, backdrop_width, backdrop_height, border);
+          BLI_rctf_union(r_border, &border);
+          has_backdrop = true;
+        }
+      }
+    }
+  }
+
+  use_border = use_border && has_backdrop;
+  if (use_border) {
+    const float width = BLI_rctf_size_x(r_border);
+    const float height = BLI_rctf_size_y(r_border);
+    BLI_rctf_pad(r_border, 0.25f * width, 0.25f * height);
+
+    rctf unit_border;
+    BLI_rctf_init(&unit_border, 0.0f, 1.0f, 0.0f, 1.0f);
+    use_border = BLI_rctf_isect(r_border, &unit_border, r_border) &&
+                 !BLI_rctf_inside_rctf(r_border, &unit_border);
+  }
+
+  for (SpaceNode *snode : backdrop_snodes) {
+    snode->runtime->use_backdrop_border = use_border;
+    snode->runtime->backdrop_border = *r_border;
+  }
+
+  return use_border;
+}
+
 /* called by compo, only to check job 'stop' value */
 static int compo_breakjob(void *cjv)
 {
@@ -226,6 +310,21 @@ static void compo_initjob(void *cjv)
   if (cj->recalc_flags) {
     compo_tag_output_nodes(cj->localtree, cj->recalc_flags);
   }
+
+  if (cj->use_backdrop_border) {
+    /* Only compute the part of the viewer image that is visible. */
+    rctf *viewer_border = &cj->localtree->viewer_border;
+    if (!(cj->localtree->flag & NTREE_VIEWER_BORDER)) {
+      *viewer_border = cj->backdrop_border;
+      cj->localtree->flag |= NTREE_VIEWER_BORDER;
+    }
+    else {
+      rctf isect;
+      if (BLI_rctf_isect(viewer_border, &cj->backdrop_border, &isect)) {
+        *viewer_border = isect;
+      }
+    }
+  }
 }
 
 /* called before redraw notifiers, it moves finished previews over */
@@ -340,6 +439,7 @@ void ED_node_composite_job(const bContext *C, struct bNodeTree *nodetree, Scene
   cj->view_layer = view_layer;
   cj->ntree = nodetree;
   cj->recalc_flags = compo_get_recalc_flags(C);
+  cj->use_backdrop_border = compo_get_backdrop_border(C, nodetree, &cj->backdrop_border);
 
   /* setup job */
   WM_jobs_customdata_set(wm_job, cj, compo_freejob);
@@ -2939,4 +3039,89 @@ void NODE_OT_cryptomatte_layer_remove(wmOperatorType *ot)
   /* flags */
   ot->flag = OPTYPE_REGISTER | OPTYPE_UNDO;
 }
+/* ****************** Export Timings  ******************* */
+
+namespace geo_log = blender::nodes::geometry_nodes_eval_log;
+
+static bool node_export_timings_poll(bContext *C)
+{
+  const SpaceNode *snode = CTX_wm_space_node(C);
+  if (snode == nullptr || snode->edittree == nullptr ||
+      snode->edittree->type != NTREE_GEOMETRY) {
+    return false;
+  }
+  if (geo_log::ModifierLog::find_root_by_node_editor_context(*snode) == nullptr) {
+    CTX_wm_operator_poll_msg_set(C, "The node tree has not been evaluated by a modifier");
+    return false;
+  }
+  return true;
+}
+
+static int node_export_timings_exec(bContext *C, wmOperator *op)
+{
+  const SpaceNode &snode = *CTX_wm_space_node(C);
+  const geo_log::ModifierLog *eval_log = geo_log::ModifierLog::find_root_by_node_editor_context(
+      snode);
+  if (eval_log == nullptr) {
+    return OPERATOR_CANCELLED;
+  }
+
+  char filepath[FILE_MAX];
+  RNA_string_get(op->ptr, "filepath", filepath);
+  BLI_path_abs(filepath, BKE_main_blendfile_path(CTX_data_main(C)));
+
+  blender::fstream stream(filepath, std::ios::out | std::ios::trunc);
+  if (!stream.is_open()) {
+    BKE_reportf(op->reports, RPT_ERROR, "Cannot open file \"%s\" for writing", filepath);
+    return OPERATOR_CANCELLED;
+  }
+  eval_log->write_timings_trace(stream);
+  if (!stream.good()) {
+    BKE_reportf(op->reports, RPT_ERROR, "Error writing file \"%s\"", filepath);
+    return OPERATOR_CANCELLED;
+  }
+  BKE_reportf(op->reports,
+              RPT_INFO,
+              "Exported %d node executions to \"%s\"",
+              int(eval_log->execution_events().size()),
+              filepath);
+  return OPERATOR_FINISHED;
+}
+
+static int node_export_timings_invoke(bContext *C, wmOperator *op, const wmEvent *UNUSED(event))
+{
+  if (!RNA_struct_property_is_set(op->ptr, "filepath")) {
+    char filepath[FILE_MAX];
+    const char *blendfile_path = BKE_main_blendfile_path(CTX_data_main(C));
+    BLI_strncpy(filepath, blendfile_path[0] ? blendfile_path : "untitled", sizeof(filepath));
+    BLI_path_extension_replace(filepath, sizeof(filepath), "_node_timings.json");
+    RNA_string_set(op->ptr, "filepath", filepath);
+  }
+  WM_event_add_fileselect(C, op);
+  return OPERATOR_RUNNING_MODAL;
+}
+
+void NODE_OT_export_timings(wmOperatorType *ot)
+{
+  /* identifiers */
+  ot->name = "Export Node Timings";
+  ot->description =
+      "Export the execution times of the nodes in the last evaluation in the trace event "
+      "format, which can be opened in web browser based trace viewers";
+  ot->idname = "NODE_OT_export_timings";
+
+  /* callbacks */
+  ot->exec = node_export_timings_exec;
+  ot->invoke = node_export_timings_invoke;
+  ot->poll = node_export_timings_poll;
+
+  WM_operator_properties_filesel(ot,
+                                 FILE_TYPE_FOLDER | FILE_TYPE_TEXT,
+                                 FILE_SPECIAL,
+                                 FILE_SAVE,
+                                 WM_FILESEL_FILEPATH | WM_FILESEL_SHOW_PROPS,
+                                 FILE_DEFAULTDISPLAY,
+                                 FILE_SORT_DEFAULT);
+}
+
 }  // namespace blender::ed::space_node
@@ -77,6 +77,13 @@ struct SpaceNode_Runtime {
   /** For auto compositing. */
   bool recalc;
 
+  /**
+   * Normalized part of the viewer image the last compositor job was limited to, because only
+   * that part was visible in the backdrop. Moving the view outside of it composites again.
+   */
+  bool use_backdrop_border;
+  rctf backdrop_border;
+
   /** Temporary data for modal linking operator. */
   std::unique_ptr<bNodeLinkDrag> linkdrag;
 
@@ -176,6 +183,15 @@ void NODE_OT_find_node(wmOperatorType *ot);
 bool space_node_view_flag(
     bContext &C, SpaceNode &snode, ARegion &region, int node_flag, int smooth_viewtx);
 
+/** Get the normalized part of a backdrop image of the given size visible in the region. */
+void node_backdrop_visible_border(const SpaceNode &snode,
+                                  const ARegion &region,
+                                  int backdrop_width,
+                                  int backdrop_height,
+                                  rctf &r_border);
+/** Composite again when the backdrop view moved outside of the last composited border. */
+void node_backdrop_view_changed(bContext &C, const SpaceNode &snode, const ARegion &region);
+
 void NODE_OT_view_all(wmOperatorType *ot);
 void NODE_OT_view_selected(wmOperatorType *ot);
 
@@ -343,6 +359,8 @@ void NODE_OT_clear_viewer_border(wmOperatorType *ot);
 void NODE_OT_cryptomatte_layer_add(wmOperatorType *ot);
 void NODE_OT_cryptomatte_layer_remove(wmOperatorType *ot);
 
+void NODE_OT_export_timings(wmOperatorType *ot);
+
 /* node_gizmo.cc */
 
 void NODE_GGT_backdrop_transform(wmGizmoGroupType *gzgt);
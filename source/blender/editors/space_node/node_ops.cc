@@ -109,6 +109,8 @@ void node_operatortypes()
 
   WM_operatortype_append(NODE_OT_cryptomatte_layer_add);
   WM_operatortype_append(NODE_OT_cryptomatte_layer_remove);
+
+  WM_operatortype_append(NODE_OT_export_timings);
 }
 
 void node_keymap(struct wmKeyConfig *keyconf)
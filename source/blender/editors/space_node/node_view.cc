@@ -115,6 +115,7 @@ static int node_view_all_exec(bContext *C, wmOperator *op)
   /* is this really needed? */
   snode->xof = 0;
   snode->yof = 0;
+  node_backdrop_view_changed(*C, *snode, *region);
 
   if (space_node_view_flag(*C, *snode, *region, 0, smooth_viewtx)) {
     return OPERATOR_FINISHED;
@@ -176,6 +177,48 @@ void NODE_OT_view_selected(wmOperatorType *ot)
 /** \name Background Image Operators
  * \{ */
 
+void node_backdrop_visible_border(const SpaceNode &snode,
+                                  const ARegion &region,
+                                  const int backdrop_width,
+                                  const int backdrop_height,
+                                  rctf &r_border)
+{
+  const float bufx = backdrop_width * snode.zoom;
+  const float bufy = backdrop_height * snode.zoom;
+
+  r_border.xmin = (-0.5f * region.winx - snode.xof) / bufx + 0.5f;
+  r_border.xmax = (0.5f * region.winx - snode.xof) / bufx + 0.5f;
+  r_border.ymin = (-0.5f * region.winy - snode.yof) / bufy + 0.5f;
+  r_border.ymax = (0.5f * region.winy - snode.yof) / bufy + 0.5f;
+}
+
+void node_backdrop_view_changed(bContext &C, const SpaceNode &snode, const ARegion &region)
+{
+  if (!snode.runtime->use_backdrop_border) {
+    return;
+  }
+
+  Main *bmain = CTX_data_main(&C);
+  void *lock;
+  Image *ima = BKE_image_ensure_viewer(bmain, IMA_TYPE_COMPOSITE, "Viewer Node");
+  ImBuf *ibuf = BKE_image_acquire_ibuf(ima, nullptr, &lock);
+
+  if (ibuf && ibuf->x > 0 && ibuf->y > 0) {
+    rctf border;
+    node_backdrop_visible_border(snode, region, ibuf->x, ibuf->y, border);
+
+    rctf unit_border;
+    BLI_rctf_init(&unit_border, 0.0f, 1.0f, 0.0f, 1.0f);
+    if (BLI_rctf_isect(&border, &unit_border, &border) &&
+        !BLI_rctf_inside_rctf(&snode.runtime->backdrop_border, &border)) {
+      /* Refreshing the area starts a new compositor job for the visible part. */
+      ED_area_tag_refresh(CTX_wm_area(&C));
+    }
+  }
+
+  BKE_image_release_ibuf(ima, ibuf, lock);
+}
+
 struct NodeViewMove {
   int mvalo[2];
   int xmin, ymin, xmax, ymax;
@@ -211,6 +254,7 @@ static int snode_bg_viewmove_modal(bContext *C, wmOperator *op, const wmEvent *e
       if (event->val == KM_RELEASE) {
         MEM_freeN(nvm);
         op->customdata = nullptr;
+        node_backdrop_view_changed(*C, *snode, *region);
         return OPERATOR_FINISHED;
       }
       break;
@@ -296,6 +340,7 @@ static int backimage_zoom_exec(bContext *C, wmOperator *op)
   ED_region_tag_redraw(region);
   WM_main_add_notifier(NC_NODE | ND_DISPLAY, nullptr);
   WM_main_add_notifier(NC_SPACE | ND_SPACE_NODE_VIEW, nullptr);
+  node_backdrop_view_changed(*C, *snode, *region);
 
   return OPERATOR_FINISHED;
 }
@@ -361,6 +406,7 @@ static int backimage_fit_exec(bContext *C, wmOperator *UNUSED(op))
   ED_region_tag_redraw(region);
   WM_main_add_notifier(NC_NODE | ND_DISPLAY, nullptr);
   WM_main_add_notifier(NC_SPACE | ND_SPACE_NODE_VIEW, nullptr);
+  node_backdrop_view_changed(*C, *snode, *region);
 
   return OPERATOR_FINISHED;
 }
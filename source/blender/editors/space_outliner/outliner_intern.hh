@@ -283,6 +283,11 @@ bool outliner_requires_rebuild_on_select_or_active_change(
  * Element types in these modes don't actually add children if collapsed, so the rebuild is needed.
  */
 bool outliner_requires_rebuild_on_open_change(const struct SpaceOutliner *space_outliner);
+/**
+ * Check if the tree may change when the current frame changes. Otherwise only a redraw is needed,
+ * which avoids rebuilding the whole tree on every frame during playback.
+ */
+bool outliner_requires_rebuild_on_frame_change(const struct SpaceOutliner *space_outliner);
 
 typedef struct IDsSelectedData {
   struct ListBase selected_array;
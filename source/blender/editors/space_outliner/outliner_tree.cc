@@ -226,6 +226,17 @@ bool outliner_requires_rebuild_on_open_change(const SpaceOutliner *space_outline
   return ELEM(space_outliner->outlinevis, SO_DATA_API);
 }
 
+bool outliner_requires_rebuild_on_frame_change(const SpaceOutliner *space_outliner)
+{
+  /* RNA collections shown in the data API view can depend on animated properties. */
+  if (space_outliner->outlinevis == SO_DATA_API) {
+    return true;
+  }
+  /* Need to rebuild tree to re-apply filter if visibility or selectability is animated. */
+  return outliner_exclude_filter_get(space_outliner) &
+         (SO_FILTER_OB_STATE_VISIBLE | SO_FILTER_OB_STATE_SELECTABLE);
+}
+
 /* special handling of hierarchical non-lib data */
 static void outliner_add_bone(SpaceOutliner *space_outliner,
                               ListBase *lb,
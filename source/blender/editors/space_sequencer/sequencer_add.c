@@ -595,6 +595,7 @@ static void seq_build_proxy(bContext *C, SeqCollection *movie_strips)
 
   wmJob *wm_job = ED_seq_proxy_wm_job_get(C);
   ProxyJob *pj = ED_seq_proxy_job_get(C, wm_job);
+  ListBase queue = {NULL, NULL};
 
   Sequence *seq;
   SEQ_ITERATOR_FOREACH (seq, movie_strips) {
@@ -602,8 +603,9 @@ static void seq_build_proxy(bContext *C, SeqCollection *movie_strips)
     SEQ_proxy_set(seq, true);
     seq->strip->proxy->build_size_flags = seq_get_proxy_size_flags(C);
     seq->strip->proxy->build_flags |= SEQ_PROXY_SKIP_EXISTING;
-    SEQ_proxy_rebuild_context(pj->main, pj->depsgraph, pj->scene, seq, NULL, &pj->queue, true);
+    SEQ_proxy_rebuild_context(pj->main, pj->depsgraph, pj->scene, seq, NULL, &queue, true);
   }
+  ED_seq_proxy_job_queue_add(pj, &queue);
 
   if (!WM_jobs_is_running(wm_job)) {
     G.is_break = false;
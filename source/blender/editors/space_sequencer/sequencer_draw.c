@@ -1871,6 +1871,44 @@ static void sequencer_preview_get_rect(rctf *preview,
   }
 }
 
+void sequencer_display_texture_free(SpaceSeq *sseq)
+{
+  if (sseq->runtime.display_texture) {
+    GPU_texture_free(sseq->runtime.display_texture);
+    sseq->runtime.display_texture = NULL;
+  }
+  if (sseq->runtime.display_texture_ibuf) {
+    IMB_freeImBuf(sseq->runtime.display_texture_ibuf);
+    sseq->runtime.display_texture_ibuf = NULL;
+  }
+}
+
+/**
+ * When the display transform runs as GLSL shader, the texture holds the pixels of the frame
+ * itself, so it stays valid as long as the same frame is displayed. This avoids uploading the
+ * frame again when only overlays, gizmos or the view change, which is expensive for 4K float
+ * frames.
+ *
+ * \return The texture to draw, or NULL when it is not kept and has to be freed by the caller.
+ */
+static GPUTexture *sequencer_display_texture_get_cached(SpaceSeq *sseq,
+                                                        ImBuf *ibuf,
+                                                        const eGPUTextureFormat format)
+{
+  GPUTexture *texture = sseq->runtime.display_texture;
+  if (texture == NULL || sseq->runtime.display_texture_ibuf != ibuf) {
+    return NULL;
+  }
+  if (ibuf->userflags & (IB_RECT_INVALID | IB_DISPLAY_BUFFER_INVALID)) {
+    return NULL;
+  }
+  if (GPU_texture_format(texture) != format || GPU_texture_width(texture) != ibuf->x ||
+      GPU_texture_height(texture) != ibuf->y) {
+    return NULL;
+  }
+  return texture;
+}
+
 static void sequencer_draw_display_buffer(const bContext *C,
                                           Scene *scene,
                                           ARegion *region,
@@ -1920,10 +1958,25 @@ static void sequencer_draw_display_buffer(const bContext *C,
     GPU_matrix_identity_projection_set();
   }
 
-  GPUTexture *texture = GPU_texture_create_2d(
-      "seq_display_buf", ibuf->x, ibuf->y, 1, format, NULL);
-  GPU_texture_update(texture, data, display_buffer);
-  GPU_texture_filter_mode(texture, false);
+  /* The display buffer is the frame's own data only when the GLSL display transform is used. */
+  const bool use_cached_texture = glsl_used && scope == NULL &&
+                                  ELEM(display_buffer, ibuf->rect, ibuf->rect_float);
+  GPUTexture *texture = NULL;
+  if (use_cached_texture) {
+    texture = sequencer_display_texture_get_cached(sseq, ibuf, format);
+  }
+  if (texture == NULL) {
+    texture = GPU_texture_create_2d("seq_display_buf", ibuf->x, ibuf->y, 1, format, NULL);
+    GPU_texture_update(texture, data, display_buffer);
+    GPU_texture_filter_mode(texture, false);
+
+    if (use_cached_texture) {
+      sequencer_display_texture_free(sseq);
+      IMB_refImBuf(ibuf);
+      sseq->runtime.display_texture = texture;
+      sseq->runtime.display_texture_ibuf = ibuf;
+    }
+  }
 
   GPU_texture_bind(texture, 0);
 
@@ -1960,7 +2013,9 @@ static void sequencer_draw_display_buffer(const bContext *C,
   immEnd();
 
   GPU_texture_unbind(texture);
-  GPU_texture_free(texture);
+  if (texture != sseq->runtime.display_texture) {
+    GPU_texture_free(texture);
+  }
 
   if (!glsl_used) {
     immUnbindProgram();
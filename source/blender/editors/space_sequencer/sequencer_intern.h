@@ -44,6 +44,9 @@ void color3ubv_from_seq(const struct Scene *curscene,
                         bool show_strip_color_tag,
                         uchar r_col[3]);
 
+/** Free the preview texture kept between redraws. */
+void sequencer_display_texture_free(struct SpaceSeq *sseq);
+
 void sequencer_special_update_set(Sequence *seq);
 /* Get handle width in 2d-View space. */
 float sequence_handle_size_get_clamped(struct Sequence *seq, float pixelx);
@@ -9,6 +9,7 @@
 #include "DNA_sound_types.h"
 
 #include "BLI_listbase.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BKE_context.h"
@@ -50,54 +51,76 @@ static void free_preview_job(void *data)
   MEM_freeN(pj);
 }
 
-/* Only this runs inside thread. */
-static void preview_startjob(void *data, short *stop, short *do_update, float *progress)
+typedef struct PreviewJobThreadData {
+  PreviewJob *pj;
+  short *stop;
+  short *do_update;
+  float *progress;
+} PreviewJobThreadData;
+
+/* Reads waveforms from the job list until it is empty, several of these run in parallel. */
+static void preview_job_task(TaskPool *__restrict pool, void *UNUSED(taskdata))
 {
-  PreviewJob *pj = data;
-  PreviewJobAudio *previewjb;
+  PreviewJobThreadData *data = BLI_task_pool_user_data(pool);
+  PreviewJob *pj = data->pj;
 
-  BLI_mutex_lock(pj->mutex);
-  previewjb = pj->previews.first;
-  BLI_mutex_unlock(pj->mutex);
+  while (true) {
+    BLI_mutex_lock(pj->mutex);
+    PreviewJobAudio *previewjb = BLI_pophead(&pj->previews);
+    BLI_mutex_unlock(pj->mutex);
+
+    if (previewjb == NULL) {
+      break;
+    }
 
-  while (previewjb) {
-    PreviewJobAudio *preview_next;
     bSound *sound = previewjb->sound;
 
-    BKE_sound_read_waveform(previewjb->bmain, sound, stop);
-
-    if (*stop || G.is_break) {
-      BLI_mutex_lock(pj->mutex);
-      previewjb = previewjb->next;
-      BLI_mutex_unlock(pj->mutex);
-      while (previewjb) {
-        sound = previewjb->sound;
-
-        /* Make sure we cleanup the loading flag! */
-        BLI_spin_lock(sound->spinlock);
-        sound->tags &= ~SOUND_TAGS_WAVEFORM_LOADING;
-        BLI_spin_unlock(sound->spinlock);
-
-        BLI_mutex_lock(pj->mutex);
-        previewjb = previewjb->next;
-        BLI_mutex_unlock(pj->mutex);
-      }
-
-      BLI_mutex_lock(pj->mutex);
-      BLI_freelistN(&pj->previews);
-      pj->total = 0;
-      pj->processed = 0;
-      BLI_mutex_unlock(pj->mutex);
-      break;
+    if (*data->stop || G.is_break) {
+      /* Make sure we cleanup the loading flag! */
+      BLI_spin_lock(sound->spinlock);
+      sound->tags &= ~SOUND_TAGS_WAVEFORM_LOADING;
+      BLI_spin_unlock(sound->spinlock);
+      MEM_freeN(previewjb);
+      continue;
     }
 
+    BKE_sound_read_waveform(previewjb->bmain, sound, data->stop);
+    MEM_freeN(previewjb);
+
     BLI_mutex_lock(pj->mutex);
-    preview_next = previewjb->next;
-    BLI_freelinkN(&pj->previews, previewjb);
-    previewjb = preview_next;
     pj->processed++;
-    *progress = (pj->total > 0) ? (float)pj->processed / (float)pj->total : 1.0f;
-    *do_update = true;
+    *data->progress = (pj->total > 0) ? (float)pj->processed / (float)pj->total : 1.0f;
+    *data->do_update = true;
+    BLI_mutex_unlock(pj->mutex);
+  }
+}
+
+/* Only this runs inside thread. */
+static void preview_startjob(void *data, short *stop, short *do_update, float *progress)
+{
+  PreviewJob *pj = data;
+  PreviewJobThreadData thread_data = {
+      .pj = pj,
+      .stop = stop,
+      .do_update = do_update,
+      .progress = progress,
+  };
+
+  /* Decoding sounds is mostly independent per sound, read the waveforms of multiple strips at
+   * the same time. Every task keeps taking sounds from the list, including ones added while
+   * the job is running. */
+  TaskPool *task_pool = BLI_task_pool_create(&thread_data, TASK_PRIORITY_LOW);
+  const int tasks_num = BLI_system_thread_count();
+  for (int i = 0; i < tasks_num; i++) {
+    BLI_task_pool_push(task_pool, preview_job_task, NULL, false, NULL);
+  }
+  BLI_task_pool_work_and_wait(task_pool);
+  BLI_task_pool_free(task_pool);
+
+  if (*stop || G.is_break) {
+    BLI_mutex_lock(pj->mutex);
+    pj->total = 0;
+    pj->processed = 0;
     BLI_mutex_unlock(pj->mutex);
   }
 }
@@ -51,6 +51,7 @@ static void seq_proxy_build_job(const bContext *C, ReportList *reports)
   ProxyJob *pj = ED_seq_proxy_job_get(C, wm_job);
 
   GSet *file_list = BLI_gset_new(BLI_ghashutil_strhash_p, BLI_ghashutil_strcmp, "file list");
+  ListBase queue = {NULL, NULL};
   bool selected = false; /* Check for no selected strips */
 
   LISTBASE_FOREACH (Sequence *, seq, SEQ_active_seqbase_get(ed)) {
@@ -69,7 +70,7 @@ static void seq_proxy_build_job(const bContext *C, ReportList *reports)
     }
 
     bool success = SEQ_proxy_rebuild_context(
-        pj->main, pj->depsgraph, pj->scene, seq, file_list, &pj->queue, false);
+        pj->main, pj->depsgraph, pj->scene, seq, file_list, &queue, false);
 
     if (!success && (seq->strip->proxy->build_flags & SEQ_PROXY_SKIP_EXISTING) != 0) {
       BKE_reportf(reports, RPT_WARNING, "Overwrite is not checked for %s, skipping", seq->name);
@@ -77,6 +78,7 @@ static void seq_proxy_build_job(const bContext *C, ReportList *reports)
   }
 
   BLI_gset_free(file_list, MEM_freeN);
+  ED_seq_proxy_job_queue_add(pj, &queue);
 
   if (!selected) {
     BKE_reportf(reports, RPT_WARNING, "Select movie or image strips");
@@ -2,6 +2,7 @@
 
 #include <cstring>
 
+#include "BLI_index_mask_ops.hh"
 #include "BLI_listbase.h"
 
 #include "DNA_screen_types.h"
@@ -29,10 +30,11 @@ static void apply_filter_operation(const VArray<T> &data,
                                    const IndexMask mask,
                                    Vector<int64_t> &new_indices)
 {
-  for (const int64_t i : mask) {
-    if (check_fn(data[i])) {
-      new_indices.append(i);
-    }
+  const IndexMask result = index_mask_ops::find_indices_based_on_predicate(
+      mask, 4096, new_indices, [&](const int64_t i) { return check_fn(data[i]); });
+  /* The result only references the new indices when some rows were filtered out. */
+  if (new_indices.is_empty()) {
+    new_indices.extend(result.indices());
   }
 }
 
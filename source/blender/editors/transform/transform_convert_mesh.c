@@ -15,6 +15,7 @@
 #include "BLI_linklist_stack.h"
 #include "BLI_math.h"
 #include "BLI_memarena.h"
+#include "BLI_task.h"
 
 #include "BKE_context.h"
 #include "BKE_crazyspace.h"
@@ -1459,10 +1460,101 @@ static void VertsToTransData(TransInfo *t,
   }
 }
 
+static int tc_mesh_transdata_island_index_get(const struct TransIslandData *island_data,
+                                              const int *dists_index,
+                                              const int vert_index)
+{
+  if (island_data->island_vert_map == NULL) {
+    return -1;
+  }
+  const int connected_index = (dists_index && dists_index[vert_index] != -1) ?
+                                  dists_index[vert_index] :
+                                  vert_index;
+  return island_data->island_vert_map[connected_index];
+}
+
+struct TransDataArgs_EditVerts {
+  TransInfo *t;
+  TransDataContainer *tc;
+  BMEditMesh *em;
+  /** Vertex index of every #TransData. */
+  const int *td_vert_index;
+  int prop_mode;
+  int cd_vert_bweight_offset;
+  int cd_vert_crease_offset;
+  float mtx[3][3];
+  float smtx[3][3];
+  const struct TransIslandData *island_data;
+  const float *dists;
+  const int *dists_index;
+  const struct TransMeshDataCrazySpace *crazyspace_data;
+};
+
+static void tc_mesh_transdata_vert_fn(void *__restrict iter_data_v,
+                                      const int iter,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const struct TransDataArgs_EditVerts *data = iter_data_v;
+  TransDataContainer *tc = data->tc;
+  const int a = data->td_vert_index[iter];
+  BMVert *eve = BM_vert_at_index(data->em->bm, a);
+  TransData *tob = &tc->data[iter];
+  TransDataExtension *tx = tc->data_ext ? &tc->data_ext[iter] : NULL;
+
+  const int island_index = tc_mesh_transdata_island_index_get(
+      data->island_data, data->dists_index, a);
+
+  float *bweight = (data->cd_vert_bweight_offset != -1) ?
+                       BM_ELEM_CD_GET_VOID_P(eve, data->cd_vert_bweight_offset) :
+                   (data->cd_vert_crease_offset != -1) ?
+                       BM_ELEM_CD_GET_VOID_P(eve, data->cd_vert_crease_offset) :
+                       NULL;
+
+  /* Do not use the island center in case we are using islands
+   * only to get axis for snap/rotate to normal... */
+  VertsToTransData(data->t, tob, tx, data->em, eve, bweight, data->island_data, island_index);
+
+  /* selected */
+  if (BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
+    tob->flag |= TD_SELECTED;
+  }
+
+  if (data->prop_mode) {
+    if (data->prop_mode & T_PROP_CONNECTED) {
+      tob->dist = data->dists[a];
+    }
+    else {
+      tob->flag |= TD_NOTCONNECTED;
+      tob->dist = FLT_MAX;
+    }
+  }
+
+  /* CrazySpace */
+  const struct TransMeshDataCrazySpace *crazyspace_data = data->crazyspace_data;
+  transform_convert_mesh_crazyspace_transdata_set(
+      data->mtx,
+      data->smtx,
+      crazyspace_data->defmats ? crazyspace_data->defmats[a] : NULL,
+      crazyspace_data->quats && BM_elem_flag_test(eve, BM_ELEM_TAG) ? crazyspace_data->quats[a] :
+                                                                      NULL,
+      tob);
+
+  if (tc->use_mirror_axis_any) {
+    if (tc->use_mirror_axis_x && fabsf(tob->loc[0]) < TRANSFORM_MAXDIST_MIRROR) {
+      tob->flag |= TD_MIRROR_EDGE_X;
+    }
+    if (tc->use_mirror_axis_y && fabsf(tob->loc[1]) < TRANSFORM_MAXDIST_MIRROR) {
+      tob->flag |= TD_MIRROR_EDGE_Y;
+    }
+    if (tc->use_mirror_axis_z && fabsf(tob->loc[2]) < TRANSFORM_MAXDIST_MIRROR) {
+      tob->flag |= TD_MIRROR_EDGE_Z;
+    }
+  }
+}
+
 void createTransEditVerts(TransInfo *t)
 {
   FOREACH_TRANS_DATA_CONTAINER (t, tc) {
-    TransDataExtension *tx = NULL;
     BMEditMesh *em = BKE_editmesh_from_object(tc->obedit);
     Mesh *me = tc->obedit->data;
     BMesh *bm = em->bm;
@@ -1585,8 +1677,7 @@ void createTransEditVerts(TransInfo *t)
        * but this stores loads of extra stuff, for TFM_SHRINKFATTEN its even more overkill
        * since we may not use the 'alt' transform mode to maintain shell thickness,
        * but with generic transform code its hard to lazy init vars */
-      tx = tc->data_ext = MEM_callocN(tc->data_len * sizeof(TransDataExtension),
-                                      "TransObData ext");
+      tc->data_ext = MEM_callocN(tc->data_len * sizeof(TransDataExtension), "TransObData ext");
     }
 
     int cd_vert_bweight_offset = -1;
@@ -1600,20 +1691,20 @@ void createTransEditVerts(TransInfo *t)
       cd_vert_crease_offset = CustomData_get_offset(&bm->vdata, CD_CREASE);
     }
 
-    TransData *tob = tc->data;
+    /* Fill in the mirror data and find the vertex of every #TransData, then fill in the
+     * #TransData in parallel, most of the time is spent there. */
+    BM_mesh_elem_table_ensure(bm, BM_VERT);
+    int *td_vert_index = MEM_mallocN(sizeof(*td_vert_index) * data_len, __func__);
+    int td_index = 0;
     TransDataMirror *td_mirror = tc->data_mirror;
     BM_ITER_MESH_INDEX (eve, &iter, bm, BM_VERTS_OF_MESH, a) {
       if (BM_elem_flag_test(eve, BM_ELEM_HIDDEN)) {
         continue;
       }
 
-      int island_index = -1;
-      if (island_data.island_vert_map) {
-        const int connected_index = (dists_index && dists_index[a] != -1) ? dists_index[a] : a;
-        island_index = island_data.island_vert_map[connected_index];
-      }
-
       if (mirror_data.vert_map && mirror_data.vert_map[a].index != -1) {
+        const int island_index = tc_mesh_transdata_island_index_get(
+            &island_data, dists_index, a);
         int elem_index = mirror_data.vert_map[a].index;
         BMVert *v_src = BM_vert_at_index(bm, elem_index);
 
@@ -1632,59 +1723,33 @@ void createTransEditVerts(TransInfo *t)
         td_mirror++;
       }
       else if (prop_mode || BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
-        float *bweight = (cd_vert_bweight_offset != -1) ?
-                             BM_ELEM_CD_GET_VOID_P(eve, cd_vert_bweight_offset) :
-                         (cd_vert_crease_offset != -1) ?
-                             BM_ELEM_CD_GET_VOID_P(eve, cd_vert_crease_offset) :
-                             NULL;
-
-        /* Do not use the island center in case we are using islands
-         * only to get axis for snap/rotate to normal... */
-        VertsToTransData(t, tob, tx, em, eve, bweight, &island_data, island_index);
-        if (tx) {
-          tx++;
-        }
-
-        /* selected */
-        if (BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
-          tob->flag |= TD_SELECTED;
-        }
-
-        if (prop_mode) {
-          if (prop_mode & T_PROP_CONNECTED) {
-            tob->dist = dists[a];
-          }
-          else {
-            tob->flag |= TD_NOTCONNECTED;
-            tob->dist = FLT_MAX;
-          }
-        }
-
-        /* CrazySpace */
-        transform_convert_mesh_crazyspace_transdata_set(
-            mtx,
-            smtx,
-            crazyspace_data.defmats ? crazyspace_data.defmats[a] : NULL,
-            crazyspace_data.quats && BM_elem_flag_test(eve, BM_ELEM_TAG) ?
-                crazyspace_data.quats[a] :
-                NULL,
-            tob);
-
-        if (tc->use_mirror_axis_any) {
-          if (tc->use_mirror_axis_x && fabsf(tob->loc[0]) < TRANSFORM_MAXDIST_MIRROR) {
-            tob->flag |= TD_MIRROR_EDGE_X;
-          }
-          if (tc->use_mirror_axis_y && fabsf(tob->loc[1]) < TRANSFORM_MAXDIST_MIRROR) {
-            tob->flag |= TD_MIRROR_EDGE_Y;
-          }
-          if (tc->use_mirror_axis_z && fabsf(tob->loc[2]) < TRANSFORM_MAXDIST_MIRROR) {
-            tob->flag |= TD_MIRROR_EDGE_Z;
-          }
-        }
-
-        tob++;
-      }
-    }
+        td_vert_index[td_index++] = a;
+      }
+    }
+    BLI_assert(td_index == data_len);
+
+    struct TransDataArgs_EditVerts data = {
+        .t = t,
+        .tc = tc,
+        .em = em,
+        .td_vert_index = td_vert_index,
+        .prop_mode = prop_mode,
+        .cd_vert_bweight_offset = cd_vert_bweight_offset,
+        .cd_vert_crease_offset = cd_vert_crease_offset,
+        .island_data = &island_data,
+        .dists = dists,
+        .dists_index = dists_index,
+        .crazyspace_data = &crazyspace_data,
+    };
+    copy_m3_m3(data.mtx, mtx);
+    copy_m3_m3(data.smtx, smtx);
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (data_len >= TRANSDATA_THREAD_LIMIT);
+    BLI_task_parallel_range(0, data_len, &data, tc_mesh_transdata_vert_fn, &settings);
+
+    MEM_freeN(td_vert_index);
 
     transform_convert_mesh_islanddata_free(&island_data);
     transform_convert_mesh_mirrordata_free(&mirror_data);
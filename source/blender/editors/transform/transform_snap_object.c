@@ -83,6 +83,13 @@ typedef struct SnapObjectData {
   };
 } SnapObjectData;
 
+/** An object to snap to, with its matrix (which differs from #Object.obmat for instances). */
+typedef struct SnapObjectCandidate {
+  Object *ob_eval;
+  float obmat[4][4];
+  bool is_object_active;
+} SnapObjectCandidate;
+
 struct SnapObjectContext {
   Scene *scene;
 
@@ -119,6 +126,16 @@ struct SnapObjectContext {
     short clip_plane_len;
     short snap_to_flag;
     bool has_occlusion_plane; /* Ignore plane of occlusion in curves. */
+
+    /**
+     * Objects gathered once for a query that walks the objects several times, to avoid walking
+     * the view layer and building dupli-lists again. Only used when `use_candidates` is set,
+     * the array is kept for the next query. See #snap_object_candidates_gather.
+     */
+    SnapObjectCandidate *candidates;
+    int candidates_len;
+    int candidates_alloc_len;
+    bool use_candidates;
   } runtime;
 };
 
@@ -443,10 +460,10 @@ typedef void (*IterSnapObjsCallback)(SnapObjectContext *sctx,
 /**
  * Walks through all objects in the scene to create the list of objects to snap.
  */
-static void iter_snap_objects(SnapObjectContext *sctx,
-                              const struct SnapObjectParams *params,
-                              IterSnapObjsCallback sob_callback,
-                              void *data)
+static void iter_snap_objects_in_view_layer(SnapObjectContext *sctx,
+                                            const struct SnapObjectParams *params,
+                                            IterSnapObjsCallback sob_callback,
+                                            void *data)
 {
   ViewLayer *view_layer = DEG_get_input_view_layer(sctx->runtime.depsgraph);
   const eSnapSelect snap_select = params->snap_select;
@@ -504,6 +521,61 @@ static void iter_snap_objects(SnapObjectContext *sctx,
   }
 }
 
+static void snap_object_candidate_add_fn(SnapObjectContext *sctx,
+                                         const struct SnapObjectParams *UNUSED(params),
+                                         Object *ob_eval,
+                                         float obmat[4][4],
+                                         bool is_object_active,
+                                         void *UNUSED(data))
+{
+  if (sctx->runtime.candidates_len == sctx->runtime.candidates_alloc_len) {
+    sctx->runtime.candidates_alloc_len = max_ii(64, sctx->runtime.candidates_alloc_len * 2);
+    sctx->runtime.candidates = MEM_reallocN(
+        sctx->runtime.candidates,
+        sizeof(*sctx->runtime.candidates) * sctx->runtime.candidates_alloc_len);
+  }
+  SnapObjectCandidate *candidate = &sctx->runtime.candidates[sctx->runtime.candidates_len++];
+  candidate->ob_eval = ob_eval;
+  copy_m4_m4(candidate->obmat, obmat);
+  candidate->is_object_active = is_object_active;
+}
+
+/**
+ * Gather the objects to snap to, so that the following calls to #iter_snap_objects use them
+ * instead of walking the view layer again, until #snap_object_candidates_clear is called.
+ * Only valid as long as the depsgraph is not evaluated, since dupli-objects are temporary.
+ */
+static void snap_object_candidates_gather(SnapObjectContext *sctx,
+                                          const struct SnapObjectParams *params)
+{
+  sctx->runtime.candidates_len = 0;
+  iter_snap_objects_in_view_layer(sctx, params, snap_object_candidate_add_fn, NULL);
+  sctx->runtime.use_candidates = true;
+}
+
+static void snap_object_candidates_clear(SnapObjectContext *sctx)
+{
+  sctx->runtime.candidates_len = 0;
+  sctx->runtime.use_candidates = false;
+}
+
+static void iter_snap_objects(SnapObjectContext *sctx,
+                              const struct SnapObjectParams *params,
+                              IterSnapObjsCallback sob_callback,
+                              void *data)
+{
+  if (!sctx->runtime.use_candidates) {
+    iter_snap_objects_in_view_layer(sctx, params, sob_callback, data);
+    return;
+  }
+
+  for (int i = 0; i < sctx->runtime.candidates_len; i++) {
+    SnapObjectCandidate *candidate = &sctx->runtime.candidates[i];
+    sob_callback(
+        sctx, params, candidate->ob_eval, candidate->obmat, candidate->is_object_active, data);
+  }
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -2872,6 +2944,7 @@ void ED_transform_snap_object_context_destroy(SnapObjectContext *sctx)
     BLI_ghash_free(sctx->cache.data_to_object_map, NULL, NULL);
   }
   BLI_memarena_free(sctx->cache.mem_arena);
+  MEM_SAFE_FREE(sctx->runtime.candidates);
 
   MEM_freeN(sctx);
 }
@@ -3202,21 +3275,39 @@ short ED_transform_snap_object_project_view3d_ex(SnapObjectContext *sctx,
                                                  float r_obmat[4][4],
                                                  float r_face_nor[3])
 {
-  return transform_snap_context_project_view3d_mixed_impl(sctx,
-                                                          depsgraph,
-                                                          region,
-                                                          v3d,
-                                                          snap_to,
-                                                          params,
-                                                          mval,
-                                                          prev_co,
-                                                          dist_px,
-                                                          r_loc,
-                                                          r_no,
-                                                          r_index,
-                                                          r_ob,
-                                                          r_obmat,
-                                                          r_face_nor);
+  sctx->runtime.depsgraph = depsgraph;
+  sctx->runtime.v3d = v3d;
+
+  /* The objects are walked twice when ray-casting (for faces or the occlusion test) and snapping
+   * to the nearest elements, gather them only once in that case. */
+  const bool use_raycast = (snap_to & SCE_SNAP_MODE_FACE) ||
+                           (params->use_occlusion_test && !XRAY_ENABLED(v3d));
+  const bool use_nearest = (snap_to & (SCE_SNAP_MODE_VERTEX | SCE_SNAP_MODE_EDGE |
+                                       SCE_SNAP_MODE_EDGE_MIDPOINT |
+                                       SCE_SNAP_MODE_EDGE_PERPENDICULAR)) != 0;
+  if (use_raycast && use_nearest) {
+    snap_object_candidates_gather(sctx, params);
+  }
+
+  const short retval = transform_snap_context_project_view3d_mixed_impl(sctx,
+                                                                        depsgraph,
+                                                                        region,
+                                                                        v3d,
+                                                                        snap_to,
+                                                                        params,
+                                                                        mval,
+                                                                        prev_co,
+                                                                        dist_px,
+                                                                        r_loc,
+                                                                        r_no,
+                                                                        r_index,
+                                                                        r_ob,
+                                                                        r_obmat,
+                                                                        r_face_nor);
+
+  snap_object_candidates_clear(sctx);
+
+  return retval;
 }
 
 short ED_transform_snap_object_project_view3d(SnapObjectContext *sctx,
@@ -160,8 +160,10 @@ class CustomMF_SI_SI_SI_SO : public MultiFunction {
                const VArray<In2> &in2,
                const VArray<In3> &in3,
                MutableSpan<Out1> out1) {
-      mask.foreach_index([&](int i) {
-        new (static_cast<void *>(&out1[i])) Out1(element_fn(in1[i], in2[i], in3[i]));
+      devirtualize_varray3(in1, in2, in3, [&](const auto &in1, const auto &in2, const auto &in3) {
+        mask.foreach_index([&](int i) {
+          new (static_cast<void *>(&out1[i])) Out1(element_fn(in1[i], in2[i], in3[i]));
+        });
       });
     };
   }
@@ -270,6 +270,12 @@ class MFProcedure : NonCopyable, NonMovable {
   MFDummyInstruction &new_dummy_instruction();
   MFReturnInstruction &new_return_instruction();
 
+  /**
+   * Remove an instruction from the procedure. No other instruction may point to it anymore. The
+   * instruction is unlinked from its variables and the next instructions.
+   */
+  void delete_instruction(MFInstruction &instruction);
+
   void add_parameter(MFParamType::InterfaceType interface_type, MFVariable &variable);
   Span<ConstMFParameter> params() const;
 
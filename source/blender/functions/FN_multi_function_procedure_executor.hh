@@ -15,6 +15,17 @@ class MFProcedureExecutor : public MultiFunction {
  private:
   MFSignature signature_;
   const MFProcedure &procedure_;
+  /**
+   * When the procedure does not contain any branches, all indices pass through the same
+   * instructions in the same order. Those are stored here, so that they can be executed without
+   * the generic scheduler. Empty when the procedure is not a straight line.
+   */
+  Vector<const MFInstruction *> straight_line_instructions_;
+  /**
+   * Number of indices that is processed by all instructions in a straight line procedure, before
+   * moving on to the next indices. It is chosen so that the intermediate buffers stay in cache.
+   */
+  int64_t segment_size_ = 0;
 
  public:
   MFProcedureExecutor(const MFProcedure &procedure);
@@ -23,6 +34,10 @@ class MFProcedureExecutor : public MultiFunction {
 
  private:
   ExecutionHints get_execution_hints() const override;
+
+  void call_straight_line_segmented(IndexMask full_mask,
+                                    MFParams params,
+                                    MFContext context) const;
 };
 
 }  // namespace blender::fn
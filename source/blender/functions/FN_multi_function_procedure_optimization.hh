@@ -44,4 +44,24 @@ namespace blender::fn::procedure_optimization {
  */
 void move_destructs_up(MFProcedure &procedure, MFInstruction &block_end_instr);
 
+/**
+ * Procedures generated from higher level descriptions (e.g. field trees) often contain the same
+ * computation multiple times, for example when the same sub-expression is used in different
+ * places. This optimization pass removes call instructions that call an equal function with the
+ * same input variables as an earlier call instruction. Users of the removed outputs use the
+ * outputs of the earlier call instead.
+ *
+ * Since removing one call can make later calls identical, chains of duplicated computations are
+ * removed entirely. Functions that depend on the context or have mutable parameters are never
+ * removed.
+ *
+ * Like #move_destructs_up, this only works on a single chain of instructions. It should run
+ * before destruct instructions are moved up. Otherwise the outputs of earlier calls may already
+ * be destructed when a duplicate call is found.
+ *
+ * \param procedure: The procedure that should be optimized.
+ * \param block_end_instr: The last instruction within a linear chain of instructions.
+ */
+void eliminate_common_subexpressions(MFProcedure &procedure, MFInstruction &block_end_instr);
+
 }  // namespace blender::fn::procedure_optimization
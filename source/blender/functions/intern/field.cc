@@ -4,6 +4,7 @@
 #include "BLI_multi_value_map.hh"
 #include "BLI_set.hh"
 #include "BLI_stack.hh"
+#include "BLI_task.hh"
 #include "BLI_vector_set.hh"
 
 #include "FN_field.hh"
@@ -136,13 +137,42 @@ static Set<GFieldRef> find_varying_fields(const FieldTreeInfo &field_tree_info,
   return found_fields;
 }
 
+/**
+ * Evaluate fields that don't depend on any input and create a function for each of them that
+ * outputs the computed value. All fields are evaluated together, so an operation with multiple
+ * outputs is only called once.
+ */
+static Vector<const MultiFunction *> build_constant_functions_for_fields(
+    MFProcedure &procedure, Span<GFieldRef> fields)
+{
+  ResourceScope scope;
+  FieldContext context;
+  Vector<GVArray> varrays = evaluate_fields(scope, fields, IndexRange(1), context);
+
+  Vector<const MultiFunction *> functions;
+  for (const int i : fields.index_range()) {
+    BLI_assert(!fields[i].node().depends_on_input());
+    const CPPType &type = fields[i].cpp_type();
+    BUFFER_FOR_CPP_TYPE_VALUE(type, buffer);
+    varrays[i].get_to_uninitialized(0, buffer);
+    functions.append(
+        &procedure.construct_function<CustomMF_GenericConstant>(type, buffer, true));
+    type.destruct(buffer);
+  }
+  return functions;
+}
+
 /**
  * Builds the #procedure so that it computes the fields.
+ *
+ * \param fold_constants: When true, operations that don't depend on any input are evaluated
+ * while the procedure is built, instead of every time it is executed.
  */
 static void build_multi_function_procedure_for_fields(MFProcedure &procedure,
                                                       ResourceScope &scope,
                                                       const FieldTreeInfo &field_tree_info,
-                                                      Span<GFieldRef> output_fields)
+                                                      Span<GFieldRef> output_fields,
+                                                      const bool fold_constants)
 {
   MFProcedureBuilder builder{procedure};
   /* Every input, intermediate and output field corresponds to a variable in the procedure. */
@@ -182,6 +212,33 @@ static void build_multi_function_procedure_for_fields(MFProcedure &procedure,
         }
         case FieldNodeType::Operation: {
           const FieldOperation &operation_node = static_cast<const FieldOperation &>(field.node());
+          if (fold_constants && !field_node.depends_on_input()) {
+            /* Fold all used outputs of the operation together, so that its function is only
+             * evaluated once. */
+            Vector<GFieldRef> fields_to_fold;
+            const MultiFunction &multi_function = operation_node.multi_function();
+            int output_index = 0;
+            for (const int param_index : multi_function.param_indices()) {
+              if (multi_function.param_type(param_index).interface_type() !=
+                  MFParamType::Output) {
+                continue;
+              }
+              const GFieldRef output_field{operation_node, output_index};
+              if (output_field == field ||
+                  !field_tree_info.field_users.lookup(output_field).is_empty() ||
+                  output_fields.contains(output_field)) {
+                fields_to_fold.append(output_field);
+              }
+              output_index++;
+            }
+            const Vector<const MultiFunction *> functions = build_constant_functions_for_fields(
+                procedure, fields_to_fold);
+            for (const int i : fields_to_fold.index_range()) {
+              MFVariable &new_variable = *builder.add_call<1>(*functions[i])[0];
+              variable_by_field.add_new(fields_to_fold[i], &new_variable);
+            }
+            break;
+          }
           const Span<GField> operation_inputs = operation_node.inputs();
 
           if (field_with_index.current_input_index < operation_inputs.size()) {
@@ -267,12 +324,36 @@ static void build_multi_function_procedure_for_fields(MFProcedure &procedure,
 
   MFReturnInstruction &return_instr = builder.add_return();
 
+  procedure_optimization::eliminate_common_subexpressions(procedure, return_instr);
   procedure_optimization::move_destructs_up(procedure, return_instr);
 
   // std::cout << procedure.to_dot() << "\n";
   BLI_assert(procedure.validate());
 }
 
+/**
+ * Approximate size of all intermediate buffers of a chunk when large masks are evaluated in
+ * chunks. Keeping it below the L2 cache size means that the buffers stay in the cache of the
+ * thread that evaluates the chunk.
+ */
+static constexpr int64_t evaluation_chunk_byte_budget = 256 * 1024;
+
+/**
+ * \return How many indices should be evaluated at once by one thread.
+ */
+static int64_t compute_evaluation_chunk_size(const MFProcedure &procedure)
+{
+  int64_t bytes_per_index = 0;
+  for (const MFVariable *variable : procedure.variables()) {
+    const MFDataType data_type = variable->data_type();
+    if (data_type.is_single()) {
+      bytes_per_index += data_type.single_type().size();
+    }
+  }
+  const int64_t chunk_size = evaluation_chunk_byte_budget / std::max<int64_t>(bytes_per_index, 1);
+  return std::clamp<int64_t>(chunk_size, 1024, 10000);
+}
+
 Vector<GVArray> evaluate_fields(ResourceScope &scope,
                                 Span<GFieldRef> fields_to_evaluate,
                                 IndexMask mask,
@@ -365,17 +446,14 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
     /* Build the procedure for those fields. */
     MFProcedure procedure;
     build_multi_function_procedure_for_fields(
-        procedure, scope, field_tree_info, varying_fields_to_evaluate);
+        procedure, scope, field_tree_info, varying_fields_to_evaluate, true);
+    const int64_t chunk_size = compute_evaluation_chunk_size(procedure);
     MFProcedureExecutor procedure_executor{procedure};
-
-    MFParamsBuilder mf_params{procedure_executor, &mask};
     MFContextBuilder mf_context;
 
-    /* Provide inputs to the procedure executor. */
-    for (const GVArray &varray : field_context_inputs) {
-      mf_params.add_readonly_single_input(varray);
-    }
-
+    /* Buffers that the computed values are written to. A null pointer means that the values are
+     * written into a destination virtual array that does not provide a span. */
+    Array<void *> output_buffers(varying_fields_to_evaluate.size());
     for (const int i : varying_fields_to_evaluate.index_range()) {
       const GFieldRef &field = varying_fields_to_evaluate[i];
       const CPPType &type = field.cpp_type();
@@ -383,10 +461,25 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
 
       /* Try to get an existing virtual array that the result should be written into. */
       GVMutableArray dst_varray = get_dst_varray(out_index);
-      void *buffer;
-      if (!dst_varray || !dst_varray.is_span()) {
+      if (dst_varray && dst_varray.is_span()) {
+        /* Write the result into the existing span. */
+        output_buffers[i] = dst_varray.get_internal_span().data();
+
+        r_varrays[out_index] = dst_varray;
+        is_output_written_to_dst[out_index] = true;
+      }
+      else if (dst_varray && mask.size() > chunk_size) {
+        /* When evaluating in chunks, the results are moved into the destination chunk by chunk,
+         * so they don't have to be stored for the full mask. */
+        output_buffers[i] = nullptr;
+
+        r_varrays[out_index] = dst_varray;
+        is_output_written_to_dst[out_index] = true;
+      }
+      else {
         /* Allocate a new buffer for the computed result. */
-        buffer = scope.linear_allocator().allocate(type.size() * array_size, type.alignment());
+        void *buffer = scope.linear_allocator().allocate(type.size() * array_size,
+                                                         type.alignment());
 
         if (!type.is_trivially_destructible()) {
           /* Destruct values in the end. */
@@ -394,22 +487,77 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
               [buffer, mask, &type]() { type.destruct_indices(buffer, mask); });
         }
 
+        output_buffers[i] = buffer;
         r_varrays[out_index] = GVArray::ForSpan({type, buffer, array_size});
       }
-      else {
-        /* Write the result into the existing span. */
-        buffer = dst_varray.get_internal_span().data();
+    }
 
-        r_varrays[out_index] = dst_varray;
-        is_output_written_to_dst[out_index] = true;
+    if (mask.size() <= chunk_size) {
+      MFParamsBuilder mf_params{procedure_executor, &mask};
+
+      /* Provide inputs to the procedure executor. */
+      for (const GVArray &varray : field_context_inputs) {
+        mf_params.add_readonly_single_input(varray);
+      }
+      /* Pass output buffers to the procedure executor. */
+      for (const int i : varying_fields_to_evaluate.index_range()) {
+        const CPPType &type = varying_fields_to_evaluate[i].cpp_type();
+        mf_params.add_uninitialized_single_output({type, output_buffers[i], array_size});
       }
 
-      /* Pass output buffer to the procedure executor. */
-      const GMutableSpan span{type, buffer, array_size};
-      mf_params.add_uninitialized_single_output(span);
+      procedure_executor.call(mask, mf_params, mf_context);
     }
+    else {
+      /* Run the whole procedure on small slices of the mask in parallel instead of evaluating
+       * every function for all indices at once. That way the intermediate values of a slice are
+       * still in the cache when the next function uses them. */
+      threading::parallel_for(mask.index_range(), chunk_size, [&](const IndexRange sub_range) {
+        const IndexMask sliced_mask = mask.slice(sub_range);
+        const int64_t slice_start = sliced_mask[0];
+        const IndexRange slice_range{slice_start, sliced_mask.last() - slice_start + 1};
+
+        /* Offset the indices, so that intermediate buffers only have to be as large as a
+         * slice. */
+        Vector<int64_t> offset_mask_indices;
+        const IndexMask offset_mask = mask.slice_and_offset(sub_range, offset_mask_indices);
+        const int64_t offset_array_size = offset_mask.min_array_size();
+
+        MFParamsBuilder mf_params{procedure_executor, offset_array_size};
+        for (const GVArray &varray : field_context_inputs) {
+          mf_params.add_readonly_single_input(varray.slice(slice_range));
+        }
 
-    procedure_executor.call_auto(mask, mf_params, mf_context);
+        LinearAllocator<> slice_allocator;
+        Vector<GMutableSpan> slice_buffers;
+        for (const int i : varying_fields_to_evaluate.index_range()) {
+          const CPPType &type = varying_fields_to_evaluate[i].cpp_type();
+          if (output_buffers[i] == nullptr) {
+            void *buffer = slice_allocator.allocate(type.size() * offset_array_size,
+                                                    type.alignment());
+            slice_buffers.append({type, buffer, offset_array_size});
+          }
+          else {
+            const GMutableSpan span{type, output_buffers[i], array_size};
+            slice_buffers.append(span.slice(slice_range));
+          }
+          mf_params.add_uninitialized_single_output(slice_buffers[i]);
+        }
+
+        procedure_executor.call(offset_mask, mf_params, mf_context);
+
+        /* Move the values of this slice into the destinations that are not spans. */
+        for (const int i : varying_fields_to_evaluate.index_range()) {
+          if (output_buffers[i] != nullptr) {
+            continue;
+          }
+          GVMutableArray dst_varray = get_dst_varray(varying_field_indices[i]);
+          const GMutableSpan buffer = slice_buffers[i];
+          for (const int64_t index : offset_mask) {
+            dst_varray.set_by_relocate(slice_start + index, buffer[index]);
+          }
+        }
+      });
+    }
   }
 
   /* Evaluate constant fields if necessary. */
@@ -417,7 +565,7 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
     /* Build the procedure for those fields. */
     MFProcedure procedure;
     build_multi_function_procedure_for_fields(
-        procedure, scope, field_tree_info, constant_fields_to_evaluate);
+        procedure, scope, field_tree_info, constant_fields_to_evaluate, false);
     MFProcedureExecutor procedure_executor{procedure};
     MFParamsBuilder mf_params{procedure_executor, 1};
     MFContextBuilder mf_context;
@@ -4,8 +4,99 @@
 
 #include "BLI_stack.hh"
 
+#include <optional>
+
 namespace blender::fn {
 
+/**
+ * Straight line procedures are executed on segments of this many bytes of intermediate data per
+ * variable and index, so that the buffers of all variables stay in the cache while a segment is
+ * passed through all instructions. Consecutive segments reuse the same buffers.
+ */
+static constexpr int64_t segment_buffers_byte_budget = 128 * 1024;
+static constexpr int64_t min_segment_size = 256;
+static constexpr int64_t max_segment_size = 4096;
+
+/**
+ * Memory of thread-local scratch allocators beyond this size is freed after every execution,
+ * so that one large execution doesn't keep its memory alive.
+ */
+static constexpr int64_t max_scratch_kept_bytes = 4 * 1024 * 1024;
+
+/**
+ * Find all instructions that are executed in a procedure that does not contain any branches.
+ * An empty vector is returned when the procedure has branches.
+ */
+static Vector<const MFInstruction *> find_straight_line_instructions(
+    const MFProcedure &procedure)
+{
+  Vector<const MFInstruction *> instructions;
+  const MFInstruction *instruction = procedure.entry();
+  while (instruction != nullptr) {
+    instructions.append(instruction);
+    switch (instruction->type()) {
+      case MFInstructionType::Call: {
+        instruction = static_cast<const MFCallInstruction *>(instruction)->next();
+        break;
+      }
+      case MFInstructionType::Destruct: {
+        instruction = static_cast<const MFDestructInstruction *>(instruction)->next();
+        break;
+      }
+      case MFInstructionType::Dummy: {
+        instruction = static_cast<const MFDummyInstruction *>(instruction)->next();
+        break;
+      }
+      case MFInstructionType::Branch: {
+        return {};
+      }
+      case MFInstructionType::Return: {
+        return instructions;
+      }
+    }
+  }
+  return {};
+}
+
+/**
+ * \return The number of indices that is processed at once when executing a straight line
+ * procedure, or zero if the procedure should not be split into segments.
+ */
+static int64_t compute_segment_size(const MFProcedure &procedure,
+                                    const Span<const MFInstruction *> straight_line_instructions)
+{
+  if (straight_line_instructions.is_empty()) {
+    return 0;
+  }
+  for (const ConstMFParameter &param : procedure.params()) {
+    if (param.variable->data_type().is_vector()) {
+      /* Vector parameters can't be sliced. */
+      return 0;
+    }
+  }
+  for (const MFInstruction *instruction : straight_line_instructions) {
+    if (instruction->type() == MFInstructionType::Call) {
+      const MultiFunction &fn = static_cast<const MFCallInstruction *>(instruction)->fn();
+      if (fn.depends_on_context()) {
+        /* Be conservative and pass all indices to functions that depend on the context. */
+        return 0;
+      }
+    }
+  }
+  int64_t bytes_per_index = 0;
+  for (const MFVariable *variable : procedure.variables()) {
+    const MFDataType data_type = variable->data_type();
+    if (data_type.is_single()) {
+      bytes_per_index += data_type.single_type().size();
+    }
+    else {
+      bytes_per_index += data_type.vector_base_type().size();
+    }
+  }
+  const int64_t segment_size = segment_buffers_byte_budget / std::max<int64_t>(bytes_per_index, 1);
+  return std::clamp(segment_size, min_segment_size, max_segment_size);
+}
+
 MFProcedureExecutor::MFProcedureExecutor(const MFProcedure &procedure) : procedure_(procedure)
 {
   MFSignatureBuilder signature("Procedure Executor");
@@ -16,6 +107,9 @@ MFProcedureExecutor::MFProcedureExecutor(const MFProcedure &procedure) : procedu
 
   signature_ = signature.build();
   this->set_signature(&signature_);
+
+  straight_line_instructions_ = find_straight_line_instructions(procedure);
+  segment_size_ = compute_segment_size(procedure, straight_line_instructions_);
 }
 
 using IndicesSplitVectors = std::array<Vector<int64_t>, 2>;
@@ -814,13 +908,14 @@ void ValueAllocator::release_variable_state(VariableState *state)
 /** Keeps track of the states of all variables during evaluation. */
 class VariableStates {
  private:
-  ValueAllocator value_allocator_;
+  /** Not owned, so that buffers can be reused when the procedure is evaluated multiple times. */
+  ValueAllocator &value_allocator_;
   Map<const MFVariable *, VariableState *> variable_states_;
   IndexMask full_mask_;
 
  public:
-  VariableStates(LinearAllocator<> &linear_allocator, IndexMask full_mask)
-      : value_allocator_(linear_allocator), full_mask_(full_mask)
+  VariableStates(ValueAllocator &value_allocator, IndexMask full_mask)
+      : value_allocator_(value_allocator), full_mask_(full_mask)
   {
   }
 
@@ -1163,17 +1258,46 @@ class InstructionScheduler {
   }
 };
 
-void MFProcedureExecutor::call(IndexMask full_mask, MFParams params, MFContext context) const
+/**
+ * Execute the instructions of a procedure without branches for all indices in the mask.
+ */
+static void execute_straight_line_instructions(const Span<const MFInstruction *> instructions,
+                                               VariableStates &variable_states,
+                                               const MFContext &context)
 {
-  BLI_assert(procedure_.validate());
-
-  LinearAllocator<> linear_allocator;
-
-  VariableStates variable_states{linear_allocator, full_mask};
-  variable_states.add_initial_variable_states(*this, procedure_, params);
+  const IndexMask mask = variable_states.full_mask();
+  for (const MFInstruction *instruction : instructions) {
+    switch (instruction->type()) {
+      case MFInstructionType::Call: {
+        const MFCallInstruction &call_instruction = *static_cast<const MFCallInstruction *>(
+            instruction);
+        execute_call_instruction(call_instruction, mask, variable_states, context);
+        break;
+      }
+      case MFInstructionType::Destruct: {
+        const MFDestructInstruction &destruct_instruction =
+            *static_cast<const MFDestructInstruction *>(instruction);
+        variable_states.destruct(*destruct_instruction.variable(), mask);
+        break;
+      }
+      case MFInstructionType::Dummy:
+      case MFInstructionType::Return: {
+        break;
+      }
+      case MFInstructionType::Branch: {
+        BLI_assert_unreachable();
+        break;
+      }
+    }
+  }
+}
 
+static void execute_scheduled_instructions(const MFProcedure &procedure,
+                                           VariableStates &variable_states,
+                                           const MFContext &context)
+{
   InstructionScheduler scheduler;
-  scheduler.add_referenced_indices(*procedure_.entry(), full_mask);
+  scheduler.add_referenced_indices(*procedure.entry(), variable_states.full_mask());
 
   /* Loop until all indices got to a return instruction. */
   while (NextInstructionInfo instr_info = scheduler.pop_next()) {
@@ -1218,10 +1342,16 @@ void MFProcedureExecutor::call(IndexMask full_mask, MFParams params, MFContext c
       }
     }
   }
+}
 
-  for (const int param_index : this->param_indices()) {
-    const MFParamType param_type = this->param_type(param_index);
-    const MFVariable *variable = procedure_.params()[param_index].variable;
+static void finish_param_variable_states(const MFProcedureExecutor &fn,
+                                         const MFProcedure &procedure,
+                                         VariableStates &variable_states)
+{
+  const IndexMask full_mask = variable_states.full_mask();
+  for (const int param_index : fn.param_indices()) {
+    const MFParamType param_type = fn.param_type(param_index);
+    const MFVariable *variable = procedure.params()[param_index].variable;
     VariableState &variable_state = variable_states.get_variable_state(*variable);
     switch (param_type.interface_type()) {
       case MFParamType::Input: {
@@ -1242,6 +1372,137 @@ void MFProcedureExecutor::call(IndexMask full_mask, MFParams params, MFContext c
   }
 }
 
+/**
+ * Provides the #LinearAllocator for the intermediate values of one execution. Small executions
+ * use a thread-local allocator that is reset afterwards, so that evaluating procedures many times
+ * on small masks (e.g. per curve or per instance) doesn't allocate memory from the system once
+ * the allocator has grown large enough. Executions that are nested on the same thread, because
+ * a called function executes a procedure itself or the thread runs another task while waiting,
+ * get their own allocator.
+ */
+class ExecutionAllocator : NonCopyable, NonMovable {
+ private:
+  struct ThreadScratch {
+    LinearAllocator<> allocator;
+    bool is_used = false;
+  };
+
+  ThreadScratch *scratch_ = nullptr;
+  std::optional<LinearAllocator<>> own_allocator_;
+
+ public:
+  ExecutionAllocator(const bool is_small)
+  {
+    static thread_local ThreadScratch thread_scratch;
+    if (is_small && !thread_scratch.is_used) {
+      scratch_ = &thread_scratch;
+      scratch_->is_used = true;
+    }
+    else {
+      own_allocator_.emplace();
+    }
+  }
+
+  ~ExecutionAllocator()
+  {
+    if (scratch_ != nullptr) {
+      scratch_->allocator.reset(max_scratch_kept_bytes);
+      scratch_->is_used = false;
+    }
+  }
+
+  LinearAllocator<> &get()
+  {
+    return scratch_ ? scratch_->allocator : *own_allocator_;
+  }
+};
+
+void MFProcedureExecutor::call(IndexMask full_mask, MFParams params, MFContext context) const
+{
+  BLI_assert(procedure_.validate());
+
+  if (segment_size_ > 0 && full_mask.size() > segment_size_ && full_mask.is_range()) {
+    this->call_straight_line_segmented(full_mask, params, context);
+    return;
+  }
+
+  /* The allocator must outlive the variable states, which are destructed in reverse order. */
+  ExecutionAllocator execution_allocator{full_mask.min_array_size() <= max_segment_size};
+  ValueAllocator value_allocator{execution_allocator.get()};
+
+  VariableStates variable_states{value_allocator, full_mask};
+  variable_states.add_initial_variable_states(*this, procedure_, params);
+
+  if (straight_line_instructions_.is_empty()) {
+    execute_scheduled_instructions(procedure_, variable_states, context);
+  }
+  else {
+    execute_straight_line_instructions(straight_line_instructions_, variable_states, context);
+  }
+
+  finish_param_variable_states(*this, procedure_, variable_states);
+}
+
+/**
+ * Pass small segments of the mask through all instructions of a straight line procedure one after
+ * another. This way the intermediate values of a segment are still in the cache when they are used
+ * by the next instruction, instead of having to be loaded from main memory again. The intermediate
+ * buffers only have to be as large as a segment and are shared by all segments.
+ */
+void MFProcedureExecutor::call_straight_line_segmented(IndexMask full_mask,
+                                                       MFParams params,
+                                                       MFContext context) const
+{
+  /* Only segment sized buffers are allocated. */
+  ExecutionAllocator execution_allocator{true};
+  ValueAllocator value_allocator{execution_allocator.get()};
+
+  /* Segments are processed in order and the mask is a range, so only the last segment can be
+   * smaller than the others. This ensures that reused buffers are always large enough. */
+  BLI_assert(full_mask.is_range());
+  const IndexRange full_range = full_mask.as_range();
+  for (int64_t segment_start = 0; segment_start < full_range.size();
+       segment_start += segment_size_) {
+    const int64_t size = std::min(segment_size_, full_range.size() - segment_start);
+    const IndexRange input_slice_range = full_range.slice(segment_start, size);
+    const IndexMask offset_mask = IndexRange(size);
+
+    MFParamsBuilder offset_params{*this, offset_mask.min_array_size()};
+    for (const int param_index : this->param_indices()) {
+      const MFParamType param_type = this->param_type(param_index);
+      switch (param_type.category()) {
+        case MFParamType::SingleInput: {
+          const GVArray &varray = params.readonly_single_input(param_index);
+          offset_params.add_readonly_single_input(varray.slice(input_slice_range));
+          break;
+        }
+        case MFParamType::SingleMutable: {
+          const GMutableSpan span = params.single_mutable(param_index);
+          offset_params.add_single_mutable(span.slice(input_slice_range));
+          break;
+        }
+        case MFParamType::SingleOutput: {
+          const GMutableSpan span = params.uninitialized_single_output(param_index);
+          offset_params.add_uninitialized_single_output(span.slice(input_slice_range));
+          break;
+        }
+        case MFParamType::VectorInput:
+        case MFParamType::VectorMutable:
+        case MFParamType::VectorOutput: {
+          BLI_assert_unreachable();
+          break;
+        }
+      }
+    }
+    MFParams offset_mf_params{offset_params};
+
+    VariableStates variable_states{value_allocator, offset_mask};
+    variable_states.add_initial_variable_states(*this, procedure_, offset_mf_params);
+    execute_straight_line_instructions(straight_line_instructions_, variable_states, context);
+    finish_param_variable_states(*this, procedure_, variable_states);
+  }
+}
+
 MultiFunction::ExecutionHints MFProcedureExecutor::get_execution_hints() const
 {
   ExecutionHints hints;
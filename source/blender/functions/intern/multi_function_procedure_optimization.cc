@@ -2,6 +2,8 @@
 
 #include "FN_multi_function_procedure_optimization.hh"
 
+#include "BLI_set.hh"
+
 namespace blender::fn::procedure_optimization {
 
 void move_destructs_up(MFProcedure &procedure, MFInstruction &block_end_instr)
@@ -73,4 +75,302 @@ void move_destructs_up(MFProcedure &procedure, MFInstruction &block_end_instr)
   }
 }
 
+/**
+ * \return All instructions of the linear chain that ends at the given instruction, in the order in
+ * which they are executed.
+ */
+static Vector<MFInstruction *> find_block_instructions(MFInstruction &block_end_instr)
+{
+  Vector<MFInstruction *> instructions;
+  MFInstruction *current_instr = &block_end_instr;
+  while (current_instr != nullptr && current_instr->type() != MFInstructionType::Branch) {
+    instructions.append(current_instr);
+    const Span<MFInstructionCursor> prev_cursors = current_instr->prev();
+    if (prev_cursors.size() != 1) {
+      break;
+    }
+    current_instr = prev_cursors[0].instruction();
+  }
+  std::reverse(instructions.begin(), instructions.end());
+  return instructions;
+}
+
+/**
+ * Link all instructions pointing to the given instruction to the next instruction instead and
+ * delete it.
+ */
+static void remove_instruction_from_chain(MFProcedure &procedure,
+                                          MFInstruction &instr,
+                                          MFInstruction *next_instr)
+{
+  while (!instr.prev().is_empty()) {
+    /* Do a copy of the cursor here, because `instr.prev()` changes when #set_next is called. */
+    const MFInstructionCursor cursor = instr.prev()[0];
+    cursor.set_next(procedure, next_instr);
+  }
+  procedure.delete_instruction(instr);
+}
+
+static bool is_mutable_or_output_param(const MFCallInstruction &call_instr, const int param_index)
+{
+  return ELEM(call_instr.fn().param_type(param_index).interface_type(),
+              MFParamType::Mutable,
+              MFParamType::Output);
+}
+
+/**
+ * \return True when the call can be replaced by an equal earlier call. This requires that the
+ * call has no side effects and that all users of its outputs are known.
+ */
+static bool call_is_removable(MFCallInstruction &call_instr,
+                              const Set<const MFVariable *> &param_variables,
+                              const Map<const MFInstruction *, int> &position_by_instr)
+{
+  const MultiFunction &fn = call_instr.fn();
+  if (fn.depends_on_context()) {
+    return false;
+  }
+  bool has_used_output = false;
+  for (const int param_index : fn.param_indices()) {
+    MFVariable *variable = call_instr.params()[param_index];
+    switch (fn.param_type(param_index).interface_type()) {
+      case MFParamType::Input: {
+        break;
+      }
+      case MFParamType::Mutable: {
+        return false;
+      }
+      case MFParamType::Output: {
+        if (variable == nullptr) {
+          break;
+        }
+        if (param_variables.contains(variable)) {
+          /* The caller provides the storage for this variable, so it can't be replaced. */
+          return false;
+        }
+        for (const MFInstruction *user : variable->users()) {
+          if (!position_by_instr.contains(user)) {
+            /* The variable is used outside of the block. */
+            return false;
+          }
+        }
+        has_used_output = true;
+        break;
+      }
+    }
+  }
+  return has_used_output;
+}
+
+/**
+ * \return True when the variable is not changed by an instruction after the given position
+ * and is not used outside of the block.
+ */
+static bool variable_is_unchanged_after(MFVariable &variable,
+                                        const int position,
+                                        const Map<const MFInstruction *, int> &position_by_instr)
+{
+  for (const MFInstruction *user : variable.users()) {
+    const int user_position = position_by_instr.lookup_default(user, -1);
+    if (user_position == -1) {
+      return false;
+    }
+    if (user_position <= position || user->type() != MFInstructionType::Call) {
+      continue;
+    }
+    const MFCallInstruction &user_call = *static_cast<const MFCallInstruction *>(user);
+    for (const int param_index : user_call.params().index_range()) {
+      if (user_call.params()[param_index] == &variable &&
+          is_mutable_or_output_param(user_call, param_index)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * \return True when the earlier call computes all used outputs of the later call.
+ */
+static bool calls_are_equal(MFCallInstruction &earlier_call,
+                            const MFCallInstruction &later_call,
+                            const int later_position,
+                            const Map<const MFInstruction *, int> &position_by_instr)
+{
+  const MultiFunction &fn = later_call.fn();
+  const MultiFunction &earlier_fn = earlier_call.fn();
+  if (&fn != &earlier_fn && !fn.equals(earlier_fn)) {
+    return false;
+  }
+  for (const int param_index : fn.param_indices()) {
+    const MFVariable *variable = later_call.params()[param_index];
+    MFVariable *earlier_variable = earlier_call.params()[param_index];
+    if (fn.param_type(param_index).interface_type() == MFParamType::Input) {
+      if (variable != earlier_variable) {
+        return false;
+      }
+    }
+    else if (variable != nullptr) {
+      if (earlier_variable == nullptr) {
+        /* The output was not computed by the earlier call. */
+        return false;
+      }
+      if (!variable_is_unchanged_after(*earlier_variable, later_position, position_by_instr)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * Make all users of the old variable use the new variable instead. Only the last destruct
+ * instruction of both variables is kept, so that the new variable lives long enough.
+ */
+static void replace_variable(MFProcedure &procedure,
+                             MFVariable &old_variable,
+                             MFVariable &new_variable,
+                             const bool new_variable_is_param,
+                             const Map<const MFInstruction *, int> &position_by_instr,
+                             Set<const MFInstruction *> &r_deleted_instrs)
+{
+  Vector<MFDestructInstruction *> destruct_instrs;
+  for (MFInstruction *user : new_variable.users()) {
+    if (user->type() == MFInstructionType::Destruct) {
+      destruct_instrs.append(static_cast<MFDestructInstruction *>(user));
+    }
+  }
+  const Vector<MFInstruction *> old_users = old_variable.users();
+  for (MFInstruction *user : old_users) {
+    switch (user->type()) {
+      case MFInstructionType::Call: {
+        MFCallInstruction &call_instr = static_cast<MFCallInstruction &>(*user);
+        for (const int param_index : call_instr.params().index_range()) {
+          if (call_instr.params()[param_index] == &old_variable) {
+            call_instr.set_param_variable(param_index, &new_variable);
+          }
+        }
+        break;
+      }
+      case MFInstructionType::Branch: {
+        static_cast<MFBranchInstruction &>(*user).set_condition(&new_variable);
+        break;
+      }
+      case MFInstructionType::Destruct: {
+        destruct_instrs.append(static_cast<MFDestructInstruction *>(user));
+        break;
+      }
+      case MFInstructionType::Dummy:
+      case MFInstructionType::Return: {
+        break;
+      }
+    }
+  }
+
+  /* Variables provided by the caller are not destructed in the procedure. */
+  MFDestructInstruction *last_destruct_instr = nullptr;
+  if (!new_variable_is_param) {
+    int last_position = -1;
+    for (MFDestructInstruction *destruct_instr : destruct_instrs) {
+      const int position = position_by_instr.lookup(destruct_instr);
+      if (position > last_position) {
+        last_destruct_instr = destruct_instr;
+        last_position = position;
+      }
+    }
+  }
+  for (MFDestructInstruction *destruct_instr : destruct_instrs) {
+    if (destruct_instr == last_destruct_instr) {
+      destruct_instr->set_variable(&new_variable);
+    }
+    else {
+      r_deleted_instrs.add_new(destruct_instr);
+      remove_instruction_from_chain(procedure, *destruct_instr, destruct_instr->next());
+    }
+  }
+}
+
+void eliminate_common_subexpressions(MFProcedure &procedure, MFInstruction &block_end_instr)
+{
+  const Vector<MFInstruction *> instructions = find_block_instructions(block_end_instr);
+  Map<const MFInstruction *, int> position_by_instr;
+  for (const int position : instructions.index_range()) {
+    position_by_instr.add_new(instructions[position], position);
+  }
+  Set<const MFVariable *> param_variables;
+  for (const ConstMFParameter &param : procedure.params()) {
+    param_variables.add(param.variable);
+  }
+
+  /* Earlier calls whose outputs are still available. */
+  Vector<MFCallInstruction *> reusable_calls;
+  /* Instructions from the block that have been deleted already. The pointers must not be
+   * dereferenced anymore. */
+  Set<const MFInstruction *> deleted_instrs;
+
+  auto remove_reusable_calls_using = [&](MFVariable *variable) {
+    if (variable == nullptr) {
+      return;
+    }
+    for (int64_t i = reusable_calls.size() - 1; i >= 0; i--) {
+      if (reusable_calls[i]->params().contains(variable)) {
+        reusable_calls.remove_and_reorder(i);
+      }
+    }
+  };
+
+  for (const int position : instructions.index_range()) {
+    MFInstruction *instr = instructions[position];
+    if (deleted_instrs.contains(instr)) {
+      continue;
+    }
+    if (instr->type() == MFInstructionType::Destruct) {
+      remove_reusable_calls_using(static_cast<MFDestructInstruction *>(instr)->variable());
+      continue;
+    }
+    if (instr->type() != MFInstructionType::Call) {
+      continue;
+    }
+    MFCallInstruction &call_instr = static_cast<MFCallInstruction &>(*instr);
+    /* Calls that use variables that are changed here can't be reused anymore. */
+    for (const int param_index : call_instr.params().index_range()) {
+      if (is_mutable_or_output_param(call_instr, param_index)) {
+        remove_reusable_calls_using(call_instr.params()[param_index]);
+      }
+    }
+    if (!call_is_removable(call_instr, param_variables, position_by_instr)) {
+      continue;
+    }
+    MFCallInstruction *earlier_call = nullptr;
+    for (MFCallInstruction *reusable_call : reusable_calls) {
+      if (calls_are_equal(*reusable_call, call_instr, position, position_by_instr)) {
+        earlier_call = reusable_call;
+        break;
+      }
+    }
+    if (earlier_call == nullptr) {
+      reusable_calls.append(&call_instr);
+      continue;
+    }
+
+    /* Use the outputs of the earlier call and remove this call. */
+    for (const int param_index : call_instr.params().index_range()) {
+      MFVariable *old_variable = call_instr.params()[param_index];
+      if (old_variable == nullptr || !is_mutable_or_output_param(call_instr, param_index)) {
+        continue;
+      }
+      MFVariable *new_variable = earlier_call->params()[param_index];
+      call_instr.set_param_variable(param_index, nullptr);
+      replace_variable(procedure,
+                       *old_variable,
+                       *new_variable,
+                       param_variables.contains(new_variable),
+                       position_by_instr,
+                       deleted_instrs);
+    }
+    deleted_instrs.add_new(&call_instr);
+    remove_instruction_from_chain(procedure, call_instr, call_instr.next());
+  }
+}
+
 }  // namespace blender::fn::procedure_optimization
@@ -289,4 +289,109 @@ TEST(field, IgnoredOutput)
   EXPECT_EQ(results.get(3), 5);
 }
 
+struct ValueWithPadding {
+  int value;
+  int padding;
+};
+
+static int get_value(const ValueWithPadding &item)
+{
+  return item.value;
+}
+
+static void set_value(ValueWithPadding &item, int value)
+{
+  item.value = value;
+}
+
+TEST(field, LargeMaskInChunks)
+{
+  GField index_field{std::make_shared<IndexFieldInput>()};
+
+  std::unique_ptr<MultiFunction> add_fn = std::make_unique<CustomMF_SI_SI_SO<int, int, int>>(
+      "add", [](int a, int b) { return a + b; });
+  Field<int> output_field{std::make_shared<FieldOperation>(
+                              FieldOperation(std::move(add_fn), {index_field, index_field})),
+                          0};
+
+  /* Use enough indices, so that the evaluation is split up into multiple chunks. */
+  const int size = 100000;
+  Vector<int64_t> indices;
+  for (const int i : IndexRange(size)) {
+    if (i % 3 != 0) {
+      indices.append(i);
+    }
+  }
+  const IndexMask mask{indices};
+
+  Array<int> span_result(size, -1);
+  Array<ValueWithPadding> virtual_result(size, {-1, -1});
+  VArray<int> varray_result;
+
+  FieldContext context;
+  FieldEvaluator evaluator{context, &mask};
+  evaluator.add_with_destination(output_field, span_result.as_mutable_span());
+  evaluator.add_with_destination(
+      output_field,
+      VMutableArray<int>::ForDerivedSpan<ValueWithPadding, get_value, set_value>(
+          virtual_result.as_mutable_span()));
+  evaluator.add(output_field, &varray_result);
+  evaluator.evaluate();
+
+  for (const int i : IndexRange(size)) {
+    if (i % 3 == 0) {
+      EXPECT_EQ(span_result[i], -1);
+      EXPECT_EQ(virtual_result[i].value, -1);
+    }
+    else {
+      EXPECT_EQ(span_result[i], 2 * i);
+      EXPECT_EQ(virtual_result[i].value, 2 * i);
+      EXPECT_EQ(varray_result.get(i), 2 * i);
+    }
+    EXPECT_EQ(virtual_result[i].padding, -1);
+  }
+}
+
+TEST(field, DeduplicateOperations)
+{
+  GField index_field{std::make_shared<IndexFieldInput>()};
+
+  int add_calls = 0;
+  CustomMF_SI_SI_SO<int, int, int> add_fn{"add", [&](int a, int b) {
+                                            add_calls++;
+                                            return a + b;
+                                          }};
+  CustomMF_SI_SI_SO<int, int, int> mul_fn{"mul", [](int a, int b) { return a * b; }};
+
+  const int constant_value = 2;
+  GField constant_field{std::make_shared<FieldConstant>(CPPType::get<int>(), &constant_value)};
+  /* This operation does not depend on any input, so it is folded into a constant. */
+  GField constant_operation_field{
+      std::make_shared<FieldOperation>(mul_fn, Vector<GField>{constant_field, constant_field}),
+      0};
+  /* Two separate but equal operations that should only be computed once. */
+  GField add_field_1{
+      std::make_shared<FieldOperation>(add_fn,
+                                       Vector<GField>{index_field, constant_operation_field}),
+      0};
+  GField add_field_2{
+      std::make_shared<FieldOperation>(add_fn,
+                                       Vector<GField>{index_field, constant_operation_field}),
+      0};
+  GField output_field{
+      std::make_shared<FieldOperation>(mul_fn, Vector<GField>{add_field_1, add_field_2}), 0};
+
+  Array<int> result(10);
+
+  FieldContext context;
+  FieldEvaluator evaluator{context, 10};
+  evaluator.add_with_destination(output_field, result.as_mutable_span());
+  evaluator.evaluate();
+
+  EXPECT_EQ(add_calls, 10);
+  for (const int i : IndexRange(10)) {
+    EXPECT_EQ(result[i], (i + 4) * (i + 4));
+  }
+}
+
 }  // namespace blender::fn::tests
@@ -5,6 +5,7 @@
 #include "FN_multi_function_builder.hh"
 #include "FN_multi_function_procedure_builder.hh"
 #include "FN_multi_function_procedure_executor.hh"
+#include "FN_multi_function_procedure_optimization.hh"
 #include "FN_multi_function_test_common.hh"
 
 namespace blender::fn::tests {
@@ -378,4 +379,123 @@ TEST(multi_function_procedure, BufferReuse)
   EXPECT_EQ(results[4], 53);
 }
 
+TEST(multi_function_procedure, StraightLineSegments)
+{
+  /**
+   * procedure(int a, int &b, int *out) {
+   *   int c = a * 2;
+   *   b += 10;
+   *   out = b + c;
+   * }
+   */
+
+  CustomMF_SI_SO<int, int> double_fn{"double", [](int a) { return a * 2; }};
+  CustomMF_SM<int> add_10_fn{"add_10", [](int &a) { a += 10; }};
+  CustomMF_SI_SI_SO<int, int, int> add_fn{"add", [](int a, int b) { return a + b; }};
+
+  MFProcedure procedure;
+  MFProcedureBuilder builder{procedure};
+
+  MFVariable *var_a = &builder.add_single_input_parameter<int>();
+  MFVariable *var_b = &builder.add_single_mutable_parameter<int>();
+  auto [var_c] = builder.add_call<1>(double_fn, {var_a});
+  builder.add_destruct(*var_a);
+  builder.add_call(add_10_fn, {var_b});
+  auto [var_out] = builder.add_call<1>(add_fn, {var_b, var_c});
+  builder.add_destruct(*var_c);
+  builder.add_return();
+  builder.add_output_parameter(*var_out);
+
+  EXPECT_TRUE(procedure.validate());
+
+  MFProcedureExecutor procedure_fn{procedure};
+
+  /* Use enough indices so that the procedure is executed in multiple segments. */
+  const int64_t size = 100000;
+  Array<int> inputs(size);
+  Array<int> mutables(size);
+  for (const int64_t i : IndexRange(size)) {
+    inputs[i] = i;
+    mutables[i] = -i;
+  }
+  Array<int> results(size, -1);
+
+  MFParamsBuilder params{procedure_fn, size};
+  params.add_readonly_single_input(inputs.as_span());
+  params.add_single_mutable(mutables.as_mutable_span());
+  params.add_uninitialized_single_output(results.as_mutable_span());
+
+  MFContextBuilder context;
+  procedure_fn.call(IndexRange(5, size - 10), params, context);
+
+  for (const int64_t i : IndexRange(size)) {
+    if (i < 5 || i >= size - 5) {
+      EXPECT_EQ(mutables[i], -i);
+      EXPECT_EQ(results[i], -1);
+    }
+    else {
+      EXPECT_EQ(mutables[i], 10 - i);
+      EXPECT_EQ(results[i], i + 10);
+    }
+  }
+}
+
+TEST(multi_function_procedure, EliminateCommonSubexpressions)
+{
+  /**
+   * procedure(int a, int *out) {
+   *   int b = a + 10;
+   *   int c = a + 10;
+   *   int d = b * c;
+   *   int e = b * c;
+   *   out = d + e;
+   * }
+   */
+
+  int add_calls = 0;
+  CustomMF_SI_SO<int, int> add_10_fn{"add 10", [&](int a) {
+                                       add_calls++;
+                                       return a + 10;
+                                     }};
+  CustomMF_SI_SI_SO<int, int, int> mul_fn{"mul", [](int a, int b) { return a * b; }};
+  CustomMF_SI_SI_SO<int, int, int> add_fn{"add", [](int a, int b) { return a + b; }};
+
+  MFProcedure procedure;
+  MFProcedureBuilder builder{procedure};
+
+  MFVariable *var_a = &builder.add_single_input_parameter<int>();
+  auto [var_b] = builder.add_call<1>(add_10_fn, {var_a});
+  auto [var_c] = builder.add_call<1>(add_10_fn, {var_a});
+  auto [var_d] = builder.add_call<1>(mul_fn, {var_b, var_c});
+  auto [var_e] = builder.add_call<1>(mul_fn, {var_b, var_c});
+  auto [var_out] = builder.add_call<1>(add_fn, {var_d, var_e});
+  builder.add_destruct({var_a, var_b, var_c, var_d, var_e});
+  MFReturnInstruction &return_instr = builder.add_return();
+  builder.add_output_parameter(*var_out);
+
+  procedure_optimization::eliminate_common_subexpressions(procedure, return_instr);
+  procedure_optimization::move_destructs_up(procedure, return_instr);
+
+  EXPECT_TRUE(procedure.validate());
+  EXPECT_TRUE(var_c->users().is_empty());
+  EXPECT_TRUE(var_e->users().is_empty());
+
+  MFProcedureExecutor procedure_fn{procedure};
+
+  Array<int> inputs = {1, 2, 3};
+  Array<int> results(3, -1);
+
+  MFParamsBuilder params{procedure_fn, 3};
+  params.add_readonly_single_input(inputs.as_span());
+  params.add_uninitialized_single_output(results.as_mutable_span());
+
+  MFContextBuilder context;
+  procedure_fn.call(IndexRange(3), params, context);
+
+  EXPECT_EQ(add_calls, 3);
+  EXPECT_EQ(results[0], 242);
+  EXPECT_EQ(results[1], 288);
+  EXPECT_EQ(results[2], 338);
+}
+
 }  // namespace blender::fn::tests
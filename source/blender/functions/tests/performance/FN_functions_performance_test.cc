@@ -0,0 +1,129 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <string>
+
+#include "BLI_array.hh"
+#include "BLI_vector.hh"
+
+#include "FN_generic_virtual_array.hh"
+#include "FN_multi_function_builder.hh"
+#include "FN_multi_function_procedure_builder.hh"
+#include "FN_multi_function_procedure_executor.hh"
+
+#include "PIL_time.h"
+
+namespace blender::fn::tests {
+
+/**
+ * Print the average time of a call after a warm-up call. The time in microseconds is also stored
+ * as test property, so that it is part of the `--gtest_output=json:<file>` report.
+ */
+template<typename Fn> static void run_benchmark(const char *name, const int runs, const Fn &fn)
+{
+  fn();
+
+  const double start_time = PIL_check_seconds_timer();
+  for (int i = 0; i < runs; i++) {
+    fn();
+  }
+  const double average_time = (PIL_check_seconds_timer() - start_time) / runs;
+
+  printf("%s: %.3f ms\n", name, average_time * 1000.0);
+  ::testing::Test::RecordProperty(name, std::to_string(average_time * 1000000.0));
+}
+
+static Vector<int64_t> every_other_index(const int64_t size)
+{
+  Vector<int64_t> indices;
+  for (int64_t i = 0; i < size; i += 2) {
+    indices.append(i);
+  }
+  return indices;
+}
+
+TEST(functions_performance, GVArrayMaterialize)
+{
+  const int64_t size = 10000000;
+  const CPPType &type = CPPType::get<float>();
+  const Array<float> data(size, 2.0f);
+  const float single_value = 2.0f;
+  const Vector<int64_t> sparse_indices = every_other_index(size);
+  Array<float> dst(size);
+
+  const GVArray varray_span = GVArray::ForSpan(data.as_span());
+  const GVArray varray_single = GVArray::ForSingle(type, size, &single_value);
+
+  run_benchmark("gvarray_span_materialize", 10, [&]() {
+    varray_span.materialize(IndexMask(size), dst.data());
+  });
+  run_benchmark("gvarray_span_materialize_sparse", 10, [&]() {
+    varray_span.materialize(IndexMask(sparse_indices), dst.data());
+  });
+  run_benchmark("gvarray_single_materialize", 10, [&]() {
+    varray_single.materialize(IndexMask(size), dst.data());
+  });
+  run_benchmark("gvarray_typed_span_materialize", 10, [&]() {
+    varray_span.typed<float>().materialize(dst);
+  });
+  EXPECT_EQ(dst[1], 2.0f);
+}
+
+TEST(functions_performance, MFProcedureExecutor)
+{
+  /**
+   * procedure(float var1, float var2, float var3, float *var5) {
+   *   var4 = var1 * var2;
+   *   var5 = var4 + var3;
+   * }
+   */
+
+  CustomMF_SI_SI_SO<float, float, float> mul_fn{"mul", [](float a, float b) { return a * b; }};
+  CustomMF_SI_SI_SO<float, float, float> add_fn{"add", [](float a, float b) { return a + b; }};
+
+  MFProcedure procedure;
+  MFProcedureBuilder builder{procedure};
+
+  MFVariable *var1 = &builder.add_single_input_parameter<float>();
+  MFVariable *var2 = &builder.add_single_input_parameter<float>();
+  MFVariable *var3 = &builder.add_single_input_parameter<float>();
+  auto [var4] = builder.add_call<1>(mul_fn, {var1, var2});
+  auto [var5] = builder.add_call<1>(add_fn, {var4, var3});
+  builder.add_destruct({var1, var2, var3, var4});
+  builder.add_return();
+  builder.add_output_parameter(*var5);
+
+  EXPECT_TRUE(procedure.validate());
+
+  MFProcedureExecutor executor{procedure};
+
+  /* The same computation as a single function, to see the overhead of the executor. */
+  CustomMF_SI_SI_SI_SO<float, float, float, float> fused_fn{
+      "mul_add", [](float a, float b, float c) { return a * b + c; }};
+
+  const int64_t size = 1000000;
+  const Array<float> input1(size, 2.0f);
+  const Array<float> input2(size, 3.0f);
+  const Vector<int64_t> sparse_indices = every_other_index(size);
+  Array<float> output(size);
+
+  auto call_fn = [&](const MultiFunction &fn, const IndexMask mask) {
+    MFParamsBuilder params{fn, size};
+    MFContextBuilder context;
+    params.add_readonly_single_input(input1.as_span());
+    params.add_readonly_single_input(input2.as_span());
+    params.add_readonly_single_input_value(1.0f);
+    params.add_uninitialized_single_output(output.as_mutable_span());
+    fn.call(mask, params, context);
+  };
+
+  run_benchmark("procedure_executor", 10, [&]() { call_fn(executor, IndexMask(size)); });
+  run_benchmark("procedure_executor_sparse", 10, [&]() {
+    call_fn(executor, IndexMask(sparse_indices));
+  });
+  run_benchmark("procedure_fused_function", 10, [&]() { call_fn(fused_fn, IndexMask(size)); });
+  EXPECT_EQ(output[0], 7.0f);
+}
+
+}  // namespace blender::fn::tests
@@ -1,5 +1,7 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <algorithm>
+
 #include "GEO_realize_instances.hh"
 
 #include "DNA_collection_types.h"
@@ -65,6 +67,7 @@ struct AttributeFallbacksArray {
    */
   Array<const void *> array;
 
+  AttributeFallbacksArray() = default;
   AttributeFallbacksArray(int size) : array(size, nullptr)
   {
   }
@@ -394,20 +397,41 @@ static Vector<std::pair<int, GSpan>> prepare_attribute_fallbacks(
 }
 
 /**
- * Calls #fn for every geometry in the given #InstanceReference. Also passes on the transformation
- * that is applied to every instance.
+ * A geometry that is added for every instance of an #InstanceReference.
+ */
+struct ReferenceGeometry {
+  GeometrySet geometry_set;
+  /** Transform relative to the instance. */
+  float4x4 transform;
+  /** Index of the object in an instanced collection, mixed into the id. -1 for other types. */
+  int collection_index;
+};
+
+/**
+ * Information about an #InstanceReference that is computed once, instead of for every instance
+ * that uses it.
  */
-static void foreach_geometry_in_reference(
-    const InstanceReference &reference,
-    const float4x4 &base_transform,
-    const uint32_t id,
-    FunctionRef<void(const GeometrySet &geometry_set, const float4x4 &transform, uint32_t id)> fn)
+struct ReferenceGatherInfo {
+  Vector<ReferenceGeometry> geometries;
+  /**
+   * True when the referenced geometry contains no nested instances and no volumes. Then the
+   * number of tasks and elements added for every instance is known in advance.
+   */
+  bool is_flat = true;
+  int pointcloud_tasks_num = 0;
+  int mesh_tasks_num = 0;
+  int curve_tasks_num = 0;
+  GatherOffsets sizes;
+};
+
+static Vector<ReferenceGeometry> gather_reference_geometries(const InstanceReference &reference)
 {
+  Vector<ReferenceGeometry> geometries;
   switch (reference.type()) {
     case InstanceReference::Type::Object: {
       const Object &object = reference.object();
-      const GeometrySet object_geometry_set = object_get_evaluated_geometry_set(object);
-      fn(object_geometry_set, base_transform, id);
+      geometries.append(
+          {object_get_evaluated_geometry_set(object), float4x4::identity(), -1});
       break;
     }
     case InstanceReference::Type::Collection: {
@@ -416,24 +440,93 @@ static void foreach_geometry_in_reference(
       sub_v3_v3(offset_matrix.values[3], collection.instance_offset);
       int index = 0;
       FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (&collection, object) {
-        const GeometrySet object_geometry_set = object_get_evaluated_geometry_set(*object);
-        const float4x4 matrix = base_transform * offset_matrix * object->obmat;
-        const int sub_id = noise::hash(id, index);
-        fn(object_geometry_set, matrix, sub_id);
+        geometries.append({object_get_evaluated_geometry_set(*object),
+                           offset_matrix * float4x4(object->obmat),
+                           index});
         index++;
       }
       FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
       break;
     }
     case InstanceReference::Type::GeometrySet: {
-      const GeometrySet &instance_geometry_set = reference.geometry_set();
-      fn(instance_geometry_set, base_transform, id);
+      geometries.append({reference.geometry_set(), float4x4::identity(), -1});
       break;
     }
     case InstanceReference::Type::None: {
       break;
     }
   }
+  return geometries;
+}
+
+/**
+ * Count the tasks and elements that #gather_realize_tasks_recursive adds for the referenced
+ * geometry, if it is flat.
+ */
+static ReferenceGatherInfo preprocess_reference(const InstanceReference &reference)
+{
+  ReferenceGatherInfo info;
+  info.geometries = gather_reference_geometries(reference);
+  for (const ReferenceGeometry &geometry : info.geometries) {
+    for (const GeometryComponent *component : geometry.geometry_set.get_components_for_read()) {
+      switch (component->type()) {
+        case GEO_COMPONENT_TYPE_MESH: {
+          const Mesh *mesh = static_cast<const MeshComponent *>(component)->get_for_read();
+          if (mesh != nullptr && mesh->totvert > 0) {
+            info.mesh_tasks_num++;
+            info.sizes.mesh_offsets.vertex += mesh->totvert;
+            info.sizes.mesh_offsets.edge += mesh->totedge;
+            info.sizes.mesh_offsets.loop += mesh->totloop;
+            info.sizes.mesh_offsets.poly += mesh->totpoly;
+          }
+          break;
+        }
+        case GEO_COMPONENT_TYPE_POINT_CLOUD: {
+          const PointCloud *pointcloud =
+              static_cast<const PointCloudComponent *>(component)->get_for_read();
+          if (pointcloud != nullptr && pointcloud->totpoint > 0) {
+            info.pointcloud_tasks_num++;
+            info.sizes.pointcloud_offset += pointcloud->totpoint;
+          }
+          break;
+        }
+        case GEO_COMPONENT_TYPE_CURVE: {
+          const Curves *curves = static_cast<const CurveComponent *>(component)->get_for_read();
+          if (curves != nullptr && curves->geometry.curve_size > 0) {
+            info.curve_tasks_num++;
+            info.sizes.curves_offsets.point += curves->geometry.point_size;
+            info.sizes.curves_offsets.curve += curves->geometry.curve_size;
+          }
+          break;
+        }
+        case GEO_COMPONENT_TYPE_INSTANCES:
+        case GEO_COMPONENT_TYPE_VOLUME: {
+          info.is_flat = false;
+          break;
+        }
+      }
+    }
+  }
+  return info;
+}
+
+static void add_gather_offsets(GatherOffsets &a, const GatherOffsets &b)
+{
+  a.pointcloud_offset += b.pointcloud_offset;
+  a.mesh_offsets.vertex += b.mesh_offsets.vertex;
+  a.mesh_offsets.edge += b.mesh_offsets.edge;
+  a.mesh_offsets.loop += b.mesh_offsets.loop;
+  a.mesh_offsets.poly += b.mesh_offsets.poly;
+  a.curves_offsets.point += b.curves_offsets.point;
+  a.curves_offsets.curve += b.curves_offsets.curve;
+}
+
+/** Move the tasks gathered for a range of instances to their final position. */
+template<typename T>
+static void move_gathered_tasks(Vector<T> &src, MutableSpan<T> dst, const int start)
+{
+  BLI_assert(start + src.size() <= dst.size());
+  std::move(src.begin(), src.end(), dst.begin() + start);
 }
 
 static void gather_realize_tasks_for_instances(GatherTasksInfo &gather_info,
@@ -454,19 +547,26 @@ static void gather_realize_tasks_for_instances(GatherTasksInfo &gather_info,
   }
 
   /* Prepare attribute fallbacks. */
-  InstanceContext instance_context = base_instance_context;
-  Vector<std::pair<int, GSpan>> pointcloud_attributes_to_override = prepare_attribute_fallbacks(
-      gather_info, instances_component, gather_info.pointclouds.attributes);
-  Vector<std::pair<int, GSpan>> mesh_attributes_to_override = prepare_attribute_fallbacks(
+  const Vector<std::pair<int, GSpan>> pointcloud_attributes_to_override =
+      prepare_attribute_fallbacks(
+          gather_info, instances_component, gather_info.pointclouds.attributes);
+  const Vector<std::pair<int, GSpan>> mesh_attributes_to_override = prepare_attribute_fallbacks(
       gather_info, instances_component, gather_info.meshes.attributes);
-  Vector<std::pair<int, GSpan>> curve_attributes_to_override = prepare_attribute_fallbacks(
+  const Vector<std::pair<int, GSpan>> curve_attributes_to_override = prepare_attribute_fallbacks(
       gather_info, instances_component, gather_info.curves.attributes);
 
-  for (const int i : transforms.index_range()) {
-    const int handle = handles[i];
-    const float4x4 &transform = transforms[i];
-    const InstanceReference &reference = references[handle];
-    const float4x4 new_base_transform = base_transform * transform;
+  /* Evaluated geometry of referenced objects and collections is only retrieved once, instead of
+   * for every instance. */
+  Array<ReferenceGatherInfo> reference_infos(references.size());
+  for (const int i : references.index_range()) {
+    reference_infos[i] = preprocess_reference(references[i]);
+  }
+
+  auto gather_instance = [&](GatherTasksInfo &info,
+                             InstanceContext &instance_context,
+                             const int i) {
+    const ReferenceGatherInfo &reference_info = reference_infos[handles[i]];
+    const float4x4 new_base_transform = base_transform * transforms[i];
 
     /* Update attribute fallbacks for the current instance. */
     for (const std::pair<int, GSpan> &pair : pointcloud_attributes_to_override) {
@@ -491,19 +591,78 @@ static void gather_realize_tasks_for_instances(GatherTasksInfo &gather_info,
     const uint32_t instance_id = noise::hash(base_instance_context.id, local_instance_id);
 
     /* Add realize tasks for all referenced geometry sets recursively. */
-    foreach_geometry_in_reference(reference,
-                                  new_base_transform,
-                                  instance_id,
-                                  [&](const GeometrySet &instance_geometry_set,
-                                      const float4x4 &transform,
-                                      const uint32_t id) {
-                                    instance_context.id = id;
-                                    gather_realize_tasks_recursive(gather_info,
-                                                                   instance_geometry_set,
-                                                                   transform,
-                                                                   instance_context);
-                                  });
+    for (const ReferenceGeometry &geometry : reference_info.geometries) {
+      instance_context.id = geometry.collection_index == -1 ?
+                                instance_id :
+                                noise::hash(instance_id, geometry.collection_index);
+      gather_realize_tasks_recursive(info,
+                                     geometry.geometry_set,
+                                     new_base_transform * geometry.transform,
+                                     instance_context);
+    }
+  };
+
+  const bool all_references_flat = std::all_of(
+      reference_infos.begin(), reference_infos.end(), [](const ReferenceGatherInfo &info) {
+        return info.is_flat;
+      });
+  if (!all_references_flat) {
+    InstanceContext instance_context = base_instance_context;
+    for (const int i : transforms.index_range()) {
+      gather_instance(gather_info, instance_context, i);
+    }
+    return;
   }
+
+  /* When the number of tasks and elements of every instance is known, compute where the tasks
+   * of every instance start first, so that they can be created in parallel. */
+  const int instances_num = transforms.size();
+  Array<GatherOffsets> instance_offsets(instances_num);
+  Array<int> pointcloud_task_starts(instances_num);
+  Array<int> mesh_task_starts(instances_num);
+  Array<int> curve_task_starts(instances_num);
+  GatherTasks &tasks = gather_info.r_tasks;
+  GatherOffsets offsets = gather_info.r_offsets;
+  int pointcloud_tasks_num = tasks.pointcloud_tasks.size();
+  int mesh_tasks_num = tasks.mesh_tasks.size();
+  int curve_tasks_num = tasks.curve_tasks.size();
+  for (const int i : IndexRange(instances_num)) {
+    const ReferenceGatherInfo &reference_info = reference_infos[handles[i]];
+    instance_offsets[i] = offsets;
+    pointcloud_task_starts[i] = pointcloud_tasks_num;
+    mesh_task_starts[i] = mesh_tasks_num;
+    curve_task_starts[i] = curve_tasks_num;
+    add_gather_offsets(offsets, reference_info.sizes);
+    pointcloud_tasks_num += reference_info.pointcloud_tasks_num;
+    mesh_tasks_num += reference_info.mesh_tasks_num;
+    curve_tasks_num += reference_info.curve_tasks_num;
+  }
+  tasks.pointcloud_tasks.resize(pointcloud_tasks_num);
+  tasks.mesh_tasks.resize(mesh_tasks_num);
+  tasks.curve_tasks.resize(curve_tasks_num);
+
+  threading::parallel_for(IndexRange(instances_num), 1024, [&](const IndexRange range) {
+    const int first = range.first();
+    GatherTasksInfo local_info = {gather_info.pointclouds,
+                                  gather_info.meshes,
+                                  gather_info.curves,
+                                  gather_info.create_id_attribute_on_any_component,
+                                  gather_info.r_temporary_arrays};
+    local_info.r_offsets = instance_offsets[first];
+    InstanceContext instance_context = base_instance_context;
+    for (const int i : range) {
+      gather_instance(local_info, instance_context, i);
+    }
+    move_gathered_tasks(local_info.r_tasks.pointcloud_tasks,
+                        tasks.pointcloud_tasks.as_mutable_span(),
+                        pointcloud_task_starts[first]);
+    move_gathered_tasks(
+        local_info.r_tasks.mesh_tasks, tasks.mesh_tasks.as_mutable_span(), mesh_task_starts[first]);
+    move_gathered_tasks(local_info.r_tasks.curve_tasks,
+                        tasks.curve_tasks.as_mutable_span(),
+                        curve_task_starts[first]);
+  });
+  gather_info.r_offsets = offsets;
 }
 
 /**
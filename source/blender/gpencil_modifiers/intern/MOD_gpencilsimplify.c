@@ -162,7 +162,8 @@ GpencilModifierTypeInfo modifierType_Gpencil_Simplify = {
     /* structName */ "SimplifyGpencilModifierData",
     /* structSize */ sizeof(SimplifyGpencilModifierData),
     /* type */ eGpencilModifierTypeType_Gpencil,
-    /* flags */ eGpencilModifierTypeFlag_SupportsEditmode,
+    /* flags */ eGpencilModifierTypeFlag_SupportsEditmode |
+        eGpencilModifierTypeFlag_SerialStrokes,
 
     /* copyData */ copyData,
 
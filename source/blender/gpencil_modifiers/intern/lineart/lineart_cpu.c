@@ -1713,19 +1713,79 @@ static int lineart_edge_type_duplication_count(char eflag)
   }
   return count;
 }
+typedef struct LineartObjectLoadData {
+  LineartRenderBuffer *rb;
+  LineartObjectInfo *obi;
+  BMesh *bm;
+  LineartVert *orv;
+  LineartTriangle *ort;
+  LineartTriangleAdjacent *orta;
+} LineartObjectLoadData;
+
+static void lineart_object_load_vert_fn(void *__restrict userdata,
+                                        const int i,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  LineartObjectLoadData *data = (LineartObjectLoadData *)userdata;
+  LineartObjectInfo *obi = data->obi;
+  BMVert *v = BM_vert_at_index(data->bm, i);
+  lineart_vert_transform(v, i, data->orv, obi->model_view, obi->model_view_proj);
+  data->orv[i].index = i;
+}
+
+static void lineart_object_load_triangle_fn(void *__restrict userdata,
+                                            const int i,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  LineartObjectLoadData *data = (LineartObjectLoadData *)userdata;
+  LineartObjectInfo *obi = data->obi;
+  LineartVert *orv = data->orv;
+  const int usage = obi->usage;
+  BMFace *f = BM_face_at_index(data->bm, i);
+  LineartTriangle *tri = lineart_triangle_from_index(data->rb, data->ort, i);
+
+  BMLoop *loop = f->l_first;
+  tri->v[0] = &orv[BM_elem_index_get(loop->v)];
+  loop = loop->next;
+  tri->v[1] = &orv[BM_elem_index_get(loop->v)];
+  loop = loop->next;
+  tri->v[2] = &orv[BM_elem_index_get(loop->v)];
+
+  /* Material mask bits and occlusion effectiveness assignment. */
+  Material *mat = BKE_object_material_get(obi->original_ob, f->mat_nr + 1);
+  tri->material_mask_bits |= ((mat && (mat->lineart.flags & LRT_MATERIAL_MASK_ENABLED)) ?
+                                  mat->lineart.material_mask_bits :
+                                  0);
+  tri->mat_occlusion |= (mat ? mat->lineart.mat_occlusion : 1);
+  tri->flags |= (mat && (mat->blend_flag & MA_BL_CULL_BACKFACE)) ?
+                    LRT_TRIANGLE_MAT_BACK_FACE_CULLING :
+                    0;
+
+  tri->intersection_mask = obi->override_intersection_mask;
+
+  double gn[3];
+  copy_v3db_v3fl(gn, f->no);
+  mul_v3_mat3_m4v3_db(tri->gn, obi->normal, gn);
+  normalize_v3_db(tri->gn);
+
+  if (usage == OBJECT_LRT_INTERSECTION_ONLY) {
+    tri->flags |= LRT_TRIANGLE_INTERSECTION_ONLY;
+  }
+  else if (ELEM(usage, OBJECT_LRT_NO_INTERSECTION, OBJECT_LRT_OCCLUSION_ONLY)) {
+    tri->flags |= LRT_TRIANGLE_NO_INTERSECTION;
+  }
+
+  /* Re-use this field to refer to adjacent info, will be cleared after culling stage. */
+  tri->intersecting_verts = (void *)&data->orta[i];
+}
+
 static void lineart_geometry_object_load(LineartObjectInfo *obi, LineartRenderBuffer *rb)
 {
   BMesh *bm;
-  BMVert *v;
-  BMFace *f;
   BMEdge *e;
-  BMLoop *loop;
   LineartEdge *la_e;
   LineartEdgeSegment *la_s;
-  LineartTriangle *tri;
   LineartTriangleAdjacent *orta;
-  double(*model_view_proj)[4] = obi->model_view_proj, (*model_view)[4] = obi->model_view,
-  (*normal)[4] = obi->normal;
   LineartElementLinkNode *eln;
   LineartVert *orv;
   LineartEdge *o_la_e;
@@ -1846,57 +1906,27 @@ static void lineart_geometry_object_load(LineartObjectInfo *obi, LineartRenderBu
       &rb->triangle_adjacent_pointers, &rb->render_data_pool, orta);
   BLI_spin_unlock(&rb->lock_task);
 
-  for (i = 0; i < bm->totvert; i++) {
-    v = BM_vert_at_index(bm, i);
-    lineart_vert_transform(v, i, orv, model_view, model_view_proj);
-    orv[i].index = i;
-  }
+  /* A single dense object often takes most of the loading time, so also split the work on its
+   * vertices and triangles between threads. Each element only writes to its own slot. */
+  LineartObjectLoadData load_data = {
+      .rb = rb,
+      .obi = obi,
+      .bm = bm,
+      .orv = orv,
+      .ort = ort,
+      .orta = orta,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 4096;
+  BLI_task_parallel_range(0, bm->totvert, &load_data, lineart_object_load_vert_fn, &settings);
   /* Register a global index increment. See #lineart_triangle_share_edge() and
    * #lineart_main_load_geometries() for detailed. It's okay that global_vindex might eventually
    * overflow, in such large scene it's virtually impossible for two vertex of the same numeric
    * index to come close together. */
   obi->global_i_offset = bm->totvert;
 
-  tri = ort;
-  for (i = 0; i < bm->totface; i++) {
-    f = BM_face_at_index(bm, i);
-
-    loop = f->l_first;
-    tri->v[0] = &orv[BM_elem_index_get(loop->v)];
-    loop = loop->next;
-    tri->v[1] = &orv[BM_elem_index_get(loop->v)];
-    loop = loop->next;
-    tri->v[2] = &orv[BM_elem_index_get(loop->v)];
-
-    /* Material mask bits and occlusion effectiveness assignment. */
-    Material *mat = BKE_object_material_get(orig_ob, f->mat_nr + 1);
-    tri->material_mask_bits |= ((mat && (mat->lineart.flags & LRT_MATERIAL_MASK_ENABLED)) ?
-                                    mat->lineart.material_mask_bits :
-                                    0);
-    tri->mat_occlusion |= (mat ? mat->lineart.mat_occlusion : 1);
-    tri->flags |= (mat && (mat->blend_flag & MA_BL_CULL_BACKFACE)) ?
-                      LRT_TRIANGLE_MAT_BACK_FACE_CULLING :
-                      0;
-
-    tri->intersection_mask = obi->override_intersection_mask;
-
-    double gn[3];
-    copy_v3db_v3fl(gn, f->no);
-    mul_v3_mat3_m4v3_db(tri->gn, normal, gn);
-    normalize_v3_db(tri->gn);
-
-    if (usage == OBJECT_LRT_INTERSECTION_ONLY) {
-      tri->flags |= LRT_TRIANGLE_INTERSECTION_ONLY;
-    }
-    else if (ELEM(usage, OBJECT_LRT_NO_INTERSECTION, OBJECT_LRT_OCCLUSION_ONLY)) {
-      tri->flags |= LRT_TRIANGLE_NO_INTERSECTION;
-    }
-
-    /* Re-use this field to refer to adjacent info, will be cleared after culling stage. */
-    tri->intersecting_verts = (void *)&orta[i];
-
-    tri = (LineartTriangle *)(((uchar *)tri) + rb->triangle_size);
-  }
+  BLI_task_parallel_range(0, bm->totface, &load_data, lineart_object_load_triangle_fn, &settings);
 
   /* Use BM_ELEM_TAG in f->head.hflag to store needed faces in the first iteration. */
 
@@ -43,6 +43,9 @@ typedef struct GPUFrameBuffer GPUFrameBuffer;
 
 typedef struct GPUOffScreen GPUOffScreen;
 
+/** Opaque type hiding blender::gpu::DepthReadBack. */
+typedef struct GPUDepthReadBack GPUDepthReadBack;
+
 GPUFrameBuffer *GPU_framebuffer_create(const char *name);
 void GPU_framebuffer_free(GPUFrameBuffer *fb);
 void GPU_framebuffer_bind(GPUFrameBuffer *fb);
@@ -205,6 +208,25 @@ void GPU_framebuffer_read_color(GPUFrameBuffer *fb,
                                 eGPUDataFormat format,
                                 void *data);
 
+/**
+ * Asynchronous read of the depth of a frame-buffer. Unlike #GPU_framebuffer_read_depth, this
+ * doesn't wait for the GPU to finish drawing. The data is fetched in a later redraw with
+ * #GPU_depth_readback_result, once the GPU is done with it.
+ */
+GPUDepthReadBack *GPU_depth_readback_create(void);
+void GPU_depth_readback_free(GPUDepthReadBack *readback);
+/**
+ * Start reading the depth of the `w` by `h` pixels at the origin of `fb` as floats.
+ * A read which is still in flight is discarded.
+ */
+void GPU_depth_readback_start(GPUDepthReadBack *readback, GPUFrameBuffer *fb, int w, int h);
+/**
+ * Copy the depth of the last started read to `r_data`, which must fit the size it was started
+ * with. Returns false without waiting when there is no read or the GPU isn't done with it yet.
+ * Each read can only be fetched once.
+ */
+bool GPU_depth_readback_result(GPUDepthReadBack *readback, float *r_data);
+
 /**
  * Read_slot and write_slot are only used for color buffers.
  */
@@ -15,6 +15,7 @@ namespace gpu {
 class Context;
 
 class Batch;
+class DepthReadBack;
 class DrawList;
 class FrameBuffer;
 class IndexBuf;
@@ -36,6 +37,7 @@ class GPUBackend {
   virtual Context *context_alloc(void *ghost_window) = 0;
 
   virtual Batch *batch_alloc() = 0;
+  virtual DepthReadBack *depth_readback_alloc() = 0;
   virtual DrawList *drawlist_alloc(int list_length) = 0;
   virtual FrameBuffer *framebuffer_alloc(const char *name) = 0;
   virtual IndexBuf *indexbuf_alloc() = 0;
@@ -377,6 +377,26 @@ void GPU_framebuffer_read_color(GPUFrameBuffer *gpu_fb,
   unwrap(gpu_fb)->read(GPU_COLOR_BIT, format, rect, channels, slot, data);
 }
 
+GPUDepthReadBack *GPU_depth_readback_create()
+{
+  return wrap(GPUBackend::get()->depth_readback_alloc());
+}
+
+void GPU_depth_readback_free(GPUDepthReadBack *readback)
+{
+  delete unwrap(readback);
+}
+
+void GPU_depth_readback_start(GPUDepthReadBack *readback, GPUFrameBuffer *gpu_fb, int w, int h)
+{
+  unwrap(readback)->start(unwrap(gpu_fb), w, h);
+}
+
+bool GPU_depth_readback_result(GPUDepthReadBack *readback, float *r_data)
+{
+  return unwrap(readback)->result(r_data);
+}
+
 /* TODO(fclem): rename to read_color. */
 void GPU_frontbuffer_read_pixels(
     int x, int y, int w, int h, int channels, eGPUDataFormat format, void *data)
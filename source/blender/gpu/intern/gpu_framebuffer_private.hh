@@ -204,7 +204,27 @@ class FrameBuffer {
   };
 };
 
+/**
+ * Asynchronous read-back of the depth plane of a frame-buffer.
+ */
+class DepthReadBack {
+ public:
+  virtual ~DepthReadBack() = default;
+
+  virtual void start(FrameBuffer *fb, int width, int height) = 0;
+  /** Non blocking, returns false if the data isn't available yet. */
+  virtual bool result(float *r_data) = 0;
+};
+
 /* Syntactic sugar. */
+static inline GPUDepthReadBack *wrap(DepthReadBack *readback)
+{
+  return reinterpret_cast<GPUDepthReadBack *>(readback);
+}
+static inline DepthReadBack *unwrap(GPUDepthReadBack *readback)
+{
+  return reinterpret_cast<DepthReadBack *>(readback);
+}
 static inline GPUFrameBuffer *wrap(FrameBuffer *vert)
 {
   return reinterpret_cast<GPUFrameBuffer *>(vert);
@@ -236,6 +236,8 @@ static void detect_workarounds()
     GLContext::native_barycentric_support = false;
     GLContext::multi_bind_support = false;
     GLContext::multi_draw_indirect_support = false;
+    GLContext::parallel_shader_compile_support = false;
+    GLContext::program_binary_support = false;
     GLContext::shader_draw_parameters_support = false;
     GLContext::texture_cube_map_array_support = false;
     GLContext::texture_filter_anisotropic_support = false;
@@ -441,6 +443,8 @@ bool GLContext::layered_rendering_support = false;
 bool GLContext::native_barycentric_support = false;
 bool GLContext::multi_bind_support = false;
 bool GLContext::multi_draw_indirect_support = false;
+bool GLContext::parallel_shader_compile_support = false;
+bool GLContext::program_binary_support = false;
 bool GLContext::shader_draw_parameters_support = false;
 bool GLContext::texture_cube_map_array_support = false;
 bool GLContext::texture_filter_anisotropic_support = false;
@@ -506,6 +510,13 @@ void GLBackend::capabilities_init()
   GLContext::native_barycentric_support = GLEW_AMD_shader_explicit_vertex_parameter;
   GLContext::multi_bind_support = GLEW_ARB_multi_bind;
   GLContext::multi_draw_indirect_support = GLEW_ARB_multi_draw_indirect;
+  GLContext::parallel_shader_compile_support = GLEW_ARB_parallel_shader_compile;
+  if (GLEW_ARB_get_program_binary) {
+    /* Some implementations expose the extension without supporting any binary format. */
+    GLint binary_formats_len = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binary_formats_len);
+    GLContext::program_binary_support = binary_formats_len > 0;
+  }
   GLContext::shader_draw_parameters_support = GLEW_ARB_shader_draw_parameters;
   GLContext::texture_cube_map_array_support = GLEW_ARB_texture_cube_map_array;
   GLContext::texture_filter_anisotropic_support = GLEW_EXT_texture_filter_anisotropic;
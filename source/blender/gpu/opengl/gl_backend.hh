@@ -66,6 +66,11 @@ class GLBackend : public GPUBackend {
     return new GLBatch();
   };
 
+  DepthReadBack *depth_readback_alloc() override
+  {
+    return new GLDepthReadBack();
+  };
+
   DrawList *drawlist_alloc(int list_length) override
   {
     return new GLDrawList(list_length);
@@ -40,6 +40,12 @@ GLContext::GLContext(void *ghost_window, GLSharedOrphanLists &shared_orphan_list
     debug::init_gl_callbacks();
   }
 
+  if (GLContext::parallel_shader_compile_support) {
+    /* Let the driver use as many threads as it wants to compile the shader stages. Only
+     * effective because the stages of a program are compiled before querying their status. */
+    glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+  }
+
   float data[4] = {0.0f, 0.0f, 0.0f, 1.0f};
   glGenBuffers(1, &default_attr_vbo_);
   glBindBuffer(GL_ARRAY_BUFFER, default_attr_vbo_);
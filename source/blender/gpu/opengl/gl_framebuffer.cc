@@ -441,6 +441,66 @@ void GLFrameBuffer::read(eGPUFrameBufferBits plane,
   glReadPixels(UNPACK4(area), format, type, r_data);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Asynchronous Depth Read-back
+ * \{ */
+
+GLDepthReadBack::~GLDepthReadBack()
+{
+  /* Sync objects are shared between contexts, but need one to be deleted. */
+  if (fence_ != nullptr && GLContext::get() != nullptr) {
+    glDeleteSync(fence_);
+  }
+  if (pbo_id_ != 0) {
+    GLContext::buf_free(pbo_id_);
+  }
+}
+
+void GLDepthReadBack::start(FrameBuffer *fb, int width, int height)
+{
+  if (fence_ != nullptr) {
+    glDeleteSync(fence_);
+    fence_ = nullptr;
+  }
+  if (pbo_id_ == 0) {
+    glGenBuffers(1, &pbo_id_);
+  }
+
+  const size_t size = sizeof(float) * (size_t)width * (size_t)height;
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo_id_);
+  if (size != pbo_size_) {
+    glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+    pbo_size_ = size;
+  }
+  /* With a pixel pack buffer bound, the data pointer is an offset inside of it. */
+  const int area[4] = {0, 0, width, height};
+  fb->read(GPU_DEPTH_BIT, GPU_DATA_FLOAT, area, 1, 0, nullptr);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  fence_ = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+bool GLDepthReadBack::result(float *r_data)
+{
+  if (fence_ == nullptr) {
+    return false;
+  }
+  GLint status = GL_UNSIGNALED;
+  glGetSynciv(fence_, GL_SYNC_STATUS, 1, nullptr, &status);
+  if (status != GL_SIGNALED) {
+    return false;
+  }
+  glDeleteSync(fence_);
+  fence_ = nullptr;
+
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo_id_);
+  glGetBufferSubData(GL_PIXEL_PACK_BUFFER, 0, pbo_size_, r_data);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  return true;
+}
+
+/** \} */
+
 void GLFrameBuffer::blit_to(
     eGPUFrameBufferBits planes, int src_slot, FrameBuffer *dst_, int dst_slot, int x, int y)
 {
@@ -104,6 +104,26 @@ class GLFrameBuffer : public FrameBuffer {
   MEM_CXX_CLASS_ALLOC_FUNCS("GLFrameBuffer");
 };
 
+/**
+ * Depth read into a pixel buffer object, with a fence to know when the GPU wrote it.
+ */
+class GLDepthReadBack : public DepthReadBack {
+ private:
+  GLuint pbo_id_ = 0;
+  /** Size of the buffer data store in bytes. */
+  size_t pbo_size_ = 0;
+  /** Signaled once the last started read is done. NULL if no read is in flight. */
+  GLsync fence_ = nullptr;
+
+ public:
+  ~GLDepthReadBack();
+
+  void start(FrameBuffer *fb, int width, int height) override;
+  bool result(float *r_data) override;
+
+  MEM_CXX_CLASS_ALLOC_FUNCS("GLDepthReadBack");
+};
+
 /* -------------------------------------------------------------------- */
 /** \name Enums Conversion
  * \{ */
@@ -5,8 +5,13 @@
  * \ingroup gpu
  */
 
+#include "BKE_appdir.h"
 #include "BKE_global.h"
 
+#include "BLI_fileops.h"
+#include "BLI_fileops_types.h"
+#include "BLI_hash_md5.h"
+#include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_vector.hh"
 
@@ -20,6 +25,9 @@
 #include "gl_shader.hh"
 #include "gl_shader_interface.hh"
 
+#include <algorithm>
+#include <mutex>
+
 using namespace blender;
 using namespace blender::gpu;
 using namespace blender::gpu::shader;
@@ -37,6 +45,9 @@ GLShader::GLShader(const char *name) : Shader(name)
   shader_program_ = glCreateProgram();
 
   debug::object_label(GL_PROGRAM, shader_program_, name);
+
+  /* Keep compilation logs when debugging. */
+  use_binary_cache_ = GLContext::program_binary_support && (G.debug & G_DEBUG_GPU) == 0;
 }
 
 GLShader::~GLShader()
@@ -849,6 +860,25 @@ char *GLShader::glsl_patch_get(GLenum gl_stage)
 }
 
 GLuint GLShader::create_shader_stage(GLenum gl_stage, MutableSpan<const char *> sources)
+{
+  /* Patch the shader code using the first source slot. */
+  sources[0] = glsl_patch_get(gl_stage);
+
+  if (use_binary_cache_) {
+    deferred_stages_.append_as();
+    StageSources &stage = deferred_stages_.last();
+    stage.gl_stage = gl_stage;
+    for (const char *source : sources) {
+      stage.sources.append(source);
+    }
+    return 0;
+  }
+
+  GLuint shader = this->shader_stage_compile(gl_stage, sources);
+  return this->shader_stage_attach(shader, gl_stage, sources);
+}
+
+GLuint GLShader::shader_stage_compile(GLenum gl_stage, Span<const char *> sources)
 {
   GLuint shader = glCreateShader(gl_stage);
   if (shader == 0) {
@@ -856,11 +886,17 @@ GLuint GLShader::create_shader_stage(GLenum gl_stage, MutableSpan<const char *>
     return 0;
   }
 
-  /* Patch the shader code using the first source slot. */
-  sources[0] = glsl_patch_get(gl_stage);
-
   glShaderSource(shader, sources.size(), sources.data(), nullptr);
   glCompileShader(shader);
+  return shader;
+}
+
+GLuint GLShader::shader_stage_attach(GLuint shader, GLenum gl_stage, Span<const char *> sources)
+{
+  if (shader == 0) {
+    compilation_failed_ = true;
+    return 0;
+  }
 
   GLint status;
   glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
@@ -897,6 +933,42 @@ GLuint GLShader::create_shader_stage(GLenum gl_stage, MutableSpan<const char *>
   return shader;
 }
 
+bool GLShader::deferred_stages_compile()
+{
+  Vector<Vector<const char *>> stage_sources;
+  Vector<GLuint> shaders;
+  /* Start all compilations before checking any result so that the driver can compile them in
+   * parallel. */
+  for (const StageSources &stage : deferred_stages_) {
+    stage_sources.append_as();
+    Vector<const char *> &sources = stage_sources.last();
+    for (const std::string &source : stage.sources) {
+      sources.append(source.c_str());
+    }
+    shaders.append(this->shader_stage_compile(stage.gl_stage, sources));
+  }
+  for (int i : deferred_stages_.index_range()) {
+    const GLenum gl_stage = deferred_stages_[i].gl_stage;
+    GLuint shader = this->shader_stage_attach(shaders[i], gl_stage, stage_sources[i]);
+    switch (gl_stage) {
+      case GL_VERTEX_SHADER:
+        vert_shader_ = shader;
+        break;
+      case GL_GEOMETRY_SHADER:
+        geom_shader_ = shader;
+        break;
+      case GL_FRAGMENT_SHADER:
+        frag_shader_ = shader;
+        break;
+      case GL_COMPUTE_SHADER:
+        compute_shader_ = shader;
+        break;
+    }
+  }
+  deferred_stages_.clear();
+  return !compilation_failed_;
+}
+
 void GLShader::vertex_shader_from_glsl(MutableSpan<const char *> sources)
 {
   vert_shader_ = this->create_shader_stage(GL_VERTEX_SHADER, sources);
@@ -917,6 +989,222 @@ void GLShader::compute_shader_from_glsl(MutableSpan<const char *> sources)
   compute_shader_ = this->create_shader_stage(GL_COMPUTE_SHADER, sources);
 }
 
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Program Binary Cache
+ *
+ * Linked programs are stored on disk so that they don't need to be compiled again in the next
+ * sessions. Files are named after a hash of all the sources, in a directory named after a hash of
+ * the driver identification. After a driver update the directory of the previous driver is
+ * deleted, and the least recently used programs are deleted when the cache gets too large.
+ * \{ */
+
+#define BINARY_CACHE_VERSION 2
+/** Size in bytes the cached programs of a driver can take before the oldest ones are deleted. */
+#define BINARY_CACHE_SIZE_MAX (256 * 1024 * 1024)
+
+struct BinaryCacheHeader {
+  char magic[4];
+  uint32_t version;
+  uint32_t format;
+  uint32_t length;
+};
+
+static void binary_cache_header_init(BinaryCacheHeader &header)
+{
+  memcpy(header.magic, "BGPB", sizeof(header.magic));
+  header.version = BINARY_CACHE_VERSION;
+  header.format = 0;
+  header.length = 0;
+}
+
+std::string GLShader::binary_cache_key_get() const
+{
+  std::string key = transform_feedback_key_;
+  for (const StageSources &stage : deferred_stages_) {
+    key += std::to_string(stage.gl_stage);
+    for (const std::string &source : stage.sources) {
+      key += source;
+    }
+  }
+  return key;
+}
+
+static void binary_cache_hash(const std::string &key, char r_hexdigest[33])
+{
+  uchar digest[16];
+  BLI_hash_md5_buffer(key.c_str(), key.size(), digest);
+  BLI_hash_md5_to_hexdigest(digest, r_hexdigest);
+}
+
+/**
+ * Delete everything except the directory of the current driver, those programs can't be loaded
+ * anymore. Then delete the least recently used programs of the current driver until they fit in
+ * #BINARY_CACHE_SIZE_MAX.
+ */
+static void binary_cache_prune(const char *cache_dirpath, const char *driver_dirname)
+{
+  struct direntry *entries;
+  uint entries_num = BLI_filelist_dir_contents(cache_dirpath, &entries);
+  for (const int i : IndexRange(entries_num)) {
+    const direntry &entry = entries[i];
+    if (FILENAME_IS_CURRPAR(entry.relname) || STREQ(entry.relname, driver_dirname)) {
+      continue;
+    }
+    const bool is_dir = BLI_is_dir(entry.path);
+    BLI_delete(entry.path, is_dir, is_dir);
+  }
+  BLI_filelist_free(entries, entries_num);
+
+  char driver_dirpath[FILE_MAX];
+  BLI_join_dirfile(driver_dirpath, sizeof(driver_dirpath), cache_dirpath, driver_dirname);
+  entries_num = BLI_filelist_dir_contents(driver_dirpath, &entries);
+  Vector<const direntry *> files;
+  int64_t size_total = 0;
+  for (const int i : IndexRange(entries_num)) {
+    const direntry &entry = entries[i];
+    if (BLI_is_file(entry.path)) {
+      files.append(&entry);
+      size_total += entry.s.st_size;
+    }
+  }
+  /* Loaded programs are touched, so the modification time is the time of the last use. */
+  std::sort(files.begin(), files.end(), [](const direntry *a, const direntry *b) {
+    return a->s.st_mtime < b->s.st_mtime;
+  });
+  for (const direntry *file : files) {
+    if (size_total <= BINARY_CACHE_SIZE_MAX) {
+      break;
+    }
+    BLI_delete(file->path, false, false);
+    size_total -= file->s.st_size;
+  }
+  BLI_filelist_free(entries, entries_num);
+}
+
+/**
+ * Directory of the programs of the current driver. It is created and pruned once per session,
+ * the first time a program is linked.
+ */
+static const char *binary_cache_dirpath_get()
+{
+  static char driver_dirpath[FILE_MAX] = "";
+  static std::once_flag init_once;
+  std::call_once(init_once, []() {
+    char cache_dirpath[FILE_MAX];
+    if (!BKE_appdir_folder_caches(cache_dirpath, sizeof(cache_dirpath))) {
+      return;
+    }
+    BLI_path_append(cache_dirpath, sizeof(cache_dirpath), "shaders");
+
+    std::string driver_key;
+    driver_key += GPU_platform_vendor();
+    driver_key += GPU_platform_renderer();
+    driver_key += GPU_platform_version();
+    driver_key += std::to_string(BINARY_CACHE_VERSION);
+    char driver_dirname[33];
+    binary_cache_hash(driver_key, driver_dirname);
+
+    char dirpath[FILE_MAX];
+    BLI_join_dirfile(dirpath, sizeof(dirpath), cache_dirpath, driver_dirname);
+    if (!BLI_dir_create_recursive(dirpath)) {
+      return;
+    }
+    binary_cache_prune(cache_dirpath, driver_dirname);
+    BLI_strncpy(driver_dirpath, dirpath, sizeof(driver_dirpath));
+  });
+  return driver_dirpath[0] != '\0' ? driver_dirpath : nullptr;
+}
+
+static bool binary_cache_filepath_get(const std::string &key, char r_filepath[FILE_MAX])
+{
+  const char *dirpath = binary_cache_dirpath_get();
+  if (dirpath == nullptr) {
+    return false;
+  }
+
+  char filename[33];
+  binary_cache_hash(key, filename);
+  BLI_join_dirfile(r_filepath, FILE_MAX, dirpath, filename);
+  return true;
+}
+
+static bool binary_cache_load(GLuint program, const char *filepath)
+{
+  FILE *file = BLI_fopen(filepath, "rb");
+  if (file == nullptr) {
+    return false;
+  }
+
+  BinaryCacheHeader header, header_expected;
+  binary_cache_header_init(header_expected);
+  bool is_valid = fread(&header, sizeof(header), 1, file) == 1 &&
+                  memcmp(header.magic, header_expected.magic, sizeof(header.magic)) == 0 &&
+                  header.version == header_expected.version && header.length > 0;
+
+  Vector<char> binary;
+  if (is_valid) {
+    binary.resize(header.length);
+    is_valid = fread(binary.data(), header.length, 1, file) == 1;
+  }
+  fclose(file);
+
+  if (is_valid) {
+    glProgramBinary(program, header.format, binary.data(), header.length);
+    GLint status;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    is_valid = status;
+  }
+  if (is_valid) {
+    /* Mark it as recently used, see #binary_cache_prune. */
+    BLI_file_touch(filepath);
+  }
+  else {
+    /* Outdated or corrupted, it is replaced once the program is compiled. */
+    BLI_delete(filepath, false, false);
+  }
+  return is_valid;
+}
+
+static void binary_cache_save(GLuint program, const char *filepath)
+{
+  GLint length = 0;
+  glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0) {
+    return;
+  }
+
+  BinaryCacheHeader header;
+  binary_cache_header_init(header);
+  Vector<char> binary(length);
+  GLenum format;
+  glGetProgramBinary(program, length, nullptr, &format, binary.data());
+  header.format = format;
+  header.length = length;
+
+  /* Write to a temporary file first, other threads or instances can read the same program. */
+  char filepath_tmp[FILE_MAX];
+  BLI_snprintf(filepath_tmp, sizeof(filepath_tmp), "%s.%p.tmp", filepath, (void *)&header);
+  FILE *file = BLI_fopen(filepath_tmp, "wb");
+  if (file == nullptr) {
+    return;
+  }
+  const bool is_written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                          fwrite(binary.data(), length, 1, file) == 1;
+  fclose(file);
+
+  if (!is_written || BLI_rename(filepath_tmp, filepath) != 0) {
+    BLI_delete(filepath_tmp, false, false);
+  }
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Linking
+ * \{ */
+
 bool GLShader::finalize(const shader::ShaderCreateInfo *info)
 {
   if (compilation_failed_) {
@@ -931,6 +1219,20 @@ bool GLShader::finalize(const shader::ShaderCreateInfo *info)
     geometry_shader_from_glsl(sources);
   }
 
+  char cache_filepath[FILE_MAX] = "";
+  if (use_binary_cache_) {
+    if (binary_cache_filepath_get(this->binary_cache_key_get(), cache_filepath) &&
+        binary_cache_load(shader_program_, cache_filepath)) {
+      deferred_stages_.clear();
+      this->interface_create(info);
+      return true;
+    }
+    if (!this->deferred_stages_compile()) {
+      return false;
+    }
+    glProgramParameteri(shader_program_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
+
   glLinkProgram(shader_program_);
 
   GLint status;
@@ -944,14 +1246,22 @@ bool GLShader::finalize(const shader::ShaderCreateInfo *info)
     return false;
   }
 
+  if (cache_filepath[0] != '\0') {
+    binary_cache_save(shader_program_, cache_filepath);
+  }
+
+  this->interface_create(info);
+  return true;
+}
+
+void GLShader::interface_create(const shader::ShaderCreateInfo *info)
+{
   if (info != nullptr) {
     interface = new GLShaderInterface(shader_program_, *info);
   }
   else {
     interface = new GLShaderInterface(shader_program_);
   }
-
-  return true;
 }
 
 /** \} */
@@ -987,6 +1297,10 @@ void GLShader::transform_feedback_names_set(Span<const char *> name_list,
   glTransformFeedbackVaryings(
       shader_program_, name_list.size(), name_list.data(), GL_INTERLEAVED_ATTRIBS);
   transform_feedback_type_ = geom_type;
+  for (const char *name : name_list) {
+    transform_feedback_key_ += name;
+    transform_feedback_key_ += ';';
+  }
 }
 
 bool GLShader::transform_feedback_enable(GPUVertBuf *buf_)
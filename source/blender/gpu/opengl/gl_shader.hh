@@ -35,6 +35,20 @@ class GLShader : public Shader {
   /** True if any shader failed to compile. */
   bool compilation_failed_ = false;
 
+  /** True if the linked program is looked up in the on-disk program binary cache. */
+  bool use_binary_cache_ = false;
+  /**
+   * Sources of the shader stages when using the binary cache. The stages are only compiled if
+   * the program is not found in the cache.
+   */
+  struct StageSources {
+    GLenum gl_stage;
+    Vector<std::string> sources;
+  };
+  Vector<StageSources> deferred_stages_;
+  /** Transform feedback varyings, part of the binary cache key. */
+  std::string transform_feedback_key_;
+
   eGPUShaderTFBType transform_feedback_type_ = GPU_SHADER_TFB_NONE;
 
  public:
@@ -75,8 +89,20 @@ class GLShader : public Shader {
  private:
   char *glsl_patch_get(GLenum gl_stage);
 
-  /** Create, compile and attach the shader stage to the shader program. */
+  /**
+   * Create, compile and attach the shader stage to the shader program.
+   * Return 0 if the compilation is deferred to #finalize when using the binary cache.
+   */
   GLuint create_shader_stage(GLenum gl_stage, MutableSpan<const char *> sources);
+  /** Create the shader stage and start its compilation. */
+  GLuint shader_stage_compile(GLenum gl_stage, Span<const char *> sources);
+  /** Check the result of the compilation and attach the shader stage to the shader program. */
+  GLuint shader_stage_attach(GLuint shader, GLenum gl_stage, Span<const char *> sources);
+  /** Compile all deferred shader stages. Return false if any failed to compile. */
+  bool deferred_stages_compile();
+  /** Key identifying the program in the binary cache, for the current driver. */
+  std::string binary_cache_key_get() const;
+  void interface_create(const shader::ShaderCreateInfo *info);
 
   /**
    * \brief features available on newer implementation such as native barycentric coordinates
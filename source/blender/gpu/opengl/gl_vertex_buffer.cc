@@ -19,7 +19,9 @@ void GLVertBuf::acquire_data()
 
   /* Discard previous data if any. */
   MEM_SAFE_FREE(data);
+  const eMEMCategory prev_mem_category = MEM_category_set(MEM_CATEGORY_GPU_STAGING);
   data = (uchar *)MEM_mallocN(sizeof(uchar) * this->size_alloc_get(), __func__);
+  MEM_category_set(prev_mem_category);
 }
 
 void GLVertBuf::resize_data()
@@ -28,7 +30,9 @@ void GLVertBuf::resize_data()
     return;
   }
 
+  const eMEMCategory prev_mem_category = MEM_category_set(MEM_CATEGORY_GPU_STAGING);
   data = (uchar *)MEM_reallocN(data, sizeof(uchar) * this->size_alloc_get());
+  MEM_category_set(prev_mem_category);
 }
 
 void GLVertBuf::release_data()
@@ -3,7 +3,8 @@ uniform mat4 ModelViewProjectionMatrix;
 
 #  define MAX_PARAM 12
 #  ifdef USE_INSTANCE
-#    define MAX_INSTANCE 6
+/* Same as MAX_WIDGET_BASE_BATCH. */
+#    define MAX_INSTANCE 16
 uniform vec4 parameters[MAX_PARAM * MAX_INSTANCE];
 #  else
 uniform vec4 parameters[MAX_PARAM];
@@ -338,6 +338,12 @@ typedef enum IMB_Proxy_Size {
   IMB_PROXY_MAX_SLOT = 4,
 } IMB_Proxy_Size;
 
+typedef enum IMB_Proxy_Codec {
+  IMB_PROXY_CODEC_H264 = 0,
+  /** Intra-only, cheaper to encode and to seek in while editing, at the cost of larger files. */
+  IMB_PROXY_CODEC_MJPEG = 1,
+} IMB_Proxy_Codec;
+
 typedef enum eIMBInterpolationFilterMode {
   IMB_FILTER_NEAREST,
   IMB_FILTER_BILINEAR,
@@ -361,6 +367,7 @@ struct IndexBuildContext;
 struct IndexBuildContext *IMB_anim_index_rebuild_context(struct anim *anim,
                                                          IMB_Timecode_Type tcs_in_use,
                                                          IMB_Proxy_Size proxy_sizes_in_use,
+                                                         IMB_Proxy_Codec proxy_codec,
                                                          int quality,
                                                          const bool overwrite,
                                                          struct GSet *file_list,
@@ -929,6 +936,8 @@ void IMB_ffmpeg_init(void);
 const char *IMB_ffmpeg_last_error(void);
 
 /**
+ * \param use_compression: Block compress byte images when possible. The returned texture then
+ * has a complete mipmap chain and can't be partially updated.
  *
  * \attention defined in util_gpu.c
  */
@@ -936,7 +945,8 @@ struct GPUTexture *IMB_create_gpu_texture(const char *name,
                                           struct ImBuf *ibuf,
                                           bool use_high_bitdepth,
                                           bool use_premult,
-                                          bool limit_gl_texture_size);
+                                          bool limit_gl_texture_size,
+                                          bool use_compression);
 /**
  * The `ibuf` is only here to detect the storage type. The produced texture will have undefined
  * content. It will need to be populated by using #IMB_update_gpu_texture_sub().
@@ -155,6 +155,8 @@ typedef enum eImBufFlags {
   IB_thumbnail = 1 << 16,
   IB_multiview = 1 << 17,
   IB_halffloat = 1 << 18,
+  /** Decode movies on the GPU when supported (ignored with #IB_animdeinterlace). */
+  IB_animhwdecode = 1 << 19,
 } eImBufFlags;
 
 /** \} */
@@ -114,6 +114,13 @@ struct anim {
   AVFrame *pFrameRGB;
   AVFrame *pFrameDeinterlaced;
   struct SwsContext *img_convert_ctx;
+  /** Pixel format #img_convert_ctx converts from. */
+  enum AVPixelFormat img_convert_fmt;
+  /** Hardware decoding, NULL when decoding in software. */
+  AVBufferRef *hw_device_ctx;
+  enum AVPixelFormat hw_pix_fmt;
+  /** Decoded frame downloaded from the hardware surface. */
+  AVFrame *pFrameHWDownload;
   int videoStream;
 
   struct ImBuf *cur_frame_final;
@@ -65,6 +65,7 @@
 
 #  include <libavcodec/avcodec.h>
 #  include <libavformat/avformat.h>
+#  include <libavutil/hwcontext.h>
 #  include <libavutil/imgutils.h>
 #  include <libavutil/rational.h>
 #  include <libswscale/swscale.h>
@@ -488,6 +489,146 @@ static ImBuf *avi_fetchibuf(struct anim *anim, int position)
 
 #ifdef WITH_FFMPEG
 
+/* Hardware decoding devices to try, in order of preference. */
+static const enum AVHWDeviceType ffmpeg_hw_device_types[] = {
+#  if defined(_WIN32)
+    AV_HWDEVICE_TYPE_D3D11VA,
+    AV_HWDEVICE_TYPE_CUDA,
+    AV_HWDEVICE_TYPE_DXVA2,
+#  elif defined(__APPLE__)
+    AV_HWDEVICE_TYPE_VIDEOTOOLBOX,
+#  else
+    AV_HWDEVICE_TYPE_CUDA,
+    AV_HWDEVICE_TYPE_VAAPI,
+#  endif
+};
+
+static enum AVPixelFormat ffmpeg_hw_get_format(AVCodecContext *pCodecCtx,
+                                               const enum AVPixelFormat *pix_fmts)
+{
+  const struct anim *anim = pCodecCtx->opaque;
+
+  for (const enum AVPixelFormat *p = pix_fmts; *p != AV_PIX_FMT_NONE; p++) {
+    if (*p == anim->hw_pix_fmt) {
+      return *p;
+    }
+  }
+
+  /* The device can't decode this stream (profile, bit depth...), fall back to software. */
+  return avcodec_default_get_format(pCodecCtx, pix_fmts);
+}
+
+/* Attach a hardware device to the codec context when one supporting the codec is available.
+ * Frames are downloaded to system memory in #ffmpeg_postprocess, everything else in the decoding
+ * path stays the same. */
+static bool ffmpeg_hw_decode_init(struct anim *anim,
+                                  AVCodecContext *pCodecCtx,
+                                  const AVCodec *pCodec)
+{
+  for (int i = 0; i < ARRAY_SIZE(ffmpeg_hw_device_types); i++) {
+    const enum AVHWDeviceType type = ffmpeg_hw_device_types[i];
+    const AVCodecHWConfig *config = NULL;
+
+    for (int j = 0; (config = avcodec_get_hw_config(pCodec, j)) != NULL; j++) {
+      if ((config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX) &&
+          config->device_type == type) {
+        break;
+      }
+    }
+    if (config == NULL) {
+      continue;
+    }
+
+    if (av_hwdevice_ctx_create(&anim->hw_device_ctx, type, NULL, NULL, 0) < 0) {
+      continue;
+    }
+
+    anim->hw_pix_fmt = config->pix_fmt;
+    pCodecCtx->hw_device_ctx = av_buffer_ref(anim->hw_device_ctx);
+    pCodecCtx->opaque = anim;
+    pCodecCtx->get_format = ffmpeg_hw_get_format;
+
+    av_log(NULL,
+           AV_LOG_INFO,
+           "Using %s for hardware video decoding\n",
+           av_hwdevice_get_type_name(type));
+    return true;
+  }
+
+  return false;
+}
+
+/* Pixel format of the frames handed to `sws_scale`, for hardware decoding this is the format of
+ * the downloaded frame. */
+static enum AVPixelFormat ffmpeg_sw_pix_fmt(const struct anim *anim)
+{
+  if (anim->hw_device_ctx && anim->pCodecCtx->sw_pix_fmt != AV_PIX_FMT_NONE) {
+    return anim->pCodecCtx->sw_pix_fmt;
+  }
+  return anim->pCodecCtx->pix_fmt;
+}
+
+/* (Re)create the color conversion context when the input pixel format changes, this happens
+ * when hardware decoding downloads frames in a different layout than the stream (NV12 instead
+ * of YUV420P for example) or falls back to software. */
+static bool ffmpeg_sws_context_ensure(struct anim *anim, enum AVPixelFormat pix_fmt)
+{
+  /* The following for color space determination */
+  int srcRange, dstRange, brightness, contrast, saturation;
+  int *table;
+  const int *inv_table;
+
+  if (anim->img_convert_ctx && anim->img_convert_fmt == pix_fmt) {
+    return true;
+  }
+
+  sws_freeContext(anim->img_convert_ctx);
+  anim->img_convert_ctx = sws_getContext(anim->x,
+                                         anim->y,
+                                         pix_fmt,
+                                         anim->x,
+                                         anim->y,
+                                         AV_PIX_FMT_RGBA,
+                                         SWS_BILINEAR | SWS_PRINT_INFO | SWS_FULL_CHR_H_INT,
+                                         NULL,
+                                         NULL,
+                                         NULL);
+  anim->img_convert_fmt = pix_fmt;
+
+  if (!anim->img_convert_ctx) {
+    return false;
+  }
+
+  /* Try do detect if input has 0-255 YCbCR range (JFIF Jpeg MotionJpeg) */
+  if (!sws_getColorspaceDetails(anim->img_convert_ctx,
+                                (int **)&inv_table,
+                                &srcRange,
+                                &table,
+                                &dstRange,
+                                &brightness,
+                                &contrast,
+                                &saturation)) {
+    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
+    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
+
+    if (sws_setColorspaceDetails(anim->img_convert_ctx,
+                                 (int *)inv_table,
+                                 srcRange,
+                                 table,
+                                 dstRange,
+                                 brightness,
+                                 contrast,
+                                 saturation)) {
+      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+    }
+  }
+  else {
+    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+  }
+
+  return true;
+}
+
 static int startffmpeg(struct anim *anim)
 {
   int i, video_stream_index;
@@ -501,11 +642,6 @@ static int startffmpeg(struct anim *anim)
   double frs_den;
   int streamcount;
 
-  /* The following for color space determination */
-  int srcRange, dstRange, brightness, contrast, saturation;
-  int *table;
-  const int *inv_table;
-
   if (anim == NULL) {
     return (-1);
   }
@@ -569,7 +705,14 @@ static int startffmpeg(struct anim *anim)
     pCodecCtx->thread_type = FF_THREAD_SLICE;
   }
 
+  anim->hw_device_ctx = NULL;
+  anim->hw_pix_fmt = AV_PIX_FMT_NONE;
+  if ((anim->ib_flags & IB_animhwdecode) && !(anim->ib_flags & IB_animdeinterlace)) {
+    ffmpeg_hw_decode_init(anim, pCodecCtx, pCodec);
+  }
+
   if (avcodec_open2(pCodecCtx, pCodec, NULL) < 0) {
+    av_buffer_unref(&anim->hw_device_ctx);
     avformat_close_input(&pFormatCtx);
     return -1;
   }
@@ -698,6 +841,7 @@ static int startffmpeg(struct anim *anim)
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
     av_frame_free(&anim->pFrame);
+    av_buffer_unref(&anim->hw_device_ctx);
     anim->pCodecCtx = NULL;
     return -1;
   }
@@ -710,6 +854,7 @@ static int startffmpeg(struct anim *anim)
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
     av_frame_free(&anim->pFrame);
+    av_buffer_unref(&anim->hw_device_ctx);
     anim->pCodecCtx = NULL;
     return -1;
   }
@@ -728,18 +873,10 @@ static int startffmpeg(struct anim *anim)
                          1);
   }
 
-  anim->img_convert_ctx = sws_getContext(anim->x,
-                                         anim->y,
-                                         anim->pCodecCtx->pix_fmt,
-                                         anim->x,
-                                         anim->y,
-                                         AV_PIX_FMT_RGBA,
-                                         SWS_BILINEAR | SWS_PRINT_INFO | SWS_FULL_CHR_H_INT,
-                                         NULL,
-                                         NULL,
-                                         NULL);
+  anim->img_convert_ctx = NULL;
+  anim->pFrameHWDownload = anim->hw_device_ctx ? av_frame_alloc() : NULL;
 
-  if (!anim->img_convert_ctx) {
+  if (!ffmpeg_sws_context_ensure(anim, anim->pCodecCtx->pix_fmt)) {
     fprintf(stderr, "Can't transform color space??? Bailing out...\n");
     avcodec_free_context(&anim->pCodecCtx);
     avformat_close_input(&anim->pFormatCtx);
@@ -747,37 +884,12 @@ static int startffmpeg(struct anim *anim)
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
     av_frame_free(&anim->pFrame);
+    av_frame_free(&anim->pFrameHWDownload);
+    av_buffer_unref(&anim->hw_device_ctx);
     anim->pCodecCtx = NULL;
     return -1;
   }
 
-  /* Try do detect if input has 0-255 YCbCR range (JFIF Jpeg MotionJpeg) */
-  if (!sws_getColorspaceDetails(anim->img_convert_ctx,
-                                (int **)&inv_table,
-                                &srcRange,
-                                &table,
-                                &dstRange,
-                                &brightness,
-                                &contrast,
-                                &saturation)) {
-    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
-    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
-
-    if (sws_setColorspaceDetails(anim->img_convert_ctx,
-                                 (int *)inv_table,
-                                 srcRange,
-                                 table,
-                                 dstRange,
-                                 brightness,
-                                 contrast,
-                                 saturation)) {
-      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-    }
-  }
-  else {
-    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-  }
-
   return 0;
 }
 
@@ -797,6 +909,21 @@ static void ffmpeg_postprocess(struct anim *anim)
     return;
   }
 
+  if (anim->hw_device_ctx && input->format == anim->hw_pix_fmt) {
+    /* Download the decoded surface, the rest of the conversion happens on the CPU. */
+    av_frame_unref(anim->pFrameHWDownload);
+    if (av_hwframe_transfer_data(anim->pFrameHWDownload, input, 0) < 0) {
+      fprintf(stderr, "ffmpeg_fetchibuf: could not download hardware decoded frame\n");
+      return;
+    }
+    input = anim->pFrameHWDownload;
+  }
+
+  if (!ffmpeg_sws_context_ensure(anim, input->format)) {
+    fprintf(stderr, "ffmpeg_fetchibuf: unsupported pixel format\n");
+    return;
+  }
+
   /* This means the data wasn't read properly,
    * this check stops crashing */
   if (input->data[0] == 0 && input->data[1] == 0 && input->data[2] == 0 && input->data[3] == 0) {
@@ -1373,7 +1500,7 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Typ
    * The issue was reported to FFmpeg under ticket #8747 in the FFmpeg tracker
    * and is fixed in the newer versions than 4.3.1. */
 
-  const AVPixFmtDescriptor *pix_fmt_descriptor = av_pix_fmt_desc_get(anim->pCodecCtx->pix_fmt);
+  const AVPixFmtDescriptor *pix_fmt_descriptor = av_pix_fmt_desc_get(ffmpeg_sw_pix_fmt(anim));
 
   int planes = R_IMF_PLANES_RGBA;
   if ((pix_fmt_descriptor->flags & AV_PIX_FMT_FLAG_ALPHA) == 0) {
@@ -1410,6 +1537,8 @@ static void free_anim_ffmpeg(struct anim *anim)
     av_frame_free(&anim->pFrame);
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
+    av_frame_free(&anim->pFrameHWDownload);
+    av_buffer_unref(&anim->hw_device_ctx);
 
     sws_freeContext(anim->img_convert_ctx);
     IMB_freeImBuf(anim->cur_frame_final);
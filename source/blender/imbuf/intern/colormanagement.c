@@ -84,10 +84,33 @@ static float imbuf_linear_srgb_to_xyz[3][3] = {{0.0f}};
  */
 static pthread_mutex_t processor_lock = BLI_MUTEX_INITIALIZER;
 
+/* Display processors are expensive to create and requested for every displayed buffer, so the
+ * most recently used ones are kept around. Entries are protected by processor_lock. */
+typedef struct DisplayProcessorCacheEntry {
+  struct DisplayProcessorCacheEntry *next, *prev;
+
+  char look[MAX_COLORSPACE_NAME];
+  char view_transform[MAX_COLORSPACE_NAME];
+  char display[MAX_COLORSPACE_NAME];
+  char from_colorspace[MAX_COLORSPACE_NAME];
+  float exposure, gamma;
+
+  OCIO_ConstCPUProcessorRcPtr *cpu_processor;
+  /* Number of processors using this entry, only unused entries are evicted. */
+  int users;
+} DisplayProcessorCacheEntry;
+
+#define DISPLAY_PROCESSOR_CACHE_MAX 8
+
+/* Most recently used entries first. */
+static ListBase global_display_processor_cache = {NULL, NULL};
+
 typedef struct ColormanageProcessor {
   OCIO_ConstCPUProcessorRcPtr *cpu_processor;
   CurveMapping *curve_mapping;
   bool is_data_result;
+  /* When set cpu_processor is owned by this cache entry. */
+  DisplayProcessorCacheEntry *cache_entry;
 } ColormanageProcessor;
 
 static struct global_gpu_state {
@@ -567,11 +590,23 @@ static void colormanage_load_config(OCIO_ConstConfigRcPtr *config)
   invert_m3_m3(imbuf_linear_srgb_to_xyz, imbuf_xyz_to_linear_srgb);
 }
 
+static void display_processor_cache_free(void)
+{
+  LISTBASE_FOREACH_MUTABLE (DisplayProcessorCacheEntry *, entry, &global_display_processor_cache) {
+    BLI_assert(entry->users == 0);
+    OCIO_cpuProcessorRelease(entry->cpu_processor);
+    MEM_freeN(entry);
+  }
+  BLI_listbase_clear(&global_display_processor_cache);
+}
+
 static void colormanage_free_config(void)
 {
   ColorSpace *colorspace;
   ColorManagedDisplay *display;
 
+  display_processor_cache_free();
+
   /* free color spaces */
   colorspace = global_colorspaces.first;
   while (colorspace) {
@@ -839,6 +874,74 @@ static OCIO_ConstCPUProcessorRcPtr *create_display_buffer_processor(const char *
   return cpu_processor;
 }
 
+static DisplayProcessorCacheEntry *display_processor_cache_acquire(const char *look,
+                                                                   const char *view_transform,
+                                                                   const char *display,
+                                                                   float exposure,
+                                                                   float gamma,
+                                                                   const char *from_colorspace)
+{
+  DisplayProcessorCacheEntry *entry;
+
+  BLI_mutex_lock(&processor_lock);
+
+  LISTBASE_FOREACH (DisplayProcessorCacheEntry *, cached, &global_display_processor_cache) {
+    if (STREQ(cached->look, look) && STREQ(cached->view_transform, view_transform) &&
+        STREQ(cached->display, display) && STREQ(cached->from_colorspace, from_colorspace) &&
+        cached->exposure == exposure && cached->gamma == gamma) {
+      BLI_remlink(&global_display_processor_cache, cached);
+      BLI_addhead(&global_display_processor_cache, cached);
+      cached->users++;
+      BLI_mutex_unlock(&processor_lock);
+      return cached;
+    }
+  }
+
+  OCIO_ConstCPUProcessorRcPtr *cpu_processor = create_display_buffer_processor(
+      look, view_transform, display, exposure, gamma, from_colorspace);
+  if (cpu_processor == NULL) {
+    BLI_mutex_unlock(&processor_lock);
+    return NULL;
+  }
+
+  entry = MEM_callocN(sizeof(DisplayProcessorCacheEntry), "display processor cache entry");
+  STRNCPY(entry->look, look);
+  STRNCPY(entry->view_transform, view_transform);
+  STRNCPY(entry->display, display);
+  STRNCPY(entry->from_colorspace, from_colorspace);
+  entry->exposure = exposure;
+  entry->gamma = gamma;
+  entry->cpu_processor = cpu_processor;
+  entry->users = 1;
+  BLI_addhead(&global_display_processor_cache, entry);
+
+  /* Evict least recently used entries which are not in use. */
+  int tot_entries = BLI_listbase_count(&global_display_processor_cache);
+  DisplayProcessorCacheEntry *evict = global_display_processor_cache.last;
+  while (evict && tot_entries > DISPLAY_PROCESSOR_CACHE_MAX) {
+    DisplayProcessorCacheEntry *evict_prev = evict->prev;
+    if (evict->users == 0) {
+      BLI_remlink(&global_display_processor_cache, evict);
+      OCIO_cpuProcessorRelease(evict->cpu_processor);
+      MEM_freeN(evict);
+      tot_entries--;
+    }
+    evict = evict_prev;
+  }
+
+  BLI_mutex_unlock(&processor_lock);
+
+  return entry;
+}
+
+static void display_processor_cache_release(DisplayProcessorCacheEntry *entry)
+{
+  BLI_mutex_lock(&processor_lock);
+  BLI_assert(entry->users > 0);
+  entry->users--;
+  BLI_mutex_unlock(&processor_lock);
+}
+
 static OCIO_ConstProcessorRcPtr *create_colorspace_transform_processor(const char *from_colorspace,
                                                                        const char *to_colorspace)
 {
@@ -2712,7 +2815,8 @@ void IMB_display_buffer_transform_apply(unsigned char *display_buffer,
                        "display transform temp buffer");
   memcpy(buffer, linear_buffer, (size_t)channels * width * height * sizeof(float));
 
-  IMB_colormanagement_processor_apply(cm_processor, buffer, width, height, channels, predivide);
+  processor_transform_apply_threaded(
+      NULL, buffer, width, height, channels, cm_processor, predivide, false);
 
   IMB_colormanagement_processor_free(cm_processor);
 
@@ -3716,13 +3820,16 @@ ColormanageProcessor *IMB_colormanagement_display_processor_new(
     cm_processor->is_data_result = display_space->is_data;
   }
 
-  cm_processor->cpu_processor = create_display_buffer_processor(
+  cm_processor->cache_entry = display_processor_cache_acquire(
       applied_view_settings->look,
       applied_view_settings->view_transform,
       display_settings->display_device,
       applied_view_settings->exposure,
       applied_view_settings->gamma,
       global_role_scene_linear);
+  if (cm_processor->cache_entry) {
+    cm_processor->cpu_processor = cm_processor->cache_entry->cpu_processor;
+  }
 
   if (applied_view_settings->flag & COLORMANAGE_VIEW_USE_CURVES) {
     cm_processor->curve_mapping = BKE_curvemapping_copy(applied_view_settings->curve_mapping);
@@ -3874,7 +3981,10 @@ void IMB_colormanagement_processor_free(ColormanageProcessor *cm_processor)
   if (cm_processor->curve_mapping) {
     BKE_curvemapping_free(cm_processor->curve_mapping);
   }
-  if (cm_processor->cpu_processor) {
+  if (cm_processor->cache_entry) {
+    display_processor_cache_release(cm_processor->cache_entry);
+  }
+  else if (cm_processor->cpu_processor) {
     OCIO_cpuProcessorRelease(cm_processor->cpu_processor);
   }
 
@@ -16,6 +16,7 @@
 #include "BLI_math.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 #ifdef _WIN32
@@ -487,8 +488,13 @@ struct proxy_output_ctx {
   struct anim *anim;
 };
 
-static struct proxy_output_ctx *alloc_proxy_output_ffmpeg(
-    struct anim *anim, AVStream *st, int proxy_size, int width, int height, int quality)
+static struct proxy_output_ctx *alloc_proxy_output_ffmpeg(struct anim *anim,
+                                                          AVStream *st,
+                                                          int proxy_size,
+                                                          int width,
+                                                          int height,
+                                                          IMB_Proxy_Codec proxy_codec,
+                                                          int quality)
 {
   struct proxy_output_ctx *rv = MEM_callocN(sizeof(struct proxy_output_ctx), "alloc_proxy_output");
 
@@ -510,7 +516,8 @@ static struct proxy_output_ctx *alloc_proxy_output_ffmpeg(
   rv->st = avformat_new_stream(rv->of, NULL);
   rv->st->id = 0;
 
-  rv->codec = avcodec_find_encoder(AV_CODEC_ID_H264);
+  rv->codec = avcodec_find_encoder(proxy_codec == IMB_PROXY_CODEC_MJPEG ? AV_CODEC_ID_MJPEG :
+                                                                          AV_CODEC_ID_H264);
 
   rv->c = avcodec_alloc_context3(rv->codec);
 
@@ -542,20 +549,30 @@ static struct proxy_output_ctx *alloc_proxy_output_ffmpeg(
   rv->c->time_base.num = 1;
   rv->st->time_base = rv->c->time_base;
 
-  /* This range matches #eFFMpegCrf. `crf_range_min` corresponds to lowest quality,
-   * `crf_range_max` to highest quality. */
-  const int crf_range_min = 32;
-  const int crf_range_max = 17;
-  int crf = round_fl_to_int((quality / 100.0f) * (crf_range_max - crf_range_min) + crf_range_min);
-
   AVDictionary *codec_opts = NULL;
-  /* High quality preset value. */
-  av_dict_set_int(&codec_opts, "crf", crf, 0);
-  /* Prefer smaller file-size. Presets from `veryslow` to `veryfast` produce output with very
-   * similar file-size, but there is big difference in performance.
-   * In some cases `veryfast` preset will produce smallest file-size. */
-  av_dict_set(&codec_opts, "preset", "veryfast", 0);
-  av_dict_set(&codec_opts, "tune", "fastdecode", 0);
+
+  if (proxy_codec == IMB_PROXY_CODEC_MJPEG) {
+    /* Every frame is a key frame, quality maps to the JPEG quantizer scale (2 is best). */
+    const int qscale = round_fl_to_int(31.0f - (quality / 100.0f) * 29.0f);
+    rv->c->flags |= AV_CODEC_FLAG_QSCALE;
+    rv->c->global_quality = FF_QP2LAMBDA * qscale;
+  }
+  else {
+    /* This range matches #eFFMpegCrf. `crf_range_min` corresponds to lowest quality,
+     * `crf_range_max` to highest quality. */
+    const int crf_range_min = 32;
+    const int crf_range_max = 17;
+    int crf = round_fl_to_int((quality / 100.0f) * (crf_range_max - crf_range_min) +
+                              crf_range_min);
+
+    /* High quality preset value. */
+    av_dict_set_int(&codec_opts, "crf", crf, 0);
+    /* Prefer smaller file-size. Presets from `veryslow` to `veryfast` produce output with very
+     * similar file-size, but there is big difference in performance.
+     * In some cases `veryfast` preset will produce smallest file-size. */
+    av_dict_set(&codec_opts, "preset", "veryfast", 0);
+    av_dict_set(&codec_opts, "tune", "fastdecode", 0);
+  }
 
   if (rv->codec->capabilities & AV_CODEC_CAP_AUTO_THREADS) {
     rv->c->thread_count = 0;
@@ -806,6 +823,7 @@ typedef struct FFmpegIndexBuilderContext {
 static IndexBuildContext *index_ffmpeg_create_context(struct anim *anim,
                                                       IMB_Timecode_Type tcs_in_use,
                                                       IMB_Proxy_Size proxy_sizes_in_use,
+                                                      IMB_Proxy_Codec proxy_codec,
                                                       int quality,
                                                       bool build_only_on_bad_performance)
 {
@@ -898,6 +916,7 @@ static IndexBuildContext *index_ffmpeg_create_context(struct anim *anim,
                                                         proxy_sizes[i],
                                                         context->iCodecCtx->width * proxy_fac[i],
                                                         context->iCodecCtx->height * proxy_fac[i],
+                                                        proxy_codec,
                                                         quality);
       if (!context->proxy_ctx[i]) {
         proxy_sizes_in_use &= ~proxy_sizes[i];
@@ -945,6 +964,19 @@ static void index_rebuild_ffmpeg_finish(FFmpegIndexBuilderContext *context, int
   MEM_freeN(context);
 }
 
+typedef struct ProxyOutputParallelData {
+  FFmpegIndexBuilderContext *context;
+  AVFrame *in_frame;
+} ProxyOutputParallelData;
+
+static void index_rebuild_ffmpeg_proxy_output_fn(void *__restrict userdata,
+                                                 const int i,
+                                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ProxyOutputParallelData *data = userdata;
+  add_to_proxy_output_ffmpeg(data->context->proxy_ctx[i], data->in_frame);
+}
+
 static void index_rebuild_ffmpeg_proc_decoded_frame(FFmpegIndexBuilderContext *context,
                                                     AVPacket *curr_packet,
                                                     AVFrame *in_frame)
@@ -955,10 +987,26 @@ static void index_rebuild_ffmpeg_proc_decoded_frame(FFmpegIndexBuilderContext *c
   uint64_t s_dts = context->seek_pos_dts;
   uint64_t pts = av_get_pts_from_frame(in_frame);
 
+  /* Each proxy size has its own scaler, encoder and output file, so the frame decoded once is
+   * scaled and encoded for all sizes at the same time. */
+  int num_proxies = 0;
   for (i = 0; i < context->num_proxy_sizes; i++) {
-    add_to_proxy_output_ffmpeg(context->proxy_ctx[i], in_frame);
+    if (context->proxy_ctx[i]) {
+      num_proxies++;
+    }
   }
 
+  ProxyOutputParallelData data = {
+      .context = context,
+      .in_frame = in_frame,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = num_proxies > 1;
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(
+      0, context->num_proxy_sizes, &data, index_rebuild_ffmpeg_proxy_output_fn, &settings);
+
   if (!context->start_pts_set) {
     context->start_pts = pts;
     context->start_pts_set = true;
@@ -1368,6 +1416,7 @@ static void index_rebuild_fallback(FallbackIndexBuilderContext *context,
 IndexBuildContext *IMB_anim_index_rebuild_context(struct anim *anim,
                                                   IMB_Timecode_Type tcs_in_use,
                                                   IMB_Proxy_Size proxy_sizes_in_use,
+                                                  IMB_Proxy_Codec proxy_codec,
                                                   int quality,
                                                   const bool overwrite,
                                                   GSet *file_list,
@@ -1425,11 +1474,15 @@ IndexBuildContext *IMB_anim_index_rebuild_context(struct anim *anim,
   switch (anim->curtype) {
 #ifdef WITH_FFMPEG
     case ANIM_FFMPEG:
-      context = index_ffmpeg_create_context(
-          anim, tcs_in_use, proxy_sizes_to_build, quality, build_only_on_bad_performance);
+      context = index_ffmpeg_create_context(anim,
+                                            tcs_in_use,
+                                            proxy_sizes_to_build,
+                                            proxy_codec,
+                                            quality,
+                                            build_only_on_bad_performance);
       break;
 #else
-    UNUSED_VARS(build_only_on_bad_performance);
+    UNUSED_VARS(build_only_on_bad_performance, proxy_codec);
 #endif
 
 #ifdef WITH_AVI
@@ -78,7 +78,9 @@ _CRTIMP void __cdecl _invalid_parameter_noinfo(void)
 }
 #include "BLI_blenlib.h"
 #include "BLI_math_color.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
+#include "BLI_vector.hh"
 
 #include "BKE_idprop.h"
 #include "BKE_image.h"
@@ -1096,6 +1098,14 @@ void IMB_exr_clear_channels(void *handle)
   BLI_freelistN(&data->channels);
 }
 
+/* Half float channels are converted and written in blocks of scan-lines, so the temporary
+ * half buffer doesn't have to hold every channel of the whole image at once (a multi-layer 8K
+ * render easily has more than a hundred channels). */
+#define EXR_WRITE_BLOCK_MAX_BYTES (128 << 20)
+/* Enough scan-lines per #OutputFile::writePixels call for OpenEXR to compress several line
+ * blocks in parallel, DWA uses blocks of 256 lines. */
+#define EXR_WRITE_BLOCK_MIN_LINES 256
+
 void IMB_exr_write_channels(void *handle)
 {
   ExrHandle *data = (ExrHandle *)handle;
@@ -1103,32 +1113,17 @@ void IMB_exr_write_channels(void *handle)
   ExrChannel *echan;
 
   if (data->channels.first) {
-    const size_t num_pixels = ((size_t)data->width) * data->height;
-    half *rect_half = nullptr, *current_rect_half = nullptr;
-
-    /* We allocate temporary storage for half pixels for all the channels at once. */
-    if (data->num_half_channels != 0) {
-      rect_half = (half *)MEM_mallocN(sizeof(half) * data->num_half_channels * num_pixels,
-                                      __func__);
-      current_rect_half = rect_half;
-    }
+    const int width = data->width;
+    const int height = data->height;
+    blender::Vector<ExrChannel *> half_channels;
 
     for (echan = (ExrChannel *)data->channels.first; echan; echan = echan->next) {
-      /* Writing starts from last scan-line, stride negative. */
       if (echan->use_half_float) {
-        float *rect = echan->rect;
-        half *cur = current_rect_half;
-        for (size_t i = 0; i < num_pixels; i++, cur++) {
-          *cur = float_to_half_safe(rect[i * echan->xstride]);
-        }
-        half *rect_to_write = current_rect_half + (data->height - 1L) * data->width;
-        frameBuffer.insert(
-            echan->name,
-            Slice(Imf::HALF, (char *)rect_to_write, sizeof(half), -data->width * sizeof(half)));
-        current_rect_half += num_pixels;
+        half_channels.append(echan);
       }
       else {
-        float *rect = echan->rect + echan->xstride * (data->height - 1L) * data->width;
+        /* Writing starts from last scan-line, stride negative. */
+        float *rect = echan->rect + echan->xstride * (height - 1L) * width;
         frameBuffer.insert(echan->name,
                            Slice(Imf::FLOAT,
                                  (char *)rect,
@@ -1137,9 +1132,52 @@ void IMB_exr_write_channels(void *handle)
       }
     }
 
-    data->ofile->setFrameBuffer(frameBuffer);
+    int block_height = height;
+    half *rect_half = nullptr;
+
+    if (!half_channels.is_empty()) {
+      const size_t line_size = sizeof(half) * half_channels.size() * width;
+      block_height = clamp_i(
+          (int)(EXR_WRITE_BLOCK_MAX_BYTES / line_size), EXR_WRITE_BLOCK_MIN_LINES, height);
+      rect_half = (half *)MEM_mallocN(line_size * block_height, __func__);
+    }
+
     try {
-      data->ofile->writePixels(data->height);
+      for (int y_start = 0; y_start < height; y_start += block_height) {
+        const int block_lines = min_ii(block_height, height - y_start);
+        FrameBuffer blockFrameBuffer = frameBuffer;
+
+        /* Convert the block for all half channels, flipping to the file's top-down order. */
+        blender::threading::parallel_for(
+            blender::IndexRange(half_channels.size() * block_lines),
+            16,
+            [&](const blender::IndexRange range) {
+              for (const int64_t i : range) {
+                const int64_t chan_index = i / block_lines;
+                const int line = i % block_lines;
+                const ExrChannel *chan = half_channels[chan_index];
+                const size_t blender_line = height - 1L - (y_start + line);
+                const float *from = chan->rect + chan->xstride * blender_line * width;
+                half *to = rect_half + ((size_t)chan_index * block_height + line) * width;
+                for (int x = 0; x < width; x++) {
+                  to[x] = float_to_half_safe(from[x * chan->xstride]);
+                }
+              }
+            });
+
+        for (const int64_t i : half_channels.index_range()) {
+          /* Offset so that the file's scan-line `y_start` maps to the first line of the block. */
+          half *block_rect = rect_half + (size_t)i * block_height * width;
+          blockFrameBuffer.insert(half_channels[i]->name,
+                                  Slice(Imf::HALF,
+                                        (char *)(block_rect - (size_t)y_start * width),
+                                        sizeof(half),
+                                        width * sizeof(half)));
+        }
+
+        data->ofile->setFrameBuffer(blockFrameBuffer);
+        data->ofile->writePixels(block_lines);
+      }
     }
     catch (const std::exception &exc) {
       std::cerr << "OpenEXR-writePixels: ERROR: " << exc.what() << std::endl;
@@ -9,6 +9,7 @@
 
 #include "BLI_math_color.h"
 #include "BLI_math_interp.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 #include "MEM_guardedalloc.h"
 
@@ -890,21 +891,145 @@ static bool q_scale_linear_interpolation(struct ImBuf *ibuf, int newx, int newy)
   return true;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Box/Linear Scaling
+ *
+ * Each pass scales along one axis. Rows (for X) and columns (for Y) are independent of each
+ * other so they are processed in parallel, the per line logic is unchanged.
+ * \{ */
+
+/** Below this number of source pixels scaling is done on the calling thread. */
+#define SCALE_PARALLEL_MIN_PIXELS (64 * 64)
+
+typedef struct ScaleParallelData {
+  const ImBuf *ibuf;
+  /** Destination buffers, NULL when the source buffer of that type doesn't exist. */
+  uchar *newrect;
+  float *newrectf;
+  /** New width for X passes, new height for Y passes. */
+  int newsize;
+  float add;
+} ScaleParallelData;
+
+static void scale_parallel_range(const ImBuf *ibuf,
+                                 const int tot,
+                                 ScaleParallelData *data,
+                                 TaskParallelRangeFunc func)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = ((size_t)ibuf->x * ibuf->y > SCALE_PARALLEL_MIN_PIXELS);
+  BLI_task_parallel_range(0, tot, data, func, &settings);
+}
+
+static void scaledownx_line(void *__restrict userdata,
+                            const int y,
+                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ScaleParallelData *data = userdata;
+  const ImBuf *ibuf = data->ibuf;
+  const int newx = data->newsize;
+  const float add = data->add;
+  const bool do_rect = (data->newrect != NULL);
+  const bool do_float = (data->newrectf != NULL);
+
+  const uchar *rect = NULL, *rect_start = NULL;
+  const float *rectf = NULL, *rectf_start = NULL;
+  uchar *newrect = NULL;
+  float *newrectf = NULL;
+  float sample = 0.0f;
+  float val[4] = {0.0f}, nval[4] = {0.0f}, valf[4] = {0.0f}, nvalf[4] = {0.0f};
+
+  if (do_rect) {
+    rect = rect_start = (const uchar *)ibuf->rect + (size_t)4 * ibuf->x * y;
+    newrect = data->newrect + (size_t)4 * newx * y;
+  }
+  if (do_float) {
+    rectf = rectf_start = ibuf->rect_float + (size_t)4 * ibuf->x * y;
+    newrectf = data->newrectf + (size_t)4 * newx * y;
+  }
+
+  for (int x = newx; x > 0; x--) {
+    if (do_rect) {
+      nval[0] = -val[0] * sample;
+      nval[1] = -val[1] * sample;
+      nval[2] = -val[2] * sample;
+      nval[3] = -val[3] * sample;
+    }
+    if (do_float) {
+      nvalf[0] = -valf[0] * sample;
+      nvalf[1] = -valf[1] * sample;
+      nvalf[2] = -valf[2] * sample;
+      nvalf[3] = -valf[3] * sample;
+    }
+
+    sample += add;
+
+    while (sample >= 1.0f) {
+      sample -= 1.0f;
+
+      if (do_rect) {
+        nval[0] += rect[0];
+        nval[1] += rect[1];
+        nval[2] += rect[2];
+        nval[3] += rect[3];
+        rect += 4;
+      }
+      if (do_float) {
+        nvalf[0] += rectf[0];
+        nvalf[1] += rectf[1];
+        nvalf[2] += rectf[2];
+        nvalf[3] += rectf[3];
+        rectf += 4;
+      }
+    }
+
+    if (do_rect) {
+      val[0] = rect[0];
+      val[1] = rect[1];
+      val[2] = rect[2];
+      val[3] = rect[3];
+      rect += 4;
+
+      newrect[0] = roundf((nval[0] + sample * val[0]) / add);
+      newrect[1] = roundf((nval[1] + sample * val[1]) / add);
+      newrect[2] = roundf((nval[2] + sample * val[2]) / add);
+      newrect[3] = roundf((nval[3] + sample * val[3]) / add);
+
+      newrect += 4;
+    }
+    if (do_float) {
+
+      valf[0] = rectf[0];
+      valf[1] = rectf[1];
+      valf[2] = rectf[2];
+      valf[3] = rectf[3];
+      rectf += 4;
+
+      newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
+      newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
+      newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
+      newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
+
+      newrectf += 4;
+    }
+
+    sample -= 1.0f;
+  }
+
+  /* Every line must consume exactly one source line, see bug T26502. */
+  BLI_assert(!do_rect || (rect - rect_start == (ptrdiff_t)4 * ibuf->x));
+  BLI_assert(!do_float || (rectf - rectf_start == (ptrdiff_t)4 * ibuf->x));
+  UNUSED_VARS_NDEBUG(rect_start, rectf_start);
+}
+
 static ImBuf *scaledownx(struct ImBuf *ibuf, int newx)
 {
   const int do_rect = (ibuf->rect != NULL);
   const int do_float = (ibuf->rect_float != NULL);
-  const size_t rect_size = IMB_get_rect_len(ibuf) * 4;
-
-  uchar *rect, *_newrect, *newrect;
-  float *rectf, *_newrectf, *newrectf;
-  float sample, add, val[4], nval[4], valf[4], nvalf[4];
-  int x, y;
 
-  rectf = _newrectf = newrectf = NULL;
-  rect = _newrect = newrect = NULL;
-  nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
-  nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
+  uchar *_newrect = NULL;
+  float *_newrectf = NULL;
 
   if (!do_rect && !do_float) {
     return ibuf;
@@ -926,126 +1051,139 @@ static ImBuf *scaledownx(struct ImBuf *ibuf, int newx)
     }
   }
 
-  add = (ibuf->x - 0.01) / newx;
+  ScaleParallelData data = {
+      .ibuf = ibuf,
+      .newrect = _newrect,
+      .newrectf = _newrectf,
+      .newsize = newx,
+      .add = (ibuf->x - 0.01) / newx,
+  };
+  scale_parallel_range(ibuf, ibuf->y, &data, scaledownx_line);
 
   if (do_rect) {
-    rect = (uchar *)ibuf->rect;
-    newrect = _newrect;
+    imb_freerectImBuf(ibuf);
+    ibuf->mall |= IB_rect;
+    ibuf->rect = (unsigned int *)_newrect;
   }
   if (do_float) {
-    rectf = ibuf->rect_float;
-    newrectf = _newrectf;
+    imb_freerectfloatImBuf(ibuf);
+    ibuf->mall |= IB_rectfloat;
+    ibuf->rect_float = _newrectf;
   }
 
-  for (y = ibuf->y; y > 0; y--) {
-    sample = 0.0f;
-    val[0] = val[1] = val[2] = val[3] = 0.0f;
-    valf[0] = valf[1] = valf[2] = valf[3] = 0.0f;
-
-    for (x = newx; x > 0; x--) {
-      if (do_rect) {
-        nval[0] = -val[0] * sample;
-        nval[1] = -val[1] * sample;
-        nval[2] = -val[2] * sample;
-        nval[3] = -val[3] * sample;
-      }
-      if (do_float) {
-        nvalf[0] = -valf[0] * sample;
-        nvalf[1] = -valf[1] * sample;
-        nvalf[2] = -valf[2] * sample;
-        nvalf[3] = -valf[3] * sample;
-      }
+  ibuf->x = newx;
+  return ibuf;
+}
 
-      sample += add;
+static void scaledowny_column(void *__restrict userdata,
+                              const int x,
+                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ScaleParallelData *data = userdata;
+  const ImBuf *ibuf = data->ibuf;
+  const int newy = data->newsize;
+  const float add = data->add;
+  const int skipx = 4 * ibuf->x;
+  const bool do_rect = (data->newrect != NULL);
+  const bool do_float = (data->newrectf != NULL);
+
+  const uchar *rect = NULL, *rect_start = NULL;
+  const float *rectf = NULL, *rectf_start = NULL;
+  uchar *newrect = NULL;
+  float *newrectf = NULL;
+  float sample = 0.0f;
+  float val[4] = {0.0f}, nval[4] = {0.0f}, valf[4] = {0.0f}, nvalf[4] = {0.0f};
 
-      while (sample >= 1.0f) {
-        sample -= 1.0f;
+  if (do_rect) {
+    rect = rect_start = (const uchar *)ibuf->rect + 4 * x;
+    newrect = data->newrect + 4 * x;
+  }
+  if (do_float) {
+    rectf = rectf_start = ibuf->rect_float + 4 * x;
+    newrectf = data->newrectf + 4 * x;
+  }
 
-        if (do_rect) {
-          nval[0] += rect[0];
-          nval[1] += rect[1];
-          nval[2] += rect[2];
-          nval[3] += rect[3];
-          rect += 4;
-        }
-        if (do_float) {
-          nvalf[0] += rectf[0];
-          nvalf[1] += rectf[1];
-          nvalf[2] += rectf[2];
-          nvalf[3] += rectf[3];
-          rectf += 4;
-        }
-      }
+  for (int y = newy; y > 0; y--) {
+    if (do_rect) {
+      nval[0] = -val[0] * sample;
+      nval[1] = -val[1] * sample;
+      nval[2] = -val[2] * sample;
+      nval[3] = -val[3] * sample;
+    }
+    if (do_float) {
+      nvalf[0] = -valf[0] * sample;
+      nvalf[1] = -valf[1] * sample;
+      nvalf[2] = -valf[2] * sample;
+      nvalf[3] = -valf[3] * sample;
+    }
 
-      if (do_rect) {
-        val[0] = rect[0];
-        val[1] = rect[1];
-        val[2] = rect[2];
-        val[3] = rect[3];
-        rect += 4;
+    sample += add;
 
-        newrect[0] = roundf((nval[0] + sample * val[0]) / add);
-        newrect[1] = roundf((nval[1] + sample * val[1]) / add);
-        newrect[2] = roundf((nval[2] + sample * val[2]) / add);
-        newrect[3] = roundf((nval[3] + sample * val[3]) / add);
+    while (sample >= 1.0f) {
+      sample -= 1.0f;
 
-        newrect += 4;
+      if (do_rect) {
+        nval[0] += rect[0];
+        nval[1] += rect[1];
+        nval[2] += rect[2];
+        nval[3] += rect[3];
+        rect += skipx;
       }
       if (do_float) {
+        nvalf[0] += rectf[0];
+        nvalf[1] += rectf[1];
+        nvalf[2] += rectf[2];
+        nvalf[3] += rectf[3];
+        rectf += skipx;
+      }
+    }
 
-        valf[0] = rectf[0];
-        valf[1] = rectf[1];
-        valf[2] = rectf[2];
-        valf[3] = rectf[3];
-        rectf += 4;
+    if (do_rect) {
+      val[0] = rect[0];
+      val[1] = rect[1];
+      val[2] = rect[2];
+      val[3] = rect[3];
+      rect += skipx;
+
+      newrect[0] = roundf((nval[0] + sample * val[0]) / add);
+      newrect[1] = roundf((nval[1] + sample * val[1]) / add);
+      newrect[2] = roundf((nval[2] + sample * val[2]) / add);
+      newrect[3] = roundf((nval[3] + sample * val[3]) / add);
+
+      newrect += skipx;
+    }
+    if (do_float) {
 
-        newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
-        newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
-        newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
-        newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
+      valf[0] = rectf[0];
+      valf[1] = rectf[1];
+      valf[2] = rectf[2];
+      valf[3] = rectf[3];
+      rectf += skipx;
 
-        newrectf += 4;
-      }
+      newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
+      newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
+      newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
+      newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
 
-      sample -= 1.0f;
+      newrectf += skipx;
     }
-  }
 
-  if (do_rect) {
-    // printf("%ld %ld\n", (uchar *)rect - ((uchar *)ibuf->rect), rect_size);
-    BLI_assert((uchar *)rect - ((uchar *)ibuf->rect) == rect_size); /* see bug T26502. */
-    imb_freerectImBuf(ibuf);
-    ibuf->mall |= IB_rect;
-    ibuf->rect = (unsigned int *)_newrect;
-  }
-  if (do_float) {
-    // printf("%ld %ld\n", rectf - ibuf->rect_float, rect_size);
-    BLI_assert((rectf - ibuf->rect_float) == rect_size); /* see bug T26502. */
-    imb_freerectfloatImBuf(ibuf);
-    ibuf->mall |= IB_rectfloat;
-    ibuf->rect_float = _newrectf;
+    sample -= 1.0f;
   }
-  (void)rect_size; /* UNUSED in release builds */
 
-  ibuf->x = newx;
-  return ibuf;
+  /* Every column must consume exactly one source column, see bug T26502. */
+  BLI_assert(!do_rect || (rect - rect_start == (ptrdiff_t)skipx * ibuf->y));
+  BLI_assert(!do_float || (rectf - rectf_start == (ptrdiff_t)skipx * ibuf->y));
+  UNUSED_VARS_NDEBUG(rect_start, rectf_start);
 }
 
 static ImBuf *scaledowny(struct ImBuf *ibuf, int newy)
 {
   const int do_rect = (ibuf->rect != NULL);
   const int do_float = (ibuf->rect_float != NULL);
-  const size_t rect_size = IMB_get_rect_len(ibuf) * 4;
 
-  uchar *rect, *_newrect, *newrect;
-  float *rectf, *_newrectf, *newrectf;
-  float sample, add, val[4], nval[4], valf[4], nvalf[4];
-  int x, y, skipx;
-
-  rectf = _newrectf = newrectf = NULL;
-  rect = _newrect = newrect = NULL;
-  nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
-  nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
+  uchar *_newrect = NULL;
+  float *_newrectf = NULL;
 
   if (!do_rect && !do_float) {
     return ibuf;
@@ -1067,110 +1205,174 @@ static ImBuf *scaledowny(struct ImBuf *ibuf, int newy)
     }
   }
 
-  add = (ibuf->y - 0.01) / newy;
-  skipx = 4 * ibuf->x;
-
-  for (x = skipx - 4; x >= 0; x -= 4) {
-    if (do_rect) {
-      rect = ((uchar *)ibuf->rect) + x;
-      newrect = _newrect + x;
-    }
-    if (do_float) {
-      rectf = ibuf->rect_float + x;
-      newrectf = _newrectf + x;
-    }
-
-    sample = 0.0f;
-    val[0] = val[1] = val[2] = val[3] = 0.0f;
-    valf[0] = valf[1] = valf[2] = valf[3] = 0.0f;
+  ScaleParallelData data = {
+      .ibuf = ibuf,
+      .newrect = _newrect,
+      .newrectf = _newrectf,
+      .newsize = newy,
+      .add = (ibuf->y - 0.01) / newy,
+  };
+  scale_parallel_range(ibuf, ibuf->x, &data, scaledowny_column);
 
-    for (y = newy; y > 0; y--) {
-      if (do_rect) {
-        nval[0] = -val[0] * sample;
-        nval[1] = -val[1] * sample;
-        nval[2] = -val[2] * sample;
-        nval[3] = -val[3] * sample;
-      }
-      if (do_float) {
-        nvalf[0] = -valf[0] * sample;
-        nvalf[1] = -valf[1] * sample;
-        nvalf[2] = -valf[2] * sample;
-        nvalf[3] = -valf[3] * sample;
-      }
+  if (do_rect) {
+    imb_freerectImBuf(ibuf);
+    ibuf->mall |= IB_rect;
+    ibuf->rect = (unsigned int *)_newrect;
+  }
+  if (do_float) {
+    imb_freerectfloatImBuf(ibuf);
+    ibuf->mall |= IB_rectfloat;
+    ibuf->rect_float = (float *)_newrectf;
+  }
 
-      sample += add;
+  ibuf->y = newy;
+  return ibuf;
+}
 
-      while (sample >= 1.0f) {
-        sample -= 1.0f;
+/**
+ * Linear interpolation along a single line of pixels, shared by #scaleupx and #scaleupy.
+ * `stride` is the distance in channels between two neighboring source and destination pixels.
+ */
+static void scaleup_line(const uchar *rect,
+                         const float *rectf,
+                         uchar *newrect,
+                         float *newrectf,
+                         const int stride,
+                         const int newsize,
+                         const float add)
+{
+  float sample = 0;
+
+  float val_a = 0, nval_a = 0, diff_a = 0;
+  float val_b = 0, nval_b = 0, diff_b = 0;
+  float val_g = 0, nval_g = 0, diff_g = 0;
+  float val_r = 0, nval_r = 0, diff_r = 0;
+  float val_af = 0, nval_af = 0, diff_af = 0;
+  float val_bf = 0, nval_bf = 0, diff_bf = 0;
+  float val_gf = 0, nval_gf = 0, diff_gf = 0;
+  float val_rf = 0, nval_rf = 0, diff_rf = 0;
+
+  if (newrect) {
+    val_a = rect[0];
+    nval_a = rect[stride];
+    diff_a = nval_a - val_a;
+    val_a += 0.5f;
+
+    val_b = rect[1];
+    nval_b = rect[stride + 1];
+    diff_b = nval_b - val_b;
+    val_b += 0.5f;
+
+    val_g = rect[2];
+    nval_g = rect[stride + 2];
+    diff_g = nval_g - val_g;
+    val_g += 0.5f;
+
+    val_r = rect[3];
+    nval_r = rect[stride + 3];
+    diff_r = nval_r - val_r;
+    val_r += 0.5f;
+
+    rect += 2 * stride;
+  }
+  if (newrectf) {
+    val_af = rectf[0];
+    nval_af = rectf[stride];
+    diff_af = nval_af - val_af;
+
+    val_bf = rectf[1];
+    nval_bf = rectf[stride + 1];
+    diff_bf = nval_bf - val_bf;
+
+    val_gf = rectf[2];
+    nval_gf = rectf[stride + 2];
+    diff_gf = nval_gf - val_gf;
+
+    val_rf = rectf[3];
+    nval_rf = rectf[stride + 3];
+    diff_rf = nval_rf - val_rf;
+
+    rectf += 2 * stride;
+  }
+
+  for (int i = newsize; i > 0; i--) {
+    if (sample >= 1.0f) {
+      sample -= 1.0f;
 
-        if (do_rect) {
-          nval[0] += rect[0];
-          nval[1] += rect[1];
-          nval[2] += rect[2];
-          nval[3] += rect[3];
-          rect += skipx;
-        }
-        if (do_float) {
-          nvalf[0] += rectf[0];
-          nvalf[1] += rectf[1];
-          nvalf[2] += rectf[2];
-          nvalf[3] += rectf[3];
-          rectf += skipx;
-        }
-      }
+      if (newrect) {
+        val_a = nval_a;
+        nval_a = rect[0];
+        diff_a = nval_a - val_a;
+        val_a += 0.5f;
 
-      if (do_rect) {
-        val[0] = rect[0];
-        val[1] = rect[1];
-        val[2] = rect[2];
-        val[3] = rect[3];
-        rect += skipx;
+        val_b = nval_b;
+        nval_b = rect[1];
+        diff_b = nval_b - val_b;
+        val_b += 0.5f;
 
-        newrect[0] = roundf((nval[0] + sample * val[0]) / add);
-        newrect[1] = roundf((nval[1] + sample * val[1]) / add);
-        newrect[2] = roundf((nval[2] + sample * val[2]) / add);
-        newrect[3] = roundf((nval[3] + sample * val[3]) / add);
+        val_g = nval_g;
+        nval_g = rect[2];
+        diff_g = nval_g - val_g;
+        val_g += 0.5f;
 
-        newrect += skipx;
+        val_r = nval_r;
+        nval_r = rect[3];
+        diff_r = nval_r - val_r;
+        val_r += 0.5f;
+        rect += stride;
       }
-      if (do_float) {
+      if (newrectf) {
+        val_af = nval_af;
+        nval_af = rectf[0];
+        diff_af = nval_af - val_af;
 
-        valf[0] = rectf[0];
-        valf[1] = rectf[1];
-        valf[2] = rectf[2];
-        valf[3] = rectf[3];
-        rectf += skipx;
+        val_bf = nval_bf;
+        nval_bf = rectf[1];
+        diff_bf = nval_bf - val_bf;
 
-        newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
-        newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
-        newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
-        newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
+        val_gf = nval_gf;
+        nval_gf = rectf[2];
+        diff_gf = nval_gf - val_gf;
 
-        newrectf += skipx;
+        val_rf = nval_rf;
+        nval_rf = rectf[3];
+        diff_rf = nval_rf - val_rf;
+        rectf += stride;
       }
-
-      sample -= 1.0f;
     }
+    if (newrect) {
+      newrect[0] = val_a + sample * diff_a;
+      newrect[1] = val_b + sample * diff_b;
+      newrect[2] = val_g + sample * diff_g;
+      newrect[3] = val_r + sample * diff_r;
+      newrect += stride;
+    }
+    if (newrectf) {
+      newrectf[0] = val_af + sample * diff_af;
+      newrectf[1] = val_bf + sample * diff_bf;
+      newrectf[2] = val_gf + sample * diff_gf;
+      newrectf[3] = val_rf + sample * diff_rf;
+      newrectf += stride;
+    }
+    sample += add;
   }
+}
 
-  if (do_rect) {
-    // printf("%ld %ld\n", (uchar *)rect - ((uchar *)ibuf->rect), rect_size);
-    BLI_assert((uchar *)rect - ((uchar *)ibuf->rect) == rect_size); /* see bug T26502. */
-    imb_freerectImBuf(ibuf);
-    ibuf->mall |= IB_rect;
-    ibuf->rect = (unsigned int *)_newrect;
-  }
-  if (do_float) {
-    // printf("%ld %ld\n", rectf - ibuf->rect_float, rect_size);
-    BLI_assert((rectf - ibuf->rect_float) == rect_size); /* see bug T26502. */
-    imb_freerectfloatImBuf(ibuf);
-    ibuf->mall |= IB_rectfloat;
-    ibuf->rect_float = (float *)_newrectf;
-  }
-  (void)rect_size; /* UNUSED in release builds */
-
-  ibuf->y = newy;
-  return ibuf;
+static void scaleupx_line(void *__restrict userdata,
+                          const int y,
+                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ScaleParallelData *data = userdata;
+  const ImBuf *ibuf = data->ibuf;
+  const int newx = data->newsize;
+
+  scaleup_line(data->newrect ? (const uchar *)ibuf->rect + (size_t)4 * ibuf->x * y : NULL,
+               data->newrectf ? ibuf->rect_float + (size_t)4 * ibuf->x * y : NULL,
+               data->newrect ? data->newrect + (size_t)4 * newx * y : NULL,
+               data->newrectf ? data->newrectf + (size_t)4 * newx * y : NULL,
+               4,
+               newx,
+               data->add);
 }
 
 static ImBuf *scaleupx(struct ImBuf *ibuf, int newx)
@@ -1233,131 +1435,14 @@ static ImBuf *scaleupx(struct ImBuf *ibuf, int newx)
     }
   }
   else {
-    const float add = (ibuf->x - 1.001) / (newx - 1.0);
-    float sample;
-
-    float val_a, nval_a, diff_a;
-    float val_b, nval_b, diff_b;
-    float val_g, nval_g, diff_g;
-    float val_r, nval_r, diff_r;
-    float val_af, nval_af, diff_af;
-    float val_bf, nval_bf, diff_bf;
-    float val_gf, nval_gf, diff_gf;
-    float val_rf, nval_rf, diff_rf;
-
-    val_a = nval_a = diff_a = val_b = nval_b = diff_b = 0;
-    val_g = nval_g = diff_g = val_r = nval_r = diff_r = 0;
-    val_af = nval_af = diff_af = val_bf = nval_bf = diff_bf = 0;
-    val_gf = nval_gf = diff_gf = val_rf = nval_rf = diff_rf = 0;
-
-    for (y = ibuf->y; y > 0; y--) {
-
-      sample = 0;
-
-      if (do_rect) {
-        val_a = rect[0];
-        nval_a = rect[4];
-        diff_a = nval_a - val_a;
-        val_a += 0.5f;
-
-        val_b = rect[1];
-        nval_b = rect[5];
-        diff_b = nval_b - val_b;
-        val_b += 0.5f;
-
-        val_g = rect[2];
-        nval_g = rect[6];
-        diff_g = nval_g - val_g;
-        val_g += 0.5f;
-
-        val_r = rect[3];
-        nval_r = rect[7];
-        diff_r = nval_r - val_r;
-        val_r += 0.5f;
-
-        rect += 8;
-      }
-      if (do_float) {
-        val_af = rectf[0];
-        nval_af = rectf[4];
-        diff_af = nval_af - val_af;
-
-        val_bf = rectf[1];
-        nval_bf = rectf[5];
-        diff_bf = nval_bf - val_bf;
-
-        val_gf = rectf[2];
-        nval_gf = rectf[6];
-        diff_gf = nval_gf - val_gf;
-
-        val_rf = rectf[3];
-        nval_rf = rectf[7];
-        diff_rf = nval_rf - val_rf;
-
-        rectf += 8;
-      }
-      for (x = newx; x > 0; x--) {
-        if (sample >= 1.0f) {
-          sample -= 1.0f;
-
-          if (do_rect) {
-            val_a = nval_a;
-            nval_a = rect[0];
-            diff_a = nval_a - val_a;
-            val_a += 0.5f;
-
-            val_b = nval_b;
-            nval_b = rect[1];
-            diff_b = nval_b - val_b;
-            val_b += 0.5f;
-
-            val_g = nval_g;
-            nval_g = rect[2];
-            diff_g = nval_g - val_g;
-            val_g += 0.5f;
-
-            val_r = nval_r;
-            nval_r = rect[3];
-            diff_r = nval_r - val_r;
-            val_r += 0.5f;
-            rect += 4;
-          }
-          if (do_float) {
-            val_af = nval_af;
-            nval_af = rectf[0];
-            diff_af = nval_af - val_af;
-
-            val_bf = nval_bf;
-            nval_bf = rectf[1];
-            diff_bf = nval_bf - val_bf;
-
-            val_gf = nval_gf;
-            nval_gf = rectf[2];
-            diff_gf = nval_gf - val_gf;
-
-            val_rf = nval_rf;
-            nval_rf = rectf[3];
-            diff_rf = nval_rf - val_rf;
-            rectf += 4;
-          }
-        }
-        if (do_rect) {
-          newrect[0] = val_a + sample * diff_a;
-          newrect[1] = val_b + sample * diff_b;
-          newrect[2] = val_g + sample * diff_g;
-          newrect[3] = val_r + sample * diff_r;
-          newrect += 4;
-        }
-        if (do_float) {
-          newrectf[0] = val_af + sample * diff_af;
-          newrectf[1] = val_bf + sample * diff_bf;
-          newrectf[2] = val_gf + sample * diff_gf;
-          newrectf[3] = val_rf + sample * diff_rf;
-          newrectf += 4;
-        }
-        sample += add;
-      }
-    }
+    ScaleParallelData data = {
+        .ibuf = ibuf,
+        .newrect = _newrect,
+        .newrectf = _newrectf,
+        .newsize = newx,
+        .add = (ibuf->x - 1.001) / (newx - 1.0),
+    };
+    scale_parallel_range(ibuf, ibuf->y, &data, scaleupx_line);
   }
 
   if (do_rect) {
@@ -1375,11 +1460,27 @@ static ImBuf *scaleupx(struct ImBuf *ibuf, int newx)
   return ibuf;
 }
 
+static void scaleupy_column(void *__restrict userdata,
+                            const int x,
+                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ScaleParallelData *data = userdata;
+  const ImBuf *ibuf = data->ibuf;
+
+  scaleup_line(data->newrect ? (const uchar *)ibuf->rect + 4 * x : NULL,
+               data->newrectf ? ibuf->rect_float + 4 * x : NULL,
+               data->newrect ? data->newrect + 4 * x : NULL,
+               data->newrectf ? data->newrectf + 4 * x : NULL,
+               4 * ibuf->x,
+               data->newsize,
+               data->add);
+}
+
 static ImBuf *scaleupy(struct ImBuf *ibuf, int newy)
 {
   uchar *rect, *_newrect = NULL, *newrect;
   float *rectf, *_newrectf = NULL, *newrectf;
-  int x, y, skipx;
+  int y, skipx;
   bool do_rect = false, do_float = false;
 
   if (ibuf == NULL) {
@@ -1431,136 +1532,14 @@ static ImBuf *scaleupy(struct ImBuf *ibuf, int newy)
     }
   }
   else {
-    const float add = (ibuf->y - 1.001) / (newy - 1.0);
-    float sample;
-
-    float val_a, nval_a, diff_a;
-    float val_b, nval_b, diff_b;
-    float val_g, nval_g, diff_g;
-    float val_r, nval_r, diff_r;
-    float val_af, nval_af, diff_af;
-    float val_bf, nval_bf, diff_bf;
-    float val_gf, nval_gf, diff_gf;
-    float val_rf, nval_rf, diff_rf;
-
-    val_a = nval_a = diff_a = val_b = nval_b = diff_b = 0;
-    val_g = nval_g = diff_g = val_r = nval_r = diff_r = 0;
-    val_af = nval_af = diff_af = val_bf = nval_bf = diff_bf = 0;
-    val_gf = nval_gf = diff_gf = val_rf = nval_rf = diff_rf = 0;
-
-    for (x = ibuf->x; x > 0; x--) {
-      sample = 0;
-      if (do_rect) {
-        rect = ((uchar *)ibuf->rect) + 4 * (x - 1);
-        newrect = _newrect + 4 * (x - 1);
-
-        val_a = rect[0];
-        nval_a = rect[skipx];
-        diff_a = nval_a - val_a;
-        val_a += 0.5f;
-
-        val_b = rect[1];
-        nval_b = rect[skipx + 1];
-        diff_b = nval_b - val_b;
-        val_b += 0.5f;
-
-        val_g = rect[2];
-        nval_g = rect[skipx + 2];
-        diff_g = nval_g - val_g;
-        val_g += 0.5f;
-
-        val_r = rect[3];
-        nval_r = rect[skipx + 3];
-        diff_r = nval_r - val_r;
-        val_r += 0.5f;
-
-        rect += 2 * skipx;
-      }
-      if (do_float) {
-        rectf = ibuf->rect_float + 4 * (x - 1);
-        newrectf = _newrectf + 4 * (x - 1);
-
-        val_af = rectf[0];
-        nval_af = rectf[skipx];
-        diff_af = nval_af - val_af;
-
-        val_bf = rectf[1];
-        nval_bf = rectf[skipx + 1];
-        diff_bf = nval_bf - val_bf;
-
-        val_gf = rectf[2];
-        nval_gf = rectf[skipx + 2];
-        diff_gf = nval_gf - val_gf;
-
-        val_rf = rectf[3];
-        nval_rf = rectf[skipx + 3];
-        diff_rf = nval_rf - val_rf;
-
-        rectf += 2 * skipx;
-      }
-
-      for (y = newy; y > 0; y--) {
-        if (sample >= 1.0f) {
-          sample -= 1.0f;
-
-          if (do_rect) {
-            val_a = nval_a;
-            nval_a = rect[0];
-            diff_a = nval_a - val_a;
-            val_a += 0.5f;
-
-            val_b = nval_b;
-            nval_b = rect[1];
-            diff_b = nval_b - val_b;
-            val_b += 0.5f;
-
-            val_g = nval_g;
-            nval_g = rect[2];
-            diff_g = nval_g - val_g;
-            val_g += 0.5f;
-
-            val_r = nval_r;
-            nval_r = rect[3];
-            diff_r = nval_r - val_r;
-            val_r += 0.5f;
-            rect += skipx;
-          }
-          if (do_float) {
-            val_af = nval_af;
-            nval_af = rectf[0];
-            diff_af = nval_af - val_af;
-
-            val_bf = nval_bf;
-            nval_bf = rectf[1];
-            diff_bf = nval_bf - val_bf;
-
-            val_gf = nval_gf;
-            nval_gf = rectf[2];
-            diff_gf = nval_gf - val_gf;
-
-            val_rf = nval_rf;
-            nval_rf = rectf[3];
-            diff_rf = nval_rf - val_rf;
-            rectf += skipx;
-          }
-        }
-        if (do_rect) {
-          newrect[0] = val_a + sample * diff_a;
-          newrect[1] = val_b + sample * diff_b;
-          newrect[2] = val_g + sample * diff_g;
-          newrect[3] = val_r + sample * diff_r;
-          newrect += skipx;
-        }
-        if (do_float) {
-          newrectf[0] = val_af + sample * diff_af;
-          newrectf[1] = val_bf + sample * diff_bf;
-          newrectf[2] = val_gf + sample * diff_gf;
-          newrectf[3] = val_rf + sample * diff_rf;
-          newrectf += skipx;
-        }
-        sample += add;
-      }
-    }
+    ScaleParallelData data = {
+        .ibuf = ibuf,
+        .newrect = _newrect,
+        .newrectf = _newrectf,
+        .newsize = newy,
+        .add = (ibuf->y - 1.001) / (newy - 1.0),
+    };
+    scale_parallel_range(ibuf, ibuf->x, &data, scaleupy_column);
   }
 
   if (do_rect) {
@@ -1578,6 +1557,8 @@ static ImBuf *scaleupy(struct ImBuf *ibuf, int newy)
   return ibuf;
 }
 
+/** \} */
+
 static void scalefast_Z_ImBuf(ImBuf *ibuf, int newx, int newy)
 {
   int *zbuf, *newzbuf, *_newzbuf = NULL;
@@ -1688,22 +1669,53 @@ struct imbufRGBA {
   float r, g, b, a;
 };
 
+typedef struct ScaleFastParallelData {
+  const ImBuf *ibuf;
+  unsigned int *newrect;
+  struct imbufRGBA *newrectf;
+  int newx;
+  size_t stepx, stepy;
+} ScaleFastParallelData;
+
+static void scalefast_line(void *__restrict userdata,
+                           const int y,
+                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ScaleFastParallelData *data = userdata;
+  const ImBuf *ibuf = data->ibuf;
+  const size_t ofsy = 32768 + y * data->stepy;
+  size_t ofsx;
+  int x;
+
+  if (data->newrect) {
+    const unsigned int *rect = ibuf->rect + (ofsy >> 16) * ibuf->x;
+    unsigned int *newrect = data->newrect + (size_t)data->newx * y;
+    ofsx = 32768;
+
+    for (x = data->newx; x > 0; x--, ofsx += data->stepx) {
+      *newrect++ = rect[ofsx >> 16];
+    }
+  }
+
+  if (data->newrectf) {
+    const struct imbufRGBA *rectf = (const struct imbufRGBA *)ibuf->rect_float +
+                                    (ofsy >> 16) * ibuf->x;
+    struct imbufRGBA *newrectf = data->newrectf + (size_t)data->newx * y;
+    ofsx = 32768;
+
+    for (x = data->newx; x > 0; x--, ofsx += data->stepx) {
+      *newrectf++ = rectf[ofsx >> 16];
+    }
+  }
+}
+
 bool IMB_scalefastImBuf(struct ImBuf *ibuf, unsigned int newx, unsigned int newy)
 {
   BLI_assert_msg(newx > 0 && newy > 0, "Images must be at least 1 on both dimensions!");
 
-  unsigned int *rect, *_newrect, *newrect;
-  struct imbufRGBA *rectf, *_newrectf, *newrectf;
-  int x, y;
+  unsigned int *_newrect = NULL;
+  struct imbufRGBA *_newrectf = NULL;
   bool do_float = false, do_rect = false;
-  size_t ofsx, ofsy, stepx, stepy;
-
-  rect = NULL;
-  _newrect = NULL;
-  newrect = NULL;
-  rectf = NULL;
-  _newrectf = NULL;
-  newrectf = NULL;
 
   if (ibuf == NULL) {
     return false;
@@ -1727,7 +1739,6 @@ bool IMB_scalefastImBuf(struct ImBuf *ibuf, unsigned int newx, unsigned int newy
     if (_newrect == NULL) {
       return false;
     }
-    newrect = _newrect;
   }
 
   if (do_float) {
@@ -1738,34 +1749,21 @@ bool IMB_scalefastImBuf(struct ImBuf *ibuf, unsigned int newx, unsigned int newy
       }
       return false;
     }
-    newrectf = _newrectf;
   }
 
-  stepx = round(65536.0 * (ibuf->x - 1.0) / (newx - 1.0));
-  stepy = round(65536.0 * (ibuf->y - 1.0) / (newy - 1.0));
-  ofsy = 32768;
-
-  for (y = newy; y > 0; y--, ofsy += stepy) {
-    if (do_rect) {
-      rect = ibuf->rect;
-      rect += (ofsy >> 16) * ibuf->x;
-      ofsx = 32768;
-
-      for (x = newx; x > 0; x--, ofsx += stepx) {
-        *newrect++ = rect[ofsx >> 16];
-      }
-    }
-
-    if (do_float) {
-      rectf = (struct imbufRGBA *)ibuf->rect_float;
-      rectf += (ofsy >> 16) * ibuf->x;
-      ofsx = 32768;
+  ScaleFastParallelData data = {
+      .ibuf = ibuf,
+      .newrect = _newrect,
+      .newrectf = _newrectf,
+      .newx = newx,
+      .stepx = round(65536.0 * (ibuf->x - 1.0) / (newx - 1.0)),
+      .stepy = round(65536.0 * (ibuf->y - 1.0) / (newy - 1.0)),
+  };
 
-      for (x = newx; x > 0; x--, ofsx += stepx) {
-        *newrectf++ = rectf[ofsx >> 16];
-      }
-    }
-  }
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = ((size_t)newx * newy > SCALE_PARALLEL_MIN_PIXELS);
+  BLI_task_parallel_range(0, newy, &data, scalefast_line, &settings);
 
   if (do_rect) {
     imb_freerectImBuf(ibuf);
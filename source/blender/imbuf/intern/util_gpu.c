@@ -8,6 +8,7 @@
 #include "imbuf.h"
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 #include "MEM_guardedalloc.h"
 
@@ -145,6 +146,283 @@ static void *imb_gpu_get_data(const ImBuf *ibuf,
   return data_rect;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Block Compression
+ *
+ * Simple CPU encoder for BC1 (DXT1) and BC3 (DXT5) textures, so byte images use a quarter
+ * (or half with alpha) of the graphics memory of an uncompressed texture. Endpoints are found
+ * with an inset bounding box fit, which is fast and good enough for viewport display.
+ * \{ */
+
+/* Images below this size are not worth compressing. */
+#define GPU_COMPRESS_MIN_SIZE 64
+
+static ushort bc_rgb_to_565(const uchar rgb[3])
+{
+  return (ushort)(((rgb[0] >> 3) << 11) | ((rgb[1] >> 2) << 5) | (rgb[2] >> 3));
+}
+
+static void bc_565_to_rgb(const ushort color, int r_rgb[3])
+{
+  const int r = (color >> 11) & 0x1f;
+  const int g = (color >> 5) & 0x3f;
+  const int b = color & 0x1f;
+  r_rgb[0] = (r << 3) | (r >> 2);
+  r_rgb[1] = (g << 2) | (g >> 4);
+  r_rgb[2] = (b << 3) | (b >> 2);
+}
+
+static void bc1_encode_color_block(const uchar block[16][4], uchar *dst)
+{
+  uchar min[3] = {255, 255, 255}, max[3] = {0, 0, 0};
+  for (int i = 0; i < 16; i++) {
+    for (int c = 0; c < 3; c++) {
+      min[c] = min_ii(min[c], block[i][c]);
+      max[c] = max_ii(max[c], block[i][c]);
+    }
+  }
+
+  /* Inset the bounding box to reduce the error of the interpolated colors. */
+  for (int c = 0; c < 3; c++) {
+    const int inset = (max[c] - min[c]) >> 4;
+    min[c] = min_ii(min[c] + inset, 255);
+    max[c] = max_ii(max[c] - inset, 0);
+  }
+
+  ushort color0 = bc_rgb_to_565(max);
+  ushort color1 = bc_rgb_to_565(min);
+  uint indices = 0;
+
+  if (color0 < color1) {
+    SWAP(ushort, color0, color1);
+  }
+
+  if (color0 != color1) {
+    /* Four color mode, requires `color0 > color1`. */
+    int palette[4][3];
+    bc_565_to_rgb(color0, palette[0]);
+    bc_565_to_rgb(color1, palette[1]);
+    for (int c = 0; c < 3; c++) {
+      palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+      palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+
+    for (int i = 0; i < 16; i++) {
+      int best_index = 0, best_dist = INT_MAX;
+      for (int p = 0; p < 4; p++) {
+        const int dr = block[i][0] - palette[p][0];
+        const int dg = block[i][1] - palette[p][1];
+        const int db = block[i][2] - palette[p][2];
+        const int dist = dr * dr + dg * dg + db * db;
+        if (dist < best_dist) {
+          best_dist = dist;
+          best_index = p;
+        }
+      }
+      indices |= (uint)best_index << (2 * i);
+    }
+  }
+
+  dst[0] = color0 & 0xff;
+  dst[1] = color0 >> 8;
+  dst[2] = color1 & 0xff;
+  dst[3] = color1 >> 8;
+  dst[4] = indices & 0xff;
+  dst[5] = (indices >> 8) & 0xff;
+  dst[6] = (indices >> 16) & 0xff;
+  dst[7] = indices >> 24;
+}
+
+static void bc3_encode_alpha_block(const uchar block[16][4], uchar *dst)
+{
+  int alpha0 = 0, alpha1 = 255;
+  for (int i = 0; i < 16; i++) {
+    alpha0 = max_ii(alpha0, block[i][3]);
+    alpha1 = min_ii(alpha1, block[i][3]);
+  }
+
+  /* Eight alpha mode, requires `alpha0 > alpha1`. When equal all indices point to `alpha0`. */
+  int palette[8];
+  palette[0] = alpha0;
+  palette[1] = alpha1;
+  for (int p = 2; p < 8; p++) {
+    palette[p] = ((8 - p) * alpha0 + (p - 1) * alpha1) / 7;
+  }
+
+  uint64_t indices = 0;
+  if (alpha0 != alpha1) {
+    for (int i = 0; i < 16; i++) {
+      int best_index = 0, best_dist = INT_MAX;
+      for (int p = 0; p < 8; p++) {
+        const int dist = abs(block[i][3] - palette[p]);
+        if (dist < best_dist) {
+          best_dist = dist;
+          best_index = p;
+        }
+      }
+      indices |= (uint64_t)best_index << (3 * i);
+    }
+  }
+
+  dst[0] = (uchar)alpha0;
+  dst[1] = (uchar)alpha1;
+  for (int i = 0; i < 6; i++) {
+    dst[2 + i] = (indices >> (8 * i)) & 0xff;
+  }
+}
+
+typedef struct CompressParallelData {
+  const uchar *rect;
+  uchar *blocks;
+  int width, height;
+  int blocks_x;
+  bool use_alpha;
+} CompressParallelData;
+
+static void compress_block_row(void *__restrict userdata,
+                               const int block_y,
+                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const CompressParallelData *data = userdata;
+  const int block_size = data->use_alpha ? 16 : 8;
+  uchar *dst = data->blocks + (size_t)block_y * data->blocks_x * block_size;
+
+  for (int block_x = 0; block_x < data->blocks_x; block_x++, dst += block_size) {
+    /* Gather the block, clamping to the image for mipmap levels smaller than a block. */
+    uchar block[16][4];
+    for (int j = 0; j < 4; j++) {
+      const int y = min_ii(block_y * 4 + j, data->height - 1);
+      for (int i = 0; i < 4; i++) {
+        const int x = min_ii(block_x * 4 + i, data->width - 1);
+        copy_v4_v4_uchar(block[j * 4 + i], data->rect + ((size_t)y * data->width + x) * 4);
+      }
+    }
+
+    if (data->use_alpha) {
+      bc3_encode_alpha_block(block, dst);
+      bc1_encode_color_block(block, dst + 8);
+    }
+    else {
+      bc1_encode_color_block(block, dst);
+    }
+  }
+}
+
+static size_t compressed_level_size(const int width, const int height, const bool use_alpha)
+{
+  return (size_t)((width + 3) / 4) * ((height + 3) / 4) * (use_alpha ? 16 : 8);
+}
+
+/* Box filter a RGBA byte buffer to half resolution. */
+static uchar *compress_downsample(const uchar *rect, const int width, const int height)
+{
+  const int new_width = max_ii(1, width / 2);
+  const int new_height = max_ii(1, height / 2);
+  uchar *new_rect = MEM_mallocN(sizeof(uchar[4]) * new_width * new_height, __func__);
+
+  for (int y = 0; y < new_height; y++) {
+    const int y0 = min_ii(y * 2, height - 1), y1 = min_ii(y * 2 + 1, height - 1);
+    for (int x = 0; x < new_width; x++) {
+      const int x0 = min_ii(x * 2, width - 1), x1 = min_ii(x * 2 + 1, width - 1);
+      const uchar *p00 = rect + ((size_t)y0 * width + x0) * 4;
+      const uchar *p01 = rect + ((size_t)y0 * width + x1) * 4;
+      const uchar *p10 = rect + ((size_t)y1 * width + x0) * 4;
+      const uchar *p11 = rect + ((size_t)y1 * width + x1) * 4;
+      uchar *dst = new_rect + ((size_t)y * new_width + x) * 4;
+      for (int c = 0; c < 4; c++) {
+        dst[c] = (uchar)((p00[c] + p01[c] + p10[c] + p11[c] + 2) >> 2);
+      }
+    }
+  }
+  return new_rect;
+}
+
+static GPUTexture *imb_gpu_create_compressed_texture(const char *name,
+                                                     const ImBuf *ibuf,
+                                                     const bool use_premult)
+{
+  eGPUDataFormat data_format;
+  eGPUTextureFormat tex_format;
+  imb_gpu_get_format(ibuf, false, &data_format, &tex_format);
+
+  const bool compress_as_srgb = (tex_format == GPU_SRGB8_A8);
+  bool freebuf = false;
+  uchar *rect = imb_gpu_get_data(ibuf, false, NULL, compress_as_srgb, use_premult, &freebuf);
+  if (rect == NULL) {
+    return NULL;
+  }
+
+  const size_t num_pixels = (size_t)ibuf->x * ibuf->y;
+  bool use_alpha = false;
+  for (size_t i = 0; i < num_pixels; i++) {
+    if (rect[i * 4 + 3] != 255) {
+      use_alpha = true;
+      break;
+    }
+  }
+
+  eGPUTextureFormat compressed_format;
+  if (compress_as_srgb) {
+    compressed_format = use_alpha ? GPU_SRGB8_A8_DXT5 : GPU_SRGB8_A8_DXT1;
+  }
+  else {
+    compressed_format = use_alpha ? GPU_RGBA8_DXT5 : GPU_RGBA8_DXT1;
+  }
+
+  /* Compress the full mipmap chain, since mipmaps can't be generated on the GPU. */
+  const int mip_len = 1 + (int)floorf(log2f((float)max_ii(ibuf->x, ibuf->y)));
+  size_t blocks_size = 0;
+  for (int level = 0, width = ibuf->x, height = ibuf->y; level < mip_len; level++) {
+    blocks_size += compressed_level_size(width, height, use_alpha);
+    width = max_ii(1, width / 2);
+    height = max_ii(1, height / 2);
+  }
+  uchar *blocks = MEM_mallocN(blocks_size, __func__);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+
+  CompressParallelData data;
+  data.rect = rect;
+  data.blocks = blocks;
+  data.width = ibuf->x;
+  data.height = ibuf->y;
+  data.use_alpha = use_alpha;
+
+  for (int level = 0; level < mip_len; level++) {
+    const int blocks_y = (data.height + 3) / 4;
+    data.blocks_x = (data.width + 3) / 4;
+    settings.use_threading = (size_t)data.blocks_x * blocks_y > 64;
+    BLI_task_parallel_range(0, blocks_y, &data, compress_block_row, &settings);
+
+    if (level + 1 < mip_len) {
+      uchar *next_rect = compress_downsample(data.rect, data.width, data.height);
+      if (data.rect != rect) {
+        MEM_freeN((void *)data.rect);
+      }
+      data.rect = next_rect;
+      data.blocks += compressed_level_size(data.width, data.height, use_alpha);
+      data.width = max_ii(1, data.width / 2);
+      data.height = max_ii(1, data.height / 2);
+    }
+  }
+
+  if (data.rect != rect) {
+    MEM_freeN((void *)data.rect);
+  }
+  if (freebuf) {
+    MEM_freeN(rect);
+  }
+
+  GPUTexture *tex = GPU_texture_create_compressed_2d(
+      name, ibuf->x, ibuf->y, mip_len, compressed_format, blocks);
+  MEM_freeN(blocks);
+
+  return tex;
+}
+
+/** \} */
+
 GPUTexture *IMB_touch_gpu_texture(
     const char *name, ImBuf *ibuf, int w, int h, int layers, bool use_high_bitdepth)
 {
@@ -198,7 +476,8 @@ GPUTexture *IMB_create_gpu_texture(const char *name,
                                    ImBuf *ibuf,
                                    bool use_high_bitdepth,
                                    bool use_premult,
-                                   bool limit_gl_texture_size)
+                                   bool limit_gl_texture_size,
+                                   bool use_compression)
 {
   GPUTexture *tex = NULL;
   int size[2] = {GPU_texture_size_with_limit(ibuf->x, limit_gl_texture_size),
@@ -236,6 +515,18 @@ GPUTexture *IMB_create_gpu_texture(const char *name,
   }
 #endif
 
+  /* Block compress byte images. Painted images are skipped, since compressed textures can't be
+   * partially updated. */
+  if (use_compression && !do_rescale && ibuf->rect_float == NULL && ibuf->rect != NULL &&
+      (ibuf->userflags & IB_BITMAPDIRTY) == 0 && (ibuf->x % 4) == 0 && (ibuf->y % 4) == 0 &&
+      min_ii(ibuf->x, ibuf->y) >= GPU_COMPRESS_MIN_SIZE) {
+    tex = imb_gpu_create_compressed_texture(name, ibuf, use_premult);
+    if (tex != NULL) {
+      GPU_texture_anisotropic_filter(tex, true);
+      return tex;
+    }
+  }
+
   eGPUDataFormat data_format;
   eGPUTextureFormat tex_format;
   imb_gpu_get_format(ibuf, use_high_bitdepth, &data_format, &tex_format);
@@ -140,7 +140,7 @@ Alembic::Abc::OObject ABCHierarchyIterator::get_alembic_parent(
 }
 
 ABCWriterConstructorArgs ABCHierarchyIterator::writer_constructor_args(
-    const HierarchyContext *context) const
+    const HierarchyContext *context)
 {
   ABCWriterConstructorArgs constructor_args;
   constructor_args.depsgraph = depsgraph_;
@@ -26,7 +26,7 @@ struct ABCWriterConstructorArgs {
   Alembic::Abc::OObject abc_parent;
   std::string abc_name;
   std::string abc_path;
-  const ABCHierarchyIterator *hierarchy_iterator;
+  ABCHierarchyIterator *hierarchy_iterator;
   const AlembicExportParams *export_params;
 };
 
@@ -66,7 +66,7 @@ class ABCHierarchyIterator : public AbstractHierarchyIterator {
 
  private:
   Alembic::Abc::OObject get_alembic_parent(const HierarchyContext *context) const;
-  ABCWriterConstructorArgs writer_constructor_args(const HierarchyContext *context) const;
+  ABCWriterConstructorArgs writer_constructor_args(const HierarchyContext *context);
   void update_archive_bounding_box();
   void update_bounding_box_recursive(Imath::Box3d &bounds, const HierarchyContext *context);
 
@@ -11,6 +11,8 @@
 #include "BLI_assert.h"
 #include "BLI_math_vector.h"
 
+#include <memory>
+
 #include "BKE_attribute.h"
 #include "BKE_customdata.h"
 #include "BKE_lib_id.h"
@@ -69,9 +71,12 @@ static void get_edge_creases(struct Mesh *mesh,
 static void get_vert_creases(struct Mesh *mesh,
                              std::vector<int32_t> &indices,
                              std::vector<float> &sharpnesses);
+static bool has_flat_shaded_poly(const Mesh *mesh);
+static bool loop_normals_needed(const Mesh *mesh, bool has_flat_shaded_poly);
 static void get_loop_normals(struct Mesh *mesh,
                              std::vector<Imath::V3f> &normals,
-                             bool has_flat_shaded_poly);
+                             bool has_flat_shaded_poly,
+                             bool calc_split_normals);
 
 ABCGenericMeshWriter::ABCGenericMeshWriter(const ABCWriterConstructorArgs &args)
     : ABCAbstractWriter(args), is_subd_(false)
@@ -139,6 +144,30 @@ bool ABCGenericMeshWriter::is_supported(const HierarchyContext *context) const
   return true;
 }
 
+/* Mesh data of one frame, converted to Alembic arrays. */
+struct ABCMeshData {
+  /* The mesh that is written, which is a triangulated copy when triangulation is enabled. */
+  std::shared_ptr<Mesh> mesh;
+
+  std::vector<Imath::V3f> points;
+  std::vector<int32_t> poly_verts;
+  std::vector<int32_t> loop_counts;
+  bool has_flat_shaded_poly = false;
+
+  UVSample uvs_and_indices;
+  const char *uv_name = "";
+  std::vector<Imath::V3f> normals;
+  std::vector<Imath::V3f> velocities;
+  bool has_velocities = false;
+
+  /* Only used for subdivision surfaces. */
+  std::vector<int32_t> edge_crease_indices;
+  std::vector<int32_t> edge_crease_lengths;
+  std::vector<float> edge_crease_sharpness;
+  std::vector<int32_t> vert_crease_indices;
+  std::vector<float> vert_crease_sharpness;
+};
+
 void ABCGenericMeshWriter::do_write(HierarchyContext &context)
 {
   Object *object = context.object;
@@ -150,27 +179,74 @@ void ABCGenericMeshWriter::do_write(HierarchyContext &context)
     return;
   }
 
-  if (args_.export_params->triangulate) {
-    const bool tag_only = false;
-    const int quad_method = args_.export_params->quad_method;
-    const int ngon_method = args_.export_params->ngon_method;
+  std::shared_ptr<ABCMeshData> abc_mesh_data = std::make_shared<ABCMeshData>();
+  /* The mesh is freed when the deferred write is done, or when it is discarded. */
+  abc_mesh_data->mesh = std::shared_ptr<Mesh>(mesh, [this, needsfree](Mesh *mesh_to_free) {
+    if (needsfree) {
+      free_export_mesh(mesh_to_free);
+    }
+  });
+
+  const bool triangulate = args_.export_params->triangulate;
+  if (args_.export_params->normals && !is_subd_ && !triangulate &&
+      loop_normals_needed(mesh, has_flat_shaded_poly(mesh))) {
+    /* The loop normals are stored on the mesh, which can be shared with other writers. Compute
+     * them here, so that the parallel preparation only reads the mesh. */
+    BKE_mesh_calc_normals_split(mesh);
+  }
+
+  const bool is_first_frame = !frame_has_been_written_;
+
+  /* Converting the mesh to Alembic arrays only reads the mesh, so that is done in parallel with
+   * the other meshes of the frame. Writing to the archive is not thread-safe. */
+  args_.hierarchy_iterator->defer_write(
+      [this, abc_mesh_data, triangulate]() {
+        if (triangulate) {
+          triangulate_mesh(*abc_mesh_data);
+        }
+        get_geometry_data(*abc_mesh_data, triangulate);
+      },
+      [this, context, abc_mesh_data, is_first_frame]() {
+        if (is_subd_) {
+          write_subd(context, *abc_mesh_data, is_first_frame);
+        }
+        else {
+          write_mesh(context, *abc_mesh_data, is_first_frame);
+        }
+      });
+}
 
-    BMeshCreateParams bmesh_create_params{};
-    BMeshFromMeshParams bmesh_from_mesh_params{};
-    bmesh_from_mesh_params.calc_face_normal = true;
-    BMesh *bm = BKE_mesh_to_bmesh_ex(mesh, &bmesh_create_params, &bmesh_from_mesh_params);
+void ABCGenericMeshWriter::free_export_mesh(Mesh *mesh)
+{
+  BKE_id_free(nullptr, mesh);
+}
 
-    BM_mesh_triangulate(bm, quad_method, ngon_method, 4, tag_only, nullptr, nullptr, nullptr);
+void ABCGenericMeshWriter::triangulate_mesh(ABCMeshData &abc_mesh_data) const
+{
+  const bool tag_only = false;
+  const int quad_method = args_.export_params->quad_method;
+  const int ngon_method = args_.export_params->ngon_method;
 
-    Mesh *triangulated_mesh = BKE_mesh_from_bmesh_for_eval_nomain(bm, nullptr, mesh);
-    BM_mesh_free(bm);
+  BMeshCreateParams bmesh_create_params{};
+  BMeshFromMeshParams bmesh_from_mesh_params{};
+  bmesh_from_mesh_params.calc_face_normal = true;
+  Mesh *mesh = abc_mesh_data.mesh.get();
+  BMesh *bm = BKE_mesh_to_bmesh_ex(mesh, &bmesh_create_params, &bmesh_from_mesh_params);
 
-    if (needsfree) {
-      free_export_mesh(mesh);
-    }
-    mesh = triangulated_mesh;
-    needsfree = true;
-  }
+  BM_mesh_triangulate(bm, quad_method, ngon_method, 4, tag_only, nullptr, nullptr, nullptr);
+
+  Mesh *triangulated_mesh = BKE_mesh_from_bmesh_for_eval_nomain(bm, nullptr, mesh);
+  BM_mesh_free(bm);
+
+  /* Releases the original export mesh. */
+  abc_mesh_data.mesh = std::shared_ptr<Mesh>(
+      triangulated_mesh, [](Mesh *mesh_to_free) { BKE_id_free(nullptr, mesh_to_free); });
+}
+
+void ABCGenericMeshWriter::get_geometry_data(ABCMeshData &abc_mesh_data,
+                                             const bool calc_split_normals)
+{
+  Mesh *mesh = abc_mesh_data.mesh.get();
 
   m_custom_data_config.pack_uvs = args_.export_params->packuv;
   m_custom_data_config.mesh = mesh;
@@ -181,52 +257,48 @@ void ABCGenericMeshWriter::do_write(HierarchyContext &context)
   m_custom_data_config.totvert = mesh->totvert;
   m_custom_data_config.timesample_index = timesample_index_;
 
-  try {
-    if (is_subd_) {
-      write_subd(context, mesh);
-    }
-    else {
-      write_mesh(context, mesh);
-    }
+  get_vertices(mesh, abc_mesh_data.points);
+  get_topology(
+      mesh, abc_mesh_data.poly_verts, abc_mesh_data.loop_counts, abc_mesh_data.has_flat_shaded_poly);
 
-    if (needsfree) {
-      free_export_mesh(mesh);
-    }
+  if (args_.export_params->uvs) {
+    abc_mesh_data.uv_name = get_uv_sample(
+        abc_mesh_data.uvs_and_indices, m_custom_data_config, &mesh->ldata);
   }
-  catch (...) {
-    if (needsfree) {
-      free_export_mesh(mesh);
-    }
-    throw;
+
+  if (is_subd_) {
+    get_edge_creases(mesh,
+                     abc_mesh_data.edge_crease_indices,
+                     abc_mesh_data.edge_crease_lengths,
+                     abc_mesh_data.edge_crease_sharpness);
+    get_vert_creases(mesh, abc_mesh_data.vert_crease_indices, abc_mesh_data.vert_crease_sharpness);
+    return;
   }
-}
 
-void ABCGenericMeshWriter::free_export_mesh(Mesh *mesh)
-{
-  BKE_id_free(nullptr, mesh);
+  if (args_.export_params->normals) {
+    get_loop_normals(
+        mesh, abc_mesh_data.normals, abc_mesh_data.has_flat_shaded_poly, calc_split_normals);
+  }
+  abc_mesh_data.has_velocities = get_velocities(mesh, abc_mesh_data.velocities);
 }
 
-void ABCGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
+void ABCGenericMeshWriter::write_mesh(const HierarchyContext &context,
+                                      const ABCMeshData &abc_mesh_data,
+                                      const bool is_first_frame)
 {
-  std::vector<Imath::V3f> points, normals;
-  std::vector<int32_t> poly_verts, loop_counts;
-  std::vector<Imath::V3f> velocities;
-  bool has_flat_shaded_poly = false;
+  Mesh *mesh = abc_mesh_data.mesh.get();
 
-  get_vertices(mesh, points);
-  get_topology(mesh, poly_verts, loop_counts, has_flat_shaded_poly);
-
-  if (!frame_has_been_written_ && args_.export_params->face_sets) {
+  if (is_first_frame && args_.export_params->face_sets) {
     write_face_sets(context.object, mesh, abc_poly_mesh_schema_);
   }
 
   OPolyMeshSchema::Sample mesh_sample = OPolyMeshSchema::Sample(
-      V3fArraySample(points), Int32ArraySample(poly_verts), Int32ArraySample(loop_counts));
-
-  UVSample uvs_and_indices;
+      V3fArraySample(abc_mesh_data.points),
+      Int32ArraySample(abc_mesh_data.poly_verts),
+      Int32ArraySample(abc_mesh_data.loop_counts));
 
   if (args_.export_params->uvs) {
-    const char *name = get_uv_sample(uvs_and_indices, m_custom_data_config, &mesh->ldata);
+    const UVSample &uvs_and_indices = abc_mesh_data.uvs_and_indices;
 
     if (!uvs_and_indices.indices.empty() && !uvs_and_indices.uvs.empty()) {
       OV2fGeomParam::Sample uv_sample;
@@ -234,7 +306,7 @@ void ABCGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
       uv_sample.setIndices(UInt32ArraySample(uvs_and_indices.indices));
       uv_sample.setScope(kFacevaryingScope);
 
-      abc_poly_mesh_schema_.setUVSourceName(name);
+      abc_poly_mesh_schema_.setUVSourceName(abc_mesh_data.uv_name);
       mesh_sample.setUVs(uv_sample);
     }
 
@@ -243,12 +315,10 @@ void ABCGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
   }
 
   if (args_.export_params->normals) {
-    get_loop_normals(mesh, normals, has_flat_shaded_poly);
-
     ON3fGeomParam::Sample normals_sample;
-    if (!normals.empty()) {
+    if (!abc_mesh_data.normals.empty()) {
       normals_sample.setScope(kFacevaryingScope);
-      normals_sample.setVals(V3fArraySample(normals));
+      normals_sample.setVals(V3fArraySample(abc_mesh_data.normals));
     }
 
     mesh_sample.setNormals(normals_sample);
@@ -258,8 +328,8 @@ void ABCGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
     write_generated_coordinates(abc_poly_mesh_schema_.getArbGeomParams(), m_custom_data_config);
   }
 
-  if (get_velocities(mesh, velocities)) {
-    mesh_sample.setVelocities(V3fArraySample(velocities));
+  if (abc_mesh_data.has_velocities) {
+    mesh_sample.setVelocities(V3fArraySample(abc_mesh_data.velocities));
   }
 
   update_bounding_box(context.object);
@@ -270,29 +340,23 @@ void ABCGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
   write_arb_geo_params(mesh);
 }
 
-void ABCGenericMeshWriter::write_subd(HierarchyContext &context, struct Mesh *mesh)
+void ABCGenericMeshWriter::write_subd(const HierarchyContext &context,
+                                      const ABCMeshData &abc_mesh_data,
+                                      const bool is_first_frame)
 {
-  std::vector<float> edge_crease_sharpness, vert_crease_sharpness;
-  std::vector<Imath::V3f> points;
-  std::vector<int32_t> poly_verts, loop_counts;
-  std::vector<int32_t> edge_crease_indices, edge_crease_lengths, vert_crease_indices;
-  bool has_flat_poly = false;
-
-  get_vertices(mesh, points);
-  get_topology(mesh, poly_verts, loop_counts, has_flat_poly);
-  get_edge_creases(mesh, edge_crease_indices, edge_crease_lengths, edge_crease_sharpness);
-  get_vert_creases(mesh, vert_crease_indices, vert_crease_sharpness);
+  Mesh *mesh = abc_mesh_data.mesh.get();
 
-  if (!frame_has_been_written_ && args_.export_params->face_sets) {
+  if (is_first_frame && args_.export_params->face_sets) {
     write_face_sets(context.object, mesh, abc_subdiv_schema_);
   }
 
   OSubDSchema::Sample subdiv_sample = OSubDSchema::Sample(
-      V3fArraySample(points), Int32ArraySample(poly_verts), Int32ArraySample(loop_counts));
+      V3fArraySample(abc_mesh_data.points),
+      Int32ArraySample(abc_mesh_data.poly_verts),
+      Int32ArraySample(abc_mesh_data.loop_counts));
 
-  UVSample sample;
   if (args_.export_params->uvs) {
-    const char *name = get_uv_sample(sample, m_custom_data_config, &mesh->ldata);
+    const UVSample &sample = abc_mesh_data.uvs_and_indices;
 
     if (!sample.indices.empty() && !sample.uvs.empty()) {
       OV2fGeomParam::Sample uv_sample;
@@ -300,7 +364,7 @@ void ABCGenericMeshWriter::write_subd(HierarchyContext &context, struct Mesh *me
       uv_sample.setIndices(UInt32ArraySample(sample.indices));
       uv_sample.setScope(kFacevaryingScope);
 
-      abc_subdiv_schema_.setUVSourceName(name);
+      abc_subdiv_schema_.setUVSourceName(abc_mesh_data.uv_name);
       subdiv_sample.setUVs(uv_sample);
     }
 
@@ -312,15 +376,15 @@ void ABCGenericMeshWriter::write_subd(HierarchyContext &context, struct Mesh *me
     write_generated_coordinates(abc_subdiv_schema_.getArbGeomParams(), m_custom_data_config);
   }
 
-  if (!edge_crease_indices.empty()) {
-    subdiv_sample.setCreaseIndices(Int32ArraySample(edge_crease_indices));
-    subdiv_sample.setCreaseLengths(Int32ArraySample(edge_crease_lengths));
-    subdiv_sample.setCreaseSharpnesses(FloatArraySample(edge_crease_sharpness));
+  if (!abc_mesh_data.edge_crease_indices.empty()) {
+    subdiv_sample.setCreaseIndices(Int32ArraySample(abc_mesh_data.edge_crease_indices));
+    subdiv_sample.setCreaseLengths(Int32ArraySample(abc_mesh_data.edge_crease_lengths));
+    subdiv_sample.setCreaseSharpnesses(FloatArraySample(abc_mesh_data.edge_crease_sharpness));
   }
 
-  if (!vert_crease_indices.empty()) {
-    subdiv_sample.setCornerIndices(Int32ArraySample(vert_crease_indices));
-    subdiv_sample.setCornerSharpnesses(FloatArraySample(vert_crease_sharpness));
+  if (!abc_mesh_data.vert_crease_indices.empty()) {
+    subdiv_sample.setCornerIndices(Int32ArraySample(abc_mesh_data.vert_crease_indices));
+    subdiv_sample.setCornerSharpnesses(FloatArraySample(abc_mesh_data.vert_crease_sharpness));
   }
 
   update_bounding_box(context.object);
@@ -361,7 +425,7 @@ void ABCGenericMeshWriter::write_arb_geo_params(struct Mesh *me)
   write_custom_data(arb_geom_params, m_custom_data_config, &me->ldata, CD_MLOOPCOL);
 }
 
-bool ABCGenericMeshWriter::get_velocities(struct Mesh *mesh, std::vector<Imath::V3f> &vels)
+bool ABCGenericMeshWriter::get_velocities(const Mesh *mesh, std::vector<Imath::V3f> &vels)
 {
   /* Export velocity attribute output by fluid sim, sequence cache modifier
    * and geometry nodes. */
@@ -521,20 +585,42 @@ static void get_vert_creases(struct Mesh *mesh,
   }
 }
 
+static bool has_flat_shaded_poly(const Mesh *mesh)
+{
+  for (int i = 0; i < mesh->totpoly; i++) {
+    if ((mesh->mpoly[i].flag & ME_SMOOTH) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool loop_normals_needed(const Mesh *mesh, const bool has_flat_shaded_poly)
+{
+  /* If all polygons are smooth shaded, and there are no custom normals, we don't need to export
+   * normals at all. This is also done by other software, see T71246. */
+  return has_flat_shaded_poly || CustomData_has_layer(&mesh->ldata, CD_CUSTOMLOOPNORMAL) ||
+         (mesh->flag & ME_AUTOSMOOTH) != 0;
+}
+
+/**
+ * \param calc_split_normals: Compute the loop normals of the mesh, otherwise they must have been
+ * computed already.
+ */
 static void get_loop_normals(struct Mesh *mesh,
                              std::vector<Imath::V3f> &normals,
-                             bool has_flat_shaded_poly)
+                             bool has_flat_shaded_poly,
+                             bool calc_split_normals)
 {
   normals.clear();
 
-  /* If all polygons are smooth shaded, and there are no custom normals, we don't need to export
-   * normals at all. This is also done by other software, see T71246. */
-  if (!has_flat_shaded_poly && !CustomData_has_layer(&mesh->ldata, CD_CUSTOMLOOPNORMAL) &&
-      (mesh->flag & ME_AUTOSMOOTH) == 0) {
+  if (!loop_normals_needed(mesh, has_flat_shaded_poly)) {
     return;
   }
 
-  BKE_mesh_calc_normals_split(mesh);
+  if (calc_split_normals) {
+    BKE_mesh_calc_normals_split(mesh);
+  }
   const float(*lnors)[3] = static_cast<float(*)[3]>(CustomData_get_layer(&mesh->ldata, CD_NORMAL));
   BLI_assert_msg(lnors != nullptr, "BKE_mesh_calc_normals_split() should have computed CD_NORMAL");
 
@@ -15,6 +15,8 @@ struct ModifierData;
 
 namespace blender::io::alembic {
 
+struct ABCMeshData;
+
 /* Writer for Alembic geometry. Does not assume the object is a mesh object. */
 class ABCGenericMeshWriter : public ABCAbstractWriter {
  private:
@@ -51,12 +53,20 @@ class ABCGenericMeshWriter : public ABCAbstractWriter {
   virtual bool export_as_subdivision_surface(Object *ob_eval) const;
 
  private:
-  void write_mesh(HierarchyContext &context, Mesh *mesh);
-  void write_subd(HierarchyContext &context, Mesh *mesh);
+  void triangulate_mesh(ABCMeshData &abc_mesh_data) const;
+  /* Convert the mesh to Alembic arrays. This runs in parallel with other writers, see
+   * #AbstractHierarchyIterator::defer_write(). */
+  void get_geometry_data(ABCMeshData &abc_mesh_data, bool calc_split_normals);
+  void write_mesh(const HierarchyContext &context,
+                  const ABCMeshData &abc_mesh_data,
+                  bool is_first_frame);
+  void write_subd(const HierarchyContext &context,
+                  const ABCMeshData &abc_mesh_data,
+                  bool is_first_frame);
   template<typename Schema> void write_face_sets(Object *object, Mesh *mesh, Schema &schema);
 
   void write_arb_geo_params(Mesh *me);
-  bool get_velocities(Mesh *mesh, std::vector<Imath::V3f> &vels);
+  bool get_velocities(const Mesh *mesh, std::vector<Imath::V3f> &vels);
   void get_geo_groups(Object *object,
                       Mesh *mesh,
                       std::map<std::string, std::vector<int32_t>> &geo_groups);
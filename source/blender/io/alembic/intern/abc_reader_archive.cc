@@ -88,7 +88,8 @@ ArchiveReader *ArchiveReader::get(struct Main *bmain, const std::vector<const ch
   return new ArchiveReader(readers);
 }
 
-ArchiveReader::ArchiveReader(const std::vector<ArchiveReader *> &readers) : m_readers(readers)
+ArchiveReader::ArchiveReader(const std::vector<ArchiveReader *> &readers)
+    : m_readers(readers), m_mesh_prefetcher(std::make_shared<MeshSamplePrefetcher>())
 {
   Alembic::AbcCoreLayer::ArchiveReaderPtrs archives;
 
@@ -103,6 +104,7 @@ ArchiveReader::ArchiveReader(const std::vector<ArchiveReader *> &readers) : m_re
 }
 
 ArchiveReader::ArchiveReader(struct Main *bmain, const char *filename)
+    : m_mesh_prefetcher(std::make_shared<MeshSamplePrefetcher>())
 {
   char abs_filename[FILE_MAX];
   BLI_strncpy(abs_filename, filename, FILE_MAX);
@@ -112,18 +114,27 @@ ArchiveReader::ArchiveReader(struct Main *bmain, const char *filename)
   UTF16_ENCODE(abs_filename);
   std::wstring wstr(abs_filename_16);
   m_infile.open(wstr.c_str(), std::ios::in | std::ios::binary);
+  m_prefetch_infile.open(wstr.c_str(), std::ios::in | std::ios::binary);
   UTF16_UN_ENCODE(abs_filename);
 #else
   m_infile.open(abs_filename, std::ios::in | std::ios::binary);
+  m_prefetch_infile.open(abs_filename, std::ios::in | std::ios::binary);
 #endif
 
+  /* Ogawa uses a free stream for every read, so concurrent reads don't block each other. */
   m_streams.push_back(&m_infile);
+  if (m_prefetch_infile.is_open()) {
+    m_streams.push_back(&m_prefetch_infile);
+  }
 
   m_archive = open_archive(abs_filename, m_streams);
 }
 
 ArchiveReader::~ArchiveReader()
 {
+  /* The prefetch thread reads from the archive, stop it before the archive is closed. */
+  m_mesh_prefetcher->stop();
+
   for (ArchiveReader *reader : m_readers) {
     delete reader;
   }
@@ -139,4 +150,9 @@ Alembic::Abc::IObject ArchiveReader::getTop()
   return m_archive.getTop();
 }
 
+std::shared_ptr<MeshSamplePrefetcher> ArchiveReader::mesh_prefetcher() const
+{
+  return m_mesh_prefetcher;
+}
+
 }  // namespace blender::io::alembic
@@ -10,6 +10,9 @@
 #include <Alembic/AbcCoreOgawa/All.h>
 
 #include <fstream>
+#include <memory>
+
+#include "abc_reader_prefetch.h"
 
 struct Main;
 
@@ -23,10 +26,14 @@ namespace blender::io::alembic {
 class ArchiveReader {
   Alembic::Abc::IArchive m_archive;
   std::ifstream m_infile;
+  /* Second stream, so that the prefetch thread doesn't have to wait for other readers. */
+  std::ifstream m_prefetch_infile;
   std::vector<std::istream *> m_streams;
 
   std::vector<ArchiveReader *> m_readers;
 
+  std::shared_ptr<MeshSamplePrefetcher> m_mesh_prefetcher;
+
   ArchiveReader(const std::vector<ArchiveReader *> &readers);
 
   ArchiveReader(struct Main *bmain, const char *filename);
@@ -39,6 +46,9 @@ class ArchiveReader {
   bool valid() const;
 
   Alembic::Abc::IObject getTop();
+
+  /** Background reader of mesh samples, shared by the mesh readers of this archive. */
+  std::shared_ptr<MeshSamplePrefetcher> mesh_prefetcher() const;
 };
 
 }  // namespace blender::io::alembic
@@ -6,6 +6,7 @@
 
 #include "abc_reader_mesh.h"
 #include "abc_axis_conversion.h"
+#include "abc_reader_prefetch.h"
 #include "abc_reader_transform.h"
 #include "abc_util.h"
 
@@ -25,6 +26,7 @@
 #include "BLI_math_geom.h"
 
 #include "BKE_attribute.h"
+#include "BKE_customdata.h"
 #include "BKE_main.h"
 #include "BKE_material.h"
 #include "BKE_mesh.h"
@@ -468,14 +470,18 @@ static void read_velocity(const V3fArraySamplePtr &velocities,
   }
 }
 
+/**
+ * \param reuse_topology: The faces and UVs of the mesh are already up to date, only read the
+ * data that changes with the vertex positions.
+ */
 static void read_mesh_sample(const std::string &iobject_full_name,
                              ImportSettings *settings,
                              const IPolyMeshSchema &schema,
+                             const IPolyMeshSchema::Sample &sample,
                              const ISampleSelector &selector,
+                             const bool reuse_topology,
                              CDStreamConfig &config)
 {
-  const IPolyMeshSchema::Sample sample = schema.getValue(selector);
-
   AbcMeshData abc_mesh_data;
   abc_mesh_data.face_counts = sample.getFaceCounts();
   abc_mesh_data.face_indices = sample.getFaceIndices();
@@ -489,7 +495,7 @@ static void read_mesh_sample(const std::string &iobject_full_name,
     abc_mesh_data.ceil_positions = ceil_sample.getPositions();
   }
 
-  if ((settings->read_flag & MOD_MESHSEQ_READ_UV) != 0) {
+  if ((settings->read_flag & MOD_MESHSEQ_READ_UV) != 0 && !reuse_topology) {
     read_uvs_params(config, abc_mesh_data, schema.getUVsParam(), selector);
   }
 
@@ -499,7 +505,9 @@ static void read_mesh_sample(const std::string &iobject_full_name,
   }
 
   if ((settings->read_flag & MOD_MESHSEQ_READ_POLY) != 0) {
-    read_mpolys(config, abc_mesh_data);
+    if (!reuse_topology) {
+      read_mpolys(config, abc_mesh_data);
+    }
     process_normals(config, schema.getNormalsParam(), selector);
   }
 
@@ -658,11 +666,42 @@ bool AbcMeshReader::accepts_object_type(
   return true;
 }
 
+void AbcMeshReader::set_prefetcher(std::shared_ptr<MeshSamplePrefetcher> prefetcher)
+{
+  m_prefetcher = std::move(prefetcher);
+}
+
+IPolyMeshSchema::Sample AbcMeshReader::get_sample(const ISampleSelector &sample_sel)
+{
+  if (!m_prefetcher || m_schema.isConstant()) {
+    return m_schema.getValue(sample_sel);
+  }
+
+  const Alembic::AbcGeom::index_t index = sample_sel.getIndex(m_schema.getTimeSampling(),
+                                                              m_schema.getNumSamples());
+  const std::string &object_path = m_iobject.getFullName();
+
+  IPolyMeshSchema::Sample sample;
+  if (!m_prefetcher->find(object_path, index, sample)) {
+    sample = m_schema.getValue(ISampleSelector(index));
+  }
+  m_prefetcher->request_after(m_schema, object_path, index);
+  return sample;
+}
+
+static bool sample_topology_changed(const Mesh *existing_mesh,
+                                    const IPolyMeshSchema::Sample &sample)
+{
+  return sample.getPositions()->size() != existing_mesh->totvert ||
+         sample.getFaceCounts()->size() != existing_mesh->totpoly ||
+         sample.getFaceIndices()->size() != existing_mesh->totloop;
+}
+
 bool AbcMeshReader::topology_changed(Mesh *existing_mesh, const ISampleSelector &sample_sel)
 {
   IPolyMeshSchema::Sample sample;
   try {
-    sample = m_schema.getValue(sample_sel);
+    sample = get_sample(sample_sel);
   }
   catch (Alembic::Util::Exception &ex) {
     printf("Alembic: error reading mesh sample for '%s/%s' at time %f: %s\n",
@@ -674,13 +713,23 @@ bool AbcMeshReader::topology_changed(Mesh *existing_mesh, const ISampleSelector
     return false;
   }
 
-  const P3fArraySamplePtr &positions = sample.getPositions();
-  const Alembic::Abc::Int32ArraySamplePtr &face_indices = sample.getFaceIndices();
-  const Alembic::Abc::Int32ArraySamplePtr &face_counts = sample.getFaceCounts();
+  return sample_topology_changed(existing_mesh, sample);
+}
 
-  return positions->size() != existing_mesh->totvert ||
-         face_counts->size() != existing_mesh->totpoly ||
-         face_indices->size() != existing_mesh->totloop;
+bool AbcMeshReader::can_reuse_topology(const Mesh *existing_mesh, const int read_flag) const
+{
+  /* Faces and UVs are the same in every sample, and were read into the mesh before. */
+  if (m_schema.getTopologyVariance() == Alembic::AbcGeom::kHeterogeneousTopology) {
+    return false;
+  }
+  if (existing_mesh->totpoly > 0 && existing_mesh->totedge == 0) {
+    return false;
+  }
+  const IV2fGeomParam &uvs = m_schema.getUVsParam();
+  if ((read_flag & MOD_MESHSEQ_READ_UV) != 0 && uvs.valid()) {
+    return uvs.isConstant() && CustomData_has_layer(&existing_mesh->ldata, CD_MLOOPUV);
+  }
+  return true;
 }
 
 Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
@@ -692,7 +741,7 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
 {
   IPolyMeshSchema::Sample sample;
   try {
-    sample = m_schema.getValue(sample_sel);
+    sample = get_sample(sample_sel);
   }
   catch (Alembic::Util::Exception &ex) {
     if (err_str != nullptr) {
@@ -733,13 +782,16 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
   settings.velocity_name = velocity_name;
   settings.velocity_scale = velocity_scale;
 
-  if (topology_changed(existing_mesh, sample_sel)) {
+  bool reuse_topology = false;
+  if (sample_topology_changed(existing_mesh, sample)) {
     new_mesh = BKE_mesh_new_nomain_from_template(
         existing_mesh, positions->size(), 0, 0, face_indices->size(), face_counts->size());
 
     settings.read_flag |= MOD_MESHSEQ_READ_ALL;
   }
   else {
+    reuse_topology = can_reuse_topology(existing_mesh, read_flag);
+
     /* If the face count changed (e.g. by triangulation), only read points.
      * This prevents crash from T49813.
      * TODO(kevin): perhaps find a better way to do this? */
@@ -761,7 +813,8 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
   config.time = sample_sel.getRequestedTime();
   config.modifier_error_message = err_str;
 
-  read_mesh_sample(m_iobject.getFullName(), &settings, m_schema, sample_sel, config);
+  read_mesh_sample(
+      m_iobject.getFullName(), &settings, m_schema, sample, sample_sel, reuse_topology, config);
 
   if (new_mesh) {
     /* Here we assume that the number of materials doesn't change, i.e. that
@@ -8,15 +8,21 @@
 #include "abc_customdata.h"
 #include "abc_reader_object.h"
 
+#include <memory>
+
 struct Mesh;
 
 namespace blender::io::alembic {
 
+class MeshSamplePrefetcher;
+
 class AbcMeshReader final : public AbcObjectReader {
   Alembic::AbcGeom::IPolyMeshSchema m_schema;
 
   CDStreamConfig m_mesh_data;
 
+  std::shared_ptr<MeshSamplePrefetcher> m_prefetcher;
+
  public:
   AbcMeshReader(const Alembic::Abc::IObject &object, ImportSettings &settings);
 
@@ -35,7 +41,16 @@ class AbcMeshReader final : public AbcObjectReader {
   bool topology_changed(Mesh *existing_mesh,
                         const Alembic::Abc::ISampleSelector &sample_sel) override;
 
+  /** Read the samples of animated meshes ahead of time in the background. */
+  void set_prefetcher(std::shared_ptr<MeshSamplePrefetcher> prefetcher);
+
  private:
+  /** Get the sample from the prefetcher when it was read already, otherwise from the file. */
+  Alembic::AbcGeom::IPolyMeshSchema::Sample get_sample(
+      const Alembic::Abc::ISampleSelector &sample_sel);
+  /** Whether only the vertex data has to be read into the mesh, see #read_mesh(). */
+  bool can_reuse_topology(const Mesh *existing_mesh, int read_flag) const;
+
   void readFaceSetsSample(Main *bmain,
                           Mesh *mesh,
                           const Alembic::AbcGeom::ISampleSelector &sample_sel);
@@ -0,0 +1,161 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup balembic
+ */
+
+#include "abc_reader_prefetch.h"
+
+#include <algorithm>
+
+using Alembic::AbcGeom::IPolyMeshSchema;
+using Alembic::AbcGeom::ISampleSelector;
+
+namespace blender::io::alembic {
+
+/* Limit of the memory used by the cached samples. */
+static const size_t max_cache_bytes = size_t(512) << 20;
+/* Requests beyond this are dropped, oldest first. It prevents the queue from growing when the
+ * background thread can't keep up. */
+static const size_t max_queued_requests = 1024;
+
+static size_t sample_bytes(const IPolyMeshSchema::Sample &sample)
+{
+  size_t bytes = 0;
+  if (sample.getPositions()) {
+    bytes += sample.getPositions()->size() * sizeof(Imath::V3f);
+  }
+  if (sample.getVelocities()) {
+    bytes += sample.getVelocities()->size() * sizeof(Imath::V3f);
+  }
+  if (sample.getFaceIndices()) {
+    bytes += sample.getFaceIndices()->size() * sizeof(int32_t);
+  }
+  if (sample.getFaceCounts()) {
+    bytes += sample.getFaceCounts()->size() * sizeof(int32_t);
+  }
+  return bytes;
+}
+
+MeshSamplePrefetcher::~MeshSamplePrefetcher()
+{
+  stop();
+}
+
+bool MeshSamplePrefetcher::find(const std::string &object_path,
+                                const index_t index,
+                                IPolyMeshSchema::Sample &r_sample)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const auto it = m_samples.find(SampleKey(object_path, index));
+  if (it == m_samples.end()) {
+    return false;
+  }
+  r_sample = it->second;
+  return true;
+}
+
+void MeshSamplePrefetcher::request_after(const IPolyMeshSchema &schema,
+                                         const std::string &object_path,
+                                         const index_t index)
+{
+  const index_t last_index = std::min<index_t>(index + lookahead_samples,
+                                               index_t(schema.getNumSamples()) - 1);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_stop) {
+    return;
+  }
+
+  bool added_request = false;
+  for (index_t next_index = index + 1; next_index <= last_index; next_index++) {
+    SampleKey key(object_path, next_index);
+    if (m_samples.count(key) != 0) {
+      continue;
+    }
+    if (std::any_of(m_requests.begin(), m_requests.end(), [&](const Request &request) {
+          return request.key == key;
+        })) {
+      continue;
+    }
+    if (m_requests.size() >= max_queued_requests) {
+      m_requests.pop_front();
+    }
+    m_requests.push_back({schema, std::move(key)});
+    added_request = true;
+  }
+
+  if (!added_request) {
+    return;
+  }
+  if (!m_thread.joinable()) {
+    m_thread = std::thread([this]() { run(); });
+  }
+  m_condition.notify_one();
+}
+
+void MeshSamplePrefetcher::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+    m_requests.clear();
+  }
+  m_condition.notify_all();
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_samples.clear();
+  m_sample_order.clear();
+  m_cache_bytes = 0;
+}
+
+void MeshSamplePrefetcher::run()
+{
+  while (true) {
+    Request request;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_condition.wait(lock, [this]() { return m_stop || !m_requests.empty(); });
+      if (m_stop) {
+        return;
+      }
+      request = std::move(m_requests.front());
+      m_requests.pop_front();
+    }
+
+    IPolyMeshSchema::Sample sample;
+    try {
+      sample = request.schema.getValue(ISampleSelector(request.key.second));
+    }
+    catch (const std::exception &) {
+      /* The error is reported when the evaluation reads the sample itself. */
+      continue;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_stop) {
+      add_sample(request.key, sample);
+    }
+  }
+}
+
+void MeshSamplePrefetcher::add_sample(const SampleKey &key, const IPolyMeshSchema::Sample &sample)
+{
+  if (!m_samples.emplace(key, sample).second) {
+    return;
+  }
+  m_sample_order.push_back(key);
+  m_cache_bytes += sample_bytes(sample);
+
+  while (m_cache_bytes > max_cache_bytes && !m_sample_order.empty()) {
+    const auto it = m_samples.find(m_sample_order.front());
+    m_sample_order.pop_front();
+    m_cache_bytes -= sample_bytes(it->second);
+    m_samples.erase(it);
+  }
+}
+
+}  // namespace blender::io::alembic
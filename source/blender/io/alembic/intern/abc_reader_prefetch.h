@@ -0,0 +1,80 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+#pragma once
+
+/** \file
+ * \ingroup balembic
+ */
+
+#include <Alembic/AbcGeom/All.h>
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace blender::io::alembic {
+
+/**
+ * Reads the mesh samples of upcoming frames on a background thread, so that the evaluation of
+ * animated meshes during playback doesn't have to wait for the file.
+ *
+ * There is one prefetcher per archive, shared by the readers of all its objects. Samples are
+ * kept in a cache with a bounded size, the oldest samples are discarded first.
+ */
+class MeshSamplePrefetcher {
+  using index_t = Alembic::AbcCoreAbstract::index_t;
+  using SampleKey = std::pair<std::string, index_t>;
+
+  struct Request {
+    Alembic::AbcGeom::IPolyMeshSchema schema;
+    SampleKey key;
+  };
+
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::thread m_thread;
+  bool m_stop = false;
+
+  std::deque<Request> m_requests;
+
+  std::map<SampleKey, Alembic::AbcGeom::IPolyMeshSchema::Sample> m_samples;
+  /* Keys of #m_samples in the order they were added, for discarding the oldest samples. */
+  std::deque<SampleKey> m_sample_order;
+  size_t m_cache_bytes = 0;
+
+ public:
+  /** Number of samples after the current one that are requested by #request_after(). */
+  static constexpr int lookahead_samples = 3;
+
+  MeshSamplePrefetcher() = default;
+  MeshSamplePrefetcher(const MeshSamplePrefetcher &other) = delete;
+  MeshSamplePrefetcher &operator=(const MeshSamplePrefetcher &other) = delete;
+  ~MeshSamplePrefetcher();
+
+  /**
+   * Get a sample that was read in the background.
+   * \return False if the sample hasn't been read (yet).
+   */
+  bool find(const std::string &object_path,
+            index_t index,
+            Alembic::AbcGeom::IPolyMeshSchema::Sample &r_sample);
+
+  /** Queue the samples that follow the given sample index to be read in the background. */
+  void request_after(const Alembic::AbcGeom::IPolyMeshSchema &schema,
+                     const std::string &object_path,
+                     index_t index);
+
+  /**
+   * Stop the background thread and clear the cache. This must be called before the archive is
+   * closed, further requests are ignored.
+   */
+  void stop();
+
+ private:
+  void run();
+  void add_sample(const SampleKey &key, const Alembic::AbcGeom::IPolyMeshSchema::Sample &sample);
+};
+
+}  // namespace blender::io::alembic
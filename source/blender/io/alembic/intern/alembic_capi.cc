@@ -861,5 +861,9 @@ CacheReader *CacheReader_open_alembic_object(CacheArchiveHandle *handle,
   abc_reader->object(object);
   abc_reader->incref();
 
+  if (AbcMeshReader *mesh_reader = dynamic_cast<AbcMeshReader *>(abc_reader)) {
+    mesh_reader->set_prefetcher(archive->mesh_prefetcher());
+  }
+
   return reinterpret_cast<CacheReader *>(abc_reader);
 }
@@ -23,6 +23,9 @@
 
 #include "DEG_depsgraph.h"
 
+#include "BLI_vector.hh"
+
+#include <functional>
 #include <map>
 #include <set>
 #include <string>
@@ -208,6 +211,14 @@ class AbstractHierarchyIterator {
   WriterMap writers_;
   ExportSubset export_subset_;
 
+ private:
+  struct DeferredWrite {
+    std::function<void()> prepare;
+    std::function<void()> write;
+  };
+  /* Writes of the current iteration, see #defer_write(). */
+  Vector<DeferredWrite> deferred_writes_;
+
  public:
   explicit AbstractHierarchyIterator(Depsgraph *depsgraph);
   virtual ~AbstractHierarchyIterator();
@@ -220,6 +231,12 @@ class AbstractHierarchyIterator {
   /* Release all writers. Call after all frames have been exported. */
   void release_writers();
 
+  /* Defer a write of the current iteration, to convert expensive data of different writers in
+   * parallel. The `prepare` functions of all deferred writes run on multiple threads and must
+   * not touch the exported file. The `write` functions then run on the calling thread, in the
+   * order they were deferred in, before iterate_and_write() returns. */
+  void defer_write(std::function<void()> prepare, std::function<void()> write);
+
   /* Determine which subset of writers is used for exporting.
    * Set this before calling iterate_and_write().
    *
@@ -259,6 +276,8 @@ class AbstractHierarchyIterator {
   void context_update_for_graph_index(HierarchyContext *context,
                                       const ExportGraph::key_type &graph_index) const;
 
+  void write_deferred();
+
   void determine_export_paths(const HierarchyContext *parent_context);
   void determine_duplication_references(const HierarchyContext *parent_context,
                                         std::string indent);
@@ -18,6 +18,7 @@
 #include "BLI_assert.h"
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.h"
+#include "BLI_task.hh"
 
 #include "DNA_ID.h"
 #include "DNA_layer_types.h"
@@ -185,6 +186,29 @@ void AbstractHierarchyIterator::iterate_and_write()
   determine_duplication_references(HierarchyContext::root(), "");
   make_writers(HierarchyContext::root());
   export_graph_clear();
+  write_deferred();
+}
+
+void AbstractHierarchyIterator::defer_write(std::function<void()> prepare,
+                                            std::function<void()> write)
+{
+  deferred_writes_.append({std::move(prepare), std::move(write)});
+}
+
+void AbstractHierarchyIterator::write_deferred()
+{
+  /* Move the writes out of the member, so that they are released when writing throws. */
+  Vector<DeferredWrite> deferred_writes = std::move(deferred_writes_);
+  deferred_writes_.clear();
+
+  threading::parallel_for(deferred_writes.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      deferred_writes[i].prepare();
+    }
+  });
+  for (DeferredWrite &deferred_write : deferred_writes) {
+    deferred_write.write();
+  }
 }
 
 void AbstractHierarchyIterator::release_writers()
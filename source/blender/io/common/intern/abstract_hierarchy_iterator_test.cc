@@ -12,6 +12,7 @@
 #include "DNA_object_types.h"
 
 #include <map>
+#include <memory>
 #include <set>
 
 namespace blender::io {
@@ -305,6 +306,68 @@ TEST_F(AbstractHierarchyIteratorTest, ExportSubsetTest)
   EXPECT_EQ(expected_data, iterator->data_writers);
 }
 
+/* Writer that defers writing its export path to the list of written paths. */
+class DeferringHierarchyWriter : public AbstractHierarchyWriter {
+ public:
+  AbstractHierarchyIterator &iterator;
+  Vector<std::string> &deferred_paths;
+  Vector<std::string> &written_paths;
+
+  DeferringHierarchyWriter(AbstractHierarchyIterator &iterator,
+                           Vector<std::string> &deferred_paths,
+                           Vector<std::string> &written_paths)
+      : iterator(iterator), deferred_paths(deferred_paths), written_paths(written_paths)
+  {
+  }
+
+  void write(HierarchyContext &context) override
+  {
+    deferred_paths.append(context.export_path);
+    std::shared_ptr<std::string> prepared_path = std::make_shared<std::string>();
+    iterator.defer_write(
+        [prepared_path, export_path = context.export_path]() { *prepared_path = export_path; },
+        [prepared_path, this]() { written_paths.append(*prepared_path); });
+  }
+};
+
+class DeferringHierarchyIterator : public TestingHierarchyIterator {
+ public:
+  Vector<std::string> deferred_paths;
+  Vector<std::string> written_paths;
+
+  explicit DeferringHierarchyIterator(Depsgraph *depsgraph) : TestingHierarchyIterator(depsgraph)
+  {
+  }
+
+ protected:
+  AbstractHierarchyWriter *create_data_writer(const HierarchyContext * /*context*/) override
+  {
+    return new DeferringHierarchyWriter(*this, deferred_paths, written_paths);
+  }
+};
+
+TEST_F(AbstractHierarchyIteratorTest, DeferredWriteTest)
+{
+  if (!blendfile_load("usd/usd_hierarchy_export_test.blend")) {
+    return;
+  }
+  depsgraph_create(DAG_EVAL_RENDER);
+  DeferringHierarchyIterator *deferring_iterator = new DeferringHierarchyIterator(depsgraph);
+  iterator = deferring_iterator;
+
+  iterator->iterate_and_write();
+
+  /* All deferred writes are done when iterating returns, in the order they were deferred in. */
+  EXPECT_FALSE(deferring_iterator->deferred_paths.is_empty());
+  EXPECT_EQ(deferring_iterator->deferred_paths, deferring_iterator->written_paths);
+
+  /* Deferred writes don't carry over to the next iteration. */
+  deferring_iterator->deferred_paths.clear();
+  deferring_iterator->written_paths.clear();
+  iterator->iterate_and_write();
+  EXPECT_EQ(deferring_iterator->deferred_paths, deferring_iterator->written_paths);
+}
+
 /* Test class that constructs a depsgraph in such a way that it includes invisible objects. */
 class AbstractHierarchyIteratorInvisibleTest : public AbstractHierarchyIteratorTest {
  protected:
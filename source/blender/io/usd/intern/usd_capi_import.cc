@@ -30,6 +30,8 @@
 #include "BLI_math_rotation.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
 
 #include "DEG_depsgraph.h"
 #include "DEG_depsgraph_build.h"
@@ -191,7 +193,10 @@ static void import_startjob(void *customdata, short *stop, short *do_update, flo
   *data->do_update = true;
   *data->progress = 0.1f;
 
-  pxr::UsdStageRefPtr stage = pxr::UsdStage::Open(data->filename);
+  pxr::UsdStageRefPtr stage = pxr::UsdStage::Open(data->filename,
+                                                  data->params.load_payloads ?
+                                                      pxr::UsdStage::LoadAll :
+                                                      pxr::UsdStage::LoadNone);
 
   if (!stage) {
     WM_reportf(RPT_ERROR, "USD Import: unable to open stage to read %s", data->filename);
@@ -217,12 +222,36 @@ static void import_startjob(void *customdata, short *stop, short *do_update, flo
 
   *data->progress = 0.2f;
 
-  const float size = static_cast<float>(archive->readers().size());
+  /* Readers of instance prototypes, which are imported once and shared by all instances. */
+  Vector<USDPrimReader *> all_readers;
+  for (const auto &item : archive->proto_readers()) {
+    all_readers.extend(item.second.data(), item.second.size());
+  }
+  all_readers.extend(archive->readers().data(), archive->readers().size());
+
+  /* Read the data that doesn't need #Main, which is most of the work for meshes, in parallel. */
+  threading::parallel_for(all_readers.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t index : range) {
+      if (all_readers[index] && !G.is_break) {
+        all_readers[index]->prefetch_object_data(0.0);
+      }
+    }
+  });
+
+  *data->progress = 0.6f;
+  *data->do_update = true;
+
+  if (G.is_break) {
+    data->was_canceled = true;
+    return;
+  }
+
+  const float size = static_cast<float>(all_readers.size());
   size_t i = 0;
 
   /* Setup parenthood */
 
-  for (USDPrimReader *reader : archive->readers()) {
+  for (USDPrimReader *reader : all_readers) {
 
     if (!reader) {
       continue;
@@ -241,7 +270,7 @@ static void import_startjob(void *customdata, short *stop, short *do_update, flo
       ob->parent = parent->object();
     }
 
-    *data->progress = 0.2f + 0.8f * (++i / size);
+    *data->progress = 0.6f + 0.4f * (++i / size);
     *data->do_update = true;
 
     if (G.is_break) {
@@ -263,7 +292,12 @@ static void import_endjob(void *customdata)
   /* Delete objects on cancellation. */
   if (data->was_canceled && data->archive) {
 
-    for (USDPrimReader *reader : data->archive->readers()) {
+    std::vector<USDPrimReader *> readers = data->archive->readers();
+    for (const auto &item : data->archive->proto_readers()) {
+      readers.insert(readers.end(), item.second.begin(), item.second.end());
+    }
+
+    for (USDPrimReader *reader : readers) {
 
       if (!reader) {
         continue;
@@ -311,6 +345,9 @@ static void import_endjob(void *customdata)
                                ID_RECALC_BASE_FLAGS);
     }
 
+    /* Prototypes of instances go into a hidden collection, instanced by their instances. */
+    data->archive->create_proto_collections(data->bmain, lc->collection);
+
     DEG_id_tag_update(&data->scene->id, ID_RECALC_BASE_FLAGS);
     DEG_relations_tag_update(data->bmain);
   }
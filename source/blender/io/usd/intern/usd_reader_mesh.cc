@@ -7,6 +7,7 @@
 #include "usd_reader_material.h"
 
 #include "BKE_customdata.h"
+#include "BKE_lib_id.h"
 #include "BKE_main.h"
 #include "BKE_material.h"
 #include "BKE_mesh.h"
@@ -176,10 +177,19 @@ USDMeshReader::USDMeshReader(const pxr::UsdPrim &prim,
       is_left_handed_(false),
       has_uvs_(false),
       is_time_varying_(false),
-      is_initial_load_(false)
+      is_initial_load_(false),
+      is_prefetched_(false),
+      prefetched_mesh_(nullptr)
 {
 }
 
+USDMeshReader::~USDMeshReader()
+{
+  if (prefetched_mesh_) {
+    BKE_id_free(nullptr, prefetched_mesh_);
+  }
+}
+
 void USDMeshReader::create_object(Main *bmain, const double /* motionSampleTime */)
 {
   Mesh *mesh = BKE_mesh_add(bmain, name_.c_str());
@@ -188,15 +198,39 @@ void USDMeshReader::create_object(Main *bmain, const double /* motionSampleTime
   object_->data = mesh;
 }
 
-void USDMeshReader::read_object_data(Main *bmain, const double motionSampleTime)
+void USDMeshReader::prefetch_object_data(const double motionSampleTime)
 {
   Mesh *mesh = (Mesh *)object_->data;
 
+  /* Reading the mesh only creates a mesh outside of #Main, or modifies the (empty) mesh of this
+   * reader's object, so it can run in parallel with other readers. */
   is_initial_load_ = true;
   Mesh *read_mesh = this->read_mesh(
       mesh, motionSampleTime, import_params_.mesh_read_flag, nullptr);
-
   is_initial_load_ = false;
+
+  is_prefetched_ = true;
+  prefetched_mesh_ = read_mesh != mesh ? read_mesh : nullptr;
+}
+
+void USDMeshReader::read_object_data(Main *bmain, const double motionSampleTime)
+{
+  Mesh *mesh = (Mesh *)object_->data;
+
+  Mesh *read_mesh = mesh;
+  if (is_prefetched_) {
+    if (prefetched_mesh_) {
+      read_mesh = prefetched_mesh_;
+      prefetched_mesh_ = nullptr;
+    }
+    is_prefetched_ = false;
+  }
+  else {
+    is_initial_load_ = true;
+    read_mesh = this->read_mesh(mesh, motionSampleTime, import_params_.mesh_read_flag, nullptr);
+    is_initial_load_ = false;
+  }
+
   if (read_mesh != mesh) {
     /* FIXME: after 2.80; `mesh->flag` isn't copied by #BKE_mesh_nomain_to_mesh() */
     /* read_mesh can be freed by BKE_mesh_nomain_to_mesh(), so get the flag before that happens. */
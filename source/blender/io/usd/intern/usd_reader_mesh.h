@@ -38,14 +38,21 @@ class USDMeshReader : public USDGeomReader {
    * implemented.  Note this will break if faces or positions vary. */
   bool is_initial_load_;
 
+  /* Set by #prefetch_object_data(). The mesh is null when the data was read into the mesh of
+   * the object directly. */
+  bool is_prefetched_;
+  Mesh *prefetched_mesh_;
+
  public:
   USDMeshReader(const pxr::UsdPrim &prim,
                 const USDImportParams &import_params,
                 const ImportSettings &settings);
+  ~USDMeshReader() override;
 
   bool valid() const override;
 
   void create_object(Main *bmain, double motionSampleTime) override;
+  void prefetch_object_data(double motionSampleTime) override;
   void read_object_data(Main *bmain, double motionSampleTime) override;
 
   struct Mesh *read_mesh(struct Mesh *existing_mesh,
@@ -74,6 +74,9 @@ class USDPrimReader {
   virtual bool valid() const;
 
   virtual void create_object(Main *bmain, double motionSampleTime) = 0;
+  /* Read the data of the prim that doesn't need #Main, like mesh geometry. This is called for
+   * many readers in parallel, before #read_object_data() is called for each of them. */
+  virtual void prefetch_object_data(double /* motionSampleTime */){};
   virtual void read_object_data(Main * /* bmain */, double /* motionSampleTime */){};
 
   Object *object() const;
@@ -20,6 +20,12 @@
 #include <pxr/usd/usdGeom/xform.h>
 #include <pxr/usd/usdLux/light.h>
 
+#include "BKE_collection.h"
+#include "BKE_lib_id.h"
+
+#include "DNA_collection_types.h"
+#include "DNA_object_types.h"
+
 #include <iostream>
 
 namespace blender::io::usd {
@@ -187,7 +193,9 @@ static bool merge_with_parent(USDPrimReader *reader)
   return true;
 }
 
-USDPrimReader *USDStageReader::collect_readers(Main *bmain, const pxr::UsdPrim &prim)
+USDPrimReader *USDStageReader::collect_readers(Main *bmain,
+                                               const pxr::UsdPrim &prim,
+                                               std::vector<USDPrimReader *> &r_readers)
 {
   if (prim.IsA<pxr::UsdGeomImageable>()) {
     pxr::UsdGeomImageable imageable(prim);
@@ -201,6 +209,26 @@ USDPrimReader *USDStageReader::collect_readers(Main *bmain, const pxr::UsdPrim &
     }
   }
 
+  if (!params_.import_instance_proxies && prim.IsInstance()) {
+    /* The prototype is imported only once, the instance becomes an empty that instances the
+     * collection of the prototype. See #create_proto_collections(). */
+    const pxr::UsdPrim prototype = prim.GetPrototype();
+    if (prototype) {
+      const pxr::SdfPath &proto_path = prototype.GetPath();
+      if (proto_readers_.find(proto_path) == proto_readers_.end()) {
+        std::vector<USDPrimReader *> &proto_readers = proto_readers_[proto_path];
+        collect_readers(bmain, prototype, proto_readers);
+      }
+
+      USDPrimReader *reader = new USDXformReader(prim, params_, settings_);
+      reader->create_object(bmain, 0.0);
+      r_readers.push_back(reader);
+      reader->incref();
+      instance_readers_.emplace_back(reader, proto_path);
+      return reader;
+    }
+  }
+
   pxr::Usd_PrimFlagsPredicate filter_predicate = pxr::UsdPrimDefaultPredicate;
 
   if (params_.import_instance_proxies) {
@@ -212,7 +240,7 @@ USDPrimReader *USDStageReader::collect_readers(Main *bmain, const pxr::UsdPrim &
   std::vector<USDPrimReader *> child_readers;
 
   for (const auto &childPrim : children) {
-    if (USDPrimReader *child_reader = collect_readers(bmain, childPrim)) {
+    if (USDPrimReader *child_reader = collect_readers(bmain, childPrim, r_readers)) {
       child_readers.push_back(child_reader);
     }
   }
@@ -239,7 +267,7 @@ USDPrimReader *USDStageReader::collect_readers(Main *bmain, const pxr::UsdPrim &
 
   reader->create_object(bmain, 0.0);
 
-  readers_.push_back(reader);
+  r_readers.push_back(reader);
   reader->incref();
 
   /* Set each child reader's parent. */
@@ -264,6 +292,10 @@ void USDStageReader::collect_readers(Main *bmain)
   std::string prim_path_mask(params_.prim_path_mask);
 
   if (!prim_path_mask.empty()) {
+    if (!params_.load_payloads) {
+      /* Only load the payloads of the requested prim, its ancestors and its descendants. */
+      stage_->Load(pxr::SdfPath(prim_path_mask));
+    }
     pxr::UsdPrim prim = stage_->GetPrimAtPath(pxr::SdfPath(prim_path_mask));
     if (prim.IsValid()) {
       root = prim;
@@ -275,7 +307,42 @@ void USDStageReader::collect_readers(Main *bmain)
   }
 
   stage_->SetInterpolationType(pxr::UsdInterpolationType::UsdInterpolationTypeHeld);
-  collect_readers(bmain, root);
+  collect_readers(bmain, root, readers_);
+}
+
+void USDStageReader::create_proto_collections(Main *bmain, Collection *parent_collection)
+{
+  if (proto_readers_.empty()) {
+    return;
+  }
+
+  /* The prototypes are only visible through their instances. */
+  Collection *all_protos_collection = BKE_collection_add(bmain, parent_collection, "prototypes");
+  all_protos_collection->flag |= COLLECTION_HIDE_VIEWPORT | COLLECTION_HIDE_RENDER;
+
+  std::map<pxr::SdfPath, Collection *> proto_collection_map;
+  for (const auto &[proto_path, proto_readers] : proto_readers_) {
+    Collection *proto_collection = BKE_collection_add(
+        bmain, all_protos_collection, proto_path.GetName().c_str());
+    proto_collection_map[proto_path] = proto_collection;
+
+    for (USDPrimReader *reader : proto_readers) {
+      if (Object *ob = reader->object()) {
+        BKE_collection_object_add(bmain, proto_collection, ob);
+      }
+    }
+  }
+
+  for (const auto &[reader, proto_path] : instance_readers_) {
+    Object *instance_ob = reader->object();
+    Collection *proto_collection = proto_collection_map[proto_path];
+    if (instance_ob == nullptr || proto_collection == nullptr) {
+      continue;
+    }
+    instance_ob->instance_collection = proto_collection;
+    instance_ob->transflag |= OB_DUPLICOLLECTION;
+    id_us_plus(&proto_collection->id);
+  }
 }
 
 void USDStageReader::clear_readers()
@@ -293,6 +360,19 @@ void USDStageReader::clear_readers()
   }
 
   readers_.clear();
+
+  for (const auto &[proto_path, proto_readers] : proto_readers_) {
+    for (USDPrimReader *reader : proto_readers) {
+      reader->decref();
+
+      if (reader->refcount() == 0) {
+        delete reader;
+      }
+    }
+  }
+
+  proto_readers_.clear();
+  instance_readers_.clear();
 }
 
 }  // Namespace blender::io::usd
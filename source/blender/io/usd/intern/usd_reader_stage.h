@@ -2,6 +2,7 @@
  * Copyright 2021 Tangent Animation and. NVIDIA Corporation. All rights reserved. */
 #pragma once
 
+struct Collection;
 struct Main;
 
 #include "usd.h"
@@ -27,6 +28,12 @@ class USDStageReader {
 
   std::vector<USDPrimReader *> readers_;
 
+  /* Readers of the prims in each prototype of native USD instances, by prototype path. These are
+   * only used when instance proxies are not imported. */
+  ProtoReaderMap proto_readers_;
+  /* Readers of instance prims, with the path of the prototype they instance. */
+  std::vector<std::pair<USDPrimReader *, pxr::SdfPath>> instance_readers_;
+
  public:
   USDStageReader(pxr::UsdStageRefPtr stage,
                  const USDImportParams &params,
@@ -63,8 +70,22 @@ class USDStageReader {
     return readers_;
   };
 
+  const ProtoReaderMap &proto_readers() const
+  {
+    return proto_readers_;
+  };
+
+  /**
+   * Create a collection for every prototype with the objects of its readers, and make the
+   * objects of the instance prims instance these collections. The prototype collections are
+   * added to a hidden "prototypes" collection in `parent_collection`.
+   */
+  void create_proto_collections(Main *bmain, Collection *parent_collection);
+
  private:
-  USDPrimReader *collect_readers(Main *bmain, const pxr::UsdPrim &prim);
+  USDPrimReader *collect_readers(Main *bmain,
+                                 const pxr::UsdPrim &prim,
+                                 std::vector<USDPrimReader *> &r_readers);
 
   /**
    * Returns true if the given prim should be included in the
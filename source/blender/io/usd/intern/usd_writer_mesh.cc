@@ -28,6 +28,7 @@
 #include "DNA_particle_types.h"
 
 #include <iostream>
+#include <memory>
 
 namespace blender::io::usd {
 
@@ -53,19 +54,33 @@ void USDGenericMeshWriter::do_write(HierarchyContext &context)
     return;
   }
 
-  try {
-    write_mesh(context, mesh);
-
+  /* The mesh is freed when the deferred write is done, or when it is discarded. */
+  std::shared_ptr<Mesh> export_mesh(mesh, [this, needsfree](Mesh *mesh_to_free) {
     if (needsfree) {
-      free_export_mesh(mesh);
+      free_export_mesh(mesh_to_free);
     }
-  }
-  catch (...) {
-    if (needsfree) {
-      free_export_mesh(mesh);
-    }
-    throw;
-  }
+  });
+  std::shared_ptr<USDMeshData> usd_mesh_data = std::make_shared<USDMeshData>();
+  const bool is_instance = usd_export_context_.export_params.use_instancing &&
+                           context.is_instance();
+  const bool is_first_frame = !frame_has_been_written_;
+
+  /* Define the prim right away, so that the order of the prims in the hierarchy is the same as
+   * when writing everything directly. */
+  pxr::UsdGeomMesh::Define(usd_export_context_.stage, usd_export_context_.usd_path);
+
+  /* Converting the mesh to USD arrays only reads the mesh, so that is done in parallel with the
+   * other meshes of the frame. Authoring on the stage is not thread-safe. */
+  usd_export_context_.hierarchy_iterator->defer_write(
+      [this, export_mesh, usd_mesh_data, is_instance]() {
+        get_geometry_data(export_mesh.get(), *usd_mesh_data);
+        if (!is_instance) {
+          get_attribute_data(export_mesh.get(), *usd_mesh_data);
+        }
+      },
+      [this, context, export_mesh, usd_mesh_data, is_first_frame]() {
+        write_mesh(context, *usd_mesh_data, is_first_frame);
+      });
 }
 
 void USDGenericMeshWriter::free_export_mesh(Mesh *mesh)
@@ -100,12 +115,18 @@ struct USDMeshData {
   pxr::VtIntArray corner_indices;
   /* The per-vertex sharpnesses. The lengths of this array must match that of `corner_indices`. */
   pxr::VtFloatArray corner_sharpnesses;
+
+  /* UV maps with their primvar names. */
+  std::vector<std::pair<pxr::TfToken, pxr::VtArray<pxr::GfVec2f>>> uv_maps;
+  /* Face-varying normals. */
+  pxr::VtVec3fArray loop_normals;
+  /* Per-vertex velocities, only when the mesh has a velocity attribute. */
+  pxr::VtVec3fArray velocities;
+  bool has_velocities = false;
 };
 
-void USDGenericMeshWriter::write_uv_maps(const Mesh *mesh, pxr::UsdGeomMesh usd_mesh)
+static void get_uv_maps(const Mesh *mesh, USDMeshData &usd_mesh_data)
 {
-  pxr::UsdTimeCode timecode = get_export_time_code();
-
   const CustomData *ldata = &mesh->ldata;
   for (int layer_idx = 0; layer_idx < ldata->totlayer; layer_idx++) {
     const CustomDataLayer *layer = &ldata->layers[layer_idx];
@@ -118,14 +139,24 @@ void USDGenericMeshWriter::write_uv_maps(const Mesh *mesh, pxr::UsdGeomMesh usd_
      * for texture coordinates by naming the UV Map as such, without having to guess which UV Map
      * is the "standard" one. */
     pxr::TfToken primvar_name(pxr::TfMakeValidIdentifier(layer->name));
-    pxr::UsdGeomPrimvar uv_coords_primvar = usd_mesh.CreatePrimvar(
-        primvar_name, pxr::SdfValueTypeNames->TexCoord2fArray, pxr::UsdGeomTokens->faceVarying);
 
-    MLoopUV *mloopuv = static_cast<MLoopUV *>(layer->data);
-    pxr::VtArray<pxr::GfVec2f> uv_coords;
+    const MLoopUV *mloopuv = static_cast<const MLoopUV *>(layer->data);
+    pxr::VtArray<pxr::GfVec2f> uv_coords(mesh->totloop);
     for (int loop_idx = 0; loop_idx < mesh->totloop; loop_idx++) {
-      uv_coords.push_back(pxr::GfVec2f(mloopuv[loop_idx].uv));
+      uv_coords[loop_idx] = pxr::GfVec2f(mloopuv[loop_idx].uv);
     }
+    usd_mesh_data.uv_maps.emplace_back(primvar_name, std::move(uv_coords));
+  }
+}
+
+void USDGenericMeshWriter::write_uv_maps(const USDMeshData &usd_mesh_data,
+                                         pxr::UsdGeomMesh usd_mesh)
+{
+  pxr::UsdTimeCode timecode = get_export_time_code();
+
+  for (const auto &[primvar_name, uv_coords] : usd_mesh_data.uv_maps) {
+    pxr::UsdGeomPrimvar uv_coords_primvar = usd_mesh.CreatePrimvar(
+        primvar_name, pxr::SdfValueTypeNames->TexCoord2fArray, pxr::UsdGeomTokens->faceVarying);
 
     if (!uv_coords_primvar.HasValue()) {
       uv_coords_primvar.Set(uv_coords, pxr::UsdTimeCode::Default());
@@ -135,7 +166,9 @@ void USDGenericMeshWriter::write_uv_maps(const Mesh *mesh, pxr::UsdGeomMesh usd_
   }
 }
 
-void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
+void USDGenericMeshWriter::write_mesh(const HierarchyContext &context,
+                                      const USDMeshData &usd_mesh_data,
+                                      const bool is_first_frame)
 {
   pxr::UsdTimeCode timecode = get_export_time_code();
   pxr::UsdTimeCode defaultTime = pxr::UsdTimeCode::Default();
@@ -145,9 +178,6 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
   pxr::UsdGeomMesh usd_mesh = pxr::UsdGeomMesh::Define(stage, usd_path);
   write_visibility(context, timecode, usd_mesh);
 
-  USDMeshData usd_mesh_data;
-  get_geometry_data(mesh, usd_mesh_data);
-
   if (usd_export_context_.export_params.use_instancing && context.is_instance()) {
     if (!mark_as_instance(context, usd_mesh.GetPrim())) {
       return;
@@ -222,15 +252,15 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
   }
 
   if (usd_export_context_.export_params.export_uvmaps) {
-    write_uv_maps(mesh, usd_mesh);
+    write_uv_maps(usd_mesh_data, usd_mesh);
   }
   if (usd_export_context_.export_params.export_normals) {
-    write_normals(mesh, usd_mesh);
+    write_normals(usd_mesh_data, usd_mesh);
   }
-  write_surface_velocity(mesh, usd_mesh);
+  write_surface_velocity(usd_mesh_data, usd_mesh);
 
   /* TODO(Sybren): figure out what happens when the face groups change. */
-  if (frame_has_been_written_) {
+  if (!is_first_frame) {
     return;
   }
 
@@ -243,11 +273,11 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
 
 static void get_vertices(const Mesh *mesh, USDMeshData &usd_mesh_data)
 {
-  usd_mesh_data.points.reserve(mesh->totvert);
+  usd_mesh_data.points.resize(mesh->totvert);
 
   const MVert *verts = mesh->mvert;
   for (int i = 0; i < mesh->totvert; ++i) {
-    usd_mesh_data.points.push_back(pxr::GfVec3f(verts[i].co));
+    usd_mesh_data.points[i] = pxr::GfVec3f(verts[i].co);
   }
 }
 
@@ -257,16 +287,19 @@ static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
    * assignments. */
   bool construct_face_groups = mesh->totcol > 1;
 
-  usd_mesh_data.face_vertex_counts.reserve(mesh->totpoly);
-  usd_mesh_data.face_indices.reserve(mesh->totloop);
+  usd_mesh_data.face_vertex_counts.resize(mesh->totpoly);
+  usd_mesh_data.face_indices.resize(mesh->totloop);
 
+  int *face_vertex_counts = usd_mesh_data.face_vertex_counts.data();
+  int *face_indices = usd_mesh_data.face_indices.data();
+  int face_index = 0;
   MLoop *mloop = mesh->mloop;
   MPoly *mpoly = mesh->mpoly;
   for (int i = 0; i < mesh->totpoly; ++i, ++mpoly) {
     MLoop *loop = mloop + mpoly->loopstart;
-    usd_mesh_data.face_vertex_counts.push_back(mpoly->totloop);
+    face_vertex_counts[i] = mpoly->totloop;
     for (int j = 0; j < mpoly->totloop; ++j, ++loop) {
-      usd_mesh_data.face_indices.push_back(loop->v);
+      face_indices[face_index++] = loop->v;
     }
 
     if (construct_face_groups) {
@@ -388,18 +421,17 @@ void USDGenericMeshWriter::assign_materials(const HierarchyContext &context,
   }
 }
 
-void USDGenericMeshWriter::write_normals(const Mesh *mesh, pxr::UsdGeomMesh usd_mesh)
+static void get_normals(const Mesh *mesh, USDMeshData &usd_mesh_data)
 {
-  pxr::UsdTimeCode timecode = get_export_time_code();
   const float(*lnors)[3] = static_cast<float(*)[3]>(CustomData_get_layer(&mesh->ldata, CD_NORMAL));
 
-  pxr::VtVec3fArray loop_normals;
-  loop_normals.reserve(mesh->totloop);
+  pxr::VtVec3fArray &loop_normals = usd_mesh_data.loop_normals;
+  loop_normals.resize(mesh->totloop);
 
   if (lnors != nullptr) {
     /* Export custom loop normals. */
     for (int loop_idx = 0, totloop = mesh->totloop; loop_idx < totloop; ++loop_idx) {
-      loop_normals.push_back(pxr::GfVec3f(lnors[loop_idx]));
+      loop_normals[loop_idx] = pxr::GfVec3f(lnors[loop_idx]);
     }
   }
   else {
@@ -409,22 +441,30 @@ void USDGenericMeshWriter::write_normals(const Mesh *mesh, pxr::UsdGeomMesh usd_
     MPoly *mpoly = mesh->mpoly;
     for (int poly_idx = 0, totpoly = mesh->totpoly; poly_idx < totpoly; ++poly_idx, ++mpoly) {
       MLoop *mloop = mesh->mloop + mpoly->loopstart;
+      pxr::GfVec3f *poly_normals = loop_normals.data() + mpoly->loopstart;
 
       if ((mpoly->flag & ME_SMOOTH) == 0) {
         /* Flat shaded, use common normal for all verts. */
         pxr::GfVec3f pxr_normal(face_normals[poly_idx]);
         for (int loop_idx = 0; loop_idx < mpoly->totloop; ++loop_idx) {
-          loop_normals.push_back(pxr_normal);
+          poly_normals[loop_idx] = pxr_normal;
         }
       }
       else {
         /* Smooth shaded, use individual vert normals. */
         for (int loop_idx = 0; loop_idx < mpoly->totloop; ++loop_idx, ++mloop) {
-          loop_normals.push_back(pxr::GfVec3f(vert_normals[mloop->v]));
+          poly_normals[loop_idx] = pxr::GfVec3f(vert_normals[mloop->v]);
         }
       }
     }
   }
+}
+
+void USDGenericMeshWriter::write_normals(const USDMeshData &usd_mesh_data,
+                                         pxr::UsdGeomMesh usd_mesh)
+{
+  pxr::UsdTimeCode timecode = get_export_time_code();
+  const pxr::VtVec3fArray &loop_normals = usd_mesh_data.loop_normals;
 
   pxr::UsdAttribute attr_normals = usd_mesh.CreateNormalsAttr(pxr::VtValue(), true);
   if (!attr_normals.HasValue()) {
@@ -434,7 +474,7 @@ void USDGenericMeshWriter::write_normals(const Mesh *mesh, pxr::UsdGeomMesh usd_
   usd_mesh.SetNormalsInterpolation(pxr::UsdGeomTokens->faceVarying);
 }
 
-void USDGenericMeshWriter::write_surface_velocity(const Mesh *mesh, pxr::UsdGeomMesh usd_mesh)
+static void get_surface_velocity(const Mesh *mesh, USDMeshData &usd_mesh_data)
 {
   /* Export velocity attribute output by fluid sim, sequence cache modifier
    * and geometry nodes. */
@@ -448,15 +488,35 @@ void USDGenericMeshWriter::write_surface_velocity(const Mesh *mesh, pxr::UsdGeom
   const float(*velocities)[3] = reinterpret_cast<float(*)[3]>(velocity_layer->data);
 
   /* Export per-vertex velocity vectors. */
-  pxr::VtVec3fArray usd_velocities;
-  usd_velocities.reserve(mesh->totvert);
+  pxr::VtVec3fArray &usd_velocities = usd_mesh_data.velocities;
+  usd_velocities.resize(mesh->totvert);
 
   for (int vertex_idx = 0, totvert = mesh->totvert; vertex_idx < totvert; ++vertex_idx) {
-    usd_velocities.push_back(pxr::GfVec3f(velocities[vertex_idx]));
+    usd_velocities[vertex_idx] = pxr::GfVec3f(velocities[vertex_idx]);
+  }
+  usd_mesh_data.has_velocities = true;
+}
+
+void USDGenericMeshWriter::write_surface_velocity(const USDMeshData &usd_mesh_data,
+                                                  pxr::UsdGeomMesh usd_mesh)
+{
+  if (!usd_mesh_data.has_velocities) {
+    return;
   }
 
   pxr::UsdTimeCode timecode = get_export_time_code();
-  usd_mesh.CreateVelocitiesAttr().Set(usd_velocities, timecode);
+  usd_mesh.CreateVelocitiesAttr().Set(usd_mesh_data.velocities, timecode);
+}
+
+void USDGenericMeshWriter::get_attribute_data(const Mesh *mesh, USDMeshData &usd_mesh_data)
+{
+  if (usd_export_context_.export_params.export_uvmaps) {
+    get_uv_maps(mesh, usd_mesh_data);
+  }
+  if (usd_export_context_.export_params.export_normals) {
+    get_normals(mesh, usd_mesh_data);
+  }
+  get_surface_velocity(mesh, usd_mesh_data);
 }
 
 USDMeshWriter::USDMeshWriter(const USDExporterContext &ctx) : USDGenericMeshWriter(ctx)
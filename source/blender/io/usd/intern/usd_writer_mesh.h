@@ -26,14 +26,19 @@ class USDGenericMeshWriter : public USDAbstractWriter {
   /* Mapping from material slot number to array of face indices with that material. */
   typedef std::map<short, pxr::VtIntArray> MaterialFaceGroups;
 
-  void write_mesh(HierarchyContext &context, Mesh *mesh);
-  void get_geometry_data(const Mesh *mesh, struct USDMeshData &usd_mesh_data);
+  /* Author the converted mesh data on the stage. */
+  void write_mesh(const HierarchyContext &context,
+                  const USDMeshData &usd_mesh_data,
+                  bool is_first_frame);
+  /* Convert the mesh to USD arrays, without touching the stage. These can run on any thread. */
+  void get_geometry_data(const Mesh *mesh, USDMeshData &usd_mesh_data);
+  void get_attribute_data(const Mesh *mesh, USDMeshData &usd_mesh_data);
   void assign_materials(const HierarchyContext &context,
                         pxr::UsdGeomMesh usd_mesh,
                         const MaterialFaceGroups &usd_face_groups);
-  void write_uv_maps(const Mesh *mesh, pxr::UsdGeomMesh usd_mesh);
-  void write_normals(const Mesh *mesh, pxr::UsdGeomMesh usd_mesh);
-  void write_surface_velocity(const Mesh *mesh, pxr::UsdGeomMesh usd_mesh);
+  void write_uv_maps(const USDMeshData &usd_mesh_data, pxr::UsdGeomMesh usd_mesh);
+  void write_normals(const USDMeshData &usd_mesh_data, pxr::UsdGeomMesh usd_mesh);
+  void write_surface_velocity(const USDMeshData &usd_mesh_data, pxr::UsdGeomMesh usd_mesh);
 };
 
 class USDMeshWriter : public USDGenericMeshWriter {
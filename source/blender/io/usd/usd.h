@@ -48,6 +48,7 @@ struct USDImportParams {
   char *prim_path_mask;
   bool import_subdiv;
   bool import_instance_proxies;
+  bool load_payloads;
   bool create_collection;
   bool import_guide;
   bool import_proxy;
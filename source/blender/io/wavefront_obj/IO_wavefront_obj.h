@@ -77,8 +77,25 @@ struct OBJExportParams {
   bool smooth_groups_bitflags;
 };
 
+struct OBJImportParams {
+  /** Full path to the source .OBJ file to import. */
+  char filepath[FILE_MAX];
+  /** Value 0 disables clamping. */
+  float clamp_size;
+  eTransformAxisForward forward_axis;
+  eTransformAxisUp up_axis;
+  /** Start a new object for every `o` statement. */
+  bool use_split_objects;
+  /** Start a new object for every `g` statement. */
+  bool use_split_groups;
+  /** Run a mesh validation pass on every imported mesh. */
+  bool validate_meshes;
+};
+
 void OBJ_export(bContext *C, const struct OBJExportParams *export_params);
 
+void OBJ_import(bContext *C, const struct OBJImportParams *import_params);
+
 #ifdef __cplusplus
 }
 #endif
@@ -334,15 +334,15 @@ void OBJWriter::write_edges_indices(FormatHandler<eFileType::OBJ> &fh,
 {
   /* Note: ensure_mesh_edges should be called before. */
   const int tot_edges = obj_mesh_data.tot_edges();
-  for (int edge_index = 0; edge_index < tot_edges; edge_index++) {
+  obj_parallel_chunked_output(fh, tot_edges, [&](FormatHandler<eFileType::OBJ> &buf, int i) {
     const std::optional<std::array<int, 2>> vertex_indices =
-        obj_mesh_data.calc_loose_edge_vert_indices(edge_index);
+        obj_mesh_data.calc_loose_edge_vert_indices(i);
     if (!vertex_indices) {
-      continue;
+      return;
     }
-    fh.write<eOBJSyntaxElement::edge>((*vertex_indices)[0] + offsets.vertex_offset + 1,
-                                      (*vertex_indices)[1] + offsets.vertex_offset + 1);
-  }
+    buf.write<eOBJSyntaxElement::edge>((*vertex_indices)[0] + offsets.vertex_offset + 1,
+                                       (*vertex_indices)[1] + offsets.vertex_offset + 1);
+  });
 }
 
 void OBJWriter::write_nurbs_curve(FormatHandler<eFileType::OBJ> &fh,
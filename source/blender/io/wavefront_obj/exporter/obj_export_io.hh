@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <string>
 #include <system_error>
 #include <type_traits>
@@ -263,6 +265,147 @@ constexpr FormattingSyntax syntax_elem_to_formatting(const eMTLSyntaxElement key
 #  pragma GCC diagnostic pop
 #endif
 
+/* -------------------------------------------------------------------- */
+/** \name Number formatting
+ *
+ * Most of the export time of large meshes goes into formatting the numbers of vertices, UVs,
+ * normals and face indices. These functions produce exactly what `printf` produces for the
+ * conversions used by the syntax elements above, without the locale and format string
+ * overhead.
+ * \{ */
+
+/** Buffer space needed for one number written by #format_number. */
+constexpr int number_buffer_size = 64;
+
+inline char *format_uint(char *dst, uint64_t value)
+{
+  char digits[20];
+  int len = 0;
+  do {
+    digits[len++] = char('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  while (len > 0) {
+    *dst++ = digits[--len];
+  }
+  return dst;
+}
+
+/** Same result as `printf("%d", value)`. */
+inline char *format_int(char *dst, const int64_t value)
+{
+  if (value < 0) {
+    *dst++ = '-';
+    return format_uint(dst, ~uint64_t(value) + 1);
+  }
+  return format_uint(dst, uint64_t(value));
+}
+
+/**
+ * Same result as `printf("%.*f", precision, value)` for finite values below 2^40 in magnitude
+ * and a precision of at most 6 digits, which covers all coordinates written in practice.
+ * The float is converted exactly and rounded to nearest with ties to even, like the C library.
+ * \return The end of the written text, or null if the value is not handled.
+ */
+inline char *format_fixed_float(char *dst, const float value, const int precision)
+{
+  static const uint64_t powers_of_ten[] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+  if (precision < 0 || precision > 6) {
+    return nullptr;
+  }
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  const int exponent_bits = (bits >> 23) & 0xff;
+  if (exponent_bits == 0xff) {
+    /* Infinity or NaN. */
+    return nullptr;
+  }
+  /* The value is `mantissa * 2^exponent`. */
+  uint64_t mantissa = bits & 0x7fffff;
+  int exponent = -149;
+  if (exponent_bits != 0) {
+    mantissa |= 0x800000;
+    exponent = exponent_bits - 150;
+  }
+  const uint64_t scale = powers_of_ten[precision];
+  uint64_t scaled;
+  if (exponent >= 0) {
+    if (exponent > 16) {
+      return nullptr;
+    }
+    scaled = (mantissa << exponent) * scale;
+  }
+  else {
+    /* Less than 2^44, so values with a larger shift round to zero. */
+    const uint64_t product = mantissa * scale;
+    const int shift = -exponent;
+    if (shift > 45) {
+      scaled = 0;
+    }
+    else {
+      scaled = product >> shift;
+      const uint64_t remainder = product & ((uint64_t(1) << shift) - 1);
+      const uint64_t half = uint64_t(1) << (shift - 1);
+      if (remainder > half || (remainder == half && (scaled & 1))) {
+        scaled++;
+      }
+    }
+  }
+  /* The sign is written for negative zero and values that round to zero too. */
+  if (bits >> 31) {
+    *dst++ = '-';
+  }
+  dst = format_uint(dst, scaled / scale);
+  if (precision > 0) {
+    *dst++ = '.';
+    uint64_t fraction = scaled % scale;
+    for (int i = precision - 1; i >= 0; i--) {
+      dst[i] = char('0' + fraction % 10);
+      fraction /= 10;
+    }
+    dst += precision;
+  }
+  return dst;
+}
+
+/**
+ * Copy the format string up to the next conversion, write `value` with that conversion and
+ * advance `fmt` past it. Only `%d`, `%f` and `%.Nf` are supported.
+ * \return The end of the written text.
+ */
+template<typename T> inline char *format_number(char *dst, const char *&fmt, const T value)
+{
+  while (*fmt != '%') {
+    BLI_assert(*fmt != '\0');
+    *dst++ = *fmt++;
+  }
+  fmt++;
+  int precision = 6;
+  if (*fmt == '.') {
+    fmt++;
+    precision = 0;
+    while (*fmt >= '0' && *fmt <= '9') {
+      precision = precision * 10 + (*fmt++ - '0');
+    }
+  }
+  if constexpr (std::is_integral_v<T>) {
+    BLI_assert(*fmt == 'd');
+    fmt++;
+    return format_int(dst, value);
+  }
+  else {
+    BLI_assert(*fmt == 'f');
+    fmt++;
+    char *end = format_fixed_float(dst, value, precision);
+    if (end == nullptr) {
+      end = dst + std::snprintf(dst, number_buffer_size, "%.*f", precision, double(value));
+    }
+    return end;
+  }
+}
+
+/** \} */
+
 /**
  * File format and syntax agnostic file buffer writer.
  * All writes are done into an internal chunked memory buffer
@@ -355,6 +498,9 @@ class FormatHandler : NonCopyable, NonMovable {
     }
   }
 
+  /** Upper bound of the length of the format strings with only number arguments. */
+  static constexpr size_t max_literal_len = 32;
+
   /* Ensure the last block contains at least this amount of free space.
    * If not, add a new block with max of block size & the amount of space needed. */
   void ensure_space(size_t at_least)
@@ -374,6 +520,21 @@ class FormatHandler : NonCopyable, NonMovable {
       VectorChar &bb = blocks_.back();
       bb.insert(bb.end(), fmt, fmt + len);
     }
+    else if constexpr (is_type_integral<T...> ||
+                       (... && std::is_same_v<remove_cvref_t<T>, float>)) {
+      /* Numbers only: format them directly, this is the hot path for mesh data. */
+      char buf[max_literal_len + number_buffer_size * sizeof...(T)];
+      BLI_assert(strlen(fmt) < max_literal_len);
+      char *end = buf;
+      ((end = format_number(end, fmt, args)), ...);
+      while (*fmt != '\0') {
+        *end++ = *fmt++;
+      }
+      const size_t len = end - buf;
+      ensure_space(len + 1);
+      VectorChar &bb = blocks_.back();
+      bb.insert(bb.end(), buf, end);
+    }
     else {
       /* Format into a local buffer. */
       char buf[write_local_buffer_size];
@@ -0,0 +1,690 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup obj
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <fcntl.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_fileops.h"
+#include "BLI_map.hh"
+#include "BLI_mmap.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "BLI_string_ref.hh"
+#include "BLI_task.hh"
+#include "BLI_vector_set.hh"
+
+#ifndef WIN32
+#  include <unistd.h>
+#else
+#  include <io.h>
+#endif
+
+#include "obj_import_file_reader.hh"
+#include "obj_import_string_utils.hh"
+
+namespace blender::io::obj {
+
+/**
+ * Size of the pieces the file is split into for parallel parsing. Large enough to keep the
+ * per chunk overhead low, small enough for good load balancing. It also keeps chunk local
+ * element counts far below #RELATIVE_INDEX_BIAS.
+ */
+static const int64_t chunk_size = 8 * 1024 * 1024;
+
+/**
+ * Split the buffer into pieces of about `chunk_size` bytes, ending at line boundaries.
+ */
+static Vector<StringRef> split_into_chunks(const StringRef buffer)
+{
+  Vector<StringRef> chunks;
+  const char *start = buffer.begin();
+  const char *end = buffer.end();
+  while (start < end) {
+    const char *split = start + std::min<int64_t>(chunk_size, end - start);
+    if (split < end) {
+      /* Move the split to the start of the next line. Start one character early, so that a
+       * split right after a line break stays where it is. */
+      StringRef rest(split - 1, end);
+      read_next_line(rest);
+      split = rest.begin();
+    }
+    chunks.append(StringRef(start, split));
+    start = split;
+  }
+  return chunks;
+}
+
+/**
+ * Convert a one-based (or negative, relative) index as written in the file to the
+ * representation described at #RELATIVE_INDEX_BIAS.
+ * \param local_count: Number of elements of this type so far in the chunk.
+ */
+static int encode_index(const int index, const int local_count)
+{
+  if (index > 0) {
+    return index - 1;
+  }
+  if (index < 0 && index > -RELATIVE_INDEX_BIAS) {
+    return local_count + index - RELATIVE_INDEX_BIAS;
+  }
+  return INVALID_INDEX;
+}
+
+/**
+ * Inverse of #encode_index, once the number of elements before the chunk is known.
+ * \return The global index, or #INVALID_INDEX if it is out of range.
+ */
+static int resolve_index(const int index, const int chunk_offset, const int total)
+{
+  int resolved = index;
+  if (index < INVALID_INDEX) {
+    resolved = chunk_offset + (index + RELATIVE_INDEX_BIAS);
+  }
+  return (resolved >= 0 && resolved < total) ? resolved : INVALID_INDEX;
+}
+
+static bool is_unsupported_keyword(const StringRef keyword)
+{
+  /* Free-form curves and surfaces, and point elements. */
+  return ELEM(keyword,
+              "vp",
+              "cstype",
+              "deg",
+              "bmat",
+              "step",
+              "curv",
+              "curv2",
+              "surf",
+              "parm",
+              "trim",
+              "hole",
+              "scrv",
+              "sp",
+              "end",
+              "con",
+              "p");
+}
+
+OBJParser::OBJParser(const OBJImportParams &import_params) : import_params_(import_params)
+{
+}
+
+void OBJParser::parse_chunk(StringRef buffer, OBJChunk &r_chunk) const
+{
+  /* The first segment continues the last object of the previous chunk. */
+  r_chunk.segments.append(std::make_unique<GeometrySegment>());
+  GeometrySegment *segment = r_chunk.segments.last().get();
+  segment->continues_previous = true;
+
+  /* Start a new segment for a new object. An empty current segment is reused, so that objects
+   * without faces or edges don't produce empty meshes. */
+  auto start_segment = [&](const StringRef name) {
+    if (!segment->is_empty()) {
+      r_chunk.segments.append(std::make_unique<GeometrySegment>());
+      segment = r_chunk.segments.last().get();
+    }
+    segment->name = name;
+    segment->continues_previous = false;
+  };
+
+  Map<std::string, int> material_indices;
+  int current_material = -1;
+  int8_t current_smooth = -1;
+
+  while (!buffer.is_empty()) {
+    const StringRef line = drop_whitespace(read_next_line(buffer));
+    if (line.is_empty() || line[0] == '#') {
+      continue;
+    }
+    const StringRef rest = drop_non_whitespace(line);
+    const StringRef keyword(line.begin(), rest.begin());
+
+    if (keyword == "v") {
+      float values[6];
+      int count;
+      parse_floats(rest, 0.0f, values, 6, &count);
+      const float3 position(values[0], values[1], values[2]);
+      r_chunk.max_abs_coordinate = std::max(
+          {r_chunk.max_abs_coordinate, fabsf(position.x), fabsf(position.y), fabsf(position.z)});
+      if (count == 6) {
+        if (r_chunk.colors.is_empty()) {
+          r_chunk.colors.resize(r_chunk.positions.size(), float3(1.0f));
+        }
+        r_chunk.colors.append(float3(values[3], values[4], values[5]));
+      }
+      else if (!r_chunk.colors.is_empty()) {
+        r_chunk.colors.append(float3(1.0f));
+      }
+      r_chunk.positions.append(position);
+    }
+    else if (keyword == "vt") {
+      float2 uv;
+      parse_floats(rest, 0.0f, uv, 2);
+      r_chunk.uvs.append(uv);
+    }
+    else if (keyword == "vn") {
+      float3 normal;
+      parse_floats(rest, 0.0f, normal, 3);
+      r_chunk.normals.append(normal);
+    }
+    else if (keyword == "f") {
+      PolyElem face;
+      face.start_index = segment->corners.size();
+      face.material_index = current_material;
+      face.shaded_smooth = current_smooth;
+      StringRef str = drop_whitespace(rest);
+      while (!str.is_empty()) {
+        PolyCorner corner;
+        int index;
+        const StringRef after = parse_int(str, 0, index, false);
+        if (after.data() == str.data()) {
+          /* Not a number, ignore the rest of the line. */
+          break;
+        }
+        corner.vert_index = encode_index(index, r_chunk.positions.size());
+        str = after;
+        if (!str.is_empty() && str[0] == '/') {
+          str = str.drop_prefix(1);
+          if (!str.is_empty() && str[0] != '/') {
+            str = parse_int(str, 0, index, false);
+            corner.uv_index = encode_index(index, r_chunk.uvs.size());
+          }
+          if (!str.is_empty() && str[0] == '/') {
+            str = parse_int(str.drop_prefix(1), 0, index, false);
+            corner.normal_index = encode_index(index, r_chunk.normals.size());
+          }
+        }
+        segment->corners.append(corner);
+        str = drop_whitespace(drop_non_whitespace(str));
+      }
+      face.corner_count = segment->corners.size() - face.start_index;
+      if (face.corner_count < 3) {
+        segment->corners.resize(face.start_index);
+        continue;
+      }
+      segment->faces.append(face);
+    }
+    else if (keyword == "l") {
+      int prev_index = INVALID_INDEX;
+      StringRef str = drop_whitespace(rest);
+      while (!str.is_empty()) {
+        int index;
+        const StringRef after = parse_int(str, 0, index, false);
+        if (after.data() == str.data()) {
+          break;
+        }
+        const int vert_index = encode_index(index, r_chunk.positions.size());
+        if (prev_index != INVALID_INDEX) {
+          segment->edges.append(int2(prev_index, vert_index));
+        }
+        prev_index = vert_index;
+        /* Skip the optional UV index. */
+        str = drop_whitespace(drop_non_whitespace(after));
+      }
+    }
+    else if (keyword == "o") {
+      if (import_params_.use_split_objects) {
+        start_segment(rest.trim());
+      }
+    }
+    else if (keyword == "g") {
+      if (import_params_.use_split_groups) {
+        start_segment(rest.trim());
+      }
+    }
+    else if (keyword == "s") {
+      /* Any non-zero smoothing group is smooth, "off" is parsed as the fallback. */
+      int smooth_group;
+      parse_int(rest, 0, smooth_group);
+      current_smooth = smooth_group != 0;
+    }
+    else if (keyword == "usemtl") {
+      const std::string name = rest.trim();
+      current_material = material_indices.lookup_or_add_cb(name, [&]() {
+        r_chunk.material_names.append(name);
+        return int(r_chunk.material_names.size() - 1);
+      });
+    }
+    else if (keyword == "mtllib") {
+      r_chunk.mtl_libraries.append(rest.trim());
+    }
+    else if (is_unsupported_keyword(keyword)) {
+      r_chunk.has_unsupported_elements = true;
+    }
+  }
+
+  r_chunk.last_material_index = current_material;
+  r_chunk.last_shaded_smooth = current_smooth;
+}
+
+/**
+ * Compute the offsets of every chunk's elements in the global arrays, build the global material
+ * list, and propagate the material and smooth state across chunk boundaries.
+ */
+void OBJParser::merge_chunk_states()
+{
+  Map<std::string, int> material_indices;
+  VectorSet<std::string> mtl_libraries;
+  int vertex_offset = 0;
+  int uv_offset = 0;
+  int normal_offset = 0;
+  int material_index = -1;
+  int8_t shaded_smooth = 0;
+
+  for (std::unique_ptr<OBJChunk> &chunk : chunks_) {
+    chunk->vertex_offset = vertex_offset;
+    chunk->uv_offset = uv_offset;
+    chunk->normal_offset = normal_offset;
+    vertex_offset += chunk->positions.size();
+    uv_offset += chunk->uvs.size();
+    normal_offset += chunk->normals.size();
+
+    for (const std::string &name : chunk->material_names) {
+      chunk->material_remap.append(material_indices.lookup_or_add_cb(name, [&]() {
+        material_names_.append(name);
+        return int(material_names_.size() - 1);
+      }));
+    }
+    chunk->incoming_material_index = material_index;
+    chunk->incoming_shaded_smooth = shaded_smooth;
+    if (chunk->last_material_index != -1) {
+      material_index = chunk->material_remap[chunk->last_material_index];
+    }
+    if (chunk->last_shaded_smooth != -1) {
+      shaded_smooth = chunk->last_shaded_smooth;
+    }
+
+    for (const std::string &library : chunk->mtl_libraries) {
+      mtl_libraries.add(library);
+    }
+    max_abs_coordinate_ = std::max(max_abs_coordinate_, chunk->max_abs_coordinate);
+  }
+
+  for (const std::string &library : mtl_libraries) {
+    mtl_libraries_.append(library);
+  }
+}
+
+void OBJParser::resolve_chunk_indices(OBJChunk &chunk, const GlobalVertices &global_vertices) const
+{
+  const int total_verts = global_vertices.positions.size();
+  const int total_uvs = global_vertices.uvs.size();
+  const int total_normals = global_vertices.normals.size();
+
+  for (std::unique_ptr<GeometrySegment> &segment : chunk.segments) {
+    int last_material_index = -2;
+    for (PolyElem &face : segment->faces) {
+      face.material_index = face.material_index == -1 ?
+                                chunk.incoming_material_index :
+                                chunk.material_remap[face.material_index];
+      if (face.shaded_smooth == -1) {
+        face.shaded_smooth = chunk.incoming_shaded_smooth;
+      }
+      MutableSpan<PolyCorner> corners = segment->corners.as_mutable_span().slice(
+          face.start_index, face.corner_count);
+      for (PolyCorner &corner : corners) {
+        corner.vert_index = resolve_index(corner.vert_index, chunk.vertex_offset, total_verts);
+        corner.uv_index = resolve_index(corner.uv_index, chunk.uv_offset, total_uvs);
+        corner.normal_index = resolve_index(
+            corner.normal_index, chunk.normal_offset, total_normals);
+        if (corner.vert_index == INVALID_INDEX) {
+          face.is_valid = false;
+        }
+        segment->has_uvs |= corner.uv_index != INVALID_INDEX;
+        segment->has_normals |= corner.normal_index != INVALID_INDEX;
+      }
+      /* Faces using the same vertex for consecutive corners would create degenerate edges. */
+      for (const int i : corners.index_range()) {
+        if (corners[i].vert_index == corners[(i + 1) % corners.size()].vert_index) {
+          face.is_valid = false;
+        }
+      }
+      if (!face.is_valid) {
+        continue;
+      }
+      segment->valid_face_count++;
+      segment->valid_corner_count += face.corner_count;
+      if (face.material_index != last_material_index && face.material_index != -1) {
+        segment->used_materials.append_non_duplicates(face.material_index);
+      }
+      last_material_index = face.material_index;
+    }
+
+    for (int2 &edge : segment->edges) {
+      edge[0] = resolve_index(edge[0], chunk.vertex_offset, total_verts);
+      edge[1] = resolve_index(edge[1], chunk.vertex_offset, total_verts);
+      if (edge[0] == INVALID_INDEX || edge[1] == INVALID_INDEX || edge[0] == edge[1]) {
+        edge = int2(INVALID_INDEX);
+        continue;
+      }
+      segment->valid_edge_count++;
+    }
+  }
+}
+
+/**
+ * Gather the vertex data of all chunks into one set of arrays, and free the chunk copies.
+ */
+static void gather_global_vertices(MutableSpan<std::unique_ptr<OBJChunk>> chunks,
+                                   GlobalVertices &r_global_vertices)
+{
+  const OBJChunk &last_chunk = *chunks.last();
+  const int total_verts = last_chunk.vertex_offset + last_chunk.positions.size();
+  const int total_uvs = last_chunk.uv_offset + last_chunk.uvs.size();
+  const int total_normals = last_chunk.normal_offset + last_chunk.normals.size();
+  bool has_colors = false;
+  for (const std::unique_ptr<OBJChunk> &chunk : chunks) {
+    has_colors |= !chunk->colors.is_empty();
+  }
+
+  r_global_vertices.positions.resize(total_verts);
+  r_global_vertices.uvs.resize(total_uvs);
+  r_global_vertices.normals.resize(total_normals);
+  if (has_colors) {
+    r_global_vertices.colors.resize(total_verts);
+  }
+
+  threading::parallel_for(chunks.index_range(), 1, [&](IndexRange range) {
+    for (const int i : range) {
+      OBJChunk &chunk = *chunks[i];
+      r_global_vertices.positions.as_mutable_span()
+          .slice(chunk.vertex_offset, chunk.positions.size())
+          .copy_from(chunk.positions);
+      r_global_vertices.uvs.as_mutable_span()
+          .slice(chunk.uv_offset, chunk.uvs.size())
+          .copy_from(chunk.uvs);
+      r_global_vertices.normals.as_mutable_span()
+          .slice(chunk.normal_offset, chunk.normals.size())
+          .copy_from(chunk.normals);
+      if (has_colors) {
+        MutableSpan<float3> colors = r_global_vertices.colors.as_mutable_span().slice(
+            chunk.vertex_offset, chunk.positions.size());
+        if (chunk.colors.is_empty()) {
+          colors.fill(float3(1.0f));
+        }
+        else {
+          colors.copy_from(chunk.colors);
+        }
+      }
+      chunk.positions.clear_and_make_inline();
+      chunk.colors.clear_and_make_inline();
+      chunk.uvs.clear_and_make_inline();
+      chunk.normals.clear_and_make_inline();
+    }
+  });
+}
+
+bool OBJParser::parse(Vector<Geometry> &r_all_geometries, GlobalVertices &r_global_vertices)
+{
+  const int file = BLI_open(import_params_.filepath, O_BINARY | O_RDONLY, 0);
+  if (file == -1) {
+    fprintf(stderr, "Cannot read from OBJ file:'%s'.\n", import_params_.filepath);
+    return false;
+  }
+  const size_t file_size = BLI_file_descriptor_size(file);
+  BLI_mmap_file *mmap_file = (file_size > 0 && file_size != size_t(-1)) ?
+                                 BLI_mmap_open(file) :
+                                 nullptr;
+  if (mmap_file == nullptr) {
+    fprintf(stderr, "Cannot map OBJ file:'%s'.\n", import_params_.filepath);
+    close(file);
+    return false;
+  }
+
+  const StringRef buffer(static_cast<const char *>(BLI_mmap_get_pointer(mmap_file)),
+                         int64_t(file_size));
+  const Vector<StringRef> pieces = split_into_chunks(buffer);
+  for ([[maybe_unused]] const int i : pieces.index_range()) {
+    chunks_.append(std::make_unique<OBJChunk>());
+  }
+  threading::parallel_for(pieces.index_range(), 1, [&](IndexRange range) {
+    for (const int i : range) {
+      this->parse_chunk(pieces[i], *chunks_[i]);
+    }
+  });
+
+  /* All strings have been copied out of the file, so the mapping is not needed anymore. */
+  BLI_mmap_free(mmap_file);
+  close(file);
+
+  merge_chunk_states();
+  gather_global_vertices(chunks_, r_global_vertices);
+  threading::parallel_for(chunks_.index_range(), 1, [&](IndexRange range) {
+    for (const int i : range) {
+      this->resolve_chunk_indices(*chunks_[i], r_global_vertices);
+    }
+  });
+
+  for (const std::unique_ptr<OBJChunk> &chunk : chunks_) {
+    if (chunk->has_unsupported_elements) {
+      fprintf(stderr,
+              "OBJ import: curves, surfaces and point elements are not supported, skipping "
+              "them.\n");
+      break;
+    }
+  }
+
+  /* Objects are named after the file when the file doesn't name them. */
+  char default_name[FILE_MAX];
+  BLI_strncpy(default_name, BLI_path_basename(import_params_.filepath), sizeof(default_name));
+  BLI_path_extension_replace(default_name, sizeof(default_name), "");
+
+  Vector<Geometry> geometries;
+  for (const std::unique_ptr<OBJChunk> &chunk : chunks_) {
+    for (const std::unique_ptr<GeometrySegment> &segment : chunk->segments) {
+      if (!segment->continues_previous || geometries.is_empty()) {
+        geometries.append({});
+        geometries.last().name = segment->name.empty() ? default_name : segment->name;
+      }
+      geometries.last().segments.append(segment.get());
+    }
+  }
+
+  for (Geometry &geometry : geometries) {
+    bool has_elements = false;
+    for (const GeometrySegment *segment : geometry.segments) {
+      has_elements |= segment->valid_face_count > 0 || segment->valid_edge_count > 0;
+    }
+    if (has_elements) {
+      r_all_geometries.append(std::move(geometry));
+    }
+  }
+
+  if (r_all_geometries.is_empty() && !r_global_vertices.positions.is_empty()) {
+    /* A point cloud, import all vertices as one mesh. */
+    r_all_geometries.append({});
+    r_all_geometries.last().name = default_name;
+    r_all_geometries.last().use_all_vertices = true;
+  }
+  return true;
+}
+
+Span<std::string> OBJParser::material_names() const
+{
+  return material_names_;
+}
+
+Span<std::string> OBJParser::mtl_libraries() const
+{
+  return mtl_libraries_;
+}
+
+float OBJParser::max_abs_coordinate() const
+{
+  return max_abs_coordinate_;
+}
+
+/* -------------------------------------------------------------------- */
+/** \name MTL Parser
+ * \{ */
+
+/**
+ * Map from MTL keywords to the texture maps of #MTLMaterial.
+ */
+static bool texture_map_from_keyword(const StringRef keyword, eMTLSyntaxElement &r_type)
+{
+  if (keyword == "map_Kd") {
+    r_type = eMTLSyntaxElement::map_Kd;
+  }
+  else if (keyword == "map_Ks") {
+    r_type = eMTLSyntaxElement::map_Ks;
+  }
+  else if (keyword == "map_Ns") {
+    r_type = eMTLSyntaxElement::map_Ns;
+  }
+  else if (keyword == "map_d") {
+    r_type = eMTLSyntaxElement::map_d;
+  }
+  else if (ELEM(keyword, "map_refl", "refl")) {
+    r_type = eMTLSyntaxElement::map_refl;
+  }
+  else if (keyword == "map_Ke") {
+    r_type = eMTLSyntaxElement::map_Ke;
+  }
+  else if (ELEM(keyword, "map_Bump", "map_bump", "bump")) {
+    r_type = eMTLSyntaxElement::map_Bump;
+  }
+  else {
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Parse the options of a texture map statement, and the image path which follows them.
+ */
+static void parse_texture_map(StringRef str, MTLMaterial &material, const eMTLSyntaxElement type)
+{
+  tex_map_XX &tex_map = material.tex_map_of_type(type);
+  str = drop_whitespace(str);
+  while (!str.is_empty() && str[0] == '-') {
+    const StringRef rest = drop_non_whitespace(str);
+    const StringRef option(str.begin(), rest.begin());
+    if (option == "-o") {
+      str = parse_floats(rest, 0.0f, tex_map.translation, 3);
+    }
+    else if (option == "-s") {
+      str = parse_floats(rest, 1.0f, tex_map.scale, 3);
+    }
+    else if (option == "-bm") {
+      str = parse_float(rest, 1.0f, material.map_Bump_strength);
+    }
+    else if (option == "-type") {
+      const StringRef value_rest = drop_non_whitespace(drop_whitespace(rest));
+      const StringRef value = StringRef(drop_whitespace(rest).begin(), value_rest.begin());
+      if (value == "sphere") {
+        tex_map.projection_type = SHD_PROJ_SPHERE;
+      }
+      str = value_rest;
+    }
+    else if (ELEM(option, "-mm")) {
+      float values[2];
+      str = parse_floats(rest, 0.0f, values, 2);
+    }
+    else if (ELEM(option, "-t")) {
+      float values[3];
+      str = parse_floats(rest, 0.0f, values, 3);
+    }
+    else {
+      /* Options with a single value: -blendu, -blendv, -boost, -cc, -clamp, -imfchan, -texres
+       * and unknown ones. */
+      str = drop_non_whitespace(drop_whitespace(rest));
+    }
+    str = drop_whitespace(str);
+  }
+  /* The rest of the line is the image path, which may contain spaces. */
+  tex_map.image_path = str.trim();
+}
+
+MTLParser::MTLParser(StringRefNull mtl_library, StringRefNull obj_filepath)
+{
+  char obj_file_dir[FILE_MAXDIR];
+  BLI_split_dir_part(obj_filepath.c_str(), obj_file_dir, FILE_MAXDIR);
+  BLI_path_join(mtl_file_path_, FILE_MAX, obj_file_dir, mtl_library.c_str(), nullptr);
+  BLI_split_dir_part(mtl_file_path_, mtl_dir_path_, FILE_MAX);
+}
+
+void MTLParser::parse_and_store(Map<std::string, std::unique_ptr<MTLMaterial>> &r_materials)
+{
+  size_t buffer_len;
+  char *buffer = static_cast<char *>(BLI_file_read_text_as_mem(mtl_file_path_, 0, &buffer_len));
+  if (buffer == nullptr) {
+    fprintf(stderr, "OBJ import: cannot read from MTL file: '%s'\n", mtl_file_path_);
+    return;
+  }
+
+  StringRef str(buffer, int64_t(buffer_len));
+  MTLMaterial *material = nullptr;
+  while (!str.is_empty()) {
+    const StringRef line = drop_whitespace(read_next_line(str));
+    if (line.is_empty() || line[0] == '#') {
+      continue;
+    }
+    const StringRef rest = drop_non_whitespace(line);
+    const StringRef keyword(line.begin(), rest.begin());
+
+    if (keyword == "newmtl") {
+      const std::string name = rest.trim();
+      if (r_materials.contains(name)) {
+        /* Keep the first definition, as materials are looked up by name. */
+        material = nullptr;
+        continue;
+      }
+      material = r_materials
+                     .lookup_or_add_cb(name, []() { return std::make_unique<MTLMaterial>(); })
+                     .get();
+      material->name = name;
+      continue;
+    }
+    if (material == nullptr) {
+      continue;
+    }
+
+    eMTLSyntaxElement texture_type;
+    if (keyword == "Ns") {
+      parse_float(rest, 324.0f, material->Ns);
+    }
+    else if (keyword == "Ka") {
+      parse_floats(rest, 0.0f, material->Ka, 3);
+    }
+    else if (keyword == "Kd") {
+      parse_floats(rest, 0.8f, material->Kd, 3);
+    }
+    else if (keyword == "Ks") {
+      parse_floats(rest, 0.5f, material->Ks, 3);
+    }
+    else if (keyword == "Ke") {
+      parse_floats(rest, 0.0f, material->Ke, 3);
+    }
+    else if (keyword == "Ni") {
+      parse_float(rest, 1.45f, material->Ni);
+    }
+    else if (keyword == "d") {
+      parse_float(rest, 1.0f, material->d);
+    }
+    else if (keyword == "Tr") {
+      float transparency;
+      parse_float(rest, 0.0f, transparency);
+      material->d = 1.0f - transparency;
+    }
+    else if (keyword == "illum") {
+      parse_int(rest, 2, material->illum);
+    }
+    else if (texture_map_from_keyword(keyword, texture_type)) {
+      parse_texture_map(rest, *material, texture_type);
+      material->tex_map_of_type(texture_type).mtl_dir_path = mtl_dir_path_;
+    }
+  }
+
+  MEM_freeN(buffer);
+}
+
+/** \} */
+
+}  // namespace blender::io::obj
@@ -0,0 +1,77 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup obj
+ */
+
+#pragma once
+
+#include "BLI_map.hh"
+#include "BLI_utility_mixins.hh"
+#include "BLI_vector.hh"
+
+#include "IO_wavefront_obj.h"
+#include "obj_export_mtl.hh"
+#include "obj_import_objects.hh"
+
+namespace blender::io::obj {
+
+/**
+ * Reads an .OBJ file. The file is memory-mapped and split into chunks at line boundaries,
+ * and the chunks are parsed on all threads. Afterwards the chunks are stitched together:
+ * vertex data is gathered into #GlobalVertices and the faces and edges are grouped into one
+ * #Geometry per object.
+ */
+class OBJParser : NonMovable, NonCopyable {
+ private:
+  const OBJImportParams &import_params_;
+  /** Owns the faces and edges referenced by the geometries returned from #parse. */
+  Vector<std::unique_ptr<OBJChunk>> chunks_;
+  Vector<std::string> material_names_;
+  Vector<std::string> mtl_libraries_;
+  float max_abs_coordinate_ = 0.0f;
+
+ public:
+  OBJParser(const OBJImportParams &import_params);
+
+  /**
+   * Parse the whole file.
+   * \return False if the file could not be read.
+   */
+  bool parse(Vector<Geometry> &r_all_geometries, GlobalVertices &r_global_vertices);
+
+  /** Names of all materials used in the file, indexed by #PolyElem.material_index. */
+  Span<std::string> material_names() const;
+  /** .MTL file names referenced in the file, without duplicates. */
+  Span<std::string> mtl_libraries() const;
+  float max_abs_coordinate() const;
+
+ private:
+  void parse_chunk(StringRef buffer, OBJChunk &r_chunk) const;
+  void merge_chunk_states();
+  void resolve_chunk_indices(OBJChunk &chunk, const GlobalVertices &global_vertices) const;
+};
+
+/**
+ * Reads an .MTL file into #MTLMaterial containers.
+ */
+class MTLParser {
+ private:
+  char mtl_file_path_[FILE_MAX];
+  /** Directory of the .MTL file, texture paths are relative to it. */
+  char mtl_dir_path_[FILE_MAX];
+
+ public:
+  /**
+   * \param mtl_library: File name of the .MTL file as written in the .OBJ file, relative to it.
+   * \param obj_filepath: Path to the .OBJ file.
+   */
+  MTLParser(StringRefNull mtl_library, StringRefNull obj_filepath);
+
+  /**
+   * Parse all materials of the file, materials already in `r_materials` are not overwritten.
+   */
+  void parse_and_store(Map<std::string, std::unique_ptr<MTLMaterial>> &r_materials);
+};
+
+}  // namespace blender::io::obj
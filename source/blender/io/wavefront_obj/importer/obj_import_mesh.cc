@@ -0,0 +1,300 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup obj
+ */
+
+#include "DNA_material_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_object_types.h"
+
+#include "BKE_customdata.h"
+#include "BKE_lib_id.h"
+#include "BKE_material.h"
+#include "BKE_mesh.h"
+#include "BKE_object.h"
+
+#include "BLI_array.hh"
+#include "BLI_math_base.h"
+#include "BLI_math_vector.h"
+#include "BLI_task.hh"
+
+#include "obj_import_mesh.hh"
+
+namespace blender::io::obj {
+
+MeshFromGeometry::MeshFromGeometry(const Geometry &mesh_geometry,
+                                   const GlobalVertices &global_vertices)
+    : mesh_geometry_(mesh_geometry), global_vertices_(global_vertices)
+{
+}
+
+MeshFromGeometry::~MeshFromGeometry()
+{
+  if (mesh_) {
+    BKE_id_free(nullptr, mesh_);
+  }
+}
+
+void MeshFromGeometry::create_mesh(const OBJImportParams &import_params)
+{
+  const Span<const GeometrySegment *> segments = mesh_geometry_.segments;
+
+  /* Offsets of the valid elements of every segment in the mesh arrays. */
+  face_offsets_.reinitialize(segments.size() + 1);
+  corner_offsets_.reinitialize(segments.size() + 1);
+  edge_offsets_.reinitialize(segments.size() + 1);
+  face_offsets_[0] = corner_offsets_[0] = edge_offsets_[0] = 0;
+  bool has_uvs = false;
+  bool has_normals = false;
+  for (const int i : segments.index_range()) {
+    face_offsets_[i + 1] = face_offsets_[i] + segments[i]->valid_face_count;
+    corner_offsets_[i + 1] = corner_offsets_[i] + segments[i]->valid_corner_count;
+    edge_offsets_[i + 1] = edge_offsets_[i] + segments[i]->valid_edge_count;
+    has_uvs |= segments[i]->has_uvs;
+    has_normals |= segments[i]->has_normals;
+  }
+
+  /* Only the vertices used by the faces and edges of this geometry become part of the mesh. They
+   * usually form one contiguous range of the global vertices, so a dense map over the used range
+   * is cheap. */
+  Vector<int> used_vertices;
+  Array<int> vertex_map;
+  int vertex_map_start = 0;
+  if (mesh_geometry_.use_all_vertices) {
+    used_vertices.resize(global_vertices_.positions.size());
+    for (const int i : used_vertices.index_range()) {
+      used_vertices[i] = i;
+    }
+  }
+  else {
+    int min_vertex = INT32_MAX;
+    int max_vertex = -1;
+    for (const GeometrySegment *segment : segments) {
+      for (const PolyElem &face : segment->faces) {
+        if (!face.is_valid) {
+          continue;
+        }
+        for (const PolyCorner &corner :
+             segment->corners.as_span().slice(face.start_index, face.corner_count)) {
+          min_vertex = std::min(min_vertex, corner.vert_index);
+          max_vertex = std::max(max_vertex, corner.vert_index);
+        }
+      }
+      for (const int2 &edge : segment->edges) {
+        if (edge[0] != INVALID_INDEX) {
+          min_vertex = std::min({min_vertex, edge[0], edge[1]});
+          max_vertex = std::max({max_vertex, edge[0], edge[1]});
+        }
+      }
+    }
+    if (max_vertex < min_vertex) {
+      return;
+    }
+    vertex_map_start = min_vertex;
+    vertex_map.reinitialize(max_vertex - min_vertex + 1);
+    vertex_map.fill(INVALID_INDEX);
+    for (const GeometrySegment *segment : segments) {
+      for (const PolyElem &face : segment->faces) {
+        if (!face.is_valid) {
+          continue;
+        }
+        for (const PolyCorner &corner :
+             segment->corners.as_span().slice(face.start_index, face.corner_count)) {
+          vertex_map[corner.vert_index - min_vertex] = 0;
+        }
+      }
+      for (const int2 &edge : segment->edges) {
+        if (edge[0] != INVALID_INDEX) {
+          vertex_map[edge[0] - min_vertex] = 0;
+          vertex_map[edge[1] - min_vertex] = 0;
+        }
+      }
+    }
+    for (const int i : vertex_map.index_range()) {
+      if (vertex_map[i] != INVALID_INDEX) {
+        vertex_map[i] = used_vertices.append_and_get_index(min_vertex + i);
+      }
+    }
+  }
+
+  collect_material_slots();
+
+  const int tot_face_elems = face_offsets_.last();
+  const int tot_corners = corner_offsets_.last();
+  const int tot_loose_edges = edge_offsets_.last();
+  mesh_ = BKE_mesh_new_nomain(
+      used_vertices.size(), tot_loose_edges, 0, tot_corners, tot_face_elems);
+
+  create_vertices(used_vertices);
+  create_colors(used_vertices);
+  create_loose_edges(vertex_map, vertex_map_start);
+
+  Array<float3> loop_normals;
+  if (has_normals) {
+    loop_normals.reinitialize(tot_corners);
+  }
+  create_polys_loops(vertex_map, vertex_map_start, has_uvs, loop_normals);
+
+  if (tot_face_elems > 0) {
+    /* Loose edges are kept, edges shared with faces are not duplicated. */
+    BKE_mesh_calc_edges(mesh_, tot_loose_edges > 0, false);
+  }
+  if (tot_loose_edges > 0) {
+    BKE_mesh_calc_edges_loose(mesh_);
+  }
+
+  if (has_normals) {
+    /* Custom normals are only used with auto smooth. Use the maximum angle, so that no edge is
+     * split by angle and the normals from the file are used as they are. */
+    mesh_->flag |= ME_AUTOSMOOTH;
+    mesh_->smoothresh = DEG2RADF(180.0f);
+    BKE_mesh_set_custom_normals(mesh_, reinterpret_cast<float(*)[3]>(loop_normals.data()));
+  }
+
+  if (import_params.validate_meshes) {
+    BKE_mesh_validate(mesh_, false, true);
+  }
+}
+
+void MeshFromGeometry::collect_material_slots()
+{
+  for (const GeometrySegment *segment : mesh_geometry_.segments) {
+    for (const int material_index : segment->used_materials) {
+      material_slots_.append_non_duplicates(material_index);
+    }
+  }
+}
+
+void MeshFromGeometry::create_vertices(const Span<int> used_vertices)
+{
+  MutableSpan<MVert> verts(mesh_->mvert, mesh_->totvert);
+  const Span<float3> positions = global_vertices_.positions;
+  threading::parallel_for(verts.index_range(), 4096, [&](IndexRange range) {
+    for (const int i : range) {
+      copy_v3_v3(verts[i].co, positions[used_vertices[i]]);
+      verts[i].flag = 0;
+      verts[i].bweight = 0;
+    }
+  });
+}
+
+void MeshFromGeometry::create_colors(const Span<int> used_vertices)
+{
+  if (global_vertices_.colors.is_empty()) {
+    return;
+  }
+  MPropCol *colors = static_cast<MPropCol *>(CustomData_add_layer_named(
+      &mesh_->vdata, CD_PROP_COLOR, CD_DEFAULT, nullptr, mesh_->totvert, "Color"));
+  const Span<float3> vertex_colors = global_vertices_.colors;
+  threading::parallel_for(IndexRange(mesh_->totvert), 4096, [&](IndexRange range) {
+    for (const int i : range) {
+      copy_v3_v3(colors[i].color, vertex_colors[used_vertices[i]]);
+      colors[i].color[3] = 1.0f;
+    }
+  });
+}
+
+void MeshFromGeometry::create_loose_edges(const Span<int> vertex_map, const int vertex_map_start)
+{
+  const Span<const GeometrySegment *> segments = mesh_geometry_.segments;
+  MutableSpan<MEdge> edges(mesh_->medge, mesh_->totedge);
+  for (const int i : segments.index_range()) {
+    int edge_index = edge_offsets_[i];
+    for (const int2 &edge : segments[i]->edges) {
+      if (edge[0] == INVALID_INDEX) {
+        continue;
+      }
+      MEdge &medge = edges[edge_index++];
+      medge.v1 = vertex_map[edge[0] - vertex_map_start];
+      medge.v2 = vertex_map[edge[1] - vertex_map_start];
+      medge.flag = ME_EDGEDRAW | ME_EDGERENDER;
+    }
+  }
+}
+
+void MeshFromGeometry::create_polys_loops(const Span<int> vertex_map,
+                                          const int vertex_map_start,
+                                          const bool create_uvs,
+                                          MutableSpan<float3> r_loop_normals)
+{
+  const Span<const GeometrySegment *> segments = mesh_geometry_.segments;
+  MutableSpan<MPoly> polys(mesh_->mpoly, mesh_->totpoly);
+  MutableSpan<MLoop> loops(mesh_->mloop, mesh_->totloop);
+  MLoopUV *loop_uvs = nullptr;
+  if (create_uvs) {
+    loop_uvs = static_cast<MLoopUV *>(CustomData_add_layer_named(
+        &mesh_->ldata, CD_MLOOPUV, CD_CALLOC, nullptr, mesh_->totloop, "UVMap"));
+  }
+
+  Map<int, int> material_slot_of_index;
+  for (const int slot : material_slots_.index_range()) {
+    material_slot_of_index.add(material_slots_[slot], slot);
+  }
+
+  /* Every segment writes to its own range of the mesh arrays. */
+  threading::parallel_for(segments.index_range(), 1, [&](IndexRange range) {
+    for (const int segment_index : range) {
+      const GeometrySegment &segment = *segments[segment_index];
+      int poly_index = face_offsets_[segment_index];
+      int loop_index = corner_offsets_[segment_index];
+      for (const PolyElem &face : segment.faces) {
+        if (!face.is_valid) {
+          continue;
+        }
+        MPoly &mpoly = polys[poly_index++];
+        mpoly.loopstart = loop_index;
+        mpoly.totloop = face.corner_count;
+        mpoly.mat_nr = material_slot_of_index.lookup_default(face.material_index, 0);
+        mpoly.flag = face.shaded_smooth ? ME_SMOOTH : 0;
+
+        for (const PolyCorner &corner :
+             segment.corners.as_span().slice(face.start_index, face.corner_count)) {
+          loops[loop_index].v = vertex_map[corner.vert_index - vertex_map_start];
+          if (loop_uvs) {
+            if (corner.uv_index != INVALID_INDEX) {
+              copy_v2_v2(loop_uvs[loop_index].uv, global_vertices_.uvs[corner.uv_index]);
+            }
+          }
+          if (!r_loop_normals.is_empty()) {
+            /* A zero vector keeps the automatic normal. */
+            r_loop_normals[loop_index] = corner.normal_index != INVALID_INDEX ?
+                                             global_vertices_.normals[corner.normal_index] :
+                                             float3(0.0f);
+          }
+          loop_index++;
+        }
+      }
+    }
+  });
+}
+
+Object *MeshFromGeometry::create_object(Main *bmain, const Span<Material *> materials)
+{
+  if (mesh_ == nullptr) {
+    return nullptr;
+  }
+  const char *name = mesh_geometry_.name.c_str();
+  Object *obj = BKE_object_add_only_object(bmain, OB_MESH, name);
+  obj->data = BKE_object_obdata_add_from_type(bmain, OB_MESH, name);
+  Mesh *mesh = static_cast<Mesh *>(obj->data);
+
+  const bool use_custom_normals = mesh_->flag & ME_AUTOSMOOTH;
+  const float smoothresh = mesh_->smoothresh;
+  BKE_mesh_nomain_to_mesh(mesh_, mesh, obj, &CD_MASK_EVERYTHING, true);
+  mesh_ = nullptr;
+  if (use_custom_normals) {
+    mesh->flag |= ME_AUTOSMOOTH;
+    mesh->smoothresh = smoothresh;
+  }
+
+  for (const int slot : material_slots_.index_range()) {
+    Material *material = materials[material_slots_[slot]];
+    BKE_object_material_slot_add(bmain, obj);
+    BKE_object_material_assign(bmain, obj, material, slot + 1, BKE_MAT_ASSIGN_OBDATA);
+  }
+  return obj;
+}
+
+}  // namespace blender::io::obj
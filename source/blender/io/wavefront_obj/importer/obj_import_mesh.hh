@@ -0,0 +1,73 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup obj
+ */
+
+#pragma once
+
+#include "BLI_array.hh"
+#include "BLI_map.hh"
+#include "BLI_utility_mixins.hh"
+#include "BLI_vector.hh"
+
+#include "IO_wavefront_obj.h"
+#include "obj_import_objects.hh"
+
+struct Main;
+struct Material;
+struct Mesh;
+struct Object;
+
+namespace blender::io::obj {
+
+/**
+ * Builds a #Mesh for one #Geometry by filling the mesh arrays directly.
+ *
+ * #create_mesh does not touch #Main, so meshes of different geometries can be built on
+ * different threads. #create_object has to be called from the main thread.
+ */
+class MeshFromGeometry : NonMovable, NonCopyable {
+ private:
+  const Geometry &mesh_geometry_;
+  const GlobalVertices &global_vertices_;
+  /** Mesh outside of #Main, created by #create_mesh. */
+  Mesh *mesh_ = nullptr;
+  /** Global material index of every material slot. */
+  Vector<int> material_slots_;
+  /** Offsets of the valid faces, corners and loose edges of every segment in the mesh. */
+  Array<int> face_offsets_;
+  Array<int> corner_offsets_;
+  Array<int> edge_offsets_;
+
+ public:
+  MeshFromGeometry(const Geometry &mesh_geometry, const GlobalVertices &global_vertices);
+  ~MeshFromGeometry();
+
+  /**
+   * Create the mesh outside of #Main. Does nothing when the geometry has no valid elements.
+   */
+  void create_mesh(const OBJImportParams &import_params);
+
+  /**
+   * Create the object and its mesh in `bmain` and move the mesh data into it.
+   * \param materials: Materials indexed by global material index.
+   */
+  Object *create_object(Main *bmain, Span<Material *> materials);
+
+ private:
+  void create_vertices(Span<int> used_vertices);
+  void create_colors(Span<int> used_vertices);
+  void create_loose_edges(Span<int> vertex_map, int vertex_map_start);
+  /**
+   * Create the faces and face corners, with UVs and normals when the file has them.
+   * \param r_loop_normals: Empty, or one normal per face corner to be filled.
+   */
+  void create_polys_loops(Span<int> vertex_map,
+                          int vertex_map_start,
+                          bool create_uvs,
+                          MutableSpan<float3> r_loop_normals);
+  void collect_material_slots();
+};
+
+}  // namespace blender::io::obj
@@ -0,0 +1,226 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup obj
+ */
+
+#include <cmath>
+#include <cstdio>
+
+#include "BKE_image.h"
+#include "BKE_material.h"
+#include "BKE_node.h"
+#include "BKE_node_tree_update.h"
+
+#include "BLI_fileops.h"
+#include "BLI_math_base.h"
+#include "BLI_math_vector.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+
+#include "DNA_image_types.h"
+#include "DNA_material_types.h"
+#include "DNA_node_types.h"
+
+#include "IMB_colormanagement.h"
+
+#include "NOD_shader.h"
+
+#include "obj_import_mtl.hh"
+
+namespace blender::io::obj {
+
+static bNode *add_node(bNodeTree *ntree, const int type, const float x, const float y)
+{
+  bNode *node = nodeAddStaticNode(nullptr, ntree, type);
+  node->locx = x;
+  node->locy = y;
+  return node;
+}
+
+static void link_sockets(bNodeTree *ntree,
+                         bNode *from_node,
+                         const char *from_socket_id,
+                         bNode *to_node,
+                         const char *to_socket_id)
+{
+  nodeAddLink(ntree,
+              from_node,
+              nodeFindSocket(from_node, SOCK_OUT, from_socket_id),
+              to_node,
+              nodeFindSocket(to_node, SOCK_IN, to_socket_id));
+}
+
+static void set_float_input(bNode *node, const char *socket_id, const float value)
+{
+  bNodeSocket *socket = nodeFindSocket(node, SOCK_IN, socket_id);
+  BLI_assert(socket && socket->type == SOCK_FLOAT);
+  static_cast<bNodeSocketValueFloat *>(socket->default_value)->value = value;
+}
+
+static void set_color_input(bNode *node, const char *socket_id, const float3 &color)
+{
+  bNodeSocket *socket = nodeFindSocket(node, SOCK_IN, socket_id);
+  BLI_assert(socket && socket->type == SOCK_RGBA);
+  bNodeSocketValueRGBA *value = static_cast<bNodeSocketValueRGBA *>(socket->default_value);
+  copy_v3_v3(value->value, color);
+  value->value[3] = 1.0f;
+}
+
+static void set_vector_input(bNode *node, const char *socket_id, const float3 &vector)
+{
+  bNodeSocket *socket = nodeFindSocket(node, SOCK_IN, socket_id);
+  BLI_assert(socket && socket->type == SOCK_VECTOR);
+  copy_v3_v3(static_cast<bNodeSocketValueVector *>(socket->default_value)->value, vector);
+}
+
+/**
+ * Load the image of a texture map. The path is relative to the .MTL file, but files written on
+ * other machines often have absolute paths that don't exist here, so the file name alone is
+ * tried next to the .MTL file too.
+ */
+static Image *load_texture_image(Main *bmain, const tex_map_XX &tex_map)
+{
+  char path[FILE_MAX];
+  BLI_strncpy(path, tex_map.image_path.c_str(), sizeof(path));
+  if (!BLI_is_file(path)) {
+    BLI_path_join(
+        path, sizeof(path), tex_map.mtl_dir_path.c_str(), tex_map.image_path.c_str(), nullptr);
+  }
+  if (!BLI_is_file(path)) {
+    BLI_path_join(path,
+                  sizeof(path),
+                  tex_map.mtl_dir_path.c_str(),
+                  BLI_path_basename(tex_map.image_path.c_str()),
+                  nullptr);
+  }
+  Image *image = BKE_image_load_exists(bmain, path);
+  if (image == nullptr) {
+    fprintf(stderr, "OBJ import: cannot load image file: '%s'\n", tex_map.image_path.c_str());
+  }
+  return image;
+}
+
+/**
+ * Add an image texture node for the texture map, with a mapping node when the map has an
+ * offset or scale.
+ * \return The image node, or null if the map has no image.
+ */
+static bNode *add_texture_node(Main *bmain,
+                               bNodeTree *ntree,
+                               const tex_map_XX &tex_map,
+                               const bool is_color_data,
+                               const float y)
+{
+  if (tex_map.image_path.empty()) {
+    return nullptr;
+  }
+  Image *image = load_texture_image(bmain, tex_map);
+  if (image == nullptr) {
+    return nullptr;
+  }
+  if (!is_color_data) {
+    STRNCPY(image->colorspace_settings.name,
+            IMB_colormanagement_role_colorspace_name_get(COLOR_ROLE_DATA));
+  }
+
+  bNode *image_node = add_node(ntree, SH_NODE_TEX_IMAGE, -500.0f, y);
+  image_node->id = &image->id;
+  static_cast<NodeTexImage *>(image_node->storage)->projection = tex_map.projection_type;
+
+  if (tex_map.translation != float3(0.0f) || tex_map.scale != float3(1.0f)) {
+    bNode *texcoord_node = add_node(ntree, SH_NODE_TEX_COORD, -1000.0f, y);
+    bNode *mapping_node = add_node(ntree, SH_NODE_MAPPING, -750.0f, y);
+    set_vector_input(mapping_node, "Location", tex_map.translation);
+    set_vector_input(mapping_node, "Scale", tex_map.scale);
+    link_sockets(ntree, texcoord_node, "UV", mapping_node, "Vector");
+    link_sockets(ntree, mapping_node, "Vector", image_node, "Vector");
+  }
+  return image_node;
+}
+
+Material *create_material(Main *bmain, const MTLMaterial &mtl_material)
+{
+  Material *material = BKE_material_add(bmain, mtl_material.name.c_str());
+
+  /* Properties that are not set in the file are negative, see #MTLMaterial. */
+  const float3 base_color = mtl_material.Kd.x >= 0.0f ? mtl_material.Kd : float3(0.8f);
+  const float specular = mtl_material.Ks.x >= 0.0f ? clamp_f(mtl_material.Ks.x, 0.0f, 1.0f) :
+                                                      0.5f;
+  /* Inverse of the approximation used by the exporter. */
+  const float roughness = mtl_material.Ns >= 0.0f ?
+                              1.0f - sqrtf(clamp_f(mtl_material.Ns, 0.0f, 1000.0f) / 1000.0f) :
+                              0.5f;
+  /* The exporter writes the metallic value as ambient color for reflective materials. */
+  const float metallic = (ELEM(mtl_material.illum, 3, 6) && mtl_material.Ka.x >= 0.0f &&
+                          mtl_material.Ka.x < 1.0f) ?
+                             mtl_material.Ka.x :
+                             0.0f;
+  const float ior = mtl_material.Ni >= 0.0f ? mtl_material.Ni : 1.45f;
+  const float alpha = mtl_material.d >= 0.0f ? clamp_f(mtl_material.d, 0.0f, 1.0f) : 1.0f;
+  const float3 emission = mtl_material.Ke.x >= 0.0f ? mtl_material.Ke : float3(0.0f);
+
+  /* Viewport display settings. */
+  copy_v3_v3(&material->r, base_color);
+  material->a = alpha;
+  material->spec = specular;
+  material->roughness = roughness;
+  material->metallic = metallic;
+
+  bNodeTree *ntree = ntreeAddTree(nullptr, "Shader Nodetree", ntreeType_Shader->idname);
+  material->nodetree = ntree;
+  material->use_nodes = true;
+
+  bNode *bsdf = add_node(ntree, SH_NODE_BSDF_PRINCIPLED, 0.0f, 300.0f);
+  bNode *output = add_node(ntree, SH_NODE_OUTPUT_MATERIAL, 300.0f, 300.0f);
+  link_sockets(ntree, bsdf, "BSDF", output, "Surface");
+  nodeSetActive(ntree, output);
+
+  set_color_input(bsdf, "Base Color", base_color);
+  set_float_input(bsdf, "Specular", specular);
+  set_float_input(bsdf, "Roughness", roughness);
+  set_float_input(bsdf, "Metallic", metallic);
+  set_float_input(bsdf, "IOR", ior);
+  set_float_input(bsdf, "Alpha", alpha);
+  set_color_input(bsdf, "Emission", emission);
+  set_float_input(bsdf, "Emission Strength", emission != float3(0.0f) ? 1.0f : 0.0f);
+
+  bool use_alpha_blend = alpha < 1.0f;
+  float y = 600.0f;
+  for (const auto item : mtl_material.texture_maps.items()) {
+    const eMTLSyntaxElement type = item.key;
+    const tex_map_XX &tex_map = item.value;
+    const bool is_color_data = ELEM(type, eMTLSyntaxElement::map_Kd, eMTLSyntaxElement::map_Ke);
+    bNode *image_node = add_texture_node(bmain, ntree, tex_map, is_color_data, y);
+    if (image_node == nullptr) {
+      continue;
+    }
+    y -= 300.0f;
+
+    if (type == eMTLSyntaxElement::map_Bump) {
+      bNode *normal_map = add_node(ntree, SH_NODE_NORMAL_MAP, -200.0f, image_node->locy);
+      if (mtl_material.map_Bump_strength >= 0.0f) {
+        set_float_input(normal_map, "Strength", mtl_material.map_Bump_strength);
+      }
+      link_sockets(ntree, image_node, "Color", normal_map, "Color");
+      link_sockets(ntree, normal_map, "Normal", bsdf, "Normal");
+      continue;
+    }
+    if (type == eMTLSyntaxElement::map_Ke) {
+      set_float_input(bsdf, "Emission Strength", 1.0f);
+    }
+    if (type == eMTLSyntaxElement::map_d) {
+      use_alpha_blend = true;
+    }
+    link_sockets(ntree, image_node, "Color", bsdf, tex_map.dest_socket_id.c_str());
+  }
+
+  if (use_alpha_blend) {
+    material->blend_method = MA_BM_BLEND;
+  }
+
+  BKE_ntree_update_main_tree(bmain, ntree, nullptr);
+  return material;
+}
+
+}  // namespace blender::io::obj
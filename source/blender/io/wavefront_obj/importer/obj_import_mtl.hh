@@ -0,0 +1,22 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup obj
+ */
+
+#pragma once
+
+#include "obj_export_mtl.hh"
+
+struct Main;
+struct Material;
+
+namespace blender::io::obj {
+
+/**
+ * Create a material with a Principled BSDF node tree from the properties and texture maps of
+ * an .MTL material. This is the inverse of #mtlmaterial_for_material.
+ */
+Material *create_material(Main *bmain, const MTLMaterial &mtl_material);
+
+}  // namespace blender::io::obj
@@ -0,0 +1,142 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup obj
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "BLI_math_vec_types.hh"
+#include "BLI_vector.hh"
+
+namespace blender::io::obj {
+
+/** Marks a missing or out of range index in a #PolyCorner or loose edge. */
+const int INVALID_INDEX = -1;
+
+/**
+ * Relative (negative) indices refer to elements counted from the end of the element list at
+ * that point of the file. A chunk is parsed before the number of elements in the preceding
+ * chunks is known, so relative indices are stored as `chunk local index - RELATIVE_INDEX_BIAS`
+ * until #OBJChunk offsets are known. Absolute indices are stored as zero-based indices, so the
+ * two cases can be told apart by the sign.
+ */
+const int RELATIVE_INDEX_BIAS = 1 << 30;
+
+/**
+ * A face corner: indices into the position, UV and normal arrays.
+ */
+struct PolyCorner {
+  int vert_index = INVALID_INDEX;
+  int uv_index = INVALID_INDEX;
+  int normal_index = INVALID_INDEX;
+};
+
+struct PolyElem {
+  /** First corner of the face in #GeometrySegment.corners. */
+  int start_index = 0;
+  int corner_count = 0;
+  /**
+   * While parsing: index into #OBJChunk.material_names, or -1 when the material was set before
+   * the chunk. After resolving: index into the global material list, or -1 for no material.
+   */
+  int material_index = -1;
+  /** 1 or 0, or -1 while parsing when the smooth state was set before the chunk. */
+  int8_t shaded_smooth = -1;
+  /** False when a vertex index of the face is out of range. */
+  bool is_valid = true;
+};
+
+/**
+ * A run of consecutive faces and loose edges of one object within a chunk. The geometry of an
+ * object can be spread over several segments when its elements cross a chunk boundary.
+ */
+struct GeometrySegment {
+  /** Name of the `o` (or `g`) statement that starts this segment. */
+  std::string name;
+  /** Whether this segment is the first one of its chunk and continues the last object of the
+   * previous chunk rather than starting a new object. */
+  bool continues_previous = false;
+
+  Vector<PolyElem> faces;
+  Vector<PolyCorner> corners;
+  /** Vertex index pairs of `l` statements. */
+  Vector<int2> edges;
+
+  /* Filled in when the indices are resolved. */
+  int valid_face_count = 0;
+  int valid_corner_count = 0;
+  int valid_edge_count = 0;
+  bool has_uvs = false;
+  bool has_normals = false;
+  /** Global material indices used by the faces of the segment, without duplicates. */
+  Vector<int> used_materials;
+
+  bool is_empty() const
+  {
+    return faces.is_empty() && edges.is_empty();
+  }
+};
+
+/**
+ * Everything parsed from one piece of the .OBJ file. Chunks are parsed independently and in
+ * parallel, then stitched together by #OBJParser.
+ */
+struct OBJChunk {
+  Vector<float3> positions;
+  /** Empty when no vertex of the chunk has a color, otherwise as long as `positions`. */
+  Vector<float3> colors;
+  Vector<float2> uvs;
+  Vector<float3> normals;
+
+  Vector<std::unique_ptr<GeometrySegment>> segments;
+
+  /** Names of the materials set by `usemtl` in this chunk. */
+  Vector<std::string> material_names;
+  Vector<std::string> mtl_libraries;
+
+  /** Material and smooth state at the end of the chunk, -1 when the chunk doesn't set them. */
+  int last_material_index = -1;
+  int8_t last_shaded_smooth = -1;
+
+  /** Largest absolute vertex coordinate, used to clamp the size of the imported objects. */
+  float max_abs_coordinate = 0.0f;
+  /** Curves, surfaces and other elements that are skipped. */
+  bool has_unsupported_elements = false;
+
+  /* Filled in after parsing: offsets of this chunk's elements in #GlobalVertices, and the
+   * material and smooth state set before this chunk. */
+  int vertex_offset = 0;
+  int uv_offset = 0;
+  int normal_offset = 0;
+  int incoming_material_index = -1;
+  int8_t incoming_shaded_smooth = 0;
+  /** Maps #OBJChunk.material_names indices to global material indices. */
+  Vector<int> material_remap;
+};
+
+/**
+ * Vertex data is shared by all objects in an .OBJ file, faces index into these arrays.
+ */
+struct GlobalVertices {
+  Vector<float3> positions;
+  /** Empty when the file has no vertex colors, otherwise as long as `positions`. */
+  Vector<float3> colors;
+  Vector<float2> uvs;
+  Vector<float3> normals;
+};
+
+/**
+ * One object to be imported: its name and the segments holding its faces and edges.
+ */
+struct Geometry {
+  std::string name;
+  Vector<const GeometrySegment *> segments;
+  /** Create a mesh from all vertices of the file, for files without any faces or edges. */
+  bool use_all_vertices = false;
+};
+
+}  // namespace blender::io::obj
@@ -0,0 +1,233 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup obj
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "obj_import_string_utils.hh"
+
+namespace blender::io::obj {
+
+static bool is_whitespace(const char c)
+{
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v';
+}
+
+static bool is_digit(const char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+StringRef read_next_line(StringRef &buffer)
+{
+  const char *start = buffer.begin();
+  const char *end = buffer.end();
+  const char *ptr = start;
+  while (ptr < end) {
+    if (*ptr == '\n') {
+      /* A backslash right before the line break (optionally followed by a carriage return)
+       * continues the line. */
+      const char *prev = ptr - 1;
+      if (prev >= start && *prev == '\r') {
+        prev--;
+      }
+      if (prev < start || *prev != '\\') {
+        break;
+      }
+    }
+    ptr++;
+  }
+  StringRef line(start, ptr);
+  if (ptr < end) {
+    /* Skip the line break. */
+    ptr++;
+  }
+  buffer = StringRef(ptr, end);
+  if (!line.is_empty() && line.back() == '\r') {
+    line = line.drop_suffix(1);
+  }
+  return line;
+}
+
+StringRef drop_whitespace(StringRef str)
+{
+  const char *ptr = str.begin();
+  const char *end = str.end();
+  while (ptr < end) {
+    if (is_whitespace(*ptr)) {
+      ptr++;
+    }
+    else if (*ptr == '\\' && ptr + 1 < end && is_whitespace(ptr[1])) {
+      /* Line continuation. */
+      ptr++;
+    }
+    else {
+      break;
+    }
+  }
+  return StringRef(ptr, end);
+}
+
+StringRef drop_non_whitespace(StringRef str)
+{
+  const char *ptr = str.begin();
+  const char *end = str.end();
+  while (ptr < end && !is_whitespace(*ptr)) {
+    ptr++;
+  }
+  return StringRef(ptr, end);
+}
+
+static StringRef drop_sign(StringRef str, bool &r_negative)
+{
+  r_negative = false;
+  if (!str.is_empty()) {
+    if (str[0] == '-') {
+      r_negative = true;
+      return str.drop_prefix(1);
+    }
+    if (str[0] == '+') {
+      return str.drop_prefix(1);
+    }
+  }
+  return str;
+}
+
+StringRef parse_int(StringRef str, const int fallback, int &dst, const bool skip_space)
+{
+  if (skip_space) {
+    str = drop_whitespace(str);
+  }
+  bool negative;
+  const StringRef digits = drop_sign(str, negative);
+  const char *ptr = digits.begin();
+  const char *end = digits.end();
+  int64_t value = 0;
+  while (ptr < end && is_digit(*ptr)) {
+    /* Saturate instead of overflowing, the value is out of range for any index anyway. */
+    if (value <= INT32_MAX) {
+      value = value * 10 + (*ptr - '0');
+    }
+    ptr++;
+  }
+  if (ptr == digits.begin()) {
+    dst = fallback;
+    return str;
+  }
+  if (negative) {
+    value = -value;
+  }
+  dst = int(std::min<int64_t>(std::max<int64_t>(value, INT32_MIN), INT32_MAX));
+  return StringRef(ptr, end);
+}
+
+/* Powers of ten that are exactly representable as doubles. */
+static const double exact_powers_of_ten[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+StringRef parse_float(StringRef str, const float fallback, float &dst, const bool skip_space)
+{
+  if (skip_space) {
+    str = drop_whitespace(str);
+  }
+  bool negative;
+  const StringRef number = drop_sign(str, negative);
+  const char *ptr = number.begin();
+  const char *end = number.end();
+
+  /* Accumulate up to 19 significant digits in an integer, the remaining ones only affect the
+   * exponent. */
+  uint64_t mantissa = 0;
+  int significant_digits = 0;
+  int exponent = 0;
+  bool has_digits = false;
+  while (ptr < end && is_digit(*ptr)) {
+    if (significant_digits < 19) {
+      mantissa = mantissa * 10 + uint64_t(*ptr - '0');
+      significant_digits += mantissa != 0;
+    }
+    else {
+      exponent++;
+    }
+    has_digits = true;
+    ptr++;
+  }
+  if (ptr < end && *ptr == '.') {
+    ptr++;
+    while (ptr < end && is_digit(*ptr)) {
+      if (significant_digits < 19) {
+        mantissa = mantissa * 10 + uint64_t(*ptr - '0');
+        significant_digits += mantissa != 0;
+        exponent--;
+      }
+      has_digits = true;
+      ptr++;
+    }
+  }
+  if (!has_digits) {
+    dst = fallback;
+    return str;
+  }
+  if (ptr < end && (*ptr == 'e' || *ptr == 'E')) {
+    bool exponent_negative;
+    const StringRef exponent_digits = drop_sign(StringRef(ptr + 1, end), exponent_negative);
+    const char *exp_ptr = exponent_digits.begin();
+    int exponent_value = 0;
+    while (exp_ptr < end && is_digit(*exp_ptr)) {
+      if (exponent_value < 10000) {
+        exponent_value = exponent_value * 10 + (*exp_ptr - '0');
+      }
+      exp_ptr++;
+    }
+    /* An 'e' without digits is not part of the number. */
+    if (exp_ptr != exponent_digits.begin()) {
+      exponent += exponent_negative ? -exponent_value : exponent_value;
+      ptr = exp_ptr;
+    }
+  }
+
+  double value = double(mantissa);
+  if (mantissa != 0) {
+    if (exponent >= 0 && exponent <= 22) {
+      value *= exact_powers_of_ten[exponent];
+    }
+    else if (exponent < 0 && exponent >= -22) {
+      value /= exact_powers_of_ten[-exponent];
+    }
+    else {
+      value *= std::pow(10.0, double(exponent));
+    }
+  }
+  dst = float(negative ? -value : value);
+  return StringRef(ptr, end);
+}
+
+StringRef parse_floats(
+    StringRef str, const float fallback, float *dst, const int count, int *r_parsed_count)
+{
+  int parsed_count = 0;
+  for (int i = 0; i < count; i++) {
+    const StringRef rest = parse_float(str, fallback, dst[i]);
+    if (rest.data() == drop_whitespace(str).data()) {
+      /* Nothing was parsed, fill the remaining values with the fallback. */
+      for (int j = i + 1; j < count; j++) {
+        dst[j] = fallback;
+      }
+      break;
+    }
+    str = rest;
+    parsed_count++;
+  }
+  if (r_parsed_count) {
+    *r_parsed_count = parsed_count;
+  }
+  return str;
+}
+
+}  // namespace blender::io::obj
@@ -0,0 +1,73 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup obj
+ *
+ * Various text parsing utilities used by the OBJ and MTL importers.
+ *
+ * Many of these functions take a #StringRef as input and return the remainder of the input
+ * after the parsed item, so that calls can be chained over the contents of a line. None of
+ * them allocate memory, which keeps the parsing of large files cheap and allows them to be
+ * used from multiple threads at once.
+ */
+
+#pragma once
+
+#include "BLI_string_ref.hh"
+
+namespace blender::io::obj {
+
+/**
+ * Fetches the next line from the input buffer and advances the buffer past it.
+ * A backslash at the end of a line continues the line on the next one; the backslash and
+ * the line break stay in the returned line and are treated as whitespace by the parsing
+ * functions below.
+ *
+ * The returned line does not include the line break character(s).
+ */
+StringRef read_next_line(StringRef &buffer);
+
+/**
+ * Drop leading whitespace from a #StringRef. Line continuations (a backslash followed by a
+ * line break) count as whitespace.
+ */
+StringRef drop_whitespace(StringRef str);
+
+/**
+ * Drop leading non-whitespace characters from a #StringRef.
+ */
+StringRef drop_non_whitespace(StringRef str);
+
+/**
+ * Parse an integer from the start of the input #StringRef.
+ * If `skip_space` is true, any leading whitespace is dropped first.
+ *
+ * \return The remainder of the input after the parsed number. If no number could be parsed,
+ * `dst` is set to `fallback` and the input (minus skipped whitespace) is returned.
+ */
+StringRef parse_int(StringRef str, int fallback, int &dst, bool skip_space = true);
+
+/**
+ * Parse a float from the start of the input #StringRef.
+ * If `skip_space` is true, any leading whitespace is dropped first.
+ *
+ * This does not go through the C library, so it is not affected by the locale and is a lot
+ * faster than `strtof`. Numbers with more than 19 significant digits are rounded and the
+ * result may differ from a correctly rounded conversion in the last bit.
+ *
+ * \return The remainder of the input after the parsed number. If no number could be parsed,
+ * `dst` is set to `fallback` and the input (minus skipped whitespace) is returned.
+ */
+StringRef parse_float(StringRef str, float fallback, float &dst, bool skip_space = true);
+
+/**
+ * Parse up to `count` floats separated by whitespace, see #parse_float.
+ *
+ * \return The remainder of the input after the last parsed number.
+ * \param r_parsed_count: Optional, receives how many numbers were actually parsed; the rest
+ * of `dst` is filled with `fallback`.
+ */
+StringRef parse_floats(
+    StringRef str, float fallback, float *dst, int count, int *r_parsed_count = nullptr);
+
+}  // namespace blender::io::obj
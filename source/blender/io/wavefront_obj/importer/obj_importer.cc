@@ -0,0 +1,149 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup obj
+ */
+
+#include <memory>
+
+#include "BKE_collection.h"
+#include "BKE_context.h"
+#include "BKE_layer.h"
+#include "BKE_object.h"
+
+#include "BLI_map.hh"
+#include "BLI_math_matrix.h"
+#include "BLI_math_rotation.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
+
+#include "DEG_depsgraph.h"
+#include "DEG_depsgraph_build.h"
+
+#include "DNA_collection_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "obj_import_file_reader.hh"
+#include "obj_import_mesh.hh"
+#include "obj_import_mtl.hh"
+#include "obj_importer.hh"
+
+namespace blender::io::obj {
+
+/**
+ * Create the materials used in the file, indexed by global material index. Materials that are
+ * not defined in any .MTL file get the default settings.
+ */
+static Vector<Material *> create_materials(Main *bmain,
+                                           const OBJParser &obj_parser,
+                                           const OBJImportParams &import_params)
+{
+  Map<std::string, std::unique_ptr<MTLMaterial>> mtl_materials;
+  for (const std::string &mtl_library : obj_parser.mtl_libraries()) {
+    MTLParser mtl_parser{mtl_library, import_params.filepath};
+    mtl_parser.parse_and_store(mtl_materials);
+  }
+
+  Vector<Material *> materials;
+  for (const std::string &name : obj_parser.material_names()) {
+    const std::unique_ptr<MTLMaterial> *mtl_material = mtl_materials.lookup_ptr(name);
+    if (mtl_material) {
+      materials.append(create_material(bmain, **mtl_material));
+    }
+    else {
+      MTLMaterial default_material;
+      default_material.name = name;
+      materials.append(create_material(bmain, default_material));
+    }
+  }
+  return materials;
+}
+
+/**
+ * The transform of every imported object: the axis conversion, and a uniform scale when the
+ * file is larger than the clamp size.
+ */
+static void object_matrix_from_params(const OBJImportParams &import_params,
+                                      const float max_abs_coordinate,
+                                      float r_obmat[4][4])
+{
+  float axes_transform[3][3];
+  unit_m3(axes_transform);
+  /* +Y-forward and +Z-up are the default Blender axis settings. The matrix returned by
+   * mat3_from_axis_conversion is transposed, which makes it the inverse of the exporter's. */
+  mat3_from_axis_conversion(OBJ_AXIS_Y_FORWARD,
+                            OBJ_AXIS_Z_UP,
+                            import_params.forward_axis,
+                            import_params.up_axis,
+                            axes_transform);
+  unit_m4(r_obmat);
+  copy_m4_m3(r_obmat, axes_transform);
+
+  if (import_params.clamp_size > 0.0f && max_abs_coordinate > import_params.clamp_size) {
+    const float scale = import_params.clamp_size / max_abs_coordinate;
+    mul_mat3_m4_fl(r_obmat, scale);
+  }
+}
+
+void importer_main(Main *bmain,
+                   Scene *scene,
+                   ViewLayer *view_layer,
+                   const OBJImportParams &import_params)
+{
+  OBJParser obj_parser{import_params};
+  Vector<Geometry> all_geometries;
+  GlobalVertices global_vertices;
+  if (!obj_parser.parse(all_geometries, global_vertices)) {
+    return;
+  }
+
+  /* Meshes are built outside of #Main, so all objects can be built in parallel. */
+  Vector<std::unique_ptr<MeshFromGeometry>> mesh_builders;
+  for (const Geometry &geometry : all_geometries) {
+    mesh_builders.append(std::make_unique<MeshFromGeometry>(geometry, global_vertices));
+  }
+  threading::parallel_for(mesh_builders.index_range(), 1, [&](IndexRange range) {
+    for (const int i : range) {
+      mesh_builders[i]->create_mesh(import_params);
+    }
+  });
+
+  const Vector<Material *> materials = create_materials(bmain, obj_parser, import_params);
+
+  float obmat[4][4];
+  object_matrix_from_params(import_params, obj_parser.max_abs_coordinate(), obmat);
+
+  LayerCollection *lc = BKE_layer_collection_get_active(view_layer);
+  BKE_view_layer_base_deselect_all(view_layer);
+  for (std::unique_ptr<MeshFromGeometry> &mesh_builder : mesh_builders) {
+    Object *obj = mesh_builder->create_object(bmain, materials);
+    if (obj == nullptr) {
+      continue;
+    }
+    BKE_object_apply_mat4(obj, obmat, true, false);
+
+    BKE_collection_object_add(bmain, lc->collection, obj);
+    Base *base = BKE_view_layer_base_find(view_layer, obj);
+    BKE_view_layer_base_select_and_set_active(view_layer, base);
+
+    DEG_id_tag_update(&lc->collection->id, ID_RECALC_COPY_ON_WRITE);
+    DEG_id_tag_update_ex(bmain,
+                         &obj->id,
+                         ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY | ID_RECALC_ANIMATION |
+                             ID_RECALC_BASE_FLAGS);
+  }
+
+  DEG_id_tag_update(&scene->id, ID_RECALC_BASE_FLAGS);
+  DEG_relations_tag_update(bmain);
+}
+
+void importer_main(bContext *C, const OBJImportParams &import_params)
+{
+  Main *bmain = CTX_data_main(C);
+  Scene *scene = CTX_data_scene(C);
+  ViewLayer *view_layer = CTX_data_view_layer(C);
+  importer_main(bmain, scene, view_layer, import_params);
+}
+
+}  // namespace blender::io::obj
@@ -0,0 +1,32 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup obj
+ */
+
+#pragma once
+
+#include "IO_wavefront_obj.h"
+
+struct Main;
+struct Scene;
+struct ViewLayer;
+
+namespace blender::io::obj {
+
+/**
+ * Import the .OBJ file given by `import_params.filepath` into the active collection of the
+ * view layer in the context.
+ */
+void importer_main(bContext *C, const OBJImportParams &import_params);
+
+/**
+ * Import the .OBJ file without a context, the objects are added to the active collection of
+ * `view_layer`. Exposed for testing.
+ */
+void importer_main(Main *bmain,
+                   Scene *scene,
+                   ViewLayer *view_layer,
+                   const OBJImportParams &import_params);
+
+}  // namespace blender::io::obj
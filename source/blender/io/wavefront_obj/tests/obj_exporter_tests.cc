@@ -1,6 +1,8 @@
 /* SPDX-License-Identifier: Apache-2.0 */
 
 #include <gtest/gtest.h>
+#include <cfloat>
+#include <cmath>
 #include <ios>
 #include <memory>
 #include <string>
@@ -270,6 +272,63 @@ parm u 0.0
   ASSERT_EQ(got_string, expected);
 }
 
+TEST(obj_exporter_writer, format_handler_numbers)
+{
+  /* Numbers are formatted without `printf`, the result has to be identical. */
+  const float values[] = {0.0f,
+                          -0.0f,
+                          1.0f,
+                          -1.5f,
+                          0.1f,
+                          1e-7f,
+                          -4e-7f,
+                          5e-7f,
+                          0.0078125f,
+                          0.00048828125f,
+                          123456.789f,
+                          -98765.4321f,
+                          1.0e12f,
+                          3.0e20f,
+                          -FLT_MAX,
+                          FLT_MIN,
+                          FLT_TRUE_MIN,
+                          INFINITY};
+  for (const float value : values) {
+    FormatHandler<eFileType::OBJ> h;
+    h.write<eOBJSyntaxElement::vertex_coords>(value, value * 0.3f, -value);
+    h.write<eOBJSyntaxElement::normal>(value, value * 0.7f, value / 3.0f);
+    char expected[512];
+    std::snprintf(expected,
+                  sizeof(expected),
+                  "v %f %f %f\nvn %.4f %.4f %.4f\n",
+                  value,
+                  value * 0.3f,
+                  -value,
+                  value,
+                  value * 0.7f,
+                  value / 3.0f);
+    EXPECT_EQ(h.get_as_string(), expected);
+  }
+  /* Sweep over a range of exponents and mantissas. */
+  for (int i = 0; i < 200000; i++) {
+    const float value = (float(i) - 100000.0f) * powf(2.0f, float(i % 61) - 40.0f) / 7.0f;
+    FormatHandler<eFileType::OBJ> h;
+    h.write<eOBJSyntaxElement::uv_vertex_coords>(value, value * 0.5f);
+    char expected[128];
+    std::snprintf(expected, sizeof(expected), "vt %f %f\n", value, value * 0.5f);
+    ASSERT_EQ(h.get_as_string(), expected);
+  }
+
+  FormatHandler<eFileType::OBJ> h;
+  h.write<eOBJSyntaxElement::poly_element_begin>();
+  h.write<eOBJSyntaxElement::vertex_uv_normal_indices>(1, 20, 300);
+  h.write<eOBJSyntaxElement::vertex_normal_indices>(-4, 0);
+  h.write<eOBJSyntaxElement::vertex_indices>(INT32_MIN);
+  h.write<eOBJSyntaxElement::poly_element_end>();
+  h.write<eOBJSyntaxElement::edge>(INT32_MAX, 7);
+  EXPECT_EQ(h.get_as_string(), "f 1/20/300 -4//0 -2147483648\nl 2147483647 7\n");
+}
+
 /* Return true if string #a and string #b are equal after their first newline. */
 static bool strings_equal_after_first_lines(const std::string &a, const std::string &b)
 {
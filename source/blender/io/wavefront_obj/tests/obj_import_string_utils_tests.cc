@@ -0,0 +1,80 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "obj_import_string_utils.hh"
+
+#include "testing/testing.h"
+
+namespace blender::io::obj {
+
+TEST(obj_import_string_utils, read_next_line)
+{
+  StringRef buffer = "abc\r\ndef \\\n ghi\n\nlast";
+  EXPECT_EQ(read_next_line(buffer), "abc");
+  EXPECT_EQ(read_next_line(buffer), "def \\\n ghi");
+  EXPECT_EQ(read_next_line(buffer), "");
+  EXPECT_EQ(read_next_line(buffer), "last");
+  EXPECT_TRUE(buffer.is_empty());
+}
+
+TEST(obj_import_string_utils, drop_whitespace)
+{
+  EXPECT_EQ(drop_whitespace(""), "");
+  EXPECT_EQ(drop_whitespace("  \t abc "), "abc ");
+  /* Line continuations count as whitespace. */
+  EXPECT_EQ(drop_whitespace(" \\\n 1"), "1");
+  EXPECT_EQ(drop_whitespace("\\a"), "\\a");
+  EXPECT_EQ(drop_non_whitespace("abc def"), " def");
+}
+
+TEST(obj_import_string_utils, parse_int)
+{
+  int value;
+  EXPECT_EQ(parse_int(" 123 456", -1, value), " 456");
+  EXPECT_EQ(value, 123);
+  EXPECT_EQ(parse_int("-7/8", -1, value), "/8");
+  EXPECT_EQ(value, -7);
+  EXPECT_EQ(parse_int("+5", -1, value), "");
+  EXPECT_EQ(value, 5);
+  EXPECT_EQ(parse_int("abc", -1, value), "abc");
+  EXPECT_EQ(value, -1);
+  EXPECT_EQ(parse_int(" 1", -1, value, false), " 1");
+  EXPECT_EQ(value, -1);
+  EXPECT_EQ(parse_int("99999999999", -1, value), "");
+  EXPECT_EQ(value, INT32_MAX);
+}
+
+TEST(obj_import_string_utils, parse_float)
+{
+  float value;
+  EXPECT_EQ(parse_float("1.5 2", -1.0f, value), " 2");
+  EXPECT_FLOAT_EQ(value, 1.5f);
+  EXPECT_EQ(parse_float("-0.25", -1.0f, value), "");
+  EXPECT_FLOAT_EQ(value, -0.25f);
+  EXPECT_EQ(parse_float(".5e2x", -1.0f, value), "x");
+  EXPECT_FLOAT_EQ(value, 50.0f);
+  EXPECT_EQ(parse_float("1E-3", -1.0f, value), "");
+  EXPECT_FLOAT_EQ(value, 0.001f);
+  EXPECT_EQ(parse_float("7.e", -1.0f, value), "e");
+  EXPECT_FLOAT_EQ(value, 7.0f);
+  EXPECT_EQ(parse_float("0.123456789012345678901234", -1.0f, value), "");
+  EXPECT_FLOAT_EQ(value, 0.123456789f);
+  EXPECT_EQ(parse_float("12345678901234567890123", -1.0f, value), "");
+  EXPECT_FLOAT_EQ(value, 1.2345679e22f);
+  EXPECT_EQ(parse_float("off", -1.0f, value), "off");
+  EXPECT_FLOAT_EQ(value, -1.0f);
+  EXPECT_EQ(parse_float("-", -1.0f, value), "-");
+  EXPECT_FLOAT_EQ(value, -1.0f);
+}
+
+TEST(obj_import_string_utils, parse_floats)
+{
+  float values[4];
+  int count;
+  EXPECT_EQ(parse_floats(" 1 2 3", 0.5f, values, 4, &count), "");
+  EXPECT_EQ(count, 3);
+  EXPECT_FLOAT_EQ(values[0], 1.0f);
+  EXPECT_FLOAT_EQ(values[2], 3.0f);
+  EXPECT_FLOAT_EQ(values[3], 0.5f);
+}
+
+}  // namespace blender::io::obj
@@ -1101,6 +1101,8 @@ typedef struct AnimData {
 
   /** Runtime data, for depsgraph evaluation. */
   FCurve **driver_array;
+  /** Runtime cache of resolved RNA paths, see #BKE_animsys_rna_path_cache_ensure. */
+  struct AnimRNAPathCache *rna_path_cache;
 
   /* settings for animation evaluation */
   /** User-defined settings. */
@@ -122,6 +122,28 @@ void *DNA_struct_reconstruct(const struct DNA_ReconstructInfo *reconstruct_info,
                              int old_struct_nr,
                              int blocks,
                              const void *old_blocks);
+/**
+ * Same as #DNA_struct_reconstruct, but only allocates the new array. Different parts of a large
+ * array can then be reconstructed on separate threads with #DNA_struct_reconstruct_range.
+ *
+ * \return Zero initialized memory for \a blocks structs of the new type,
+ * or NULL when the struct doesn't exist anymore.
+ */
+void *DNA_struct_reconstruct_alloc(const struct DNA_ReconstructInfo *reconstruct_info,
+                                   int old_struct_nr,
+                                   int blocks);
+/**
+ * Reconstruct the \a blocks structs starting at index \a start of an array.
+ *
+ * \param old_blocks: The entire array of struct data.
+ * \param new_blocks: The entire array allocated by #DNA_struct_reconstruct_alloc.
+ */
+void DNA_struct_reconstruct_range(const struct DNA_ReconstructInfo *reconstruct_info,
+                                  int old_struct_nr,
+                                  int start,
+                                  int blocks,
+                                  const void *old_blocks,
+                                  void *new_blocks);
 
 /**
  * Returns the offset of the field with the specified name and type within the specified
@@ -560,7 +560,10 @@
   }
 
 #define _DNA_DEFAULT_NodesModifierData \
-  { 0 }
+  { \
+    .flag = 0, \
+    .cache_memory_limit = 1024, \
+  }
 
 #define _DNA_DEFAULT_SkinModifierData \
   { \
@@ -181,6 +181,8 @@ typedef enum {
 typedef struct SubsurfRuntimeData {
   /* Cached subdivision surface descriptor, with topology and settings. */
   struct Subdiv *subdiv;
+  /* Last result of the CPU subdivision, for updates where only positions change. */
+  struct SubdivMeshCache *mesh_cache;
   char set_by_draw_code;
   char _pad[7];
 } SubsurfRuntimeData;
@@ -2292,9 +2294,22 @@ typedef struct NodesModifierData {
    * This can be used to help the user to debug a node tree.
    */
   void *runtime_eval_log;
-  void *_pad1;
+  /**
+   * Node outputs that are kept between evaluations when #NODES_MODIFIER_USE_CACHE is set.
+   * Only used on the original modifier.
+   */
+  void *runtime_cache;
+  /** #NodesModifierFlag. */
+  int flag;
+  /** Maximum memory used by the node output cache in megabytes. */
+  int cache_memory_limit;
 } NodesModifierData;
 
+/** #NodesModifierData.flag */
+typedef enum NodesModifierFlag {
+  NODES_MODIFIER_USE_CACHE = (1 << 0),
+} NodesModifierFlag;
+
 typedef struct MeshToVolumeModifierData {
   ModifierData modifier;
 
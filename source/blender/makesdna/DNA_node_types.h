@@ -595,6 +595,7 @@ typedef struct bNodeTree {
 
 /* tree is localized copy, free when deleting node groups */
 /* #define NTREE_IS_LOCALIZED           (1 << 5) */
+#define NTREE_COM_USE_CACHE (1 << 6) /* keep expensive operation results between executions */
 
 /* tree->execution_mode */
 typedef enum eNodeTreeExecutionMode {
@@ -155,6 +155,9 @@ typedef struct FFMpegCodecData {
   int rc_buffer_size;
   int mux_packet_size;
   int mux_rate;
+  /** Encoder threads, 0 for automatic. */
+  int threads;
+  char _pad0[4];
   void *_pad1;
 } FFMpegCodecData;
 
@@ -1861,6 +1864,8 @@ typedef struct Scene {
 #define R_EDGE_FRS (1 << 25)        /* R_EDGE reserved for Freestyle */
 #define R_PERSISTENT_DATA (1 << 26) /* keep data around for re-render */
 #define R_MODE_UNUSED_27 (1 << 27)  /* cleared */
+/* Don't evaluate the frames skipped by the frame step when rendering animations. */
+#define R_SKIP_STEPPED_FRAMES (1 << 28)
 
 /** #RenderData.seq_flag */
 enum {
@@ -2187,6 +2192,7 @@ enum {
   FFMPEG_AUTOSPLIT_OUTPUT = (1 << 1),
   FFMPEG_LOSSLESS_OUTPUT = (1 << 2),
   FFMPEG_USE_MAX_B_FRAMES = (1 << 3),
+  FFMPEG_USE_HARDWARE_ENCODER = (1 << 4),
 };
 
 /** #Paint.flags */
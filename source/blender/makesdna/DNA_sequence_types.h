@@ -97,7 +97,8 @@ typedef struct StripProxy {
                           /* to build */
   short build_flags;
   char storage;
-  char _pad[5];
+  char codec; /* proxy codec (see below) */
+  char _pad[4];
 } StripProxy;
 
 typedef struct Strip {
@@ -290,6 +291,9 @@ typedef struct Editing {
   /* Cache control */
   float recycle_max_cost; /* UNUSED only for versioning. */
   int cache_flag;
+  /** Number of frames rendered at the same time when prefetching. */
+  int prefetch_threads;
+  char _pad2[4];
 
   struct PrefetchJob *prefetch_job;
 
@@ -608,6 +612,9 @@ enum {
 #define SEQ_PROXY_TC_RECORD_RUN_NO_GAPS 8
 #define SEQ_PROXY_TC_ALL 15
 
+#define SEQ_PROXY_CODEC_H264 0
+#define SEQ_PROXY_CODEC_MJPEG 1
+
 /** SeqProxy.build_flags */
 enum {
   SEQ_PROXY_SKIP_EXISTING = 1,
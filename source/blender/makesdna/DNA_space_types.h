@@ -606,6 +606,10 @@ typedef struct SpaceSeqRuntime {
   struct rctf last_thumbnail_area;
   /** Stores lists of most recently displayed thumbnails. */
   struct GHash *last_displayed_thumbnails;
+  /** Texture of the last displayed preview frame, re-used while that frame stays on screen. */
+  struct GPUTexture *display_texture;
+  /** Frame uploaded to `display_texture`, referenced so it can't be freed or changed. */
+  struct ImBuf *display_texture_ibuf;
 } SpaceSeqRuntime;
 
 /** Sequencer. */
@@ -650,7 +650,8 @@ typedef struct UserDef_Experimental {
   char use_extended_asset_browser;
   char use_override_templates;
   char use_named_attribute_nodes;
-  char _pad[2];
+  char use_draw_occlusion_culling;
+  char _pad[1];
   /** `makesdna` does not allow empty structs. */
 } UserDef_Experimental;
 
@@ -798,7 +799,8 @@ typedef struct UserDef {
   int prefetchframes;
   /** Control the rotation step of the view when PAD2, PAD4, PAD6&PAD8 is use. */
   float pad_rot_angle;
-  char _pad12[4];
+  /** Memory limit in megabytes for still image buffers, 0 disables the limit. */
+  int image_memory_limit;
   /** Rotating view icon size. */
   short rvisize;
   /** Rotating view icon brightness. */
@@ -929,7 +931,7 @@ typedef struct UserDef {
 
   float collection_instance_empty_size;
   char text_flag;
-  char _pad10[1];
+  char video_flag; /* eUserpref_VideoFlag */
 
   char file_preview_type; /* eUserpref_File_Preview_Type */
   char statusbar_flag;    /* eUserpref_StatusBar_Flag */
@@ -1130,6 +1132,7 @@ typedef enum eUserpref_GPU_Flag {
   USER_GPU_FLAG_NO_EDIT_MODE_SMOOTH_WIRE = (1 << 1),
   USER_GPU_FLAG_OVERLAY_SMOOTH_WIRE = (1 << 2),
   USER_GPU_FLAG_SUBDIVISION_EVALUATION = (1 << 3),
+  USER_GPU_FLAG_TEXTURE_COMPRESSION = (1 << 4),
 } eUserpref_GPU_Flag;
 
 /** #UserDef.tablet_api */
@@ -1389,6 +1392,11 @@ typedef enum eUserpref_SeqProxySetup {
   USER_SEQ_PROXY_SETUP_AUTOMATIC = 1,
 } eUserpref_SeqProxySetup;
 
+/** #UserDef.video_flag */
+typedef enum eUserpref_VideoFlag {
+  USER_VIDEO_HARDWARE_DECODING = (1 << 0),
+} eUserpref_VideoFlag;
+
 /* Locale Ids. Auto will try to get local from OS. Our default is English though. */
 /** #UserDef.language */
 enum {
@@ -1121,6 +1121,9 @@ typedef struct DNA_ReconstructInfo {
 
   int *step_counts;
   ReconstructStep **steps;
+
+  /** Index in `newsdna->structs` for every struct in `oldsdna`, -1 when it has been removed. */
+  int *new_struct_nr_from_old;
 } DNA_ReconstructInfo;
 
 static void reconstruct_structs(const DNA_ReconstructInfo *reconstruct_info,
@@ -1212,17 +1215,13 @@ static void reconstruct_structs(const DNA_ReconstructInfo *reconstruct_info,
   }
 }
 
-void *DNA_struct_reconstruct(const DNA_ReconstructInfo *reconstruct_info,
-                             int old_struct_nr,
-                             int blocks,
-                             const void *old_blocks)
+void *DNA_struct_reconstruct_alloc(const DNA_ReconstructInfo *reconstruct_info,
+                                   int old_struct_nr,
+                                   int blocks)
 {
-  const SDNA *oldsdna = reconstruct_info->oldsdna;
   const SDNA *newsdna = reconstruct_info->newsdna;
 
-  const SDNA_Struct *old_struct = oldsdna->structs[old_struct_nr];
-  const char *type_name = oldsdna->types[old_struct->type];
-  const int new_struct_nr = DNA_struct_find_nr(newsdna, type_name);
+  const int new_struct_nr = reconstruct_info->new_struct_nr_from_old[old_struct_nr];
 
   if (new_struct_nr == -1) {
     return NULL;
@@ -1231,9 +1230,42 @@ void *DNA_struct_reconstruct(const DNA_ReconstructInfo *reconstruct_info,
   const SDNA_Struct *new_struct = newsdna->structs[new_struct_nr];
   const int new_block_size = newsdna->types_size[new_struct->type];
 
-  char *new_blocks = MEM_callocN(blocks * new_block_size, "reconstruct");
-  reconstruct_structs(
-      reconstruct_info, blocks, old_struct_nr, new_struct_nr, old_blocks, new_blocks);
+  return MEM_callocN((size_t)blocks * new_block_size, "reconstruct");
+}
+
+void DNA_struct_reconstruct_range(const DNA_ReconstructInfo *reconstruct_info,
+                                  int old_struct_nr,
+                                  int start,
+                                  int blocks,
+                                  const void *old_blocks,
+                                  void *new_blocks)
+{
+  const int new_struct_nr = reconstruct_info->new_struct_nr_from_old[old_struct_nr];
+  BLI_assert(new_struct_nr != -1);
+
+  const SDNA_Struct *old_struct = reconstruct_info->oldsdna->structs[old_struct_nr];
+  const SDNA_Struct *new_struct = reconstruct_info->newsdna->structs[new_struct_nr];
+  const int old_block_size = reconstruct_info->oldsdna->types_size[old_struct->type];
+  const int new_block_size = reconstruct_info->newsdna->types_size[new_struct->type];
+
+  reconstruct_structs(reconstruct_info,
+                      blocks,
+                      old_struct_nr,
+                      new_struct_nr,
+                      (const char *)old_blocks + (size_t)start * old_block_size,
+                      (char *)new_blocks + (size_t)start * new_block_size);
+}
+
+void *DNA_struct_reconstruct(const DNA_ReconstructInfo *reconstruct_info,
+                             int old_struct_nr,
+                             int blocks,
+                             const void *old_blocks)
+{
+  void *new_blocks = DNA_struct_reconstruct_alloc(reconstruct_info, old_struct_nr, blocks);
+  if (new_blocks != NULL) {
+    DNA_struct_reconstruct_range(
+        reconstruct_info, old_struct_nr, 0, blocks, old_blocks, new_blocks);
+  }
   return new_blocks;
 }
 
@@ -1509,6 +1541,112 @@ static int compress_reconstruct_steps(ReconstructStep *steps, const int old_step
   return new_step_count;
 }
 
+/** Move a step to a different position in the old and new struct. */
+static void offset_reconstruct_step(ReconstructStep *step, const int old_delta, const int new_delta)
+{
+  switch (step->type) {
+    case RECONSTRUCT_STEP_MEMCPY:
+      step->data.memcpy.old_offset += old_delta;
+      step->data.memcpy.new_offset += new_delta;
+      break;
+    case RECONSTRUCT_STEP_CAST_PRIMITIVE:
+      step->data.cast_primitive.old_offset += old_delta;
+      step->data.cast_primitive.new_offset += new_delta;
+      break;
+    case RECONSTRUCT_STEP_CAST_POINTER_TO_32:
+    case RECONSTRUCT_STEP_CAST_POINTER_TO_64:
+      step->data.cast_pointer.old_offset += old_delta;
+      step->data.cast_pointer.new_offset += new_delta;
+      break;
+    case RECONSTRUCT_STEP_SUBSTRUCT:
+      step->data.substruct.old_offset += old_delta;
+      step->data.substruct.new_offset += new_delta;
+      break;
+    case RECONSTRUCT_STEP_INIT_ZERO:
+      break;
+  }
+}
+
+/**
+ * Nested structs that are not equal in both files would otherwise be reconstructed with a
+ * recursive call for every element. Below this number of resulting steps, their steps are
+ * copied into the parent struct instead, which also lets adjacent copies be merged.
+ */
+#define RECONSTRUCT_FLATTEN_MAX_STEPS 256
+
+static void flatten_reconstruct_steps(DNA_ReconstructInfo *reconstruct_info,
+                                      const int new_struct_nr,
+                                      bool *flattened)
+{
+  if (flattened[new_struct_nr]) {
+    return;
+  }
+  flattened[new_struct_nr] = true;
+
+  const SDNA *oldsdna = reconstruct_info->oldsdna;
+  const SDNA *newsdna = reconstruct_info->newsdna;
+  ReconstructStep *steps = reconstruct_info->steps[new_struct_nr];
+  const int step_count = reconstruct_info->step_counts[new_struct_nr];
+
+  /* Flatten nested structs first and count the steps after flattening. */
+  int flat_step_count = 0;
+  bool has_flattened_substruct = false;
+  for (int a = 0; a < step_count; a++) {
+    const ReconstructStep *step = &steps[a];
+    if (step->type == RECONSTRUCT_STEP_SUBSTRUCT) {
+      const int sub_struct_nr = step->data.substruct.new_struct_nr;
+      flatten_reconstruct_steps(reconstruct_info, sub_struct_nr, flattened);
+      const int sub_step_count = step->data.substruct.array_len *
+                                 reconstruct_info->step_counts[sub_struct_nr];
+      if (sub_step_count <= RECONSTRUCT_FLATTEN_MAX_STEPS) {
+        flat_step_count += sub_step_count;
+        has_flattened_substruct = true;
+        continue;
+      }
+    }
+    flat_step_count++;
+  }
+
+  if (!has_flattened_substruct) {
+    return;
+  }
+
+  ReconstructStep *flat_steps = MEM_malloc_arrayN(
+      (size_t)flat_step_count, sizeof(ReconstructStep), __func__);
+  int flat_step_index = 0;
+  for (int a = 0; a < step_count; a++) {
+    const ReconstructStep *step = &steps[a];
+    if (step->type == RECONSTRUCT_STEP_SUBSTRUCT) {
+      const int sub_struct_nr = step->data.substruct.new_struct_nr;
+      const ReconstructStep *sub_steps = reconstruct_info->steps[sub_struct_nr];
+      const int sub_step_count = reconstruct_info->step_counts[sub_struct_nr];
+      if (step->data.substruct.array_len * sub_step_count <= RECONSTRUCT_FLATTEN_MAX_STEPS) {
+        const SDNA_Struct *old_sub_struct = oldsdna->structs[step->data.substruct.old_struct_nr];
+        const SDNA_Struct *new_sub_struct = newsdna->structs[sub_struct_nr];
+        const int old_size = oldsdna->types_size[old_sub_struct->type];
+        const int new_size = newsdna->types_size[new_sub_struct->type];
+        for (int elem = 0; elem < step->data.substruct.array_len; elem++) {
+          for (int b = 0; b < sub_step_count; b++) {
+            ReconstructStep *flat_step = &flat_steps[flat_step_index++];
+            *flat_step = sub_steps[b];
+            offset_reconstruct_step(flat_step,
+                                    step->data.substruct.old_offset + elem * old_size,
+                                    step->data.substruct.new_offset + elem * new_size);
+          }
+        }
+        continue;
+      }
+    }
+    flat_steps[flat_step_index++] = *step;
+  }
+  BLI_assert(flat_step_index == flat_step_count);
+
+  MEM_freeN(steps);
+  reconstruct_info->steps[new_struct_nr] = flat_steps;
+  reconstruct_info->step_counts[new_struct_nr] = compress_reconstruct_steps(flat_steps,
+                                                                            flat_step_count);
+}
+
 DNA_ReconstructInfo *DNA_reconstruct_info_create(const SDNA *oldsdna,
                                                  const SDNA *newsdna,
                                                  const char *compare_flags)
@@ -1520,6 +1658,13 @@ DNA_ReconstructInfo *DNA_reconstruct_info_create(const SDNA *oldsdna,
   reconstruct_info->step_counts = MEM_malloc_arrayN(newsdna->structs_len, sizeof(int), __func__);
   reconstruct_info->steps = MEM_malloc_arrayN(
       newsdna->structs_len, sizeof(ReconstructStep *), __func__);
+  reconstruct_info->new_struct_nr_from_old = MEM_malloc_arrayN(
+      oldsdna->structs_len, sizeof(int), __func__);
+  for (int old_struct_nr = 0; old_struct_nr < oldsdna->structs_len; old_struct_nr++) {
+    const SDNA_Struct *old_struct = oldsdna->structs[old_struct_nr];
+    reconstruct_info->new_struct_nr_from_old[old_struct_nr] = DNA_struct_find_nr(
+        newsdna, oldsdna->types[old_struct->type]);
+  }
 
   /* Generate reconstruct steps for all structs. */
   for (int new_struct_nr = 0; new_struct_nr < newsdna->structs_len; new_struct_nr++) {
@@ -1553,6 +1698,13 @@ DNA_ReconstructInfo *DNA_reconstruct_info_create(const SDNA *oldsdna,
     UNUSED_VARS(print_reconstruct_step);
   }
 
+  /* Replace recursive reconstruction of small nested structs by their steps. */
+  bool *flattened = MEM_callocN(sizeof(bool) * (size_t)newsdna->structs_len, __func__);
+  for (int new_struct_nr = 0; new_struct_nr < newsdna->structs_len; new_struct_nr++) {
+    flatten_reconstruct_steps(reconstruct_info, new_struct_nr, flattened);
+  }
+  MEM_freeN(flattened);
+
   return reconstruct_info;
 }
 
@@ -1565,6 +1717,7 @@ void DNA_reconstruct_info_free(DNA_ReconstructInfo *reconstruct_info)
   }
   MEM_freeN(reconstruct_info->steps);
   MEM_freeN(reconstruct_info->step_counts);
+  MEM_freeN(reconstruct_info->new_struct_nr_from_old);
   MEM_freeN(reconstruct_info);
 }
 
@@ -62,21 +62,13 @@ const PointerRNA PointerRNA_NULL = {NULL};
 void RNA_init(void)
 {
   StructRNA *srna;
-  PropertyRNA *prop;
 
   BLENDER_RNA.structs_map = BLI_ghash_str_new_ex(__func__, 2048);
   BLENDER_RNA.structs_len = 0;
 
+  /* The property hashes of the structs are created on first lookup, see
+   * #rna_builtin_properties_lookup_string, most structs are never looked up by name. */
   for (srna = BLENDER_RNA.structs.first; srna; srna = srna->cont.next) {
-    if (!srna->cont.prophash) {
-      srna->cont.prophash = BLI_ghash_str_new("RNA_init gh");
-
-      for (prop = srna->cont.properties.first; prop; prop = prop->next) {
-        if (!(prop->flag_internal & PROP_INTERN_BUILTIN)) {
-          BLI_ghash_insert(srna->cont.prophash, (void *)prop->identifier, prop);
-        }
-      }
-    }
     BLI_assert(srna->flag & STRUCT_PUBLIC_NAMESPACE);
     BLI_ghash_insert(BLENDER_RNA.structs_map, (void *)srna->identifier, srna);
     BLENDER_RNA.structs_len += 1;
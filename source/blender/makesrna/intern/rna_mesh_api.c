@@ -188,6 +188,35 @@ static void rna_Mesh_count_selected_items(Mesh *mesh, int r_count[3])
   BKE_mesh_count_selected_items(mesh, r_count);
 }
 
+static void rna_Mesh_from_arrays(Mesh *mesh,
+                                 ReportList *reports,
+                                 int positions_len,
+                                 float *positions,
+                                 int face_offsets_len,
+                                 int *face_offsets,
+                                 int corner_verts_len,
+                                 int *corner_verts)
+{
+  if (face_offsets_len < 1) {
+    BKE_report(reports, RPT_ERROR, "Face offsets must contain at least one value");
+    return;
+  }
+  const char *error = BKE_mesh_assign_from_arrays(mesh,
+                                                  (const float(*)[3])positions,
+                                                  positions_len / 3,
+                                                  face_offsets,
+                                                  face_offsets_len - 1,
+                                                  corner_verts,
+                                                  corner_verts_len);
+  if (error) {
+    BKE_report(reports, RPT_ERROR, error);
+    return;
+  }
+
+  DEG_id_tag_update(&mesh->id, ID_RECALC_GEOMETRY_ALL_MODES);
+  WM_main_add_notifier(NC_GEOM | ND_DATA, mesh);
+}
+
 static void rna_Mesh_clear_geometry(Mesh *mesh)
 {
   BKE_mesh_clear_geometry(mesh);
@@ -203,6 +232,7 @@ void RNA_api_mesh(StructRNA *srna)
   FunctionRNA *func;
   PropertyRNA *parm;
   const int normals_array_dim[] = {1, 3};
+  const int positions_array_dim[] = {1, 3};
 
   func = RNA_def_function(srna, "transform", "rna_Mesh_transform");
   RNA_def_function_ui_description(func,
@@ -317,6 +347,33 @@ void RNA_api_mesh(StructRNA *srna)
       func, "result", "nothing", 64, "Return value", "String description of result of comparison");
   RNA_def_function_return(func, parm);
 
+  func = RNA_def_function(srna, "from_arrays", "rna_Mesh_from_arrays");
+  RNA_def_function_ui_description(
+      func,
+      "Replace the geometry of the mesh with faces defined by flat arrays, edges are calculated "
+      "from the faces. Contiguous float32 and int32 buffers (e.g. NumPy arrays) are read "
+      "without converting each value");
+  RNA_def_function_flag(func, FUNC_USE_REPORTS);
+  parm = RNA_def_float_array(
+      func, "positions", 1, NULL, -FLT_MAX, FLT_MAX, "", "Vertex positions", 0.0f, 0.0f);
+  RNA_def_property_multi_array(parm, 2, positions_array_dim);
+  RNA_def_parameter_flags(parm, PROP_DYNAMIC, PARM_REQUIRED);
+  parm = RNA_def_int_array(func,
+                           "face_offsets",
+                           1,
+                           NULL,
+                           0,
+                           INT_MAX,
+                           "",
+                           "Index of the first corner of every face, followed by the number of "
+                           "corners",
+                           0,
+                           INT_MAX);
+  RNA_def_parameter_flags(parm, PROP_DYNAMIC, PARM_REQUIRED);
+  parm = RNA_def_int_array(
+      func, "corner_verts", 1, NULL, 0, INT_MAX, "", "Vertex index of every corner", 0, INT_MAX);
+  RNA_def_parameter_flags(parm, PROP_DYNAMIC, PARM_REQUIRED);
+
   func = RNA_def_function(srna, "clear_geometry", "rna_Mesh_clear_geometry");
   RNA_def_function_ui_description(
       func,
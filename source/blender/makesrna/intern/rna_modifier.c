@@ -1642,6 +1642,15 @@ static void rna_NodesModifier_node_group_update(Main *bmain, Scene *scene, Point
   MOD_nodes_update_interface(object, nmd);
 }
 
+static void rna_NodesModifier_use_cache_update(Main *bmain, Scene *scene, PointerRNA *ptr)
+{
+  NodesModifierData *nmd = ptr->data;
+  if (!(nmd->flag & NODES_MODIFIER_USE_CACHE)) {
+    MOD_nodes_cache_free(nmd);
+  }
+  rna_Modifier_update(bmain, scene, ptr);
+}
+
 static IDProperty **rna_NodesModifier_properties(PointerRNA *ptr)
 {
   NodesModifierData *nmd = ptr->data;
@@ -6940,6 +6949,23 @@ static void rna_def_modifier_nodes(BlenderRNA *brna)
   RNA_def_property_flag(prop, PROP_EDITABLE);
   RNA_def_property_update(prop, 0, "rna_NodesModifier_node_group_update");
 
+  prop = RNA_def_property(srna, "use_cache", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", NODES_MODIFIER_USE_CACHE);
+  RNA_def_property_ui_text(
+      prop,
+      "Use Cache",
+      "Keep node outputs between evaluations, so that only nodes whose inputs changed are "
+      "computed again");
+  RNA_def_property_update(prop, 0, "rna_NodesModifier_use_cache_update");
+
+  prop = RNA_def_property(srna, "cache_memory_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "cache_memory_limit");
+  RNA_def_property_range(prop, 1, INT_MAX);
+  RNA_def_property_ui_range(prop, 16, 16384, 16, -1);
+  RNA_def_property_ui_text(
+      prop, "Cache Memory Limit", "Maximum memory used by cached node outputs in megabytes");
+  RNA_def_property_update(prop, 0, "rna_Modifier_update");
+
   RNA_define_lib_overridable(false);
 }
 
@@ -12434,6 +12434,15 @@ static void rna_def_composite_nodetree(BlenderRNA *brna)
   RNA_def_property_ui_text(
       prop, "Viewer Region", "Use boundaries for viewer nodes and composite backdrop");
   RNA_def_property_update(prop, NC_NODE | ND_DISPLAY, "rna_NodeTree_update");
+
+  prop = RNA_def_property(srna, "use_cache", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", NTREE_COM_USE_CACHE);
+  RNA_def_property_ui_text(prop,
+                           "Cache Results",
+                           "Keep the results of expensive nodes like Denoise, Defocus and Vector "
+                           "Blur between executions while editing, so changes further down the "
+                           "tree don't recompute them (only supported in Full Frame mode)");
+  RNA_def_property_update(prop, NC_NODE | ND_DISPLAY, "rna_NodeTree_update");
 }
 
 static void rna_def_shader_nodetree(BlenderRNA *brna)
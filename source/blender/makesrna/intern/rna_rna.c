@@ -123,7 +123,10 @@ const EnumPropertyItem rna_enum_property_unit_items[] = {
 /** \} */
 
 #ifdef RNA_RUNTIME
+#  include "atomic_ops.h"
+
 #  include "BLI_ghash.h"
+#  include "BLI_listbase.h"
 #  include "BLI_string.h"
 #  include "MEM_guardedalloc.h"
 
@@ -413,6 +416,33 @@ PointerRNA rna_builtin_properties_get(CollectionPropertyIterator *iter)
   return rna_Struct_properties_get(iter);
 }
 
+/**
+ * Get the hash of properties by identifier of a built-in struct, creating it on first use.
+ * Runtime structs have no hash and are searched linearly.
+ */
+static GHash *rna_struct_prophash_ensure(StructRNA *srna)
+{
+  GHash *prophash = srna->cont.prophash;
+  if (prophash || (srna->flag & STRUCT_RUNTIME)) {
+    return prophash;
+  }
+
+  prophash = BLI_ghash_str_new_ex(__func__, BLI_listbase_count(&srna->cont.properties));
+  LISTBASE_FOREACH (PropertyRNA *, prop, &srna->cont.properties) {
+    if (!(prop->flag_internal & PROP_INTERN_BUILTIN)) {
+      BLI_ghash_insert(prophash, (void *)prop->identifier, prop);
+    }
+  }
+
+  /* Lookups can happen from multiple threads, e.g. when evaluating drivers. */
+  GHash *prophash_prev = atomic_cas_ptr((void **)&srna->cont.prophash, NULL, prophash);
+  if (prophash_prev != NULL) {
+    BLI_ghash_free(prophash, NULL, NULL);
+    return prophash_prev;
+  }
+  return prophash;
+}
+
 int rna_builtin_properties_lookup_string(PointerRNA *ptr, const char *key, PointerRNA *r_ptr)
 {
   StructRNA *srna;
@@ -422,8 +452,9 @@ int rna_builtin_properties_lookup_string(PointerRNA *ptr, const char *key, Point
   srna = ptr->type;
 
   do {
-    if (srna->cont.prophash) {
-      prop = BLI_ghash_lookup(srna->cont.prophash, (void *)key);
+    GHash *prophash = rna_struct_prophash_ensure(srna);
+    if (prophash) {
+      prop = BLI_ghash_lookup(prophash, (void *)key);
 
       if (prop) {
         propptr.type = &RNA_Property;
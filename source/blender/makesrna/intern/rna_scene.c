@@ -5800,6 +5800,25 @@ static void rna_def_scene_ffmpeg_settings(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Use Max B-Frames", "Set a maximum number of B-frames");
   RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, NULL);
 
+  prop = RNA_def_property(srna, "use_hardware_encoder", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flags", FFMPEG_USE_HARDWARE_ENCODER);
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_ui_text(prop,
+                           "Hardware Encoder",
+                           "Encode H.264 on the GPU (NVENC, Quick Sync, AMF or VideoToolbox) when "
+                           "available, falls back to the software encoder otherwise");
+  RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, NULL);
+
+  prop = RNA_def_property(srna, "threads", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "threads");
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_range(prop, 0, BLENDER_MAX_THREADS);
+  RNA_def_property_ui_text(
+      prop,
+      "Encoder Threads",
+      "Number of threads the video encoder uses, 0 to use one per processor core");
+  RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, NULL);
+
   prop = RNA_def_property(srna, "buffersize", PROP_INT, PROP_NONE);
   RNA_def_property_int_sdna(prop, NULL, "rc_buffer_size");
   RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
@@ -6228,6 +6247,16 @@ static void rna_def_scene_render_data(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Overwrite", "Overwrite existing files while rendering");
   RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, NULL);
 
+  prop = RNA_def_property(srna, "use_skip_stepped_frames", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "mode", R_SKIP_STEPPED_FRAMES);
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_ui_text(prop,
+                           "Skip Stepped Frames",
+                           "Don't evaluate the frames skipped by the frame step when rendering "
+                           "an animation, frame change handlers don't run for them. Simulations "
+                           "still step through every frame");
+  RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, NULL);
+
   prop = RNA_def_property(srna, "use_compositing", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, NULL, "scemode", R_DOCOMP);
   RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
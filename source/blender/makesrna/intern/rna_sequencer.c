@@ -40,6 +40,7 @@
 #include "SEQ_prefetch.h"
 #include "SEQ_proxy.h"
 #include "SEQ_relations.h"
+#include "SEQ_render.h"
 #include "SEQ_sequencer.h"
 #include "SEQ_sound.h"
 #include "SEQ_time.h"
@@ -245,6 +246,14 @@ static int rna_SequenceEditor_sequences_all_lookup_string(PointerRNA *ptr,
   return false;
 }
 
+static void rna_SequenceEditor_prefetch_threads_update(Main *UNUSED(bmain),
+                                                      Scene *scene,
+                                                      PointerRNA *UNUSED(ptr))
+{
+  /* Workers are created when prefetching starts again. */
+  SEQ_prefetch_stop(scene);
+}
+
 static void rna_SequenceEditor_update_cache(Main *UNUSED(bmain),
                                             Scene *scene,
                                             PointerRNA *UNUSED(ptr))
@@ -1536,6 +1545,16 @@ static void rna_def_strip_proxy(BlenderRNA *brna)
       {0, NULL, 0, NULL, NULL},
   };
 
+  static const EnumPropertyItem seq_proxy_codec_items[] = {
+      {SEQ_PROXY_CODEC_H264, "H264", 0, "H.264", "Small files, slower to build and to seek in"},
+      {SEQ_PROXY_CODEC_MJPEG,
+       "MJPEG",
+       0,
+       "Motion JPEG",
+       "Every frame is a key frame, fast to build and to scrub through but larger files"},
+      {0, NULL, 0, NULL, NULL},
+  };
+
   srna = RNA_def_struct(brna, "SequenceProxy", NULL);
   RNA_def_struct_ui_text(srna, "Sequence Proxy", "Proxy parameters for a sequence strip");
   RNA_def_struct_sdna(srna, "StripProxy");
@@ -1593,6 +1612,11 @@ static void rna_def_strip_proxy(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Quality", "Quality of proxies to build");
   RNA_def_property_ui_range(prop, 1, 100, 1, -1);
 
+  prop = RNA_def_property(srna, "codec", PROP_ENUM, PROP_NONE);
+  RNA_def_property_enum_sdna(prop, NULL, "codec");
+  RNA_def_property_enum_items(prop, seq_proxy_codec_items);
+  RNA_def_property_ui_text(prop, "Codec", "Codec used to encode movie proxies");
+
   prop = RNA_def_property(srna, "timecode", PROP_ENUM, PROP_NONE);
   RNA_def_property_enum_sdna(prop, NULL, "tc");
   RNA_def_property_enum_items(prop, seq_tc_items);
@@ -2222,6 +2246,16 @@ static void rna_def_editor(BlenderRNA *brna)
       "Prefetch Frames",
       "Render frames ahead of current frame in the background for faster playback");
   RNA_def_property_update(prop, NC_SCENE | ND_SEQUENCER, NULL);
+
+  prop = RNA_def_property(srna, "prefetch_threads", PROP_INT, PROP_NONE);
+  RNA_def_property_range(prop, 1, SEQ_PREFETCH_WORKERS_MAX);
+  RNA_def_property_ui_text(prop,
+                           "Prefetch Threads",
+                           "Number of frames rendered at the same time when prefetching. Edits "
+                           "with scene, clip, mask or text strips always render one frame at a "
+                           "time");
+  RNA_def_property_update(
+      prop, NC_SCENE | ND_SEQUENCER, "rna_SequenceEditor_prefetch_threads_update");
 }
 
 static void rna_def_filter_video(StructRNA *srna)
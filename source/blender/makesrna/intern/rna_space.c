@@ -2316,6 +2316,7 @@ static void seq_build_proxy(bContext *C, PointerRNA *ptr)
   GSet *file_list = BLI_gset_new(BLI_ghashutil_strhash_p, BLI_ghashutil_strcmp, "file list");
   wmJob *wm_job = ED_seq_proxy_wm_job_get(C);
   ProxyJob *pj = ED_seq_proxy_job_get(C, wm_job);
+  ListBase queue = {NULL, NULL};
 
   LISTBASE_FOREACH (Sequence *, seq, seqbase) {
     if (seq->type != SEQ_TYPE_MOVIE || seq->strip == NULL || seq->strip->proxy == NULL) {
@@ -2327,10 +2328,11 @@ static void seq_build_proxy(bContext *C, PointerRNA *ptr)
 
     /* Build proxy. */
     SEQ_proxy_rebuild_context(
-        pj->main, pj->depsgraph, pj->scene, seq, file_list, &pj->queue, true);
+        pj->main, pj->depsgraph, pj->scene, seq, file_list, &queue, true);
   }
 
   BLI_gset_free(file_list, MEM_freeN);
+  ED_seq_proxy_job_queue_add(pj, &queue);
 
   if (!WM_jobs_is_running(wm_job)) {
     G.is_break = false;
@@ -5521,6 +5521,15 @@ static void rna_def_userdef_system(BlenderRNA *brna)
   RNA_def_property_enum_sdna(prop, NULL, "sequencer_proxy_setup");
   RNA_def_property_ui_text(prop, "Proxy Setup", "When and how proxies are created");
 
+  /* Video decoding */
+
+  prop = RNA_def_property(srna, "use_hardware_video_decoding", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "video_flag", USER_VIDEO_HARDWARE_DECODING);
+  RNA_def_property_ui_text(prop,
+                           "Hardware Video Decoding",
+                           "Decode movies on the GPU when the system supports it, falls back to "
+                           "software decoding otherwise (applies to movies opened afterwards)");
+
   prop = RNA_def_property(srna, "scrollback", PROP_INT, PROP_UNSIGNED);
   RNA_def_property_int_sdna(prop, NULL, "scrollback");
   RNA_def_property_range(prop, 32, 32768);
@@ -5610,6 +5619,15 @@ static void rna_def_userdef_system(BlenderRNA *brna)
       prop, "GL Texture Limit", "Limit the texture size to save graphics memory");
   RNA_def_property_update(prop, 0, "rna_userdef_gl_texture_limit_update");
 
+  prop = RNA_def_property(srna, "use_texture_compression", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "gpu_flag", USER_GPU_FLAG_TEXTURE_COMPRESSION);
+  RNA_def_property_ui_text(prop,
+                           "Texture Compression",
+                           "Store 8-bit image textures block compressed on the GPU, using less "
+                           "graphics memory and bandwidth at a small cost in quality and "
+                           "loading time");
+  RNA_def_property_update(prop, 0, "rna_userdef_gl_texture_limit_update");
+
   prop = RNA_def_property(srna, "texture_time_out", PROP_INT, PROP_NONE);
   RNA_def_property_int_sdna(prop, NULL, "textimeout");
   RNA_def_property_range(prop, 0, 3600);
@@ -5627,6 +5645,16 @@ static void rna_def_userdef_system(BlenderRNA *brna)
       "Texture Collection Rate",
       "Number of seconds between each run of the GL texture garbage collector");
 
+  prop = RNA_def_property(srna, "image_memory_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "image_memory_limit");
+  RNA_def_property_range(prop, 0, max_memory_in_megabytes_int());
+  RNA_def_property_ui_text(
+      prop,
+      "Image Memory Limit",
+      "Maximum memory used by loaded image buffers (in megabytes). Least recently used images "
+      "which are not modified are freed and reloaded from disk when needed "
+      "(set to 0 to keep all images loaded)");
+
   prop = RNA_def_property(srna, "vbo_time_out", PROP_INT, PROP_NONE);
   RNA_def_property_int_sdna(prop, NULL, "vbotimeout");
   RNA_def_property_range(prop, 0, 3600);
@@ -6393,6 +6421,14 @@ static void rna_def_userdef_experimental(BlenderRNA *brna)
                            "reduces execution time and memory usage)");
   RNA_def_property_update(prop, 0, "rna_userdef_update");
 
+  prop = RNA_def_property(srna, "use_draw_occlusion_culling", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_draw_occlusion_culling", 1);
+  RNA_def_property_ui_text(prop,
+                           "Viewport Occlusion Culling",
+                           "Skip drawing objects hidden behind other objects in the previous "
+                           "viewport redraw");
+  RNA_def_property_update(prop, 0, "rna_userdef_update");
+
   prop = RNA_def_property(srna, "use_new_curves_type", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, NULL, "use_new_curves_type", 1);
   RNA_def_property_ui_text(prop, "New Curves Type", "Enable the new curves data type in the UI");
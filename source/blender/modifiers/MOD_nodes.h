@@ -19,6 +19,11 @@ void MOD_nodes_update_interface(struct Object *object, struct NodesModifierData
 
 void MOD_nodes_init(struct Main *bmain, struct NodesModifierData *nmd);
 
+/**
+ * Free the node outputs that are kept between evaluations of the modifier.
+ */
+void MOD_nodes_cache_free(struct NodesModifierData *nmd);
+
 #ifdef __cplusplus
 }
 #endif
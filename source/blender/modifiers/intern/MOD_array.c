@@ -12,6 +12,7 @@
 #include "BLI_utildefines.h"
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "BLT_translation.h"
 
@@ -350,6 +351,91 @@ static void mesh_merge_transform(Mesh *result,
   }
 }
 
+typedef struct ArrayCopyData {
+  const ArrayModifierData *amd;
+  const Mesh *mesh;
+  Mesh *result;
+  /** Cumulative offset of every copy. */
+  const float (*offsets)[4][4];
+  const float (*src_vert_normals)[3];
+  float (*dst_vert_normals)[3];
+} ArrayCopyData;
+
+/**
+ * Fill one copy of the original geometry, the copies are independent of each other.
+ */
+static void array_copy_task_cb(void *__restrict userdata,
+                               const int c,
+                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ArrayCopyData *data = userdata;
+  const Mesh *mesh = data->mesh;
+  Mesh *result = data->result;
+  const float(*current_offset)[4] = data->offsets[c];
+  const int chunk_nverts = mesh->totvert;
+  const int chunk_nedges = mesh->totedge;
+  const int chunk_nloops = mesh->totloop;
+  const int chunk_npolys = mesh->totpoly;
+  int i;
+
+  /* copy customdata to new geometry */
+  CustomData_copy_data(&mesh->vdata, &result->vdata, 0, c * chunk_nverts, chunk_nverts);
+  CustomData_copy_data(&mesh->edata, &result->edata, 0, c * chunk_nedges, chunk_nedges);
+  CustomData_copy_data(&mesh->ldata, &result->ldata, 0, c * chunk_nloops, chunk_nloops);
+  CustomData_copy_data(&mesh->pdata, &result->pdata, 0, c * chunk_npolys, chunk_npolys);
+
+  const int vert_offset = c * chunk_nverts;
+
+  /* apply offset to all new verts */
+  for (i = 0; i < chunk_nverts; i++) {
+    const int i_dst = vert_offset + i;
+    mul_m4_v3(current_offset, result->mvert[i_dst].co);
+
+    /* We have to correct normals too, if we do not tag them as dirty! */
+    if (data->dst_vert_normals) {
+      copy_v3_v3(data->dst_vert_normals[i_dst], data->src_vert_normals[i]);
+      mul_mat3_m4_v3(current_offset, data->dst_vert_normals[i_dst]);
+      normalize_v3(data->dst_vert_normals[i_dst]);
+    }
+  }
+
+  /* adjust edge vertex indices */
+  MEdge *me = result->medge + c * chunk_nedges;
+  for (i = 0; i < chunk_nedges; i++, me++) {
+    me->v1 += c * chunk_nverts;
+    me->v2 += c * chunk_nverts;
+  }
+
+  MPoly *mp = result->mpoly + c * chunk_npolys;
+  for (i = 0; i < chunk_npolys; i++, mp++) {
+    mp->loopstart += c * chunk_nloops;
+  }
+
+  /* adjust loop vertex and edge indices */
+  MLoop *ml = result->mloop + c * chunk_nloops;
+  for (i = 0; i < chunk_nloops; i++, ml++) {
+    ml->v += c * chunk_nverts;
+    ml->e += c * chunk_nedges;
+  }
+
+  /* handle UVs */
+  if (chunk_nloops > 0 && is_zero_v2(data->amd->uv_offset) == false) {
+    const float uv_offset[2] = {
+        data->amd->uv_offset[0] * (float)c,
+        data->amd->uv_offset[1] * (float)c,
+    };
+    const int totuv = CustomData_number_of_layers(&result->ldata, CD_MLOOPUV);
+    for (i = 0; i < totuv; i++) {
+      MLoopUV *dmloopuv = CustomData_get_layer_n(&result->ldata, CD_MLOOPUV, i);
+      dmloopuv += c * chunk_nloops;
+      for (int l_index = 0; l_index < chunk_nloops; l_index++, dmloopuv++) {
+        dmloopuv->uv[0] += uv_offset[0];
+        dmloopuv->uv[1] += uv_offset[1];
+      }
+    }
+  }
+}
+
 static Mesh *arrayModifier_doArray(ArrayModifierData *amd,
                                    const ModifierEvalContext *ctx,
                                    Mesh *mesh)
@@ -357,9 +443,6 @@ static Mesh *arrayModifier_doArray(ArrayModifierData *amd,
   const MVert *src_mvert;
   MVert *result_dm_verts;
 
-  MEdge *me;
-  MLoop *ml;
-  MPoly *mp;
   int i, j, c, count;
   float length = amd->length;
   /* offset matrix */
@@ -575,107 +658,66 @@ static Mesh *arrayModifier_doArray(ArrayModifierData *amd,
     BKE_mesh_vertex_normals_clear_dirty(result);
   }
 
+  /* The cumulative offsets are computed first, so that the copies can be filled in parallel. */
+  float(*offsets)[4][4] = MEM_malloc_arrayN((size_t)count, sizeof(*offsets), __func__);
+  copy_m4_m4(offsets[0], current_offset);
   for (c = 1; c < count; c++) {
-    /* copy customdata to new geometry */
-    CustomData_copy_data(&mesh->vdata, &result->vdata, 0, c * chunk_nverts, chunk_nverts);
-    CustomData_copy_data(&mesh->edata, &result->edata, 0, c * chunk_nedges, chunk_nedges);
-    CustomData_copy_data(&mesh->ldata, &result->ldata, 0, c * chunk_nloops, chunk_nloops);
-    CustomData_copy_data(&mesh->pdata, &result->pdata, 0, c * chunk_npolys, chunk_npolys);
-
-    const int vert_offset = c * chunk_nverts;
-
     /* recalculate cumulative offset here */
     mul_m4_m4m4(current_offset, current_offset, offset);
+    copy_m4_m4(offsets[c], current_offset);
+  }
 
-    /* apply offset to all new verts */
-    for (i = 0; i < chunk_nverts; i++) {
-      const int i_dst = vert_offset + i;
-      mul_m4_v3(current_offset, result_dm_verts[i_dst].co);
-
-      /* We have to correct normals too, if we do not tag them as dirty! */
-      if (!use_recalc_normals) {
-        copy_v3_v3(dst_vert_normals[i_dst], src_vert_normals[i]);
-        mul_mat3_m4_v3(current_offset, dst_vert_normals[i_dst]);
-        normalize_v3(dst_vert_normals[i_dst]);
-      }
-    }
-
-    /* adjust edge vertex indices */
-    me = result->medge + c * chunk_nedges;
-    for (i = 0; i < chunk_nedges; i++, me++) {
-      me->v1 += c * chunk_nverts;
-      me->v2 += c * chunk_nverts;
-    }
-
-    mp = result->mpoly + c * chunk_npolys;
-    for (i = 0; i < chunk_npolys; i++, mp++) {
-      mp->loopstart += c * chunk_nloops;
-    }
-
-    /* adjust loop vertex and edge indices */
-    ml = result->mloop + c * chunk_nloops;
-    for (i = 0; i < chunk_nloops; i++, ml++) {
-      ml->v += c * chunk_nverts;
-      ml->e += c * chunk_nedges;
-    }
-
-    /* Handle merge between chunk n and n-1 */
-    if (use_merge && (c >= 1)) {
-      if (!offset_has_scale && (c >= 2)) {
-        /* Mapping chunk 3 to chunk 2 is a translation of mapping 2 to 1
-         * ... that is except if scaling makes the distance grow */
-        int k;
-        int this_chunk_index = c * chunk_nverts;
-        int prev_chunk_index = (c - 1) * chunk_nverts;
-        for (k = 0; k < chunk_nverts; k++, this_chunk_index++, prev_chunk_index++) {
-          int target = full_doubles_map[prev_chunk_index];
-          if (target != -1) {
-            target += chunk_nverts; /* translate mapping */
-            while (target != -1 && !ELEM(full_doubles_map[target], -1, target)) {
-              /* If target is already mapped, we only follow that mapping if final target remains
-               * close enough from current vert (otherwise no mapping at all). */
-              if (compare_len_v3v3(result_dm_verts[this_chunk_index].co,
-                                   result_dm_verts[full_doubles_map[target]].co,
-                                   amd->merge_dist)) {
-                target = full_doubles_map[target];
-              }
-              else {
-                target = -1;
-              }
+  ArrayCopyData copy_data = {
+      .amd = amd,
+      .mesh = mesh,
+      .result = result,
+      .offsets = (const float(*)[4][4])offsets,
+      .src_vert_normals = src_vert_normals,
+      .dst_vert_normals = dst_vert_normals,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  /* Avoid the threading overhead for copies of small meshes. */
+  settings.min_iter_per_thread = max_ii(1, 4096 / max_ii(1, chunk_nverts + chunk_nloops));
+  BLI_task_parallel_range(1, count, &copy_data, array_copy_task_cb, &settings);
+  MEM_freeN(offsets);
+
+  /* Handle merge between chunk n and n-1 */
+  for (c = 1; use_merge && c < count; c++) {
+    if (!offset_has_scale && (c >= 2)) {
+      /* Mapping chunk 3 to chunk 2 is a translation of mapping 2 to 1
+       * ... that is except if scaling makes the distance grow */
+      int k;
+      int this_chunk_index = c * chunk_nverts;
+      int prev_chunk_index = (c - 1) * chunk_nverts;
+      for (k = 0; k < chunk_nverts; k++, this_chunk_index++, prev_chunk_index++) {
+        int target = full_doubles_map[prev_chunk_index];
+        if (target != -1) {
+          target += chunk_nverts; /* translate mapping */
+          while (target != -1 && !ELEM(full_doubles_map[target], -1, target)) {
+            /* If target is already mapped, we only follow that mapping if final target remains
+             * close enough from current vert (otherwise no mapping at all). */
+            if (compare_len_v3v3(result_dm_verts[this_chunk_index].co,
+                                 result_dm_verts[full_doubles_map[target]].co,
+                                 amd->merge_dist)) {
+              target = full_doubles_map[target];
+            }
+            else {
+              target = -1;
             }
           }
-          full_doubles_map[this_chunk_index] = target;
         }
-      }
-      else {
-        dm_mvert_map_doubles(full_doubles_map,
-                             result_dm_verts,
-                             (c - 1) * chunk_nverts,
-                             chunk_nverts,
-                             c * chunk_nverts,
-                             chunk_nverts,
-                             amd->merge_dist);
+        full_doubles_map[this_chunk_index] = target;
       }
     }
-  }
-
-  /* handle UVs */
-  if (chunk_nloops > 0 && is_zero_v2(amd->uv_offset) == false) {
-    const int totuv = CustomData_number_of_layers(&result->ldata, CD_MLOOPUV);
-    for (i = 0; i < totuv; i++) {
-      MLoopUV *dmloopuv = CustomData_get_layer_n(&result->ldata, CD_MLOOPUV, i);
-      dmloopuv += chunk_nloops;
-      for (c = 1; c < count; c++) {
-        const float uv_offset[2] = {
-            amd->uv_offset[0] * (float)c,
-            amd->uv_offset[1] * (float)c,
-        };
-        int l_index = chunk_nloops;
-        for (; l_index-- != 0; dmloopuv++) {
-          dmloopuv->uv[0] += uv_offset[0];
-          dmloopuv->uv[1] += uv_offset[1];
-        }
-      }
+    else {
+      dm_mvert_map_doubles(full_doubles_map,
+                           result_dm_verts,
+                           (c - 1) * chunk_nverts,
+                           chunk_nverts,
+                           c * chunk_nverts,
+                           chunk_nverts,
+                           amd->merge_dist);
     }
   }
 
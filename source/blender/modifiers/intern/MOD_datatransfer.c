@@ -72,6 +72,19 @@ static void initData(ModifierData *md)
   dtmd->flags = MOD_DATATRANSFER_OBSRC_TRANSFORM;
 }
 
+static void freeRuntimeData(void *runtime_data)
+{
+  if (runtime_data != NULL) {
+    BKE_object_data_transfer_remap_cache_free(runtime_data);
+  }
+}
+
+static void freeData(ModifierData *md)
+{
+  freeRuntimeData(md->runtime);
+  md->runtime = NULL;
+}
+
 static void requiredDataMask(Object *UNUSED(ob),
                              ModifierData *md,
                              CustomData_MeshMasks *r_cddata_masks)
@@ -187,6 +200,11 @@ static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *
 
   BKE_reports_init(&reports, RPT_STORE);
 
+  /* Keep the geometry mappings around, they rarely change between evaluations. */
+  if (md->runtime == NULL) {
+    md->runtime = BKE_object_data_transfer_remap_cache_create();
+  }
+
   /* NOTE: no islands precision for now here. */
   if (BKE_object_data_transfer_ex(ctx->depsgraph,
                                   scene,
@@ -210,6 +228,7 @@ static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *
                                   dtmd->mix_factor,
                                   dtmd->defgrp_name,
                                   invert_vgroup,
+                                  md->runtime,
                                   &reports)) {
     result->runtime.is_original = false;
   }
@@ -473,14 +492,14 @@ ModifierTypeInfo modifierType_DataTransfer = {
 
     /* initData */ initData,
     /* requiredDataMask */ requiredDataMask,
-    /* freeData */ NULL,
+    /* freeData */ freeData,
     /* isDisabled */ isDisabled,
     /* updateDepsgraph */ updateDepsgraph,
     /* dependsOnTime */ NULL,
     /* dependsOnNormals */ dependsOnNormals,
     /* foreachIDLink */ foreachIDLink,
     /* foreachTexLink */ NULL,
-    /* freeRuntimeData */ NULL,
+    /* freeRuntimeData */ freeRuntimeData,
     /* panelRegister */ panelRegister,
     /* blendWrite */ NULL,
     /* blendRead */ NULL,
@@ -32,9 +32,11 @@
 #include "MOD_modifiertypes.h"
 #include "MOD_ui_common.h"
 
+#include "BLI_array.hh"
 #include "BLI_float4x4.hh"
 #include "BLI_index_range.hh"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 
 #include "RNA_access.h"
 #include "RNA_prototypes.h"
@@ -49,17 +51,23 @@ namespace blender {
 /* This class follows the MeshDataAdapter interface from openvdb. */
 class OpenVDBMeshAdapter {
  private:
-  Span<MVert> vertices_;
+  /* Vertex positions in index space. OpenVDB queries every triangle corner several times while
+   * voxelizing, so the positions are transformed once up front instead of on every query. */
+  Array<float3> positions_;
   Span<MLoop> loops_;
   Span<MLoopTri> looptris_;
-  float4x4 transform_;
 
  public:
   OpenVDBMeshAdapter(Mesh &mesh, float4x4 transform)
-      : vertices_(mesh.mvert, mesh.totvert),
-        loops_(mesh.mloop, mesh.totloop),
-        transform_(transform)
+      : positions_(mesh.totvert, NoInitialization()), loops_(mesh.mloop, mesh.totloop)
   {
+    const Span<MVert> vertices{mesh.mvert, mesh.totvert};
+    threading::parallel_for(vertices.index_range(), 4096, [&](const IndexRange range) {
+      for (const int i : range) {
+        positions_[i] = transform * float3(vertices[i].co);
+      }
+    });
+
     const MLoopTri *looptries = BKE_mesh_runtime_looptri_ensure(&mesh);
     const int looptries_len = BKE_mesh_runtime_looptri_len(&mesh);
     looptris_ = Span(looptries, looptries_len);
@@ -72,7 +80,7 @@ class OpenVDBMeshAdapter {
 
   size_t pointCount() const
   {
-    return static_cast<size_t>(vertices_.size());
+    return static_cast<size_t>(positions_.size());
   }
 
   size_t vertexCount(size_t UNUSED(polygon_index)) const
@@ -84,9 +92,8 @@ class OpenVDBMeshAdapter {
   void getIndexSpacePoint(size_t polygon_index, size_t vertex_index, openvdb::Vec3d &pos) const
   {
     const MLoopTri &looptri = looptris_[polygon_index];
-    const MVert &vertex = vertices_[loops_[looptri.tri[vertex_index]].v];
-    const float3 transformed_co = transform_ * float3(vertex.co);
-    pos = &transformed_co.x;
+    const float3 &co = positions_[loops_[looptri.tri[vertex_index]].v];
+    pos = openvdb::Vec3d(co.x, co.y, co.z);
   }
 };
 }  // namespace blender
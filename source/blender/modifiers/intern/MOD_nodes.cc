@@ -70,6 +70,7 @@
 
 #include "MOD_modifiertypes.h"
 #include "MOD_nodes.h"
+#include "MOD_nodes_cache.hh"
 #include "MOD_nodes_evaluator.hh"
 #include "MOD_ui_common.h"
 
@@ -112,6 +113,8 @@ using blender::fn::ValueOrFieldCPPType;
 using blender::nodes::FieldInferencingInterface;
 using blender::nodes::GeoNodeExecParams;
 using blender::nodes::InputSocketFieldType;
+using blender::modifiers::geometry_nodes::NodeOutputCache;
+using blender::modifiers::geometry_nodes::NodeOutputCacheStats;
 using blender::threading::EnumerableThreadSpecific;
 using namespace blender::fn::multi_function_types;
 using namespace blender::nodes::derived_node_tree_types;
@@ -920,6 +923,32 @@ static void clear_runtime_data(NodesModifierData *nmd)
   }
 }
 
+void MOD_nodes_cache_free(NodesModifierData *nmd)
+{
+  if (nmd->runtime_cache != nullptr) {
+    delete static_cast<NodeOutputCache *>(nmd->runtime_cache);
+    nmd->runtime_cache = nullptr;
+  }
+}
+
+/**
+ * The cache is stored on the original modifier, so that it survives the re-creation of the
+ * evaluated copy. Multiple depsgraphs may evaluate the same modifier at the same time, hence the
+ * lock when it is created.
+ */
+static NodeOutputCache *ensure_node_output_cache(NodesModifierData &nmd,
+                                                 const ModifierEvalContext &ctx)
+{
+  NodesModifierData *nmd_orig = reinterpret_cast<NodesModifierData *>(
+      BKE_modifier_get_original(ctx.object, &nmd.modifier));
+  static std::mutex mutex;
+  std::lock_guard lock{mutex};
+  if (nmd_orig->runtime_cache == nullptr) {
+    nmd_orig->runtime_cache = new NodeOutputCache();
+  }
+  return static_cast<NodeOutputCache *>(nmd_orig->runtime_cache);
+}
+
 struct OutputAttributeInfo {
   GField field;
   StringRefNull name;
@@ -1136,6 +1165,11 @@ static GeometrySet compute_geometry(const DerivedNodeTree &tree,
   eval_params.depsgraph = ctx->depsgraph;
   eval_params.self_object = ctx->object;
   eval_params.geo_logger = geo_logger.has_value() ? &*geo_logger : nullptr;
+  if (nmd->flag & NODES_MODIFIER_USE_CACHE) {
+    NodeOutputCache *cache = ensure_node_output_cache(*nmd, *ctx);
+    cache->begin_evaluation(int64_t(nmd->cache_memory_limit) * 1024 * 1024);
+    eval_params.cache = cache;
+  }
   blender::modifiers::geometry_nodes::evaluate_geometry_nodes(eval_params);
 
   GeometrySet output_geometry_set = std::move(*eval_params.r_output_values[0].get<GeometrySet>());
@@ -1281,7 +1315,9 @@ static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *
 {
   GeometrySet geometry_set = GeometrySet::create_with_mesh(mesh, GeometryOwnershipType::Editable);
 
+  const eMEMCategory prev_mem_category = MEM_category_set(MEM_CATEGORY_GEOMETRY_NODES);
   modifyGeometry(md, ctx, geometry_set);
+  MEM_category_set(prev_mem_category);
 
   Mesh *new_mesh = geometry_set.get_component_for_write<MeshComponent>().release();
   if (new_mesh == nullptr) {
@@ -1294,7 +1330,9 @@ static void modifyGeometrySet(ModifierData *md,
                               const ModifierEvalContext *ctx,
                               GeometrySet *geometry_set)
 {
+  const eMEMCategory prev_mem_category = MEM_category_set(MEM_CATEGORY_GEOMETRY_NODES);
   modifyGeometry(md, ctx, *geometry_set);
+  MEM_category_set(prev_mem_category);
 }
 
 struct AttributeSearchData {
@@ -1645,6 +1683,50 @@ static void output_attribute_panel_draw(const bContext *C, Panel *panel)
   }
 }
 
+static void cache_header_draw(const bContext *UNUSED(C), Panel *panel)
+{
+  uiLayout *layout = panel->layout;
+  PointerRNA *ptr = modifier_panel_get_property_pointers(panel, nullptr);
+  uiItemR(layout, ptr, "use_cache", 0, nullptr, ICON_NONE);
+}
+
+static void cache_panel_draw(const bContext *UNUSED(C), Panel *panel)
+{
+  uiLayout *layout = panel->layout;
+
+  PointerRNA *ptr = modifier_panel_get_property_pointers(panel, nullptr);
+  NodesModifierData *nmd = static_cast<NodesModifierData *>(ptr->data);
+
+  uiLayoutSetPropSep(layout, true);
+  uiLayoutSetPropDecorate(layout, false);
+
+  uiLayout *col = uiLayoutColumn(layout, false);
+  uiLayoutSetActive(col, nmd->flag & NODES_MODIFIER_USE_CACHE);
+  uiItemR(col, ptr, "cache_memory_limit", 0, IFACE_("Memory Limit"), ICON_NONE);
+
+  if (nmd->runtime_cache == nullptr) {
+    return;
+  }
+  const NodeOutputCacheStats stats = static_cast<NodeOutputCache *>(nmd->runtime_cache)->stats();
+  char memory_str[15];
+  BLI_str_format_byte_unit(memory_str, stats.memory_bytes, true);
+  char str[256];
+  BLI_snprintf(str, sizeof(str), TIP_("Memory: %s"), memory_str);
+  uiItemL(col, str, ICON_NONE);
+  BLI_snprintf(str,
+               sizeof(str),
+               TIP_("Entries: %lld, Evictions: %lld"),
+               (long long)stats.entries,
+               (long long)stats.evictions);
+  uiItemL(col, str, ICON_NONE);
+  BLI_snprintf(str,
+               sizeof(str),
+               TIP_("Last Evaluation: %lld hits, %lld misses"),
+               (long long)stats.hits,
+               (long long)stats.misses);
+  uiItemL(col, str, ICON_NONE);
+}
+
 static void panelRegister(ARegionType *region_type)
 {
   PanelType *panel_type = modifier_panel_register(region_type, eModifierType_Nodes, panel_draw);
@@ -1654,6 +1736,8 @@ static void panelRegister(ARegionType *region_type)
                              nullptr,
                              output_attribute_panel_draw,
                              panel_type);
+  modifier_subpanel_register(
+      region_type, "cache", "", cache_header_draw, cache_panel_draw, panel_type);
 }
 
 static void blendWrite(BlendWriter *writer, const ModifierData *md)
@@ -1672,6 +1756,7 @@ static void blendRead(BlendDataReader *reader, ModifierData *md)
   BLO_read_data_address(reader, &nmd->settings.properties);
   IDP_BlendDataRead(reader, &nmd->settings.properties);
   nmd->runtime_eval_log = nullptr;
+  nmd->runtime_cache = nullptr;
 }
 
 static void copyData(const ModifierData *md, ModifierData *target, const int flag)
@@ -1682,6 +1767,7 @@ static void copyData(const ModifierData *md, ModifierData *target, const int fla
   BKE_modifier_copydata_generic(md, target, flag);
 
   tnmd->runtime_eval_log = nullptr;
+  tnmd->runtime_cache = nullptr;
 
   if (nmd->settings.properties != nullptr) {
     tnmd->settings.properties = IDP_CopyProperty_ex(nmd->settings.properties, flag);
@@ -1697,6 +1783,7 @@ static void freeData(ModifierData *md)
   }
 
   clear_runtime_data(nmd);
+  MOD_nodes_cache_free(nmd);
 }
 
 static void requiredDataMask(Object *UNUSED(ob),
@@ -0,0 +1,184 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "MOD_nodes_cache.hh"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_float4x4.hh"
+
+#include "BKE_attribute_access.hh"
+#include "BKE_geometry_set.hh"
+
+namespace blender::modifiers::geometry_nodes {
+
+/**
+ * Rough estimate of the memory used by a geometry. It is not exact, because that would require
+ * knowledge about the internals of every component, but good enough to keep the cache from
+ * growing without bounds.
+ */
+static int64_t estimate_geometry_memory(const GeometrySet &geometry_set)
+{
+  int64_t memory = 0;
+  for (const GeometryComponent *component : geometry_set.get_components_for_read()) {
+    component->attribute_foreach(
+        [&](const bke::AttributeIDRef &UNUSED(attribute_id), const AttributeMetaData &meta_data) {
+          const CPPType *type = bke::custom_data_type_to_cpp_type(meta_data.data_type);
+          if (type != nullptr) {
+            memory += type->size() * component->attribute_domain_size(meta_data.domain);
+          }
+          return true;
+        });
+    if (component->type() == GEO_COMPONENT_TYPE_INSTANCES) {
+      const InstancesComponent &instances = *static_cast<const InstancesComponent *>(component);
+      memory += instances.instances_amount() * sizeof(float4x4);
+    }
+  }
+  return memory;
+}
+
+static int64_t estimate_value_memory(const GPointer value)
+{
+  const CPPType &type = *value.type();
+  if (type.is<GeometrySet>()) {
+    return type.size() + estimate_geometry_memory(*value.get<GeometrySet>());
+  }
+  return type.size();
+}
+
+NodeOutputCache::~NodeOutputCache()
+{
+  this->clear();
+}
+
+void NodeOutputCache::begin_evaluation(const int64_t memory_limit)
+{
+  std::lock_guard lock{mutex_};
+  evaluation_counter_++;
+  memory_limit_ = memory_limit;
+  stats_.hits = 0;
+  stats_.misses = 0;
+  this->remove_least_recently_used_entries();
+}
+
+bool NodeOutputCache::lookup(const NodeOutputCacheKey &key,
+                             const Span<int> output_indices,
+                             const FunctionRef<void(int output_index, GPointer value)> fn)
+{
+  std::lock_guard lock{mutex_};
+  Entry *entry = entries_.lookup_ptr(key.hash);
+  if (entry == nullptr || entry->key_data.as_span() != key.data.as_span()) {
+    stats_.misses++;
+    return false;
+  }
+  Vector<const CachedValue *, 16> found_values;
+  for (const int output_index : output_indices) {
+    const CachedValue *found_value = nullptr;
+    for (const CachedValue &cached_value : entry->values) {
+      if (cached_value.output_index == output_index) {
+        found_value = &cached_value;
+        break;
+      }
+    }
+    if (found_value == nullptr) {
+      /* Not all outputs that are used now have been used when the entry was created. */
+      stats_.misses++;
+      return false;
+    }
+    found_values.append(found_value);
+  }
+  for (const CachedValue *cached_value : found_values) {
+    fn(cached_value->output_index, {cached_value->type, cached_value->value});
+  }
+  entry->last_used = evaluation_counter_;
+  stats_.hits++;
+  return true;
+}
+
+void NodeOutputCache::add(const NodeOutputCacheKey &key,
+                          const int output_index,
+                          const GPointer value)
+{
+  const CPPType &type = *value.type();
+  void *buffer = MEM_mallocN_aligned(type.size(), type.alignment(), __func__);
+  type.copy_construct(value.get(), buffer);
+  const int64_t value_memory = estimate_value_memory(value);
+
+  std::lock_guard lock{mutex_};
+  Entry *existing_entry = entries_.lookup_ptr(key.hash);
+  if (existing_entry != nullptr && existing_entry->key_data.as_span() != key.data.as_span()) {
+    /* Hash collision with a different computation, only keep the most recent one. */
+    this->remove_entry(key.hash);
+  }
+  Entry &entry = entries_.lookup_or_add_cb(key.hash, [&]() {
+    Entry new_entry;
+    new_entry.key_data = key.data;
+    return new_entry;
+  });
+  for (CachedValue &cached_value : entry.values) {
+    if (cached_value.output_index == output_index) {
+      /* The same value has been added by another evaluation already. */
+      type.destruct(buffer);
+      MEM_freeN(buffer);
+      return;
+    }
+  }
+  entry.values.append({output_index, &type, buffer});
+  entry.memory_bytes += value_memory;
+  entry.last_used = evaluation_counter_;
+  memory_bytes_ += value_memory;
+  this->remove_least_recently_used_entries();
+}
+
+void NodeOutputCache::clear()
+{
+  std::lock_guard lock{mutex_};
+  for (Entry &entry : entries_.values()) {
+    free_entry(entry);
+  }
+  entries_.clear();
+  memory_bytes_ = 0;
+}
+
+NodeOutputCacheStats NodeOutputCache::stats() const
+{
+  std::lock_guard lock{mutex_};
+  NodeOutputCacheStats stats = stats_;
+  stats.entries = entries_.size();
+  stats.memory_bytes = memory_bytes_;
+  return stats;
+}
+
+void NodeOutputCache::free_entry(Entry &entry)
+{
+  for (CachedValue &cached_value : entry.values) {
+    cached_value.type->destruct(cached_value.value);
+    MEM_freeN(cached_value.value);
+  }
+  entry.values.clear();
+}
+
+void NodeOutputCache::remove_least_recently_used_entries()
+{
+  while (memory_bytes_ > memory_limit_ && !entries_.is_empty()) {
+    /* The number of entries is in the order of the number of nodes, so a linear search is fine. */
+    uint64_t oldest_key = 0;
+    uint64_t oldest_usage = UINT64_MAX;
+    for (auto item : entries_.items()) {
+      if (item.value.last_used < oldest_usage) {
+        oldest_usage = item.value.last_used;
+        oldest_key = item.key;
+      }
+    }
+    this->remove_entry(oldest_key);
+    stats_.evictions++;
+  }
+}
+
+void NodeOutputCache::remove_entry(const uint64_t hash)
+{
+  Entry entry = entries_.pop(hash);
+  memory_bytes_ -= entry.memory_bytes;
+  free_entry(entry);
+}
+
+}  // namespace blender::modifiers::geometry_nodes
@@ -0,0 +1,106 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include <mutex>
+
+#include "BLI_function_ref.hh"
+#include "BLI_map.hh"
+#include "BLI_vector.hh"
+
+#include "FN_generic_pointer.hh"
+
+namespace blender::modifiers::geometry_nodes {
+
+using fn::CPPType;
+using fn::GPointer;
+
+struct NodeOutputCacheStats {
+  /** Number of nodes whose outputs were found in the cache in the last evaluation. */
+  int64_t hits = 0;
+  /** Number of cacheable nodes that had to be computed in the last evaluation. */
+  int64_t misses = 0;
+  /** Number of entries that have been removed to stay below the memory limit in total. */
+  int64_t evictions = 0;
+  int64_t entries = 0;
+  int64_t memory_bytes = 0;
+};
+
+/**
+ * Describes everything that can influence the outputs of a node: the node itself, its unlinked
+ * input values and the keys of all nodes it depends on.
+ */
+struct NodeOutputCacheKey {
+  /** Serialized description of the inputs, compared on lookup. */
+  Vector<uint8_t> data;
+  /** Hash of #data. */
+  uint64_t hash = 0;
+};
+
+/**
+ * Keeps output values of nodes between evaluations of a geometry nodes modifier. Entries are
+ * identified by a #NodeOutputCacheKey, so a node only has to be computed again when something
+ * upstream changed. Entries are found by the hash of the key and the full key data is compared
+ * as well, so hash collisions can't return the outputs of a different computation.
+ *
+ * The cache is thread-safe, because the same original modifier may be evaluated by multiple
+ * depsgraphs at the same time.
+ */
+class NodeOutputCache : NonCopyable, NonMovable {
+ private:
+  struct CachedValue {
+    int output_index;
+    const CPPType *type;
+    void *value;
+  };
+
+  struct Entry {
+    Vector<uint8_t> key_data;
+    Vector<CachedValue> values;
+    int64_t memory_bytes = 0;
+    /** Used to remove the least recently used entries first. */
+    uint64_t last_used = 0;
+  };
+
+  mutable std::mutex mutex_;
+  Map<uint64_t, Entry> entries_;
+  int64_t memory_limit_ = 0;
+  int64_t memory_bytes_ = 0;
+  uint64_t evaluation_counter_ = 0;
+  NodeOutputCacheStats stats_;
+
+ public:
+  ~NodeOutputCache();
+
+  /**
+   * Has to be called before every evaluation of the node tree.
+   * \param memory_limit: Maximum memory in bytes the cached values should use.
+   */
+  void begin_evaluation(int64_t memory_limit);
+
+  /**
+   * If the outputs with the given indices are all cached for the key, \a fn is called for each of
+   * them and true is returned. The values passed to \a fn have to be copied, because they are only
+   * valid during the call.
+   */
+  bool lookup(const NodeOutputCacheKey &key,
+              Span<int> output_indices,
+              FunctionRef<void(int output_index, GPointer value)> fn);
+
+  /**
+   * Store a copy of a computed output value. This may remove other entries when the memory limit
+   * is exceeded.
+   */
+  void add(const NodeOutputCacheKey &key, int output_index, GPointer value);
+
+  void clear();
+
+  NodeOutputCacheStats stats() const;
+
+ private:
+  static void free_entry(Entry &entry);
+  void remove_entry(uint64_t hash);
+  void remove_least_recently_used_entries();
+};
+
+}  // namespace blender::modifiers::geometry_nodes
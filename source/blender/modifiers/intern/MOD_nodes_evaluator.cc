@@ -1,9 +1,13 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
 #include "MOD_nodes_evaluator.hh"
+#include "MOD_nodes_cache.hh"
 
 #include "BKE_type_conversions.hh"
 
+#include "DNA_genfile.h"
+#include "DNA_sdna_types.h"
+
 #include "NOD_geometry_exec.hh"
 #include "NOD_socket_declarations.hh"
 
@@ -250,6 +254,20 @@ struct NodeState {
    * not run twice at the same time accidentally.
    */
   NodeScheduleState schedule_state = NodeScheduleState::NotScheduled;
+
+  /**
+   * Identifies everything the outputs of this node depend on. It is only set when the outputs of
+   * the node can be cached between evaluations. Does not change during evaluation, so it can be
+   * read without a lock.
+   */
+  std::optional<NodeOutputCacheKey> cache_key;
+  bool cache_key_computed = false;
+
+  /** True when the cache has been checked for the outputs of this node already. */
+  bool cache_lookup_done = false;
+
+  /** True when the outputs have been loaded from the cache, so they don't have to be added. */
+  bool outputs_loaded_from_cache = false;
 };
 
 /**
@@ -403,6 +421,230 @@ static bool node_supports_laziness(const DNode node)
   return node->typeinfo()->geometry_node_execute_supports_laziness;
 }
 
+static bool socket_type_references_id(const SocketRef &socket)
+{
+  return ELEM(socket.bsocket()->type,
+              SOCK_OBJECT,
+              SOCK_COLLECTION,
+              SOCK_TEXTURE,
+              SOCK_IMAGE,
+              SOCK_MATERIAL);
+}
+
+/**
+ * Nodes whose outputs can depend on data that is not part of the node tree can't be cached,
+ * because there is no cheap way to detect when that data changed.
+ */
+static bool node_type_is_cacheable(const DNode node)
+{
+  const bNode &bnode = *node->bnode();
+  if (bnode.id != nullptr) {
+    return false;
+  }
+  if (ELEM(bnode.type,
+           GEO_NODE_OBJECT_INFO,
+           GEO_NODE_COLLECTION_INFO,
+           GEO_NODE_IS_VIEWPORT,
+           GEO_NODE_IMAGE_TEXTURE,
+           GEO_NODE_INPUT_SCENE_TIME)) {
+    return false;
+  }
+  /* Lazy nodes might only compute some of their outputs in one execution. */
+  if (node_supports_laziness(node)) {
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Builds the data of a #NodeOutputCacheKey. Values are added one by one and never as whole
+ * structs, so that padding bytes with undefined contents don't end up in the key.
+ */
+class CacheKeyBuilder {
+ private:
+  Vector<uint8_t> data_;
+
+ public:
+  template<typename T> void add(const T &value)
+  {
+    static_assert(std::is_arithmetic_v<T>);
+    this->add_bytes(&value, sizeof(T));
+  }
+
+  void add_bytes(const void *data, const int64_t size)
+  {
+    data_.extend(static_cast<const uint8_t *>(data), size);
+  }
+
+  void add_string(const StringRef str)
+  {
+    this->add(str.size());
+    this->add_bytes(str.data(), str.size());
+  }
+
+  void add_key(const NodeOutputCacheKey &key)
+  {
+    this->add(key.data.size());
+    data_.extend(key.data);
+  }
+
+  NodeOutputCacheKey build()
+  {
+    NodeOutputCacheKey key;
+    key.hash = get_default_hash(
+        StringRef(reinterpret_cast<const char *>(data_.data()), data_.size()));
+    key.data = std::move(data_);
+    return key;
+  }
+};
+
+static bool dna_member_is_pointer(const char *name)
+{
+  return name[0] == '*' || (name[0] == '(' && name[1] == '*');
+}
+
+/**
+ * Add the members of DNA data like node storage or socket default values to the key. Returns
+ * false when the data references other data, which is not compared.
+ */
+static bool add_dna_struct_to_key(CacheKeyBuilder &builder,
+                                  const SDNA &sdna,
+                                  const int struct_nr,
+                                  const uint8_t *data)
+{
+  const SDNA_Struct &sdna_struct = *sdna.structs[struct_nr];
+  int offset = 0;
+  for (const int i : IndexRange(sdna_struct.members_len)) {
+    const SDNA_StructMember &member = sdna_struct.members[i];
+    const char *name = sdna.names[member.name];
+    const int size = DNA_elem_size_nr(&sdna, member.type, member.name);
+    const uint8_t *member_data = data + offset;
+    offset += size;
+
+    if (dna_member_is_pointer(name)) {
+      const Span<const void *> pointers{reinterpret_cast<const void *const *>(member_data),
+                                        size / int(sizeof(void *))};
+      for (const void *pointer : pointers) {
+        if (pointer != nullptr) {
+          return false;
+        }
+      }
+      continue;
+    }
+    if (STRPREFIX(name, "_pad")) {
+      continue;
+    }
+    const int member_struct_nr = DNA_struct_find_nr(&sdna, sdna.types[member.type]);
+    if (member_struct_nr == -1) {
+      builder.add_bytes(member_data, size);
+      continue;
+    }
+    const int member_struct_size = sdna.types_size[member.type];
+    for (const int array_index : IndexRange(sdna.names_array_len[member.name])) {
+      if (!add_dna_struct_to_key(
+              builder, sdna, member_struct_nr, member_data + array_index * member_struct_size)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static bool add_dna_data_to_key(CacheKeyBuilder &builder,
+                                const char *struct_name,
+                                const void *data)
+{
+  builder.add(data != nullptr);
+  if (data == nullptr) {
+    return true;
+  }
+  const SDNA &sdna = *DNA_sdna_current_get();
+  const int struct_nr = DNA_struct_find_nr(&sdna, struct_name);
+  if (struct_nr == -1) {
+    return false;
+  }
+  return add_dna_struct_to_key(builder, sdna, struct_nr, static_cast<const uint8_t *>(data));
+}
+
+static const char *socket_default_value_struct_name(const eNodeSocketDatatype socket_type)
+{
+  switch (socket_type) {
+    case SOCK_FLOAT:
+      return "bNodeSocketValueFloat";
+    case SOCK_VECTOR:
+      return "bNodeSocketValueVector";
+    case SOCK_RGBA:
+      return "bNodeSocketValueRGBA";
+    case SOCK_BOOLEAN:
+      return "bNodeSocketValueBoolean";
+    case SOCK_INT:
+      return "bNodeSocketValueInt";
+    case SOCK_STRING:
+      return "bNodeSocketValueString";
+    default:
+      return nullptr;
+  }
+}
+
+static bool add_unlinked_socket_value_to_key(CacheKeyBuilder &builder, const SocketRef &socket)
+{
+  if (socket_type_references_id(socket)) {
+    return false;
+  }
+  const bNodeSocket &bsocket = *socket.bsocket();
+  builder.add(bsocket.type);
+  if (bsocket.default_value == nullptr) {
+    builder.add(false);
+    return true;
+  }
+  const char *struct_name = socket_default_value_struct_name(
+      eNodeSocketDatatype(bsocket.type));
+  if (struct_name == nullptr) {
+    return false;
+  }
+  return add_dna_data_to_key(builder, struct_name, bsocket.default_value);
+}
+
+/**
+ * Values passed into the node group from the modifier can be added to the key unless they are
+ * geometry or data-blocks.
+ */
+static bool add_group_input_value_to_key(CacheKeyBuilder &builder, const GPointer value)
+{
+  const ValueOrFieldCPPType *value_or_field_type = dynamic_cast<const ValueOrFieldCPPType *>(
+      value.type());
+  if (value_or_field_type == nullptr) {
+    return false;
+  }
+  builder.add_string(value_or_field_type->name());
+  if (value_or_field_type->is_field(value.get())) {
+    /* Fields passed in by the modifier are attribute inputs, which are identified by name. */
+    const GField &field = *value_or_field_type->get_field_ptr(value.get());
+    const bke::AttributeFieldInput *attribute_input =
+        dynamic_cast<const bke::AttributeFieldInput *>(&field.node());
+    if (attribute_input == nullptr) {
+      return false;
+    }
+    builder.add(true);
+    builder.add_string(attribute_input->attribute_name());
+    return true;
+  }
+  builder.add(false);
+  const CPPType &base_type = value_or_field_type->base_type();
+  const void *base_value = value_or_field_type->get_value_ptr(value.get());
+  if (base_type.is<std::string>()) {
+    builder.add_string(*static_cast<const std::string *>(base_value));
+    return true;
+  }
+  /* These types have no padding. */
+  if (base_type.is<float>() || base_type.is<int>() || base_type.is<bool>() ||
+      base_type.is<float3>() || base_type.is<ColorGeometry4f>()) {
+    builder.add_bytes(base_value, base_type.size());
+    return true;
+  }
+  return false;
+}
+
 struct NodeTaskRunState {
   /** The node that should be run on the same thread after the current node finished. */
   DNode next_node_to_run;
@@ -483,6 +725,10 @@ class GeometryNodesEvaluator {
     task_pool_ = BLI_task_pool_create(this, TASK_PRIORITY_HIGH);
 
     this->create_states_for_reachable_nodes();
+    if (params_.cache != nullptr) {
+      /* Has to happen before the group inputs are forwarded, because their values are hashed. */
+      this->compute_cache_keys();
+    }
     this->forward_group_inputs();
     this->schedule_initial_nodes();
 
@@ -619,6 +865,115 @@ class GeometryNodesEvaluator {
     }
   }
 
+  void compute_cache_keys()
+  {
+    for (const NodeWithState &item : node_states_) {
+      this->ensure_cache_key(item.node, *item.state);
+    }
+  }
+
+  const std::optional<NodeOutputCacheKey> &ensure_cache_key(const DNode node,
+                                                           NodeState &node_state)
+  {
+    if (!node_state.cache_key_computed) {
+      node_state.cache_key = this->compute_cache_key(node, node_state);
+      node_state.cache_key_computed = true;
+    }
+    return node_state.cache_key;
+  }
+
+  /**
+   * The key combines the node itself with all of its input values or the keys of the nodes they
+   * are computed by. Since the key does not depend on the node's location in the tree, identical
+   * nodes with identical inputs share cached outputs, e.g. in multiple instances of a group.
+   */
+  std::optional<NodeOutputCacheKey> compute_cache_key(const DNode node,
+                                                      const NodeState &node_state)
+  {
+    if (node->is_group_input_node() || node->is_group_output_node()) {
+      return std::nullopt;
+    }
+    if (!node_type_is_cacheable(node)) {
+      return std::nullopt;
+    }
+    const bNode &bnode = *node->bnode();
+    CacheKeyBuilder builder;
+    builder.add_string(bnode.idname);
+    builder.add(bnode.custom1);
+    builder.add(bnode.custom2);
+    builder.add(bnode.custom3);
+    builder.add(bnode.custom4);
+    if (!add_dna_data_to_key(builder, node->typeinfo()->storagename, bnode.storage)) {
+      return std::nullopt;
+    }
+
+    for (const int i : node->inputs().index_range()) {
+      const InputState &input_state = node_state.inputs[i];
+      if (input_state.type == nullptr) {
+        continue;
+      }
+      if (input_state.force_compute) {
+        /* The input has to be computed for logging, so the node has to run. */
+        return std::nullopt;
+      }
+      const DInputSocket socket = node.input(i);
+      if (socket_type_references_id(*socket.socket_ref())) {
+        return std::nullopt;
+      }
+      builder.add(i);
+
+      bool is_cacheable = true;
+      bool has_origin = false;
+      socket.foreach_origin_socket([&](const DSocket origin) {
+        has_origin = true;
+        if (!this->add_origin_to_key(builder, origin)) {
+          is_cacheable = false;
+        }
+      });
+      if (!is_cacheable) {
+        return std::nullopt;
+      }
+      builder.add(has_origin);
+      if (!has_origin) {
+        if (!add_unlinked_socket_value_to_key(builder, *socket.socket_ref())) {
+          return std::nullopt;
+        }
+      }
+    }
+    return builder.build();
+  }
+
+  /**
+   * Origins computed by other nodes add the entire key of that node, so that the keys can be
+   * compared without having to trust the keys of the nodes they depend on.
+   */
+  bool add_origin_to_key(CacheKeyBuilder &builder, const DSocket origin)
+  {
+    if (origin->is_input()) {
+      builder.add(0);
+      return add_unlinked_socket_value_to_key(builder, *origin.socket_ref());
+    }
+    const DNode origin_node = origin.node();
+    if (origin_node->is_group_input_node()) {
+      const GMutablePointer *value = params_.input_values.lookup_ptr(DOutputSocket(origin));
+      if (value == nullptr) {
+        return false;
+      }
+      builder.add(1);
+      return add_group_input_value_to_key(builder, *value);
+    }
+    NodeState &origin_state = this->get_node_state(origin_node);
+    const std::optional<NodeOutputCacheKey> &origin_key = this->ensure_cache_key(origin_node,
+                                                                                 origin_state);
+    if (!origin_key.has_value()) {
+      return false;
+    }
+    builder.add(2);
+    builder.add_key(*origin_key);
+    builder.add(origin->index());
+    return true;
+  }
+
   void destruct_node_states()
   {
     threading::parallel_for(
@@ -765,7 +1120,20 @@ class GeometryNodesEvaluator {
 
     NodeState &node_state = *node_states_.lookup_key_as(node).state;
 
-    const bool do_execute_node = this->node_task_preprocessing(node, node_state, run_state);
+    bool check_cache = false;
+    const bool do_execute_node = this->node_task_preprocessing(
+        node, node_state, run_state, check_cache);
+
+    if (check_cache) {
+      if (!this->load_outputs_from_cache(node, node_state, run_state)) {
+        /* Run the node again, this time its inputs are requested as usual. */
+        this->with_locked_node(node, node_state, run_state, [&](LockedNode &locked_node) {
+          this->schedule_node(locked_node);
+        });
+      }
+      this->node_task_postprocessing(node, node_state, false, run_state);
+      return;
+    }
 
     /* Only execute the node if all prerequisites are met. There has to be an output that is
      * required and all required inputs have to be provided already. */
@@ -778,7 +1146,8 @@ class GeometryNodesEvaluator {
 
   bool node_task_preprocessing(const DNode node,
                                NodeState &node_state,
-                               NodeTaskRunState *run_state)
+                               NodeTaskRunState *run_state,
+                               bool &r_check_cache)
   {
     bool do_execute_node = false;
     this->with_locked_node(node, node_state, run_state, [&](LockedNode &locked_node) {
@@ -797,6 +1166,13 @@ class GeometryNodesEvaluator {
        * required and before we check that all required inputs are provided. This reduces the
        * number of "round-trips" through the task pool by one for most nodes. */
       if (!node_state.non_lazy_inputs_handled) {
+        if (node_state.cache_key.has_value() && !node_state.cache_lookup_done) {
+          /* Check the cache before any inputs are requested, so that nodes to the left don't
+           * have to be computed when the outputs are cached. */
+          node_state.cache_lookup_done = true;
+          r_check_cache = true;
+          return;
+        }
         this->require_non_lazy_inputs(locked_node);
         node_state.non_lazy_inputs_handled = true;
       }
@@ -881,17 +1257,24 @@ class GeometryNodesEvaluator {
 
   void foreach_non_lazy_input(LockedNode &locked_node, FunctionRef<void(DInputSocket socket)> fn)
   {
-    if (node_supports_laziness(locked_node.node)) {
-      /* In the future only some of the inputs may support laziness. */
+    const bool supports_laziness = node_supports_laziness(locked_node.node);
+    const nodes::NodeDeclaration *node_declaration = locked_node.node->declaration();
+    if (supports_laziness && node_declaration == nullptr) {
+      /* Without a declaration, all inputs of nodes that support laziness are lazy. */
       return;
     }
-    /* Nodes that don't support laziness require all inputs. */
+    /* Nodes that don't support laziness require all inputs. Otherwise only the inputs that are
+     * not declared to be lazy are required before the first execution. That avoids an additional
+     * execution of the node just to request inputs that are always used. */
     for (const int i : locked_node.node->inputs().index_range()) {
       InputState &input_state = locked_node.node_state.inputs[i];
       if (input_state.type == nullptr) {
         /* Ignore unavailable/non-data sockets. */
         continue;
       }
+      if (supports_laziness && node_declaration->inputs()[i]->is_lazy()) {
+        continue;
+      }
       fn(locked_node.node.input(i));
     }
   }
@@ -991,7 +1374,7 @@ class GeometryNodesEvaluator {
     const std::chrono::microseconds duration =
         std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
     if (params_.geo_logger != nullptr) {
-      params_.geo_logger->local().log_execution_time(node, duration);
+      params_.geo_logger->local().log_execution_time(node, begin, duration);
     }
   }
 
@@ -1149,6 +1532,48 @@ class GeometryNodesEvaluator {
     }
   }
 
+  /**
+   * Forward the outputs of the node from the cache if all used outputs are cached.
+   * \return True when the outputs have been found in the cache.
+   */
+  bool load_outputs_from_cache(const DNode node,
+                               NodeState &node_state,
+                               NodeTaskRunState *run_state)
+  {
+    Vector<int, 16> output_indices;
+    for (const int i : node_state.outputs.index_range()) {
+      const OutputState &output_state = node_state.outputs[i];
+      if (output_state.has_been_computed) {
+        continue;
+      }
+      if (output_state.output_usage_for_execution == ValueUsage::Unused) {
+        continue;
+      }
+      output_indices.append(i);
+    }
+
+    LinearAllocator<> &allocator = local_allocators_.local();
+    Vector<GMutablePointer, 16> output_values(node_state.outputs.size());
+    const bool found = params_.cache->lookup(
+        *node_state.cache_key, output_indices, [&](const int output_index, const GPointer value) {
+          const CPPType &type = *value.type();
+          void *buffer = allocator.allocate(type.size(), type.alignment());
+          type.copy_construct(value.get(), buffer);
+          output_values[output_index] = {type, buffer};
+        });
+    if (!found) {
+      return false;
+    }
+
+    node_state.outputs_loaded_from_cache = true;
+    for (const int output_index : output_indices) {
+      OutputState &output_state = node_state.outputs[output_index];
+      this->forward_output(node.output(output_index), output_values[output_index], run_state);
+      output_state.has_been_computed = true;
+    }
+    return true;
+  }
+
   void node_task_postprocessing(const DNode node,
                                 NodeState &node_state,
                                 bool was_executed,
@@ -1399,6 +1824,10 @@ class GeometryNodesEvaluator {
   {
     BLI_assert(value_to_forward.get() != nullptr);
 
+    if (params_.cache != nullptr) {
+      this->add_output_to_cache(from_socket, value_to_forward);
+    }
+
     LinearAllocator<> &allocator = local_allocators_.local();
 
     Vector<DSocket> log_original_value_sockets;
@@ -1456,6 +1885,19 @@ class GeometryNodesEvaluator {
         allocator, forward_original_value_sockets, value_to_forward, from_socket, run_state);
   }
 
+  void add_output_to_cache(const DOutputSocket socket, const GPointer value)
+  {
+    const NodeWithState *node_with_state = node_states_.lookup_key_ptr_as(socket.node());
+    if (node_with_state == nullptr) {
+      return;
+    }
+    const NodeState &node_state = *node_with_state->state;
+    if (!node_state.cache_key.has_value() || node_state.outputs_loaded_from_cache) {
+      return;
+    }
+    params_.cache->add(*node_state.cache_key, socket->index(), value);
+  }
+
   bool should_forward_to_socket(const DInputSocket socket)
   {
     const DNode to_node = socket.node();
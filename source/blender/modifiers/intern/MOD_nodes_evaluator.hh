@@ -22,6 +22,8 @@ using namespace nodes::derived_node_tree_types;
 using fn::GMutablePointer;
 using fn::GPointer;
 
+class NodeOutputCache;
+
 struct GeometryNodesEvaluationParams {
   blender::LinearAllocator<> allocator;
 
@@ -38,6 +40,8 @@ struct GeometryNodesEvaluationParams {
   Depsgraph *depsgraph;
   Object *self_object;
   geo_log::GeoLogger *geo_logger;
+  /* Outputs of nodes that are kept between evaluations. May be null. */
+  NodeOutputCache *cache = nullptr;
 
   Vector<GMutablePointer> r_output_values;
 };
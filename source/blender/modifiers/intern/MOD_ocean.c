@@ -307,6 +307,45 @@ static Mesh *generate_ocean_geometry(OceanModifierData *omd, Mesh *mesh_orig, co
   return result;
 }
 
+/* Number of vertices displaced by one task, sampled with a single lock of the ocean. */
+#  define OCEAN_DISPLACE_CHUNK_SIZE 256
+
+typedef struct DisplaceOceanData {
+  MVert *mverts;
+  int verts_num;
+  struct Ocean *ocean;
+  float size_co_inv;
+  bool use_chop;
+} DisplaceOceanData;
+
+static void displace_ocean_vertices_cb(void *__restrict userdata,
+                                       const int chunk,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  DisplaceOceanData *dod = userdata;
+  const int start = chunk * OCEAN_DISPLACE_CHUNK_SIZE;
+  const int num = min_ii(OCEAN_DISPLACE_CHUNK_SIZE, dod->verts_num - start);
+  MVert *mverts = &dod->mverts[start];
+  float uv[OCEAN_DISPLACE_CHUNK_SIZE][2];
+  float disp[OCEAN_DISPLACE_CHUNK_SIZE][3];
+
+  for (int i = 0; i < num; i++) {
+    uv[i][0] = (mverts[i].co[0] * dod->size_co_inv) + 0.5f;
+    uv[i][1] = (mverts[i].co[1] * dod->size_co_inv) + 0.5f;
+  }
+
+  BKE_ocean_eval_uv_displacement_array(dod->ocean, (const float(*)[2])uv, disp, num);
+
+  for (int i = 0; i < num; i++) {
+    float *vco = mverts[i].co;
+    vco[2] += disp[i][1];
+    if (dod->use_chop) {
+      vco[0] += disp[i][0];
+      vco[1] += disp[i][2];
+    }
+  }
+}
+
 static Mesh *doOcean(ModifierData *md, const ModifierEvalContext *ctx, Mesh *mesh)
 {
   OceanModifierData *omd = (OceanModifierData *)md;
@@ -446,9 +485,27 @@ static Mesh *doOcean(ModifierData *md, const ModifierEvalContext *ctx, Mesh *mes
 
   /* displace the geometry */
 
-  /* NOTE: tried to parallelized that one and previous foam loop,
-   * but gives 20% slower results... odd. */
-  {
+  /* NOTE: the live simulation samples whole chunks of vertices with a single lock of the ocean,
+   * locking it for every vertex made the parallel loop slower than the serial one. */
+  if (!(omd->oceancache && omd->cached == true)) {
+    DisplaceOceanData dod = {
+        .mverts = mverts,
+        .verts_num = result->totvert,
+        .ocean = omd->ocean,
+        .size_co_inv = size_co_inv,
+        .use_chop = (omd->chop_amount > 0.0f),
+    };
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (result->totvert > 4 * OCEAN_DISPLACE_CHUNK_SIZE);
+    BLI_task_parallel_range(0,
+                            divide_ceil_u(result->totvert, OCEAN_DISPLACE_CHUNK_SIZE),
+                            &dod,
+                            displace_ocean_vertices_cb,
+                            &settings);
+  }
+  else {
     const int num_verts = result->totvert;
 
     for (i = 0; i < num_verts; i++) {
@@ -456,12 +513,7 @@ static Mesh *doOcean(ModifierData *md, const ModifierEvalContext *ctx, Mesh *mes
       const float u = OCEAN_CO(size_co_inv, vco[0]);
       const float v = OCEAN_CO(size_co_inv, vco[1]);
 
-      if (omd->oceancache && omd->cached == true) {
-        BKE_ocean_cache_eval_uv(omd->oceancache, &ocr, cfra_for_cache, u, v);
-      }
-      else {
-        BKE_ocean_eval_uv(omd->ocean, &ocr, u, v);
-      }
+      BKE_ocean_cache_eval_uv(omd->oceancache, &ocr, cfra_for_cache, u, v);
 
       vco[2] += ocr.disp[1];
 
@@ -105,6 +105,7 @@ static void freeRuntimeData(void *runtime_data_v)
   if (runtime_data->subdiv != NULL) {
     BKE_subdiv_free(runtime_data->subdiv);
   }
+  BKE_subdiv_mesh_cache_free(runtime_data->mesh_cache);
   MEM_freeN(runtime_data);
 }
 
@@ -155,7 +156,8 @@ static void subdiv_mesh_settings_init(SubdivToMeshSettings *settings,
 static Mesh *subdiv_as_mesh(SubsurfModifierData *smd,
                             const ModifierEvalContext *ctx,
                             Mesh *mesh,
-                            Subdiv *subdiv)
+                            Subdiv *subdiv,
+                            const bool use_cache)
 {
   Mesh *result = mesh;
   SubdivToMeshSettings mesh_settings;
@@ -163,7 +165,15 @@ static Mesh *subdiv_as_mesh(SubsurfModifierData *smd,
   if (mesh_settings.resolution < 3) {
     return result;
   }
-  result = BKE_subdiv_to_mesh(subdiv, &mesh_settings, mesh);
+  SubsurfRuntimeData *runtime_data = (SubsurfRuntimeData *)smd->modifier.runtime;
+  if (!use_cache) {
+    BKE_subdiv_mesh_cache_free(runtime_data->mesh_cache);
+    runtime_data->mesh_cache = NULL;
+    return BKE_subdiv_to_mesh(subdiv, &mesh_settings, mesh);
+  }
+  /* The cache avoids interpolating all the custom data again when only the positions of the
+   * input mesh change, like for an animated armature or shape key below the modifier. */
+  result = BKE_subdiv_to_mesh_cached(subdiv, &mesh_settings, mesh, &runtime_data->mesh_cache);
   return result;
 }
 
@@ -237,6 +247,8 @@ static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *
     const int required_mode = BKE_subsurf_modifier_eval_required_mode(is_render_mode, is_editmode);
     if (BKE_subsurf_modifier_can_do_gpu_subdiv_ex(
             scene, ctx->object, mesh, smd, required_mode, false)) {
+      BKE_subdiv_mesh_cache_free(runtime_data->mesh_cache);
+      runtime_data->mesh_cache = NULL;
       subdiv_cache_cpu_evaluation_settings(ctx, mesh, smd);
       return result;
     }
@@ -258,7 +270,11 @@ static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *
   /* TODO(sergey): Decide whether we ever want to use CCG for subsurf,
    * maybe when it is a last modifier in the stack? */
   if (true) {
-    result = subdiv_as_mesh(smd, ctx, mesh, subdiv);
+    /* Custom normals are calculated from positions, so the input changes with any deformation.
+     * Applying the modifier is a one-off evaluation which doesn't benefit from the cache. */
+    const bool use_cache = !use_clnors && (ctx->flag & MOD_APPLY_TO_BASE_MESH) == 0 &&
+                           subdiv == runtime_data->subdiv;
+    result = subdiv_as_mesh(smd, ctx, mesh, subdiv, use_cache);
   }
   else {
     result = subdiv_as_ccg(smd, ctx, mesh, subdiv);
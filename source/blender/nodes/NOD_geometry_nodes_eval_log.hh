@@ -28,6 +28,7 @@
 #include "NOD_derived_node_tree.hh"
 
 #include <chrono>
+#include <iosfwd>
 
 struct SpaceNode;
 struct SpaceSpreadsheet;
@@ -158,6 +159,7 @@ struct NodeWithWarning {
 
 struct NodeWithExecutionTime {
   DNode node;
+  std::chrono::steady_clock::time_point begin;
   std::chrono::microseconds exec_time;
 };
 
@@ -200,7 +202,9 @@ class LocalGeoLogger {
   void log_value_for_sockets(Span<DSocket> sockets, GPointer value);
   void log_multi_value_socket(DSocket socket, Span<GPointer> values);
   void log_node_warning(DNode node, NodeWarningType type, std::string message);
-  void log_execution_time(DNode node, std::chrono::microseconds exec_time);
+  void log_execution_time(DNode node,
+                          std::chrono::steady_clock::time_point begin,
+                          std::chrono::microseconds exec_time);
   /**
    * Log a message that will be displayed in the node editor next to the node.
    * This should only be used for debugging purposes and not to display information to users.
@@ -223,15 +227,14 @@ class GeoLogger {
   std::unique_ptr<GeometryValueLog> input_geometry_log_;
   std::unique_ptr<GeometryValueLog> output_geometry_log_;
 
+  /** Memory in use by the whole process before the evaluation. */
+  size_t mem_in_use_begin_;
+
   friend LocalGeoLogger;
   friend ModifierLog;
 
  public:
-  GeoLogger(Set<DSocket> log_full_sockets)
-      : log_full_sockets_(std::move(log_full_sockets)),
-        threadlocals_([this]() { return LocalGeoLogger(*this); })
-  {
-  }
+  GeoLogger(Set<DSocket> log_full_sockets);
 
   void log_input_geometry(const GeometrySet &geometry)
   {
@@ -332,6 +335,16 @@ class TreeLog {
   void foreach_node_log(FunctionRef<void(const NodeLog &)> fn) const;
 };
 
+/** A single execution of a node, used for the timing report of an evaluation. */
+struct NodeExecutionEvent {
+  /** Names of the group nodes containing the node, followed by the name of the node. */
+  std::string node_path;
+  /** Index of the thread-local logger, every thread that executed nodes has its own index. */
+  int thread_index;
+  std::chrono::steady_clock::time_point begin;
+  std::chrono::microseconds duration;
+};
+
 /** Contains information about an entire geometry nodes evaluation. */
 class ModifierLog {
  private:
@@ -344,6 +357,15 @@ class ModifierLog {
   std::unique_ptr<GeometryValueLog> input_geometry_log_;
   std::unique_ptr<GeometryValueLog> output_geometry_log_;
 
+  /** All node executions, sorted by their start time. */
+  Vector<NodeExecutionEvent> execution_events_;
+  /**
+   * Memory in use by the whole process before and after the evaluation. This is only sampled
+   * once per evaluation, because getting it for every node execution is too expensive.
+   */
+  size_t mem_in_use_begin_;
+  size_t mem_in_use_end_;
+
  public:
   ModifierLog(GeoLogger &logger);
 
@@ -367,6 +389,15 @@ class ModifierLog {
   const GeometryValueLog *input_geometry_log() const;
   const GeometryValueLog *output_geometry_log() const;
 
+  Span<NodeExecutionEvent> execution_events() const;
+  /**
+   * Write the node executions of the evaluation as JSON in the trace event format, which can be
+   * opened in `chrome://tracing` or Perfetto. Every thread has its own track, so the thread
+   * utilization is visible too. The process memory usage before and after the evaluation is
+   * written as a counter.
+   */
+  void write_timings_trace(std::ostream &stream) const;
+
  private:
   using LogByTreeContext = Map<const DTreeContext *, TreeLog *>;
 
@@ -84,6 +84,7 @@ class SocketDeclaration {
   bool is_unavailable_ = false;
   bool is_attribute_name_ = false;
   bool is_default_link_socket_ = false;
+  bool is_lazy_ = false;
 
   InputSocketFieldType input_field_type_ = InputSocketFieldType::None;
   OutputFieldDependency output_field_dependency_;
@@ -120,6 +121,7 @@ class SocketDeclaration {
   eNodeSocketInOut in_out() const;
   bool is_attribute_name() const;
   bool is_default_link_socket() const;
+  bool is_lazy() const;
 
   InputSocketFieldType input_field_type() const;
   const OutputFieldDependency &output_field_dependency() const;
@@ -201,6 +203,17 @@ class SocketDeclarationBuilder : public BaseSocketDeclarationBuilder {
     return *(Self *)this;
   }
 
+  /**
+   * The input is only computed when the node requests it with #lazy_require_input during
+   * execution. Only has an effect when the node type supports laziness. Inputs of such nodes
+   * that are not lazy are computed before the node is executed the first time.
+   */
+  Self &lazy(bool value = true)
+  {
+    decl_->is_lazy_ = value;
+    return *(Self *)this;
+  }
+
   /** The input socket allows passing in a field. */
   Self &supports_field()
   {
@@ -418,6 +431,11 @@ inline bool SocketDeclaration::is_default_link_socket() const
   return is_default_link_socket_;
 }
 
+inline bool SocketDeclaration::is_lazy() const
+{
+  return is_lazy_;
+}
+
 inline InputSocketFieldType SocketDeclaration::input_field_type() const
 {
   return input_field_type_;
@@ -241,6 +241,11 @@ void ntreeCompositTagRender(Scene *scene)
    * This is still rather weak though,
    * ideally render struct would store own main AND original G_MAIN. */
 
+#ifdef WITH_COMPOSITOR
+  /* Cached results may depend on the previous render result. */
+  COM_clear_caches();
+#endif
+
   for (Scene *sce_iter = (Scene *)G_MAIN->scenes.first; sce_iter;
        sce_iter = (Scene *)sce_iter->id.next) {
     if (sce_iter->nodetree) {
@@ -127,9 +127,8 @@ class SampleCurveFunction : public fn::MultiFunction {
     }
 
     const CurveComponent *curve_component = geometry_set_.get_component_for_read<CurveComponent>();
-    const std::unique_ptr<CurveEval> curve = curves_to_curve_eval(
-        *curve_component->get_for_read());
-    Span<SplinePtr> splines = curve->splines();
+    const CurveEval &curve = curves_to_curve_eval_cached(*curve_component->get_for_read());
+    Span<SplinePtr> splines = curve.splines();
     if (splines.is_empty()) {
       return return_default();
     }
@@ -240,14 +239,14 @@ static void node_geo_exec(GeoNodeExecParams params)
     return;
   }
 
-  const std::unique_ptr<CurveEval> curve = curves_to_curve_eval(*component->get_for_read());
+  const CurveEval &curve = curves_to_curve_eval_cached(*component->get_for_read());
 
-  if (curve->splines().is_empty()) {
+  if (curve.splines().is_empty()) {
     params.set_default_remaining_outputs();
     return;
   }
 
-  Array<float> spline_lengths = curve->accumulated_spline_lengths();
+  Array<float> spline_lengths = curve.accumulated_spline_lengths();
   const float total_length = spline_lengths.last();
   if (total_length == 0.0f) {
     params.set_default_remaining_outputs();
@@ -1,6 +1,8 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_bounds.hh"
 #include "BLI_kdtree.h"
+#include "BLI_map.hh"
 #include "BLI_noise.hh"
 #include "BLI_rand.hh"
 #include "BLI_task.hh"
@@ -22,6 +24,10 @@
 
 #include "node_geometry_util.hh"
 
+#ifdef WITH_TBB
+#  include <tbb/parallel_sort.h>
+#endif
+
 namespace blender::nodes::node_geo_distribute_points_on_faces_cc {
 
 static void node_declare(NodeDeclarationBuilder &b)
@@ -79,6 +85,38 @@ static float3 normal_to_euler_rotation(const float3 normal)
   return rotation;
 }
 
+/**
+ * Decide how many points are added to a triangle. The random number generator is seeded for the
+ * triangle and used afterwards to generate the points on it.
+ */
+static int looptri_point_amount(const Mesh &mesh,
+                                const MLoopTri &looptri,
+                                const float base_density,
+                                const Span<float> density_factors,
+                                RandomNumberGenerator &looptri_rng)
+{
+  const int v0_loop = looptri.tri[0];
+  const int v1_loop = looptri.tri[1];
+  const int v2_loop = looptri.tri[2];
+  const float3 v0_pos = float3(mesh.mvert[mesh.mloop[v0_loop].v].co);
+  const float3 v1_pos = float3(mesh.mvert[mesh.mloop[v1_loop].v].co);
+  const float3 v2_pos = float3(mesh.mvert[mesh.mloop[v2_loop].v].co);
+
+  float looptri_density_factor = 1.0f;
+  if (!density_factors.is_empty()) {
+    const float v0_density_factor = std::max(0.0f, density_factors[v0_loop]);
+    const float v1_density_factor = std::max(0.0f, density_factors[v1_loop]);
+    const float v2_density_factor = std::max(0.0f, density_factors[v2_loop]);
+    looptri_density_factor = (v0_density_factor + v1_density_factor + v2_density_factor) / 3.0f;
+  }
+  const float area = area_tri_v3(v0_pos, v1_pos, v2_pos);
+
+  const float points_amount_fl = area * base_density * looptri_density_factor;
+  const float add_point_probability = fractf(points_amount_fl);
+  const bool add_point = add_point_probability > looptri_rng.get_float();
+  return (int)points_amount_fl + (int)add_point;
+}
+
 static void sample_mesh_surface(const Mesh &mesh,
                                 const float base_density,
                                 const Span<float> density_factors,
@@ -90,44 +128,52 @@ static void sample_mesh_surface(const Mesh &mesh,
   const Span<MLoopTri> looptris{BKE_mesh_runtime_looptri_ensure(&mesh),
                                 BKE_mesh_runtime_looptri_len(&mesh)};
 
-  for (const int looptri_index : looptris.index_range()) {
-    const MLoopTri &looptri = looptris[looptri_index];
-    const int v0_loop = looptri.tri[0];
-    const int v1_loop = looptri.tri[1];
-    const int v2_loop = looptri.tri[2];
-    const int v0_index = mesh.mloop[v0_loop].v;
-    const int v1_index = mesh.mloop[v1_loop].v;
-    const int v2_index = mesh.mloop[v2_loop].v;
-    const float3 v0_pos = float3(mesh.mvert[v0_index].co);
-    const float3 v1_pos = float3(mesh.mvert[v1_index].co);
-    const float3 v2_pos = float3(mesh.mvert[v2_index].co);
-
-    float looptri_density_factor = 1.0f;
-    if (!density_factors.is_empty()) {
-      const float v0_density_factor = std::max(0.0f, density_factors[v0_loop]);
-      const float v1_density_factor = std::max(0.0f, density_factors[v1_loop]);
-      const float v2_density_factor = std::max(0.0f, density_factors[v2_loop]);
-      looptri_density_factor = (v0_density_factor + v1_density_factor + v2_density_factor) / 3.0f;
-    }
-    const float area = area_tri_v3(v0_pos, v1_pos, v2_pos);
-
-    const int looptri_seed = noise::hash(looptri_index, seed);
-    RandomNumberGenerator looptri_rng(looptri_seed);
-
-    const float points_amount_fl = area * base_density * looptri_density_factor;
-    const float add_point_probability = fractf(points_amount_fl);
-    const bool add_point = add_point_probability > looptri_rng.get_float();
-    const int point_amount = (int)points_amount_fl + (int)add_point;
-
-    for (int i = 0; i < point_amount; i++) {
-      const float3 bary_coord = looptri_rng.get_barycentric_coordinates();
-      float3 point_pos;
-      interp_v3_v3v3v3(point_pos, v0_pos, v1_pos, v2_pos, bary_coord);
-      r_positions.append(point_pos);
-      r_bary_coords.append(bary_coord);
-      r_looptri_indices.append(looptri_index);
+  /* Count the points on every triangle first, so that the points can be generated in parallel,
+   * in the same order as if the triangles were processed one after another. */
+  Array<int> offsets(looptris.size() + 1);
+  threading::parallel_for(looptris.index_range(), 1024, [&](const IndexRange range) {
+    for (const int looptri_index : range) {
+      RandomNumberGenerator looptri_rng(noise::hash(looptri_index, seed));
+      offsets[looptri_index] = looptri_point_amount(
+          mesh, looptris[looptri_index], base_density, density_factors, looptri_rng);
     }
+  });
+  int offset = 0;
+  for (const int looptri_index : looptris.index_range()) {
+    const int point_amount = offsets[looptri_index];
+    offsets[looptri_index] = offset;
+    offset += point_amount;
   }
+  offsets.last() = offset;
+
+  const int start = r_positions.size();
+  r_positions.resize(start + offset);
+  r_bary_coords.resize(start + offset);
+  r_looptri_indices.resize(start + offset);
+
+  threading::parallel_for(looptris.index_range(), 512, [&](const IndexRange range) {
+    for (const int looptri_index : range) {
+      const IndexRange points(start + offsets[looptri_index],
+                              offsets[looptri_index + 1] - offsets[looptri_index]);
+      if (points.is_empty()) {
+        continue;
+      }
+      const MLoopTri &looptri = looptris[looptri_index];
+      RandomNumberGenerator looptri_rng(noise::hash(looptri_index, seed));
+      /* Generate the same random numbers as when counting the points. */
+      looptri_point_amount(mesh, looptri, base_density, density_factors, looptri_rng);
+
+      const float3 v0_pos = float3(mesh.mvert[mesh.mloop[looptri.tri[0]].v].co);
+      const float3 v1_pos = float3(mesh.mvert[mesh.mloop[looptri.tri[1]].v].co);
+      const float3 v2_pos = float3(mesh.mvert[mesh.mloop[looptri.tri[2]].v].co);
+      for (const int i : points) {
+        const float3 bary_coord = looptri_rng.get_barycentric_coordinates();
+        interp_v3_v3v3v3(r_positions[i], v0_pos, v1_pos, v2_pos, bary_coord);
+        r_bary_coords[i] = bary_coord;
+        r_looptri_indices[i] = looptri_index;
+      }
+    }
+  });
 }
 
 BLI_NOINLINE static KDTree_3d *build_kdtree(Span<float3> positions)
@@ -144,13 +190,142 @@ BLI_NOINLINE static KDTree_3d *build_kdtree(Span<float3> positions)
   return kdtree;
 }
 
-BLI_NOINLINE static void update_elimination_mask_for_close_points(
-    Span<float3> positions, const float minimum_distance, MutableSpan<bool> elimination_mask)
+/** Grids with more cells along an axis than this use the KD-tree, see #CloseCellGrid. */
+static constexpr int max_grid_axis_cells = 1 << 16;
+
+/**
+ * Points sorted by the cells of a regular grid, with a cell size slightly larger than the minimum
+ * distance. Points within the minimum distance of a point are always in the same or in one of the
+ * directly neighboring cells. Finding them is cheaper than a search in a KD-tree, and the grid
+ * can be built in parallel, unlike a balanced KD-tree.
+ *
+ * The margin in the cell size covers the floating point error in the cell coordinates, which is
+ * why the number of cells along an axis is limited.
+ */
+struct CloseCellGrid {
+  float3 min;
+  float cell_size_inv;
+  /**
+   * The points sorted by the row of their cell along the X axis, then by their X cell coordinate
+   * and index. The positions are copied so that the points in neighboring cells are read from
+   * contiguous memory.
+   */
+  Array<int> sorted_indices;
+  Array<int> sorted_cell_x;
+  Array<float3> sorted_positions;
+  /** The range in the sorted arrays of every row of cells that contains points. */
+  Map<uint64_t, IndexRange> row_ranges;
+
+  int3 cell_of(const float3 &position) const
+  {
+    const float3 cell = (position - this->min) * this->cell_size_inv;
+    return int3(int(cell.x), int(cell.y), int(cell.z));
+  }
+
+  static uint64_t row_key(const int y, const int z)
+  {
+    return uint64_t(y) | (uint64_t(z) << 21);
+  }
+};
+
+static bool build_close_cell_grid(const Span<float3> positions,
+                                  const float minimum_distance,
+                                  CloseCellGrid &r_grid)
 {
-  if (minimum_distance <= 0.0f) {
-    return;
+  const std::optional<bounds::MinMaxResult<float3>> bounds = bounds::min_max(positions);
+  if (!bounds) {
+    return false;
   }
+  const float cell_size = minimum_distance * 1.05f;
+  const float3 cells_num = (bounds->max - bounds->min) / cell_size + float3(1.0f);
+  if (cells_num.x >= max_grid_axis_cells || cells_num.y >= max_grid_axis_cells ||
+      cells_num.z >= max_grid_axis_cells) {
+    return false;
+  }
+  r_grid.min = bounds->min;
+  r_grid.cell_size_inv = 1.0f / cell_size;
+
+  Array<std::pair<uint64_t, int>> keys(positions.size());
+  threading::parallel_for(positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int3 cell = r_grid.cell_of(positions[i]);
+      keys[i] = {uint64_t(cell.x) | (CloseCellGrid::row_key(cell.y, cell.z) << 21), i};
+    }
+  });
+#ifdef WITH_TBB
+  tbb::parallel_sort(keys.begin(), keys.end());
+#else
+  std::sort(keys.begin(), keys.end());
+#endif
+
+  r_grid.sorted_indices.reinitialize(positions.size());
+  r_grid.sorted_cell_x.reinitialize(positions.size());
+  r_grid.sorted_positions.reinitialize(positions.size());
+  threading::parallel_for(keys.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int index = keys[i].second;
+      r_grid.sorted_indices[i] = index;
+      r_grid.sorted_cell_x[i] = int(keys[i].first & ((1 << 21) - 1));
+      r_grid.sorted_positions[i] = positions[index];
+    }
+  });
 
+  int row_start = 0;
+  for (const int i : keys.index_range()) {
+    const uint64_t row = keys[i].first >> 21;
+    if (i + 1 == keys.size() || (keys[i + 1].first >> 21) != row) {
+      r_grid.row_ranges.add_new(row, IndexRange(row_start, i + 1 - row_start));
+      row_start = i + 1;
+    }
+  }
+  return true;
+}
+
+/**
+ * Same as #update_elimination_mask_for_close_points_kdtree, but uses a #CloseCellGrid
+ * to find the close points. The result is exactly the same.
+ */
+BLI_NOINLINE static void update_elimination_mask_for_close_points_grid(
+    const Span<float3> positions,
+    const float minimum_distance,
+    const CloseCellGrid &grid,
+    MutableSpan<bool> elimination_mask)
+{
+  const float minimum_distance_sq = minimum_distance * minimum_distance;
+  for (const int i : positions.index_range()) {
+    if (elimination_mask[i]) {
+      continue;
+    }
+    const float3 position = positions[i];
+    const int3 cell = grid.cell_of(position);
+    /* Rows that don't exist are just not found, only negative coordinates have to be skipped
+     * because they don't fit in the key. */
+    for (int z = std::max(cell.z - 1, 0); z <= cell.z + 1; z++) {
+      for (int y = std::max(cell.y - 1, 0); y <= cell.y + 1; y++) {
+        const IndexRange *row = grid.row_ranges.lookup_ptr(CloseCellGrid::row_key(y, z));
+        if (row == nullptr) {
+          continue;
+        }
+        const Span<int> row_cell_x = grid.sorted_cell_x.as_span().slice(*row);
+        const int start = std::lower_bound(row_cell_x.begin(), row_cell_x.end(), cell.x - 1) -
+                          row_cell_x.begin();
+        const int end = std::upper_bound(row_cell_x.begin(), row_cell_x.end(), cell.x + 1) -
+                        row_cell_x.begin();
+        for (const int sorted_i : row->slice(start, end - start)) {
+          const int other = grid.sorted_indices[sorted_i];
+          if (other != i && math::distance_squared(grid.sorted_positions[sorted_i], position) <=
+                                minimum_distance_sq) {
+            elimination_mask[other] = true;
+          }
+        }
+      }
+    }
+  }
+}
+
+BLI_NOINLINE static void update_elimination_mask_for_close_points_kdtree(
+    Span<float3> positions, const float minimum_distance, MutableSpan<bool> elimination_mask)
+{
   KDTree_3d *kdtree = build_kdtree(positions);
   BLI_SCOPED_DEFER([&]() { BLI_kdtree_3d_free(kdtree); });
 
@@ -179,6 +354,27 @@ BLI_NOINLINE static void update_elimination_mask_for_close_points(
   }
 }
 
+/**
+ * Eliminate the points that are closer than the minimum distance to a point with a lower index
+ * that wasn't eliminated itself.
+ */
+BLI_NOINLINE static void update_elimination_mask_for_close_points(
+    Span<float3> positions, const float minimum_distance, MutableSpan<bool> elimination_mask)
+{
+  if (minimum_distance <= 0.0f) {
+    return;
+  }
+
+  CloseCellGrid grid;
+  if (build_close_cell_grid(positions, minimum_distance, grid)) {
+    update_elimination_mask_for_close_points_grid(
+        positions, minimum_distance, grid, elimination_mask);
+  }
+  else {
+    update_elimination_mask_for_close_points_kdtree(positions, minimum_distance, elimination_mask);
+  }
+}
+
 BLI_NOINLINE static void update_elimination_mask_based_on_density_factors(
     const Mesh &mesh,
     const Span<float> density_factors,
@@ -188,30 +384,33 @@ BLI_NOINLINE static void update_elimination_mask_based_on_density_factors(
 {
   const Span<MLoopTri> looptris{BKE_mesh_runtime_looptri_ensure(&mesh),
                                 BKE_mesh_runtime_looptri_len(&mesh)};
-  for (const int i : bary_coords.index_range()) {
-    if (elimination_mask[i]) {
-      continue;
-    }
+  threading::parallel_for(bary_coords.index_range(), 2048, [&](const IndexRange range) {
+    for (const int i : range) {
+      if (elimination_mask[i]) {
+        continue;
+      }
 
-    const MLoopTri &looptri = looptris[looptri_indices[i]];
-    const float3 bary_coord = bary_coords[i];
+      const MLoopTri &looptri = looptris[looptri_indices[i]];
+      const float3 bary_coord = bary_coords[i];
 
-    const int v0_loop = looptri.tri[0];
-    const int v1_loop = looptri.tri[1];
-    const int v2_loop = looptri.tri[2];
+      const int v0_loop = looptri.tri[0];
+      const int v1_loop = looptri.tri[1];
+      const int v2_loop = looptri.tri[2];
 
-    const float v0_density_factor = std::max(0.0f, density_factors[v0_loop]);
-    const float v1_density_factor = std::max(0.0f, density_factors[v1_loop]);
-    const float v2_density_factor = std::max(0.0f, density_factors[v2_loop]);
+      const float v0_density_factor = std::max(0.0f, density_factors[v0_loop]);
+      const float v1_density_factor = std::max(0.0f, density_factors[v1_loop]);
+      const float v2_density_factor = std::max(0.0f, density_factors[v2_loop]);
 
-    const float probablity = v0_density_factor * bary_coord.x + v1_density_factor * bary_coord.y +
-                             v2_density_factor * bary_coord.z;
+      const float probablity = v0_density_factor * bary_coord.x +
+                               v1_density_factor * bary_coord.y +
+                               v2_density_factor * bary_coord.z;
 
-    const float hash = noise::hash_float_to_float(bary_coord);
-    if (hash > probablity) {
-      elimination_mask[i] = true;
+      const float hash = noise::hash_float_to_float(bary_coord);
+      if (hash > probablity) {
+        elimination_mask[i] = true;
+      }
     }
-  }
+  });
 }
 
 BLI_NOINLINE static void eliminate_points_based_on_mask(const Span<bool> elimination_mask,
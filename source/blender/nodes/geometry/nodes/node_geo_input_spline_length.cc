@@ -23,9 +23,9 @@ static VArray<float> construct_spline_length_gvarray(const CurveComponent &compo
   if (!component.has_curves()) {
     return {};
   }
-  const std::unique_ptr<CurveEval> curve = curves_to_curve_eval(*component.get_for_read());
+  const CurveEval &curve = curves_to_curve_eval_cached(*component.get_for_read());
 
-  Span<SplinePtr> splines = curve->splines();
+  Span<SplinePtr> splines = curve.splines();
   Array<float> spline_lenghts(splines.size());
   for (const int i : splines.index_range()) {
     spline_lenghts[i] = splines[i]->length();
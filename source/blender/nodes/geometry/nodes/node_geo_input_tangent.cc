@@ -80,15 +80,15 @@ static VArray<float3> construct_curve_tangent_gvarray(const CurveComponent &comp
   if (!component.has_curves()) {
     return {};
   }
-  const std::unique_ptr<CurveEval> curve = curves_to_curve_eval(*component.get_for_read());
+  const CurveEval &curve = curves_to_curve_eval_cached(*component.get_for_read());
 
   if (domain == ATTR_DOMAIN_POINT) {
-    Array<float3> tangents = curve_tangent_point_domain(*curve);
+    Array<float3> tangents = curve_tangent_point_domain(curve);
     return VArray<float3>::ForContainer(std::move(tangents));
   }
 
   if (domain == ATTR_DOMAIN_CURVE) {
-    Array<float3> point_tangents = curve_tangent_point_domain(*curve);
+    Array<float3> point_tangents = curve_tangent_point_domain(curve);
     return component.attribute_try_adapt_domain<float3>(
         VArray<float3>::ForContainer(std::move(point_tangents)),
         ATTR_DOMAIN_POINT,
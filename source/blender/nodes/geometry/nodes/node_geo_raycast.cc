@@ -149,57 +149,53 @@ static void raycast_to_mesh(IndexMask mask,
   /* We shouldn't be rebuilding the BVH tree when calling this function in parallel. */
   BLI_assert(tree_data.cached);
 
-  for (const int i : mask) {
-    const float ray_length = ray_lengths[i];
-    const float3 ray_origin = ray_origins[i];
-    const float3 ray_direction = math::normalize(ray_directions[i]);
-
-    BVHTreeRayHit hit;
-    hit.index = -1;
-    hit.dist = ray_length;
-    if (BLI_bvhtree_ray_cast(tree_data.tree,
-                             ray_origin,
-                             ray_direction,
-                             0.0f,
-                             &hit,
-                             tree_data.raycast_callback,
-                             &tree_data) != -1) {
-      hit_count++;
-      if (!r_hit.is_empty()) {
-        r_hit[i] = hit.index >= 0;
-      }
-      if (!r_hit_indices.is_empty()) {
-        /* The caller must be able to handle invalid indices anyway, so don't clamp this value. */
-        r_hit_indices[i] = hit.index;
-      }
-      if (!r_hit_positions.is_empty()) {
-        r_hit_positions[i] = hit.co;
-      }
-      if (!r_hit_normals.is_empty()) {
-        r_hit_normals[i] = hit.no;
-      }
-      if (!r_hit_distances.is_empty()) {
-        r_hit_distances[i] = hit.dist;
-      }
-    }
-    else {
-      if (!r_hit.is_empty()) {
-        r_hit[i] = false;
-      }
-      if (!r_hit_indices.is_empty()) {
-        r_hit_indices[i] = -1;
-      }
-      if (!r_hit_positions.is_empty()) {
-        r_hit_positions[i] = float3(0.0f, 0.0f, 0.0f);
-      }
-      if (!r_hit_normals.is_empty()) {
-        r_hit_normals[i] = float3(0.0f, 0.0f, 0.0f);
-      }
-      if (!r_hit_distances.is_empty()) {
-        r_hit_distances[i] = ray_length;
-      }
-    }
-  }
+  hit_count = int(BLI_bvhtree_ray_cast_batch(
+      tree_data.tree,
+      mask,
+      ray_origins,
+      ray_directions,
+      ray_lengths,
+      0.0f,
+      tree_data.raycast_callback,
+      &tree_data,
+      [&](const int64_t i, const BVHTreeRayHit &hit) {
+        if (hit.index >= 0) {
+          if (!r_hit.is_empty()) {
+            r_hit[i] = true;
+          }
+          if (!r_hit_indices.is_empty()) {
+            /* The caller must be able to handle invalid indices anyway, so don't clamp this
+             * value. */
+            r_hit_indices[i] = hit.index;
+          }
+          if (!r_hit_positions.is_empty()) {
+            r_hit_positions[i] = hit.co;
+          }
+          if (!r_hit_normals.is_empty()) {
+            r_hit_normals[i] = hit.no;
+          }
+          if (!r_hit_distances.is_empty()) {
+            r_hit_distances[i] = hit.dist;
+          }
+        }
+        else {
+          if (!r_hit.is_empty()) {
+            r_hit[i] = false;
+          }
+          if (!r_hit_indices.is_empty()) {
+            r_hit_indices[i] = -1;
+          }
+          if (!r_hit_positions.is_empty()) {
+            r_hit_positions[i] = float3(0.0f, 0.0f, 0.0f);
+          }
+          if (!r_hit_normals.is_empty()) {
+            r_hit_normals[i] = float3(0.0f, 0.0f, 0.0f);
+          }
+          if (!r_hit_distances.is_empty()) {
+            r_hit_distances[i] = ray_lengths[i];
+          }
+        }
+      }));
 }
 
 class RaycastFunction : public fn::MultiFunction {
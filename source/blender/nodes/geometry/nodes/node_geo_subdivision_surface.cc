@@ -1,5 +1,7 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_task.hh"
+
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
 #include "DNA_modifier_types.h"
@@ -86,9 +88,11 @@ static void node_geo_exec(GeoNodeExecParams params)
     OutputAttribute_Typed<float> crease = mesh_component.attribute_try_get_for_output_only<float>(
         "crease", domain);
     MutableSpan<float> crease_span = crease.as_span();
-    for (auto i : creases.index_range()) {
-      crease_span[i] = std::clamp(creases[i], 0.0f, 1.0f);
-    }
+    threading::parallel_for(creases.index_range(), 2048, [&](IndexRange range) {
+      for (const int i : range) {
+        crease_span[i] = std::clamp(creases[i], 0.0f, 1.0f);
+      }
+    });
     crease.save();
 
     /* Initialize mesh settings. */
@@ -23,41 +23,53 @@ static void node_declare(NodeDeclarationBuilder &b)
   b.add_input<decl::Bool>(N_("Switch")).default_value(false).supports_field();
   b.add_input<decl::Bool>(N_("Switch"), "Switch_001").default_value(false);
 
-  b.add_input<decl::Float>(N_("False")).supports_field();
-  b.add_input<decl::Float>(N_("True")).supports_field();
-  b.add_input<decl::Int>(N_("False"), "False_001").min(-100000).max(100000).supports_field();
-  b.add_input<decl::Int>(N_("True"), "True_001").min(-100000).max(100000).supports_field();
+  b.add_input<decl::Float>(N_("False")).supports_field().lazy();
+  b.add_input<decl::Float>(N_("True")).supports_field().lazy();
+  b.add_input<decl::Int>(N_("False"), "False_001")
+      .min(-100000)
+      .max(100000)
+      .supports_field()
+      .lazy();
+  b.add_input<decl::Int>(N_("True"), "True_001")
+      .min(-100000)
+      .max(100000)
+      .supports_field()
+      .lazy();
   b.add_input<decl::Bool>(N_("False"), "False_002")
       .default_value(false)
       .hide_value()
-      .supports_field();
+      .supports_field()
+      .lazy();
   b.add_input<decl::Bool>(N_("True"), "True_002")
       .default_value(true)
       .hide_value()
-      .supports_field();
-  b.add_input<decl::Vector>(N_("False"), "False_003").supports_field();
-  b.add_input<decl::Vector>(N_("True"), "True_003").supports_field();
+      .supports_field()
+      .lazy();
+  b.add_input<decl::Vector>(N_("False"), "False_003").supports_field().lazy();
+  b.add_input<decl::Vector>(N_("True"), "True_003").supports_field().lazy();
   b.add_input<decl::Color>(N_("False"), "False_004")
       .default_value({0.8f, 0.8f, 0.8f, 1.0f})
-      .supports_field();
+      .supports_field()
+      .lazy();
   b.add_input<decl::Color>(N_("True"), "True_004")
       .default_value({0.8f, 0.8f, 0.8f, 1.0f})
-      .supports_field();
-  b.add_input<decl::String>(N_("False"), "False_005").supports_field();
-  b.add_input<decl::String>(N_("True"), "True_005").supports_field();
-
-  b.add_input<decl::Geometry>(N_("False"), "False_006");
-  b.add_input<decl::Geometry>(N_("True"), "True_006");
-  b.add_input<decl::Object>(N_("False"), "False_007");
-  b.add_input<decl::Object>(N_("True"), "True_007");
-  b.add_input<decl::Collection>(N_("False"), "False_008");
-  b.add_input<decl::Collection>(N_("True"), "True_008");
-  b.add_input<decl::Texture>(N_("False"), "False_009");
-  b.add_input<decl::Texture>(N_("True"), "True_009");
-  b.add_input<decl::Material>(N_("False"), "False_010");
-  b.add_input<decl::Material>(N_("True"), "True_010");
-  b.add_input<decl::Image>(N_("False"), "False_011");
-  b.add_input<decl::Image>(N_("True"), "True_011");
+      .supports_field()
+      .lazy();
+  b.add_input<decl::String>(N_("False"), "False_005").supports_field().lazy();
+  b.add_input<decl::String>(N_("True"), "True_005").supports_field().lazy();
+
+  b.add_input<decl::Geometry>(N_("False"), "False_006").lazy();
+  b.add_input<decl::Geometry>(N_("True"), "True_006").lazy();
+  b.add_input<decl::Object>(N_("False"), "False_007").lazy();
+  b.add_input<decl::Object>(N_("True"), "True_007").lazy();
+  b.add_input<decl::Collection>(N_("False"), "False_008").lazy();
+  b.add_input<decl::Collection>(N_("True"), "True_008").lazy();
+  b.add_input<decl::Texture>(N_("False"), "False_009").lazy();
+  b.add_input<decl::Texture>(N_("True"), "True_009").lazy();
+  b.add_input<decl::Material>(N_("False"), "False_010").lazy();
+  b.add_input<decl::Material>(N_("True"), "True_010").lazy();
+  b.add_input<decl::Image>(N_("False"), "False_011").lazy();
+  b.add_input<decl::Image>(N_("True"), "True_011").lazy();
 
   b.add_output<decl::Float>(N_("Output")).dependent_field();
   b.add_output<decl::Int>(N_("Output"), "Output_001").dependent_field();
@@ -170,10 +182,6 @@ template<typename T> class SwitchFieldsFunction : public fn::MultiFunction {
 
 template<typename T> void switch_fields(GeoNodeExecParams &params, const StringRef suffix)
 {
-  if (params.lazy_require_input("Switch")) {
-    return;
-  }
-
   const std::string name_false = "False" + suffix;
   const std::string name_true = "True" + suffix;
   const std::string name_output = "Output" + suffix;
@@ -219,9 +227,6 @@ template<typename T> void switch_fields(GeoNodeExecParams &params, const StringR
 
 template<typename T> void switch_no_fields(GeoNodeExecParams &params, const StringRef suffix)
 {
-  if (params.lazy_require_input("Switch_001")) {
-    return;
-  }
   bool switch_value = params.get_input<bool>("Switch_001");
 
   const std::string name_false = "False" + suffix;
@@ -148,22 +148,24 @@ static void get_closest_in_bvhtree(BVHTreeFromMesh &tree_data,
   BLI_assert(positions.size() >= r_distances_sq.size());
   BLI_assert(positions.size() >= r_positions.size());
 
-  for (const int i : mask) {
-    BVHTreeNearest nearest;
-    nearest.dist_sq = FLT_MAX;
-    const float3 position = positions[i];
-    BLI_bvhtree_find_nearest(
-        tree_data.tree, position, &nearest, tree_data.nearest_callback, &tree_data);
-    if (!r_indices.is_empty()) {
-      r_indices[i] = nearest.index;
-    }
-    if (!r_distances_sq.is_empty()) {
-      r_distances_sq[i] = nearest.dist_sq;
-    }
-    if (!r_positions.is_empty()) {
-      r_positions[i] = nearest.co;
-    }
-  }
+  BLI_bvhtree_find_nearest_batch(
+      tree_data.tree,
+      mask,
+      positions,
+      FLT_MAX,
+      tree_data.nearest_callback,
+      &tree_data,
+      [&](const int64_t i, const BVHTreeNearest &nearest) {
+        if (!r_indices.is_empty()) {
+          r_indices[i] = nearest.index;
+        }
+        if (!r_distances_sq.is_empty()) {
+          r_distances_sq[i] = nearest.dist_sq;
+        }
+        if (!r_positions.is_empty()) {
+          r_positions[i] = nearest.co;
+        }
+      });
 }
 
 static void get_closest_pointcloud_points(const PointCloud &pointcloud,
@@ -178,17 +180,18 @@ static void get_closest_pointcloud_points(const PointCloud &pointcloud,
   BVHTreeFromPointCloud tree_data;
   BKE_bvhtree_from_pointcloud_get(&tree_data, &pointcloud, 2);
 
-  for (const int i : mask) {
-    BVHTreeNearest nearest;
-    nearest.dist_sq = FLT_MAX;
-    const float3 position = positions[i];
-    BLI_bvhtree_find_nearest(
-        tree_data.tree, position, &nearest, tree_data.nearest_callback, &tree_data);
-    r_indices[i] = nearest.index;
-    if (!r_distances_sq.is_empty()) {
-      r_distances_sq[i] = nearest.dist_sq;
-    }
-  }
+  BLI_bvhtree_find_nearest_batch(tree_data.tree,
+                                 mask,
+                                 positions,
+                                 FLT_MAX,
+                                 tree_data.nearest_callback,
+                                 &tree_data,
+                                 [&](const int64_t i, const BVHTreeNearest &nearest) {
+                                   r_indices[i] = nearest.index;
+                                   if (!r_distances_sq.is_empty()) {
+                                     r_distances_sq[i] = nearest.dist_sq;
+                                   }
+                                 });
 
   free_bvhtree_from_pointcloud(&tree_data);
 }
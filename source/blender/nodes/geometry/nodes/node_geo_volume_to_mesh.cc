@@ -15,6 +15,8 @@
 #include "BKE_volume.h"
 #include "BKE_volume_to_mesh.hh"
 
+#include "BLI_task.hh"
+
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
 
@@ -98,10 +100,13 @@ static Mesh *create_mesh_from_volume_grids(Span<openvdb::GridBase::ConstPtr> gri
                                            const float adaptivity,
                                            const bke::VolumeToMeshResolution &resolution)
 {
+  /* Grids are independent, convert them concurrently. */
   Array<bke::OpenVDBMeshData> mesh_data(grids.size());
-  for (const int i : grids.index_range()) {
-    mesh_data[i] = bke::volume_to_mesh_data(*grids[i], resolution, threshold, adaptivity);
-  }
+  threading::parallel_for(grids.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      mesh_data[i] = bke::volume_to_mesh_data(*grids[i], resolution, threshold, adaptivity);
+    }
+  });
 
   int vert_offset = 0;
   int poly_offset = 0;
@@ -125,18 +130,20 @@ static Mesh *create_mesh_from_volume_grids(Span<openvdb::GridBase::ConstPtr> gri
   MutableSpan<MLoop> loops{mesh->mloop, mesh->totloop};
   MutableSpan<MPoly> polys{mesh->mpoly, mesh->totpoly};
 
-  for (const int i : grids.index_range()) {
-    const bke::OpenVDBMeshData &data = mesh_data[i];
-    bke::fill_mesh_from_openvdb_data(data.verts,
-                                     data.tris,
-                                     data.quads,
-                                     vert_offsets[i],
-                                     poly_offsets[i],
-                                     loop_offsets[i],
-                                     verts,
-                                     polys,
-                                     loops);
-  }
+  threading::parallel_for(grids.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      const bke::OpenVDBMeshData &data = mesh_data[i];
+      bke::fill_mesh_from_openvdb_data(data.verts,
+                                       data.tris,
+                                       data.quads,
+                                       vert_offsets[i],
+                                       poly_offsets[i],
+                                       loop_offsets[i],
+                                       verts,
+                                       polys,
+                                       loops);
+    }
+  });
 
   BKE_mesh_calc_edges(mesh, false, false);
   BKE_mesh_normals_tag_dirty(mesh);
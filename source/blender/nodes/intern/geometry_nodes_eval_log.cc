@@ -2,6 +2,8 @@
 
 #include "NOD_geometry_nodes_eval_log.hh"
 
+#include "BLI_array.hh"
+
 #include "BKE_geometry_set_instances.hh"
 
 #include "DNA_modifier_types.h"
@@ -11,7 +13,12 @@
 
 #include "BLT_translation.h"
 
+#include "MEM_guardedalloc.h"
+
+#include <algorithm>
 #include <chrono>
+#include <iomanip>
+#include <ostream>
 
 namespace blender::nodes::geometry_nodes_eval_log {
 
@@ -21,15 +28,28 @@ using fn::FieldInput;
 using fn::GField;
 using fn::ValueOrFieldCPPType;
 
+static std::string node_path(const DNode node)
+{
+  std::string path = node->name();
+  for (const DTreeContext *context = node.context(); !context->is_root();
+       context = context->parent_context()) {
+    path = context->parent_node()->name() + "/" + path;
+  }
+  return path;
+}
+
 ModifierLog::ModifierLog(GeoLogger &logger)
     : input_geometry_log_(std::move(logger.input_geometry_log_)),
-      output_geometry_log_(std::move(logger.output_geometry_log_))
+      output_geometry_log_(std::move(logger.output_geometry_log_)),
+      mem_in_use_begin_(logger.mem_in_use_begin_),
+      mem_in_use_end_(MEM_get_memory_in_use())
 {
   root_tree_logs_ = allocator_.construct<TreeLog>();
 
   LogByTreeContext log_by_tree_context;
 
   /* Combine all the local loggers that have been used by separate threads. */
+  int thread_index = 0;
   for (LocalGeoLogger &local_logger : logger) {
     /* Take ownership of the allocator. */
     logger_allocators_.append(std::move(local_logger.allocator_));
@@ -57,13 +77,24 @@ ModifierLog::ModifierLog(GeoLogger &logger)
       NodeLog &node_log = this->lookup_or_add_node_log(log_by_tree_context,
                                                        node_with_exec_time.node);
       node_log.exec_time_ = node_with_exec_time.exec_time;
+      execution_events_.append({node_path(node_with_exec_time.node),
+                                thread_index,
+                                node_with_exec_time.begin,
+                                node_with_exec_time.exec_time});
     }
 
     for (NodeWithDebugMessage &debug_message : local_logger.node_debug_messages_) {
       NodeLog &node_log = this->lookup_or_add_node_log(log_by_tree_context, debug_message.node);
       node_log.debug_messages_.append(debug_message.message);
     }
+    thread_index++;
   }
+
+  std::sort(execution_events_.begin(),
+            execution_events_.end(),
+            [](const NodeExecutionEvent &a, const NodeExecutionEvent &b) {
+              return a.begin < b.begin;
+            });
 }
 
 TreeLog &ModifierLog::lookup_or_add_tree_log(LogByTreeContext &log_by_tree_context,
@@ -124,6 +155,97 @@ const GeometryValueLog *ModifierLog::output_geometry_log() const
   return output_geometry_log_.get();
 }
 
+Span<NodeExecutionEvent> ModifierLog::execution_events() const
+{
+  return execution_events_;
+}
+
+static void write_json_string(std::ostream &stream, const StringRef str)
+{
+  stream << '"';
+  for (const char c : str) {
+    switch (c) {
+      case '"':
+        stream << "\\\"";
+        break;
+      case '\\':
+        stream << "\\\\";
+        break;
+      case '\n':
+        stream << "\\n";
+        break;
+      default:
+        if (uint8_t(c) < 0x20) {
+          stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(uint8_t(c))
+                 << std::dec;
+        }
+        else {
+          stream << c;
+        }
+        break;
+    }
+  }
+  stream << '"';
+}
+
+void ModifierLog::write_timings_trace(std::ostream &stream) const
+{
+  using namespace std::chrono;
+  const steady_clock::time_point start = execution_events_.is_empty() ?
+                                             steady_clock::time_point() :
+                                             execution_events_.first().begin;
+  microseconds end = microseconds::zero();
+  int threads_num = 0;
+  for (const NodeExecutionEvent &event : execution_events_) {
+    end = std::max(end, duration_cast<microseconds>(event.begin - start) + event.duration);
+    threads_num = std::max(threads_num, event.thread_index + 1);
+  }
+  /* A thread can execute another node while it waits for a parallel loop in a node, so only the
+   * union of the execution times is counted as busy time. */
+  Array<microseconds> busy_time(threads_num, microseconds::zero());
+  Array<microseconds> busy_until(threads_num, microseconds::zero());
+
+  stream << "{\"traceEvents\": [\n";
+  bool first = true;
+  const auto separator = [&]() -> std::ostream & {
+    stream << (first ? "  " : ",\n  ");
+    first = false;
+    return stream;
+  };
+  for (const int thread_index : IndexRange(threads_num)) {
+    separator() << R"({"ph": "M", "pid": 0, "tid": )" << thread_index
+                << R"(, "name": "thread_name", "args": {"name": "Thread )" << thread_index
+                << "\"}}";
+  }
+  for (const NodeExecutionEvent &event : execution_events_) {
+    const int64_t begin_us = duration_cast<microseconds>(event.begin - start).count();
+    separator() << R"({"ph": "X", "cat": "node", "pid": 0, "tid": )" << event.thread_index
+                << R"(, "ts": )" << begin_us << R"(, "dur": )" << event.duration.count()
+                << R"(, "name": )";
+    write_json_string(stream, event.node_path);
+    stream << "}";
+    const microseconds event_begin(begin_us);
+    const microseconds event_end = event_begin + event.duration;
+    microseconds &thread_busy_until = busy_until[event.thread_index];
+    if (event_end > thread_busy_until) {
+      busy_time[event.thread_index] += event_end - std::max(event_begin, thread_busy_until);
+      thread_busy_until = event_end;
+    }
+  }
+  separator() << R"({"ph": "C", "pid": 0, "ts": 0, "name": "Memory", "args": {"bytes": )"
+              << mem_in_use_begin_ << "}}";
+  separator() << R"({"ph": "C", "pid": 0, "ts": )" << end.count()
+              << R"(, "name": "Memory", "args": {"bytes": )" << mem_in_use_end_ << "}}";
+  stream << "\n],\n";
+
+  /* Summary of the thread utilization. */
+  stream << R"("otherData": {"wall_time_us": )" << end.count() << R"(, "thread_busy_time_us": [)";
+  for (const int thread_index : busy_time.index_range()) {
+    stream << (thread_index == 0 ? "" : ", ") << busy_time[thread_index].count();
+  }
+  stream << "]}}\n";
+}
+
 const NodeLog *TreeLog::lookup_node_log(StringRef node_name) const
 {
   const destruct_ptr<NodeLog> *node_log = node_logs_.lookup_ptr_as(node_name);
@@ -401,6 +523,13 @@ const NodeLog *ModifierLog::find_node_by_spreadsheet_editor_context(
   return node_log;
 }
 
+GeoLogger::GeoLogger(Set<DSocket> log_full_sockets)
+    : log_full_sockets_(std::move(log_full_sockets)),
+      threadlocals_([this]() { return LocalGeoLogger(*this); }),
+      mem_in_use_begin_(MEM_get_memory_in_use())
+{
+}
+
 void LocalGeoLogger::log_value_for_sockets(Span<DSocket> sockets, GPointer value)
 {
   const CPPType &type = *value.type();
@@ -472,9 +601,11 @@ void LocalGeoLogger::log_node_warning(DNode node, NodeWarningType type, std::str
   node_warnings_.append({node, {type, std::move(message)}});
 }
 
-void LocalGeoLogger::log_execution_time(DNode node, std::chrono::microseconds exec_time)
+void LocalGeoLogger::log_execution_time(DNode node,
+                                        std::chrono::steady_clock::time_point begin,
+                                        std::chrono::microseconds exec_time)
 {
-  node_exec_times_.append({node, exec_time});
+  node_exec_times_.append({node, begin, exec_time});
 }
 
 void LocalGeoLogger::log_debug_message(DNode node, std::string message)
@@ -31,6 +31,8 @@
 #include "bpy_app_icons.h"
 #include "bpy_app_timers.h"
 
+#include "MEM_guardedalloc.h"
+
 #include "BLI_utildefines.h"
 
 #include "BKE_appdir.h"
@@ -341,6 +343,21 @@ static PyObject *bpy_app_autoexec_fail_message_get(PyObject *UNUSED(self), void
   return PyC_UnicodeFromByte(G.autoexec_fail);
 }
 
+PyDoc_STRVAR(bpy_app_memory_usage_by_category_doc,
+             "Dictionary of the memory in use in bytes, by category of the allocating subsystem. "
+             "Only available with the default allocator, not with --debug-memory (read-only)");
+static PyObject *bpy_app_memory_usage_by_category_get(PyObject *UNUSED(self),
+                                                      void *UNUSED(closure))
+{
+  PyObject *dict = PyDict_New();
+  for (int i = 0; i < MEM_CATEGORY_NUM; i++) {
+    PyObject *value = PyLong_FromSize_t(MEM_get_category_memory_in_use((eMEMCategory)i));
+    PyDict_SetItemString(dict, MEM_category_name((eMEMCategory)i), value);
+    Py_DECREF(value);
+  }
+  return dict;
+}
+
 static PyGetSetDef bpy_app_getsets[] = {
     {"debug", bpy_app_debug_get, bpy_app_debug_set, bpy_app_debug_doc, (void *)G_DEBUG},
     {"debug_ffmpeg",
@@ -425,6 +442,11 @@ static PyGetSetDef bpy_app_getsets[] = {
      NULL},
     {"tempdir", bpy_app_tempdir_get, NULL, bpy_app_tempdir_doc, NULL},
     {"driver_namespace", bpy_app_driver_dict_get, NULL, bpy_app_driver_dict_doc, NULL},
+    {"memory_usage_by_category",
+     bpy_app_memory_usage_by_category_get,
+     NULL,
+     bpy_app_memory_usage_by_category_doc,
+     NULL},
 
     {"render_icon_size",
      bpy_app_preview_render_size_get,
@@ -5365,6 +5365,116 @@ static PyObject *pyrna_prop_collection_foreach_set(BPy_PropertyRNA *self, PyObje
   return foreach_getset(self, args, 1);
 }
 
+static const char *foreach_buffer_format(RawPropertyType raw_type, bool attr_signed)
+{
+  switch (raw_type) {
+    case PROP_RAW_CHAR:
+      return attr_signed ? "b" : "B";
+    case PROP_RAW_SHORT:
+      return attr_signed ? "h" : "H";
+    case PROP_RAW_INT:
+      return attr_signed ? "i" : "I";
+    case PROP_RAW_BOOLEAN:
+      return "?";
+    case PROP_RAW_FLOAT:
+      return "f";
+    case PROP_RAW_DOUBLE:
+      return "d";
+    case PROP_RAW_UNSET:
+      break;
+  }
+  return NULL;
+}
+
+PyDoc_STRVAR(pyrna_prop_collection_foreach_view_doc,
+             ".. method:: foreach_view(attr, writable=False)\n"
+             "\n"
+             "   Return a memoryview of an attribute of all items in this collection, without\n"
+             "   copying the data. It can be passed to ``numpy.asarray`` for example.\n"
+             "\n"
+             "   :arg attr: The name of the attribute of the items.\n"
+             "   :type attr: string\n"
+             "   :arg writable: When true, values can be assigned through the view. The update of\n"
+             "      the attribute is triggered once, when the view is created.\n"
+             "   :type writable: boolean\n"
+             "   :return: A view with one row per item, and one column per array element when the\n"
+             "      attribute is an array.\n"
+             "   :rtype: memoryview\n"
+             "\n"
+             "   .. warning::\n"
+             "\n"
+             "      The view does not own the data. It must not be used after the collection is\n"
+             "      resized or freed, for example after adding geometry or changing the mode.\n");
+static PyObject *pyrna_prop_collection_foreach_view(BPy_PropertyRNA *self,
+                                                    PyObject *args,
+                                                    PyObject *kw)
+{
+  const char *attr;
+  bool writable = false;
+
+  PYRNA_PROP_CHECK_OBJ(self);
+
+  static const char *_keywords[] = {"", "writable", NULL};
+  static _PyArg_Parser _parser = {"s|$O&:foreach_view", _keywords, 0};
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kw, &_parser, &attr, PyC_ParseBool, &writable)) {
+    return NULL;
+  }
+
+  PointerRNA itemptr;
+  PropertyRNA *itemprop = NULL;
+  RawArray raw_array = {NULL};
+  /* An empty collection results in an empty view, the type of the items is not needed then. */
+  if (!RNA_property_collection_lookup_int(&self->ptr, self->prop, 0, &itemptr)) {
+    return PyMemoryView_FromMemory((char *)"", 0, writable ? PyBUF_WRITE : PyBUF_READ);
+  }
+  itemprop = RNA_struct_find_property(&itemptr, attr);
+  if (itemprop == NULL) {
+    PyErr_Format(PyExc_AttributeError,
+                 "foreach_view '%.200s.%200s[...]' elements have no attribute '%.200s'",
+                 RNA_struct_identifier(self->ptr.type),
+                 RNA_property_identifier(self->prop),
+                 attr);
+    return NULL;
+  }
+  const bool attr_signed = (RNA_property_subtype(itemprop) != PROP_UNSIGNED);
+  const char *format = foreach_buffer_format(RNA_property_raw_type(itemprop), attr_signed);
+  if (format == NULL ||
+      !RNA_property_collection_raw_array(&self->ptr, self->prop, itemprop, &raw_array) ||
+      raw_array.array == NULL) {
+    PyErr_Format(PyExc_TypeError,
+                 "foreach_view '%.200s.%200s[...]' attribute '%.200s' is not stored in a "
+                 "contiguous array, use foreach_get/set instead",
+                 RNA_struct_identifier(self->ptr.type),
+                 RNA_property_identifier(self->prop),
+                 attr);
+    return NULL;
+  }
+
+  const int attr_tot = RNA_property_array_length(&itemptr, itemprop);
+  const Py_ssize_t itemsize = RNA_raw_type_sizeof(raw_array.type);
+  /* The memoryview copies the shape and strides. */
+  Py_ssize_t shape[2] = {raw_array.len, attr_tot};
+  Py_ssize_t strides[2] = {raw_array.stride, itemsize};
+
+  Py_buffer buf = {NULL};
+  buf.buf = raw_array.array;
+  buf.itemsize = itemsize;
+  buf.len = raw_array.len * MAX2(attr_tot, 1) * itemsize;
+  buf.readonly = !writable;
+  buf.format = (char *)format;
+  buf.ndim = (attr_tot > 0) ? 2 : 1;
+  buf.shape = shape;
+  buf.strides = strides;
+
+  if (writable) {
+    /* Values are expected to change, tag the owner of the data before they are written.
+     * Dependency graph updates are only evaluated later, so the new values are used. */
+    RNA_property_update(BPY_context_get(), &itemptr, itemprop);
+  }
+
+  return PyMemoryView_FromBuffer(&buf);
+}
+
 static PyObject *pyprop_array_foreach_getset(BPy_PropertyArrayRNA *self,
                                              PyObject *args,
                                              const bool do_set)
@@ -5714,6 +5824,10 @@ static struct PyMethodDef pyrna_prop_collection_methods[] = {
      (PyCFunction)pyrna_prop_collection_foreach_set,
      METH_VARARGS,
      pyrna_prop_collection_foreach_set_doc},
+    {"foreach_view",
+     (PyCFunction)pyrna_prop_collection_foreach_view,
+     METH_VARARGS | METH_KEYWORDS,
+     pyrna_prop_collection_foreach_view_doc},
 
     {"keys", (PyCFunction)pyrna_prop_collection_keys, METH_NOARGS, pyrna_prop_collection_keys_doc},
     {"items",
@@ -511,6 +511,77 @@ static char *copy_values(PyObject *seq,
   return data;
 }
 
+/**
+ * Copy the values of a dynamic array parameter from an object that supports the buffer protocol,
+ * when its type and shape match the property. This avoids creating a Python object for every
+ * value of large arrays, e.g. NumPy arrays passed to functions.
+ *
+ * \return 1 when the values were copied, 0 when the buffer can't be used directly, so that the
+ * sequence code-path has to be used instead.
+ */
+static int py_to_array_from_buffer(PyObject *seq,
+                                   PointerRNA *ptr,
+                                   PropertyRNA *prop,
+                                   char *param_data,
+                                   const char buffer_format,
+                                   int item_size,
+                                   const ItemConvert_FuncArg *convert_item)
+{
+  if (param_data == NULL || !(RNA_property_flag(prop) & PROP_DYNAMIC) ||
+      !PyObject_CheckBuffer(seq)) {
+    return 0;
+  }
+
+  Py_buffer buf;
+  if (PyObject_GetBuffer(seq, &buf, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == -1) {
+    PyErr_Clear();
+    return 0;
+  }
+
+  /* Only native byte order and size is supported. */
+  const char *format = buf.format ? buf.format : "B";
+  if (format[0] == '@') {
+    format++;
+  }
+  int dimsize[MAX_ARRAY_DIMENSION];
+  const int totdim = RNA_property_array_dimension(ptr, prop, dimsize);
+  bool is_compatible = format[0] == buffer_format && format[1] == '\0' &&
+                       buf.itemsize == item_size && buf.ndim == totdim &&
+                       buf.len / item_size <= INT_MAX;
+  for (int dim = 1; is_compatible && dim < totdim; dim++) {
+    is_compatible = buf.shape[dim] == dimsize[dim];
+  }
+  if (!is_compatible) {
+    PyBuffer_Release(&buf);
+    return 0;
+  }
+
+  const int totitem = (int)(buf.len / item_size);
+  ParameterDynAlloc *param_alloc = (ParameterDynAlloc *)param_data;
+  param_alloc->array_tot = totitem;
+  /* Freeing the parameter list frees the array. */
+  param_alloc->array = MEM_mallocN(MAX2(buf.len, 1), "py_to_array dyn buffer");
+  memcpy(param_alloc->array, buf.buf, buf.len);
+  PyBuffer_Release(&buf);
+
+  /* Apply the same range clamping as the sequence code-path. */
+  if (buffer_format == 'f') {
+    const float *range = convert_item->arg.float_data.range;
+    float *values = param_alloc->array;
+    for (int i = 0; i < totitem; i++) {
+      CLAMP(values[i], range[0], range[1]);
+    }
+  }
+  else if (buffer_format == 'i') {
+    const int *range = convert_item->arg.int_data.range;
+    int *values = param_alloc->array;
+    for (int i = 0; i < totitem; i++) {
+      CLAMP(values[i], range[0], range[1]);
+    }
+  }
+  return 1;
+}
+
 static int py_to_array(PyObject *seq,
                        PointerRNA *ptr,
                        PropertyRNA *prop,
@@ -518,6 +589,7 @@ static int py_to_array(PyObject *seq,
                        ItemTypeCheckFunc check_item_type,
                        const char *item_type_str,
                        int item_size,
+                       const char buffer_format,
                        const ItemConvert_FuncArg *convert_item,
                        RNA_SetArrayFunc rna_set_array,
                        const char *error_prefix)
@@ -528,6 +600,11 @@ static int py_to_array(PyObject *seq,
 
   // totdim = RNA_property_array_dimension(ptr, prop, dim_size); /* UNUSED */
 
+  if (py_to_array_from_buffer(
+          seq, ptr, prop, param_data, buffer_format, item_size, convert_item)) {
+    return 0;
+  }
+
   if (validate_array(seq, ptr, prop, 0, check_item_type, item_type_str, &totitem, error_prefix) ==
       -1) {
     return -1;
@@ -733,6 +810,7 @@ int pyrna_py_to_array(
                         py_float_check,
                         "float",
                         sizeof(float),
+                        'f',
                         &convert_item,
                         (RNA_SetArrayFunc)RNA_property_float_set_array,
                         error_prefix);
@@ -749,6 +827,7 @@ int pyrna_py_to_array(
                         py_int_check,
                         "int",
                         sizeof(int),
+                        'i',
                         &convert_item,
                         (RNA_SetArrayFunc)RNA_property_int_set_array,
                         error_prefix);
@@ -765,6 +844,7 @@ int pyrna_py_to_array(
                         py_bool_check,
                         "boolean",
                         sizeof(bool),
+                        '?',
                         &convert_item,
                         (RNA_SetArrayFunc)RNA_property_boolean_set_array,
                         error_prefix);
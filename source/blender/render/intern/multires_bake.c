@@ -69,6 +69,10 @@ typedef struct {
   const float *precomputed_normals;
   int w, h;
   int tri_index;
+  /* Data of the triangle at `tri_index`, which is the same for all its pixels. */
+  const float *tri_uv[3];
+  float tri_normals[3][3];
+  const float *tri_tangents[3];
   DerivedMesh *lores_dm, *hires_dm;
   int lvl;
   void *thread_data;
@@ -86,7 +90,6 @@ typedef struct {
   char *texels;
   const MResolvePixelData *data;
   MFlushPixel flush_pixel;
-  short *do_update;
 } MBakeRast;
 
 typedef struct {
@@ -131,8 +134,7 @@ static void multiresbake_get_normal(const MResolvePixelData *data,
 static void init_bake_rast(MBakeRast *bake_rast,
                            const ImBuf *ibuf,
                            const MResolvePixelData *data,
-                           MFlushPixel flush_pixel,
-                           short *do_update)
+                           MFlushPixel flush_pixel)
 {
   BakeImBufuserData *userdata = (BakeImBufuserData *)ibuf->userdata;
 
@@ -143,27 +145,32 @@ static void init_bake_rast(MBakeRast *bake_rast,
   bake_rast->h = ibuf->y;
   bake_rast->data = data;
   bake_rast->flush_pixel = flush_pixel;
-  bake_rast->do_update = do_update;
+}
+
+/* Look up the data of a triangle that is shared by all its pixels, before rasterizing it. */
+static void init_bake_tri(MResolvePixelData *data, const int tri_index)
+{
+  const MLoopTri *lt = &data->mlooptri[tri_index];
+
+  data->tri_index = tri_index;
+
+  for (int i = 0; i < 3; i++) {
+    data->tri_uv[i] = data->mloopuv[lt->tri[i]].uv;
+    multiresbake_get_normal(data, data->tri_normals[i], tri_index, i);
+    data->tri_tangents[i] = data->pvtangent ? data->pvtangent + lt->tri[i] * 4 : NULL;
+  }
 }
 
 static void flush_pixel(const MResolvePixelData *data, const int x, const int y)
 {
   const float st[2] = {(x + 0.5f) / data->w, (y + 0.5f) / data->h};
-  const float *st0, *st1, *st2;
-  const float *tang0, *tang1, *tang2;
-  float no0[3], no1[3], no2[3];
+  const float *st0 = data->tri_uv[0], *st1 = data->tri_uv[1], *st2 = data->tri_uv[2];
+  const float *no0 = data->tri_normals[0], *no1 = data->tri_normals[1],
+              *no2 = data->tri_normals[2];
   float fUV[2], from_tang[3][3], to_tang[3][3];
   float u, v, w, sign;
   int r;
 
-  st0 = data->mloopuv[data->mlooptri[data->tri_index].tri[0]].uv;
-  st1 = data->mloopuv[data->mlooptri[data->tri_index].tri[1]].uv;
-  st2 = data->mloopuv[data->mlooptri[data->tri_index].tri[2]].uv;
-
-  multiresbake_get_normal(data, no0, data->tri_index, 0); /* can optimize these 3 into one call */
-  multiresbake_get_normal(data, no1, data->tri_index, 1);
-  multiresbake_get_normal(data, no2, data->tri_index, 2);
-
   resolve_tri_uv_v2(fUV, st, st0, st1, st2);
 
   u = fUV[0];
@@ -171,9 +178,9 @@ static void flush_pixel(const MResolvePixelData *data, const int x, const int y)
   w = 1 - u - v;
 
   if (data->pvtangent) {
-    tang0 = data->pvtangent + data->mlooptri[data->tri_index].tri[0] * 4;
-    tang1 = data->pvtangent + data->mlooptri[data->tri_index].tri[1] * 4;
-    tang2 = data->pvtangent + data->mlooptri[data->tri_index].tri[2] * 4;
+    const float *tang0 = data->tri_tangents[0];
+    const float *tang1 = data->tri_tangents[1];
+    const float *tang2 = data->tri_tangents[2];
 
     /* the sign is the same at all face vertices for any non degenerate face.
      * Just in case we clamp the interpolated value though. */
@@ -216,9 +223,6 @@ static void set_rast_triangle(const MBakeRast *bake_rast, const int x, const int
     if ((bake_rast->texels[y * w + x]) == 0) {
       bake_rast->texels[y * w + x] = FILTER_MASK_USED;
       flush_pixel(bake_rast->data, x, y);
-      if (bake_rast->do_update) {
-        *bake_rast->do_update = true;
-      }
     }
   }
 }
@@ -393,7 +397,7 @@ static void *do_multires_bake_thread(void *data_v)
       continue;
     }
 
-    data->tri_index = tri_index;
+    init_bake_tri(data, tri_index);
 
     bake_rasterize(
         bake_rast, mloopuv[lt->tri[0]].uv, mloopuv[lt->tri[1]].uv, mloopuv[lt->tri[2]].uv);
@@ -556,7 +560,7 @@ static void do_multires_bake(MultiresBakeRender *bkr,
       handle->height_min = FLT_MAX;
       handle->height_max = -FLT_MAX;
 
-      init_bake_rast(&handle->bake_rast, ibuf, &handle->data, flush_pixel, bkr->do_update);
+      init_bake_rast(&handle->bake_rast, ibuf, &handle->data, flush_pixel);
 
       if (tot_thread > 1) {
         BLI_threadpool_insert(&threads, handle);
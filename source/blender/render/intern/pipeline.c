@@ -33,6 +33,7 @@
 #include "BLI_string.h"
 #include "BLI_threads.h"
 #include "BLI_timecode.h"
+#include "BLI_trace.h"
 
 #include "BLT_translation.h"
 
@@ -1194,7 +1195,14 @@ static void do_render_compositor(Render *re)
      * it could be optimized to render only the needed view
      * but what if a scene has a different number of views
      * than the main scene? */
+    const bool use_trace = BLI_trace_is_enabled();
+    if (use_trace) {
+      BLI_trace_begin("render", "Render Engine");
+    }
     do_render_engine(re);
+    if (use_trace) {
+      BLI_trace_end();
+    }
   }
   else {
     re->i.cfra = re->r.cfra;
@@ -1245,6 +1253,10 @@ static void do_render_compositor(Render *re)
           /* If we have consistent depsgraph now would be a time to update them. */
         }
 
+        const bool use_trace = BLI_trace_is_enabled();
+        if (use_trace) {
+          BLI_trace_begin("render", "Compositor");
+        }
         RenderView *rv;
         for (rv = re->result->views.first; rv; rv = rv->next) {
           ntreeCompositExecTree(re->pipeline_scene_eval,
@@ -1256,6 +1268,9 @@ static void do_render_compositor(Render *re)
                                 &re->scene->display_settings,
                                 rv->name);
         }
+        if (use_trace) {
+          BLI_trace_end();
+        }
 
         ntree->stats_draw = NULL;
         ntree->test_break = NULL;
@@ -1466,6 +1481,10 @@ static void do_render_full_pipeline(Render *re)
 
   re->i.lastframetime = PIL_check_seconds_timer() - re->i.starttime;
 
+  if (BLI_trace_is_enabled()) {
+    BLI_trace_complete("render", "Render Frame", re->i.starttime, re->i.lastframetime);
+  }
+
   re->stats_draw(re->sdh, &re->i);
 
   /* save render result stamp if needed */
@@ -2292,6 +2311,29 @@ static void re_movie_free_all(Render *re, bMovieHandle *mh, int totvideos)
   MEM_SAFE_FREE(re->movie_ctx_arr);
 }
 
+/**
+ * Frames which are not rendered still need to be evaluated unless the user opted out, since frame
+ * change handlers may depend on them. They are always evaluated when simulations need to step
+ * through every frame.
+ */
+static bool render_anim_need_skipped_frames_update(Main *bmain, Scene *scene)
+{
+  if ((scene->r.mode & R_SKIP_STEPPED_FRAMES) == 0) {
+    return true;
+  }
+  for (Scene *sce_iter = scene; sce_iter != NULL; sce_iter = sce_iter->set) {
+    if (sce_iter->rigidbody_world != NULL) {
+      return true;
+    }
+  }
+  LISTBASE_FOREACH (Object *, ob, &bmain->objects) {
+    if (BKE_ptcache_object_has(scene, ob, 0)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void RE_RenderAnim(Render *re,
                    Main *bmain,
                    Scene *scene,
@@ -2375,11 +2417,19 @@ void RE_RenderAnim(Render *re,
 
   re->flag |= R_ANIMATION;
 
+  const bool need_skipped_frames_update = (tfra > 1) &&
+                                          render_anim_need_skipped_frames_update(bmain, scene);
+
   {
     scene->r.subframe = 0.0f;
     for (nfra = sfra, scene->r.cfra = sfra; scene->r.cfra <= efra; scene->r.cfra++) {
       char name[FILE_MAX];
 
+      if (nfra != scene->r.cfra && !need_skipped_frames_update) {
+        /* Skip this frame, the user opted out of evaluating it. */
+        continue;
+      }
+
       /* A feedback loop exists here -- render initialization requires updated
        * render layers settings which could be animated, but scene evaluation for
        * the frame happens later because it depends on what layers are visible to
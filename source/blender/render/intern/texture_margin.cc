@@ -5,10 +5,12 @@
  * \ingroup render
  */
 
+#include "BLI_array.hh"
 #include "BLI_assert.h"
 #include "BLI_math_geom.h"
 #include "BLI_math_vec_types.hh"
 #include "BLI_math_vector.hh"
+#include "BLI_task.hh"
 #include "BLI_vector.hh"
 
 #include "BKE_DerivedMesh.h"
@@ -205,70 +207,89 @@ class TextureMarginMap {
    * Walk over the map and for margin pixels follow the direction stored in the bottom 3
    * bits back to the polygon.
    * Then look up the pixel from the next polygon.
+   *
+   * Finding the pixel to copy from only reads the map, so it's done for all rows in parallel.
+   * The pixels are then interpolated in scan-line order, because the interpolation can read
+   * margin pixels that were written before.
    */
   void lookup_pixels(ImBuf *ibuf, char *mask, int maxPolygonSteps)
   {
-    for (int y = 0; y < h_; y++) {
-      for (int x = 0; x < w_; x++) {
-        uint32_t dp = get_pixel(x, y);
-        if (IsDijkstraPixel(dp) && !DijkstraPixelIsUnset(dp)) {
-          int dist = DijkstraPixelGetDistance(dp);
-          int direction = DijkstraPixelGetDirection(dp);
-
-          int xx = x;
-          int yy = y;
-
-          /* Follow the dijkstra directions to find the polygon this margin pixels belongs to. */
-          while (dist > 0) {
-            xx -= directions[direction][0];
-            yy -= directions[direction][1];
-            dp = get_pixel(xx, yy);
-            dist -= distances[direction];
-            BLI_assert(!dist || (dist == DijkstraPixelGetDistance(dp)));
-            direction = DijkstraPixelGetDirection(dp);
-          }
-
-          uint32_t poly = get_pixel(xx, yy);
-
-          BLI_assert(!IsDijkstraPixel(poly));
-
-          float destX, destY;
-
-          int other_poly;
-          bool found_pixel_in_polygon = false;
-          if (lookup_pixel_polygon_neighbourhood(x, y, &poly, &destX, &destY, &other_poly)) {
+    struct MarginPixel {
+      int x;
+      float destX, destY;
+    };
+    Array<Vector<MarginPixel>> margin_pixels_by_row(h_);
+
+    threading::parallel_for(IndexRange(h_), 16, [&](const IndexRange range) {
+      for (const int y : range) {
+        for (int x = 0; x < w_; x++) {
+          uint32_t dp = get_pixel(x, y);
+          if (IsDijkstraPixel(dp) && !DijkstraPixelIsUnset(dp)) {
+            int dist = DijkstraPixelGetDistance(dp);
+            int direction = DijkstraPixelGetDirection(dp);
+
+            int xx = x;
+            int yy = y;
+
+            /* Follow the dijkstra directions to find the polygon this margin pixels belongs to. */
+            while (dist > 0) {
+              xx -= directions[direction][0];
+              yy -= directions[direction][1];
+              dp = get_pixel(xx, yy);
+              dist -= distances[direction];
+              BLI_assert(!dist || (dist == DijkstraPixelGetDistance(dp)));
+              direction = DijkstraPixelGetDirection(dp);
+            }
 
-            for (int i = 0; i < maxPolygonSteps; i++) {
-              /* Force to pixel grid. */
-              int nx = (int)round(destX);
-              int ny = (int)round(destY);
-              uint32_t polygon_from_map = get_pixel(nx, ny);
-              if (other_poly == polygon_from_map) {
-                found_pixel_in_polygon = true;
-                break;
+            uint32_t poly = get_pixel(xx, yy);
+
+            BLI_assert(!IsDijkstraPixel(poly));
+
+            float destX, destY;
+
+            int other_poly;
+            bool found_pixel_in_polygon = false;
+            if (lookup_pixel_polygon_neighbourhood(x, y, &poly, &destX, &destY, &other_poly)) {
+
+              for (int i = 0; i < maxPolygonSteps; i++) {
+                /* Force to pixel grid. */
+                int nx = (int)round(destX);
+                int ny = (int)round(destY);
+                uint32_t polygon_from_map = get_pixel(nx, ny);
+                if (other_poly == polygon_from_map) {
+                  found_pixel_in_polygon = true;
+                  break;
+                }
+
+                float dist_to_edge;
+                /* Look up again, but starting from the polygon we were expected to land in. */
+                if (!lookup_pixel(
+                        nx, ny, other_poly, &destX, &destY, &other_poly, &dist_to_edge)) {
+                  found_pixel_in_polygon = false;
+                  break;
+                }
               }
 
-              float dist_to_edge;
-              /* Look up again, but starting from the polygon we were expected to land in. */
-              if (!lookup_pixel(nx, ny, other_poly, &destX, &destY, &other_poly, &dist_to_edge)) {
-                found_pixel_in_polygon = false;
-                break;
+              if (found_pixel_in_polygon) {
+                margin_pixels_by_row[y].append({x, destX, destY});
+                /* Add our new pixels to the assigned pixel map. */
+                mask[y * w_ + x] = 1;
               }
             }
-
-            if (found_pixel_in_polygon) {
-              bilinear_interpolation(ibuf, ibuf, destX, destY, x, y);
-              /* Add our new pixels to the assigned pixel map. */
-              mask[y * w_ + x] = 1;
-            }
+          }
+          else if (DijkstraPixelIsUnset(dp) || !IsDijkstraPixel(dp)) {
+            /* These are not margin pixels, make sure the extend filter which is run after this
+             * step leaves them alone.
+             */
+            mask[y * w_ + x] = 1;
           }
         }
-        else if (DijkstraPixelIsUnset(dp) || !IsDijkstraPixel(dp)) {
-          /* These are not margin pixels, make sure the extend filter which is run after this step
-           * leaves them alone.
-           */
-          mask[y * w_ + x] = 1;
-        }
+      }
+    });
+
+    for (const int y : IndexRange(h_)) {
+      for (const MarginPixel &pixel : margin_pixels_by_row[y]) {
+        bilinear_interpolation(ibuf, ibuf, pixel.destX, pixel.destY, pixel.x, y);
       }
     }
   }
@@ -20,6 +20,7 @@ struct Scene;
 struct SeqIndexBuildContext;
 struct SeqRenderData;
 struct Sequence;
+struct TicketMutex;
 
 bool SEQ_proxy_rebuild_context(struct Main *bmain,
                                struct Depsgraph *depsgraph,
@@ -43,11 +44,17 @@ typedef struct ProxyBuildJob {
   struct Depsgraph *depsgraph;
   struct Scene *scene;
   struct ListBase queue;
+  /** Protects `queue`, strips can be added while the job is running. */
+  struct TicketMutex *queue_mutex;
   int stop;
 } ProxyJob;
 
 struct wmJob *ED_seq_proxy_wm_job_get(const struct bContext *C);
 ProxyJob *ED_seq_proxy_job_get(const struct bContext *C, struct wmJob *wm_job);
+/**
+ * Move the build contexts in `queue` to the job queue, a running job picks them up as well.
+ */
+void ED_seq_proxy_job_queue_add(ProxyJob *pj, struct ListBase *queue);
 
 #ifdef __cplusplus
 }
@@ -20,9 +20,14 @@ struct Sequence;
 
 typedef enum eSeqTaskId {
   SEQ_TASK_MAIN_RENDER,
+  /** Prefetch workers use consecutive IDs, starting with this one. */
   SEQ_TASK_PREFETCH_RENDER,
 } eSeqTaskId;
 
+/** Maximum number of frames rendered at the same time by prefetching. */
+#define SEQ_PREFETCH_WORKERS_MAX 8
+#define SEQ_TASK_MAX (SEQ_TASK_PREFETCH_RENDER + SEQ_PREFETCH_WORKERS_MAX)
+
 typedef struct SeqRenderData {
   struct Main *bmain;
   struct Depsgraph *depsgraph;
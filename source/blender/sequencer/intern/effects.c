@@ -642,13 +642,18 @@ static void gamtabs(float gamma)
   }
 }
 
+static ThreadMutex gamma_tabs_mutex = BLI_MUTEX_INITIALIZER;
+
 static void build_gammatabs(void)
 {
+  /* Prefetching may render several frames at the same time. */
+  BLI_mutex_lock(&gamma_tabs_mutex);
   if (gamma_tabs_init == false) {
     gamtabs(2.0f);
     makeGammaTables(2.0f);
     gamma_tabs_init = true;
   }
+  BLI_mutex_unlock(&gamma_tabs_mutex);
 }
 
 static void init_gammacross(Sequence *UNUSED(seq))
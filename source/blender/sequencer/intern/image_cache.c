@@ -58,6 +58,8 @@
  * Linking: We use links to reduce number of iterations over entries needed to manage cache.
  * Entries are linked in order as they are put into cache.
  * Only permanent (is_temp_cache = 0) cache entries are linked.
+ * Each task (main thread and prefetch workers) links its entries separately, because tasks render
+ * different frames at the same time.
  * Putting #SEQ_CACHE_STORE_FINAL_OUT will reset linking
  *
  * Only entire frame can be freed to release resources for new entries (recycling).
@@ -75,7 +77,8 @@ typedef struct SeqCache {
   ThreadMutex iterator_mutex;
   struct BLI_mempool *keys_pool;
   struct BLI_mempool *items_pool;
-  struct SeqCacheKey *last_key;
+  /* Last key put into the cache by each task. */
+  struct SeqCacheKey *last_key[SEQ_TASK_MAX];
   struct SeqDiskCache *disk_cache;
   int thumbnail_count;
 } SeqCache;
@@ -213,9 +216,26 @@ static int get_stored_types_flag(Scene *scene, SeqCacheKey *key)
   return flag;
 }
 
+static void seq_cache_last_keys_clear(SeqCache *cache)
+{
+  memset(cache->last_key, 0, sizeof(cache->last_key));
+}
+
+/* Key of a chain that is still being built by a task. */
+static bool seq_cache_key_is_last(SeqCache *cache, SeqCacheKey *key)
+{
+  for (int i = 0; i < SEQ_TASK_MAX; i++) {
+    if (cache->last_key[i] == key) {
+      return true;
+    }
+  }
+  return false;
+}
+
 static void seq_cache_put_ex(Scene *scene, SeqCacheKey *key, ImBuf *ibuf)
 {
   SeqCache *cache = seq_cache_get_from_scene(scene);
+  SeqCacheKey **last_key = &cache->last_key[key->task_id];
   SeqCacheItem *item;
   item = BLI_mempool_alloc(cache->items_pool);
   item->cache_owner = cache;
@@ -226,30 +246,30 @@ static void seq_cache_put_ex(Scene *scene, SeqCacheKey *key, ImBuf *ibuf)
   /* Item stored for later use. */
   if (stored_types_flag & key->type) {
     key->is_temp_cache = false;
-    key->link_prev = cache->last_key;
+    key->link_prev = *last_key;
   }
 
   /* Store pointer to last cached key. */
-  SeqCacheKey *temp_last_key = cache->last_key;
+  SeqCacheKey *temp_last_key = *last_key;
 
   if (BLI_ghash_reinsert(cache->hash, key, item, seq_cache_keyfree, seq_cache_valfree)) {
     IMB_refImBuf(ibuf);
 
     if (!key->is_temp_cache || key->type != SEQ_CACHE_STORE_THUMBNAIL) {
-      cache->last_key = key;
+      *last_key = key;
     }
   }
 
   /* Set last_key's reference to this key so we can look up chain backwards.
-   * Item is already put in cache, so cache->last_key points to current key.
+   * Item is already put in cache, so last_key points to current key.
    */
   if (!key->is_temp_cache && temp_last_key) {
-    temp_last_key->link_next = cache->last_key;
+    temp_last_key->link_next = *last_key;
   }
 
   /* Reset linking. */
   if (key->type == SEQ_CACHE_STORE_FINAL_OUT) {
-    cache->last_key = NULL;
+    *last_key = NULL;
   }
 }
 
@@ -318,8 +338,11 @@ static SeqCacheKey *seq_cache_choose_key(Scene *scene, SeqCacheKey *lkey, SeqCac
       rkey = swapkey;
     }
 
-    int l_diff = scene->r.cfra - lkey->timeline_frame;
-    int r_diff = rkey->timeline_frame - scene->r.cfra;
+    /* Distance to the current frame, divided by the cost of rendering the frame again. Frames
+     * that render in real-time are recycled by distance only, slower frames are kept longer in
+     * proportion to how much slower than real-time they render. */
+    float l_diff = (scene->r.cfra - lkey->timeline_frame) / max_ff(lkey->cost, 1.0f);
+    float r_diff = (rkey->timeline_frame - scene->r.cfra) / max_ff(rkey->cost, 1.0f);
 
     if (l_diff > r_diff) {
       finalkey = lkey;
@@ -413,6 +436,11 @@ static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
       continue;
     }
 
+    /* Frame is still being rendered by another task. */
+    if (seq_cache_key_is_last(cache, key)) {
+      continue;
+    }
+
     total_count++;
 
     if (lkey) {
@@ -494,7 +522,7 @@ static void seq_cache_create(Main *bmain, Scene *scene)
     cache->keys_pool = BLI_mempool_create(sizeof(SeqCacheKey), 0, 64, BLI_MEMPOOL_NOP);
     cache->items_pool = BLI_mempool_create(sizeof(SeqCacheItem), 0, 64, BLI_MEMPOOL_NOP);
     cache->hash = BLI_ghash_new(seq_cache_hashhash, seq_cache_hashcmp, "SeqCache hash");
-    cache->last_key = NULL;
+    seq_cache_last_keys_clear(cache);
     cache->bmain = bmain;
     cache->thumbnail_count = 0;
     BLI_mutex_init(&cache->iterator_mutex);
@@ -611,7 +639,7 @@ void SEQ_cache_cleanup(Scene *scene)
     BLI_ghashIterator_step(&gh_iter);
     BLI_ghash_remove(cache->hash, key, seq_cache_keyfree, seq_cache_valfree);
   }
-  cache->last_key = NULL;
+  seq_cache_last_keys_clear(cache);
   cache->thumbnail_count = 0;
   seq_cache_unlock(scene);
 }
@@ -676,7 +704,7 @@ void seq_cache_cleanup_sequence(Scene *scene,
       BLI_ghash_remove(cache->hash, key, seq_cache_keyfree, seq_cache_valfree);
     }
   }
-  cache->last_key = NULL;
+  seq_cache_last_keys_clear(cache);
   seq_cache_unlock(scene);
 }
 
@@ -717,7 +745,7 @@ void seq_cache_thumbnail_cleanup(Scene *scene, rctf *view_area_safe)
       cache->thumbnail_count--;
     }
   }
-  cache->last_key = NULL;
+  seq_cache_last_keys_clear(cache);
 }
 
 struct ImBuf *seq_cache_get(const SeqRenderData *context,
@@ -784,8 +812,19 @@ struct ImBuf *seq_cache_get(const SeqRenderData *context,
   return ibuf;
 }
 
-bool seq_cache_put_if_possible(
-    const SeqRenderData *context, Sequence *seq, float timeline_frame, int type, ImBuf *ibuf)
+static void seq_cache_put_with_cost(const SeqRenderData *context,
+                                    Sequence *seq,
+                                    float timeline_frame,
+                                    int type,
+                                    ImBuf *i,
+                                    float cost);
+
+bool seq_cache_put_if_possible(const SeqRenderData *context,
+                               Sequence *seq,
+                               float timeline_frame,
+                               int type,
+                               ImBuf *ibuf,
+                               float cost)
 {
   Scene *scene = context->scene;
 
@@ -800,12 +839,13 @@ bool seq_cache_put_if_possible(
   }
 
   if (seq_cache_recycle_item(scene)) {
-    seq_cache_put(context, seq, timeline_frame, type, ibuf);
+    seq_cache_put_with_cost(context, seq, timeline_frame, type, ibuf, cost);
     return true;
   }
 
-  seq_cache_set_temp_cache_linked(scene, scene->ed->cache->last_key);
-  scene->ed->cache->last_key = NULL;
+  SeqCache *cache = seq_cache_get_from_scene(scene);
+  seq_cache_set_temp_cache_linked(scene, cache->last_key[context->task_id]);
+  cache->last_key[context->task_id] = NULL;
   return false;
 }
 
@@ -840,8 +880,12 @@ void seq_cache_thumbnail_put(
   seq_cache_unlock(scene);
 }
 
-void seq_cache_put(
-    const SeqRenderData *context, Sequence *seq, float timeline_frame, int type, ImBuf *i)
+static void seq_cache_put_with_cost(const SeqRenderData *context,
+                                    Sequence *seq,
+                                    float timeline_frame,
+                                    int type,
+                                    ImBuf *i,
+                                    float cost)
 {
   if (i == NULL || context->skip_cache || context->is_proxy_render || !seq) {
     return;
@@ -870,6 +914,7 @@ void seq_cache_put(
   seq_cache_lock(scene);
   SeqCache *cache = seq_cache_get_from_scene(scene);
   SeqCacheKey *key = seq_cache_allocate_key(cache, context, seq, timeline_frame, type);
+  key->cost = cost;
   seq_cache_put_ex(scene, key, i);
   seq_cache_unlock(scene);
 
@@ -885,6 +930,21 @@ void seq_cache_put(
   }
 }
 
+void seq_cache_put(
+    const SeqRenderData *context, Sequence *seq, float timeline_frame, int type, ImBuf *i)
+{
+  seq_cache_put_with_cost(context, seq, timeline_frame, type, i, 0.0f);
+}
+
+void seq_cache_final_out_put(const SeqRenderData *context,
+                             Sequence *seq,
+                             float timeline_frame,
+                             ImBuf *i,
+                             float cost)
+{
+  seq_cache_put_with_cost(context, seq, timeline_frame, SEQ_CACHE_STORE_FINAL_OUT, i, cost);
+}
+
 void SEQ_cache_iterate(
     struct Scene *scene,
     void *userdata,
@@ -909,7 +969,7 @@ void SEQ_cache_iterate(
     interrupt = callback_iter(userdata, key->seq, key->timeline_frame, key->type);
   }
 
-  cache->last_key = NULL;
+  seq_cache_last_keys_clear(cache);
   seq_cache_unlock(scene);
 }
 
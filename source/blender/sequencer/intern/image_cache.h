@@ -44,6 +44,16 @@ void seq_cache_put(const struct SeqRenderData *context,
                    float timeline_frame,
                    int type,
                    struct ImBuf *i);
+/**
+ * Put a final frame into the cache.
+ * \param cost: Render time of the frame divided by its playback duration, frames that are more
+ * expensive to render again are recycled later.
+ */
+void seq_cache_final_out_put(const struct SeqRenderData *context,
+                             struct Sequence *seq,
+                             float timeline_frame,
+                             struct ImBuf *i,
+                             float cost);
 void seq_cache_thumbnail_put(const struct SeqRenderData *context,
                              struct Sequence *seq,
                              float timeline_frame,
@@ -53,7 +63,8 @@ bool seq_cache_put_if_possible(const struct SeqRenderData *context,
                                struct Sequence *seq,
                                float timeline_frame,
                                int type,
-                               struct ImBuf *nval);
+                               struct ImBuf *nval,
+                               float cost);
 /**
  * Find only "base" keys.
  * Sources(other types) for a frame must be freed all at once.
@@ -30,6 +30,10 @@ void seq_prefetch_get_time_range(struct Scene *scene, int *start, int *end);
  * For cache context swapping.
  */
 struct SeqRenderData *seq_prefetch_get_original_context(const struct SeqRenderData *context);
+/**
+ * Prefetch renders of edits that are safe to render concurrently don't lock other renders.
+ */
+bool seq_prefetch_render_is_concurrent(const struct SeqRenderData *context);
 /**
  * For cache context swapping.
  */
@@ -19,6 +19,7 @@
 #include "BLI_path_util.h"
 #include "BLI_session_uuid.h"
 #include "BLI_string.h"
+#include "BLI_threads.h"
 
 #ifdef WIN32
 #  include "BLI_winstuff.h"
@@ -458,6 +459,7 @@ bool SEQ_proxy_rebuild_context(Main *bmain,
         context->index_context = IMB_anim_index_rebuild_context(sanim->anim,
                                                                 context->tc_flags,
                                                                 context->size_flags,
+                                                                nseq->strip->proxy->codec,
                                                                 context->quality,
                                                                 context->overwrite,
                                                                 file_list,
@@ -476,6 +478,8 @@ bool SEQ_proxy_rebuild_context(Main *bmain,
   return true;
 }
 
+static ThreadMutex proxy_render_mutex = BLI_MUTEX_INITIALIZER;
+
 void SEQ_proxy_rebuild(SeqIndexBuildContext *context,
                        short *stop,
                        short *do_update,
@@ -507,6 +511,10 @@ void SEQ_proxy_rebuild(SeqIndexBuildContext *context,
 
   /* fail safe code */
 
+  /* Several strips can be built at the same time by the proxy job, only movies decoded directly
+   * through FFmpeg are independent from each other. */
+  BLI_mutex_lock(&proxy_render_mutex);
+
   SEQ_render_new_render_data(bmain,
                              context->depsgraph,
                              context->scene,
@@ -547,6 +555,8 @@ void SEQ_proxy_rebuild(SeqIndexBuildContext *context,
       break;
     }
   }
+
+  BLI_mutex_unlock(&proxy_render_mutex);
 }
 
 void SEQ_proxy_rebuild_finish(SeqIndexBuildContext *context, bool stop)
@@ -11,8 +11,14 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
+#include "BLI_math_base.h"
+#include "BLI_threads.h"
 #include "BLI_timecode.h"
 
+#include "PIL_time.h"
+
+#include "atomic_ops.h"
+
 #include "DNA_scene_types.h"
 #include "DNA_sequence_types.h"
 
@@ -36,26 +42,107 @@ static void proxy_freejob(void *pjv)
   ProxyJob *pj = pjv;
 
   BLI_freelistN(&pj->queue);
+  BLI_ticket_mutex_free(pj->queue_mutex);
 
   MEM_freeN(pj);
 }
 
+/* Movies are decoded and encoded by FFmpeg which already uses several threads per file, only
+ * build a few of them at the same time. */
+#define PROXY_JOB_THREADS_MAX 4
+
+typedef struct ProxyJobThread {
+  struct ProxyJobThreads *threads;
+  float progress;
+} ProxyJobThread;
+
+typedef struct ProxyJobThreads {
+  ProxyJob *pj;
+  ProxyJobThread thread[PROXY_JOB_THREADS_MAX];
+  /** Last queue item taken by a thread, protected by the queue mutex. */
+  LinkData *queue_last;
+  int contexts_done;
+  int threads_done;
+  short *stop;
+  short do_update;
+} ProxyJobThreads;
+
+/* Take the next context from the job queue, which may have grown since the job started. */
+static struct SeqIndexBuildContext *proxy_queue_next(ProxyJobThreads *threads)
+{
+  ProxyJob *pj = threads->pj;
+  struct SeqIndexBuildContext *context = NULL;
+
+  BLI_ticket_mutex_lock(pj->queue_mutex);
+  LinkData *link = threads->queue_last ? threads->queue_last->next : pj->queue.first;
+  if (link) {
+    threads->queue_last = link;
+    context = link->data;
+  }
+  BLI_ticket_mutex_unlock(pj->queue_mutex);
+
+  return context;
+}
+
+static void *proxy_thread_run(void *thread_v)
+{
+  ProxyJobThread *thread = thread_v;
+  ProxyJobThreads *threads = thread->threads;
+
+  while (!*threads->stop) {
+    struct SeqIndexBuildContext *context = proxy_queue_next(threads);
+    if (context == NULL) {
+      break;
+    }
+
+    thread->progress = 0.0f;
+    SEQ_proxy_rebuild(context, threads->stop, &threads->do_update, &thread->progress);
+    thread->progress = 0.0f;
+    atomic_add_and_fetch_int32(&threads->contexts_done, 1);
+  }
+
+  atomic_add_and_fetch_int32(&threads->threads_done, 1);
+  return NULL;
+}
+
 /* Only this runs inside thread. */
 static void proxy_startjob(void *pjv, short *stop, short *do_update, float *progress)
 {
   ProxyJob *pj = pjv;
-  LinkData *link;
-
-  for (link = pj->queue.first; link; link = link->next) {
-    struct SeqIndexBuildContext *context = link->data;
+  ProxyJobThreads threads = {NULL};
+  ListBase threadbase;
+  int i;
+
+  threads.pj = pj;
+  threads.stop = stop;
+
+  const int threads_num = min_ii(BLI_system_thread_count(), PROXY_JOB_THREADS_MAX);
+  BLI_threadpool_init(&threadbase, proxy_thread_run, threads_num);
+  for (i = 0; i < threads_num; i++) {
+    threads.thread[i].threads = &threads;
+    BLI_threadpool_insert(&threadbase, &threads.thread[i]);
+  }
 
-    SEQ_proxy_rebuild(context, stop, do_update, progress);
+  while (atomic_add_and_fetch_int32(&threads.threads_done, 0) < threads_num) {
+    BLI_ticket_mutex_lock(pj->queue_mutex);
+    const int contexts_num = BLI_listbase_count(&pj->queue);
+    BLI_ticket_mutex_unlock(pj->queue_mutex);
 
-    if (*stop) {
-      pj->stop = 1;
-      fprintf(stderr, "Canceling proxy rebuild on users request...\n");
-      break;
+    float progress_sum = (float)atomic_add_and_fetch_int32(&threads.contexts_done, 0);
+    for (i = 0; i < threads_num; i++) {
+      progress_sum += threads.thread[i].progress;
     }
+    *progress = (contexts_num > 0) ? min_ff(progress_sum / contexts_num, 1.0f) : 1.0f;
+    *do_update = true;
+
+    PIL_sleep_ms(50);
+  }
+
+  BLI_threadpool_end(&threadbase);
+
+  if (*stop) {
+    pj->stop = 1;
+    fprintf(stderr, "Canceling proxy rebuild on users request...\n");
   }
 }
 
@@ -84,6 +171,7 @@ ProxyJob *ED_seq_proxy_job_get(const bContext *C, wmJob *wm_job)
     pj->depsgraph = depsgraph;
     pj->scene = scene;
     pj->main = CTX_data_main(C);
+    pj->queue_mutex = BLI_ticket_mutex_alloc();
     WM_jobs_customdata_set(wm_job, pj, proxy_freejob);
     WM_jobs_timer(wm_job, 0.1, NC_SCENE | ND_SEQUENCER, NC_SCENE | ND_SEQUENCER);
     WM_jobs_callbacks(wm_job, proxy_startjob, NULL, NULL, proxy_endjob);
@@ -91,6 +179,13 @@ ProxyJob *ED_seq_proxy_job_get(const bContext *C, wmJob *wm_job)
   return pj;
 }
 
+void ED_seq_proxy_job_queue_add(ProxyJob *pj, ListBase *queue)
+{
+  BLI_ticket_mutex_lock(pj->queue_mutex);
+  BLI_movelisttolist(&pj->queue, queue);
+  BLI_ticket_mutex_unlock(pj->queue_mutex);
+}
+
 struct wmJob *ED_seq_proxy_wm_job_get(const bContext *C)
 {
   Scene *scene = CTX_data_scene(C);
@@ -22,6 +22,7 @@
 #include "BLI_listbase.h"
 #include "BLI_path_util.h"
 #include "BLI_rect.h"
+#include "BLI_task.h"
 
 #include "BKE_anim_data.h"
 #include "BKE_animsys.h"
@@ -44,6 +45,8 @@
 #include "IMB_imbuf_types.h"
 #include "IMB_metadata.h"
 
+#include "PIL_time.h"
+
 #include "RNA_access.h"
 #include "RNA_prototypes.h"
 
@@ -1807,12 +1810,96 @@ static ImBuf *seq_render_strip_stack_apply_effect(
   return out;
 }
 
+/**
+ * Strips that only read their own data can be rendered concurrently with other strips of the
+ * same stack. Scene, meta and effect strips with inputs may touch shared data (render engines,
+ * animation evaluation, input strips), as do modifiers that use another strip as mask.
+ */
+static bool seq_render_strip_is_independent(const Sequence *seq)
+{
+  if (!ELEM(seq->type, SEQ_TYPE_IMAGE, SEQ_TYPE_MOVIE, SEQ_TYPE_COLOR)) {
+    return false;
+  }
+  LISTBASE_FOREACH (SequenceModifierData *, smd, &seq->modifiers) {
+    if (smd->mask_sequence != NULL) {
+      return false;
+    }
+  }
+  return true;
+}
+
+typedef struct SeqRenderStackParallelData {
+  const SeqRenderData *context;
+  Sequence **seq_arr;
+  ImBuf **r_ibufs;
+  float timeline_frame;
+} SeqRenderStackParallelData;
+
+static void seq_render_strip_stack_parallel_fn(void *__restrict userdata,
+                                               const int i,
+                                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SeqRenderStackParallelData *data = userdata;
+  Sequence *seq = data->seq_arr[i];
+  if (seq == NULL) {
+    return;
+  }
+  SeqRenderState state;
+  seq_render_state_init(&state);
+  data->r_ibufs[i] = seq_render_strip(data->context, &state, seq, data->timeline_frame);
+}
+
+/**
+ * Render the inputs of strips in `seq_arr[start..count)` that are blended on top of the stack
+ * in parallel, so only the (cheap) blending remains serial. Strips that can't be rendered
+ * concurrently are left NULL in `r_ibufs` and rendered in order while blending.
+ */
+static void seq_render_strip_stack_prerender(const SeqRenderData *context,
+                                             Sequence **seq_arr,
+                                             int start,
+                                             int count,
+                                             float timeline_frame,
+                                             ImBuf **r_ibufs)
+{
+  Sequence *jobs[MAXSEQ + 1] = {NULL};
+  int jobs_num = 0;
+
+  for (int i = start; i < count; i++) {
+    Sequence *seq = seq_arr[i];
+    if (seq_get_early_out_for_blend_mode(seq) != EARLY_DO_EFFECT) {
+      continue;
+    }
+    if (!seq_render_strip_is_independent(seq)) {
+      continue;
+    }
+    jobs[i] = seq;
+    jobs_num++;
+  }
+
+  /* Nothing to gain from a single strip, its own processing is already threaded. */
+  if (jobs_num < 2) {
+    return;
+  }
+
+  SeqRenderStackParallelData data = {
+      .context = context,
+      .seq_arr = jobs,
+      .r_ibufs = r_ibufs,
+      .timeline_frame = timeline_frame,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(start, count, &data, seq_render_strip_stack_parallel_fn, &settings);
+}
+
 static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
                                      SeqRenderState *state,
                                      ListBase *seqbasep,
                                      float timeline_frame,
                                      int chanshown)
 {
+  ImBuf *prerendered_ibufs[MAXSEQ + 1] = {NULL};
   Sequence *seq_arr[MAXSEQ + 1];
   int count;
   int i;
@@ -1885,12 +1972,17 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
   }
 
   i++;
+  seq_render_strip_stack_prerender(context, seq_arr, i, count, timeline_frame, prerendered_ibufs);
+
   for (; i < count; i++) {
     Sequence *seq = seq_arr[i];
 
     if (seq_get_early_out_for_blend_mode(seq) == EARLY_DO_EFFECT) {
       ImBuf *ibuf1 = out;
-      ImBuf *ibuf2 = seq_render_strip(context, state, seq, timeline_frame);
+      ImBuf *ibuf2 = prerendered_ibufs[i];
+      if (ibuf2 == NULL) {
+        ibuf2 = seq_render_strip(context, state, seq, timeline_frame);
+      }
 
       out = seq_render_strip_stack_apply_effect(context, seq, timeline_frame, ibuf1, ibuf2);
 
@@ -1940,17 +2032,25 @@ ImBuf *SEQ_render_give_ibuf(const SeqRenderData *context, float timeline_frame,
   SEQ_relations_free_all_anim_ibufs(context->scene, timeline_frame);
 
   if (count && !out) {
-    BLI_mutex_lock(&seq_render_mutex);
+    const bool use_render_mutex = !seq_prefetch_render_is_concurrent(context);
+    if (use_render_mutex) {
+      BLI_mutex_lock(&seq_render_mutex);
+    }
+    const double render_start = PIL_check_seconds_timer();
     out = seq_render_strip_stack(context, &state, seqbasep, timeline_frame, chanshown);
+    /* Render time relative to the playback duration of a frame. */
+    const float cost = (float)((PIL_check_seconds_timer() - render_start) * FPS);
 
     if (context->is_prefetch_render) {
-      seq_cache_put(context, seq_arr[count - 1], timeline_frame, SEQ_CACHE_STORE_FINAL_OUT, out);
+      seq_cache_final_out_put(context, seq_arr[count - 1], timeline_frame, out, cost);
     }
     else {
       seq_cache_put_if_possible(
-          context, seq_arr[count - 1], timeline_frame, SEQ_CACHE_STORE_FINAL_OUT, out);
+          context, seq_arr[count - 1], timeline_frame, SEQ_CACHE_STORE_FINAL_OUT, out, cost);
+    }
+    if (use_render_mutex) {
+      BLI_mutex_unlock(&seq_render_mutex);
     }
-    BLI_mutex_unlock(&seq_render_mutex);
   }
 
   seq_prefetch_start(context, timeline_frame);
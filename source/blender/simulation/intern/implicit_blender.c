@@ -18,6 +18,7 @@
 #  include "DNA_texture_types.h"
 
 #  include "BLI_math.h"
+#  include "BLI_task.h"
 #  include "BLI_utildefines.h"
 
 #  include "BKE_cloth.h"
@@ -34,6 +35,12 @@
 #    define CLOTH_OPENMP_LIMIT 512
 #  endif
 
+/* Minimum number of vertices for the solver to use multiple threads. */
+#  define CLOTH_PARALLEL_LIMIT 1024
+/* Number of vertices of which partial sums are computed together. The result of sums doesn't
+ * depend on the number of threads, because this is fixed. */
+#  define CLOTH_PARALLEL_CHUNK_SIZE 512
+
 //#define DEBUG_TIME
 
 #  ifdef DEBUG_TIME
@@ -642,6 +649,120 @@ DO_INLINE void subadd_bfmatrixS_bfmatrixS(
   }
 }
 
+/* Entry of a row of a sparse symmetric big matrix. */
+typedef struct BlockRowEntry {
+  unsigned int block;
+  unsigned int col;
+  /* Off-diagonal blocks are stored once, in the upper triangle. */
+  bool transposed;
+} BlockRowEntry;
+
+/* Row-wise index of the blocks of a sparse symmetric big matrix, so that its product with a long
+ * vector can be computed in parallel over rows. */
+typedef struct BlockRowIndex {
+  unsigned int *row_offsets;
+  BlockRowEntry *entries;
+} BlockRowIndex;
+
+/* Only the first blocks_num off-diagonal blocks are used, the remaining ones are zero. */
+static void block_row_index_build(BlockRowIndex *index,
+                                  const fmatrix3x3 *matrix,
+                                  unsigned int blocks_num)
+{
+  const unsigned int vcount = matrix[0].vcount;
+  const unsigned int blocks_end = vcount + blocks_num;
+  unsigned int *offsets = MEM_callocN(sizeof(*offsets) * (vcount + 1), __func__);
+
+  offsets[0] = 0;
+  for (unsigned int i = 0; i < vcount; i++) {
+    offsets[i + 1] = 1;
+  }
+  for (unsigned int i = vcount; i < blocks_end; i++) {
+    offsets[matrix[i].r + 1]++;
+    offsets[matrix[i].c + 1]++;
+  }
+  for (unsigned int i = 0; i < vcount; i++) {
+    offsets[i + 1] += offsets[i];
+  }
+
+  BlockRowEntry *entries = MEM_mallocN(sizeof(*entries) * offsets[vcount], __func__);
+  unsigned int *fill = MEM_mallocN(sizeof(*fill) * vcount, __func__);
+  memcpy(fill, offsets, sizeof(*fill) * vcount);
+
+  for (unsigned int i = 0; i < vcount; i++) {
+    entries[fill[i]++] = (BlockRowEntry){i, i, false};
+  }
+  for (unsigned int i = vcount; i < blocks_end; i++) {
+    const unsigned int r = matrix[i].r, c = matrix[i].c;
+    entries[fill[r]++] = (BlockRowEntry){i, c, false};
+    entries[fill[c]++] = (BlockRowEntry){i, r, true};
+  }
+
+  MEM_freeN(fill);
+  index->row_offsets = offsets;
+  index->entries = entries;
+}
+
+static void block_row_index_free(BlockRowIndex *index)
+{
+  MEM_SAFE_FREE(index->row_offsets);
+  MEM_SAFE_FREE(index->entries);
+}
+
+typedef struct BlockMulData {
+  const BlockRowIndex *index;
+  const fmatrix3x3 *matrix;
+  const fmatrix3x3 *filter;
+  lfVector *from;
+  lfVector *to;
+} BlockMulData;
+
+static void mul_bfmatrix_lfvector_row_fn(void *__restrict userdata,
+                                         const int row,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BlockMulData *data = userdata;
+  const BlockRowIndex *index = data->index;
+  float sum[3] = {0.0f, 0.0f, 0.0f};
+
+  for (unsigned int i = index->row_offsets[row]; i < index->row_offsets[row + 1]; i++) {
+    const BlockRowEntry *entry = &index->entries[i];
+    if (entry->transposed) {
+      muladd_fmatrixT_fvector(sum, data->matrix[entry->block].m, data->from[entry->col]);
+    }
+    else {
+      muladd_fmatrix_fvector(sum, data->matrix[entry->block].m, data->from[entry->col]);
+    }
+  }
+  if (data->filter) {
+    mul_m3_v3(data->filter[row].m, sum);
+  }
+  copy_v3_v3(data->to[row], sum);
+}
+
+/* Same as #mul_bfmatrix_lfvector, in parallel over rows and optionally followed by #filter. */
+static void mul_bfmatrix_lfvector_indexed(lfVector *to,
+                                          const fmatrix3x3 *from,
+                                          const BlockRowIndex *index,
+                                          lfVector *fLongVector,
+                                          const fmatrix3x3 *filter)
+{
+  const unsigned int vcount = from[0].vcount;
+  BlockMulData data = {
+      .index = index,
+      .matrix = from,
+      .filter = filter,
+      .from = fLongVector,
+      .to = to,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = vcount > CLOTH_PARALLEL_LIMIT;
+  settings.min_iter_per_thread = 256;
+  BLI_task_parallel_range(0, (int)vcount, &data, mul_bfmatrix_lfvector_row_fn, &settings);
+}
+
 ///////////////////////////////////////////////////////////////////
 /* simulator start */
 ///////////////////////////////////////////////////////////////////
@@ -834,8 +955,106 @@ static int cg_filtered(lfVector *ldV, fmatrix3x3 *lA, lfVector *lB, lfVector *z,
 }
 #  endif
 
+/* State of the conjugate gradient solver, shared by the parallel steps of an iteration.
+ * Each step handles chunks of #CLOTH_PARALLEL_CHUNK_SIZE vertices and stores a partial sum per
+ * chunk, which are added in order afterwards to get the same result with any number of threads. */
+typedef struct CGData {
+  unsigned int numverts;
+  const fmatrix3x3 *S;
+  const lfVector *Pinv;
+  lfVector *dV, *r, *c, *q, *s;
+  float alpha, beta;
+  float *chunk_sums;
+} CGData;
+
+static int cg_chunks_num(unsigned int numverts)
+{
+  return (int)((numverts + CLOTH_PARALLEL_CHUNK_SIZE - 1) / CLOTH_PARALLEL_CHUNK_SIZE);
+}
+
+static float cg_run_chunks(CGData *data, TaskParallelRangeFunc func)
+{
+  const int chunks_num = cg_chunks_num(data->numverts);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = data->numverts > CLOTH_PARALLEL_LIMIT;
+  BLI_task_parallel_range(0, chunks_num, data, func, &settings);
+
+  float sum = 0.0f;
+  for (int i = 0; i < chunks_num; i++) {
+    sum += data->chunk_sums[i];
+  }
+  return sum;
+}
+
+#  define CG_CHUNK_FOREACH_VERT(data, chunk, i) \
+    for (unsigned int i = (unsigned int)(chunk)*CLOTH_PARALLEL_CHUNK_SIZE, \
+                      i##_end = min_uu(i + CLOTH_PARALLEL_CHUNK_SIZE, (data)->numverts); \
+         i < i##_end; \
+         i++)
+
+/* c^T * q */
+static void cg_dot_cq_fn(void *__restrict userdata,
+                         const int chunk,
+                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  CGData *data = userdata;
+  float sum = 0.0f;
+  CG_CHUNK_FOREACH_VERT (data, chunk, i) {
+    sum += dot_v3v3(data->c[i], data->q[i]);
+  }
+  data->chunk_sums[chunk] = sum;
+}
+
+/* dV += alpha * c, r -= alpha * q, s = P^-1 * r, and r^T * s */
+static void cg_update_residual_fn(void *__restrict userdata,
+                                  const int chunk,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  CGData *data = userdata;
+  const float alpha = data->alpha;
+  float sum = 0.0f;
+  CG_CHUNK_FOREACH_VERT (data, chunk, i) {
+    madd_v3_v3fl(data->dV[i], data->c[i], alpha);
+    madd_v3_v3fl(data->r[i], data->q[i], -alpha);
+    mul_v3_v3v3(data->s[i], data->Pinv[i], data->r[i]);
+    sum += dot_v3v3(data->r[i], data->s[i]);
+  }
+  data->chunk_sums[chunk] = sum;
+}
+
+/* c = filter(s + beta * c) */
+static void cg_update_direction_fn(void *__restrict userdata,
+                                   const int chunk,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  CGData *data = userdata;
+  const float beta = data->beta;
+  CG_CHUNK_FOREACH_VERT (data, chunk, i) {
+    float c[3];
+    madd_v3_v3v3fl(c, data->s[i], data->c[i], beta);
+    mul_v3_m3v3(data->c[i], data->S[i].m, c);
+  }
+  data->chunk_sums[chunk] = 0.0f;
+}
+
+#  undef CG_CHUNK_FOREACH_VERT
+
+/* Diagonal (Jacobi) pre-conditioner: P = diag(A). */
+static void cg_build_preconditioner(lfVector *Pinv, const fmatrix3x3 *lA, unsigned int numverts)
+{
+  for (unsigned int i = 0; i < numverts; i++) {
+    for (int k = 0; k < 3; k++) {
+      const float diag = lA[i].m[k][k];
+      Pinv[i][k] = (diag > FLT_EPSILON) ? 1.0f / diag : 1.0f;
+    }
+  }
+}
+
 static int cg_filtered(lfVector *ldV,
                        fmatrix3x3 *lA,
+                       const BlockRowIndex *lA_rows,
                        lfVector *lB,
                        lfVector *z,
                        fmatrix3x3 *S,
@@ -852,23 +1071,43 @@ static int cg_filtered(lfVector *ldV,
   lfVector *c = create_lfvector(numverts);
   lfVector *q = create_lfvector(numverts);
   lfVector *s = create_lfvector(numverts);
-  float bnorm2, delta_new, delta_old, delta_target, alpha;
+  lfVector *Pinv = create_lfvector(numverts);
+  float bnorm2, delta_new, delta_old, delta_target;
+
+  CGData data = {
+      .numverts = numverts,
+      .S = S,
+      .Pinv = Pinv,
+      .dV = ldV,
+      .r = r,
+      .c = c,
+      .q = q,
+      .s = s,
+      .chunk_sums = MEM_mallocN(sizeof(float) * cg_chunks_num(numverts), __func__),
+  };
 
   cp_lfvector(ldV, z, numverts);
 
-  /* d0 = filter(B)^T * P * filter(B) */
+  cg_build_preconditioner(Pinv, lA, numverts);
+
+  /* d0 = filter(B)^T * P^-1 * filter(B) */
   cp_lfvector(fB, lB, numverts);
   filter(fB, S);
-  bnorm2 = dot_lfvector(fB, fB, numverts);
+  for (unsigned int i = 0; i < numverts; i++) {
+    mul_v3_v3v3(s[i], Pinv[i], fB[i]);
+  }
+  bnorm2 = dot_lfvector(fB, s, numverts);
   delta_target = conjgrad_epsilon * conjgrad_epsilon * bnorm2;
 
   /* r = filter(B - A * dV) */
-  mul_bfmatrix_lfvector(AdV, lA, ldV);
+  mul_bfmatrix_lfvector_indexed(AdV, lA, lA_rows, ldV, NULL);
   sub_lfvector_lfvector(r, lB, AdV, numverts);
   filter(r, S);
 
   /* c = filter(P^-1 * r) */
-  cp_lfvector(c, r, numverts);
+  for (unsigned int i = 0; i < numverts; i++) {
+    mul_v3_v3v3(c[i], Pinv[i], r[i]);
+  }
   filter(c, S);
 
   /* delta = r^T * c */
@@ -886,22 +1125,18 @@ static int cg_filtered(lfVector *ldV,
 #  endif
 
   while (delta_new > delta_target && conjgrad_loopcount < conjgrad_looplimit) {
-    mul_bfmatrix_lfvector(q, lA, c);
-    filter(q, S);
+    /* q = filter(A * c) */
+    mul_bfmatrix_lfvector_indexed(q, lA, lA_rows, c, S);
 
-    alpha = delta_new / dot_lfvector(c, q, numverts);
+    data.alpha = delta_new / cg_run_chunks(&data, cg_dot_cq_fn);
 
-    add_lfvector_lfvectorS(ldV, ldV, c, alpha, numverts);
-
-    add_lfvector_lfvectorS(r, r, q, -alpha, numverts);
-
-    /* s = P^-1 * r */
-    cp_lfvector(s, r, numverts);
+    /* dV += alpha * c, r -= alpha * q, s = P^-1 * r */
     delta_old = delta_new;
-    delta_new = dot_lfvector(r, s, numverts);
+    delta_new = cg_run_chunks(&data, cg_update_residual_fn);
 
-    add_lfvector_lfvectorS(c, s, c, delta_new / delta_old, numverts);
-    filter(c, S);
+    /* c = filter(s + c * delta_new / delta_old) */
+    data.beta = delta_new / delta_old;
+    cg_run_chunks(&data, cg_update_direction_fn);
 
     conjgrad_loopcount++;
   }
@@ -918,6 +1153,8 @@ static int cg_filtered(lfVector *ldV,
   del_lfvector(c);
   del_lfvector(q);
   del_lfvector(s);
+  del_lfvector(Pinv);
+  MEM_freeN(data.chunk_sums);
   // printf("W/O conjgrad_loopcount: %d\n", conjgrad_loopcount);
 
   result->status = conjgrad_loopcount < conjgrad_looplimit ? SIM_SOLVER_SUCCESS :
@@ -1146,7 +1383,11 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 
   subadd_bfmatrixS_bfmatrixS(data->A, data->dFdV, dt, data->dFdX, (dt * dt));
 
-  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, data->V);
+  /* All big matrices have the same blocks. */
+  BlockRowIndex rows;
+  block_row_index_build(&rows, data->A, (unsigned int)data->num_blocks);
+
+  mul_bfmatrix_lfvector_indexed(dFdXmV, data->dFdX, &rows, data->V, NULL);
 
   add_lfvectorS_lfvectorS(data->B, data->F, dt, dFdXmV, (dt * dt), numverts);
 
@@ -1155,7 +1396,9 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 #  endif
 
   /* Conjugate gradient algorithm to solve Ax=b. */
-  cg_filtered(data->dV, data->A, data->B, data->z, data->S, result);
+  cg_filtered(data->dV, data->A, &rows, data->B, data->z, data->S, result);
+
+  block_row_index_free(&rows);
 
   // cg_filtered_pre(id->dV, id->A, id->B, id->z, id->S, id->P, id->Pinv, id->bigI);
 
@@ -711,8 +711,14 @@ static void wm_file_read_post(bContext *C, const struct wmFileReadPost_Params *p
     WM_operatortype_last_properties_clear_all();
 
     /* After load post, so for example the driver namespace can be filled
-     * before evaluating the depsgraph. */
-    wm_event_do_depsgraph(C, true);
+     * before evaluating the depsgraph.
+     *
+     * In background mode the startup file is usually replaced by the file to process right away,
+     * skip evaluating it. Anything that needs evaluated data still ensures the depsgraph is
+     * evaluated on access. */
+    if (!(G.background && is_startup_file)) {
+      wm_event_do_depsgraph(C, true);
+    }
 
     ED_editors_init(C);
 
@@ -1918,6 +1924,9 @@ static void wm_autosave_location(char *filepath)
   BLI_join_dirfile(filepath, FILE_MAX, BKE_tempdir_base(), path);
 }
 
+/** Chunks of the last auto-save written from the undo memfile, to only write what changed. */
+static MemFileWrittenLayout wm_autosave_written_layout = {{0}};
+
 static void wm_autosave_write(Main *bmain, wmWindowManager *wm)
 {
   char filepath[FILE_MAX];
@@ -1928,9 +1937,11 @@ static void wm_autosave_write(Main *bmain, wmWindowManager *wm)
   const bool use_memfile = (U.uiflag & USER_GLOBALUNDO) != 0;
   MemFile *memfile = use_memfile ? ED_undosys_stack_memfile_get_active(wm->undo_stack) : NULL;
   if (memfile != NULL) {
-    BLO_memfile_write_file(memfile, filepath);
+    BLO_memfile_write_file_incremental(memfile, filepath, &wm_autosave_written_layout);
   }
   else {
+    BLO_memfile_written_layout_free(&wm_autosave_written_layout);
+
     if (use_memfile) {
       /* This is very unlikely, alert developers of this unexpected case. */
       CLOG_WARN(&LOG, "undo-data not found for writing, fallback to regular file write!");
@@ -2002,6 +2013,7 @@ void wm_autosave_delete(void)
   char filename[FILE_MAX];
 
   wm_autosave_location(filename);
+  BLO_memfile_written_layout_free(&wm_autosave_written_layout);
 
   if (BLI_exists(filename)) {
     char str[FILE_MAX];
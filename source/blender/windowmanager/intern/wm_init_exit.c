@@ -33,6 +33,7 @@
 #include "BLI_timer.h"
 #include "BLI_utildefines.h"
 
+#include "BLO_readfile.h"
 #include "BLO_undofile.h"
 #include "BLO_writefile.h"
 
@@ -615,6 +616,7 @@ void WM_exit_ex(bContext *C, const bool do_python)
 
   GHOST_DisposeSystemPaths();
 
+  BLO_file_dna_cache_clear();
   DNA_sdna_current_free();
 
   BLI_threadapi_exit();
@@ -29,6 +29,7 @@
 #include "BLI_system.h"
 #include "BLI_task.h"
 #include "BLI_threads.h"
+#include "BLI_trace.h"
 #include "BLI_utildefines.h"
 
 /* Mostly initialization functions. */
@@ -144,6 +145,9 @@ static void callback_main_atexit(void *user_data)
 {
   struct CreatorAtExitData *app_init_data = user_data;
 
+  /* Write the trace of `--debug-trace`, if enabled. */
+  BLI_trace_exit();
+
   if (app_init_data->ba) {
     BLI_args_destroy(app_init_data->ba);
     app_init_data->ba = NULL;
@@ -27,6 +27,7 @@
 #  include "BLI_string_utf8.h"
 #  include "BLI_system.h"
 #  include "BLI_threads.h"
+#  include "BLI_trace.h"
 #  include "BLI_utildefines.h"
 
 #  include "BLO_readfile.h" /* only for BLO_has_bfile_extension */
@@ -588,6 +589,7 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
 
   printf("\n");
   BLI_args_print_arg_doc(ba, "--debug-fpe");
+  BLI_args_print_arg_doc(ba, "--debug-trace");
   BLI_args_print_arg_doc(ba, "--debug-exit-on-error");
   BLI_args_print_arg_doc(ba, "--disable-crash-handler");
   BLI_args_print_arg_doc(ba, "--disable-abort-handler");
@@ -1105,6 +1107,24 @@ static int arg_handle_debug_fpe_set(int UNUSED(argc),
   return 0;
 }
 
+static const char arg_handle_debug_trace_set_doc[] =
+    "<filepath>\n"
+    "\tRecord a timeline of depsgraph, modifier, draw and render events.\n"
+    "\tIt is written to the file on exit, in the Chrome trace format (for 'chrome://tracing'\n"
+    "\tand 'https://ui.perfetto.dev').";
+static int arg_handle_debug_trace_set(int argc, const char **argv, void *UNUSED(data))
+{
+  if (argc > 1) {
+    char filepath[FILE_MAX];
+    STRNCPY(filepath, argv[1]);
+    BLI_path_abs_from_cwd(filepath, sizeof(filepath));
+    BLI_trace_enable(filepath);
+    return 1;
+  }
+  printf("\nError: you must specify a filepath after '--debug-trace'.\n");
+  return 0;
+}
+
 static const char arg_handle_app_template_doc[] =
     "<template>\n"
     "\tSet the application template (matching the directory name), use 'default' for none.";
@@ -2137,6 +2157,7 @@ void main_args_setup(bContext *C, bArgs *ba)
   BLI_args_add(ba, NULL, "--debug-io", CB(arg_handle_debug_mode_io), NULL);
 
   BLI_args_add(ba, NULL, "--debug-fpe", CB(arg_handle_debug_fpe_set), NULL);
+  BLI_args_add(ba, NULL, "--debug-trace", CB(arg_handle_debug_trace_set), NULL);
 
 #  ifdef WITH_LIBMV
   BLI_args_add(ba, NULL, "--debug-libmv", CB(arg_handle_debug_mode_libmv), NULL);
@@ -0,0 +1,67 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+import os
+
+
+def _run(args):
+    import bpy
+    import time
+
+    scene = bpy.context.scene
+    scene.render.resolution_x = 1920
+    scene.render.resolution_y = 1080
+    scene.render.resolution_percentage = 100
+
+    # Without a Render Layers node only the compositing tree is evaluated, so
+    # the scene itself is not rendered.
+    scene.use_nodes = True
+    tree = scene.node_tree
+    tree.nodes.clear()
+
+    image = bpy.data.images.new("Input", 1920, 1080, float_buffer=True)
+    image.generated_type = 'COLOR_GRID'
+
+    image_node = tree.nodes.new('CompositorNodeImage')
+    image_node.image = image
+    blur = tree.nodes.new('CompositorNodeBlur')
+    blur.filter_type = args['filter_type']
+    blur.size_x = 50
+    blur.size_y = 50
+    composite = tree.nodes.new('CompositorNodeComposite')
+
+    tree.links.new(image_node.outputs['Image'], blur.inputs['Image'])
+    tree.links.new(blur.outputs['Image'], composite.inputs['Image'])
+
+    start_time = time.time()
+    elapsed_time = 0.0
+    num_renders = 0
+
+    while elapsed_time < 10.0:
+        bpy.ops.render.render()
+
+        num_renders += 1
+        elapsed_time = time.time() - start_time
+
+    result = {'time': elapsed_time / num_renders}
+    return result
+
+
+class CompositorTest(api.Test):
+    def __init__(self, filter_type):
+        self.filter_type = filter_type
+
+    def name(self):
+        return f"blur_{self.filter_type.lower()}"
+
+    def category(self):
+        return "compositor"
+
+    def run(self, env, device_id):
+        args = {'filter_type': self.filter_type}
+        result, _ = env.run_in_blender(_run, args)
+        return result
+
+
+def generate(env):
+    return [CompositorTest(filter_type) for filter_type in ('FLAT', 'GAUSS')]
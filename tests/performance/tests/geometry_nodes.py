@@ -0,0 +1,114 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+import os
+
+
+def _peak_memory():
+    # Peak resident memory of the Blender process in bytes, where available.
+    try:
+        import resource
+    except ImportError:
+        return None
+
+    import sys
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    return peak if sys.platform == 'darwin' else peak * 1024
+
+
+def _add_node(tree, idname, inputs={}):
+    node = tree.nodes.new(idname)
+    for name, value in inputs.items():
+        node.inputs[name].default_value = value
+    return node
+
+
+def _build_tree(tree, scenario):
+    links = tree.links
+    group_output = tree.nodes.new('NodeGroupOutput')
+
+    if scenario in {'scatter', 'realize'}:
+        grid = _add_node(tree, 'GeometryNodeMeshGrid',
+                         {'Size X': 10.0, 'Size Y': 10.0, 'Vertices X': 500, 'Vertices Y': 500})
+        distribute = _add_node(tree, 'GeometryNodeDistributePointsOnFaces', {'Density': 5000.0})
+        instance = _add_node(tree, 'GeometryNodeMeshIcoSphere', {'Radius': 0.01, 'Subdivisions': 2})
+        instance_on_points = tree.nodes.new('GeometryNodeInstanceOnPoints')
+
+        links.new(grid.outputs['Mesh'], distribute.inputs['Mesh'])
+        links.new(distribute.outputs['Points'], instance_on_points.inputs['Points'])
+        links.new(instance.outputs['Mesh'], instance_on_points.inputs['Instance'])
+        result = instance_on_points.outputs['Instances']
+
+        if scenario == 'realize':
+            realize = tree.nodes.new('GeometryNodeRealizeInstances')
+            links.new(result, realize.inputs['Geometry'])
+            result = realize.outputs['Geometry']
+    elif scenario == 'curve_to_mesh':
+        spiral = _add_node(tree, 'GeometryNodeCurveSpiral', {'Resolution': 1000, 'Rotations': 200.0})
+        profile = _add_node(tree, 'GeometryNodeCurvePrimitiveCircle', {'Resolution': 64, 'Radius': 0.01})
+        curve_to_mesh = tree.nodes.new('GeometryNodeCurveToMesh')
+
+        links.new(spiral.outputs['Curve'], curve_to_mesh.inputs['Curve'])
+        links.new(profile.outputs['Curve'], curve_to_mesh.inputs['Profile Curve'])
+        result = curve_to_mesh.outputs['Mesh']
+
+    links.new(result, group_output.inputs['Geometry'])
+
+
+def _run(args):
+    import bpy
+    import time
+
+    scenario = args['scenario']
+
+    # Procedurally generated, so no benchmark files are needed.
+    bpy.ops.mesh.primitive_plane_add()
+    ob = bpy.context.active_object
+
+    tree = bpy.data.node_groups.new(scenario, 'GeometryNodeTree')
+    tree.outputs.new('NodeSocketGeometry', "Geometry")
+    _build_tree(tree, scenario)
+
+    modifier = ob.modifiers.new(scenario, 'NODES')
+    modifier.node_group = tree
+
+    # Evaluate once, so that one time initialization is not measured.
+    depsgraph = bpy.context.evaluated_depsgraph_get()
+    depsgraph.update()
+
+    start_time = time.time()
+    elapsed_time = 0.0
+    num_evaluations = 0
+
+    while elapsed_time < 10.0:
+        ob.update_tag()
+        depsgraph.update()
+
+        num_evaluations += 1
+        elapsed_time = time.time() - start_time
+
+    result = {'time': elapsed_time / num_evaluations}
+    peak_memory = _peak_memory()
+    if peak_memory is not None:
+        result['peak_memory'] = peak_memory
+    return result
+
+
+class GeometryNodesTest(api.Test):
+    def __init__(self, scenario):
+        self.scenario = scenario
+
+    def name(self):
+        return self.scenario
+
+    def category(self):
+        return "geometry_nodes"
+
+    def run(self, env, device_id):
+        args = {'scenario': self.scenario}
+        result, _ = env.run_in_blender(_run, args)
+        return result
+
+
+def generate(env):
+    return [GeometryNodesTest(scenario) for scenario in ('scatter', 'realize', 'curve_to_mesh')]
@@ -0,0 +1,47 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+import os
+
+
+def _run(args):
+    import bpy
+    import time
+
+    # A dense grid, so that the conversion between mesh and edit-mesh dominates.
+    bpy.ops.mesh.primitive_grid_add(x_subdivisions=args['subdivisions'],
+                                    y_subdivisions=args['subdivisions'])
+
+    start_time = time.time()
+    elapsed_time = 0.0
+    num_toggles = 0
+
+    while elapsed_time < 10.0:
+        bpy.ops.object.mode_set(mode='EDIT')
+        bpy.ops.object.mode_set(mode='OBJECT')
+
+        num_toggles += 1
+        elapsed_time = time.time() - start_time
+
+    result = {'time': elapsed_time / num_toggles}
+    return result
+
+
+class MeshEditTest(api.Test):
+    def __init__(self, subdivisions):
+        self.subdivisions = subdivisions
+
+    def name(self):
+        return f"edit_mode_toggle_{self.subdivisions}"
+
+    def category(self):
+        return "mesh_edit"
+
+    def run(self, env, device_id):
+        args = {'subdivisions': self.subdivisions}
+        result, _ = env.run_in_blender(_run, args)
+        return result
+
+
+def generate(env):
+    return [MeshEditTest(subdivisions) for subdivisions in (100, 1000)]